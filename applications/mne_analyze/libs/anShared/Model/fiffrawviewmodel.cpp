@@ -49,6 +49,7 @@
 
 #include <rtprocessing/helpers/filterkernel.h>
 #include <utils/mnemath.h>
+#include <utils/filecache.h>
 
 #include <rtprocessing/filter.h>
 
@@ -58,6 +59,7 @@
 
 #include <QtConcurrent/QtConcurrent>
 #include <QElapsedTimer>
+#include <QBuffer>
 #include <QFile>
 #include <QBrush>
 #include <QFileDialog>
@@ -79,6 +81,33 @@ using namespace RTPROCESSINGLIB;
 // DEFINE GLOBAL METHODS
 //=============================================================================================================
 
+namespace {
+
+//=============================================================================================================
+/**
+ * Creates a device on the same data the model reads from, so that background reads do not share the device of
+ * the model.
+ *
+ * @param[in] sFileName      The file the model was loaded from.
+ * @param[in] byteData       The data the model was loaded from, if it was not loaded from a file.
+ *
+ * @return The new device.
+ */
+QSharedPointer<QIODevice> createDetachedDevice(const QString& sFileName,
+                                               const QByteArray& byteData)
+{
+    if(byteData.isEmpty()) {
+        return QSharedPointer<QIODevice>(new QFile(sFileName));
+    }
+
+    QSharedPointer<QBuffer> pBuffer(new QBuffer);
+    pBuffer->setData(byteData);
+
+    return pBuffer;
+}
+
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -113,6 +142,10 @@ FiffRawViewModel::FiffRawViewModel(const QString &sFilePath,
 , m_bPerformFiltering(false)
 , m_pAnnotationModel(QSharedPointer<AnnotationModel>::create())
 , m_pRtFilter(FilterOverlapAdd::SPtr::create())
+, m_iPrefetchFirst(0)
+, m_iScrollDirection(1)
+, m_bRawDataStale(false)
+, m_iCancelBackground(0)
 {
     Q_UNUSED(sFilePath)
 
@@ -122,6 +155,13 @@ FiffRawViewModel::FiffRawViewModel(const QString &sFilePath,
                 postBlockLoad(m_blockLoadFutureWatcher.future().result());
             });
 
+    // connect the overview build: zoomed out views are drawn from it as soon as it is available
+    connect(&m_overviewFutureWatcher, &QFutureWatcher<FiffRawOverview::SPtr>::finished,
+            [this]() {
+                m_pOverview = m_overviewFutureWatcher.result();
+                emit dataChanged(createIndex(0,0), createIndex(rowCount(), columnCount()));
+            });
+
     if(byteLoadedData.isEmpty()) {
         m_file.setFileName(sFilePath);
         initFiffData(m_file);
@@ -138,7 +178,9 @@ FiffRawViewModel::FiffRawViewModel(const QString &sFilePath,
 
 FiffRawViewModel::~FiffRawViewModel()
 {
-
+    m_iCancelBackground.storeRelease(1);
+    m_overviewFutureWatcher.waitForFinished();
+    m_prefetchFuture.waitForFinished();
 }
 
 //=============================================================================================================
@@ -174,6 +216,8 @@ void FiffRawViewModel::initFiffData(QIODevice& p_IODevice)
     // need to close the file manually
     p_IODevice.close();
 
+    startOverviewBuild();
+
     m_bIsInit = true;
 }
 
@@ -398,12 +442,17 @@ void FiffRawViewModel::setWindowSize(int iNumSeconds,
     m_iVisibleWindowSize = iNumSeconds;
     m_iTotalBlockCount = m_iVisibleWindowSize + 2 * m_iPreloadBufferSize;
 
-    //reload data to accomodate new size
-    reloadAllData();
-
     //Update m_dDx based on new size
     setDataColumnWidth(iColWidth);
 
+    //reload data to accomodate new size, zoomed out views are drawn from the overview instead
+    if(isOverviewActive()) {
+        m_bRawDataStale = true;
+        updateEndStartFlags();
+    } else {
+        reloadAllData();
+    }
+
     endResetModel();
 }
 
@@ -564,11 +613,34 @@ void FiffRawViewModel::updateHorizontalScrollPosition(qint32 newScrollPosition)
         return;
     }
 
+    if(newScrollPosition != m_iScrollPos) {
+        m_iScrollDirection = newScrollPosition > m_iScrollPos ? 1 : -1;
+    }
+
     m_iScrollPos = newScrollPosition;
 
     // Convert scroll position to fiff sample space via m_dDx
     qint32 targetCursor = (newScrollPosition / m_dDx) + absoluteFirstSample() ;
 
+    if(isOverviewActive()) {
+        // zoomed out views are drawn from the overview: only move the cursor, the blocks are read once zoomed in again
+        qint32 iCursor = absoluteFirstSample() + ((targetCursor - absoluteFirstSample()) / m_iSamplesPerBlock - m_iPreloadBufferSize) * m_iSamplesPerBlock;
+        iCursor = std::min(iCursor, absoluteLastSample() + 1 - m_iTotalBlockCount * m_iSamplesPerBlock);
+        m_iFiffCursorBegin = std::max(absoluteFirstSample(), iCursor);
+
+        m_bRawDataStale = true;
+        updateEndStartFlags();
+
+        emit dataChanged(createIndex(0,0), createIndex(rowCount(), columnCount()));
+        return;
+    }
+
+    if(m_bRawDataStale) {
+        // the blocks were not kept up to date while the overview was drawn
+        reloadAllData();
+        updateEndStartFlags();
+    }
+
     if (targetCursor < m_iFiffCursorBegin + (m_iPreloadBufferSize - 1) * m_iSamplesPerBlock
         && !m_bStartOfFileReached) {
         // Calculate the amount of data we need to load
@@ -611,6 +683,30 @@ void FiffRawViewModel::updateHorizontalScrollPosition(qint32 newScrollPosition)
             postBlockLoad(loadLaterBlocks(blockDist));
         }
     }
+
+    startPrefetch();
+}
+
+//=============================================================================================================
+
+bool FiffRawViewModel::getOverviewEnvelope(qint32 iRow,
+                                           RowVectorXd& vecMin,
+                                           RowVectorXd& vecMax) const
+{
+    if(!isOverviewActive()) {
+        return false;
+    }
+
+    // the envelope spans the same samples as the held blocks, starting at the cursor
+    int iNumberSamples = m_iTotalBlockCount * m_iSamplesPerBlock;
+    int iNumberPixels = std::max(1, qRound(iNumberSamples * m_dDx));
+
+    return m_pOverview->getEnvelope(iRow,
+                                    m_iFiffCursorBegin,
+                                    iNumberSamples,
+                                    iNumberPixels,
+                                    vecMin,
+                                    vecMax);
 }
 
 //=============================================================================================================
@@ -723,7 +819,7 @@ int FiffRawViewModel::loadEarlierBlocks(qint32 numBlocks)
     }
 
     // Read the raw data
-    if(m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, start, end)) {
+    if(readRawSegment(matData, matTimes, start, end)) {
         // qDebug() << "[FiffRawViewModel::loadFiffData] Successfully read a block ";
     } else {
         qWarning() << "[FiffRawViewModel::loadEarlierBlocks] Could not read block ";
@@ -820,7 +916,7 @@ int FiffRawViewModel::loadLaterBlocks(qint32 numBlocks)
     }
 
     // read data
-    if(m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, start, end)) {
+    if(readRawSegment(matData, matTimes, start, end)) {
         // qDebug() << "[FiffRawViewModel::loadFiffData] Successfully read a block ";
     } else {
         qWarning() << "[FiffRawViewModel::loadLaterBlocks] Could not read block ";
@@ -953,13 +1049,15 @@ void FiffRawViewModel::reloadAllData()
     }
 
     // read in all blocks
-    if(m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, start, end)) {
+    if(readRawSegment(matData, matTimes, start, end)) {
         // qDebug() << "[FiffRawmodel::loadFiffData] Successfully read a block ";
     } else {
         qWarning() << "[FiffRawViewModel::loadFiffData] Could not read samples " << start << " to " << end;
         return;
     }
 
+    m_bRawDataStale = false;
+
     // append a matrix pair for each block
     for(int i = 0; i < m_iTotalBlockCount; ++i) {
         m_lData.push_back(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, i*m_iSamplesPerBlock+iFilterDelay, matData.rows(), m_iSamplesPerBlock),
@@ -991,3 +1089,168 @@ void FiffRawViewModel::reloadAllData()
 
     emit dataChanged(createIndex(0,0), createIndex(rowCount(), columnCount()));
 }
+
+//=============================================================================================================
+
+bool FiffRawViewModel::readRawSegment(MatrixXd& matData,
+                                      MatrixXd& matTimes,
+                                      int iFrom,
+                                      int iTo)
+{
+    {
+        QMutexLocker locker(&m_prefetchMutex);
+
+        if(m_matPrefetchData.cols() > 0
+           && iFrom >= m_iPrefetchFirst
+           && iTo < m_iPrefetchFirst + m_matPrefetchData.cols()) {
+            matData = m_matPrefetchData.middleCols(iFrom - m_iPrefetchFirst, iTo - iFrom + 1);
+            matTimes = m_matPrefetchTimes.middleCols(iFrom - m_iPrefetchFirst, iTo - iFrom + 1);
+            return true;
+        }
+    }
+
+    return m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, iFrom, iTo);
+}
+
+//=============================================================================================================
+
+void FiffRawViewModel::startPrefetch()
+{
+    if(m_pFiffIO->m_qlistRaw.empty() || m_prefetchFuture.isRunning()) {
+        return;
+    }
+
+    // One visible window ahead in scroll direction, padded so that the block loads can account for the filter delay
+    int iWindow = m_iVisibleWindowSize * m_iSamplesPerBlock;
+    int iPad = m_bPerformFiltering ? m_filterKernel.getFilterOrder() : 0;
+    int iFirst, iLast, iNeededFirst, iNeededLast;
+
+    if(m_iScrollDirection > 0) {
+        iFirst = currentLastSample() + 1 - iPad;
+        iLast = currentLastSample() + iWindow + iPad;
+        iNeededFirst = iFirst;
+        iNeededLast = iFirst + iWindow / 2;
+    } else {
+        iFirst = m_iFiffCursorBegin - iWindow - iPad;
+        iLast = m_iFiffCursorBegin - 1 + iPad;
+        iNeededFirst = iLast - iWindow / 2;
+        iNeededLast = iLast;
+    }
+
+    iFirst = std::max(iFirst, absoluteFirstSample());
+    iLast = std::min(iLast, absoluteLastSample());
+    iNeededFirst = std::max(iNeededFirst, iFirst);
+    iNeededLast = std::min(iNeededLast, iLast);
+
+    if(iFirst >= iLast) {
+        return;
+    }
+
+    {
+        // Only read again once less than half a window ahead is left
+        QMutexLocker locker(&m_prefetchMutex);
+
+        if(m_matPrefetchData.cols() > 0
+           && iNeededFirst >= m_iPrefetchFirst
+           && iNeededLast < m_iPrefetchFirst + m_matPrefetchData.cols()) {
+            return;
+        }
+    }
+
+    // The background read gets its own device, so it does not interfere with the reads of the model
+    FiffRawData raw(*m_pFiffIO->m_qlistRaw[0]);
+    QDataStream::ByteOrder byteOrder = m_pFiffIO->m_qlistRaw[0]->file->byteOrder();
+    QSharedPointer<QIODevice> pDevice = createDetachedDevice(m_file.fileName(), m_byteLoadedData);
+
+    m_prefetchFuture = QtConcurrent::run([this, raw, byteOrder, pDevice, iFirst, iLast]() {
+        if(m_iCancelBackground.loadAcquire() != 0) {
+            return;
+        }
+
+        FiffRawData rawReader(raw);
+        rawReader.file = FiffStream::SPtr(new FiffStream(pDevice.data()));
+        rawReader.file->setByteOrder(byteOrder);
+
+        MatrixXd matData, matTimes;
+
+        if(!rawReader.read_raw_segment(matData, matTimes, iFirst, iLast)) {
+            qWarning() << "[FiffRawViewModel::startPrefetch] Could not read samples " << iFirst << " to " << iLast;
+            return;
+        }
+
+        QMutexLocker locker(&m_prefetchMutex);
+        m_matPrefetchData.swap(matData);
+        m_matPrefetchTimes.swap(matTimes);
+        m_iPrefetchFirst = iFirst;
+    });
+}
+
+//=============================================================================================================
+
+void FiffRawViewModel::startOverviewBuild()
+{
+    // Data that was not loaded from a file is not cached
+    FileCache cache(m_byteLoadedData.isEmpty() ? FileCache::defaultDirectory("rawoverview") : QString(), "ovw");
+    QString sCacheKey = cache.isEnabled() ? FiffRawOverview::getCacheKey(m_file.fileName()) : QString();
+
+    FiffRawData raw(*m_pFiffIO->m_qlistRaw[0]);
+    QDataStream::ByteOrder byteOrder = m_pFiffIO->m_qlistRaw[0]->file->byteOrder();
+    QSharedPointer<QIODevice> pDevice = createDetachedDevice(m_file.fileName(), m_byteLoadedData);
+    QString sFileName = m_byteLoadedData.isEmpty() ? m_file.fileName() : QString();
+    const QAtomicInt* pCancel = &m_iCancelBackground;
+
+    m_overviewFutureWatcher.setFuture(QtConcurrent::run([raw, byteOrder, pDevice, sFileName, cache, sCacheKey, pCancel]() -> FiffRawOverview::SPtr {
+        FiffRawOverview::SPtr pOverview = FiffRawOverview::SPtr::create();
+        QByteArray baCached;
+
+        if(!sCacheKey.isEmpty() && cache.read(sCacheKey, baCached)) {
+            QBuffer buffer(&baCached);
+            buffer.open(QIODevice::ReadOnly);
+
+            if(pOverview->load(buffer, raw.info.nchan, raw.first_samp, raw.last_samp)) {
+                return pOverview;
+            }
+        }
+
+        // The whole recording is read, files on disk are read with several concurrent readers
+        if(!sFileName.isEmpty()) {
+            FiffRawDataSet rawSet(QStringList() << sFileName);
+            rawSet.setProj(raw.proj);
+            rawSet.setComp(raw.comp);
+
+            if(!pOverview->build(rawSet, pCancel)) {
+                return FiffRawOverview::SPtr();
+            }
+        } else {
+            FiffRawData rawReader(raw);
+            rawReader.file = FiffStream::SPtr(new FiffStream(pDevice.data()));
+            rawReader.file->setByteOrder(byteOrder);
+
+            if(!pOverview->build(rawReader, pCancel)) {
+                return FiffRawOverview::SPtr();
+            }
+        }
+
+        if(!sCacheKey.isEmpty()) {
+            baCached.clear();
+            QBuffer buffer(&baCached);
+            buffer.open(QIODevice::WriteOnly);
+
+            if(pOverview->save(buffer)) {
+                cache.write(sCacheKey, baCached);
+            }
+        }
+
+        return pOverview;
+    }));
+}
+
+//=============================================================================================================
+
+bool FiffRawViewModel::isOverviewActive() const
+{
+    // The overview holds the unfiltered data and is only exact if a pixel covers at least one bin
+    return !m_pOverview.isNull()
+           && !m_bPerformFiltering
+           && m_dDx * m_pOverview->getBaseBinSize() <= 1.0;
+}
@@ -44,6 +44,7 @@
 
 #include "../anshared_global.h"
 #include "../Utils/types.h"
+#include "../Utils/fiffrawoverview.h"
 #include "abstractmodel.h"
 
 #include <fiff/fiff_io.h>
@@ -56,7 +57,9 @@
 
 #include <QSharedPointer>
 #include <QFutureWatcher>
+#include <QFuture>
 #include <QMutex>
+#include <QAtomicInt>
 #include <QBuffer>
 #include <QFile>
 #include <QColor>
@@ -496,6 +499,21 @@ public:
      */
     void updateHorizontalScrollPosition(qint32 newScrollPosition);
 
+    //=========================================================================================================
+    /**
+     * Returns the min/max envelope of a channel for the currently held sample range, drawn from the precomputed
+     * overview. This is only available for zoomed out views without filtering, once the overview was built.
+     *
+     * @param[in] iRow       The channel.
+     * @param[out] vecMin    The minimum per pixel.
+     * @param[out] vecMax    The maximum per pixel.
+     *
+     * @return Returns true if the envelope should be drawn instead of the raw data.
+     */
+    bool getOverviewEnvelope(qint32 iRow,
+                             Eigen::RowVectorXd& vecMin,
+                             Eigen::RowVectorXd& vecMax) const;
+
 private:
     //=========================================================================================================
     /**
@@ -556,6 +574,44 @@ private:
      */
     void reloadAllData();
 
+    //=========================================================================================================
+    /**
+     * Reads a sample range of the raw data. The range is taken from the prefetched data if it is fully covered,
+     * otherwise it is read from the file.
+     *
+     * @param[out] matData   The read data.
+     * @param[out] matTimes  The corresponding times.
+     * @param[in] iFrom      The first sample to read.
+     * @param[in] iTo        The last sample to read (inclusive).
+     *
+     * @return Returns true if successful.
+     */
+    bool readRawSegment(MatrixXd& matData,
+                        MatrixXd& matTimes,
+                        int iFrom,
+                        int iTo);
+
+    //=========================================================================================================
+    /**
+     * Reads the next visible window in the current scroll direction in the background, so that the following
+     * block loads do not need to touch the file.
+     */
+    void startPrefetch();
+
+    //=========================================================================================================
+    /**
+     * Loads the overview of the whole file from the cache or builds it in the background.
+     */
+    void startOverviewBuild();
+
+    //=========================================================================================================
+    /**
+     * Returns whether the view is zoomed out far enough to be drawn from the overview.
+     *
+     * @return Returns true if the overview is used for drawing.
+     */
+    bool isOverviewActive() const;
+
     std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lData;             /**< Data */
     std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lNewData;          /**< Data that is to be appended or prepended */
     std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lFilteredData;     /**< Filtered data */
@@ -610,6 +666,18 @@ private:
 
     QSharedPointer<AnnotationModel>             m_pAnnotationModel;                         /**< Model to stored annotations to be displayed */
 
+    // overview and prefetch stuff
+    FiffRawOverview::SPtr                       m_pOverview;                                /**< Min/max overview of the whole file, null until it was built */
+    QFutureWatcher<FiffRawOverview::SPtr>       m_overviewFutureWatcher;                    /**< Watches the background build of the overview */
+    QFuture<void>                               m_prefetchFuture;                           /**< The currently running prefetch */
+    QMutex                                      m_prefetchMutex;                            /**< Guards the prefetched data */
+    MatrixXd                                    m_matPrefetchData;                          /**< Prefetched raw data */
+    MatrixXd                                    m_matPrefetchTimes;                         /**< Times of the prefetched raw data */
+    qint32                                      m_iPrefetchFirst;                           /**< First sample of the prefetched raw data */
+    qint32                                      m_iScrollDirection;                         /**< Last scroll direction, 1 for later and -1 for earlier samples */
+    bool                                        m_bRawDataStale;                            /**< Whether the held blocks lag behind the cursor because the overview was drawn */
+    QAtomicInt                                  m_iCancelBackground;                        /**< Set to cancel all background reads on destruction */
+
 signals:
     //=========================================================================================================
     /**
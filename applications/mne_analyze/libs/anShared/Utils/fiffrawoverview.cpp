@@ -0,0 +1,347 @@
+//=============================================================================================================
+/**
+ * @file     fiffrawoverview.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FiffRawOverview Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiffrawoverview.h"
+
+#include <fiff/fiff_raw_data.h>
+#include <fiff/fiff_raw_data_set.h>
+#include <utils/filecache.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QFileInfo>
+#include <QIODevice>
+
+//=============================================================================================================
+// Eigen INCLUDES
+//=============================================================================================================
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace ANSHAREDLIB;
+using namespace FIFFLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+const quint32 OVERVIEW_MAGIC          = 0x4f565257;   /**< Identifies overview cache files. */
+const qint32  OVERVIEW_VERSION        = 1;            /**< Version of the cache file layout. */
+const int     OVERVIEW_BIN_FACTOR     = 4;            /**< Bins of one level combined to one bin of the next level. */
+const int     OVERVIEW_MIN_BIN_SIZE   = 64;           /**< Smallest number of samples per bin on the first level. */
+const int     OVERVIEW_MAX_BINS       = 32768;        /**< Largest number of bins per channel on the first level. */
+const int     OVERVIEW_CHUNK_BINS     = 64;           /**< Number of first level bins read from the file at once. */
+const int     OVERVIEW_SET_CHUNK_BINS = 1024;         /**< Number of first level bins read from a data set at once. */
+
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffRawOverview::FiffRawOverview()
+: m_iNumberChannels(0)
+, m_iFirstSample(0)
+, m_iLastSample(-1)
+, m_iBaseBinSize(OVERVIEW_MIN_BIN_SIZE)
+{
+}
+
+//=============================================================================================================
+
+template<typename T>
+bool FiffRawOverview::buildFrom(const T& raw,
+                                int iNumberChannels,
+                                int iFirstSample,
+                                int iLastSample,
+                                int iChunkBins,
+                                const QAtomicInt* pCancel)
+{
+    m_vecBinSizes.clear();
+    m_vecMinLevels.clear();
+    m_vecMaxLevels.clear();
+
+    m_iNumberChannels = iNumberChannels;
+    m_iFirstSample = iFirstSample;
+    m_iLastSample = iLastSample;
+
+    int iNumberSamples = m_iLastSample - m_iFirstSample + 1;
+
+    if(m_iNumberChannels <= 0 || iNumberSamples <= 0) {
+        return false;
+    }
+
+    // Limit the memory of the first level by choosing a large enough bin size
+    m_iBaseBinSize = OVERVIEW_MIN_BIN_SIZE;
+
+    while((iNumberSamples + m_iBaseBinSize - 1) / m_iBaseBinSize > OVERVIEW_MAX_BINS) {
+        m_iBaseBinSize *= 2;
+    }
+
+    int iNumberBins = (iNumberSamples + m_iBaseBinSize - 1) / m_iBaseBinSize;
+    MatrixXfR matMin(m_iNumberChannels, iNumberBins);
+    MatrixXfR matMax(m_iNumberChannels, iNumberBins);
+
+    MatrixXd matData, matTimes;
+    int iChunkSize = iChunkBins * m_iBaseBinSize;
+    int iBin = 0;
+
+    for(int iFrom = m_iFirstSample; iFrom <= m_iLastSample; iFrom += iChunkSize) {
+        if(pCancel && pCancel->loadAcquire() != 0) {
+            return false;
+        }
+
+        int iTo = qMin(iFrom + iChunkSize - 1, m_iLastSample);
+
+        if(!raw.read_raw_segment(matData, matTimes, iFrom, iTo) || matData.rows() != m_iNumberChannels) {
+            qWarning() << "[FiffRawOverview::build] Could not read samples" << iFrom << "to" << iTo;
+            return false;
+        }
+
+        for(int iStart = 0; iStart < matData.cols(); iStart += m_iBaseBinSize, ++iBin) {
+            int iCount = qMin(m_iBaseBinSize, int(matData.cols()) - iStart);
+
+            matMin.col(iBin) = matData.middleCols(iStart, iCount).rowwise().minCoeff().cast<float>();
+            matMax.col(iBin) = matData.middleCols(iStart, iCount).rowwise().maxCoeff().cast<float>();
+        }
+    }
+
+    m_vecBinSizes.append(m_iBaseBinSize);
+    m_vecMinLevels.append(matMin);
+    m_vecMaxLevels.append(matMax);
+
+    buildLevels();
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool FiffRawOverview::build(FiffRawData& raw,
+                            const QAtomicInt* pCancel)
+{
+    return buildFrom(raw, raw.info.nchan, raw.first_samp, raw.last_samp, OVERVIEW_CHUNK_BINS, pCancel);
+}
+
+//=============================================================================================================
+
+bool FiffRawOverview::build(const FiffRawDataSet& rawSet,
+                            const QAtomicInt* pCancel)
+{
+    // Larger chunks give the data set enough buffers to read in parallel
+    return buildFrom(rawSet, rawSet.info().nchan, rawSet.firstSample(), rawSet.lastSample(), OVERVIEW_SET_CHUNK_BINS, pCancel);
+}
+
+//=============================================================================================================
+
+bool FiffRawOverview::save(QIODevice& device) const
+{
+    if(isEmpty()) {
+        return false;
+    }
+
+    QDataStream stream(&device);
+    stream << OVERVIEW_MAGIC << OVERVIEW_VERSION;
+    stream << qint32(m_iNumberChannels) << qint32(m_iFirstSample) << qint32(m_iLastSample) << qint32(m_iBaseBinSize);
+    stream << qint32(m_vecMinLevels.first().cols());
+
+    // Only the first level is stored, the others are cheap to recompute
+    int iBytes = int(m_vecMinLevels.first().size() * sizeof(float));
+    stream.writeRawData(reinterpret_cast<const char*>(m_vecMinLevels.first().data()), iBytes);
+    stream.writeRawData(reinterpret_cast<const char*>(m_vecMaxLevels.first().data()), iBytes);
+
+    return stream.status() == QDataStream::Ok;
+}
+
+//=============================================================================================================
+
+bool FiffRawOverview::load(QIODevice& device,
+                           int iNumberChannels,
+                           int iFirstSample,
+                           int iLastSample)
+{
+    QDataStream stream(&device);
+    quint32 uiMagic;
+    qint32 iVersion, iChannels, iFirst, iLast, iBaseBinSize, iNumberBins;
+
+    stream >> uiMagic >> iVersion >> iChannels >> iFirst >> iLast >> iBaseBinSize >> iNumberBins;
+
+    if(stream.status() != QDataStream::Ok
+       || uiMagic != OVERVIEW_MAGIC
+       || iVersion != OVERVIEW_VERSION
+       || iChannels != iNumberChannels
+       || iFirst != iFirstSample
+       || iLast != iLastSample
+       || iBaseBinSize <= 0
+       || iNumberBins != (iLast - iFirst + iBaseBinSize) / iBaseBinSize) {
+        return false;
+    }
+
+    MatrixXfR matMin(iChannels, iNumberBins);
+    MatrixXfR matMax(iChannels, iNumberBins);
+    int iBytes = int(matMin.size() * sizeof(float));
+
+    if(stream.readRawData(reinterpret_cast<char*>(matMin.data()), iBytes) != iBytes
+       || stream.readRawData(reinterpret_cast<char*>(matMax.data()), iBytes) != iBytes) {
+        return false;
+    }
+
+    m_iNumberChannels = iChannels;
+    m_iFirstSample = iFirst;
+    m_iLastSample = iLast;
+    m_iBaseBinSize = iBaseBinSize;
+
+    m_vecBinSizes.clear();
+    m_vecMinLevels.clear();
+    m_vecMaxLevels.clear();
+
+    m_vecBinSizes.append(m_iBaseBinSize);
+    m_vecMinLevels.append(matMin);
+    m_vecMaxLevels.append(matMax);
+
+    buildLevels();
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool FiffRawOverview::getEnvelope(int iRow,
+                                  int iFirstSample,
+                                  int iNumberSamples,
+                                  int iNumberPixels,
+                                  RowVectorXd& vecMin,
+                                  RowVectorXd& vecMax) const
+{
+    if(isEmpty() || iRow < 0 || iRow >= m_iNumberChannels || iNumberSamples <= 0 || iNumberPixels <= 0) {
+        return false;
+    }
+
+    double dSamplesPerPixel = double(iNumberSamples) / iNumberPixels;
+
+    // Pick the coarsest level whose bins still fit into one pixel
+    int iLevel = 0;
+
+    while(iLevel + 1 < m_vecBinSizes.size() && m_vecBinSizes.at(iLevel + 1) <= dSamplesPerPixel) {
+        ++iLevel;
+    }
+
+    int iBinSize = m_vecBinSizes.at(iLevel);
+    int iNumberBins = m_vecMinLevels.at(iLevel).cols();
+    const MatrixXfR& matMin = m_vecMinLevels.at(iLevel);
+    const MatrixXfR& matMax = m_vecMaxLevels.at(iLevel);
+
+    vecMin.setZero(iNumberPixels);
+    vecMax.setZero(iNumberPixels);
+
+    int iOffset = iFirstSample - m_iFirstSample;
+
+    for(int p = 0; p < iNumberPixels; ++p) {
+        int iStart = iOffset + int(p * dSamplesPerPixel);
+        int iEnd = iOffset + int((p + 1) * dSamplesPerPixel);
+
+        // Pixels outside of the file stay at zero, bins partly covered by a pixel are included so no peak is lost
+        if(iEnd <= 0 || iStart > m_iLastSample - m_iFirstSample) {
+            continue;
+        }
+
+        int iFirstBin = qBound(0, iStart / iBinSize, iNumberBins - 1);
+        int iLastBin = qBound(iFirstBin + 1, (iEnd + iBinSize - 1) / iBinSize, iNumberBins);
+
+        vecMin(p) = matMin.row(iRow).segment(iFirstBin, iLastBin - iFirstBin).minCoeff();
+        vecMax(p) = matMax.row(iRow).segment(iFirstBin, iLastBin - iFirstBin).maxCoeff();
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+QString FiffRawOverview::getCacheKey(const QString& sFileName)
+{
+    QFileInfo fileInfo(sFileName);
+
+    if(!fileInfo.exists()) {
+        return QString();
+    }
+
+    FileCacheKey key("FiffRawOverview v1");
+    key.add(fileInfo.absoluteFilePath());
+    key.addValue(fileInfo.size());
+    key.addValue(fileInfo.lastModified().toMSecsSinceEpoch());
+
+    return key.result();
+}
+
+//=============================================================================================================
+
+void FiffRawOverview::buildLevels()
+{
+    while(m_vecMinLevels.last().cols() > 2) {
+        const MatrixXfR& matMinBelow = m_vecMinLevels.last();
+        const MatrixXfR& matMaxBelow = m_vecMaxLevels.last();
+        int iNumberChildren = matMinBelow.cols();
+        int iNumberBins = (iNumberChildren + OVERVIEW_BIN_FACTOR - 1) / OVERVIEW_BIN_FACTOR;
+
+        MatrixXfR matMin(m_iNumberChannels, iNumberBins);
+        MatrixXfR matMax(m_iNumberChannels, iNumberBins);
+
+        for(int iBin = 0; iBin < iNumberBins; ++iBin) {
+            int iStart = iBin * OVERVIEW_BIN_FACTOR;
+            int iCount = qMin(OVERVIEW_BIN_FACTOR, iNumberChildren - iStart);
+
+            matMin.col(iBin) = matMinBelow.middleCols(iStart, iCount).rowwise().minCoeff();
+            matMax.col(iBin) = matMaxBelow.middleCols(iStart, iCount).rowwise().maxCoeff();
+        }
+
+        m_vecBinSizes.append(m_vecBinSizes.last() * OVERVIEW_BIN_FACTOR);
+        m_vecMinLevels.append(matMin);
+        m_vecMaxLevels.append(matMax);
+    }
+}
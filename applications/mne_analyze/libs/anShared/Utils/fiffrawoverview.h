@@ -0,0 +1,244 @@
+//=============================================================================================================
+/**
+ * @file     fiffrawoverview.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the FiffRawOverview Class.
+ *
+ */
+
+#ifndef ANSHAREDLIB_FIFFRAWOVERVIEW_H
+#define ANSHAREDLIB_FIFFRAWOVERVIEW_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../anshared_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QVector>
+#include <QAtomicInt>
+
+//=============================================================================================================
+// Eigen INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+class QIODevice;
+
+namespace FIFFLIB {
+    class FiffRawData;
+    class FiffRawDataSet;
+}
+
+//=============================================================================================================
+// DEFINE NAMESPACE ANSHAREDLIB
+//=============================================================================================================
+
+namespace ANSHAREDLIB {
+
+//=============================================================================================================
+/**
+ * Min/max decimated overview of a whole raw file on several resolution levels. The first level holds the minimum
+ * and maximum of bins of getBaseBinSize() samples per channel, every further level combines four bins of the level
+ * below. The overview is built once by reading through the file and can be stored to and restored from a cache
+ * file, so that zoomed out views can be drawn without reading raw data.
+ */
+class ANSHAREDSHARED_EXPORT FiffRawOverview
+{
+
+public:
+    typedef QSharedPointer<FiffRawOverview> SPtr;            /**< Shared pointer type for FiffRawOverview. */
+    typedef QSharedPointer<const FiffRawOverview> ConstSPtr; /**< Const shared pointer type for FiffRawOverview. */
+
+    //=========================================================================================================
+    /**
+     * Constructs an empty overview.
+     */
+    FiffRawOverview();
+
+    //=========================================================================================================
+    /**
+     * Builds the overview by reading the whole file in chunks.
+     *
+     * @param [in] raw       The raw data to read from. Should use its own file handle when run in a background thread.
+     * @param [in] pCancel   Optional flag, the build is aborted as soon as it is set to a non zero value.
+     *
+     * @return Returns true if the overview was built, false if reading failed or the build was cancelled.
+     */
+    bool build(FIFFLIB::FiffRawData& raw,
+               const QAtomicInt* pCancel = Q_NULLPTR);
+
+    //=========================================================================================================
+    /**
+     * Builds the overview from a recording on disk. The chunks are read concurrently by the data set.
+     *
+     * @param [in] rawSet    The recording to read from.
+     * @param [in] pCancel   Optional flag, the build is aborted as soon as it is set to a non zero value.
+     *
+     * @return Returns true if the overview was built, false if reading failed or the build was cancelled.
+     */
+    bool build(const FIFFLIB::FiffRawDataSet& rawSet,
+               const QAtomicInt* pCancel = Q_NULLPTR);
+
+    //=========================================================================================================
+    /**
+     * Stores the overview to a device.
+     *
+     * @param [in] device    The device to write to.
+     *
+     * @return Returns true if successful.
+     */
+    bool save(QIODevice& device) const;
+
+    //=========================================================================================================
+    /**
+     * Restores the overview from a device written by save. The data is only accepted if it matches the given
+     * channel number and sample range.
+     *
+     * @param [in] device            The device to read from.
+     * @param [in] iNumberChannels   The expected number of channels.
+     * @param [in] iFirstSample      The expected first sample of the raw file.
+     * @param [in] iLastSample       The expected last sample of the raw file.
+     *
+     * @return Returns true if successful.
+     */
+    bool load(QIODevice& device,
+              int iNumberChannels,
+              int iFirstSample,
+              int iLastSample);
+
+    //=========================================================================================================
+    /**
+     * Computes the per pixel min/max envelope of a channel for a sample range from the coarsest level whose bins
+     * do not exceed one pixel.
+     *
+     * @param [in] iRow              The channel.
+     * @param [in] iFirstSample      The first (absolute) sample of the range.
+     * @param [in] iNumberSamples    The number of samples of the range.
+     * @param [in] iNumberPixels     The number of pixels the range is drawn to.
+     * @param [out] vecMin           The minimum per pixel.
+     * @param [out] vecMax           The maximum per pixel.
+     *
+     * @return Returns false if the overview is empty or the channel is out of range.
+     */
+    bool getEnvelope(int iRow,
+                     int iFirstSample,
+                     int iNumberSamples,
+                     int iNumberPixels,
+                     Eigen::RowVectorXd& vecMin,
+                     Eigen::RowVectorXd& vecMax) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of samples per bin on the finest level. Views with fewer samples per pixel should be
+     * drawn from the raw data.
+     *
+     * @return The number of samples per bin on the finest level.
+     */
+    inline int getBaseBinSize() const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether the overview is empty.
+     *
+     * @return Returns true if nothing was built or loaded yet.
+     */
+    inline bool isEmpty() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the cache key of the overview of a raw file. The key depends on the path, size and modification
+     * time of the raw file, so that changed files are not matched with stale overviews.
+     *
+     * @param [in] sFileName     The raw file.
+     *
+     * @return The cache key or an empty string if the file does not exist.
+     */
+    static QString getCacheKey(const QString& sFileName);
+
+private:
+    typedef Eigen::Matrix<float,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> MatrixXfR;
+
+    //=========================================================================================================
+    /**
+     * Builds the first level from a reader with a read_raw_segment method and computes the others.
+     */
+    template<typename T>
+    bool buildFrom(const T& raw,
+                   int iNumberChannels,
+                   int iFirstSample,
+                   int iLastSample,
+                   int iChunkBins,
+                   const QAtomicInt* pCancel);
+
+    //=========================================================================================================
+    /**
+     * Computes all levels above the first one.
+     */
+    void buildLevels();
+
+    int                     m_iNumberChannels;      /**< The number of channels. */
+    int                     m_iFirstSample;         /**< The first sample of the raw file. */
+    int                     m_iLastSample;          /**< The last sample of the raw file. */
+    int                     m_iBaseBinSize;         /**< The number of samples per bin on the first level. */
+
+    QVector<int>            m_vecBinSizes;          /**< The bin size in samples per level. */
+    QVector<MatrixXfR>      m_vecMinLevels;         /**< The bin minima per level (channels x bins). */
+    QVector<MatrixXfR>      m_vecMaxLevels;         /**< The bin maxima per level (channels x bins). */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline int FiffRawOverview::getBaseBinSize() const
+{
+    return m_iBaseBinSize;
+}
+
+//=============================================================================================================
+
+inline bool FiffRawOverview::isEmpty() const
+{
+    return m_vecBinSizes.isEmpty();
+}
+
+} // namespace ANSHAREDLIB
+
+#endif // ANSHAREDLIB_FIFFRAWOVERVIEW_H
@@ -93,6 +93,7 @@ SOURCES += \
     Model/annotationmodel.cpp \
     Model/analyzedatamodel.cpp \
     Model/averagingdatamodel.cpp \
+    Utils/fiffrawoverview.cpp \
 
 HEADERS += \
     anshared_global.h \
@@ -112,6 +113,7 @@ HEADERS += \
     Model/annotationmodel.h \
     Model/analyzedatamodel.h \
     Model/averagingdatamodel.h \
+    Utils/fiffrawoverview.h \
 
 INCLUDEPATH += $${EIGEN_INCLUDE_DIR}
 INCLUDEPATH += $${MNE_INCLUDE_DIR}
@@ -42,6 +42,8 @@
 #include <anShared/Management/analyzedata.h>
 #include <anShared/Model/fiffrawviewmodel.h>
 
+#include <fiff/fiff_stream.h>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
@@ -78,6 +80,9 @@ QSharedPointer<IPlugin> DataLoader::clone() const
 void DataLoader::init()
 {
     m_pCommu = new Communicator(this);
+
+    // Recordings without a tag directory are scanned only once, later loads use the cached index
+    FIFFLIB::FiffStream::enable_sidecar_index();
 }
 
 //=============================================================================================================
@@ -237,6 +237,20 @@ void FiffRawViewDelegate::createPlotPath(const QStyleOptionViewItem &option,
 
     QPointF qSamplePosition;
 
+    // Zoomed out views are drawn from the min/max overview with one vertical line per pixel
+    Eigen::RowVectorXd vecMin, vecMax;
+
+    if(t_pModel->getOverviewEnvelope(index.row(), vecMin, vecMax)) {
+        double x = path.currentPosition().x();
+
+        for(int i = 0; i < vecMin.size(); ++i) {
+            path.lineTo(x + i, y_base - vecMax[i] * dScaleY);
+            path.lineTo(x + i, y_base - vecMin[i] * dScaleY);
+        }
+
+        return;
+    }
+
     //Deactivate downsampling for now due to aliasing effects
 //    int iPaintStep = (int)(1.0/dDx) - 1;
 //    if (iPaintStep < 2){
@@ -49,6 +49,7 @@
 
 #include <QStack>
 #include <QFileInfo>
+#include <QtEndian>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -235,11 +236,29 @@ int FiffAnonymizer::anonymizeFile()
     processHeaderTags();
 
 
+    QByteArray tagHeader;
     while( (m_pTag->next != -1) && (!m_pInStream->device()->atEnd()))
     {
-        readTag();
-        censorTag();
-        writeTag();
+        //only tags which might hold sensitive information, or which open/close a block, are decoded.
+        //Everything else (i.e. the raw data buffers) is copied verbatim.
+        tagHeader = m_pInStream->device()->peek(4*sizeof(qint32));
+        if(tagHeader.size() < static_cast<int>(4*sizeof(qint32)))
+        {
+            break;
+        }
+
+        FIFFLIB::fiff_int_t kind = qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(tagHeader.constData()));
+
+        if(tagNeedsDecoding(kind))
+        {
+            readTag();
+            censorTag();
+            writeTag();
+        } else if(!copyTagVerbatim()) {
+            qCritical() << "Error while copying a tag of kind" << kind << "to the output file.";
+            closeInOutStreams();
+            return 1;
+        }
     }
 
     closeInOutStreams();
@@ -594,6 +613,104 @@ void FiffAnonymizer::writeTag()
 
 //=============================================================================================================
 
+bool FiffAnonymizer::tagNeedsDecoding(FIFFLIB::fiff_int_t kind) const
+{
+    switch (kind)
+    {
+    case FIFF_BLOCK_START:
+    case FIFF_BLOCK_END:
+    case FIFF_FILE_ID:
+    case FIFF_BLOCK_ID:
+    case FIFF_PARENT_FILE_ID:
+    case FIFF_PARENT_BLOCK_ID:
+    case FIFF_REF_FILE_ID:
+    case FIFF_REF_BLOCK_ID:
+    case FIFF_MEAS_DATE:
+    case FIFF_COMMENT:
+    case FIFF_EXPERIMENTER:
+    case FIFF_SUBJ_ID:
+    case FIFF_SUBJ_FIRST_NAME:
+    case FIFF_SUBJ_MIDDLE_NAME:
+    case FIFF_SUBJ_LAST_NAME:
+    case FIFF_SUBJ_BIRTH_DAY:
+    case FIFF_SUBJ_SEX:
+    case FIFF_SUBJ_HAND:
+    case FIFF_SUBJ_WEIGHT:
+    case FIFF_SUBJ_HEIGHT:
+    case FIFF_SUBJ_COMMENT:
+    case FIFF_SUBJ_HIS_ID:
+    case FIFF_PROJ_ID:
+    case FIFF_PROJ_NAME:
+    case FIFF_PROJ_AIM:
+    case FIFF_PROJ_PERSONS:
+    case FIFF_PROJ_COMMENT:
+    case FIFF_MRI_PIXEL_DATA:
+    case FIFF_MNE_ENV_WORKING_DIR:
+    case FIFF_MNE_ENV_COMMAND_LINE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//=============================================================================================================
+
+bool FiffAnonymizer::copyTagVerbatim()
+{
+    //a 4 MB chunk keeps the memory bounded for huge tags while still moving the data in few system calls
+    const qint64 iChunkSize(4*1024*1024);
+
+    QIODevice* pDevIn = m_pInStream->device();
+    QIODevice* pDevOut = m_pOutStream->device();
+
+    qint32 kind, type, size, next;
+    *m_pInStream >> kind;
+    *m_pInStream >> type;
+    *m_pInStream >> size;
+    *m_pInStream >> next;
+
+    if(m_pInStream->status() != QDataStream::Ok || size < 0)
+    {
+        return false;
+    }
+
+    m_pTag->kind = kind;
+    m_pTag->type = type;
+    m_pTag->next = next;
+
+    //make output tag list linear
+    *m_pOutStream << kind;
+    *m_pOutStream << type;
+    *m_pOutStream << size;
+    *m_pOutStream << static_cast<qint32>(next > 0 ? FIFFV_NEXT_SEQ : next);
+
+    qint64 iRemaining(size);
+    while(iRemaining > 0)
+    {
+        const qint64 iToRead(qMin(iRemaining, iChunkSize));
+        if(m_BCopyBuffer.size() < iToRead)
+        {
+            m_BCopyBuffer.resize(static_cast<int>(iToRead));
+        }
+
+        const qint64 iRead(pDevIn->read(m_BCopyBuffer.data(), iToRead));
+        if(iRead <= 0 || pDevOut->write(m_BCopyBuffer.constData(), iRead) != iRead)
+        {
+            return false;
+        }
+        iRemaining -= iRead;
+    }
+
+    if(next > 0)
+    {
+        pDevIn->seek(next);
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
 void FiffAnonymizer::processHeaderTags()
 {
     readTag();
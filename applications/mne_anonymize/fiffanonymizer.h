@@ -779,6 +779,28 @@ private:
      */
     void writeTag();
 
+    //=========================================================================================================
+    /**
+     * Checks whether a tag of the given kind has to go through readTag(), censorTag() and writeTag(). This is
+     * the case for every kind handled in censorTag() and for the block start/end tags which drive the block
+     * type list. All other tags can be copied verbatim.
+     *
+     * @param [in] kind  Kind of the tag about to be read.
+     *
+     * @return True if the tag has to be decoded.
+     */
+    bool tagNeedsDecoding(FIFFLIB::fiff_int_t kind) const;
+
+    //=========================================================================================================
+    /**
+     * Copies the tag at the current position of the input file into the output file without decoding its
+     * payload. The header is rewritten with a sequential 'next' field and the data is moved in large chunks
+     * through a reusable buffer. The header of the copied tag is stored in m_pTag (without data).
+     *
+     * @return True if the whole tag could be copied.
+     */
+    bool copyTagVerbatim();
+
     //=========================================================================================================
 
     FIFFLIB::FiffStream::SPtr m_pInStream;  /**< Pointer to FiffStream object for reading.*/
@@ -789,6 +811,8 @@ private:
 
     QSharedPointer<QStack<int32_t> > m_pBlockTypeList;          /**< Pointer to Stack storing info related to the blocks of tags in the file.*/
 
+    QByteArray m_BCopyBuffer;           /**< Reusable buffer for the verbatim copy of tags which need no anonymization.*/
+
     QFile m_fFileIn;                    /**< Input file.*/
     QFile m_fFileOut;                   /**< Output file.*/
 
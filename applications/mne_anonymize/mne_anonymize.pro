@@ -40,7 +40,7 @@ include(../../mne-cpp.pri)
 
 TEMPLATE = app
 
-QT += widgets network
+QT += widgets network concurrent
 
 #CONFIG += console
 
@@ -51,6 +51,8 @@
 #include <QRandomGenerator>
 #include <QDir>
 #include <QFileInfo>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -78,6 +80,7 @@ SettingsControllerCl::SettingsControllerCl()
 , m_bDeleteInputFileAfter(false)
 , m_bDeleteInputFileConfirmation(true)
 , m_bHisIdSpecified(false)
+, m_bBatchMode(false)
 , m_bVerboseMode(false)
 , m_bSilentMode(false)
 , m_bInOutFileNamesEqual(false)
@@ -97,6 +100,7 @@ SettingsControllerCl::SettingsControllerCl(const QStringList& arguments)
 , m_bDeleteInputFileAfter(false)
 , m_bDeleteInputFileConfirmation(true)
 , m_bHisIdSpecified(false)
+, m_bBatchMode(false)
 , m_bVerboseMode(false)
 , m_bSilentMode(false)
 , m_bInOutFileNamesEqual(false)
@@ -175,7 +179,8 @@ void SettingsControllerCl::initParser()
     m_parser.addOption(versionOpt);
 
     QCommandLineOption inFileOpt(QStringList() << "i" << "in",
-                                 QCoreApplication::translate("main","File to anonymize."),
+                                 QCoreApplication::translate("main","File to anonymize. Can be given several times, in which case all the files are anonymized "
+                                                                    "concurrently and each output file gets the default name."),
                                  QCoreApplication::translate("main","infile"));
     m_parser.addOption(inFileOpt);
 
@@ -234,6 +239,12 @@ void SettingsControllerCl::initParser()
                                          QCoreApplication::translate("main","Anonymize information related to the MNE environment. "
                                                                                        "If found in the file, Working Directory or command line tags will be anonymized."));
     m_parser.addOption(mneEnvironmentOpt);
+
+    QCommandLineOption jobsOpt(QStringList() << "j" << "jobs",
+                               QCoreApplication::translate("main","Maximum number of files anonymized at the same time when several input files are specified. "
+                                                                  "Default: number of cores."),
+                               QCoreApplication::translate("main","n"));
+    m_parser.addOption(jobsOpt);
 }
 
 //=============================================================================================================
@@ -356,6 +367,11 @@ int SettingsControllerCl::parseInputs(const QStringList& arguments)
 
 int SettingsControllerCl::parseInOutFiles()
 {
+    const QStringList slInFiles(m_parser.values("in"));
+    if(slInFiles.size() > 1)
+    {
+        return parseBatchInFiles(slInFiles);
+    }
 
     if(m_parser.isSet("in"))
     {
@@ -420,8 +436,54 @@ int SettingsControllerCl::parseInOutFiles()
 
 //=============================================================================================================
 
+int SettingsControllerCl::parseBatchInFiles(const QStringList& slInFiles)
+{
+    if(m_parser.isSet("out"))
+    {
+        qCritical() << "An output file cannot be specified when anonymizing several input files.";
+        return 1;
+    }
+
+    if(m_parser.isSet("delete_input_file_after") && !m_parser.isSet("avoid_delete_confirmation"))
+    {
+        qCritical() << "Deleting the input files of a batch requires the avoid_delete_confirmation [-f] option.";
+        return 1;
+    }
+
+    m_slBatchInFiles.clear();
+    for(const QString& sInFile : slInFiles)
+    {
+        QFileInfo fiInFile(sInFile);
+        if(!fiInFile.isFile())
+        {
+            qCritical() << "Input file is not a file:" << sInFile;
+            return 1;
+        }
+        m_slBatchInFiles.append(fiInFile.absoluteFilePath());
+    }
+
+    if(m_parser.isSet("jobs"))
+    {
+        int iJobs(m_parser.value("jobs").toInt());
+        if(iJobs > 0)
+        {
+            QThreadPool::globalInstance()->setMaxThreadCount(iJobs);
+        }
+    }
+
+    m_bBatchMode = true;
+    return 0;
+}
+
+//=============================================================================================================
+
 int SettingsControllerCl::execute()
 {
+    if(m_bBatchMode)
+    {
+        return executeBatch();
+    }
+
     if(m_pAnonymizer->anonymizeFile())
     {
         qCritical() << "Error. Program ends now.";
@@ -450,6 +512,75 @@ int SettingsControllerCl::execute()
 
 //=============================================================================================================
 
+int SettingsControllerCl::executeBatch()
+{
+    struct BatchJob {
+        QFileInfo fiInFile;
+        QFileInfo fiOutFile;
+        int iResult;
+    };
+
+    QList<BatchJob> lJobs;
+    for(const QString& sInFile : m_slBatchInFiles)
+    {
+        BatchJob job;
+        job.fiInFile.setFile(sInFile);
+        job.fiOutFile.setFile(QDir(job.fiInFile.absolutePath()).filePath(
+                                  job.fiInFile.baseName() + "_anonymized." + job.fiInFile.completeSuffix()));
+        job.iResult = 1;
+        lJobs.append(job);
+    }
+
+    const FiffAnonymizer& configuredAnonymizer(*m_pAnonymizer);
+    QFuture<void> future = QtConcurrent::map(lJobs, [&configuredAnonymizer](BatchJob& job) {
+        FiffAnonymizer anonymizer(configuredAnonymizer);
+        if(anonymizer.setInFile(job.fiInFile.absoluteFilePath()) == 0
+           && anonymizer.setOutFile(job.fiOutFile.absoluteFilePath()) == 0)
+        {
+            job.iResult = anonymizer.anonymizeFile();
+        }
+    });
+    future.waitForFinished();
+
+    int iFailed(0);
+    for(const BatchJob& job : lJobs)
+    {
+        if(job.iResult)
+        {
+            ++iFailed;
+            qCritical() << "Error during the anonymization of the input file:" << job.fiInFile.fileName();
+            continue;
+        }
+
+        if(m_bDeleteInputFileAfter)
+        {
+            QFile inFile(job.fiInFile.absoluteFilePath());
+            if(inFile.remove())
+            {
+                printIfVerbose("Input file deleted: " + job.fiInFile.fileName());
+            } else {
+                qCritical() << "Unable to delete the input file: " << inFile.fileName();
+            }
+        }
+
+        if(!m_bSilentMode)
+        {
+            std::printf("\n%s", QString("MNE Anonymize finished correctly: " + job.fiInFile.fileName() + " -> " + job.fiOutFile.fileName()).toUtf8().data());
+        }
+    }
+
+    if(!m_bSilentMode)
+    {
+        std::printf("\n%s\n", QString("Anonymized " + QString::number(lJobs.size() - iFailed) + " of " + QString::number(lJobs.size()) + " files.").toUtf8().data());
+    }
+
+    printFooterIfVerbose();
+
+    return iFailed ? 1 : 0;
+}
+
+//=============================================================================================================
+
 bool SettingsControllerCl::checkDeleteInputFile()
 {
     if(m_bDeleteInputFileAfter) //false by default
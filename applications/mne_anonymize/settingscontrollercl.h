@@ -166,6 +166,26 @@ private:
      */
     int parseInOutFiles();
 
+    //=========================================================================================================
+    /**
+     * Configures the batch mode, used when more than one input file has been specified. Each input file gets
+     * the default output file name and no single output file option is allowed.
+     *
+     * @param[in] slInFiles The list of input files.
+     *
+     * @return Returns 0 if the files were accepted, 1 otherwise.
+     */
+    int parseBatchInFiles(const QStringList& slInFiles);
+
+    //=========================================================================================================
+    /**
+     * Anonymizes all the input files of the batch mode concurrently. Each file is processed by its own copy of
+     * the configured FiffAnonymizer, so the anonymization options are shared while the streams are not.
+     *
+     * @return Returns 0 if all the files were anonymized correctly, 1 otherwise.
+     */
+    int executeBatch();
+
     //=========================================================================================================
     /**
      * The user might request throught the flag "--delete_input_file_after" to have the input file deleted. If the
@@ -244,12 +264,14 @@ protected:
 
     QFileInfo m_fiInFile;               /**< Input File info obj.*/
     QFileInfo m_fiOutFile;              /**< Output File info obj.*/
+    QStringList m_slBatchInFiles;       /**< Input files to anonymize concurrently in batch mode.*/
 
 protected:
     bool m_bGuiMode;                        /**< Object running in GUI mode.*/
     bool m_bDeleteInputFileAfter;           /**< User's request to delete the input file after anonymization.*/
     bool m_bDeleteInputFileConfirmation;    /**< User's request to avoid confirmation prompt for input file deletion.*/
     bool m_bHisIdSpecified;                 /**< User specified a "his_id" field to be used if that info is present in the input file.*/
+    bool m_bBatchMode;                      /**< Several input files are anonymized concurrently.*/
 
 private:
     bool m_bVerboseMode;                    /**< Show header when executing.*/
@@ -0,0 +1,245 @@
+//=============================================================================================================
+/**
+ * @file     main.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Implements the mne_compress_raw application.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff.h>
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QtEndian>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace UTILSLIB;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace
+{
+
+//=============================================================================================================
+/**
+ * Copies all tags of a fiff file and compresses (or uncompresses) the raw data buffers on the way. Tags are
+ * copied sequentially, the output file has no tag directory and is scanned by readers when opened.
+ *
+ * @param[in] sFileIn        the input file.
+ * @param[in] sFileOut       the output file.
+ * @param[in] bUncompress    whether to uncompress FIFFT_COMPRESSED_BUFFER tags instead of compressing buffers.
+ * @param[in] iLevel         zlib compression level.
+ * @param[in] bLittleEndian  whether the input file is in little-endian byte order. The output keeps the byte order.
+ *
+ * @return the number of converted buffers, -1 on error.
+ */
+int convertFile(const QString& sFileIn,
+                const QString& sFileOut,
+                bool bUncompress,
+                int iLevel,
+                bool bLittleEndian)
+{
+    QFile fileIn(sFileIn);
+    if(!fileIn.open(QIODevice::ReadOnly)) {
+        qCritical("Cannot open %s", sFileIn.toUtf8().constData());
+        return -1;
+    }
+    QFile fileOut(sFileOut);
+    if(!fileOut.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCritical("Cannot open %s for writing", sFileOut.toUtf8().constData());
+        return -1;
+    }
+
+    FiffStream streamIn(&fileIn);
+    if(bLittleEndian) {
+        streamIn.setByteOrder(QDataStream::LittleEndian);
+    }
+    FiffStream streamOut(&fileOut);
+    streamOut.setByteOrder(streamIn.byteOrder());
+    const int iEndian = streamIn.byteOrder() == QDataStream::LittleEndian ? FIFFV_LITTLE_ENDIAN : FIFFV_BIG_ENDIAN;
+    FiffTag::SPtr pTag;
+    const qint32 iNoDirectory = -1;
+    qint32 iNchan = 0;
+    int iConverted = 0;
+
+    while(!fileIn.atEnd()) {
+        // Keep the file byte order, only the raw data buffers are touched
+        streamIn.read_tag_into(pTag, -1, false);
+        const bool bLast = pTag->next < 0;
+
+        if(pTag->kind == FIFF_DIR) {
+            // The directory positions do not hold in the output file
+            if(bLast) {
+                break;
+            }
+            continue;
+        }
+
+        if(pTag->kind == FIFF_DIR_POINTER) {
+            streamOut.write_int(FIFF_DIR_POINTER, &iNoDirectory);
+            continue;
+        }
+
+        if(pTag->kind == FIFF_NCHAN && pTag->size() >= 4) {
+            iNchan = iEndian == FIFFV_LITTLE_ENDIAN ? qFromLittleEndian<qint32>(reinterpret_cast<const uchar*>(pTag->data()))
+                                                   : qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(pTag->data()));
+        }
+
+        if(pTag->kind == FIFF_DATA_BUFFER) {
+            if(!bUncompress && FiffCompressedBuffer::isSupportedType(pTag->type) && iNchan > 0) {
+                const int iWidth = (pTag->type == FIFFT_SHORT || pTag->type == FIFFT_DAU_PACK16) ? 2 : 4;
+                if(pTag->size() % (iWidth * iNchan) == 0) {
+                    FiffTag::convert_tag_data(pTag, iEndian, FIFFV_NATIVE_ENDIAN);
+                    QByteArray baPayload = FiffCompressedBuffer::compress(pTag->data(),
+                                                                          pTag->type,
+                                                                          iNchan,
+                                                                          pTag->size() / (iWidth * iNchan),
+                                                                          iLevel);
+                    static_cast<QByteArray&>(*pTag) = baPayload;
+                    pTag->type = FIFFT_COMPRESSED_BUFFER;
+                    ++iConverted;
+                } else {
+                    qWarning("Data buffer size does not match %d channels, copied uncompressed.", iNchan);
+                }
+            } else if(bUncompress && pTag->type == FIFFT_COMPRESSED_BUFFER) {
+                QByteArray baData;
+                fiff_int_t iType;
+                qint32 nchan, nsamp;
+                if(!FiffCompressedBuffer::uncompress(pTag->data(), pTag->size(), baData, iType, nchan, nsamp)) {
+                    qCritical("Corrupt compressed data buffer in %s", sFileIn.toUtf8().constData());
+                    return -1;
+                }
+                static_cast<QByteArray&>(*pTag) = baData;
+                pTag->type = iType;
+                FiffTag::convert_tag_data(pTag, FIFFV_NATIVE_ENDIAN, iEndian);
+                ++iConverted;
+            }
+        }
+
+        pTag->next = bLast ? FIFFV_NEXT_NONE : FIFFV_NEXT_SEQ;
+        streamOut.write_tag(pTag, fileOut.pos());
+
+        if(bLast) {
+            break;
+        }
+    }
+
+    return iConverted;
+}
+
+} // namespace
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+//=============================================================================================================
+/**
+ * The function main marks the entry point of the mne_compress_raw application.
+ * By default, main has the storage class extern.
+ *
+ * @param [in] argc  (argument count) is an integer that indicates how many arguments were entered on the command line when the program was started.
+ * @param [in] argv  (argument vector) is an array of pointers to arrays of character objects. The array objects are null-terminated strings, representing the arguments that were entered on the command line when the program was started.
+ * @return the value that was set to exit() (which is 0 if exit() is called via quit()).
+ */
+int main(int argc, char *argv[])
+{
+    qInstallMessageHandler(ApplicationLogger::customLogWriter);
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Converts the raw data buffers of a fiff file to (or from) the compressed buffer format. "
+                                     "Every buffer is compressed on its own, so random access to the data is kept.");
+    parser.addHelpOption();
+
+    QCommandLineOption inOption("in", "The input file <in>.", "in");
+    QCommandLineOption outOption("out", "The output file <out>.", "out");
+    QCommandLineOption uncompressOption("uncompress", "Restore the uncompressed raw data buffers.");
+    QCommandLineOption levelOption("level", "The zlib compression level <level> (0-9).", "level", "6");
+    QCommandLineOption littleEndianOption("little", "The input file is in little-endian byte order.");
+
+    parser.addOption(inOption);
+    parser.addOption(outOption);
+    parser.addOption(uncompressOption);
+    parser.addOption(levelOption);
+    parser.addOption(littleEndianOption);
+
+    parser.process(app);
+
+    if(!parser.isSet(inOption) || !parser.isSet(outOption)) {
+        parser.showHelp(1);
+    }
+
+    if(QFile(parser.value(inOption)).fileName() == QFile(parser.value(outOption)).fileName()) {
+        qCritical("Input and output file must differ.");
+        return 1;
+    }
+
+    bool bOk;
+    int iLevel = parser.value(levelOption).toInt(&bOk);
+    if(!bOk || iLevel < 0 || iLevel > 9) {
+        qCritical("Invalid compression level %s.", parser.value(levelOption).toUtf8().constData());
+        return 1;
+    }
+
+    int iConverted = convertFile(parser.value(inOption),
+                                 parser.value(outOption),
+                                 parser.isSet(uncompressOption),
+                                 iLevel,
+                                 parser.isSet(littleEndianOption));
+    if(iConverted < 0) {
+        return 1;
+    }
+
+    qint64 iSizeIn = QFile(parser.value(inOption)).size();
+    qint64 iSizeOut = QFile(parser.value(outOption)).size();
+    qInfo("%d buffers converted, %lld -> %lld bytes (%.1f %%).",
+          iConverted,
+          iSizeIn,
+          iSizeOut,
+          iSizeIn > 0 ? 100.0 * iSizeOut / iSizeIn : 0.0);
+
+    return 0;
+}
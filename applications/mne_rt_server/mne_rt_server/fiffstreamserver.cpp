@@ -44,6 +44,8 @@
 
 #include "mne_rt_server.h"
 
+#include <fiff/fiff_constants.h>
+
 #include <stdlib.h>
 
 //=============================================================================================================
@@ -61,6 +63,8 @@ using namespace COMMUNICATIONLIB;
 FiffStreamServer::FiffStreamServer(QObject *parent)
 : QTcpServer(parent)
 , m_iNextClientId(0)
+, m_clientBackpressurePolicy(FiffStreamThread::DropOldest)
+, m_iClientMaxQueuedBytes(64 * 1024 * 1024)
 {
 }
 
@@ -78,12 +82,14 @@ void FiffStreamServer::comClist(Command p_command)
     //ToDo JSON
     QString t_sOutput("");
     t_sOutput.append("\tID\tAlias\r\n");
+    m_qClientListMutex.lock();
     QMap<qint32, FiffStreamThread*>::iterator i;
     for (i = this->m_qClientList.begin(); i != this->m_qClientList.end(); ++i)
     {
         QString str = QString("\t%1\t%2\r\n").arg(i.key()).arg(i.value()->getAlias());
         t_sOutput.append(str);
     }
+    m_qClientListMutex.unlock();
     t_sOutput.append("\n");
     qobject_cast<MNERTServer*>(this->parent())->getCommandManager()["clist"].reply(t_sOutput);
 
@@ -298,6 +304,7 @@ QByteArray FiffStreamServer::parseToId(QString& p_sRawId, qint32& p_iParsedId)
         bool t_isInt;
         qint32 t_id = p_sRawId.toInt(&t_isInt);
 
+        QMutexLocker locker(&m_qClientListMutex);
         if(t_isInt && this->m_qClientList.contains(t_id))
         {
             p_iParsedId = t_id;
@@ -352,10 +359,40 @@ void FiffStreamServer::forwardMeasInfo(qint32 ID, const FiffInfo& p_fiffInfo)
 }
 
 //=============================================================================================================
-//ToDo increase preformance --> try inline
+
 void FiffStreamServer::forwardRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRawData)
 {
-    emit remitRawBuffer(m_pMatRawData);
+    bool t_bHasReceiver = false;
+    m_qClientListMutex.lock();
+    for(FiffStreamThread* t_pClient : m_qClientList)
+    {
+        if(t_pClient && t_pClient->isSendingRawBuffer())
+        {
+            t_bHasReceiver = true;
+            break;
+        }
+    }
+    m_qClientListMutex.unlock();
+
+    if(!t_bHasReceiver)
+        return;
+
+    //
+    // Encode the tag once, the clients only queue a reference to the (implicitly shared) block
+    //
+    QByteArray t_blockData;
+    FiffStream t_FiffStreamOut(&t_blockData, QIODevice::WriteOnly);
+    t_FiffStreamOut.write_float(FIFF_DATA_BUFFER, m_pMatRawData->data(), m_pMatRawData->rows()*m_pMatRawData->cols());
+
+    emit remitRawBuffer(t_blockData);
+}
+
+//=============================================================================================================
+
+void FiffStreamServer::setClientBackpressure(FiffStreamThread::BackpressurePolicy policy, qint64 iMaxQueuedBytes)
+{
+    m_clientBackpressurePolicy = policy;
+    m_iClientMaxQueuedBytes = iMaxQueuedBytes;
 }
 
 //=============================================================================================================
@@ -363,8 +400,11 @@ void FiffStreamServer::forwardRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRa
 void FiffStreamServer::incomingConnection(qintptr socketDescriptor)
 {
     FiffStreamThread* t_pStreamThread = new FiffStreamThread(m_iNextClientId, socketDescriptor, this);
+    t_pStreamThread->setBackpressurePolicy(m_clientBackpressurePolicy, m_iClientMaxQueuedBytes);
 
+    m_qClientListMutex.lock();
     m_qClientList.insert(m_iNextClientId, t_pStreamThread);
+    m_qClientListMutex.unlock();
     ++m_iNextClientId;
 
     //when thread has finished it gets deleted
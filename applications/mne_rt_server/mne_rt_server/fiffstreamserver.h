@@ -41,6 +41,8 @@
 // INCLUDES
 //=============================================================================================================
 
+#include "fiffstreamthread.h"
+
 #include <fiff/fiff_info.h>
 #include <communication/rtCommand/commandmanager.h>
 
@@ -48,6 +50,7 @@
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QMutex>
 #include <QStringList>
 #include <QTcpServer>
 
@@ -58,12 +61,6 @@
 namespace RTSERVER
 {
 
-//=============================================================================================================
-// FORWARD DECLARATIONS
-//=============================================================================================================
-
-class FiffStreamThread;
-
 //=============================================================================================================
 /**
  * DECLARE CLASS FiffStreamServer
@@ -98,6 +95,15 @@ public:
      */
     void connectCommands();
 
+    //=========================================================================================================
+    /**
+     * Sets the backpressure of clients which connect from now on.
+     *
+     * @param[in] policy             What to drop when the send queue of a client is full.
+     * @param[in] iMaxQueuedBytes    Maximum number of bytes queued per client.
+     */
+    void setClientBackpressure(FiffStreamThread::BackpressurePolicy policy, qint64 iMaxQueuedBytes);
+
 //    virtual bool parseCommand(QStringList& p_sListCommand, QByteArray& p_blockOutputInfo);
 
 //    //=========================================================================================================
@@ -117,7 +123,13 @@ signals:
     void stopMeasFiffStreamClient(qint32 ID);
 
     void remitMeasInfo(qint32 ID, const FIFFLIB::FiffInfo& p_fiffInfo);
-    void remitRawBuffer(QSharedPointer<Eigen::MatrixXf>);
+    //=========================================================================================================
+    /**
+     * Emitted once per raw buffer with the encoded FIFF_DATA_BUFFER tag, which is shared by all clients.
+     *
+     * @param[in] blockData  The encoded tag.
+     */
+    void remitRawBuffer(const QByteArray& blockData);
 
     void closeFiffStreamServer();
 
@@ -168,8 +180,12 @@ private:
 
     QByteArray parseToId(QString& p_sRawId, qint32& p_iParsedId);
 
+    mutable QMutex                  m_qClientListMutex;     /**< Guards m_qClientList, clients remove themselves and the producer walks it. */
     QMap<qint32, FiffStreamThread*> m_qClientList;
     qint32                          m_iNextClientId;
+
+    FiffStreamThread::BackpressurePolicy    m_clientBackpressurePolicy;     /**< Backpressure policy of new clients. */
+    qint64                                  m_iClientMaxQueuedBytes;        /**< Send queue limit of new clients. */
 };
 
 //=============================================================================================================
@@ -178,7 +194,8 @@ private:
 
 FiffStreamThread* FiffStreamServer::getClient(qint32 id)
 {
-    return m_qClientList[id];
+    QMutexLocker locker(&m_qClientListMutex);
+    return m_qClientList.value(id);
 }
 } // NAMESPACE
 
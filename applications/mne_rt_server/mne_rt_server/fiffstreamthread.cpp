@@ -58,6 +58,7 @@
 //=============================================================================================================
 
 #include <QtNetwork>
+#include <QtEndian>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -67,6 +68,16 @@ using namespace UTILSLIB;
 using namespace RTSERVER;
 using namespace FIFFLIB;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace
+{
+const qint64 SOCKET_WRITE_HIGH_WATER = 256 * 1024;          /**< Bytes kept in the socket write buffer. */
+const qint64 DEFAULT_MAX_QUEUED_BYTES = 64 * 1024 * 1024;   /**< Default send queue limit per client. */
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -76,8 +87,12 @@ FiffStreamThread::FiffStreamThread(qint32 id, int socketDescriptor, QObject *par
 , m_iDataClientId(id)
 , m_sDataClientAlias(QString(""))
 , m_iSocketDescriptor(socketDescriptor)
-, m_bIsSendingRawBuffer(false)
-, m_bIsRunning(false)
+, m_iQueuedBytes(0)
+, m_iMaxQueuedBytes(DEFAULT_MAX_QUEUED_BYTES)
+, m_backpressurePolicy(DropOldest)
+, m_iDroppedBuffers(0)
+, m_bWakeupPending(false)
+, m_iIsSendingRawBuffer(0)
 {
 }
 
@@ -87,27 +102,39 @@ FiffStreamThread::~FiffStreamThread()
 {
     //Remove from client list
     FiffStreamServer* t_pFiffStreamServer = qobject_cast<FiffStreamServer*>(this->parent());
-    if(t_pFiffStreamServer)
+    if(t_pFiffStreamServer) {
+        QMutexLocker locker(&t_pFiffStreamServer->m_qClientListMutex);
         t_pFiffStreamServer->m_qClientList.remove(m_iDataClientId);
+    }
 
-    m_bIsRunning = false;
+    QThread::quit();
     QThread::wait();
 }
 
 //=============================================================================================================
 
+void FiffStreamThread::setBackpressurePolicy(BackpressurePolicy policy, qint64 iMaxQueuedBytes)
+{
+    QMutexLocker locker(&m_qMutex);
+    m_backpressurePolicy = policy;
+    m_iMaxQueuedBytes = iMaxQueuedBytes;
+}
+
+//=============================================================================================================
+
 void FiffStreamThread::startMeas(qint32 ID)
 {
     if(ID == m_iDataClientId)
     {
         qDebug() << "Activate raw buffer sending.";
 
-        m_qMutex.lock();
         // ToDo send start meas
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
+        QByteArray t_blockData;
+        FiffStream t_FiffStreamOut(&t_blockData, QIODevice::WriteOnly);
         t_FiffStreamOut.start_block(FIFFB_RAW_DATA);
-        m_bIsSendingRawBuffer = true;
-        m_qMutex.unlock();
+        enqueueBlock(t_blockData, false);
+
+        m_iIsSendingRawBuffer.storeRelease(1);
     }
 }
 
@@ -120,11 +147,12 @@ void FiffStreamThread::stopMeas(qint32 ID)
     {
         qDebug() << "stop raw buffer sending.";
 
-        m_qMutex.lock();
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
+        m_iIsSendingRawBuffer.storeRelease(0);
+
+        QByteArray t_blockData;
+        FiffStream t_FiffStreamOut(&t_blockData, QIODevice::WriteOnly);
         t_FiffStreamOut.end_block(FIFFB_RAW_DATA);
-        m_bIsSendingRawBuffer = false;
-        m_qMutex.unlock();
+        enqueueBlock(t_blockData, false);
     }
 }
 
@@ -167,54 +195,20 @@ void FiffStreamThread::parseCommand(FiffTag::SPtr p_pTag)
 
 //=============================================================================================================
 
-void FiffStreamThread::sendRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRawData)
+void FiffStreamThread::sendRawBuffer(const QByteArray& blockData)
 {
-    if(m_bIsSendingRawBuffer)
-    {
-//        qDebug() << "Send RawBuffer to client";
-
-        m_qMutex.lock();
-
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
-        t_FiffStreamOut.write_float(FIFF_DATA_BUFFER,m_pMatRawData->data(),m_pMatRawData->rows()*m_pMatRawData->cols());
-
-        m_qMutex.unlock();
-
-    }
-//    else
-//    {
-//        qDebug() << "Send RawBuffer is not activated";
-//    }
+    if(isSendingRawBuffer())
+        enqueueBlock(blockData, true);
 }
 
 //=============================================================================================================
 
-//void FiffStreamThread::sendData(QTcpSocket& p_qTcpSocket)
-//{
-//    if(p_qTcpSocket.state() != QAbstractSocket::UnconnectedState && m_bIsRunning)
-//    {
-//        m_qMutex.lock();
-//        qint32 t_iBlockSize = m_qSendBlock.size();
-//        if(t_iBlockSize > 0)
-//        {
-////            qDebug() << "data available" << t_iBlockSize;
-//            qint32 t_iBytesWritten = p_qTcpSocket.write(m_qSendBlock);
-//            qDebug()<<"[Block to write]"<<t_iBlockSize<<"[bytes has been Written]"<<t_iBytesWritten;
-//            p_qTcpSocket.waitForBytesWritten();
-//        }
-//        m_qMutex.unlock();
-//    }
-//}
-
-//=============================================================================================================
-
 void FiffStreamThread::sendMeasurementInfo(qint32 ID, const FiffInfo& p_fiffInfo)
 {
     if(ID == m_iDataClientId)
     {
-        m_qMutex.lock();
-
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
+        QByteArray t_blockData;
+        FiffStream t_FiffStreamOut(&t_blockData, QIODevice::WriteOnly);
 
 //        qint32 init_info[2];
 //        init_info[0] = FIFF_MNE_RT_CLIENT_ID;
@@ -225,9 +219,9 @@ void FiffStreamThread::sendMeasurementInfo(qint32 ID, const FiffInfo& p_fiffInfo
 //FiffStream::start_writing_raw
 
         p_fiffInfo.writeToStream(&t_FiffStreamOut);
-        m_qMutex.unlock();
+        enqueueBlock(t_blockData, false);
 
-//        qDebug() << "MeasInfo Blocksize: " << m_qSendBlock.size();
+//        qDebug() << "MeasInfo Blocksize: " << t_blockData.size();
     }
 }
 
@@ -235,63 +229,138 @@ void FiffStreamThread::sendMeasurementInfo(qint32 ID, const FiffInfo& p_fiffInfo
 
 void FiffStreamThread::writeClientId()
 {
-    FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
+    QByteArray t_blockData;
+    FiffStream t_FiffStreamOut(&t_blockData, QIODevice::WriteOnly);
 
     t_FiffStreamOut.write_int(FIFF_MNE_RT_CLIENT_ID, &m_iDataClientId);
+    enqueueBlock(t_blockData, false);
 }
 
 //=============================================================================================================
 
-//void FiffStreamThread::readProc(QTcpSocket& p_qTcpSocket)
-//{
-//    FiffStream t_FiffStreamIn(&p_qTcpSocket);
-
-//    //
-//    // Read: Wait 10ms for incomming tag header, read and continue
-//    //
-//    p_qTcpSocket.waitForReadyRead(10);
-
-//    if (p_qTcpSocket.bytesAvailable() >= (int)sizeof(qint32)*4)
-//    {
-//        qDebug() << "goes to read bytes " ;
-//        FiffTag::SPtr t_pTag;
-//        FiffTag::read_tag_info(&t_FiffStreamIn, t_pTag, false);
-
-//        //
-//        // wait until tag size data are available and read the data
-//        //
-//        while (p_qTcpSocket.bytesAvailable() < t_pTag->size())
-//        {
-//            p_qTcpSocket.waitForReadyRead(10);
-//        }
-//        FiffTag::read_tag_data(&t_FiffStreamIn, t_pTag);
-
-//        //
-//        // Parse the tag
-//        //
-//        if(t_pTag->kind == FIFF_MNE_RT_COMMAND)
-//        {
-//            parseCommand(t_pTag);
-//        }
-//    }
-//}
+void FiffStreamThread::enqueueBlock(const QByteArray& blockData, bool bDroppable)
+{
+    bool t_bWakeup = false;
+    bool t_bEnqueue = true;
+    qint64 t_iDropped = 0;
+
+    {
+        QMutexLocker locker(&m_qMutex);
+
+        if(bDroppable && m_iQueuedBytes + blockData.size() > m_iMaxQueuedBytes)
+        {
+            if(m_backpressurePolicy == DropNewest)
+            {
+                t_bEnqueue = false;
+                t_iDropped = 1;
+            }
+            else
+            {
+                // Drop the oldest raw buffers until the new one fits, control tags stay in place
+                for(int i = 0; i < m_lSendQueue.size() && m_iQueuedBytes + blockData.size() > m_iMaxQueuedBytes; )
+                {
+                    if(m_lSendQueue[i].bDroppable)
+                    {
+                        m_iQueuedBytes -= m_lSendQueue[i].data.size();
+                        m_lSendQueue.removeAt(i);
+                        ++t_iDropped;
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+        }
+
+        if(t_bEnqueue)
+        {
+            SendBlock t_block;
+            t_block.data = blockData;
+            t_block.bDroppable = bDroppable;
+            m_lSendQueue.append(t_block);
+            m_iQueuedBytes += blockData.size();
+
+            if(!m_bWakeupPending)
+            {
+                m_bWakeupPending = true;
+                t_bWakeup = true;
+            }
+        }
+
+        // Report the first drop and then every 100th, a slow client should not flood the log
+        if(t_iDropped > 0)
+        {
+            qint64 t_iPrev = m_iDroppedBuffers;
+            m_iDroppedBuffers += t_iDropped;
+            if(t_iPrev == 0 || t_iPrev / 100 != m_iDroppedBuffers / 100)
+                printf("FiffStreamClient (ID %d): client too slow, %lld raw buffers dropped so far\r\n\n", m_iDataClientId, static_cast<long long>(m_iDroppedBuffers));
+        }
+    }
+
+    if(t_bWakeup)
+        emit sendQueueFilled();
+}
 
 //=============================================================================================================
 
-void FiffStreamThread::run()
+void FiffStreamThread::flushSendQueue(QTcpSocket& socket)
 {
-    m_bIsRunning = true;
+    forever
+    {
+        QByteArray t_blockData;
+        {
+            QMutexLocker locker(&m_qMutex);
+            m_bWakeupPending = false;
 
-    FiffStreamServer* t_pParentServer = qobject_cast<FiffStreamServer*>(this->parent());
+            // Keep the rest in the queue, where the backpressure policy can still drop it
+            if(m_lSendQueue.isEmpty() || socket.bytesToWrite() >= SOCKET_WRITE_HIGH_WATER)
+                return;
 
-    connect(t_pParentServer, &FiffStreamServer::remitMeasInfo,
-            this, &FiffStreamThread::sendMeasurementInfo);
-    connect(t_pParentServer, &FiffStreamServer::remitRawBuffer,
-            this, &FiffStreamThread::sendRawBuffer);
-    connect(t_pParentServer, &FiffStreamServer::startMeasFiffStreamClient,
-            this, &FiffStreamThread::startMeas);
-    connect(t_pParentServer, &FiffStreamServer::stopMeasFiffStreamClient,
-            this, &FiffStreamThread::stopMeas);
+            t_blockData = m_lSendQueue.takeFirst().data;
+            m_iQueuedBytes -= t_blockData.size();
+        }
+
+        if(socket.write(t_blockData) != t_blockData.size())
+            return;
+    }
+}
+
+//=============================================================================================================
+
+void FiffStreamThread::readCommands(QTcpSocket& socket)
+{
+    FiffStream t_FiffStreamIn(&socket);
+
+    while(socket.bytesAvailable() >= (int)sizeof(qint32)*4)
+    {
+        //
+        // Peek the tag header and wait for the next readyRead until the data is complete
+        //
+        QByteArray t_header = socket.peek(sizeof(qint32)*4);
+        qint32 t_iSize = static_cast<qint32>(qFromBigEndian<quint32>(reinterpret_cast<const uchar*>(t_header.constData()) + 2*sizeof(qint32)));
+        if(t_iSize < 0 || socket.bytesAvailable() < (qint64)sizeof(qint32)*4 + t_iSize)
+            return;
+
+        FiffTag::SPtr t_pTag;
+        t_FiffStreamIn.read_tag_info(t_pTag, false);
+        t_FiffStreamIn.read_tag_data(t_pTag);
+
+        //
+        // Parse the tag
+        //
+        if(t_pTag->kind == FIFF_MNE_RT_COMMAND)
+        {
+            parseCommand(t_pTag);
+        }
+    }
+}
+
+//=============================================================================================================
+
+void FiffStreamThread::run()
+{
+    FiffStreamServer* t_pParentServer = qobject_cast<FiffStreamServer*>(this->parent());
 
     QTcpSocket t_qTcpSocket;
     if (!t_qTcpSocket.setSocketDescriptor(m_iSocketDescriptor)) {
@@ -306,64 +375,37 @@ void FiffStreamThread::run()
                t_qTcpSocket.peerPort());
     }
 
-    FiffStream t_FiffStreamIn(&t_qTcpSocket);
-
-//    int i = 0;
-    while(t_qTcpSocket.state() != QAbstractSocket::UnconnectedState && m_bIsRunning)
-    {
-        //
-        // Write available data
-        //
-        m_qMutex.lock();
-        qint32 t_iBlockSize = m_qSendBlock.size();
-//        qDebug() << "data available" << t_iBlockSize;
-        if(t_iBlockSize > 0)
-        {
-            qint32 t_iBytesWritten = t_qTcpSocket.write(m_qSendBlock);
-//            qDebug() << ++i<< "[wrote bytes] " << t_iBytesWritten;
-            t_qTcpSocket.waitForBytesWritten();
-            if(t_iBytesWritten == t_iBlockSize)
-            {
-                m_qSendBlock.clear();
-            }
-            else
-            {
-                //we have to store bytes which were not written to the socket, due to writing limit
-                //m_qSendBlock = m_qSendBlock.mid(t_iBytesWritten, t_iBlockSize-t_iBytesWritten);
-                m_qSendBlock.remove(0,t_iBytesWritten); //higher performance then mid
-            }
-        }
-        m_qMutex.unlock();
-
-        //
-        // Read: Wait 10ms for incomming tag header, read and continue
-        //
-        t_qTcpSocket.waitForReadyRead(10);
+    connect(t_pParentServer, &FiffStreamServer::remitMeasInfo,
+            this, &FiffStreamThread::sendMeasurementInfo);
+    connect(t_pParentServer, &FiffStreamServer::startMeasFiffStreamClient,
+            this, &FiffStreamThread::startMeas);
+    connect(t_pParentServer, &FiffStreamServer::stopMeasFiffStreamClient,
+            this, &FiffStreamThread::stopMeas);
 
-        if (t_qTcpSocket.bytesAvailable() >= (int)sizeof(qint32)*4)
-        {
-//            qDebug() << "goes to read bytes " ;
-            FiffTag::SPtr t_pTag;
-            t_FiffStreamIn.read_tag_info(t_pTag, false);
+    // Raw buffers only queue a reference to the shared block in the emitting thread
+    connect(t_pParentServer, &FiffStreamServer::remitRawBuffer,
+            this, &FiffStreamThread::sendRawBuffer, Qt::DirectConnection);
+
+    //
+    // The socket lives in this thread, its event loop drives reading and writing
+    //
+    connect(this, &FiffStreamThread::sendQueueFilled,
+            &t_qTcpSocket, [this, &t_qTcpSocket]() { flushSendQueue(t_qTcpSocket); });
+    connect(&t_qTcpSocket, &QTcpSocket::bytesWritten,
+            &t_qTcpSocket, [this, &t_qTcpSocket]() { flushSendQueue(t_qTcpSocket); });
+    connect(&t_qTcpSocket, &QTcpSocket::readyRead,
+            &t_qTcpSocket, [this, &t_qTcpSocket]() { readCommands(t_qTcpSocket); });
+    connect(&t_qTcpSocket, &QTcpSocket::disconnected,
+            &t_qTcpSocket, [this]() { QThread::quit(); });
+
+    flushSendQueue(t_qTcpSocket);
+    readCommands(t_qTcpSocket);
 
-            //
-            // wait until tag size data are available and read the data
-            //
-            while (t_qTcpSocket.bytesAvailable() < t_pTag->size())
-            {
-                t_qTcpSocket.waitForReadyRead(10);
-            }
-            t_FiffStreamIn.read_tag_data(t_pTag);
+    if(t_qTcpSocket.state() != QAbstractSocket::UnconnectedState)
+        exec();
 
-            //
-            // Parse the tag
-            //
-            if(t_pTag->kind == FIFF_MNE_RT_COMMAND)
-            {
-                parseCommand(t_pTag);
-            }
-        }
-    }
+    disconnect(t_pParentServer, &FiffStreamServer::remitRawBuffer,
+               this, &FiffStreamThread::sendRawBuffer);
 
     t_qTcpSocket.disconnectFromHost();
     if(t_qTcpSocket.state() != QAbstractSocket::UnconnectedState)
@@ -49,9 +49,12 @@
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QAtomicInt>
 #include <QThread>
 #include <QTcpSocket>
 #include <QMutex>
+#include <QList>
+#include <QByteArray>
 #include <QSharedPointer>
 
 //=============================================================================================================
@@ -70,6 +73,14 @@ class FiffStreamThread : public QThread
     Q_OBJECT
 
 public:
+    /**
+     * What to do with raw buffers when a client does not read fast enough.
+     */
+    enum BackpressurePolicy {
+        DropOldest,     /**< Drop the oldest queued raw buffers, keeps the client close to real time. */
+        DropNewest      /**< Drop incoming raw buffers, keeps the queued data contiguous. */
+    };
+
     FiffStreamThread(qint32 id, int socketDescriptor, QObject *parent);
 
     ~FiffStreamThread();
@@ -80,29 +91,64 @@ public:
 
     inline QString getAlias();
 
+    inline bool isSendingRawBuffer() const;
+
+    //=========================================================================================================
+    /**
+     * Sets the backpressure of this client. Control tags are never dropped.
+     *
+     * @param[in] policy             What to drop when the send queue is full.
+     * @param[in] iMaxQueuedBytes    Maximum number of bytes queued for the client.
+     */
+    void setBackpressurePolicy(BackpressurePolicy policy, qint64 iMaxQueuedBytes);
+
+    //=========================================================================================================
+    /**
+     * Queues an encoded raw buffer tag. The block is shared with all other clients, only a reference is queued.
+     * Can be called from any thread.
+     *
+     * @param[in] blockData  The encoded FIFF_DATA_BUFFER tag.
+     */
+    void sendRawBuffer(const QByteArray& blockData);
+
 //    void deactivateRawBufferSending();
 
     void parseCommand(QSharedPointer<FIFFLIB::FiffTag> p_pTag);
 
     void writeClientId();
 
-//    void sendData(QTcpSocket& p_qTcpSocket);
-
 signals:
     void error(QTcpSocket::SocketError socketError);
 
+    //=========================================================================================================
+    /**
+     * Emitted when data was queued for an empty send queue. Wakes up the event loop of the client thread.
+     */
+    void sendQueueFilled();
+
 private:
+    /**
+     * A queued, encoded tag.
+     */
+    struct SendBlock {
+        QByteArray data;    /**< The encoded tag(s), shared between clients. */
+        bool bDroppable;    /**< Whether the block may be dropped under backpressure. */
+    };
+
     qint32 m_iDataClientId;
     QString m_sDataClientAlias;
 
     int m_iSocketDescriptor;
 
-    QMutex m_qMutex;
-    QByteArray m_qSendBlock;
+    QMutex m_qMutex;                            /**< Guards the send queue. */
+    QList<SendBlock> m_lSendQueue;              /**< Blocks waiting for the socket. */
+    qint64 m_iQueuedBytes;                      /**< Number of bytes in m_lSendQueue. */
+    qint64 m_iMaxQueuedBytes;                   /**< Queue limit for raw buffers. */
+    BackpressurePolicy m_backpressurePolicy;    /**< What to drop when the queue limit is reached. */
+    qint64 m_iDroppedBuffers;                   /**< Number of dropped raw buffers. */
+    bool m_bWakeupPending;                      /**< Whether sendQueueFilled is pending. */
 
-    bool m_bIsSendingRawBuffer;
-
-    bool m_bIsRunning;
+    QAtomicInt m_iIsSendingRawBuffer;           /**< Set by the client thread, read by the producer through isSendingRawBuffer(). */
 
     void startMeas(qint32 ID);
 
@@ -110,9 +156,32 @@ private:
 
     void sendMeasurementInfo(qint32 ID, const FIFFLIB::FiffInfo& p_fiffInfo);
 
-    void sendRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRawData);
-    //void readToBuffer1();
-//    void readProc(QTcpSocket& p_qTcpSocket);
+    //=========================================================================================================
+    /**
+     * Appends a block to the send queue and applies the backpressure policy.
+     *
+     * @param[in] blockData      The encoded tag(s).
+     * @param[in] bDroppable     Whether the block may be dropped.
+     */
+    void enqueueBlock(const QByteArray& blockData, bool bDroppable);
+
+    //=========================================================================================================
+    /**
+     * Moves queued blocks into the socket until its write buffer is filled. Runs in the client thread and is
+     * driven by sendQueueFilled and QTcpSocket::bytesWritten.
+     *
+     * @param[in] socket     The client socket.
+     */
+    void flushSendQueue(QTcpSocket& socket);
+
+    //=========================================================================================================
+    /**
+     * Parses all complete tags which are available on the socket. Runs in the client thread and is driven by
+     * QTcpSocket::readyRead.
+     *
+     * @param[in] socket     The client socket.
+     */
+    void readCommands(QTcpSocket& socket);
 };
 
 inline qint32 FiffStreamThread::getID()
@@ -124,6 +193,11 @@ inline QString FiffStreamThread::getAlias()
 {
     return m_sDataClientAlias;
 }
+
+inline bool FiffStreamThread::isSendingRawBuffer() const
+{
+    return m_iIsSendingRawBuffer.loadAcquire() != 0;
+}
 } // NAMESPACE
 
 #endif //FIFFSTREAMTHREAD_H
@@ -42,6 +42,8 @@
 #include "fiffsimulator.h"
 
 #include <utils/generics/circularbuffer.h>
+#include <fiff/fiff_raw_data.h>
+#include <fiff/fiff_stream.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -49,6 +51,7 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QStringList>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -99,106 +102,100 @@ void FiffProducer::run()
 {
     m_bIsRunning = true;
 
-    // reopen file in this thread
-    QFile t_File(m_pFiffSimulator->m_RawInfo.info.filename);
-    FiffStream::SPtr p_pStream(new FiffStream(&t_File));
-    m_pFiffSimulator->m_RawInfo.file = p_pStream;
+    m_pFiffSimulator->mutex.lock();
+    const QStringList lSimFiles = m_pFiffSimulator->m_lSimFiles;
+    const qint32 nchan = m_pFiffSimulator->m_RawInfo.info.nchan;
+    const float fTrueSamplingRate = m_pFiffSimulator->m_TrueSamplingRate;
+    m_pFiffSimulator->mutex.unlock();
 
     //
     //   Set up the reading parameters
     //
-    fiff_int_t from = m_pFiffSimulator->m_RawInfo.first_samp;
-    fiff_int_t to = m_pFiffSimulator->m_RawInfo.last_samp;
-//    float quantum_sec = (float)uiSamplePeriod/1000000.0f; //read and write in 10 sec junks
-    fiff_int_t quantum = m_pFiffSimulator->m_uiBufferSampleSize;//ceil(quantum_sec*m_pFiffSimulator->m_pRawInfo->info.sfreq);
+    fiff_int_t quantum = m_pFiffSimulator->m_uiBufferSampleSize;
 
     qDebug() << "quantum " << quantum;
 
     //
-    //   To read the whole file at once set
-    //
-    //quantum     = to - from + 1;
-    //
-    //
-    //   Read and write all the data
+    //   This thread only prefetches: it reads ahead until the circular buffer is full, the simulator thread
+    //   takes care of the timing. The playlist is replayed in a loop. A buffer which reaches the end of a file
+    //   is completed with the first samples of the next one, so there are no gaps between the files.
     //
+    QFile t_File;
+    FiffRawData t_Raw;
+    qint32 iFile = -1;
+    qint32 iFailedFiles = 0;
+    bool bPlaylistStarted = false;
+    fiff_int_t first = 0;
 
-    fiff_int_t first, last;
     MatrixXd data;
     MatrixXd times;
-
-    first = from;
-
-//    //Calibration - Is taken care of during read_raw_segment(...) later in the code
-//    qint32 nchan = m_pFiffSimulator->m_RawInfo.info.nchan;
-//    MatrixXd cals(1,nchan);
-//    SparseMatrix<double> inv_calsMat(nchan, nchan);
-//    for(qint32 i = 0; i < nchan; ++i)
-//        inv_calsMat.insert(i, i) = 1.0f/m_pFiffSimulator->m_RawInfo.info.chs[i].cal;
-
-    //Not good cause production time is not accurate
-    //loading and thread sleep is longer than thread sleep time - better to have a extra loading thread
-    // ToDo restructure this producer as laoding buffer --> and thread sleep to simulator buffer
-    fiff_int_t t_iDiff;
-    bool t_bRestart = false;
+    MatrixXf matChunk(nchan, quantum);
+    fiff_int_t iFilled = 0;
 
     while(m_bIsRunning)
     {
-        last = first+quantum-1;
-        if (last > to)
-        {
-            t_iDiff = last - to;
-            t_bRestart = true;
-
-            last = to;
-        }
-
-        if (!m_pFiffSimulator->m_RawInfo.read_raw_segment(data,times,first,last))
-        {
-            printf("error during read_raw_segment\n");
-        }
-
-        MatrixXf tmp = data.cast<float>();//(inv_calsMat*data).cast<float>();
-
-        if(t_bRestart)
+        if(iFile < 0 || first > t_Raw.last_samp)
         {
             //
-            // Case end of Simulation: restart file from the beginning and read remaining bytes
+            // Open the next file of the playlist
             //
-            printf("### RESTART Simulation File ###\r\n");
+            if(iFailedFiles >= lSimFiles.size())
+            {
+                qWarning() << "[FiffProducer::run] None of the simulation files can be read. Stopping.";
+                break;
+            }
 
-            first = from;
-            last = first+t_iDiff-1;
+            iFile = (iFile + 1) % lSimFiles.size();
 
-            if (!m_pFiffSimulator->m_RawInfo.read_raw_segment(data,times,first,last))
+            if(iFile == 0 && bPlaylistStarted)
             {
-                printf("error during read_raw_segment\n");
+                printf("### RESTART Simulation File ###\r\n");
             }
+            bPlaylistStarted = true;
 
-            MatrixXf tmp2 = data.cast<float>();//(inv_calsMat*data).cast<float>();
+            t_Raw = FiffRawData();
+            t_File.close();
+            t_File.setFileName(lSimFiles.at(iFile));
 
-            MatrixXf tmp3(tmp.rows(), tmp.cols()+tmp2.cols());
+            if(!FiffStream::setup_read_raw(t_File, t_Raw) || t_Raw.info.nchan != nchan)
+            {
+                qWarning() << "[FiffProducer::run] Skipping simulation file" << lSimFiles.at(iFile) << "- it cannot be read or its channels do not match.";
+                ++iFailedFiles;
+                first = 0;
+                t_Raw.last_samp = -1;
+                continue;
+            }
+
+            if(t_Raw.info.sfreq != fTrueSamplingRate)
+            {
+                qWarning() << "[FiffProducer::run] Simulation file" << lSimFiles.at(iFile) << "has a different sampling rate. It is replayed at" << fTrueSamplingRate << "Hz.";
+            }
 
-            tmp3.block(0,0,tmp.rows(),tmp.cols()) = tmp;
-            tmp3.block(0,tmp.cols(),tmp.rows(),tmp2.cols()) = tmp2;
+            iFailedFiles = 0;
+            first = t_Raw.first_samp;
+        }
 
-            tmp = tmp3;
+        fiff_int_t last = qMin(first + quantum - iFilled - 1, t_Raw.last_samp);
 
-            t_bRestart = false;
-            first += t_iDiff;
+        if (!t_Raw.read_raw_segment(data,times,first,last) || data.rows() != nchan || data.cols() != last-first+1)
+        {
+            printf("error during read_raw_segment\n");
+            data.setZero(nchan, last-first+1);
         }
-        else
+
+        matChunk.block(0, iFilled, nchan, data.cols()) = data.cast<float>();
+        iFilled += data.cols();
+        first = last + 1;
+
+        if(iFilled < quantum)
         {
-            first += quantum;
+            continue;
         }
+        iFilled = 0;
 
         // call blocks until there is free space in the buffer
-        while(!m_pFiffSimulator->m_pRawMatrixBuffer->push(tmp) && m_bIsRunning) {
+        while(!m_pFiffSimulator->m_pRawMatrixBuffer->push(matChunk) && m_bIsRunning) {
             //Do nothing until the circular buffer is ready to accept new data again
         }
     }
-
-    // close datastream in this thread
-//    delete m_pFiffSimulator->m_RawInfo.file;
-//    m_pFiffSimulator->m_RawInfo.file = NULL;
 }
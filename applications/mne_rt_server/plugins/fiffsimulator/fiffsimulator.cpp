@@ -54,6 +54,19 @@
 #include <QFile>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QtMath>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <chrono>
+#include <thread>
+
+#if defined(Q_OS_LINUX)
+#include <time.h>
+#include <errno.h>
+#endif
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -74,6 +87,35 @@ const QString FiffSimulator::Commands::GETBUFSIZE   = "getbufsize";
 const QString FiffSimulator::Commands::ACCEL        = "accel";
 const QString FiffSimulator::Commands::GETACCEL     = "getaccel";
 const QString FiffSimulator::Commands::SIMFILE      = "simfile";
+const QString FiffSimulator::Commands::SPEED        = "speed";
+const QString FiffSimulator::Commands::GETSPEED     = "getspeed";
+const QString FiffSimulator::Commands::JITTER       = "jitter";
+
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+namespace {
+    const double dMaxLagPeriods = 10.0;     /**< Buffers later than this many periods restart the schedule instead of being caught up in a burst. */
+
+    /**
+     * Sleeps until an absolute point in time, so that the time spent between two deadlines does not add up.
+     */
+    void sleepUntil(const std::chrono::steady_clock::time_point& tDeadline)
+    {
+#if defined(Q_OS_LINUX)
+        // steady_clock is CLOCK_MONOTONIC on Linux
+        const qint64 iNs = std::chrono::duration_cast<std::chrono::nanoseconds>(tDeadline.time_since_epoch()).count();
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(iNs / 1000000000);
+        ts.tv_nsec = static_cast<long>(iNs % 1000000000);
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, Q_NULLPTR) == EINTR) {
+        }
+#else
+        std::this_thread::sleep_until(tDeadline);
+#endif
+    }
+}
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -85,9 +127,13 @@ FiffSimulator::FiffSimulator()
 , m_uiBufferSampleSize(200)//(4)
 , m_AccelerationFactor(1.0)
 , m_TrueSamplingRate(0.0)
+, m_fSpeedFactor(1.0)
 , m_pRawMatrixBuffer(NULL)
 , m_bIsRunning(false)
 {
+    m_lSimFiles << m_sResourceDataPath;
+
+    this->readSimulationConfig();
     this->init();
 }
 
@@ -219,15 +265,45 @@ void FiffSimulator::comGetAccel(Command p_command)
 void FiffSimulator::comSimfile(Command p_command)
 {
     //
-    // simulation file
+    // simulation file, several files separated by ';' are replayed one after the other
     //
-    QFile t_file(p_command.pValues()[0].toString());
+    QStringList t_lSimFiles = p_command.pValues()[0].toString().split(';', QString::SkipEmptyParts);
+
+    //
+    // all files are replayed with the measurement info of the first one, so each of them has to be a readable raw
+    // file with the same number of channels and sampling rate
+    //
+    bool t_bFilesValid = !t_lSimFiles.isEmpty();
+    qint32 t_iNchan = 0;
+    float t_fSFreq = 0.0f;
+
+    for(int i = 0; i < t_lSimFiles.size() && t_bFilesValid; ++i)
+    {
+        QFile t_File(t_lSimFiles.at(i));
+        FiffRawData t_Raw;
+
+        if(!t_File.exists() || !FiffStream::setup_read_raw(t_File, t_Raw))
+        {
+            qDebug() << "Not able to read raw info of" << t_lSimFiles.at(i);
+            t_bFilesValid = false;
+        }
+        else if(i == 0)
+        {
+            t_iNchan = t_Raw.info.nchan;
+            t_fSFreq = t_Raw.info.sfreq;
+        }
+        else if(t_Raw.info.nchan != t_iNchan || t_Raw.info.sfreq != t_fSFreq)
+        {
+            qDebug() << "Channels or sampling rate of" << t_lSimFiles.at(i) << "do not match" << t_lSimFiles.first();
+            t_bFilesValid = false;
+        }
+    }
 
     QString t_sResourceDataPathOld = m_sResourceDataPath;
 
-    if(t_file.exists())
+    if(t_bFilesValid)
     {
-        m_sResourceDataPath = p_command.pValues()[0].toString();
+        m_sResourceDataPath = t_lSimFiles.first();
         m_RawInfo = FiffRawData();
 
         if (this->readRawInfo())
@@ -235,6 +311,10 @@ void FiffSimulator::comSimfile(Command p_command)
             m_pFiffProducer->stop();
             this->stop();
 
+            mutex.lock();
+            m_lSimFiles = t_lSimFiles;
+            mutex.unlock();
+
             m_commandManager[Commands::SIMFILE].reply("New simulation file set succefully.\r\n");
         }
         else
@@ -247,7 +327,7 @@ void FiffSimulator::comSimfile(Command p_command)
     }
     else
     {
-        qDebug() << "File does not exist on server!";
+        qDebug() << "Simulation files are not valid on server!";
         m_sResourceDataPath = t_sResourceDataPathOld;
         m_commandManager[Commands::SIMFILE].reply("Simulation file not set.\r\n");
     }
@@ -255,6 +335,96 @@ void FiffSimulator::comSimfile(Command p_command)
 
 //=============================================================================================================
 
+void FiffSimulator::comSpeed(Command p_command)
+{
+    float t_fSpeed = p_command.pValues()[0].toFloat();
+
+    if(t_fSpeed >= 0)
+    {
+        bool t_bWasRunning = m_bIsRunning;
+
+        if(m_bIsRunning)
+        {
+            m_pFiffProducer->stop();
+            this->stop();
+        }
+
+        m_fSpeedFactor = t_fSpeed;
+
+        if(t_bWasRunning)
+            this->start();
+
+        QString str = t_fSpeed > 0 ? QString("\tSet replay speed to %1x\r\n\n").arg(t_fSpeed)
+                                   : QString("\tSet replay speed to as fast as possible\r\n\n");
+
+        m_commandManager[Commands::SPEED].reply(str);
+    }
+    else
+        m_commandManager[Commands::SPEED].reply("Replay speed not set\r\n");
+}
+
+//=============================================================================================================
+
+void FiffSimulator::comGetSpeed(Command p_command)
+{
+    bool t_bCommandIsJson = p_command.isJson();
+    if(t_bCommandIsJson)
+    {
+        //
+        //create JSON help object
+        //
+        QJsonObject t_qJsonObjectRoot;
+        t_qJsonObjectRoot.insert(Commands::SPEED, QJsonValue((double)m_fSpeedFactor));
+        QJsonDocument p_qJsonDocument(t_qJsonObjectRoot);
+
+        m_commandManager[Commands::GETSPEED].reply(p_qJsonDocument.toJson());
+    }
+    else
+    {
+        QString str = QString("\t%1\r\n\n").arg(m_fSpeedFactor);
+        m_commandManager[Commands::GETSPEED].reply(str);
+    }
+}
+
+//=============================================================================================================
+
+void FiffSimulator::comJitter(Command p_command)
+{
+    m_statsMutex.lock();
+    JitterStats t_stats = m_jitterStats;
+    m_statsMutex.unlock();
+
+    double t_dMeanUs = t_stats.iBuffers > 0 ? t_stats.dSumUs / t_stats.iBuffers : 0.0;
+    double t_dStdUs = t_stats.iBuffers > 1 ? qSqrt(qMax(0.0, (t_stats.dSumSqUs - t_stats.iBuffers * t_dMeanUs * t_dMeanUs) / (t_stats.iBuffers - 1))) : 0.0;
+
+    if(p_command.isJson())
+    {
+        QJsonObject t_qJsonObjectRoot;
+        t_qJsonObjectRoot.insert("buffers", QJsonValue((double)t_stats.iBuffers));
+        t_qJsonObjectRoot.insert("mean_us", QJsonValue(t_dMeanUs));
+        t_qJsonObjectRoot.insert("std_us", QJsonValue(t_dStdUs));
+        t_qJsonObjectRoot.insert("max_us", QJsonValue(t_stats.dMaxUs));
+        t_qJsonObjectRoot.insert("overruns", QJsonValue((double)t_stats.iOverruns));
+        t_qJsonObjectRoot.insert("resyncs", QJsonValue((double)t_stats.iResyncs));
+        QJsonDocument p_qJsonDocument(t_qJsonObjectRoot);
+
+        m_commandManager[Commands::JITTER].reply(p_qJsonDocument.toJson());
+    }
+    else
+    {
+        QString str = QString("\tBuffers: %1\r\n\tLateness mean: %2 us\r\n\tLateness std: %3 us\r\n\tLateness max: %4 us\r\n\tOverruns: %5\r\n\tResyncs: %6\r\n\n")
+                      .arg(t_stats.iBuffers)
+                      .arg(t_dMeanUs, 0, 'f', 1)
+                      .arg(t_dStdUs, 0, 'f', 1)
+                      .arg(t_stats.dMaxUs, 0, 'f', 1)
+                      .arg(t_stats.iOverruns)
+                      .arg(t_stats.iResyncs);
+        m_commandManager[Commands::JITTER].reply(str);
+    }
+}
+
+//=============================================================================================================
+
 void FiffSimulator::connectCommandManager()
 {
     //Connect slots
@@ -263,6 +433,9 @@ void FiffSimulator::connectCommandManager()
     QObject::connect(&m_commandManager[Commands::ACCEL], &Command::executed, this, &FiffSimulator::comAccel);
     QObject::connect(&m_commandManager[Commands::GETACCEL], &Command::executed, this, &FiffSimulator::comGetAccel);
     QObject::connect(&m_commandManager[Commands::SIMFILE], &Command::executed, this, &FiffSimulator::comSimfile);
+    QObject::connect(&m_commandManager[Commands::SPEED], &Command::executed, this, &FiffSimulator::comSpeed);
+    QObject::connect(&m_commandManager[Commands::GETSPEED], &Command::executed, this, &FiffSimulator::comGetSpeed);
+    QObject::connect(&m_commandManager[Commands::JITTER], &Command::executed, this, &FiffSimulator::comJitter);
 }
 
 //=============================================================================================================
@@ -281,7 +454,7 @@ const char* FiffSimulator::getName() const
 
 //=============================================================================================================
 
-void FiffSimulator::init()
+void FiffSimulator::readSimulationConfig()
 {
     //
     // Read cfg file
@@ -291,6 +464,7 @@ void FiffSimulator::init()
     {
         QTextStream in(&t_qFile);
         QString key = "simFile = ";
+        QStringList t_lSimFiles;
         while (!in.atEnd()) {
             QString line = in.readLine();
             if(line.contains(key, Qt::CaseInsensitive))
@@ -304,17 +478,31 @@ void FiffSimulator::init()
 
                 if (t_qFileMeas.open(QIODevice::ReadOnly))
                 {
-                    m_sResourceDataPath = sFileName;
-                    qInfo() << "[FiffSimulator::init] Load simulation file " << sFileName;
+                    t_lSimFiles << sFileName;
+                    qInfo() << "[FiffSimulator::readSimulationConfig] Load simulation file " << sFileName;
                     t_qFileMeas.close();
                 } else {
-                    qInfo() << "[FiffSimulator::init] Trying to open simulation file " << sFileName << "read from FiffSimulation.cfg failed. Opening sample_audvis_raw.fif instead.";
+                    qInfo() << "[FiffSimulator::readSimulationConfig] Trying to open simulation file " << sFileName << "read from FiffSimulation.cfg failed. Opening sample_audvis_raw.fif instead.";
                 }
             }
         }
         t_qFile.close();
+
+        //Several simFile entries are replayed one after the other
+        if(!t_lSimFiles.isEmpty())
+        {
+            m_sResourceDataPath = t_lSimFiles.first();
+            mutex.lock();
+            m_lSimFiles = t_lSimFiles;
+            mutex.unlock();
+        }
     }
+}
 
+//=============================================================================================================
+
+void FiffSimulator::init()
+{
     if(m_pRawMatrixBuffer)
         delete m_pRawMatrixBuffer;
     m_pRawMatrixBuffer = NULL;
@@ -374,6 +562,7 @@ bool FiffSimulator::readRawInfo()
         {
             printf("Error: Not able to read raw info!\n");
             m_RawInfo.clear();
+            mutex.unlock();
             return false;
         }
 
@@ -480,23 +669,74 @@ void FiffSimulator::run()
 {
     m_bIsRunning = true;
 
-    float t_fSamplingFrequency = m_RawInfo.info.sfreq;
-    float t_fBuffSampleSize = (float)m_uiBufferSampleSize;
+    m_statsMutex.lock();
+    m_jitterStats = JitterStats();
+    m_statsMutex.unlock();
 
-    quint32 uiSamplePeriod = (unsigned int) ((t_fBuffSampleSize/t_fSamplingFrequency)*1000000.0f);
+    //
+    // Every buffer has an absolute deadline, measured from the first one. Time spent in emitting and waiting
+    // for data therefore does not accumulate. A speed factor of 0 sends the buffers as fast as possible.
+    //
+    double t_dPeriodNs = 0.0;
+    if(m_fSpeedFactor > 0 && m_RawInfo.info.sfreq > 0)
+    {
+        t_dPeriodNs = (double)m_uiBufferSampleSize / ((double)m_RawInfo.info.sfreq * m_fSpeedFactor) * 1.0e9;
+    }
+
+    std::chrono::steady_clock::time_point t_tStart;
+    qint64 t_iBuffer = -1;
 
-//    quint32 count = 0;
     Eigen::MatrixXf matData;
 
     while(m_bIsRunning)
     {
         if(m_pRawMatrixBuffer->pop(matData) ) {
+            if(t_dPeriodNs > 0.0) {
+                if(t_iBuffer < 0) {
+                    t_tStart = std::chrono::steady_clock::now();
+                    t_iBuffer = 0;
+                }
+
+                const std::chrono::steady_clock::time_point t_tDeadline = t_tStart + std::chrono::nanoseconds((qint64)(t_iBuffer * t_dPeriodNs));
+                sleepUntil(t_tDeadline);
+
+                const std::chrono::steady_clock::time_point t_tNow = std::chrono::steady_clock::now();
+                const qint64 t_iLatenessNs = std::chrono::duration_cast<std::chrono::nanoseconds>(t_tNow - t_tDeadline).count();
+                updateJitterStats(t_iLatenessNs, t_dPeriodNs);
+
+                ++t_iBuffer;
+
+                // After a long stall start a new schedule, a burst of buffers would distort the timing downstream
+                if(t_iLatenessNs > dMaxLagPeriods * t_dPeriodNs) {
+                    t_tStart = t_tNow;
+                    t_iBuffer = 1;
+
+                    m_statsMutex.lock();
+                    ++m_jitterStats.iResyncs;
+                    m_statsMutex.unlock();
+                }
+            }
+
             QSharedPointer<Eigen::MatrixXf> t_pRawBuffer(new Eigen::MatrixXf(matData));
-            //        ++count;
-            //        printf("%d raw buffer (%d x %d) generated\r\n", count, t_pRawBuffer->rows(), t_pRawBuffer->cols());
 
             emit remitRawBuffer(t_pRawBuffer);
-            usleep(uiSamplePeriod);
         }
     }
 }
+
+//=============================================================================================================
+
+void FiffSimulator::updateJitterStats(qint64 iLatenessNs,
+                                      double dPeriodNs)
+{
+    const double dLatenessUs = iLatenessNs / 1000.0;
+
+    QMutexLocker locker(&m_statsMutex);
+    ++m_jitterStats.iBuffers;
+    m_jitterStats.dSumUs += dLatenessUs;
+    m_jitterStats.dSumSqUs += dLatenessUs * dLatenessUs;
+    m_jitterStats.dMaxUs = qMax(m_jitterStats.dMaxUs, dLatenessUs);
+    if(iLatenessNs > dPeriodNs) {
+        ++m_jitterStats.iOverruns;
+    }
+}
@@ -52,6 +52,7 @@
 //=============================================================================================================
 
 #include <QString>
+#include <QStringList>
 #include <QMutex>
 
 //=============================================================================================================
@@ -94,6 +95,22 @@ public:
         static const QString ACCEL;
         static const QString GETACCEL;
         static const QString SIMFILE;
+        static const QString SPEED;
+        static const QString GETSPEED;
+        static const QString JITTER;
+    };
+
+    /**
+     * Timing statistics of the replay, i.e., how late the buffers were sent compared to their deadlines.
+     */
+    struct JitterStats
+    {
+        qint64  iBuffers = 0;           /**< Number of paced buffers. */
+        double  dSumUs = 0.0;           /**< Sum of the lateness in microseconds. */
+        double  dSumSqUs = 0.0;         /**< Sum of the squared lateness in microseconds. */
+        double  dMaxUs = 0.0;           /**< Maximum lateness in microseconds. */
+        qint64  iOverruns = 0;          /**< Buffers which were later than one buffer period. */
+        qint64  iResyncs = 0;           /**< Number of times the schedule was restarted after falling far behind. */
     };
 
     //=========================================================================================================
@@ -164,6 +181,47 @@ private:
      */
     void comSimfile(COMMUNICATIONLIB::Command p_command);
 
+    //=========================================================================================================
+    /**
+     * Sets the replay speed. 1 replays in real time, 10 ten times faster and 0 as fast as possible.
+     *
+     * @param[in] p_command  The replay speed command.
+     */
+    void comSpeed(COMMUNICATIONLIB::Command p_command);
+
+    //=========================================================================================================
+    /**
+     * Returns the replay speed
+     *
+     * @param[in] p_command  The replay speed command.
+     */
+    void comGetSpeed(COMMUNICATIONLIB::Command p_command);
+
+    //=========================================================================================================
+    /**
+     * Returns the jitter statistics of the current replay
+     *
+     * @param[in] p_command  The jitter command.
+     */
+    void comJitter(COMMUNICATIONLIB::Command p_command);
+
+    //=========================================================================================================
+    /**
+     * Adds the lateness of a sent buffer to the jitter statistics.
+     *
+     * @param[in] iLatenessNs    How late the buffer was sent, in nanoseconds.
+     * @param[in] dPeriodNs      The buffer period in nanoseconds.
+     */
+    void updateJitterStats(qint64 iLatenessNs,
+                           double dPeriodNs);
+
+    //=========================================================================================================
+    /**
+     * Reads the simulation files from FiffSimulation.cfg. Called once on construction, so a playlist set with the
+     * simfile command is kept when the simulator is restarted.
+     */
+    void readSimulationConfig();
+
     //=========================================================================================================
     /**
      * Initialise the FiffSimulator.
@@ -177,14 +235,18 @@ private:
     bool readRawInfo();
 
     QMutex mutex;
+    QMutex                                  m_statsMutex;           /**< Guards the jitter statistics. */
 
     FiffProducer*                           m_pFiffProducer;        /**< Holds the DataProducer.*/
     UTILSLIB::CircularBuffer_Matrix_float*  m_pRawMatrixBuffer;     /**< The Circular Raw Matrix Buffer. */
     FIFFLIB::FiffRawData                    m_RawInfo;              /**< Holds the fiff raw measurement information. */
     QString                                 m_sResourceDataPath;    /**< Holds the path to the Fiff resource simulation file directory.*/
+    QStringList                             m_lSimFiles;            /**< The simulation files which are replayed in a loop. The first one provides the measurement info.*/
     quint32                                 m_uiBufferSampleSize;   /**< Sample size of the buffer */
     float                                   m_AccelerationFactor;   /**< Acceleration factor to simulate different sampling rates. */
     float                                   m_TrueSamplingRate;     /**< The true sampling rate of the fif file. */
+    float                                   m_fSpeedFactor;         /**< Replay speed relative to the (accelerated) sampling rate, 0 replays as fast as possible. */
+    JitterStats                             m_jitterStats;          /**< Timing statistics of the current replay. */
     bool                                    m_bIsRunning;           /**< Flag whether the producer is running.*/
 };
 } // NAMESPACE
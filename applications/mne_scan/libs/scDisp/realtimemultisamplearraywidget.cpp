@@ -53,6 +53,7 @@
 #include <disp/viewers/triggerdetectionview.h>
 
 #include <scMeas/realtimemultisamplearray.h>
+#include <scMeas/pipelinemonitor.h>
 
 #include <rtprocessing/helpers/filterkernel.h>
 
@@ -121,19 +122,34 @@ void RealTimeMultiSampleArrayWidget::update(SCMEASLIB::Measurement::SPtr pMeasur
 {
     if(!m_pRTMSA) {
         m_pRTMSA = qSharedPointerDynamicCast<RealTimeMultiSampleArray>(pMeasurement);
+
+        if(m_pRTMSA) {
+            m_sStageName = QString("Display - %1").arg(m_pRTMSA->getName());
+        }
     }
 
     if(m_pRTMSA) {
+        const QList<SampleBlock> lSampleBlocks = m_pRTMSA->getMultiSampleBlocks();
+
         if(m_pRTMSA->isChInit() && !m_pFiffInfo) {
             m_pFiffInfo = m_pRTMSA->info();
-            m_iMaxFilterTapSize = m_pRTMSA->getMultiSampleArray().first().cols();
+            m_iMaxFilterTapSize = lSampleBlocks.first().cols();
 
             if(!m_bDisplayWidgetsInitialized) {
                 initDisplayControllWidgets();
             }
-        } else if (!m_pRTMSA->getMultiSampleArray().isEmpty()) {
-            //Add data to table view
-            m_pChannelDataView->addData(m_pRTMSA->getMultiSampleArray());
+        } else if (!lSampleBlocks.isEmpty()) {
+            qint64 iStart = PipelineMonitor::currentTime();
+
+            //Add data to table view. The shared blocks are passed one by one, so they are not copied into a temporary list.
+            for(const SampleBlock& block : lSampleBlocks) {
+                m_pChannelDataView->addData(block.data());
+            }
+
+            PipelineMonitor::recordStage(m_sStageName,
+                                         iStart,
+                                         PipelineMonitor::currentTime(),
+                                         lSampleBlocks.first().timestamp());
         }
     }
 }
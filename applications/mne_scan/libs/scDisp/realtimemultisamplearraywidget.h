@@ -172,6 +172,8 @@ private:
 
     QSharedPointer<FIFFLIB::FiffInfo>                       m_pFiffInfo;                    /**< FiffInfo, which is used insteadd of ListChInfo*/
 
+    QString                                                 m_sStageName;                   /**< Name of the display in the pipeline statistics. */
+
     QPointer<QAction>                                       m_pActionSelectSensors;         /**< show roi select widget */
     QPointer<QAction>                                       m_pActionHideBad;               /**< Hide bad channels. */
 
@@ -0,0 +1,405 @@
+//=============================================================================================================
+/**
+ * @file     pipelinemonitor.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the PipelineMonitor class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "pipelinemonitor.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QAtomicInt>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCMEASLIB;
+using namespace UTILSLIB;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+const int NUMBER_HISTOGRAM_BINS = 32;       /**< Latency histogram bins, the last bin holds everything above 35 minutes. */
+const int MAX_NUMBER_TRACE_EVENTS = 131072; /**< Only the most recent trace events are kept. */
+
+//=============================================================================================================
+/**
+ * A recorded trace event. Complete events ('X') hold the processing duration, counter events ('C') the queue size.
+ */
+struct TraceEvent
+{
+    int     iStage;
+    char    cPhase;
+    qint64  iTimestamp;
+    qint64  iValue;
+    qint64  iLatency;
+};
+
+//=============================================================================================================
+/**
+ * The state of the monitor, shared by all threads.
+ */
+struct MonitorData
+{
+    MonitorData()
+    : iNextEvent(0)
+    , bEventsWrapped(false)
+    {
+        vecEvents.resize(MAX_NUMBER_TRACE_EVENTS);
+    }
+
+    QMutex                          mutex;
+    QHash<QString,int>              hashStageIndices;
+    QList<PipelineStageStatistics>  lStages;
+    QVector<TraceEvent>             vecEvents;
+    int                             iNextEvent;
+    bool                            bEventsWrapped;
+};
+
+QAtomicInt g_iEnabled(0);
+
+//=============================================================================================================
+
+MonitorData& monitorData()
+{
+    static MonitorData data;
+    return data;
+}
+
+//=============================================================================================================
+
+QElapsedTimer startedTimer()
+{
+    QElapsedTimer timer;
+    timer.start();
+    return timer;
+}
+
+//=============================================================================================================
+
+int stageIndex(MonitorData& data,
+               const QString& sStage)
+{
+    QHash<QString,int>::const_iterator it = data.hashStageIndices.constFind(sStage);
+
+    if(it != data.hashStageIndices.constEnd()) {
+        return it.value();
+    }
+
+    PipelineStageStatistics stage;
+    stage.sName = sStage;
+    data.lStages.append(stage);
+    data.hashStageIndices.insert(sStage, data.lStages.size() - 1);
+
+    return data.lStages.size() - 1;
+}
+
+//=============================================================================================================
+
+void addTraceEvent(MonitorData& data,
+                   const TraceEvent& event)
+{
+    data.vecEvents[data.iNextEvent] = event;
+
+    if(++data.iNextEvent == MAX_NUMBER_TRACE_EVENTS) {
+        data.iNextEvent = 0;
+        data.bEventsWrapped = true;
+    }
+}
+
+} // NAMESPACE
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+PipelineStageStatistics::PipelineStageStatistics()
+: iNumBlocks(0)
+, iProcessingTimeTotal(0)
+, iProcessingTimeMax(0)
+, iNumLatencies(0)
+, iLatencyTotal(0)
+, iLatencyMax(0)
+, vecLatencyHistogram(NUMBER_HISTOGRAM_BINS, 0)
+, bHasQueue(false)
+{
+    queueStatistics = CircularBufferStatistics();
+}
+
+//=============================================================================================================
+
+double PipelineStageStatistics::processingTimeMean() const
+{
+    return iNumBlocks > 0 ? double(iProcessingTimeTotal) / double(iNumBlocks) : 0.0;
+}
+
+//=============================================================================================================
+
+double PipelineStageStatistics::latencyMean() const
+{
+    return iNumLatencies > 0 ? double(iLatencyTotal) / double(iNumLatencies) : 0.0;
+}
+
+//=============================================================================================================
+
+qint64 PipelineStageStatistics::latencyPercentile(double dPercentile) const
+{
+    if(iNumLatencies == 0) {
+        return 0;
+    }
+
+    qint64 iTarget = qMax(qint64(1), qint64(dPercentile * iNumLatencies + 0.5));
+    qint64 iCount = 0;
+
+    for(int i = 0; i < vecLatencyHistogram.size(); ++i) {
+        iCount += vecLatencyHistogram[i];
+
+        if(iCount >= iTarget) {
+            return qMin(qint64(2) << i, iLatencyMax);
+        }
+    }
+
+    return iLatencyMax;
+}
+
+//=============================================================================================================
+
+qint64 PipelineMonitor::currentTime()
+{
+    static const QElapsedTimer timer = startedTimer();
+    return timer.nsecsElapsed() / 1000;
+}
+
+//=============================================================================================================
+
+void PipelineMonitor::setEnabled(bool bEnabled)
+{
+    g_iEnabled.storeRelease(bEnabled ? 1 : 0);
+}
+
+//=============================================================================================================
+
+bool PipelineMonitor::isEnabled()
+{
+    return g_iEnabled.loadAcquire() != 0;
+}
+
+//=============================================================================================================
+
+void PipelineMonitor::recordStage(const QString& sStage,
+                                  qint64 iStart,
+                                  qint64 iEnd,
+                                  qint64 iAcquisition)
+{
+    if(!isEnabled()) {
+        return;
+    }
+
+    qint64 iDuration = qMax(qint64(0), iEnd - iStart);
+    qint64 iLatency = iAcquisition >= 0 ? qMax(qint64(0), iEnd - iAcquisition) : -1;
+
+    MonitorData& data = monitorData();
+    QMutexLocker locker(&data.mutex);
+
+    int iStage = stageIndex(data, sStage);
+    PipelineStageStatistics& stage = data.lStages[iStage];
+
+    stage.iNumBlocks++;
+    stage.iProcessingTimeTotal += iDuration;
+    stage.iProcessingTimeMax = qMax(stage.iProcessingTimeMax, iDuration);
+
+    if(iLatency >= 0) {
+        int iBin = 0;
+        while(iBin < NUMBER_HISTOGRAM_BINS - 1 && (iLatency >> (iBin + 1)) > 0) {
+            ++iBin;
+        }
+
+        stage.iNumLatencies++;
+        stage.iLatencyTotal += iLatency;
+        stage.iLatencyMax = qMax(stage.iLatencyMax, iLatency);
+        stage.vecLatencyHistogram[iBin]++;
+    }
+
+    TraceEvent event;
+    event.iStage = iStage;
+    event.cPhase = 'X';
+    event.iTimestamp = iStart;
+    event.iValue = iDuration;
+    event.iLatency = iLatency;
+    addTraceEvent(data, event);
+}
+
+//=============================================================================================================
+
+void PipelineMonitor::recordQueue(const QString& sStage,
+                                  const CircularBufferStatistics& stats)
+{
+    if(!isEnabled()) {
+        return;
+    }
+
+    MonitorData& data = monitorData();
+    QMutexLocker locker(&data.mutex);
+
+    int iStage = stageIndex(data, sStage);
+    PipelineStageStatistics& stage = data.lStages[iStage];
+
+    stage.bHasQueue = true;
+    stage.queueStatistics = stats;
+
+    TraceEvent event;
+    event.iStage = iStage;
+    event.cPhase = 'C';
+    event.iTimestamp = currentTime();
+    event.iValue = stats.iSize;
+    event.iLatency = -1;
+    addTraceEvent(data, event);
+}
+
+//=============================================================================================================
+
+QList<PipelineStageStatistics> PipelineMonitor::getStatistics()
+{
+    MonitorData& data = monitorData();
+    QMutexLocker locker(&data.mutex);
+
+    return data.lStages;
+}
+
+//=============================================================================================================
+
+void PipelineMonitor::reset()
+{
+    MonitorData& data = monitorData();
+    QMutexLocker locker(&data.mutex);
+
+    data.hashStageIndices.clear();
+    data.lStages.clear();
+    data.iNextEvent = 0;
+    data.bEventsWrapped = false;
+}
+
+//=============================================================================================================
+
+bool PipelineMonitor::exportChromeTrace(const QString& sFilePath)
+{
+    MonitorData& data = monitorData();
+
+    data.mutex.lock();
+    QList<PipelineStageStatistics> lStages = data.lStages;
+    QVector<TraceEvent> vecEvents;
+
+    if(data.bEventsWrapped) {
+        vecEvents = data.vecEvents.mid(data.iNextEvent) + data.vecEvents.mid(0, data.iNextEvent);
+    } else {
+        vecEvents = data.vecEvents.mid(0, data.iNextEvent);
+    }
+    data.mutex.unlock();
+
+    QJsonArray arrayEvents;
+
+    QJsonObject processName;
+    processName.insert("name", "process_name");
+    processName.insert("ph", "M");
+    processName.insert("pid", 1);
+    processName.insert("args", QJsonObject{{"name", "MNE Scan"}});
+    arrayEvents.append(processName);
+
+    // Every stage gets its own track
+    for(int i = 0; i < lStages.size(); ++i) {
+        QJsonObject threadName;
+        threadName.insert("name", "thread_name");
+        threadName.insert("ph", "M");
+        threadName.insert("pid", 1);
+        threadName.insert("tid", i + 1);
+        threadName.insert("args", QJsonObject{{"name", lStages[i].sName}});
+        arrayEvents.append(threadName);
+    }
+
+    for(const TraceEvent& event : vecEvents) {
+        QJsonObject object;
+        object.insert("pid", 1);
+        object.insert("tid", event.iStage + 1);
+        object.insert("ts", double(event.iTimestamp));
+
+        if(event.cPhase == 'X') {
+            object.insert("name", lStages[event.iStage].sName);
+            object.insert("cat", "stage");
+            object.insert("ph", "X");
+            object.insert("dur", double(event.iValue));
+
+            if(event.iLatency >= 0) {
+                object.insert("args", QJsonObject{{"latency_us", double(event.iLatency)}});
+            }
+        } else {
+            object.insert("name", lStages[event.iStage].sName + " queue");
+            object.insert("cat", "queue");
+            object.insert("ph", "C");
+            object.insert("args", QJsonObject{{"size", double(event.iValue)}});
+        }
+
+        arrayEvents.append(object);
+    }
+
+    QJsonObject trace;
+    trace.insert("traceEvents", arrayEvents);
+    trace.insert("displayTimeUnit", "ms");
+
+    QFile file(sFilePath);
+
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[PipelineMonitor::exportChromeTrace] Could not open" << sFilePath;
+        return false;
+    }
+
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+
+    return true;
+}
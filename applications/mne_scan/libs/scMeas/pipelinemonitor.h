@@ -0,0 +1,197 @@
+//=============================================================================================================
+/**
+ * @file     pipelinemonitor.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Contains the declaration of the PipelineMonitor class.
+ *
+ */
+
+#ifndef PIPELINEMONITOR_H
+#define PIPELINEMONITOR_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "scmeas_global.h"
+
+#include <utils/generics/circularbuffer.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QString>
+#include <QList>
+#include <QVector>
+
+//=============================================================================================================
+// DEFINE NAMESPACE SCMEASLIB
+//=============================================================================================================
+
+namespace SCMEASLIB
+{
+
+//=============================================================================================================
+/**
+ * Accumulated timings of one pipeline stage, e.g. the processing thread or the input of a plugin. All times are
+ * in microseconds of the PipelineMonitor clock.
+ */
+struct SCMEASSHARED_EXPORT PipelineStageStatistics
+{
+    PipelineStageStatistics();
+
+    //=========================================================================================================
+    /**
+     * Returns the mean processing time per block.
+     *
+     * @return the mean processing time in microseconds.
+     */
+    double processingTimeMean() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the mean end-to-end latency, i.e. the time from the acquisition of a block until the stage finished.
+     *
+     * @return the mean latency in microseconds.
+     */
+    double latencyMean() const;
+
+    //=========================================================================================================
+    /**
+     * Estimates a percentile of the end-to-end latency from the histogram. The upper bound of the histogram bin is
+     * returned, so the estimate is at most a factor of two too high.
+     *
+     * @param [in] dPercentile   the percentile in [0,1], e.g. 0.95.
+     *
+     * @return the latency percentile in microseconds.
+     */
+    qint64 latencyPercentile(double dPercentile) const;
+
+    QString                                 sName;                  /**< Name of the stage. */
+    qint64                                  iNumBlocks;             /**< Number of processed blocks. */
+    qint64                                  iProcessingTimeTotal;   /**< Summed processing time. */
+    qint64                                  iProcessingTimeMax;     /**< Maximal processing time. */
+    qint64                                  iNumLatencies;          /**< Number of blocks with an acquisition timestamp. */
+    qint64                                  iLatencyTotal;          /**< Summed end-to-end latency. */
+    qint64                                  iLatencyMax;            /**< Maximal end-to-end latency. */
+    QVector<qint64>                         vecLatencyHistogram;    /**< Latency histogram. Bin i counts latencies in [2^i, 2^(i+1)) microseconds, bin 0 also counts 0. */
+    bool                                    bHasQueue;              /**< Whether queue statistics were reported for this stage. */
+    UTILSLIB::CircularBufferStatistics      queueStatistics;        /**< Latest statistics of the input queue of the stage. */
+};
+
+//=============================================================================================================
+/**
+ * Collects per-stage processing times, end-to-end latencies and queue statistics of the mne_scan pipeline. Sample
+ * blocks are stamped with currentTime() on acquisition, so every stage can report its latency relative to the
+ * acquisition. The recorded events can be exported as Chrome trace JSON (chrome://tracing, Perfetto).
+ * All methods are thread safe.
+ *
+ * @brief Pipeline latency and throughput instrumentation.
+ */
+class SCMEASSHARED_EXPORT PipelineMonitor
+{
+public:
+    //=========================================================================================================
+    /**
+     * Returns the time of the monotonic pipeline clock.
+     *
+     * @return the time in microseconds since the clock was first used.
+     */
+    static qint64 currentTime();
+
+    //=========================================================================================================
+    /**
+     * Enables or disables the instrumentation. Recording is disabled by default and switched on from the pipeline
+     * statistics dock.
+     *
+     * @param [in] bEnabled   whether to record.
+     */
+    static void setEnabled(bool bEnabled);
+
+    //=========================================================================================================
+    /**
+     * Returns whether the instrumentation is enabled.
+     *
+     * @return true if enabled.
+     */
+    static bool isEnabled();
+
+    //=========================================================================================================
+    /**
+     * Records the processing of one block by a stage.
+     *
+     * @param [in] sStage        the name of the stage.
+     * @param [in] iStart        the time at which the processing started (see currentTime()).
+     * @param [in] iEnd          the time at which the processing finished (see currentTime()).
+     * @param [in] iAcquisition  the acquisition time of the block or -1 if not known.
+     */
+    static void recordStage(const QString& sStage,
+                            qint64 iStart,
+                            qint64 iEnd,
+                            qint64 iAcquisition = -1);
+
+    //=========================================================================================================
+    /**
+     * Records the current statistics of the input queue of a stage.
+     *
+     * @param [in] sStage        the name of the stage.
+     * @param [in] stats         the queue statistics.
+     */
+    static void recordQueue(const QString& sStage,
+                            const UTILSLIB::CircularBufferStatistics& stats);
+
+    //=========================================================================================================
+    /**
+     * Returns the accumulated statistics of all stages in the order they were first recorded.
+     *
+     * @return the stage statistics.
+     */
+    static QList<PipelineStageStatistics> getStatistics();
+
+    //=========================================================================================================
+    /**
+     * Clears all statistics and recorded trace events.
+     */
+    static void reset();
+
+    //=========================================================================================================
+    /**
+     * Writes the recorded trace events as Chrome trace JSON. Only the most recent events are kept.
+     *
+     * @param [in] sFilePath     the path of the JSON file.
+     *
+     * @return true if the file was written.
+     */
+    static bool exportChromeTrace(const QString& sFilePath);
+};
+
+} // NAMESPACE
+
+#endif // PIPELINEMONITOR_H
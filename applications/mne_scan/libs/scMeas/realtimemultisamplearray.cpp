@@ -38,6 +38,7 @@
 //=============================================================================================================
 
 #include "realtimemultisamplearray.h"
+#include "pipelinemonitor.h"
 
 #include <iostream>
 
@@ -227,14 +228,44 @@ void RealTimeMultiSampleArray::initFromFiffInfo(FiffInfo::SPtr &p_pFiffInfo)
 
 //=============================================================================================================
 
+QList<MatrixXd> RealTimeMultiSampleArray::getMultiSampleArray() const
+{
+    QMutexLocker locker(&m_qMutex);
+
+    QList<MatrixXd> lMatSamples;
+    lMatSamples.reserve(m_lSampleBlocks.size());
+
+    for(const SampleBlock& block : m_lSampleBlocks) {
+        lMatSamples.append(block.data());
+    }
+
+    return lMatSamples;
+}
+
+//=============================================================================================================
+
 void RealTimeMultiSampleArray::setValue(const MatrixXd& mat)
+{
+    setValue(SampleBlock(mat));
+}
+
+//=============================================================================================================
+
+void RealTimeMultiSampleArray::setValue(MatrixXd&& mat)
+{
+    setValue(SampleBlock(std::move(mat)));
+}
+
+//=============================================================================================================
+
+void RealTimeMultiSampleArray::setValue(const SampleBlock& block)
 {
     if(!m_bChInfoIsInit)
         return;
 
     m_qMutex.lock();
     //check vector size
-    if(mat.rows() != m_qListChInfo.size())
+    if(block.rows() != m_qListChInfo.size())
         qCritical() << "Error Occured in RealTimeMultiSampleArrayNew::setVector: Vector size does not match the number of channels! ";
 
     //ToDo
@@ -245,15 +276,26 @@ void RealTimeMultiSampleArray::setValue(const MatrixXd& mat)
 //        else if(v[i] > m_qListChInfo[i].getMaxValue()) v[i] = m_qListChInfo[i].getMaxValue();
 //    }
 
-    //Store
-    m_matSamples.push_back(mat);
+    //Store - only the reference to the shared samples is added
+    m_lSampleBlocks.push_back(block);
+    bool bNotify = m_lSampleBlocks.size() >= m_iMultiArraySize;
+    qint64 iAcquisition = m_lSampleBlocks.first().timestamp();
+
+    if(m_sStageName.isEmpty()) {
+        m_sStageName = QString("%1 - output").arg(getName());
+    }
+    const QString sStageName = m_sStageName;
 
     m_qMutex.unlock();
-    if(m_matSamples.size() >= m_iMultiArraySize)
+    if(bNotify)
     {
+        //The connected plugins and displays are notified synchronously, so this is the time it takes to hand the data over
+        qint64 iStart = PipelineMonitor::currentTime();
         emit notify();
+        PipelineMonitor::recordStage(sStageName, iStart, PipelineMonitor::currentTime(), iAcquisition);
+
         m_qMutex.lock();
-        m_matSamples.clear();
+        m_lSampleBlocks.clear();
         m_qMutex.unlock();
     }
 }
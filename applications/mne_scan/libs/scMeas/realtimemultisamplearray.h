@@ -43,6 +43,7 @@
 #include "scmeas_global.h"
 #include "measurement.h"
 #include "realtimesamplearraychinfo.h"
+#include "sampleblock.h"
 
 #include <fiff/fiff_info.h>
 
@@ -193,29 +194,56 @@ public:
 
     //=========================================================================================================
     /**
-     * Returns the gathered multi sample array.
+     * Returns a deep copy of the gathered multi sample array. Prefer getMultiSampleBlocks(), which does not copy
+     * the samples.
      *
      * @return the current multi sample array.
      */
-    inline const QList<Eigen::MatrixXd>& getMultiSampleArray();
+    QList<Eigen::MatrixXd> getMultiSampleArray() const;
 
     //=========================================================================================================
     /**
-     * Attaches a value to the sample array list.
+     * Returns the gathered sample blocks. The blocks share their samples with the producer and all other
+     * consumers, so they can be stored (e.g. in a CircularBuffer_SampleBlock) without copying the samples.
+     *
+     * @return the current sample blocks.
+     */
+    inline QList<SampleBlock> getMultiSampleBlocks() const;
+
+    //=========================================================================================================
+    /**
+     * Attaches a value to the sample array list. The matrix is copied once into a new SampleBlock.
      *
      * @param [in] mat   the value which is attached to the sample array list.
      */
     virtual void setValue(const Eigen::MatrixXd& mat);
 
+    //=========================================================================================================
+    /**
+     * Attaches a value to the sample array list. The matrix is moved into a new SampleBlock without copying.
+     *
+     * @param [in] mat   the value which is attached to the sample array list.
+     */
+    virtual void setValue(Eigen::MatrixXd&& mat);
+
+    //=========================================================================================================
+    /**
+     * Attaches a sample block to the sample array list. The samples are shared with the block, not copied.
+     *
+     * @param [in] block   the sample block which is attached to the sample array list.
+     */
+    virtual void setValue(const SampleBlock& block);
+
 private:
     mutable QMutex              m_qMutex;           /**< Mutex to ensure thread safety */
 
     FIFFLIB::FiffInfo::SPtr     m_pFiffInfo_orig;   /**< Original Fiff Info if initialized by fiff info. */
 
     QString                     m_sXMLLayoutFile;   /**< Layout file name. */
+    QString                     m_sStageName;       /**< Name of the hand over in the pipeline statistics, built with the first block. */
     double                      m_dSamplingRate;    /**< Sampling rate of the RealTimeSampleArray.*/
     qint32                      m_iMultiArraySize;  /**< Sample size of the multi sample array.*/
-    QList<Eigen::MatrixXd>      m_matSamples;       /**< The multi sample array.*/
+    QList<SampleBlock>          m_lSampleBlocks;    /**< The multi sample array.*/
     bool                        m_bChInfoIsInit;    /**< If channel info is initialized.*/
 
     QList<RealTimeSampleArrayChInfo> m_qListChInfo; /**< Channel info list.*/
@@ -228,7 +256,7 @@ private:
 inline void RealTimeMultiSampleArray::clear()
 {
     QMutexLocker locker(&m_qMutex);
-    m_matSamples.clear();
+    m_lSampleBlocks.clear();
 }
 
 //=============================================================================================================
@@ -317,9 +345,10 @@ qint32 RealTimeMultiSampleArray::getMultiArraySize() const
 
 //=============================================================================================================
 
-inline const QList<Eigen::MatrixXd>& RealTimeMultiSampleArray::getMultiSampleArray()
+inline QList<SampleBlock> RealTimeMultiSampleArray::getMultiSampleBlocks() const
 {
-    return m_matSamples;
+    QMutexLocker locker(&m_qMutex);
+    return m_lSampleBlocks;
 }
 } // NAMESPACE
 
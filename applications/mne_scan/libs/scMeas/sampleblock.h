@@ -0,0 +1,237 @@
+//=============================================================================================================
+/**
+ * @file     sampleblock.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Contains the declaration of the SampleBlock class.
+ *
+ */
+
+#ifndef SAMPLEBLOCK_H
+#define SAMPLEBLOCK_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "scmeas_global.h"
+
+#include <utils/generics/circularbuffer.h>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedData>
+#include <QSharedDataPointer>
+
+//=============================================================================================================
+// DEFINE NAMESPACE SCMEASLIB
+//=============================================================================================================
+
+namespace SCMEASLIB
+{
+
+//=============================================================================================================
+/**
+ * Reference counted sample block which is passed between plugins. Copies of a SampleBlock share the same
+ * matrix. A deep copy is only made if a holder requests write access via detach() while the data is shared,
+ * so a producer can publish one block to any number of consumers.
+ *
+ * @brief Implicitly shared, copy-on-write block of samples (channels x samples).
+ */
+class SCMEASSHARED_EXPORT SampleBlock
+{
+public:
+    //=========================================================================================================
+    /**
+     * Constructs an empty SampleBlock.
+     */
+    SampleBlock();
+
+    //=========================================================================================================
+    /**
+     * Constructs a SampleBlock holding a copy of the given matrix. The block is stamped with the current time of
+     * the PipelineMonitor clock.
+     *
+     * @param [in] matData   the samples (channels x samples).
+     */
+    explicit SampleBlock(const Eigen::MatrixXd& matData);
+
+    //=========================================================================================================
+    /**
+     * Constructs a SampleBlock by taking over the given matrix without copying it. The block is stamped with the
+     * current time of the PipelineMonitor clock.
+     *
+     * @param [in] matData   the samples (channels x samples).
+     */
+    explicit SampleBlock(Eigen::MatrixXd&& matData);
+
+    //=========================================================================================================
+    /**
+     * Returns the acquisition timestamp, see PipelineMonitor::currentTime().
+     *
+     * @return the acquisition time in microseconds or -1 for an empty block.
+     */
+    inline qint64 timestamp() const;
+
+    //=========================================================================================================
+    /**
+     * Sets the acquisition timestamp. Stages which compute a new block from an incoming one should pass on the
+     * timestamp of the incoming block.
+     *
+     * @param [in] iTimestamp   the acquisition time in microseconds.
+     */
+    inline void setTimestamp(qint64 iTimestamp);
+
+    //=========================================================================================================
+    /**
+     * Returns the samples. The data is not copied, also not if the block is shared.
+     *
+     * @return the samples (channels x samples).
+     */
+    inline const Eigen::MatrixXd& data() const;
+
+    //=========================================================================================================
+    /**
+     * Returns a writable reference to the samples. If the block is shared with other holders, the samples are
+     * copied first, so that the other holders keep seeing the original data.
+     *
+     * @return the writable samples (channels x samples).
+     */
+    inline Eigen::MatrixXd& detach();
+
+    //=========================================================================================================
+    /**
+     * Returns whether the samples are shared with another SampleBlock.
+     *
+     * @return true if the samples are shared.
+     */
+    inline bool isShared() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of rows (channels).
+     *
+     * @return the number of rows.
+     */
+    inline Eigen::Index rows() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of columns (samples).
+     *
+     * @return the number of columns.
+     */
+    inline Eigen::Index cols() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * The shared part of a SampleBlock.
+     */
+    class Data : public QSharedData
+    {
+    public:
+        Data() {}
+        explicit Data(const Eigen::MatrixXd& mat) : matData(mat) {}
+        explicit Data(Eigen::MatrixXd&& mat) : matData(std::move(mat)) {}
+
+        Eigen::MatrixXd matData;    /**< The samples. */
+    };
+
+    QSharedDataPointer<Data>    d;              /**< The shared samples. */
+    qint64                      m_iTimestamp;   /**< The acquisition time in microseconds. */
+};
+
+//=============================================================================================================
+// TYPEDEF
+//=============================================================================================================
+
+typedef UTILSLIB::CircularBuffer<SampleBlock>  CircularBuffer_SampleBlock;     /**< Defines CircularBuffer of SampleBlock type.*/
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline const Eigen::MatrixXd& SampleBlock::data() const
+{
+    return d->matData;
+}
+
+//=============================================================================================================
+
+inline qint64 SampleBlock::timestamp() const
+{
+    return m_iTimestamp;
+}
+
+//=============================================================================================================
+
+inline void SampleBlock::setTimestamp(qint64 iTimestamp)
+{
+    m_iTimestamp = iTimestamp;
+}
+
+//=============================================================================================================
+
+inline Eigen::MatrixXd& SampleBlock::detach()
+{
+    //The non-const access of QSharedDataPointer detaches if the data is shared
+    return d->matData;
+}
+
+//=============================================================================================================
+
+inline bool SampleBlock::isShared() const
+{
+    return d->ref.load() > 1;
+}
+
+//=============================================================================================================
+
+inline Eigen::Index SampleBlock::rows() const
+{
+    return d->matData.rows();
+}
+
+//=============================================================================================================
+
+inline Eigen::Index SampleBlock::cols() const
+{
+    return d->matData.cols();
+}
+} // NAMESPACE
+
+#endif // SAMPLEBLOCK_H
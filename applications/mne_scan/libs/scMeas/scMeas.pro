@@ -84,7 +84,9 @@ SOURCES += \
     realtimecov.cpp \
     realtimehpiresult.cpp \
     realtimespectrum.cpp \
-    realtimefwdsolution.cpp
+    realtimefwdsolution.cpp \
+    sampleblock.cpp \
+    pipelinemonitor.cpp
 
 HEADERS += \
     scmeas_global.h \
@@ -99,7 +101,9 @@ HEADERS += \
     realtimecov.h \
     realtimehpiresult.h \
     realtimespectrum.h \
-    realtimefwdsolution.h
+    realtimefwdsolution.h \
+    sampleblock.h \
+    pipelinemonitor.h
 
 INCLUDEPATH += $${EIGEN_INCLUDE_DIR}
 INCLUDEPATH += $${MNE_INCLUDE_DIR}
@@ -40,11 +40,15 @@
 #include "plugininputconnector.h"
 #include "../Interfaces/IPlugin.h"
 
+#include <scMeas/realtimemultisamplearray.h>
+#include <scMeas/pipelinemonitor.h>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
 
 using namespace SCSHAREDLIB;
+using namespace SCMEASLIB;
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -75,5 +79,30 @@ bool PluginInputConnector::isOutputConnector() const
 
 void PluginInputConnector::update(SCMEASLIB::Measurement::SPtr pMeasurement)
 {
+    if(!PipelineMonitor::isEnabled() || !m_pPlugin) {
+        emit notify(pMeasurement);
+        return;
+    }
+
+    if(m_sStageName.isEmpty()) {
+        m_sStageName = QString("%1 - %2").arg(m_pPlugin->getName()).arg(getName());
+    }
+
+    qint64 iAcquisition = -1;
+
+    if(QSharedPointer<RealTimeMultiSampleArray> pRTMSA = pMeasurement.dynamicCast<RealTimeMultiSampleArray>()) {
+        const QList<SampleBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
+        if(!lSampleBlocks.isEmpty()) {
+            iAcquisition = lSampleBlocks.first().timestamp();
+        }
+    }
+
+    //The hand over includes waiting for free space in the input queue of the plugin
+    qint64 iStart = PipelineMonitor::currentTime();
     emit notify(pMeasurement);
+    PipelineMonitor::recordStage(m_sStageName,
+                                 iStart,
+                                 PipelineMonitor::currentTime(),
+                                 iAcquisition);
 }
@@ -112,6 +112,8 @@ signals:
 public slots:
     void update(SCMEASLIB::Measurement::SPtr pMeasurement);
 
+private:
+    QString m_sStageName;   /**< Name of the hand over in the pipeline statistics, built with the first recorded block. */
 };
 } // NAMESPACE
 
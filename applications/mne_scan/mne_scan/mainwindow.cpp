@@ -55,6 +55,7 @@
 #include "mainwindow.h"
 #include "startupwidget.h"
 #include "plugingui.h"
+#include "pipelinestatisticswidget.h"
 #include "info.h"
 
 //=============================================================================================================
@@ -173,6 +174,7 @@ void MainWindow::setupUI()
     createToolBars();
     createPluginDockWindow();
     createLogDockWindow();
+    createPipelineStatisticsDockWindow();
 
     initStatusBar();
 }
@@ -585,6 +587,9 @@ void MainWindow::createMenus()
     if(m_pDockWidget_Log) {
         m_pMenuView->addAction(m_pDockWidget_Log->toggleViewAction());
     }
+    if(m_pDockWidget_PipelineStatistics) {
+        m_pMenuView->addAction(m_pDockWidget_PipelineStatistics->toggleViewAction());
+    }
     m_pMenuLgLv = m_pMenuView->addMenu(tr("&Log Level"));
     m_pMenuLgLv->addAction(m_pActionMinLgLv);
     m_pMenuLgLv->addAction(m_pActionNormLgLv);
@@ -709,6 +714,24 @@ void MainWindow::createLogDockWindow()
 
 //=============================================================================================================
 
+void MainWindow::createPipelineStatisticsDockWindow()
+{
+    m_pDockWidget_PipelineStatistics = new QDockWidget(tr("Pipeline Statistics"), this);
+    m_pDockWidget_PipelineStatistics->setObjectName("PipelineStatistics");
+
+    PipelineStatisticsWidget* pPipelineStatisticsWidget = new PipelineStatisticsWidget(m_pDockWidget_PipelineStatistics);
+    m_pDockWidget_PipelineStatistics->setWidget(pPipelineStatisticsWidget);
+
+    m_pDockWidget_PipelineStatistics->setAllowedAreas(Qt::BottomDockWidgetArea | Qt::RightDockWidgetArea);
+    addDockWidget(Qt::BottomDockWidgetArea, m_pDockWidget_PipelineStatistics);
+
+    m_pDockWidget_PipelineStatistics->hide();
+
+    m_pMenuView->addAction(m_pDockWidget_PipelineStatistics->toggleViewAction());
+}
+
+//=============================================================================================================
+
 void MainWindow::updatePluginSetupWidget(SCSHAREDLIB::IPlugin::SPtr pPlugin)
 {
     m_qListDynamicPluginActions.clear();
@@ -260,6 +260,12 @@ private:
      */
     void createLogDockWindow();
 
+    //=========================================================================================================
+    /**
+     * Creates the pipeline statistics dock widget.
+     */
+    void createPipelineStatisticsDockWindow();
+
     //=========================================================================================================
     /**
      * Sets the plugin setup widget to central widget of MainWindow class depending on the current plugin
@@ -399,6 +405,7 @@ private:
 
     QPointer<QDockWidget>               m_pPluginGuiDockWidget;         /**< Dock widget which holds the plugin gui. */
     QPointer<QDockWidget>               m_pDockWidget_Log;              /**< Holds the dock widget containing the log.*/
+    QPointer<QDockWidget>               m_pDockWidget_PipelineStatistics;   /**< Holds the dock widget containing the pipeline statistics.*/
 
     QPointer<QToolBar>                  m_pToolBar;                     /**< Holds the tool bar.*/
     QPointer<QToolBar>                  m_pDynamicPluginToolBar;        /**< Holds the plugin tool bar.*/
@@ -141,7 +141,8 @@ SOURCES += \
     pluginitem.cpp \
     plugingui.cpp \
     arrow.cpp \
-    mainwindow.cpp
+    mainwindow.cpp \
+    pipelinestatisticswidget.cpp
 
 HEADERS += \
     info.h \
@@ -151,7 +152,8 @@ HEADERS += \
     pluginitem.h \
     plugingui.h \
     arrow.h \
-    mainwindow.h
+    mainwindow.h \
+    pipelinestatisticswidget.h
 
 FORMS +=
 
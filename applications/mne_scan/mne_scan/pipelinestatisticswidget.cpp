@@ -0,0 +1,229 @@
+//=============================================================================================================
+/**
+ * @file     pipelinestatisticswidget.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the PipelineStatisticsWidget class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "pipelinestatisticswidget.h"
+
+#include <scMeas/pipelinemonitor.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QCheckBox>
+#include <QDateTime>
+#include <QDir>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNESCAN;
+using namespace SCMEASLIB;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+PipelineStatisticsWidget::PipelineStatisticsWidget(QWidget *parent)
+: QWidget(parent)
+, m_pTableWidget(new QTableWidget(this))
+, m_pUpdateTimer(new QTimer(this))
+{
+    QStringList lHeaders;
+    lHeaders << tr("Stage")
+             << tr("Blocks")
+             << tr("Mean time [ms]")
+             << tr("Max time [ms]")
+             << tr("Mean latency [ms]")
+             << tr("95% latency [ms]")
+             << tr("Max latency [ms]")
+             << tr("Queue")
+             << tr("Max queue")
+             << tr("Push timeouts");
+
+    m_pTableWidget->setColumnCount(lHeaders.size());
+    m_pTableWidget->setHorizontalHeaderLabels(lHeaders);
+    m_pTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_pTableWidget->setSelectionMode(QAbstractItemView::NoSelection);
+    m_pTableWidget->verticalHeader()->hide();
+    m_pTableWidget->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_pTableWidget->setToolTip(tr("Time is the processing time per block. Latency is the time from the acquisition of a block until the stage finished it. "
+                                  "A queue which runs full (highlighted) is consumed too slowly by its stage."));
+
+    //Recording costs a clock read and a locked update per block, so it only runs while asked for
+    QCheckBox* pCheckBoxRecord = new QCheckBox(tr("Record statistics"), this);
+    pCheckBoxRecord->setChecked(PipelineMonitor::isEnabled());
+    connect(pCheckBoxRecord, &QCheckBox::toggled,
+            this, &PipelineStatisticsWidget::setRecording);
+
+    QPushButton* pButtonReset = new QPushButton(tr("Reset"), this);
+    connect(pButtonReset, &QPushButton::clicked,
+            this, &PipelineStatisticsWidget::resetStatistics);
+
+    QPushButton* pButtonExport = new QPushButton(tr("Export Chrome Trace..."), this);
+    connect(pButtonExport, &QPushButton::clicked,
+            this, &PipelineStatisticsWidget::exportChromeTrace);
+
+    QHBoxLayout* pButtonLayout = new QHBoxLayout;
+    pButtonLayout->addWidget(pCheckBoxRecord);
+    pButtonLayout->addStretch();
+    pButtonLayout->addWidget(pButtonReset);
+    pButtonLayout->addWidget(pButtonExport);
+
+    QVBoxLayout* pLayout = new QVBoxLayout;
+    pLayout->setMargin(5);
+    pLayout->addWidget(m_pTableWidget);
+    pLayout->addLayout(pButtonLayout);
+    this->setLayout(pLayout);
+
+    connect(m_pUpdateTimer, &QTimer::timeout,
+            this, &PipelineStatisticsWidget::updateStatistics);
+    m_pUpdateTimer->start(1000);
+}
+
+//=============================================================================================================
+
+PipelineStatisticsWidget::~PipelineStatisticsWidget()
+{
+    PipelineMonitor::setEnabled(false);
+}
+
+//=============================================================================================================
+
+void PipelineStatisticsWidget::updateStatistics()
+{
+    if(!isVisible()) {
+        return;
+    }
+
+    QList<PipelineStageStatistics> lStages = PipelineMonitor::getStatistics();
+
+    m_pTableWidget->setRowCount(lStages.size());
+
+    for(int i = 0; i < lStages.size(); ++i) {
+        const PipelineStageStatistics& stage = lStages.at(i);
+
+        QStringList lValues;
+        lValues << stage.sName
+                << QString::number(stage.iNumBlocks)
+                << QString::number(stage.processingTimeMean() / 1000.0, 'f', 2)
+                << QString::number(stage.iProcessingTimeMax / 1000.0, 'f', 2);
+
+        if(stage.iNumLatencies > 0) {
+            lValues << QString::number(stage.latencyMean() / 1000.0, 'f', 1)
+                    << QString::number(stage.latencyPercentile(0.95) / 1000.0, 'f', 1)
+                    << QString::number(stage.iLatencyMax / 1000.0, 'f', 1);
+        } else {
+            lValues << "-" << "-" << "-";
+        }
+
+        if(stage.bHasQueue) {
+            lValues << QString("%1/%2").arg(stage.queueStatistics.iSize).arg(stage.queueStatistics.iCapacity)
+                    << QString::number(stage.queueStatistics.iMaxSize)
+                    << QString::number(stage.queueStatistics.iNumPushTimeouts);
+        } else {
+            lValues << "-" << "-" << "-";
+        }
+
+        //A queue which ran full throttles the upstream stages, so its consumer is the bottleneck
+        bool bSaturated = stage.bHasQueue
+                          && (stage.queueStatistics.iMaxSize >= stage.queueStatistics.iCapacity
+                              || stage.queueStatistics.iNumPushTimeouts > 0);
+
+        for(int j = 0; j < lValues.size(); ++j) {
+            QTableWidgetItem* pItem = m_pTableWidget->item(i, j);
+
+            if(!pItem) {
+                pItem = new QTableWidgetItem;
+                m_pTableWidget->setItem(i, j, pItem);
+            }
+
+            pItem->setText(lValues.at(j));
+            pItem->setBackground(bSaturated ? QBrush(QColor(255, 170, 100)) : QBrush());
+
+            if(j > 0) {
+                pItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            }
+        }
+    }
+}
+
+//=============================================================================================================
+
+void PipelineStatisticsWidget::setRecording(bool bRecord)
+{
+    PipelineMonitor::setEnabled(bRecord);
+}
+
+//=============================================================================================================
+
+void PipelineStatisticsWidget::resetStatistics()
+{
+    PipelineMonitor::reset();
+    m_pTableWidget->setRowCount(0);
+}
+
+//=============================================================================================================
+
+void PipelineStatisticsWidget::exportChromeTrace()
+{
+    QString sFileName = QString("%1/mne_scan_trace_%2.json").arg(QDir::homePath()).arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+
+    sFileName = QFileDialog::getSaveFileName(this,
+                                             tr("Export Chrome Trace"),
+                                             sFileName,
+                                             tr("Chrome trace (*.json)"));
+
+    if(sFileName.isEmpty()) {
+        return;
+    }
+
+    if(!PipelineMonitor::exportChromeTrace(sFileName)) {
+        QMessageBox::warning(this,
+                             tr("Export Chrome Trace"),
+                             tr("The trace could not be written to %1.").arg(sFileName));
+    }
+}
@@ -0,0 +1,124 @@
+//=============================================================================================================
+/**
+ * @file     pipelinestatisticswidget.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Contains the declaration of the PipelineStatisticsWidget class.
+ *
+ */
+
+#ifndef PIPELINESTATISTICSWIDGET_H
+#define PIPELINESTATISTICSWIDGET_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QWidget>
+#include <QSharedPointer>
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+class QTableWidget;
+class QTimer;
+
+//=============================================================================================================
+// DEFINE NAMESPACE MNESCAN
+//=============================================================================================================
+
+namespace MNESCAN
+{
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS PipelineStatisticsWidget
+ *
+ * @brief The PipelineStatisticsWidget shows the live processing times, latencies and queue statistics of all
+ * pipeline stages and exports the recorded events as Chrome trace.
+ */
+class PipelineStatisticsWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    typedef QSharedPointer<PipelineStatisticsWidget> SPtr;               /**< Shared pointer type for PipelineStatisticsWidget. */
+    typedef QSharedPointer<const PipelineStatisticsWidget> ConstSPtr;    /**< Const shared pointer type for PipelineStatisticsWidget. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a PipelineStatisticsWidget which is a child of parent.
+     *
+     * @param [in] parent pointer to parent widget.
+     */
+    PipelineStatisticsWidget(QWidget *parent = 0);
+
+    //=========================================================================================================
+    /**
+     * Destroys the PipelineStatisticsWidget.
+     */
+    ~PipelineStatisticsWidget();
+
+private:
+    //=========================================================================================================
+    /**
+     * Updates the table with the current statistics. Nothing is done while the widget is hidden.
+     */
+    void updateStatistics();
+
+    //=========================================================================================================
+    /**
+     * Switches the recording of the pipeline statistics on or off.
+     *
+     * @param [in] bRecord   whether to record.
+     */
+    void setRecording(bool bRecord);
+
+    //=========================================================================================================
+    /**
+     * Clears all recorded statistics.
+     */
+    void resetStatistics();
+
+    //=========================================================================================================
+    /**
+     * Asks for a file name and exports the recorded events as Chrome trace JSON.
+     */
+    void exportChromeTrace();
+
+    QTableWidget*   m_pTableWidget;     /**< Holds the statistics table. */
+    QTimer*         m_pUpdateTimer;     /**< Holds the timer which refreshes the table. */
+};
+}//NAMESPACE
+
+#endif // PIPELINESTATISTICSWIDGET_H
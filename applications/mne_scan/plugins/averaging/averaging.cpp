@@ -170,12 +170,14 @@ void Averaging::update(SCMEASLIB::Measurement::SPtr pMeasurement)
         MatrixXd matData;
 
         if(m_pFiffInfo) {
-            for(qint32 i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
+            const QList<SampleBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
+            for(const SampleBlock& block : lSampleBlocks) {
                 if(m_pRtAve) {
                     // This extra copy is necessary since the referenced data is getting deleted as soon as
                     // m_pRtAve->append() returns. m_pRtAve->append() returns without a copy since it communicates
                     // via signals with the worker thread of RtCov.
-                    matData = pRTMSA->getMultiSampleArray()[i];
+                    matData = block.data();
                     m_pRtAve->append(matData);
                 }
             }
@@ -44,6 +44,7 @@
 #include <disp/viewers/covariancesettingsview.h>
 
 #include <scMeas/realtimemultisamplearray.h>
+#include <scMeas/pipelinemonitor.h>
 #include <scMeas/realtimecov.h>
 #include <rtprocessing/rtcov.h>
 
@@ -81,7 +82,7 @@ using namespace Eigen;
 
 Covariance::Covariance()
 : m_iEstimationSamples(2000)
-, m_pCircularBuffer(CircularBuffer_Matrix_double::SPtr::create(40))
+, m_pCircularBuffer(CircularBuffer_SampleBlock::SPtr::create(40))
 {
 }
 
@@ -219,11 +220,11 @@ void Covariance::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             initPluginControlWidgets();
         }
 
-        for(qint32 i = 0; i < pRTMSA->getMultiArraySize(); ++i) {
-            // Please note that we do not need a copy here since this function will block until
-            // the buffer accepts new data again. Hence, the data is not deleted in the actual
-            // Measurement function after it emitted the notify signal.
-            while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+        const QList<SampleBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
+        for(const SampleBlock& block : lSampleBlocks) {
+            // Please note that only the reference to the shared samples is pushed, the samples are not copied.
+            while(!m_pCircularBuffer->push(block)) {
                 //Do nothing until the circular buffer is ready to accept new data again
             }
         }
@@ -252,22 +253,29 @@ void Covariance::run()
         msleep(100);
     }
 
-    MatrixXd matData;
+    SampleBlock block;
     FiffCov fiffCov;
     m_mutex.lock();
     int iEstimationSamples = m_iEstimationSamples;
     m_mutex.unlock();
     RTPROCESSINGLIB::RtCov rtCov(m_pFiffInfo);
+    const QString sStageName = getName();
 
     // Start processing data
     while(!isInterruptionRequested()) {
         // Get the current data
-        if(m_pCircularBuffer->pop(matData)) {
+        if(m_pCircularBuffer->pop(block)) {
+            qint64 iStart = PipelineMonitor::currentTime();
+
             m_mutex.lock();
             iEstimationSamples = m_iEstimationSamples;
             m_mutex.unlock();
 
-            fiffCov = rtCov.estimateCovariance(matData, iEstimationSamples);
+            fiffCov = rtCov.estimateCovariance(block.data(), iEstimationSamples);
+
+            PipelineMonitor::recordStage(sStageName, iStart, PipelineMonitor::currentTime(), block.timestamp());
+            PipelineMonitor::recordQueue(sStageName, m_pCircularBuffer->getStatistics());
+
             if(!fiffCov.names.isEmpty()) {
                 m_pCovarianceOutput->data()->setValue(fiffCov);
             }
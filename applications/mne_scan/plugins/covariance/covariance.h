@@ -43,7 +43,7 @@
 #include "covariance_global.h"
 
 #include <scShared/Interfaces/IAlgorithm.h>
-#include <utils/generics/circularbuffer.h>
+#include <scMeas/sampleblock.h>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -155,7 +155,7 @@ private:
     QMutex      m_mutex;
     qint32      m_iEstimationSamples;
 
-    UTILSLIB::CircularBuffer_Matrix_double::SPtr        m_pCircularBuffer;              /**< Matrix data circular buffer */
+    SCMEASLIB::CircularBuffer_SampleBlock::SPtr         m_pCircularBuffer;              /**< Matrix data circular buffer */
 
     QSharedPointer<FIFFLIB::FiffInfo>                   m_pFiffInfo;                    /**< Fiff measurement info.*/
 
@@ -40,6 +40,8 @@
 
 #include "dummytoolbox.h"
 
+#include <scMeas/pipelinemonitor.h>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -65,7 +67,7 @@ using namespace Eigen;
 //=============================================================================================================
 
 DummyToolbox::DummyToolbox()
-: m_pCircularBuffer(CircularBuffer_Matrix_double::SPtr::create(40))
+: m_pCircularBuffer(CircularBuffer_SampleBlock::SPtr::create(40))
 {
 }
 
@@ -113,6 +115,9 @@ void DummyToolbox::unload()
 
 bool DummyToolbox::start()
 {
+    // The queue statistics reported to the pipeline monitor describe the current run
+    m_pCircularBuffer->resetStatistics();
+
     //Start thread
     QThread::start();
 
@@ -174,13 +179,11 @@ void DummyToolbox::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             initPluginControlWidgets();
         }
 
-        MatrixXd matData;
+        const QList<SampleBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
 
-        for(unsigned char i = 0; i < pRTMSA->getMultiArraySize(); ++i) {
-            // Please note that we do not need a copy here since this function will block until
-            // the buffer accepts new data again. Hence, the data is not deleted in the actual
-            // Mesaurement function after it emitted the notify signal.
-            while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+        for(const SampleBlock& block : lSampleBlocks) {
+            // Please note that only the reference to the shared samples is pushed, the samples are not copied.
+            while(!m_pCircularBuffer->push(block)) {
                 //Do nothing until the circular buffer is ready to accept new data again
             }
         }
@@ -210,22 +213,31 @@ void DummyToolbox::initPluginControlWidgets()
 
 void DummyToolbox::run()
 {
-    MatrixXd matData;
+    SampleBlock block;
 
     // Wait for Fiff Info
     while(!m_pFiffInfo) {
         msleep(10);
     }
 
+    const QString sStageName = getName();
+
     while(!isInterruptionRequested()) {
         // Get the current data
-        if(m_pCircularBuffer->pop(matData)) {
-            //ToDo: Implement your algorithm here
+        if(m_pCircularBuffer->pop(block)) {
+            qint64 iStart = PipelineMonitor::currentTime();
+
+            //ToDo: Implement your algorithm here. Use block.data() for read access and block.detach() if the
+            //samples need to be modified in place.
+
+            //Report the processing time and the end-to-end latency to the pipeline statistics
+            PipelineMonitor::recordStage(sStageName, iStart, PipelineMonitor::currentTime(), block.timestamp());
+            PipelineMonitor::recordQueue(sStageName, m_pCircularBuffer->getStatistics());
 
             //Send the data to the connected plugins and the online display
             //Unocmment this if you also uncommented the m_pOutput in the constructor above
             if(!isInterruptionRequested()) {
-                m_pOutput->data()->setValue(matData);
+                m_pOutput->data()->setValue(block);
             }
         }
     }
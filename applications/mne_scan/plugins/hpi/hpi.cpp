@@ -45,6 +45,7 @@
 
 #include <disp/viewers/hpisettingsview.h>
 #include <scMeas/realtimemultisamplearray.h>
+#include <scMeas/pipelinemonitor.h>
 #include <scMeas/realtimehpiresult.h>
 #include <inverse/hpiFit/hpifit.h>
 
@@ -80,7 +81,7 @@ Hpi::Hpi()
 , m_bDoContinousHpi(false)
 , m_bUseSSP(false)
 , m_bUseComp(false)
-, m_pCircularBuffer(CircularBuffer_Matrix_double::SPtr::create(40))
+, m_pCircularBuffer(CircularBuffer_SampleBlock::SPtr::create(40))
 {
     connect(this, &Hpi::devHeadTransAvailable,
             this, &Hpi::onDevHeadTransAvailable, Qt::BlockingQueuedConnection);
@@ -188,8 +189,10 @@ void Hpi::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             initPluginControlWidgets();
         }
 
+        const QList<SampleBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
         // Check if data is present
-        if(pRTMSA->getMultiSampleArray().size() > 0) {
+        if(lSampleBlocks.size() > 0) {
             //If bad channels changed, recalcluate projectors
             updateProjections();
 
@@ -199,17 +202,15 @@ void Hpi::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             m_mutex.unlock();
 
             if(bDoFreqOrder || bDoSingleHpi) {
-                while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[0])) {
+                while(!m_pCircularBuffer->push(lSampleBlocks.first())) {
                     //Do nothing until the circular buffer is ready to accept new data again
                 }
             }
 
             if(m_bDoContinousHpi) {
-                for(unsigned char i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                    // Please note that we do not need a copy here since this function will block until
-                    // the buffer accepts new data again. Hence, the data is not deleted in the actual
-                    // Measurement function after it emitted the notify signal.
-                    while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+                for(const SampleBlock& block : lSampleBlocks) {
+                    // Please note that only the reference to the shared samples is pushed, the samples are not copied.
+                    while(!m_pCircularBuffer->push(block)) {
                         //Do nothing until the circular buffer is ready to accept new data again
                     }
                 }
@@ -486,7 +487,8 @@ void Hpi::run()
     double dRotation = 0.0;
 
     int iDataIndexCounter = 0;
-    MatrixXd matData;
+    SampleBlock block;
+    const QString sStageName = getName();
 
     m_mutex.lock();
     int iNumberOfFitsPerSecond = m_iNumberOfFitsPerSecond;
@@ -503,7 +505,12 @@ void Hpi::run()
         m_mutex.unlock();
 
         //pop matrix
-        if(m_pCircularBuffer->pop(matData)) {
+        if(m_pCircularBuffer->pop(block)) {
+            qint64 iStart = PipelineMonitor::currentTime();
+            const MatrixXd& matData = block.data();
+
+            PipelineMonitor::recordQueue(sStageName, m_pCircularBuffer->getStatistics());
+
             if(iDataIndexCounter + matData.cols() < matDataMerged.cols()) {
                 matDataMerged.block(0, iDataIndexCounter, matData.rows(), matData.cols()) = matData;
                 iDataIndexCounter += matData.cols();
@@ -547,6 +554,8 @@ void Hpi::run()
                            m_pFiffInfo);
                 m_mutex.unlock();
 
+                PipelineMonitor::recordStage(sStageName, iStart, PipelineMonitor::currentTime(), block.timestamp());
+
                 //Check if the error meets distance requirement
                 if(fitResult.errorDistances.size() > 0) {
                     dMeanErrorDist = std::accumulate(fitResult.errorDistances.begin(), fitResult.errorDistances.end(), .0) / fitResult.errorDistances.size();
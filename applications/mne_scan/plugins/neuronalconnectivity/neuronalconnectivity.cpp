@@ -100,7 +100,9 @@ NeuronalConnectivity::NeuronalConnectivity()
     AbstractMetric::m_iNumberBinStart = 0;
     AbstractMetric::m_iNumberBinAmount = 100;
 
-    //Init rt connectivity worker
+    //Init rt connectivity worker. The worker keeps the sliding window and updates it incrementally.
+    m_pRtConnectivity->setSlidingWindow(m_iNumberAverages);
+
     connect(m_pRtConnectivity.data(), &RtConnectivity::newConnectivityResultAvailable,
             this, &NeuronalConnectivity::onNewConnectivityResultAvailable);
 }
@@ -274,30 +276,14 @@ void NeuronalConnectivity::updateSource(SCMEASLIB::Measurement::SPtr pMeasuremen
 
             m_iBlockSize = pRTSE->getValue().first()->data.cols() - iZeroIdx;
 
-            // Check row and colum integrity and restart if necessary
-            if(m_connectivitySettings.size() != 0) {
-                if(m_iBlockSize != m_connectivitySettings.at(0).matData.cols()) {
-                    m_connectivitySettings.clearAllData();
-                    m_pRtConnectivity->restart();
-                }
-            }
-
-            // No copy necessary since we do a deep copy in connectivity settings before the measurement
-            // overwrites the matrix
-            m_connectivitySettings.append(pRTSE->getValue()[i]->data.block(0,
-                                                                           iZeroIdx,
-                                                                           pRTSE->getValue()[i]->data.rows(),
-                                                                           pRTSE->getValue()[i]->data.cols() - iZeroIdx));
-        }
-
-        //Pop data from buffer
-        if(m_connectivitySettings.size() >= m_iNumberAverages) {
-            m_pRtConnectivity->restart();
-            m_connectivitySettings.removeFirst(m_connectivitySettings.size()-m_iNumberAverages);
+            // The worker restarts its window if the block size changes and evicts the oldest trial
+            m_timer.restart();
+            m_pRtConnectivity->append(m_connectivitySettings,
+                                      pRTSE->getValue()[i]->data.block(0,
+                                                                       iZeroIdx,
+                                                                       pRTSE->getValue()[i]->data.rows(),
+                                                                       pRTSE->getValue()[i]->data.cols() - iZeroIdx));
         }
-
-        m_timer.restart();
-        m_pRtConnectivity->append(m_connectivitySettings);
     }
 }
 
@@ -333,22 +319,15 @@ void NeuronalConnectivity::updateRTMSA(SCMEASLIB::Measurement::SPtr pMeasurement
                 m_pFiffInfo = pRTMSA->info();
                 generateNodeVertices();
                 m_iNumberBadChannels = m_pFiffInfo->bads.size();
-                m_pRtConnectivity->restart();
             }
 
             MatrixXd data;
 
-            for(qint32 i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                const MatrixXd& t_mat = pRTMSA->getMultiSampleArray()[i];
-                m_iBlockSize = pRTMSA->getMultiSampleArray()[i].cols();
+            const QList<SampleBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
 
-                // Check row and colum integrity and restart if necessary
-                if(m_connectivitySettings.size() != 0) {
-                    if(m_iBlockSize != m_connectivitySettings.at(0).matData.cols()) {
-                        m_connectivitySettings.clearAllData();
-                        m_pRtConnectivity->restart();
-                    }
-                }
+            for(const SampleBlock& block : lSampleBlocks) {
+                const MatrixXd& t_mat = block.data();
+                m_iBlockSize = t_mat.cols();
 
                 data.resize(m_vecPicks.cols(), t_mat.cols());
 
@@ -356,17 +335,10 @@ void NeuronalConnectivity::updateRTMSA(SCMEASLIB::Measurement::SPtr pMeasurement
                     data.row(j) = t_mat.row(m_vecPicks[j]);
                 }
 
-                m_connectivitySettings.append(data);
+                // Only the new block is transformed, the worker subtracts the evicted trial from its running sums
+                m_timer.restart();
+                m_pRtConnectivity->append(m_connectivitySettings, data);
             }
-
-            //Pop data from buffer
-            if(m_connectivitySettings.size() > m_iNumberAverages) {
-                m_pRtConnectivity->restart();
-                m_connectivitySettings.removeFirst(m_connectivitySettings.size()-m_iNumberAverages);
-            }
-
-            m_timer.restart();
-            m_pRtConnectivity->append(m_connectivitySettings);
         }
     }
 }
@@ -425,14 +397,6 @@ void NeuronalConnectivity::updateRTEV(SCMEASLIB::Measurement::SPtr pMeasurement)
 
                     m_iBlockSize = t_mat.cols();
 
-                    // Check row and colum integrity and restart if necessary
-                    if(m_connectivitySettings.size() != 0) {
-                        if(m_iBlockSize != m_connectivitySettings.at(0).matData.cols()) {
-                            m_connectivitySettings.clearAllData();
-                            m_pRtConnectivity->restart();
-                        }
-                    }
-
                     MatrixXd data;
                     data.resize(m_vecPicks.cols(), t_mat.cols());
 
@@ -440,16 +404,8 @@ void NeuronalConnectivity::updateRTEV(SCMEASLIB::Measurement::SPtr pMeasurement)
                         data.row(j) = t_mat.row(m_vecPicks[j]);
                     }
 
-                    m_connectivitySettings.append(data);
-
-                    //Pop data from buffer
-                    if(m_connectivitySettings.size() > m_iNumberAverages) {
-                        m_pRtConnectivity->restart();
-                        m_connectivitySettings.removeFirst(m_connectivitySettings.size()-m_iNumberAverages);
-                    }
-
                     m_timer.restart();
-                    m_pRtConnectivity->append(m_connectivitySettings);
+                    m_pRtConnectivity->append(m_connectivitySettings, data);
 
                     break;
                 }
@@ -496,6 +452,7 @@ void NeuronalConnectivity::generateNodeVertices()
     //Set node 3D positions to connectivity settings
     m_connectivitySettings.setNodePositions(*m_pFiffInfo, m_vecPicks);
     m_connectivitySettings.clearAllData();
+    m_pRtConnectivity->reset();
 }
 
 //=============================================================================================================
@@ -544,8 +501,7 @@ void NeuronalConnectivity::run()
 void NeuronalConnectivity::onNewConnectivityResultAvailable(const QList<Network>& connectivityResults,
                                                             const ConnectivitySettings& connectivitySettings)
 {
-    m_connectivitySettings = connectivitySettings;
-    m_connectivitySettings.setConnectivityMethods(m_sConnectivityMethods);
+    Q_UNUSED(connectivitySettings)
 
     for(int i = 0; i < connectivityResults.size(); ++i) {
         m_pCircularBuffer->push(connectivityResults.at(i));
@@ -563,8 +519,8 @@ void NeuronalConnectivity::onMetricChanged(const QString& sMetric)
     m_sConnectivityMethods = QStringList() << sMetric;
     m_connectivitySettings.setConnectivityMethods(m_sConnectivityMethods);
     if(m_pRtConnectivity && this->isRunning()) {
-        m_pRtConnectivity->restart();
-        m_pRtConnectivity->append(m_connectivitySettings);
+        // Recompute the current window with the new metric
+        m_pRtConnectivity->append(m_connectivitySettings, MatrixXd());
     }
 }
 
@@ -573,6 +529,7 @@ void NeuronalConnectivity::onMetricChanged(const QString& sMetric)
 void NeuronalConnectivity::onNumberTrialsChanged(int iNumberTrials)
 {
     m_iNumberAverages = iNumberTrials;
+    m_pRtConnectivity->setSlidingWindow(m_iNumberAverages);
 }
 
 //=============================================================================================================
@@ -591,6 +548,7 @@ void NeuronalConnectivity::onTriggerTypeChanged(const QString& triggerType)
 {
     if(triggerType != m_sAvrType) {
         m_connectivitySettings.clearAllData();
+        m_pRtConnectivity->reset();
         m_sAvrType = triggerType;
     }
 }
@@ -53,6 +53,7 @@
 #include <utils/ioutils.h>
 
 #include <scMeas/realtimemultisamplearray.h>
+#include <scMeas/pipelinemonitor.h>
 
 #include "FormFiles/noisereductionsetupwidget.h"
 
@@ -90,7 +91,7 @@ NoiseReduction::NoiseReduction()
 , m_iMaxFilterLength(1)
 , m_iMaxFilterTapSize(-1)
 , m_sCurrentSystem("VectorView")
-, m_pCircularBuffer(QSharedPointer<UTILSLIB::CircularBuffer_Matrix_double>::create(40))
+, m_pCircularBuffer(QSharedPointer<CircularBuffer_SampleBlock>::create(40))
 , m_pNoiseReductionInput(Q_NULLPTR)
 , m_pNoiseReductionOutput(Q_NULLPTR)
 {
@@ -150,6 +151,9 @@ void NoiseReduction::unload()
 
 bool NoiseReduction::start()
 {
+    // The queue statistics reported to the pipeline monitor describe the current run
+    m_pCircularBuffer->resetStatistics();
+
     //Start thread as soon as we have received the first data block. See update().
 
     return true;
@@ -200,38 +204,30 @@ void NoiseReduction::update(SCMEASLIB::Measurement::SPtr pMeasurement)
         if(!m_pFiffInfo) {
             m_pFiffInfo = pRTMSA->info();
 
-            //Init the multiplication matrices
-            m_matSparseProjMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-            m_matSparseCompMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-            m_matSparseSpharaMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-            m_matSparseProjCompMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-            m_matSparseFull = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-
-            m_matSparseProjMult.setIdentity();
-            m_matSparseCompMult.setIdentity();
-            m_matSparseSpharaMult.setIdentity();
-            m_matSparseProjCompMult.setIdentity();
-            m_matSparseFull.setIdentity();
+            //Init the multiplication operators
+            m_projectionOperator.setNumberChannels(m_pFiffInfo->chs.size());
+            m_spharaOperator.setNumberChannels(m_pFiffInfo->chs.size());
+            m_spharaOperator.setStages(ProjectionOperator::Sphara);
 
             //Init output
             m_pNoiseReductionOutput->data()->initFromFiffInfo(m_pFiffInfo);
             m_pNoiseReductionOutput->data()->setMultiArraySize(1);
         }
 
+        const QList<SampleBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
         // Check if data is present
-        if(pRTMSA->getMultiSampleArray().size() > 0) {
+        if(lSampleBlocks.size() > 0) {
             //Init widgets
             if(m_iMaxFilterTapSize == -1) {
-                m_iMaxFilterTapSize = pRTMSA->getMultiSampleArray().first().cols();
+                m_iMaxFilterTapSize = lSampleBlocks.first().cols();
                 initPluginControlWidgets();
                 QThread::start();
             }
 
-            for(unsigned char i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                // Please note that we do not need a copy here since this function will block until
-                // the buffer accepts new data again. Hence, the data is not deleted in the actual
-                // Measurement function after it emitted the notify signal.
-                while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+            for(const SampleBlock& block : lSampleBlocks) {
+                // Please note that only the reference to the shared samples is pushed, the samples are not copied.
+                while(!m_pCircularBuffer->push(block)) {
                     //Do nothing until the circular buffer is ready to accept new data again
                 }
             }
@@ -342,46 +338,55 @@ void NoiseReduction::run()
     createSpharaOperator();
 
     // Init
-    MatrixXd matData;
+    SampleBlock block;
     QScopedPointer<RTPROCESSINGLIB::FilterOverlapAdd> pRtFilter(new RTPROCESSINGLIB::FilterOverlapAdd());
+    const QString sStageName = getName();
 
     while(!isInterruptionRequested()) {
         // Get the current data
-        if(m_pCircularBuffer->pop(matData)) {
+        if(m_pCircularBuffer->pop(block)) {
+            qint64 iStart = PipelineMonitor::currentTime();
+
             m_mutex.lock();
-            //Do SSP's and compensators here
+            //The bad channels are part of the SPHARA operator
+            if(m_bSpharaActive && m_lSpharaBads != m_pFiffInfo->bads) {
+                updateSpharaStage();
+            }
+
+            //Do compensators, SSP's and SPHARA as one fused operator here. SPHARA is applied after filtering if the data is filtered.
+            int iStages = ProjectionOperator::NoStage;
+
             if(m_bCompActivated) {
-                if(m_bProjActivated) {
-                    //Comp + Proj
-                    matData = m_matSparseProjCompMult * matData;
-                } else {
-                    //Comp
-                    matData = m_matSparseCompMult * matData;
-                }
-            } else {
-                if(m_bProjActivated) {
-                    //Proj
-                    matData = m_matSparseProjMult * matData;
-                } else {
-                    //None - Raw
-                }
+                iStages |= ProjectionOperator::Compensator;
+            }
+
+            if(m_bProjActivated) {
+                iStages |= ProjectionOperator::Projector;
+            }
+
+            if(m_bSpharaActive && !m_bFilterActivated) {
+                iStages |= ProjectionOperator::Sphara;
+            }
+
+            m_projectionOperator.setStages(iStages);
+
+            //The block is shared with the other consumers of the input. Only detach (copy) it if it is actually modified.
+            if(!m_projectionOperator.isIdentity()) {
+                m_projectionOperator.apply(block.detach());
             }
 
             //Do temporal filtering here
             if(m_bFilterActivated) {
-                matData = pRtFilter->calculate(matData,
-                                                          m_filterKernel,
-                                                          m_lFilterChannelList);
+                SampleBlock filteredBlock(pRtFilter->calculate(block.data(),
+                                                               m_filterKernel,
+                                                               m_lFilterChannelList));
+                filteredBlock.setTimestamp(block.timestamp());
+                block = filteredBlock;
             }
 
-            //Do SPHARA here
-            if(m_bSpharaActive) {
-                //Set bad channels to zero so they do not get smeared into
-                for(int i = 0; i < m_pFiffInfo->bads.size(); ++i) {
-                    matData.row(m_pFiffInfo->ch_names.indexOf(m_pFiffInfo->bads.at(i))).setZero();
-                }
-
-                matData = m_matSparseSpharaMult * matData;
+            //Do SPHARA on the filtered data here
+            if(m_bSpharaActive && m_bFilterActivated) {
+                m_spharaOperator.apply(block.detach());
             }
 
     //        //Common average
@@ -408,9 +413,12 @@ void NoiseReduction::run()
 
             m_mutex.unlock();
 
+            PipelineMonitor::recordStage(sStageName, iStart, PipelineMonitor::currentTime(), block.timestamp());
+            PipelineMonitor::recordQueue(sStageName, m_pCircularBuffer->getStatistics());
+
             //Send the data to the connected plugins and the display
             if(!isInterruptionRequested()) {
-                m_pNoiseReductionOutput->data()->setValue(matData);
+                m_pNoiseReductionOutput->data()->setValue(block);
             }
         }
     }
@@ -443,32 +451,7 @@ void NoiseReduction::updateProjection(const QList<FIFFLIB::FiffProj>& projs)
             }
         }
 
-        // Make proj sparse
-        qint32 nchan = this->m_pFiffInfo->nchan;
-        qint32 i, k;
-
-        typedef Eigen::Triplet<double> T;
-        std::vector<T> tripletList;
-        tripletList.reserve(nchan);
-
-        tripletList.clear();
-        tripletList.reserve(matProj.rows()*matProj.cols());
-        for(i = 0; i < matProj.rows(); ++i) {
-            for(k = 0; k < matProj.cols(); ++k) {
-                if(matProj(i,k) != 0) {
-                    tripletList.push_back(T(i, k, matProj(i,k)));
-                }
-            }
-        }
-
-        m_matSparseProjMult = SparseMatrix<double>(matProj.rows(),matProj.cols());
-        if(tripletList.size() > 0)
-            m_matSparseProjMult.setFromTriplets(tripletList.begin(), tripletList.end());
-
-        //Create full multiplication matrix
-        m_matSparseProjCompMult = m_matSparseProjMult * m_matSparseCompMult;
-
-        m_matSparseFull = m_matSparseProjMult * m_matSparseCompMult;
+        m_projectionOperator.setProjector(matProj);
         m_mutex.unlock();
     }
 }
@@ -494,37 +477,10 @@ void NoiseReduction::updateCompensator(int to)
         this->m_pFiffInfo->make_compensator(0, to, newComp);//Do this always from 0 since we always read new raw data, we never actually perform a multiplication on already existing data
 
         this->m_pFiffInfo->set_current_comp(to);
-        MatrixXd matComp = newComp.data->data;
-
-        //
-        // Make proj sparse
-        //
-        qint32 nchan = this->m_pFiffInfo->nchan;
-        qint32 i, k;
-
-        typedef Eigen::Triplet<double> T;
-        std::vector<T> tripletList;
-        tripletList.reserve(nchan);
-
-        tripletList.clear();
-        tripletList.reserve(matComp.rows()*matComp.cols());
-        for(i = 0; i < matComp.rows(); ++i) {
-            for(k = 0; k < matComp.cols(); ++k) {
-                if(matComp(i,k) != 0) {
-                    tripletList.push_back(T(i, k, matComp(i,k)));
-                }
-            }
-        }
-
-        m_matSparseCompMult = SparseMatrix<double>(matComp.rows(),matComp.cols());
-        if(tripletList.size() > 0) {
-            m_matSparseCompMult.setFromTriplets(tripletList.begin(), tripletList.end());
-        }
-
-        //Create full multiplication matrix
-        m_matSparseProjCompMult = m_matSparseProjMult * m_matSparseCompMult;
 
-        m_matSparseFull = m_matSparseProjMult * m_matSparseCompMult;
+        m_mutex.lock();
+        m_projectionOperator.setCompensator(newComp.data->data);
+        m_mutex.unlock();
     }
 }
 
@@ -662,55 +618,30 @@ void NoiseReduction::createSpharaOperator()
 //    IOUtils::write_eigen_matrix(matSpharaMultFirst, QString(QCoreApplication::applicationDirPath() + "resources/mne_scan/plugins/noisereduction/SPHARA/matSpharaMultFirst.txt"));
 //    IOUtils::write_eigen_matrix(matSpharaMultSecond, QString(QCoreApplication::applicationDirPath() + "resources/mne_scan/plugins/noisereduction/SPHARA/matSpharaMultSecond.txt"));
 
-    //
-    // Make operators sparse
-    //
-    qint32 nchan = this->m_pFiffInfo->nchan;
-    qint32 i, k;
-
-    typedef Eigen::Triplet<double> T;
-    std::vector<T> tripletList;
-    tripletList.reserve(nchan);
-
-    //First operator
-    tripletList.clear();
-    tripletList.reserve(matSpharaMultFirst.rows()*matSpharaMultFirst.cols());
-    for(i = 0; i < matSpharaMultFirst.rows(); ++i) {
-        for(k = 0; k < matSpharaMultFirst.cols(); ++k) {
-            if(matSpharaMultFirst(i,k) != 0) {
-                tripletList.push_back(T(i, k, matSpharaMultFirst(i,k)));
-            }
-        }
-    }
-
-    SparseMatrix<double> matSparseSpharaMultFirst = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
+    //Create full multiplication matrix
+    m_matSpharaMult = matSpharaMultFirst * matSpharaMultSecond;
 
-    if(tripletList.size() > 0) {
-        matSparseSpharaMultFirst.setFromTriplets(tripletList.begin(), tripletList.end());
-    }
+    updateSpharaStage();
 
-    //Second operator
-    tripletList.clear();
-    tripletList.reserve(matSpharaMultSecond.rows()*matSpharaMultSecond.cols());
+    m_mutex.unlock();
+}
 
-    for(i = 0; i < matSpharaMultSecond.rows(); ++i) {
-        for(k = 0; k < matSpharaMultSecond.cols(); ++k) {
-            if(matSpharaMultSecond(i,k) != 0) {
-                tripletList.push_back(T(i, k, matSpharaMultSecond(i,k)));
-            }
-        }
-    }
+//=============================================================================================================
 
-    SparseMatrix<double>matSparseSpharaMultSecond = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
+void NoiseReduction::updateSpharaStage()
+{
+    //Set bad channels to zero so they do not get smeared into
+    MatrixXd matSphara = m_matSpharaMult;
 
-    if(tripletList.size() > 0) {
-        matSparseSpharaMultSecond.setFromTriplets(tripletList.begin(), tripletList.end());
+    for(int i = 0; i < m_pFiffInfo->bads.size(); ++i) {
+        int index = m_pFiffInfo->ch_names.indexOf(m_pFiffInfo->bads.at(i));
+        if(index >= 0 && index < matSphara.cols()) {
+            matSphara.col(index).setZero();
+        }
     }
 
-    //Create full multiplication matrix
-    m_matSparseSpharaMult = matSparseSpharaMultFirst * matSparseSpharaMultSecond;
-
-    m_matSparseFull = m_matSparseProjMult * m_matSparseCompMult;
+    m_lSpharaBads = m_pFiffInfo->bads;
 
-    m_mutex.unlock();
+    m_projectionOperator.setSphara(matSphara);
+    m_spharaOperator.setSphara(matSphara);
 }
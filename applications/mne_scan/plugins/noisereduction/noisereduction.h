@@ -42,11 +42,12 @@
 
 #include "noisereduction_global.h"
 
-#include <utils/generics/circularbuffer.h>
+#include <scMeas/sampleblock.h>
 
 #include <fiff/fiff_proj.h>
 
 #include <rtprocessing/helpers/filterkernel.h>
+#include <rtprocessing/helpers/projectionoperator.h>
 
 #include <scShared/Interfaces/IAlgorithm.h>
 
@@ -54,11 +55,13 @@
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QStringList>
+
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
 
-#include <Eigen/SparseCore>
+#include <Eigen/Core>
 
 //=============================================================================================================
 // FORWARD DECLARATIONS
@@ -218,6 +221,13 @@ protected:
     void createSpharaOperator();
 
 private:
+    //=========================================================================================================
+    /**
+     * Sets the SPHARA operator with the columns of the bad channels zeroed, so they do not get smeared into
+     * the other channels. Must be called with the mutex locked.
+     */
+    void updateSpharaStage();
+
     QMutex                          m_mutex;                                    /**< The threads mutex.*/
 
     bool                            m_bCompActivated;                           /**< Compensator activated */
@@ -241,11 +251,11 @@ private:
     Eigen::VectorXi                 m_vecIndicesSecondBabyMEG;                  /**< The indices of the channels to pick for the second SPHARA oerpator in case of a BabyMEG system.*/
     Eigen::VectorXi                 m_vecIndicesFirstEEG;                       /**< The indices of the channels to pick for the second SPHARA operator in case of an EEG system.*/
 
-    Eigen::SparseMatrix<double>     m_matSparseSpharaMult;                      /**< The final sparse SPHARA operator .*/
-    Eigen::SparseMatrix<double>     m_matSparseProjCompMult;                    /**< The final sparse projection + compensator operator.*/
-    Eigen::SparseMatrix<double>     m_matSparseProjMult;                        /**< The final sparse SSP projector */
-    Eigen::SparseMatrix<double>     m_matSparseCompMult;                        /**< The final sparse compensator matrix */
-    Eigen::SparseMatrix<double>     m_matSparseFull;                            /**< The final sparse full multiplication matrix  */
+    Eigen::MatrixXd                 m_matSpharaMult;                            /**< The final SPHARA operator.*/
+    QStringList                     m_lSpharaBads;                              /**< The bad channels the SPHARA stage was created with.*/
+
+    RTPROCESSINGLIB::ProjectionOperator m_projectionOperator;                   /**< The fused compensator, SSP and SPHARA operator.*/
+    RTPROCESSINGLIB::ProjectionOperator m_spharaOperator;                       /**< The SPHARA operator applied after filtering.*/
 
     Eigen::MatrixXd                 m_matSpharaVVGradLoaded;                    /**< The loaded VectorView gradiometer basis functions.*/
     Eigen::MatrixXd                 m_matSpharaVVMagLoaded;                     /**< The loaded VectorView magnetometer basis functions.*/
@@ -257,7 +267,7 @@ private:
 
     QSharedPointer<FIFFLIB::FiffInfo>                               m_pFiffInfo;            /**< Fiff measurement info.*/
 
-    QSharedPointer<UTILSLIB::CircularBuffer_Matrix_double>          m_pCircularBuffer;      /**< Holds incoming raw data. */
+    QSharedPointer<SCMEASLIB::CircularBuffer_SampleBlock>           m_pCircularBuffer;      /**< Holds incoming raw data. */
 
     SCSHAREDLIB::PluginInputData<SCMEASLIB::RealTimeMultiSampleArray>::SPtr      m_pNoiseReductionInput;      /**< The RealTimeMultiSampleArray of the NoiseReduction input.*/
     SCSHAREDLIB::PluginOutputData<SCMEASLIB::RealTimeMultiSampleArray>::SPtr     m_pNoiseReductionOutput;     /**< The RealTimeMultiSampleArray of the NoiseReduction output.*/
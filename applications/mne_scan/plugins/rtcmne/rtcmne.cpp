@@ -58,6 +58,7 @@
 
 #include <scMeas/realtimesourceestimate.h>
 #include <scMeas/realtimemultisamplearray.h>
+#include <scMeas/pipelinemonitor.h>
 #include <scMeas/realtimecov.h>
 #include <scMeas/realtimeevokedset.h>
 #include <scMeas/realtimefwdsolution.h>
@@ -93,7 +94,7 @@ using namespace Eigen;
 //=============================================================================================================
 
 RtcMne::RtcMne()
-: m_pCircularMatrixBuffer(CircularBuffer_Matrix_double::SPtr(new CircularBuffer_Matrix_double(40)))
+: m_pCircularMatrixBuffer(CircularBuffer_SampleBlock::SPtr(new CircularBuffer_SampleBlock(40)))
 , m_pCircularEvokedBuffer(CircularBuffer<FIFFLIB::FiffEvoked>::SPtr::create(40))
 , m_bEvokedInput(false)
 , m_bRawInput(false)
@@ -405,16 +406,16 @@ void RtcMne::updateRTMSA(SCMEASLIB::Measurement::SPtr pMeasurement)
                 QMap<QString,double> mapReject;
                 mapReject.insert("eog", 150e-06);
 
-                for(qint32 i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                    bool bArtifactDetected = MNEEpochDataList::checkForArtifact(pRTMSA->getMultiSampleArray()[i],
+                const QList<SampleBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
+                for(const SampleBlock& block : lSampleBlocks) {
+                    bool bArtifactDetected = MNEEpochDataList::checkForArtifact(block.data(),
                                                                                 *m_pFiffInfoInput,
                                                                                 mapReject);
 
                     if(!bArtifactDetected) {
-                        // Please note that we do not need a copy here since this function will block until
-                        // the buffer accepts new data again. Hence, the data is not deleted in the actual
-                        // Measurement function after it emitted the notify signal.
-                        while(!m_pCircularMatrixBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+                        // Please note that only the reference to the shared samples is pushed, the samples are not copied.
+                        while(!m_pCircularMatrixBuffer->push(block)) {
                             //Do nothing until the circular buffer is ready to accept new data again
                         }
                     } else {
@@ -571,8 +572,9 @@ void RtcMne::run()
     // Init parameters
     qint32 skip_count = 0;
     FiffEvoked evoked;
-    MatrixXd matData;
+    SampleBlock block;
     MatrixXd matDataResized;
+    const QString sStageName = getName();
     qint32 j;
     int iTimePointSps = 0;
     int iNumberChannels = 0;
@@ -604,6 +606,8 @@ void RtcMne::run()
         if(bUpdateMinimumNorm) {
             m_qMutex.lock();
             pMinimumNorm = MinimumNorm::SPtr(new MinimumNorm(m_invOp, lambda2, m_sMethod));
+            // Single precision is sufficient for display purposes and halves the kernel bandwidth per block
+            pMinimumNorm->setFloatPrecision(true);
             m_bUpdateMinimumNorm = false;
             m_qMutex.unlock();
 
@@ -616,7 +620,10 @@ void RtcMne::run()
         if(bRawInput && pMinimumNorm) {
             if(((skip_count % iDownSample) == 0)) {
                 // Get the current raw data
-                if(m_pCircularMatrixBuffer->pop(matData)) {
+                if(m_pCircularMatrixBuffer->pop(block)) {
+                    qint64 iStart = PipelineMonitor::currentTime();
+                    const MatrixXd& matData = block.data();
+
                     //Pick the same channels as in the inverse operator
                     matDataResized.resize(iNumberChannels, matData.cols());
 
@@ -630,6 +637,9 @@ void RtcMne::run()
                                                                     tstep,
                                                                     true);
 
+                    PipelineMonitor::recordStage(sStageName, iStart, PipelineMonitor::currentTime(), block.timestamp());
+                    PipelineMonitor::recordQueue(sStageName, m_pCircularMatrixBuffer->getStatistics());
+
                     if(!sourceEstimate.isEmpty()) {
                         if(iTimePointSps < sourceEstimate.data.cols() && iTimePointSps >= 0) {
                             sourceEstimate = sourceEstimate.reduce(iTimePointSps,1);
@@ -640,7 +650,7 @@ void RtcMne::run()
                     }
                 }
             } else {
-                m_pCircularMatrixBuffer->pop(matData);
+                m_pCircularMatrixBuffer->pop(block);
             }
         }
 
@@ -38,6 +38,8 @@
 
 #include "writetofilesetupwidget.h"
 
+#include <fiff/fiff_file.h>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -59,6 +61,19 @@ WriteToFileSetupWidget::WriteToFileSetupWidget(WriteToFile* toolbox, QWidget *pa
 , m_pWriteToFile(toolbox)
 {
     ui.setupUi(this);
+
+    ui.m_qComboBox_DataType->addItem("Float (32 bit)", FIFFT_FLOAT);
+    ui.m_qComboBox_DataType->addItem("Integer (32 bit)", FIFFT_INT);
+    ui.m_qComboBox_DataType->addItem("Short (16 bit)", FIFFT_SHORT);
+    ui.m_qComboBox_DataType->setCurrentIndex(qMax(0, ui.m_qComboBox_DataType->findData(m_pWriteToFile->getDataType())));
+    connect(ui.m_qComboBox_DataType, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this](int index) {
+                m_pWriteToFile->setDataType(ui.m_qComboBox_DataType->itemData(index).toInt());
+            });
+
+    ui.m_qSpinBox_SplitSize->setValue(m_pWriteToFile->getSplitSize());
+    connect(ui.m_qSpinBox_SplitSize, QOverload<int>::of(&QSpinBox::valueChanged),
+            m_pWriteToFile, &WriteToFile::setSplitSize);
 }
 
 //=============================================================================================================
@@ -0,0 +1,513 @@
+//=============================================================================================================
+/**
+ * @file     fiffrawwriter.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Contains the definition of the FiffRawWriter class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiffrawwriter.h"
+
+#include <fiff/fiff_stream.h>
+#include <fiff/fiff_info.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QFileInfo>
+#include <QtEndian>
+#include <QDebug>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace WRITETOFILEPLUGIN;
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+    const int iMaxFreeBuffers = 16;             /**< Number of conversion buffers kept for reuse. */
+    const qint64 iSplitReserve = 64*1024;       /**< Room kept for the closing tags when checking the split size. */
+
+    //=========================================================================================================
+    /**
+     * Returns the integer step used for a channel which carries no calibration of its own (cal*range == 1),
+     * e.g. the EEG amplifier plugins which deliver samples in volts.
+     *
+     * @param[in] iUnit          The unit of the channel.
+     * @param[in] iDataType      The integer file data type (FIFFT_INT or FIFFT_SHORT).
+     *
+     * @return The value of one integer step in the channel unit, 0 if no step is known for this unit.
+     */
+    double uncalibratedResolution(fiff_int_t iUnit,
+                                  fiff_int_t iDataType)
+    {
+        const bool bShort = iDataType == FIFFT_SHORT;
+
+        switch(iUnit) {
+            case FIFF_UNIT_V:                           // 0.1 uV (+-3.2 mV) or 1 nV (+-2.1 V)
+                return bShort ? 1e-7 : 1e-9;
+            case FIFF_UNIT_T:                           // 10 fT (+-327 pT) or 0.1 fT (+-0.2 mT)
+                return bShort ? 1e-14 : 1e-16;
+            case FIFF_UNIT_T_M:                         // 1 pT/m (+-32 nT/m) or 0.01 pT/m (+-21 uT/m)
+                return bShort ? 1e-12 : 1e-14;
+            case FIFF_UNIT_NONE:                        // Counts, e.g. trigger values
+            case 0:
+                return 1.0;
+            default:
+                return 0.0;
+        }
+    }
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffRawWriter::FiffRawWriter(qint64 iMaxQueueBytes,
+                             QObject* parent)
+: QThread(parent)
+, m_iQueuedBytes(0)
+, m_iPeakQueuedBytes(0)
+, m_iMaxQueueBytes(iMaxQueueBytes)
+, m_bRecording(false)
+, m_bStop(false)
+, m_iDataType(FIFFT_FLOAT)
+, m_iFileDataType(FIFFT_FLOAT)
+, m_iSplitSize(0)
+, m_iSplitCount(0)
+, m_iSamplesWritten(0)
+, m_iFileFirstSample(0)
+{
+}
+
+//=============================================================================================================
+
+FiffRawWriter::~FiffRawWriter()
+{
+    finishRecording();
+
+    m_mutex.lock();
+    m_bStop = true;
+    m_condQueueFilled.wakeAll();
+    m_mutex.unlock();
+
+    wait();
+}
+
+//=============================================================================================================
+
+bool FiffRawWriter::startRecording(const QString& sFileName,
+                                   const FiffInfo& info,
+                                   fiff_int_t iDataType,
+                                   qint64 iSplitSize)
+{
+    if(iDataType != FIFFT_FLOAT && iDataType != FIFFT_INT && iDataType != FIFFT_SHORT) {
+        qWarning() << "[FiffRawWriter::startRecording] Unsupported data type" << iDataType;
+        return false;
+    }
+
+    // Integer files store cal*range per channel. Channels without a calibration of their own get a fixed
+    // step, which is written to the file as well. Otherwise volt scale samples would round to zero.
+    QSharedPointer<FiffInfo> pInfo = QSharedPointer<FiffInfo>(new FiffInfo(info));
+
+    if(iDataType != FIFFT_FLOAT) {
+        for(int k = 0; k < pInfo->nchan; ++k) {
+            FiffChInfo& chInfo = pInfo->chs[k];
+
+            if(chInfo.cal * chInfo.range != 1.0f) {
+                continue;
+            }
+
+            double dResolution = uncalibratedResolution(chInfo.unit, iDataType);
+
+            if(dResolution == 0.0) {
+                qWarning() << "[FiffRawWriter::startRecording] Channel" << chInfo.ch_name << "has no calibration and unit"
+                           << chInfo.unit << "has no known resolution. Use float output for this recording.";
+                return false;
+            }
+
+            chInfo.cal = dResolution;
+            chInfo.range = 1.0f;
+        }
+    }
+
+    if(isRecording()) {
+        finishRecording();
+    }
+
+    m_encodeMutex.lock();
+    m_iDataType = iDataType;
+    m_vecInvCals.resize(pInfo->nchan);
+    for(int k = 0; k < pInfo->nchan; ++k) {
+        // Float files are written with the channel range reset to 1.0, integer files keep it
+        double dCal = pInfo->chs[k].cal;
+        if(iDataType != FIFFT_FLOAT) {
+            dCal *= pInfo->chs[k].range;
+        }
+        m_vecInvCals[k] = dCal != 0.0 ? 1.0 / dCal : 1.0;
+    }
+    m_vecClipped.fill(0, pInfo->nchan);
+    m_lChNames = pInfo->ch_names;
+    m_encodeMutex.unlock();
+
+    Block block;
+    block.command = Block::Start;
+    block.pInfo = pInfo;
+    block.sFileName = sFileName;
+    block.iDataType = iDataType;
+    block.iSplitSize = iSplitSize;
+
+    m_mutex.lock();
+    m_bRecording = true;
+    m_iPeakQueuedBytes = 0;
+    m_mutex.unlock();
+
+    enqueue(block);
+
+    if(!isRunning()) {
+        start();
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool FiffRawWriter::writeBuffer(const MatrixXd& matData)
+{
+    Block block;
+    block.command = Block::Data;
+    block.iSamples = matData.cols();
+
+    m_mutex.lock();
+    if(!m_bRecording) {
+        m_mutex.unlock();
+        return false;
+    }
+    if(!m_lFreeBuffers.isEmpty()) {
+        block.data = m_lFreeBuffers.takeLast();
+    }
+    m_mutex.unlock();
+
+    m_encodeMutex.lock();
+    if(matData.rows() != m_vecInvCals.cols()) {
+        m_encodeMutex.unlock();
+        qWarning() << "[FiffRawWriter::writeBuffer] Buffer has" << matData.rows() << "channels, the recording" << m_vecInvCals.cols();
+        return false;
+    }
+    block.iDataType = m_iDataType;
+    encode(matData, block.data);
+    m_encodeMutex.unlock();
+
+    enqueue(block);
+
+    return true;
+}
+
+//=============================================================================================================
+
+void FiffRawWriter::finishRecording()
+{
+    m_mutex.lock();
+    if(!m_bRecording) {
+        m_mutex.unlock();
+        return;
+    }
+    m_bRecording = false;
+    m_mutex.unlock();
+
+    Block block;
+    block.command = Block::Finish;
+    enqueue(block);
+}
+
+//=============================================================================================================
+
+bool FiffRawWriter::isRecording() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_bRecording;
+}
+
+//=============================================================================================================
+
+QVector<qint64> FiffRawWriter::clippedSamples() const
+{
+    QMutexLocker locker(&m_encodeMutex);
+    return m_vecClipped;
+}
+
+//=============================================================================================================
+
+qint64 FiffRawWriter::peakQueuedBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_iPeakQueuedBytes;
+}
+
+//=============================================================================================================
+
+void FiffRawWriter::run()
+{
+    forever {
+        Block block;
+
+        m_mutex.lock();
+        while(m_lQueue.isEmpty() && !m_bStop) {
+            m_condQueueFilled.wait(&m_mutex);
+        }
+        if(m_lQueue.isEmpty()) {
+            m_mutex.unlock();
+            break;
+        }
+        block = m_lQueue.takeFirst();
+        m_mutex.unlock();
+
+        switch(block.command) {
+            case Block::Start:
+                if(m_pOutfid) {
+                    m_pOutfid->finish_writing_raw();
+                }
+                m_pInfo = block.pInfo;
+                m_sFileName = block.sFileName;
+                m_iFileDataType = block.iDataType;
+                m_iSplitSize = block.iSplitSize;
+                m_iSplitCount = 0;
+                m_iSamplesWritten = 0;
+                openFile(m_sFileName, 0);
+                break;
+
+            case Block::Data:
+                if(m_pOutfid) {
+                    const qint64 iTagSize = 4 * sizeof(qint32) + block.data.size();
+                    if(m_iSamplesWritten > m_iFileFirstSample
+                       && m_qFileOut.pos() + iTagSize + iSplitReserve > m_iSplitSize) {
+                        splitFile();
+                    }
+
+                    *m_pOutfid << static_cast<qint32>(FIFF_DATA_BUFFER);
+                    *m_pOutfid << static_cast<qint32>(block.iDataType);
+                    *m_pOutfid << static_cast<qint32>(block.data.size());
+                    *m_pOutfid << static_cast<qint32>(FIFFV_NEXT_SEQ);
+                    if(m_pOutfid->writeRawData(block.data.constData(), block.data.size()) != block.data.size()) {
+                        qCritical() << "[FiffRawWriter::run] Could not write data buffer to" << m_qFileOut.fileName();
+                    }
+                    m_iSamplesWritten += block.iSamples;
+                }
+                break;
+
+            case Block::Finish:
+                if(m_pOutfid) {
+                    m_pOutfid->finish_writing_raw();
+                    m_pOutfid.clear();
+                }
+                m_pInfo.clear();
+                break;
+        }
+
+        m_mutex.lock();
+        m_iQueuedBytes -= block.data.size();
+        if(block.command == Block::Data && m_lFreeBuffers.size() < iMaxFreeBuffers) {
+            m_lFreeBuffers.append(block.data);
+        }
+        m_condQueueDrained.wakeAll();
+        m_mutex.unlock();
+    }
+
+    if(m_pOutfid) {
+        m_pOutfid->finish_writing_raw();
+        m_pOutfid.clear();
+    }
+}
+
+//=============================================================================================================
+
+void FiffRawWriter::enqueue(const Block& block)
+{
+    QMutexLocker locker(&m_mutex);
+
+    // Never drop data, wait for the disk instead. A single block is always accepted.
+    while(!m_lQueue.isEmpty() && m_iQueuedBytes + block.data.size() > m_iMaxQueueBytes) {
+        m_condQueueDrained.wait(&m_mutex);
+    }
+
+    m_iQueuedBytes += block.data.size();
+    m_iPeakQueuedBytes = qMax(m_iPeakQueuedBytes, m_iQueuedBytes);
+    m_lQueue.append(block);
+    m_condQueueFilled.wakeOne();
+}
+
+//=============================================================================================================
+
+void FiffRawWriter::encode(const MatrixXd& matData,
+                           QByteArray& data)
+{
+    const int iRows = matData.rows();
+    const int iCols = matData.cols();
+    const int iBytesPerValue = m_iDataType == FIFFT_SHORT ? 2 : 4;
+
+    // Resizing keeps the capacity of a recycled buffer
+    data.resize(iRows * iCols * iBytesPerValue);
+    uchar* pOut = reinterpret_cast<uchar*>(data.data());
+
+    auto clip = [this](int iChannel) {
+        if(m_vecClipped[iChannel]++ == 0) {
+            qWarning() << "[FiffRawWriter::encode] Channel" << m_lChNames.value(iChannel)
+                       << "exceeds the range of the packed data type. Samples are clipped.";
+        }
+    };
+
+    // Samples are stored channel by channel, i.e., in the column major order of matData
+    switch(m_iDataType) {
+        case FIFFT_SHORT:
+            for(int j = 0; j < iCols; ++j) {
+                for(int i = 0; i < iRows; ++i) {
+                    const double dValue = matData(i,j) * m_vecInvCals[i];
+                    qint16 iValue;
+                    if(dValue >= 32767.0) {
+                        iValue = 32767;
+                        if(dValue > 32767.5) clip(i);
+                    } else if(dValue <= -32768.0) {
+                        iValue = -32768;
+                        if(dValue < -32768.5) clip(i);
+                    } else {
+                        iValue = static_cast<qint16>(qRound(dValue));
+                    }
+                    qToBigEndian<qint16>(iValue, pOut);
+                    pOut += 2;
+                }
+            }
+            break;
+
+        case FIFFT_INT:
+            for(int j = 0; j < iCols; ++j) {
+                for(int i = 0; i < iRows; ++i) {
+                    const double dValue = matData(i,j) * m_vecInvCals[i];
+                    qint32 iValue;
+                    if(dValue >= 2147483647.0) {
+                        iValue = 2147483647;
+                        if(dValue > 2147483647.5) clip(i);
+                    } else if(dValue <= -2147483648.0) {
+                        iValue = -2147483647 - 1;
+                        if(dValue < -2147483648.5) clip(i);
+                    } else {
+                        iValue = static_cast<qint32>(qRound64(dValue));
+                    }
+                    qToBigEndian<qint32>(iValue, pOut);
+                    pOut += 4;
+                }
+            }
+            break;
+
+        default:
+            for(int j = 0; j < iCols; ++j) {
+                for(int i = 0; i < iRows; ++i) {
+                    const float fValue = static_cast<float>(matData(i,j) * m_vecInvCals[i]);
+                    quint32 iBits;
+                    memcpy(&iBits, &fValue, sizeof(quint32));
+                    qToBigEndian<quint32>(iBits, pOut);
+                    pOut += 4;
+                }
+            }
+            break;
+    }
+}
+
+//=============================================================================================================
+
+void FiffRawWriter::openFile(const QString& sFileName,
+                             fiff_int_t iFirstSample)
+{
+    m_qFileOut.setFileName(sFileName);
+
+    RowVectorXd cals;
+    MatrixXi sel;
+    m_pOutfid = FiffStream::start_writing_raw(m_qFileOut,
+                                              *m_pInfo,
+                                              cals,
+                                              sel,
+                                              m_iFileDataType == FIFFT_FLOAT,
+                                              m_iFileDataType);
+    m_pOutfid->write_int(FIFF_FIRST_SAMPLE, &iFirstSample);
+    m_iFileFirstSample = iFirstSample;
+}
+
+//=============================================================================================================
+
+void FiffRawWriter::splitFile()
+{
+    ++m_iSplitCount;
+    QString sNextFileName = splitFileName(m_iSplitCount);
+
+    //Write the link to the next file
+    qint32 data;
+    m_pOutfid->start_block(FIFFB_REF);
+    data = FIFFV_ROLE_NEXT_FILE;
+    m_pOutfid->write_int(FIFF_REF_ROLE,&data);
+    m_pOutfid->write_string(FIFF_REF_FILE_NAME, QFileInfo(sNextFileName).fileName());
+    m_pOutfid->write_id(FIFF_REF_FILE_ID);//ToDo meas_id
+    data = m_iSplitCount - 1;
+    m_pOutfid->write_int(FIFF_REF_FILE_NUM, &data);
+    m_pOutfid->end_block(FIFFB_REF);
+
+    m_pOutfid->finish_writing_raw();
+
+    openFile(sNextFileName, m_iSamplesWritten);
+
+    emit fileSplit(sNextFileName);
+}
+
+//=============================================================================================================
+
+QString FiffRawWriter::splitFileName(int iSplit) const
+{
+    QString sBaseName = m_sFileName;
+    if(sBaseName.endsWith("_raw.fif")) {
+        sBaseName.chop(8);
+    } else if(sBaseName.endsWith(".fif")) {
+        sBaseName.chop(4);
+    }
+
+    return sBaseName + QString("-%1_raw.fif").arg(iSplit);
+}
@@ -0,0 +1,292 @@
+//=============================================================================================================
+/**
+ * @file     fiffrawwriter.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Contains the declaration of the FiffRawWriter class.
+ *
+ */
+
+#ifndef FIFFRAWWRITER_H
+#define FIFFRAWWRITER_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "writetofile_global.h"
+
+#include <fiff/fiff_types.h>
+#include <fiff/fiff_file.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSharedPointer>
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+#include <QStringList>
+#include <QFile>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+namespace FIFFLIB{
+    class FiffInfo;
+    class FiffStream;
+}
+
+//=============================================================================================================
+// DEFINE NAMESPACE WRITETOFILEPLUGIN
+//=============================================================================================================
+
+namespace WRITETOFILEPLUGIN
+{
+
+//=============================================================================================================
+// WRITETOFILEPLUGIN FORWARD DECLARATIONS
+//=============================================================================================================
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS FiffRawWriter
+ *
+ * @brief The FiffRawWriter class writes raw data buffers to a fif file from a background thread.
+ *
+ * The calling thread only converts the incoming buffers into their on-disk representation (FIFFT_FLOAT,
+ * FIFFT_INT or FIFFT_SHORT, calibrated with precomputed reciprocal factors) and hands them over to a bounded
+ * queue. The writer thread owns the file and performs the actual disk I/O, including the splitting of the
+ * recording into several files once a size limit is reached. Conversion buffers are recycled, so no
+ * allocations happen in steady state. When the queue is full the calling thread is blocked, no data is dropped.
+ */
+class FiffRawWriter : public QThread
+{
+    Q_OBJECT
+
+public:
+    typedef QSharedPointer<FiffRawWriter> SPtr;            /**< Shared pointer type for FiffRawWriter. */
+    typedef QSharedPointer<const FiffRawWriter> ConstSPtr; /**< Const shared pointer type for FiffRawWriter. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a FiffRawWriter.
+     *
+     * @param[in] iMaxQueueBytes     The maximum number of encoded bytes which can wait for the disk.
+     * @param[in] parent             The parent object.
+     */
+    explicit FiffRawWriter(qint64 iMaxQueueBytes = 512*1024*1024,
+                           QObject* parent = Q_NULLPTR);
+
+    //=========================================================================================================
+    /**
+     * Destroys the FiffRawWriter. All queued buffers are written and an open recording is finished first.
+     */
+    ~FiffRawWriter();
+
+    //=========================================================================================================
+    /**
+     * Starts a new recording. The file itself is created by the writer thread.
+     * For integer data types, channels with cal*range == 1 (e.g. EEG in volts) are written with a fixed
+     * resolution per unit, which is stored as the channel calibration in the file.
+     *
+     * @param[in] sFileName      The name of the first file. Split files get a "-<n>_raw.fif" suffix.
+     * @param[in] info           The measurement info to write. Active projectors should be switched off before.
+     * @param[in] iDataType      The data type of the raw buffers (FIFFT_FLOAT, FIFFT_INT or FIFFT_SHORT).
+     * @param[in] iSplitSize     The size in bytes at which the recording continues in a new file.
+     *
+     * @return true if the recording was started, false if the data type is not supported or a channel
+     *         cannot be packed into the integer data type.
+     */
+    bool startRecording(const QString& sFileName,
+                        const FIFFLIB::FiffInfo& info,
+                        FIFFLIB::fiff_int_t iDataType = FIFFT_FLOAT,
+                        qint64 iSplitSize = 2000000000L);
+
+    //=========================================================================================================
+    /**
+     * Converts a calibrated data block and queues it for writing. Blocks if the queue is full.
+     *
+     * @param[in] matData    The data (channels x samples) to write.
+     *
+     * @return true if the block was queued, false if no recording is active or the channels do not match.
+     */
+    bool writeBuffer(const Eigen::MatrixXd& matData);
+
+    //=========================================================================================================
+    /**
+     * Finishes the current recording. The file is closed by the writer thread once all queued blocks are written.
+     */
+    void finishRecording();
+
+    //=========================================================================================================
+    /**
+     * Returns whether a recording was started and not yet finished.
+     *
+     * @return true if recording.
+     */
+    bool isRecording() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of clipped samples per channel of the current recording. Only integer data types clip.
+     *
+     * @return The clipped samples per channel.
+     */
+    QVector<qint64> clippedSamples() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the largest number of bytes which were waiting for the disk during the current recording.
+     *
+     * @return The peak queue size in bytes.
+     */
+    qint64 peakQueuedBytes() const;
+
+signals:
+    //=========================================================================================================
+    /**
+     * Emitted by the writer thread whenever the recording continues in a new file.
+     *
+     * @param[in] sFileName  The name of the new file.
+     */
+    void fileSplit(const QString& sFileName);
+
+protected:
+    //=========================================================================================================
+    /**
+     * The writer thread. Writes the queued blocks until it is asked to stop and the queue is empty.
+     */
+    virtual void run();
+
+private:
+    /**
+     * A unit of work for the writer thread.
+     */
+    struct Block {
+        enum Command {
+            Start,
+            Data,
+            Finish
+        };
+        Command                             command = Data;         /**< What to do. */
+        QByteArray                          data;                   /**< Big endian payload of a data block. */
+        qint32                              iSamples = 0;           /**< Number of samples in a data block. */
+        QSharedPointer<FIFFLIB::FiffInfo>   pInfo;                  /**< The measurement info of a start block. */
+        QString                             sFileName;              /**< The file name of a start block. */
+        FIFFLIB::fiff_int_t                 iDataType = FIFFT_FLOAT;/**< The data type of a start or data block. */
+        qint64                              iSplitSize = 0;         /**< The split size of a start block. */
+    };
+
+    //=========================================================================================================
+    /**
+     * Queues a block, waits while the queue holds more than the allowed number of bytes.
+     *
+     * @param[in] block  The block to queue.
+     */
+    void enqueue(const Block& block);
+
+    //=========================================================================================================
+    /**
+     * Converts the data into the big endian representation of the current data type.
+     *
+     * @param[in] matData    The calibrated data.
+     * @param[out] data      The encoded payload. Its capacity is reused.
+     */
+    void encode(const Eigen::MatrixXd& matData,
+                QByteArray& data);
+
+    //=========================================================================================================
+    /**
+     * Opens a new file and writes the measurement info. Called by the writer thread.
+     *
+     * @param[in] sFileName      The file name.
+     * @param[in] iFirstSample   The first sample written to this file.
+     */
+    void openFile(const QString& sFileName,
+                  FIFFLIB::fiff_int_t iFirstSample);
+
+    //=========================================================================================================
+    /**
+     * Links the current file to the next one, closes it and opens the next file. Called by the writer thread.
+     */
+    void splitFile();
+
+    //=========================================================================================================
+    /**
+     * Generates the name of the n-th split file.
+     *
+     * @param[in] iSplit     The split count.
+     *
+     * @return The file name.
+     */
+    QString splitFileName(int iSplit) const;
+
+    mutable QMutex                      m_mutex;                /**< Guards the queue, the buffer pool and the state flags. */
+    mutable QMutex                      m_encodeMutex;          /**< Guards the conversion state. */
+    QWaitCondition                      m_condQueueFilled;      /**< Wakes the writer thread. */
+    QWaitCondition                      m_condQueueDrained;     /**< Wakes callers which wait for space in the queue. */
+
+    QList<Block>                        m_lQueue;               /**< The blocks waiting for the disk. */
+    QList<QByteArray>                   m_lFreeBuffers;         /**< Recycled conversion buffers. */
+    qint64                              m_iQueuedBytes;         /**< Bytes currently waiting for the disk. */
+    qint64                              m_iPeakQueuedBytes;     /**< Largest number of bytes which were waiting for the disk. */
+    qint64                              m_iMaxQueueBytes;       /**< Maximum number of bytes which can wait for the disk. */
+    bool                                m_bRecording;           /**< Whether a recording is active on the calling side. */
+    bool                                m_bStop;                /**< Whether the writer thread should end once the queue is empty. */
+
+    FIFFLIB::fiff_int_t                 m_iDataType;            /**< The data type used for encoding. */
+    Eigen::RowVectorXd                  m_vecInvCals;           /**< Reciprocal calibration per channel. */
+    QVector<qint64>                     m_vecClipped;           /**< Number of clipped samples per channel. */
+    QStringList                         m_lChNames;             /**< Channel names, used for range warnings. */
+
+    // Owned by the writer thread
+    QSharedPointer<FIFFLIB::FiffInfo>   m_pInfo;                /**< The measurement info of the current recording. */
+    QSharedPointer<FIFFLIB::FiffStream> m_pOutfid;              /**< The stream of the current file. */
+    QFile                               m_qFileOut;             /**< The current file. */
+    QString                             m_sFileName;            /**< The name of the first file of the recording. */
+    FIFFLIB::fiff_int_t                 m_iFileDataType;        /**< The data type of the current recording. */
+    qint64                              m_iSplitSize;           /**< The split size of the current recording. */
+    qint32                              m_iSplitCount;          /**< Number of splits of the current recording. */
+    FIFFLIB::fiff_int_t                 m_iSamplesWritten;      /**< Samples written since the start of the recording. */
+    FIFFLIB::fiff_int_t                 m_iFileFirstSample;     /**< First sample of the current file. */
+};
+} // NAMESPACE
+
+#endif // FIFFRAWWRITER_H
@@ -37,17 +37,22 @@
 //=============================================================================================================
 
 #include "writetofile.h"
+#include "fiffrawwriter.h"
 
 #include "FormFiles/writetofilesetupwidget.h"
 
 #include <disp/viewers/projectsettingsview.h>
 #include <scMeas/realtimemultisamplearray.h>
-#include <fiff/fiff_stream.h>
+#include <scMeas/pipelinemonitor.h>
+#include <fiff/fiff_info.h>
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QFile>
+#include <QSettings>
+
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
@@ -72,9 +77,11 @@ WriteToFile::WriteToFile()
 : m_bWriteToFile(false)
 , m_bUseRecordTimer(false)
 , m_iBlinkStatus(0)
-, m_iSplitCount(0)
 , m_iRecordingMSeconds(5*60*1000)
-, m_pCircularBuffer(CircularBuffer_Matrix_double::SPtr(new CircularBuffer_Matrix_double(40)))
+, m_iSplitSizeMB(MAX_DATA_LEN/(1000*1000))
+, m_iDataType(FIFFT_FLOAT)
+, m_pRawWriter(FiffRawWriter::SPtr(new FiffRawWriter))
+, m_pCircularBuffer(CircularBuffer_SampleBlock::SPtr(new CircularBuffer_SampleBlock(40)))
 {
     m_pActionRecordFile = new QAction(QIcon(":/images/record.png"), tr("Start Recording"),this);
     m_pActionRecordFile->setStatusTip(tr("Start Recording"));
@@ -123,6 +130,10 @@ void WriteToFile::init()
     connect(m_pWriteToFileInput.data(), &PluginInputConnector::notify,
             this, &WriteToFile::update, Qt::DirectConnection);
     m_inputConnectors.append(m_pWriteToFileInput);
+
+    QSettings settings("MNECPP");
+    m_iDataType = settings.value(QString("MNESCAN/%1/dataType").arg(getName()), FIFFT_FLOAT).toInt();
+    m_iSplitSizeMB = settings.value(QString("MNESCAN/%1/splitSizeMB").arg(getName()), m_iSplitSizeMB).toInt();
 }
 
 //=============================================================================================================
@@ -188,13 +199,13 @@ void WriteToFile::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             initPluginControlWidgets();
         }
 
+        const QList<SampleBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
         // Check if data is present
-        if(pRTMSA->getMultiSampleArray().size() > 0) {
-            for(unsigned char i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                // Please note that we do not need a copy here since this function will block until
-                // the buffer accepts new data again. Hence, the data is not deleted in the actual
-                // Measurement function after it emitted the notify signal.
-                while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+        if(lSampleBlocks.size() > 0) {
+            for(const SampleBlock& block : lSampleBlocks) {
+                // Please note that only the reference to the shared samples is pushed, the samples are not copied.
+                while(!m_pCircularBuffer->push(block)) {
                     //Do nothing until the circular buffer is ready to accept new data again
                 }
             }
@@ -271,30 +282,22 @@ void WriteToFile::initPluginControlWidgets()
 
 void WriteToFile::run()
 {
-    MatrixXd matData;
-    qint32 size = 0;
+    SampleBlock block;
+    const QString sStageName = getName();
 
     while(!isInterruptionRequested()) {
         if(m_pCircularBuffer) {
             //pop matrix
-            if(m_pCircularBuffer->pop(matData)) {
-                //Write raw data to fif file
-                m_mutex.lock();
+            if(m_pCircularBuffer->pop(block)) {
+                qint64 iStart = PipelineMonitor::currentTime();
+
+                //Hand the raw data over to the writer thread. This only blocks if the disk falls behind for long.
                 if(m_bWriteToFile) {
-                    size += matData.rows()*matData.cols() * 4;
-
-                    if(size > MAX_DATA_LEN) {
-                        size = 0;
-                        this->splitRecordingFile();
-                    }
-
-                    if(m_pOutfid) {
-                        m_pOutfid->write_raw_buffer(matData);
-                    }
-                } else {
-                    size = 0;
+                    m_pRawWriter->writeBuffer(block.data());
                 }
-                m_mutex.unlock();
+
+                PipelineMonitor::recordStage(sStageName, iStart, PipelineMonitor::currentTime(), block.timestamp());
+                PipelineMonitor::recordQueue(sStageName, m_pCircularBuffer->getStatistics());
             }
         }
     }
@@ -337,12 +340,8 @@ void WriteToFile::toggleRecordingFile()
 {
     //Setup writing to file
     if(m_bWriteToFile) {
-        m_mutex.lock();
-        m_pOutfid->finish_writing_raw();
-        m_mutex.unlock();
-
         m_bWriteToFile = false;
-        m_iSplitCount = 0;
+        m_pRawWriter->finishRecording();
 
         //Stop record timer
         m_pRecordTimer->stop();
@@ -350,8 +349,6 @@ void WriteToFile::toggleRecordingFile()
         m_pActionRecordFile->setIcon(QIcon(":/images/record.png"));
         m_pUpdateTimeInfoTimer->stop();
     } else {
-        m_iSplitCount = 0;
-
         if(!m_pFiffInfo) {
             QMessageBox msgBox;
             msgBox.setText("FiffInfo missing!");
@@ -371,9 +368,8 @@ void WriteToFile::toggleRecordingFile()
                 return;
         }
 
-        //Initiate the stream for writing to the fif file
-        m_qFileOut.setFileName(m_sRecordFileName);
-        if(m_qFileOut.exists()) {
+        //Check the file for writing to the fif file
+        if(QFile::exists(m_sRecordFileName)) {
             QMessageBox msgBox;
             msgBox.setText("The file you want to write already exists.");
             msgBox.setInformativeText("Do you want to overwrite this file?");
@@ -390,15 +386,13 @@ void WriteToFile::toggleRecordingFile()
             m_pFiffInfo->projs[i].active = false;
         }
 
-        //Start/Prepare writing process. Actual writing is done in run() method.
-        m_mutex.lock();
-        RowVectorXd cals;
-        m_pOutfid = FiffStream::start_writing_raw(m_qFileOut,
-                                                  *m_pFiffInfo,
-                                                  cals);
-        fiff_int_t first = 0;
-        m_pOutfid->write_int(FIFF_FIRST_SAMPLE, &first);
-        m_mutex.unlock();
+        //Start/Prepare writing process. The file is written by the writer thread, the data is handed over in run().
+        if(!m_pRawWriter->startRecording(m_sRecordFileName,
+                                         *m_pFiffInfo,
+                                         m_iDataType,
+                                         static_cast<qint64>(m_iSplitSizeMB) * 1000 * 1000)) {
+            return;
+        }
 
         m_bWriteToFile = true;
 
@@ -415,38 +409,36 @@ void WriteToFile::toggleRecordingFile()
 
 //=============================================================================================================
 
-void WriteToFile::splitRecordingFile()
+void WriteToFile::setDataType(fiff_int_t iDataType)
+{
+    m_iDataType = iDataType;
+
+    QSettings settings("MNECPP");
+    settings.setValue(QString("MNESCAN/%1/dataType").arg(getName()), m_iDataType);
+}
+
+//=============================================================================================================
+
+fiff_int_t WriteToFile::getDataType() const
+{
+    return m_iDataType;
+}
+
+//=============================================================================================================
+
+void WriteToFile::setSplitSize(int iSizeMB)
+{
+    m_iSplitSizeMB = iSizeMB;
+
+    QSettings settings("MNECPP");
+    settings.setValue(QString("MNESCAN/%1/splitSizeMB").arg(getName()), m_iSplitSizeMB);
+}
+
+//=============================================================================================================
+
+int WriteToFile::getSplitSize() const
 {
-    //qDebug() << "Split recording file";
-    ++m_iSplitCount;
-    QString nextFileName = m_sRecordFileName.remove("_raw.fif");
-    nextFileName += QString("-%1_raw.fif").arg(m_iSplitCount);
-
-    //Write the link to the next file
-    qint32 data;
-    m_pOutfid->start_block(FIFFB_REF);
-    data = FIFFV_ROLE_NEXT_FILE;
-    m_pOutfid->write_int(FIFF_REF_ROLE,&data);
-    m_pOutfid->write_string(FIFF_REF_FILE_NAME, nextFileName);
-    m_pOutfid->write_id(FIFF_REF_FILE_ID);//ToDo meas_id
-    data = m_iSplitCount - 1;
-    m_pOutfid->write_int(FIFF_REF_FILE_NUM, &data);
-    m_pOutfid->end_block(FIFFB_REF);
-
-    //finish file
-    m_pOutfid->finish_writing_raw();
-
-    //start next file
-    m_qFileOut.setFileName(nextFileName);
-    RowVectorXd cals;
-    MatrixXi sel;
-    m_pOutfid = FiffStream::start_writing_raw(m_qFileOut,
-                                              *m_pFiffInfo,
-                                              cals,
-                                              sel,
-                                              false);
-    fiff_int_t first = 0;
-    m_pOutfid->write_int(FIFF_FIRST_SAMPLE, &first);
+    return m_iSplitSizeMB;
 }
 
 //=============================================================================================================
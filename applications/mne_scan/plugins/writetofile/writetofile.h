@@ -41,8 +41,9 @@
 
 #include "writetofile_global.h"
 
-#include <utils/generics/circularbuffer.h>
+#include <scMeas/sampleblock.h>
 #include <scShared/Interfaces/IAlgorithm.h>
+#include <fiff/fiff_types.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -50,7 +51,6 @@
 
 #include <QPointer>
 #include <QAction>
-#include <QFile>
 #include <QTime>
 
 //=============================================================================================================
@@ -65,7 +65,6 @@
 
 namespace FIFFLIB{
     class FiffInfo;
-    class FiffStream;
 }
 
 namespace SCMEASLIB{
@@ -85,6 +84,8 @@ namespace WRITETOFILEPLUGIN
 // WRITETOFILEPLUGIN FORWARD DECLARATIONS
 //=============================================================================================================
 
+class FiffRawWriter;
+
 //=============================================================================================================
 /**
  * DECLARE CLASS WriteToFile
@@ -138,6 +139,38 @@ public:
      */
     void initPluginControlWidgets();
 
+    //=========================================================================================================
+    /**
+     * Sets the data type of the recorded raw buffers. Takes effect with the next recording.
+     *
+     * @param[in] iDataType   FIFFT_FLOAT, FIFFT_INT or FIFFT_SHORT.
+     */
+    void setDataType(FIFFLIB::fiff_int_t iDataType);
+
+    //=========================================================================================================
+    /**
+     * Returns the data type of the recorded raw buffers.
+     *
+     * @return FIFFT_FLOAT, FIFFT_INT or FIFFT_SHORT.
+     */
+    FIFFLIB::fiff_int_t getDataType() const;
+
+    //=========================================================================================================
+    /**
+     * Sets the size at which a recording continues in a new file. Takes effect with the next recording.
+     *
+     * @param[in] iSizeMB   The split size in MB (1000*1000 bytes).
+     */
+    void setSplitSize(int iSizeMB);
+
+    //=========================================================================================================
+    /**
+     * Returns the size at which a recording continues in a new file.
+     *
+     * @return The split size in MB (1000*1000 bytes).
+     */
+    int getSplitSize() const;
+
 private:
     //=========================================================================================================
     /**
@@ -175,12 +208,6 @@ private:
      */
     void toggleRecordingFile();
 
-    //=========================================================================================================
-    /**
-     * Determines current file. And starts a new one.
-     */
-    void splitRecordingFile();
-
     //=========================================================================================================
     /**
      * change recording button.
@@ -191,25 +218,23 @@ private:
     bool                                    m_bUseRecordTimer;              /**< Flag whether to use data recording timer.*/
 
     qint16                                  m_iBlinkStatus;                 /**< The blink status of the recording button.*/
-    qint32                                  m_iSplitCount;                  /**< File split count */
     int                                     m_iRecordingMSeconds;           /**< Recording length in mseconds.*/
-
-    QMutex                                  m_mutex;                        /**< The threads mutex.*/
+    int                                     m_iSplitSizeMB;                 /**< Size in MB at which a recording continues in a new file.*/
+    FIFFLIB::fiff_int_t                     m_iDataType;                    /**< Data type of the recorded raw buffers.*/
 
     QSharedPointer<FIFFLIB::FiffInfo>       m_pFiffInfo;                    /**< Fiff measurement info.*/
-    QSharedPointer<FIFFLIB::FiffStream>     m_pOutfid;                      /**< FiffStream to write to.*/
+    QSharedPointer<FiffRawWriter>           m_pRawWriter;                   /**< Converts and writes the raw buffers on a background thread.*/
 
     QSharedPointer<QTimer>                  m_pUpdateTimeInfoTimer;         /**< timer to control remaining time. */
     QSharedPointer<QTimer>                  m_pBlinkingRecordButtonTimer;   /**< timer to control blinking recording button. */
     QSharedPointer<QTimer>                  m_pRecordTimer;                 /**< timer to control recording time. */
 
-    QFile                                   m_qFileOut;                     /**< QFile for writing to fif file.*/
     QString                                 m_sRecordFileName;              /**< Current record file. */
     QTime                                   m_recordingStartedTime;         /**< The time when the recording started.*/
 
     QPointer<QAction>                       m_pActionRecordFile;            /**< start recording action */
 
-    QSharedPointer<UTILSLIB::CircularBuffer_Matrix_double>                      m_pCircularBuffer;      /**< Holds incoming raw data. */
+    QSharedPointer<SCMEASLIB::CircularBuffer_SampleBlock>                       m_pCircularBuffer;      /**< Holds incoming raw data. */
 
     SCSHAREDLIB::PluginInputData<SCMEASLIB::RealTimeMultiSampleArray>::SPtr      m_pWriteToFileInput;   /**< The RealTimeMultiSampleArray of the WriteToFile input.*/
 };
@@ -98,10 +98,12 @@ CONFIG(debug, debug|release) {
 
 SOURCES += \
         writetofile.cpp \
+        fiffrawwriter.cpp \
         FormFiles/writetofilesetupwidget.cpp \
 
 HEADERS += \
         writetofile.h\
+        fiffrawwriter.h \
         writetofile_global.h \
         FormFiles/writetofilesetupwidget.h \
 
@@ -283,7 +283,7 @@ int main(int argc, char *argv[])
     } else {
         //Create source level data
         QFile t_fileFwd(sFwd);
-        t_Fwd = MNEForwardSolution(t_fileFwd, false, true);
+        t_Fwd = MNEForwardSolution(t_fileFwd, false, true, defaultQStringList, defaultQStringList, false, true);
 
         // Load data
         MNESourceEstimate sourceEstimate;
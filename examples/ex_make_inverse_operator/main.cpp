@@ -116,7 +116,8 @@ int main(int argc, char *argv[])
     if(evoked.isEmpty())
         return 1;
 
-    MNEForwardSolution t_forwardMeeg(t_fileFwdMeeg, false, true);
+    // The gain matrix is memory mapped, the inverse setup only reads the channels it uses
+    MNEForwardSolution t_forwardMeeg(t_fileFwdMeeg, false, true, defaultQStringList, defaultQStringList, false, true);
 
     FiffCov noise_cov(t_fileCov);
 
@@ -126,7 +127,7 @@ int main(int argc, char *argv[])
     // Restrict forward solution as necessary for MEG
     MNEForwardSolution t_forwardMeg = t_forwardMeeg.pick_types(true, false);
     // Alternatively, you can just load a forward solution that is restricted
-    MNEForwardSolution t_forwardEeg(t_fileFwdEeg, false, true);
+    MNEForwardSolution t_forwardEeg(t_fileFwdEeg, false, true, defaultQStringList, defaultQStringList, false, true);
 
     // make an M/EEG, MEG-only, and EEG-only inverse operators
     FiffInfo info = evoked.info;
@@ -84,6 +84,7 @@ bool RtClient::getConnectionStatus()
 bool RtClient::stop()
 {
     m_bIsRunning = false;
+    QThread::quit();
     //QThread::wait();
 
     return true;
@@ -134,10 +135,6 @@ void RtClient::run()
     //
     // Inits
     //
-    MatrixXf matData;
-
-    fiff_int_t kind;
-
     qint32 from = 0;
     qint32 to = -1;
 
@@ -161,30 +158,35 @@ void RtClient::run()
 
     m_pFiffInfo = t_dataClient.readInfo();
 
-    // start measurement
-    t_cmdClient["start"].pValues()[0].setValue(clientId);
-    t_cmdClient["start"].send();
+    //
+    // Receive the raw buffers in the event loop of this thread, instead of polling the socket
+    //
+    connect(&t_dataClient, &RtDataClient::rawBufferReceived,
+            &t_dataClient, [this, &from, &to](QSharedPointer<MatrixXf> pMatData) {
+        to += pMatData->cols();
+        printf("Reading %d ... %d  =  %9.3f ... %9.3f secs...", from, to, ((float)from)/m_pFiffInfo->sfreq, ((float)to)/m_pFiffInfo->sfreq);
+        from += pMatData->cols();
 
-    while(m_bIsRunning)
-    {
+        emit rawBufferReceived(*pMatData);
 
-//        while(m_bIsMeasuring)
+        printf("[done]\n");
+    });
+    connect(&t_dataClient, &RtDataClient::rawDataEnded,
+            &t_dataClient, [this]() { QThread::quit(); });
+    connect(&t_dataClient, &QTcpSocket::disconnected,
+            &t_dataClient, [this]() { QThread::quit(); });
 
-        t_dataClient.readRawBuffer(m_pFiffInfo->nchan, matData, kind);
+    t_dataClient.startReceiving(m_pFiffInfo->nchan);
 
-        if(kind == FIFF_DATA_BUFFER)
-        {
-            to += matData.cols();
-            printf("Reading %d ... %d  =  %9.3f ... %9.3f secs...", from, to, ((float)from)/m_pFiffInfo->sfreq, ((float)to)/m_pFiffInfo->sfreq);
-            from += matData.cols();
+    // start measurement
+    t_cmdClient["start"].pValues()[0].setValue(clientId);
+    t_cmdClient["start"].send();
 
-            emit rawBufferReceived(matData);
-        }
-        else if(FIFF_DATA_BUFFER == FIFF_BLOCK_END)
-            m_bIsRunning = false;
+    if(m_bIsRunning)
+        exec();
 
-        printf("[done]\n");
-    }
+    t_dataClient.stopReceiving();
+    m_bIsRunning = false;
 
     //
     // Disconnect Stuff
@@ -41,6 +41,13 @@
 #include "rtdataclient.h"
 #include <fiff/fiff_file.h>
 
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QMutex>
+#include <QtEndian>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
@@ -49,6 +56,74 @@ using namespace COMMUNICATIONLIB;
 using namespace FIFFLIB;
 using namespace Eigen;
 
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+/**
+ * Converts big endian floats straight into the data matrix, without an intermediate tag.
+ */
+static void decodeFloatBuffer(const char* payload, MatrixXf& data)
+{
+    FiffTag::decode_data_buffer(payload,
+                                data.size() * sizeof(float),
+                                FIFFT_FLOAT,
+                                FIFFV_BIG_ENDIAN,
+                                data.rows(),
+                                data.cols(),
+                                data);
+}
+
+//=============================================================================================================
+
+/**
+ * Matrices emitted in asynchronous mode. A matrix returns to the pool when its last shared pointer is released,
+ * the pool stays alive as long as one of its matrices is in use.
+ */
+struct RtDataClient::RawBufferPool
+{
+    static const int MAX_FREE = 16;
+
+    QMutex mutex;
+    QList<MatrixXf*> lFree;
+
+    ~RawBufferPool()
+    {
+        qDeleteAll(lFree);
+    }
+
+    static QSharedPointer<MatrixXf> acquire(const QSharedPointer<RawBufferPool>& pPool, qint32 iRows, qint32 iCols)
+    {
+        MatrixXf* pMat = Q_NULLPTR;
+        {
+            QMutexLocker locker(&pPool->mutex);
+            for(int i = 0; i < pPool->lFree.size(); ++i)
+            {
+                if(pPool->lFree[i]->rows() == iRows && pPool->lFree[i]->cols() == iCols)
+                {
+                    pMat = pPool->lFree.takeAt(i);
+                    break;
+                }
+            }
+            if(!pMat && !pPool->lFree.isEmpty())
+                pMat = pPool->lFree.takeLast();
+        }
+
+        if(!pMat)
+            pMat = new MatrixXf;
+        if(pMat->rows() != iRows || pMat->cols() != iCols)
+            pMat->resize(iRows, iCols);
+
+        return QSharedPointer<MatrixXf>(pMat, [pPool](MatrixXf* pReleased) {
+            QMutexLocker locker(&pPool->mutex);
+            if(pPool->lFree.size() < MAX_FREE)
+                pPool->lFree.append(pReleased);
+            else
+                delete pReleased;
+        });
+    }
+};
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -56,7 +131,14 @@ using namespace Eigen;
 RtDataClient::RtDataClient(QObject *parent)
 : QTcpSocket(parent)
 , m_clientID(-1)
+, m_iReadPos(0)
+, m_iAsyncChannels(0)
+, m_pBufferPool(new RawBufferPool)
 {
+    qRegisterMetaType<QSharedPointer<Eigen::MatrixXf> >("QSharedPointer<Eigen::MatrixXf>");
+
+    m_receiveBuffer.reserve(1024 * 1024);
+
     getClientId();
 }
 
@@ -81,11 +163,9 @@ qint32 RtDataClient::getClientId()
         QString t_sCommand("");
         t_fiffStream.write_rt_command(1, t_sCommand);
 
-        this->waitForReadyRead(100);
         // ID is send as answer
         FiffTag::SPtr t_pTag;
-        t_fiffStream.read_tag(t_pTag);
-        if (t_pTag->kind == FIFF_MNE_RT_CLIENT_ID)
+        if (readTag(t_pTag, 100) && t_pTag->kind == FIFF_MNE_RT_CLIENT_ID)
             m_clientID = *t_pTag->toInt();
     }
     return m_clientID;
@@ -100,14 +180,14 @@ FiffInfo::SPtr RtDataClient::readInfo()
     bool t_bReadMeasBlockEnd = false;
     QString col_names, row_names;
 
-    FiffStream t_fiffStream(this);
     //
     // Find the start
     //
     FiffTag::SPtr t_pTag;
     while(!t_bReadMeasBlockStart)
     {
-        t_fiffStream.read_rt_tag(t_pTag);
+        if(!readTag(t_pTag))
+            return p_pFiffInfo;
         if(t_pTag->kind == FIFF_BLOCK_START && *(t_pTag->toInt()) == FIFFB_MEAS_INFO)
         {
             printf("FIFF_BLOCK_START FIFFB_MEAS_INFO\n");
@@ -124,7 +204,8 @@ FiffInfo::SPtr RtDataClient::readInfo()
 
     while(!t_bReadMeasBlockEnd)
     {
-        t_fiffStream.read_rt_tag(t_pTag);
+        if(!readTag(t_pTag))
+            return p_pFiffInfo;
         //
         //  megacq parameters
         //
@@ -132,7 +213,8 @@ FiffInfo::SPtr RtDataClient::readInfo()
         {
             while(t_pTag->kind != FIFF_BLOCK_END || *(t_pTag->toInt()) != FIFFB_DACQ_PARS)
             {
-                t_fiffStream.read_rt_tag(t_pTag);
+                if(!readTag(t_pTag))
+                    return p_pFiffInfo;
                 if(t_pTag->kind == FIFF_DACQ_PARS)
                     p_pFiffInfo->acq_pars = t_pTag->toString();
                 else if(t_pTag->kind == FIFF_DACQ_STIM)
@@ -162,7 +244,8 @@ FiffInfo::SPtr RtDataClient::readInfo()
         {
             while(t_pTag->kind != FIFF_BLOCK_END || *(t_pTag->toInt()) != FIFFB_ISOTRAK)
             {
-                t_fiffStream.read_rt_tag(t_pTag);
+                if(!readTag(t_pTag))
+                    return p_pFiffInfo;
 
                 if(t_pTag->kind == FIFF_DIG_POINT)
                     p_pFiffInfo->dig.append(t_pTag->toDigPoint());
@@ -175,14 +258,16 @@ FiffInfo::SPtr RtDataClient::readInfo()
         {
             while(t_pTag->kind != FIFF_BLOCK_END || *(t_pTag->toInt()) != FIFFB_PROJ)
             {
-                t_fiffStream.read_rt_tag(t_pTag);
+                if(!readTag(t_pTag))
+                    return p_pFiffInfo;
                 if(t_pTag->kind == FIFF_BLOCK_START && *(t_pTag->toInt()) == FIFFB_PROJ_ITEM)
                 {
                     FiffProj proj;
                     qint32 countProj = p_pFiffInfo->projs.size();
                     while(t_pTag->kind != FIFF_BLOCK_END || *(t_pTag->toInt()) != FIFFB_PROJ_ITEM)
                     {
-                        t_fiffStream.read_rt_tag(t_pTag);
+                        if(!readTag(t_pTag))
+                            return p_pFiffInfo;
                         switch (t_pTag->kind)
                         {
                         case FIFF_NAME: // First proj -> Proj is created
@@ -228,14 +313,16 @@ FiffInfo::SPtr RtDataClient::readInfo()
         {
             while(t_pTag->kind != FIFF_BLOCK_END || *(t_pTag->toInt()) != FIFFB_MNE_CTF_COMP)
             {
-                t_fiffStream.read_rt_tag(t_pTag);
+                if(!readTag(t_pTag))
+                    return p_pFiffInfo;
                 if(t_pTag->kind == FIFF_BLOCK_START && *(t_pTag->toInt()) == FIFFB_MNE_CTF_COMP_DATA)
                 {
                     FiffCtfComp comp;
                     qint32 countComp = p_pFiffInfo->comps.size();
                     while(t_pTag->kind != FIFF_BLOCK_END || *(t_pTag->toInt()) != FIFFB_MNE_CTF_COMP_DATA)
                     {
-                        t_fiffStream.read_rt_tag(t_pTag);
+                        if(!readTag(t_pTag))
+                            return p_pFiffInfo;
                         switch (t_pTag->kind)
                         {
                         case FIFF_MNE_CTF_COMP_KIND: //First comp -> create comp
@@ -291,7 +378,8 @@ FiffInfo::SPtr RtDataClient::readInfo()
         {
             while(t_pTag->kind != FIFF_BLOCK_END || *(t_pTag->toInt()) != FIFFB_MNE_BAD_CHANNELS)
             {
-                t_fiffStream.read_rt_tag(t_pTag);
+                if(!readTag(t_pTag))
+                    return p_pFiffInfo;
                 if(t_pTag->kind == FIFF_MNE_CH_NAME_LIST)
                     p_pFiffInfo->bads = FiffStream::split_name_list(t_pTag->data());
             }
@@ -370,20 +458,25 @@ void RtDataClient::readRawBuffer(qint32 p_nChannels,
                                  MatrixXf& data,
                                  fiff_int_t& kind)
 {
-    FiffStream t_fiffStream(this);
-    //
-    // Find the start
-    //
-    FiffTag::SPtr t_pTag;
+    fiff_int_t type;
+    qint32 size;
+    const char* payload;
 
-    t_fiffStream.read_rt_tag(t_pTag);
-
-    kind = t_pTag->kind;
+    while(!nextTag(kind, type, size, payload))
+    {
+        if(!fillReceiveBuffer(100) && state() != QAbstractSocket::ConnectedState)
+        {
+            kind = -1;
+            return;
+        }
+    }
 
-    if(kind == FIFF_DATA_BUFFER)
+    if(kind == FIFF_DATA_BUFFER && type == FIFFT_FLOAT)
     {
-        qint32 nSamples = (t_pTag->size()/4)/p_nChannels;
-        data = MatrixXf(Map< MatrixXf >(t_pTag->toFloat(), p_nChannels, nSamples));
+        qint32 nSamples = (size/4)/p_nChannels;
+        if(data.rows() != p_nChannels || data.cols() != nSamples)
+            data.resize(p_nChannels, nSamples);
+        decodeFloatBuffer(payload, data);
     }
 //        else
 //            data = tag.data;
@@ -391,9 +484,139 @@ void RtDataClient::readRawBuffer(qint32 p_nChannels,
 
 //=============================================================================================================
 
+void RtDataClient::startReceiving(qint32 p_nChannels)
+{
+    m_iAsyncChannels = p_nChannels;
+    connect(this, &QTcpSocket::readyRead,
+            this, &RtDataClient::onReadyRead, Qt::UniqueConnection);
+
+    // Data which arrived before the mode switch does not trigger readyRead again
+    onReadyRead();
+}
+
+//=============================================================================================================
+
+void RtDataClient::stopReceiving()
+{
+    disconnect(this, &QTcpSocket::readyRead,
+               this, &RtDataClient::onReadyRead);
+    m_iAsyncChannels = 0;
+}
+
+//=============================================================================================================
+
 void RtDataClient::setClientAlias(const QString &p_sAlias)
 {
     FiffStream t_fiffStream(this);
     t_fiffStream.write_rt_command(2, p_sAlias);//MNE_RT.MNE_RT_SET_CLIENT_ALIAS, alias);
     this->flush();
 }
+
+//=============================================================================================================
+
+bool RtDataClient::fillReceiveBuffer(int msecs)
+{
+    if(bytesAvailable() <= 0 && (msecs == 0 || !waitForReadyRead(msecs)))
+        return false;
+
+    // Move the incomplete tag to the front, the capacity of the buffer is kept
+    if(m_iReadPos > 0)
+    {
+        int iRemaining = m_receiveBuffer.size() - m_iReadPos;
+        if(iRemaining > 0)
+            memmove(m_receiveBuffer.data(), m_receiveBuffer.constData() + m_iReadPos, iRemaining);
+        m_receiveBuffer.resize(iRemaining);
+        m_iReadPos = 0;
+    }
+
+    int iOldSize = m_receiveBuffer.size();
+    qint64 iAvailable = bytesAvailable();
+    if(iOldSize + iAvailable > m_receiveBuffer.capacity())
+        m_receiveBuffer.reserve(static_cast<int>(iOldSize + iAvailable));
+    m_receiveBuffer.resize(static_cast<int>(iOldSize + iAvailable));
+
+    qint64 iRead = read(m_receiveBuffer.data() + iOldSize, iAvailable);
+    m_receiveBuffer.resize(iOldSize + static_cast<int>(qMax<qint64>(iRead, 0)));
+
+    return iRead > 0;
+}
+
+//=============================================================================================================
+
+bool RtDataClient::nextTag(fiff_int_t& kind,
+                           fiff_int_t& type,
+                           qint32& size,
+                           const char*& payload)
+{
+    const int iHeaderSize = 4 * sizeof(qint32);
+    const int iAvailable = m_receiveBuffer.size() - m_iReadPos;
+    if(iAvailable < iHeaderSize)
+        return false;
+
+    const uchar* pHeader = reinterpret_cast<const uchar*>(m_receiveBuffer.constData() + m_iReadPos);
+    qint32 iSize = qFromBigEndian<qint32>(pHeader + 8);
+    if(iSize < 0 || iAvailable - iHeaderSize < iSize)
+        return false;
+
+    kind = qFromBigEndian<qint32>(pHeader);
+    type = qFromBigEndian<qint32>(pHeader + 4);
+    size = iSize;
+    payload = m_receiveBuffer.constData() + m_iReadPos + iHeaderSize;
+    m_iReadPos += iHeaderSize + iSize;
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool RtDataClient::readTag(FiffTag::SPtr& p_pTag,
+                           int msecs)
+{
+    fiff_int_t kind, type;
+    qint32 size;
+    const char* payload;
+
+    while(!nextTag(kind, type, size, payload))
+    {
+        if(!fillReceiveBuffer(msecs < 0 ? 100 : msecs) && (msecs >= 0 || state() != QAbstractSocket::ConnectedState))
+            return false;
+    }
+
+    p_pTag = FiffTag::SPtr(new FiffTag());
+    p_pTag->kind = kind;
+    p_pTag->type = type;
+    p_pTag->next = FIFFV_NEXT_SEQ;
+    if(size > 0)
+    {
+        p_pTag->resize(size);
+        memcpy(p_pTag->data(), payload, size);
+        FiffTag::convert_tag_data(p_pTag, FIFFV_BIG_ENDIAN, FIFFV_NATIVE_ENDIAN);
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+void RtDataClient::onReadyRead()
+{
+    fillReceiveBuffer(0);
+
+    fiff_int_t kind, type;
+    qint32 size;
+    const char* payload;
+
+    while(m_iAsyncChannels > 0 && nextTag(kind, type, size, payload))
+    {
+        if(kind == FIFF_DATA_BUFFER && type == FIFFT_FLOAT)
+        {
+            QSharedPointer<MatrixXf> pMatRawBuffer = RawBufferPool::acquire(m_pBufferPool, m_iAsyncChannels, (size/4)/m_iAsyncChannels);
+            decodeFloatBuffer(payload, *pMatRawBuffer);
+            emit rawBufferReceived(pMatRawBuffer);
+        }
+        else if(kind == FIFF_BLOCK_END && size >= 4 && qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(payload)) == FIFFB_RAW_DATA)
+        {
+            emit rawDataEnded();
+        }
+    }
+}
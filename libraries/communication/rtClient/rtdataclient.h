@@ -54,6 +54,7 @@
 #include <QSharedPointer>
 #include <QString>
 #include <QTcpSocket>
+#include <QByteArray>
 
 //=============================================================================================================
 // DEFINE NAMESPACE COMMUNICATIONLIB
@@ -110,16 +111,33 @@ public:
 
     //=========================================================================================================
     /**
-     * Reads fiff measurement information of a data the connection
+     * Reads the next tag and decodes it when it is a raw buffer. Blocks until a complete tag was received.
+     * The data matrix is only reallocated when its size changes, so a caller which keeps the matrix does not
+     * allocate per buffer.
      *
      * @param[in] p_nChannels    Number of channels to reshape the received data
      * @param[out] data          The read data - ToDo change this to raw buffer data object
-     * @param[out] kind          Data kind
+     * @param[out] kind          Data kind, -1 if the connection was closed
      */
     void readRawBuffer(qint32 p_nChannels,
                        Eigen::MatrixXf& data,
                        FIFFLIB::fiff_int_t& kind);
 
+    //=========================================================================================================
+    /**
+     * Starts the asynchronous mode. Received data is parsed whenever the socket signals readyRead and every raw
+     * buffer is emitted with rawBufferReceived. Requires an event loop in the thread of the client.
+     *
+     * @param[in] p_nChannels    Number of channels to reshape the received data
+     */
+    void startReceiving(qint32 p_nChannels);
+
+    //=========================================================================================================
+    /**
+     * Stops the asynchronous mode.
+     */
+    void stopReceiving();
+
     //=========================================================================================================
     /**
      * Sets the alias of the data client
@@ -128,9 +146,75 @@ public:
      */
     void setClientAlias(const QString &p_sAlias);
 
+signals:
+    //=========================================================================================================
+    /**
+     * Emitted for every received raw buffer in asynchronous mode. The matrix is taken from a pool and returns
+     * to it when the last reference is released, so consumers should not hold on to it longer than necessary.
+     *
+     * @param[in] pMatRawBuffer  The received raw buffer, channels x samples.
+     */
+    void rawBufferReceived(QSharedPointer<Eigen::MatrixXf> pMatRawBuffer);
+
+    //=========================================================================================================
+    /**
+     * Emitted in asynchronous mode when the server ends the raw data block.
+     */
+    void rawDataEnded();
+
 private:
-    qint32 m_clientID;  /**< Corresponding client id of the data client at mne_rt_server */
-    
+    struct RawBufferPool;
+
+    //=========================================================================================================
+    /**
+     * Appends the available socket data to the receive buffer.
+     *
+     * @param[in] msecs  Time to wait for data when none is available. 0 does not wait.
+     *
+     * @return true if data was appended, false otherwise.
+     */
+    bool fillReceiveBuffer(int msecs);
+
+    //=========================================================================================================
+    /**
+     * Takes the next complete tag from the receive buffer. The payload points into the receive buffer and is
+     * valid until the next call of fillReceiveBuffer.
+     *
+     * @param[out] kind      Tag kind.
+     * @param[out] type      Tag type.
+     * @param[out] size      Payload size in bytes.
+     * @param[out] payload   Big endian payload.
+     *
+     * @return true if a complete tag was available, false otherwise.
+     */
+    bool nextTag(FIFFLIB::fiff_int_t& kind,
+                 FIFFLIB::fiff_int_t& type,
+                 qint32& size,
+                 const char*& payload);
+
+    //=========================================================================================================
+    /**
+     * Reads the next tag from the receive buffer into a FiffTag.
+     *
+     * @param[out] p_pTag    The read tag.
+     * @param[in] msecs      Time to wait for data, -1 waits until the connection is closed.
+     *
+     * @return true if a tag was read, false otherwise.
+     */
+    bool readTag(FIFFLIB::FiffTag::SPtr& p_pTag,
+                 int msecs = -1);
+
+    //=========================================================================================================
+    /**
+     * Parses all complete tags in asynchronous mode.
+     */
+    void onReadyRead();
+
+    qint32 m_clientID;                              /**< Corresponding client id of the data client at mne_rt_server */
+    QByteArray m_receiveBuffer;                     /**< Reusable receive buffer, the capacity is kept. */
+    int m_iReadPos;                                 /**< Start of the unparsed data in m_receiveBuffer. */
+    qint32 m_iAsyncChannels;                        /**< Number of channels in asynchronous mode, 0 if inactive. */
+    QSharedPointer<RawBufferPool> m_pBufferPool;    /**< Pool of the matrices emitted in asynchronous mode. */
 };
 } // NAMESPACE
 
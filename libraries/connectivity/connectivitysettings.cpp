@@ -68,6 +68,33 @@ using namespace FSLIB;
 // DEFINE GLOBAL METHODS
 //=============================================================================================================
 
+namespace {
+
+/**
+ * Subtracts the per row trial contribution from the running sum. Returns false if the sum holds data but the trial
+ * does not provide a matching contribution.
+ */
+template<typename T>
+bool subtractPairs(QVector<QPair<int,T> >& vecSum,
+                   const QVector<QPair<int,T> >& vecTrial)
+{
+    if(vecSum.isEmpty()) {
+        return true;
+    }
+
+    if(vecSum.size() != vecTrial.size()) {
+        return false;
+    }
+
+    for (int i = 0; i < vecSum.size(); ++i) {
+        vecSum[i].second -= vecTrial.at(i).second;
+    }
+
+    return true;
+}
+
+} // namespace
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -178,33 +205,18 @@ void ConnectivitySettings::removeFirst(int iAmount)
     }
 
     // Substract influence of trials from overall summed up intermediate data and remove from data list
-    for (int j = 0; j < iAmount; ++j) {
-        for (int i = 0; i < m_trialData.first().matData.rows(); ++i) {
-            if(i < m_intermediateSumData.vecPairCsdSum.size() && (m_intermediateSumData.vecPairCsdSum.size() == m_trialData.first().vecPairCsd.size())) {
-                m_intermediateSumData.vecPairCsdSum[i].second -= m_trialData.first().vecPairCsd.at(i).second;
-            }
-            if(i < m_intermediateSumData.vecPairCsdNormalizedSum.size() && (m_intermediateSumData.vecPairCsdNormalizedSum.size() == m_trialData.first().vecPairCsdNormalized.size())) {
-                m_intermediateSumData.vecPairCsdNormalizedSum[i].second -= m_trialData.first().vecPairCsdNormalized.at(i).second;
-            }
-            if(i < m_intermediateSumData.vecPairCsdImagSignSum.size() && (m_intermediateSumData.vecPairCsdImagSignSum.size() == m_trialData.first().vecPairCsdImagSign.size())) {
-                m_intermediateSumData.vecPairCsdImagSignSum[i].second -= m_trialData.first().vecPairCsdImagSign.at(i).second;
-            }
-            if(i < m_intermediateSumData.vecPairCsdImagAbsSum.size() && (m_intermediateSumData.vecPairCsdImagAbsSum.size() == m_trialData.first().vecPairCsdImagAbs.size())) {
-                m_intermediateSumData.vecPairCsdImagAbsSum[i].second -= m_trialData.first().vecPairCsdImagAbs.at(i).second;
-            }
-            if(i < m_intermediateSumData.vecPairCsdImagSqrdSum.size() && (m_intermediateSumData.vecPairCsdImagSqrdSum.size() == m_trialData.first().vecPairCsdImagSqrd.size())) {
-                m_intermediateSumData.vecPairCsdImagSqrdSum[i].second -= m_trialData.first().vecPairCsdImagSqrd.at(i).second;
-            }
-        }
-
-        if(m_intermediateSumData.matPsdSum.rows() == m_trialData.first().matPsd.rows() &&
-           m_intermediateSumData.matPsdSum.cols() == m_trialData.first().matPsd.cols() ) {
-            m_intermediateSumData.matPsdSum -= m_trialData.first().matPsd;
-        }
+    bool bSumsValid = true;
 
+    for (int j = 0; j < iAmount; ++j) {
+        bSumsValid &= subtractContribution(m_trialData.first());
         m_trialData.removeFirst();
     }
 
+    // Sums which still hold a removed trial have to be rebuilt from the remaining trials
+    if(!bSumsValid) {
+        clearIntermediateData();
+    }
+
 //    iTime = timer.elapsed();
 //    qDebug() << "ConnectivitySettings::removeFirst" << iTime;
 //    timer.restart();
@@ -229,33 +241,18 @@ void ConnectivitySettings::removeLast(int iAmount)
     }
 
     // Substract influence of trials from overall summed up intermediate data and remove from data list
-    for (int j = 0; j < iAmount; ++j) {
-        for (int i = 0; i < m_trialData.last().matData.rows(); ++i) {
-            if(i < m_intermediateSumData.vecPairCsdSum.size() && (m_intermediateSumData.vecPairCsdSum.size() == m_trialData.last().vecPairCsd.size())) {
-                m_intermediateSumData.vecPairCsdSum[i].second -= m_trialData.last().vecPairCsd.at(i).second;
-            }
-            if(i < m_intermediateSumData.vecPairCsdNormalizedSum.size() && (m_intermediateSumData.vecPairCsdNormalizedSum.size() == m_trialData.last().vecPairCsdNormalized.size())) {
-                m_intermediateSumData.vecPairCsdNormalizedSum[i].second -= m_trialData.last().vecPairCsdNormalized.at(i).second;
-            }
-            if(i < m_intermediateSumData.vecPairCsdImagSignSum.size() && (m_intermediateSumData.vecPairCsdImagSignSum.size() == m_trialData.last().vecPairCsdImagSign.size())) {
-                m_intermediateSumData.vecPairCsdImagSignSum[i].second -= m_trialData.last().vecPairCsdImagSign.at(i).second;
-            }
-            if(i < m_intermediateSumData.vecPairCsdImagAbsSum.size() && (m_intermediateSumData.vecPairCsdImagAbsSum.size() == m_trialData.last().vecPairCsdImagAbs.size())) {
-                m_intermediateSumData.vecPairCsdImagAbsSum[i].second -= m_trialData.last().vecPairCsdImagAbs.at(i).second;
-            }
-            if(i < m_intermediateSumData.vecPairCsdImagSqrdSum.size() && (m_intermediateSumData.vecPairCsdImagSqrdSum.size() == m_trialData.last().vecPairCsdImagSqrd.size())) {
-                m_intermediateSumData.vecPairCsdImagSqrdSum[i].second -= m_trialData.last().vecPairCsdImagSqrd.at(i).second;
-            }
-        }
-
-        if(m_intermediateSumData.matPsdSum.rows() == m_trialData.last().matPsd.rows() &&
-           m_intermediateSumData.matPsdSum.cols() == m_trialData.last().matPsd.cols() ) {
-            m_intermediateSumData.matPsdSum -= m_trialData.last().matPsd;
-        }
+    bool bSumsValid = true;
 
+    for (int j = 0; j < iAmount; ++j) {
+        bSumsValid &= subtractContribution(m_trialData.last());
         m_trialData.removeLast();
     }
 
+    // Sums which still hold a removed trial have to be rebuilt from the remaining trials
+    if(!bSumsValid) {
+        clearIntermediateData();
+    }
+
 //    iTime = timer.elapsed();
 //    qDebug() << "ConnectivitySettings::removeLast" << iTime;
 //    timer.restart();
@@ -416,3 +413,25 @@ ConnectivitySettings::IntermediateSumData& ConnectivitySettings::getIntermediate
 {
     return m_intermediateSumData;
 }
+
+//*******************************************************************************************************
+
+bool ConnectivitySettings::subtractContribution(const IntermediateTrialData& trialData)
+{
+    bool bValid = subtractPairs(m_intermediateSumData.vecPairCsdSum, trialData.vecPairCsd);
+    bValid &= subtractPairs(m_intermediateSumData.vecPairCsdNormalizedSum, trialData.vecPairCsdNormalized);
+    bValid &= subtractPairs(m_intermediateSumData.vecPairCsdImagSignSum, trialData.vecPairCsdImagSign);
+    bValid &= subtractPairs(m_intermediateSumData.vecPairCsdImagAbsSum, trialData.vecPairCsdImagAbs);
+    bValid &= subtractPairs(m_intermediateSumData.vecPairCsdImagSqrdSum, trialData.vecPairCsdImagSqrd);
+
+    if(m_intermediateSumData.matPsdSum.size() != 0) {
+        if(m_intermediateSumData.matPsdSum.rows() == trialData.matPsd.rows() &&
+           m_intermediateSumData.matPsdSum.cols() == trialData.matPsd.cols()) {
+            m_intermediateSumData.matPsdSum -= trialData.matPsd;
+        } else {
+            bValid = false;
+        }
+    }
+
+    return bValid;
+}
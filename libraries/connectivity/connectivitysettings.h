@@ -172,6 +172,12 @@ public:
     IntermediateSumData& getIntermediateSumData();
 
 protected:
+    /**
+     * Subtracts the trial's intermediate data from the summed up intermediate data. Returns false if a sum could not
+     * be corrected because the trial did not store its contribution.
+     */
+    bool subtractContribution(const IntermediateTrialData& trialData);
+
     QStringList                     m_sConnectivityMethods;         /**< The connectivity methods. */
     QString                         m_sWindowType;                  /**< The window type used to compute tapered spectra. */
 
@@ -42,6 +42,8 @@
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QThread>
+
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
@@ -59,6 +61,7 @@ using namespace CONNECTIVITYLIB;
 bool AbstractMetric::m_bStorageModeIsActive = false;
 int AbstractMetric::m_iNumberBinStart = -1;
 int AbstractMetric::m_iNumberBinAmount = -1;
+int AbstractMetric::m_iNumberTrialBlocks = -1;
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -68,3 +71,25 @@ AbstractMetric::AbstractMetric()
 {
 }
 
+//=============================================================================================================
+
+QVector<QPair<int,int> > AbstractMetric::getTrialBlocks(int iNumberTrials)
+{
+    QVector<QPair<int,int> > vecBlocks;
+
+    if(iNumberTrials <= 0) {
+        return vecBlocks;
+    }
+
+    int iNumberBlocks = qBound(1, m_iNumberTrialBlocks > 0 ? m_iNumberTrialBlocks : QThread::idealThreadCount(), iNumberTrials);
+    int iFirst = 0;
+
+    for(int i = 0; i < iNumberBlocks; ++i) {
+        int iLast = iFirst + iNumberTrials / iNumberBlocks + (i < iNumberTrials % iNumberBlocks ? 1 : 0);
+        vecBlocks.append(qMakePair(iFirst, iLast));
+        iFirst = iLast;
+    }
+
+    return vecBlocks;
+}
+
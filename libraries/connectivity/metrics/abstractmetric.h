@@ -47,6 +47,7 @@
 
 #include <QSharedPointer>
 #include <QVector>
+#include <QPair>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -90,8 +91,19 @@ public:
     static bool     m_bStorageModeIsActive;
     static int      m_iNumberBinStart;
     static int      m_iNumberBinAmount;
+    static int      m_iNumberTrialBlocks;   /**< The number of trial blocks processed in parallel. Values <= 0 use one block per thread. */
 
 protected:
+    //=========================================================================================================
+    /**
+     * Splits the trials into contiguous blocks, one per available thread or m_iNumberTrialBlocks if set. Each block
+     * can then be processed in parallel into its own accumulator, which avoids locking a shared result for every trial.
+     *
+     * @param[in] iNumberTrials      The number of trials.
+     *
+     * @return                       The [first, last) trial index pairs of the blocks.
+     */
+    static QVector<QPair<int,int> > getTrialBlocks(int iNumberTrials);
 };
 
 //=============================================================================================================
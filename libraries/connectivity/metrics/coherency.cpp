@@ -142,9 +142,14 @@ void Coherency::calculateAbs(Network& finalNetwork,
                          connectivitySettings.getIntermediateSumData().matPsdSum);
     };
 
+    if(!connectivitySettings.getIntermediateSumData().vecPairCsdSum.isEmpty()) {
+        finalNetwork.initPairWeights(connectivitySettings.getIntermediateSumData().vecPairCsdSum.first().second.cols());
+    }
+
     QFuture<void> resultCSDPSD = QtConcurrent::map(connectivitySettings.getIntermediateSumData().vecPairCsdSum,
                                                    computePSDCSDLambda);
     resultCSDPSD.waitForFinished();
+    finalNetwork.finishPairWeights();
 
 //    iTime = timer.elapsed();
 //    qWarning() << "Compute" << iTime;
@@ -213,9 +218,14 @@ void Coherency::calculateImag(Network& finalNetwork,
                           connectivitySettings.getIntermediateSumData().matPsdSum);
     };
 
+    if(!connectivitySettings.getIntermediateSumData().vecPairCsdSum.isEmpty()) {
+        finalNetwork.initPairWeights(connectivitySettings.getIntermediateSumData().vecPairCsdSum.first().second.cols());
+    }
+
     QFuture<void> resultCSDPSD = QtConcurrent::map(connectivitySettings.getIntermediateSumData().vecPairCsdSum,
                                                    computePSDCSDLambda);
     resultCSDPSD.waitForFinished();
+    finalNetwork.finishPairWeights();
 
 //    iTime = timer.elapsed();
 //    qWarning() << "Compute" << iTime;
@@ -387,20 +397,14 @@ void Coherency::computePSDCSDAbs(QMutex& mutex,
     // Average. Note that the number of trials cancel each other out.
     MatrixXcd matCohy = pairInput.second.cwiseQuotient(matPSDtmp.cwiseSqrt());
 
-    QSharedPointer<NetworkEdge> pEdge;
     MatrixXd matWeight;
     int j;
     int i = pairInput.first;
 
+    // Every map call writes the pairs of a different row, so no locking is needed
     for(j = i; j < matCohy.rows(); ++j) {
         matWeight = matCohy.row(j).cwiseAbs().transpose();
-        pEdge = QSharedPointer<NetworkEdge>(new NetworkEdge(i, j, matWeight));
-
-        mutex.lock();
-        finalNetwork.getNodeAt(i)->append(pEdge);
-        finalNetwork.getNodeAt(j)->append(pEdge);
-        finalNetwork.append(pEdge);
-        mutex.unlock();
+        finalNetwork.setPairWeight(i, j, matWeight);
     }
 }
 
@@ -420,19 +424,13 @@ void Coherency::computePSDCSDImag(QMutex& mutex,
 
     MatrixXcd matCohy = pairInput.second.cwiseQuotient(matPSDtmp.cwiseSqrt());
 
-    QSharedPointer<NetworkEdge> pEdge;
     MatrixXd matWeight;
     int j;
     int i = pairInput.first;
 
+    // Every map call writes the pairs of a different row, so no locking is needed
     for(j = i; j < matCohy.rows(); ++j) {
         matWeight = matCohy.row(j).imag().transpose();
-        pEdge = QSharedPointer<NetworkEdge>(new NetworkEdge(i, j, matWeight));
-
-        mutex.lock();
-        finalNetwork.getNodeAt(i)->append(pEdge);
-        finalNetwork.getNodeAt(j)->append(pEdge);
-        finalNetwork.append(pEdge);
-        mutex.unlock();
+        finalNetwork.setPairWeight(i, j, matWeight);
     }
 }
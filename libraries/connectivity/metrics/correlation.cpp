@@ -111,46 +111,57 @@ Network Correlation::calculate(ConnectivitySettings& connectivitySettings)
 //    qWarning() << "Preparation" << iTime;
 //    timer.restart();
 
-    // Calculate connectivity matrix over epochs and average afterwards
-//    double dScalingStep = 1.0/matDataList.size();
-//    dataTemp.matInputData = dScalingStep * (i+1) * matDataList.at(i);
+    // Calculate connectivity matrix over epochs and average afterwards.
+    // Every block of trials is summed into its own accumulator so the threads never share a result matrix.
+    const QList<ConnectivitySettings::IntermediateTrialData>& lTrialData = connectivitySettings.getTrialData();
+    QVector<QPair<int,int> > vecBlocks = AbstractMetric::getTrialBlocks(lTrialData.size());
+    QVector<MatrixXd> vecAccumulators(vecBlocks.size());
+    QVector<int> vecBlockIdx(vecBlocks.size());
+
+    for(int i = 0; i < vecBlockIdx.size(); ++i) {
+        vecBlockIdx[i] = i;
+        vecAccumulators[i] = MatrixXd::Zero(rows, rows);
+    }
 
-    QFuture<MatrixXd> resultMat = QtConcurrent::mappedReduced(connectivitySettings.getTrialData(),
-                                                              compute,
-                                                              reduce);
-    resultMat.waitForFinished();
+    std::function<void(int&)> computeLambda = [&](int& iBlock) {
+        for(int iTrial = vecBlocks.at(iBlock).first; iTrial < vecBlocks.at(iBlock).second; ++iTrial) {
+            compute(lTrialData.at(iTrial),
+                    vecAccumulators[iBlock]);
+        }
+    };
 
-    MatrixXd matDist = resultMat.result();
+    QFuture<void> result = QtConcurrent::map(vecBlockIdx,
+                                             computeLambda);
+    result.waitForFinished();
 
-//    MatrixXd matDist;
+    MatrixXd matDist = MatrixXd::Zero(rows, rows);
 
-//    for(int i = 0; i < connectivitySettings.getTrialData().size(); ++i) {
-//        reduce(matDist, compute(connectivitySettings.getTrialData().at(i)));
-//    }
+    for(int i = 0; i < vecAccumulators.size(); ++i) {
+        matDist += vecAccumulators.at(i);
+    }
 
-//    matDist /= connectivitySettings.size();
+    matDist /= connectivitySettings.size();
 
 //    iTime = timer.elapsed();
 //    qWarning() << "ComputeSpectraPSDCSD" << iTime;
 //    timer.restart();
 
     //Add edges to network
+    finalNetwork.initPairWeights(1);
+
     MatrixXd matWeight(1,1);
-    QSharedPointer<NetworkEdge> pEdge;
     int j;
 
     for(int i = 0; i < matDist.rows(); ++i) {
         for(j = i; j < matDist.cols(); ++j) {
             matWeight << matDist(i,j);
 
-            pEdge = QSharedPointer<NetworkEdge>(new NetworkEdge(i, j, matWeight));
-
-            finalNetwork.getNodeAt(i)->append(pEdge);
-            finalNetwork.getNodeAt(j)->append(pEdge);
-            finalNetwork.append(pEdge);
+            finalNetwork.setPairWeight(i, j, matWeight);
         }
     }
 
+    finalNetwork.finishPairWeights();
+
 //    iTime = timer.elapsed();
 //    qWarning() << "Compute" << iTime;
 //    timer.restart();
@@ -160,34 +171,19 @@ Network Correlation::calculate(ConnectivitySettings& connectivitySettings)
 
 //=============================================================================================================
 
-MatrixXd Correlation::compute(const ConnectivitySettings::IntermediateTrialData& inputData)
+void Correlation::compute(const ConnectivitySettings::IntermediateTrialData& inputData,
+                          MatrixXd& matDist)
 {
-    MatrixXd matDist = MatrixXd::Zero(inputData.matData.rows(), inputData.matData.rows());
-    RowVectorXd vecRow;
-    int j;
-
-    matDist = inputData.matData * inputData.matData.transpose();
+    // Remove the mean and scale every row to unit norm, so that the inner products are the correlation coefficients
+    MatrixXd matNormalized = inputData.matData.colwise() - inputData.matData.rowwise().mean();
+    VectorXd vecNorms = matNormalized.rowwise().norm();
 
-//    for(int i = 0; i < inputData.matData.rows(); ++i) {
-//        vecRow = inputData.matData.row(i);
-
-//        for(j = i; j < inputData.matData.rows(); ++j) {
-//            matDist(i,j) += (vecRow.dot(inputData.matData.row(j))/vecRow.cols());
-//        }
-//    }
-
-    return matDist;
-}
-
-//=============================================================================================================
-
-void Correlation::reduce(MatrixXd &resultData,
-                         const MatrixXd &data)
-{
-    if(resultData.rows() != data.rows() || resultData.cols() != data.cols()) {
-        resultData.resize(data.rows(), data.cols());
-        resultData.setZero();
+    for(int i = 0; i < matNormalized.rows(); ++i) {
+        if(vecNorms(i) > 0.0) {
+            matNormalized.row(i) /= vecNorms(i);
+        }
     }
 
-    resultData += data;
+    // Symmetric rank update (SYRK). Only the upper triangle of matDist is written.
+    matDist.selfadjointView<Upper>().rankUpdate(matNormalized);
 }
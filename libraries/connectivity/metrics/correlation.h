@@ -74,7 +74,9 @@ class Network;
 
 //=============================================================================================================
 /**
- * This class computes the correlation metric.
+ * This class computes the correlation metric. The weight of a pair is the Pearson correlation coefficient of the
+ * two rows, computed per trial and averaged over all trials. Earlier versions returned the averaged raw inner
+ * products XX^T of the rows instead, which were neither demeaned nor normalized.
  *
  * @brief This class computes the correlation metric.
  */
@@ -104,23 +106,13 @@ public:
 protected:
     //=========================================================================================================
     /**
-     * Calculates the connectivity matrix for a given input data matrix based on the correlation coefficient.
+     * Calculates the correlation coefficients of a given input data matrix and adds them to matDist.
      *
-     * @param[in] inputData      The input data.
-     *
-     * @return                   The connectivity matrix.
-     */
-    static Eigen::MatrixXd compute(const ConnectivitySettings::IntermediateTrialData& inputData);
-
-    //=========================================================================================================
-    /**
-     * Sums up (reduces) the in parallel processed connectivity matrix.
-     *
-     * @param[out] resultData    The result data.
-     * @param[in]  data          The incoming, temporary result data.
+     * @param[in]    inputData           The input data.
+     * @param[out]   matDist             The sum of all edge weights. Only the upper triangle is updated.
      */
-    static void reduce(Eigen::MatrixXd &resultData,
-                       const Eigen::MatrixXd &data);
+    static void compute(const ConnectivitySettings::IntermediateTrialData& inputData,
+                        Eigen::MatrixXd& matDist);
 };
 
 //=============================================================================================================
@@ -123,16 +123,38 @@ Network CrossCorrelation::calculate(ConnectivitySettings& connectivitySettings)
 
     QPair<MatrixXd, VectorXd> tapers = Spectral::generateTapers(iSignalLength, connectivitySettings.getWindowType());
 
-    // Compute the cross correlation in parallel
-    QMutex mutex;
-    MatrixXd matDist;
-
-    std::function<void(ConnectivitySettings::IntermediateTrialData&)> computeLambda = [&](ConnectivitySettings::IntermediateTrialData& inputData) {
-        compute(inputData,
-                matDist,
-                mutex,
-                iNfft,
-                tapers);
+    // Compute the cross correlation in parallel.
+    // Every block of trials is summed into its own accumulator so the threads never share a result matrix.
+    // Take the pointers in this thread, so that the trial list is detached only once.
+    QList<ConnectivitySettings::IntermediateTrialData>& lTrialData = connectivitySettings.getTrialData();
+    QVector<ConnectivitySettings::IntermediateTrialData*> vecTrialData;
+    vecTrialData.reserve(lTrialData.size());
+
+    for(int i = 0; i < lTrialData.size(); ++i) {
+        vecTrialData.append(&lTrialData[i]);
+    }
+
+    QVector<QPair<int,int> > vecBlocks = AbstractMetric::getTrialBlocks(vecTrialData.size());
+    QVector<MatrixXd> vecAccumulators(vecBlocks.size());
+    QVector<int> vecBlockIdx(vecBlocks.size());
+
+    for(int i = 0; i < vecBlockIdx.size(); ++i) {
+        vecBlockIdx[i] = i;
+        vecAccumulators[i] = MatrixXd::Zero(rows, rows);
+    }
+
+    std::function<void(int&)> computeLambda = [&](int& iBlock) {
+        // One FFT object per block, so the plans are reused for all trials of the block
+        FFT<double> fft;
+        fft.SetFlag(fft.HalfSpectrum);
+
+        for(int iTrial = vecBlocks.at(iBlock).first; iTrial < vecBlocks.at(iBlock).second; ++iTrial) {
+            compute(*vecTrialData.at(iTrial),
+                    vecAccumulators[iBlock],
+                    fft,
+                    iNfft,
+                    tapers);
+        }
     };
 
 //    iTime = timer.elapsed();
@@ -140,10 +162,16 @@ Network CrossCorrelation::calculate(ConnectivitySettings& connectivitySettings)
 //    timer.restart();
 
     // Calculate connectivity matrix over epochs and average afterwards
-    QFuture<void> resultMat = QtConcurrent::map(connectivitySettings.getTrialData(),
+    QFuture<void> resultMat = QtConcurrent::map(vecBlockIdx,
                                                 computeLambda);
     resultMat.waitForFinished();
 
+    MatrixXd matDist = MatrixXd::Zero(rows, rows);
+
+    for(int i = 0; i < vecAccumulators.size(); ++i) {
+        matDist += vecAccumulators.at(i);
+    }
+
     matDist /= connectivitySettings.size();
 
 //    iTime = timer.elapsed();
@@ -151,22 +179,21 @@ Network CrossCorrelation::calculate(ConnectivitySettings& connectivitySettings)
 //    timer.restart();
 
     //Add edges to network
+    finalNetwork.initPairWeights(1);
+
     MatrixXd matWeight(1,1);
-    QSharedPointer<NetworkEdge> pEdge;
     int j;
 
     for(int i = 0; i < matDist.rows(); ++i) {
         for(j = i; j < matDist.cols(); ++j) {
             matWeight << matDist(i,j);
 
-            pEdge = QSharedPointer<NetworkEdge>(new NetworkEdge(i, j, matWeight));
-
-            finalNetwork.getNodeAt(i)->append(pEdge);
-            finalNetwork.getNodeAt(j)->append(pEdge);
-            finalNetwork.append(pEdge);
+            finalNetwork.setPairWeight(i, j, matWeight);
         }
     }
 
+    finalNetwork.finishPairWeights();
+
 //    iTime = timer.elapsed();
 //    qWarning() << "Compute" << iTime;
 //    timer.restart();
@@ -178,7 +205,7 @@ Network CrossCorrelation::calculate(ConnectivitySettings& connectivitySettings)
 
 void CrossCorrelation::compute(ConnectivitySettings::IntermediateTrialData& inputData,
                                MatrixXd& matDist,
-                               QMutex& mutex,
+                               FFT<double>& fft,
                                int iNfft,
                                const QPair<MatrixXd, VectorXd>& tapers)
 {
@@ -190,16 +217,13 @@ void CrossCorrelation::compute(ConnectivitySettings::IntermediateTrialData& inpu
     RowVectorXd vecInputFFT, rowData;
     RowVectorXcd vecResultFreq;
 
-    FFT<double> fft;
-    fft.SetFlag(fft.HalfSpectrum);
-
     int i, j;
     int iNRows = inputData.matData.rows();
+    int iNFreqs = int(floor(iNfft / 2.0)) + 1;
 
     // Calculate tapered spectra if not available already
     // This code was copied and changed modified Utils/Spectra since we do not want to call the function due to time loss.
     if(inputData.vecTapSpectra.isEmpty()) {
-        int iNFreqs = int(floor(iNfft / 2.0)) + 1;
         MatrixXcd matTapSpectrum(tapers.first.rows(), iNFreqs);
 
         for (i = 0; i < iNRows; ++i) {
@@ -229,45 +253,41 @@ void CrossCorrelation::compute(ConnectivitySettings::IntermediateTrialData& inpu
 //    qDebug() << QThread::currentThreadId() << "CrossCorrelation::compute timer - Tapered spectra:" << iTime;
 //    timer.restart();
 
-    // Perform multiplication and transform back to time domain to find max XCOR coefficient
-    // Note that the result in time domain is mirrored around the center of the data (compared to Matlab)
-    MatrixXd matDistTrial = MatrixXd::Zero(iNRows, iNRows);
-    RowVectorXcd vecResultXCor;
-    int idx = 0;
-    double denom = tapers.second.sum();
+    // Average the tapered spectra of all channels once. Row major, so that every channel is contiguous in memory.
+    typedef Matrix<std::complex<double>, Dynamic, Dynamic, RowMajor> MatrixXcdRowMajor;
+    typedef Matrix<double, Dynamic, Dynamic, RowMajor> MatrixXdRowMajor;
 
-    for(i = 0; i < inputData.vecTapSpectra.size(); ++i) {
-        vecResultFreq = inputData.vecTapSpectra.at(i).colwise().sum() / denom;
+    double denom = tapers.second.sum();
+    MatrixXcdRowMajor matSpectra(iNRows, iNFreqs);
 
-        for(j = i; j < inputData.vecTapSpectra.size(); ++j) {
-            vecResultXCor = vecResultFreq.cwiseProduct(inputData.vecTapSpectra.at(j).colwise().sum() / denom);
+    for(i = 0; i < iNRows; ++i) {
+        matSpectra.row(i) = inputData.vecTapSpectra.at(i).colwise().sum() / denom;
+    }
 
-            fft.inv(vecInputFFT, vecResultXCor, iNfft);
+    // Perform multiplication and transform back to time domain to find max XCOR coefficient
+    // Note that the result in time domain is mirrored around the center of the data (compared to Matlab)
+    MatrixXcdRowMajor matProducts;
+    MatrixXdRowMajor matResultXCor;
+    int iNPairs;
 
-            vecInputFFT.maxCoeff(&idx);
+    for(i = 0; i < iNRows; ++i) {
+        iNPairs = iNRows - i;
 
-            matDistTrial(i,j) = vecInputFFT(idx);
-        }
-    }
+        // Products of channel i with all channels j >= i in one elementwise operation
+        matProducts = matSpectra.bottomRows(iNPairs).array().rowwise() * matSpectra.row(i).array();
 
-//    iTime = timer.elapsed();
-//    qDebug() << QThread::currentThreadId() << "CrossCorrelation::compute timer - Multiplication and inv FFT:" << iTime;
-//    timer.restart();
+        // Inverse transform of all products into one contiguous result matrix
+        matResultXCor.resize(iNPairs, iNfft);
 
-    // Sum up weights
-    mutex.lock();
+        for(j = 0; j < iNPairs; ++j) {
+            fft.inv(matResultXCor.row(j).data(), matProducts.row(j).data(), iNfft);
+        }
 
-    if(matDist.rows() != matDistTrial.rows() || matDist.cols() != matDistTrial.cols()) {
-        matDist.resize(matDistTrial.rows(), matDistTrial.cols());
-        matDist.setZero();
+        matDist.row(i).tail(iNPairs) += matResultXCor.rowwise().maxCoeff().transpose();
     }
 
-    matDist += matDistTrial;
-
-    mutex.unlock();
-
 //    iTime = timer.elapsed();
-//    qDebug() << QThread::currentThreadId() << "CrossCorrelation::compute timer - Summing up matDist:" << iTime;
+//    qDebug() << QThread::currentThreadId() << "CrossCorrelation::compute timer - Multiplication and inv FFT:" << iTime;
 //    timer.restart();
 
     if(!m_bStorageModeIsActive) {
@@ -49,13 +49,13 @@
 //=============================================================================================================
 
 #include <QSharedPointer>
-#include <QMutex>
 
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
 
 #include <Eigen/Core>
+#include <unsupported/Eigen/FFT>
 
 //=============================================================================================================
 // FORWARD DECLARATIONS
@@ -108,14 +108,14 @@ protected:
      * Calculates the connectivity matrix for a given input data matrix based on the cross correlation coefficient.
      *
      * @param[in]    inputData           The input data.
-     * @param[out]   matDist             The sum of all edge weights.
-     * @param[in]    mutex               The mutex used to safely access matDist.
+     * @param[out]   matDist             The sum of all edge weights. Only the upper triangle is updated.
+     * @param[in]    fft                 The FFT object of the calling thread.
      * @param[in]    iNfft               The FFT length.
      * @param[in]    tapers              The taper information.
      */
     static void compute(ConnectivitySettings::IntermediateTrialData& inputData,
                         Eigen::MatrixXd& matDist,
-                        QMutex& mutex,
+                        Eigen::FFT<double>& fft,
                         int iNfft,
                         const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
 };
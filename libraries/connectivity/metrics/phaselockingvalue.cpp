@@ -313,20 +313,21 @@ void PhaseLockingValue::computePLV(ConnectivitySettings &connectivitySettings,
     // Compute final PLV and create Network
     MatrixXd matNom;
     MatrixXd matWeight;
-    QSharedPointer<NetworkEdge> pEdge;
     int j;
 
     for (int i = 0; i < connectivitySettings.at(0).matData.rows(); ++i) {
         matNom = connectivitySettings.getIntermediateSumData().vecPairCsdNormalizedSum.at(i).second.cwiseAbs() / connectivitySettings.size();
 
+        if(i == 0) {
+            finalNetwork.initPairWeights(matNom.cols());
+        }
+
         for(j = i; j < connectivitySettings.at(0).matData.rows(); ++j) {
             matWeight = matNom.row(j).transpose();
 
-            pEdge = QSharedPointer<NetworkEdge>(new NetworkEdge(i, j, matWeight));
-
-            finalNetwork.getNodeAt(i)->append(pEdge);
-            finalNetwork.getNodeAt(j)->append(pEdge);
-            finalNetwork.append(pEdge);
+            finalNetwork.setPairWeight(i, j, matWeight);
         }
     }
+
+    finalNetwork.finishPairWeights();
 }
@@ -68,13 +68,191 @@ using namespace UTILSLIB;
 // DEFINE GLOBAL METHODS
 //=============================================================================================================
 
+namespace {
+
+inline bool testBit(const QVector<quint64>& vecMask, int iBit)
+{
+    return (vecMask.at(iBit >> 6) >> (iBit & 63)) & 1;
+}
+
+//=============================================================================================================
+
+inline void setBit(QVector<quint64>& vecMask, int iBit, bool bValue)
+{
+    if(bValue) {
+        vecMask[iBit >> 6] |= quint64(1) << (iBit & 63);
+    } else {
+        vecMask[iBit >> 6] &= ~(quint64(1) << (iBit & 63));
+    }
+}
+
+//=============================================================================================================
+
+inline int numberPairs(int iNumberNodes)
+{
+    return iNumberNodes * (iNumberNodes - 1) / 2;
+}
+
+//=============================================================================================================
+
+/**
+ * Averages the bins of a weight row the same way NetworkEdge::calculateAveragedWeight does. Returns false if the
+ * bin range does not apply and the current averaged weight should be kept.
+ */
+template<typename T>
+bool averageBins(const Eigen::DenseBase<T>& rowWeights,
+                 const QPair<int,int>& minMaxFreqBins,
+                 double& dAveragedWeight)
+{
+    const int iStartBin = minMaxFreqBins.first;
+    const int iEndBin = minMaxFreqBins.second;
+    const int iBins = rowWeights.cols();
+
+    if(iEndBin < iStartBin || iStartBin < -1 || iEndBin < -1 || iBins == 0) {
+        return false;
+    }
+
+    if(iStartBin == -1 && iEndBin == -1) {
+        dAveragedWeight = rowWeights.mean();
+    } else if(iStartBin < iBins) {
+        dAveragedWeight = rowWeights.segment(iStartBin, qMin(iEndBin, iBins - 1) - iStartBin + 1).mean();
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+/**
+ * Builds the CSR adjacency of all pairs set in vecMask. The row offsets are used as fill cursors, so no temporary
+ * buffers are needed and a rebuild with an unchanged number of nodes and edges does not allocate.
+ */
+void buildAdjacency(const QVector<quint64>& vecMask,
+                    int iNumberNodes,
+                    int iNumberPairs,
+                    NetworkAdjacency& adjacency)
+{
+    QVector<int>& vecRowPtr = adjacency.vecRowPtr;
+    vecRowPtr.fill(0, iNumberNodes + 1);
+    int p = 0;
+
+    for(int j = 1; j < iNumberNodes && p < iNumberPairs; ++j) {
+        for(int i = 0; i < j && p < iNumberPairs; ++i, ++p) {
+            if(testBit(vecMask, p)) {
+                ++vecRowPtr[i + 1];
+                ++vecRowPtr[j + 1];
+            }
+        }
+    }
+
+    for(int i = 0; i < iNumberNodes; ++i) {
+        vecRowPtr[i + 1] += vecRowPtr[i];
+    }
+
+    adjacency.vecNeighbors.resize(vecRowPtr[iNumberNodes]);
+    adjacency.vecPairs.resize(vecRowPtr[iNumberNodes]);
+    p = 0;
+
+    // vecRowPtr[i] walks to the start of row i + 1 while row i is filled
+    for(int j = 1; j < iNumberNodes && p < iNumberPairs; ++j) {
+        for(int i = 0; i < j && p < iNumberPairs; ++i, ++p) {
+            if(testBit(vecMask, p)) {
+                adjacency.vecNeighbors[vecRowPtr[i]] = j;
+                adjacency.vecPairs[vecRowPtr[i]++] = p;
+                adjacency.vecNeighbors[vecRowPtr[j]] = i;
+                adjacency.vecPairs[vecRowPtr[j]++] = p;
+            }
+        }
+    }
+
+    for(int i = iNumberNodes; i > 0; --i) {
+        vecRowPtr[i] = vecRowPtr[i - 1];
+    }
+    vecRowPtr[0] = 0;
+}
+
+//=============================================================================================================
+
+/**
+ * Adds the pair p of the nodes i < j to the CSR adjacency. The new entries are appended to the rows of i and j.
+ */
+void insertAdjacency(NetworkAdjacency& adjacency,
+                     int i,
+                     int j,
+                     int p)
+{
+    QVector<int>& vecRowPtr = adjacency.vecRowPtr;
+
+    // Insert into the later row first, so the insert position of row i is not shifted
+    adjacency.vecNeighbors.insert(vecRowPtr[j + 1], i);
+    adjacency.vecPairs.insert(vecRowPtr[j + 1], p);
+    adjacency.vecNeighbors.insert(vecRowPtr[i + 1], j);
+    adjacency.vecPairs.insert(vecRowPtr[i + 1], p);
+
+    for(int k = i + 1; k < vecRowPtr.size(); ++k) {
+        vecRowPtr[k] += (k > j) ? 2 : 1;
+    }
+}
+
+//=============================================================================================================
+
+/**
+ * Adds an empty row for a new node to the CSR adjacency.
+ */
+void appendAdjacencyRow(NetworkAdjacency& adjacency)
+{
+    if(adjacency.vecRowPtr.isEmpty()) {
+        adjacency.vecRowPtr.append(0);
+    }
+
+    adjacency.vecRowPtr.append(adjacency.vecRowPtr.last());
+}
+
+//=============================================================================================================
+
+/**
+ * Returns the minimum and maximum (in/out) degree of the nodes in the adjacency. Edges point from the lower to the
+ * higher node ID unless their pair is set in vecReversedMask.
+ */
+QPair<int,int> minMaxDegrees(const NetworkAdjacency& adjacency,
+                             const QVector<quint64>& vecReversedMask,
+                             bool bCountIn,
+                             bool bCountOut)
+{
+    int maxDegree = 0;
+    int minDegree = 1000000;
+
+    for(int i = 0; i < adjacency.vecRowPtr.size() - 1; ++i) {
+        int iDegree = 0;
+
+        for(int k = adjacency.vecRowPtr[i]; k < adjacency.vecRowPtr[i + 1]; ++k) {
+            bool bIsStart = (i < adjacency.vecNeighbors[k]) != testBit(vecReversedMask, adjacency.vecPairs[k]);
+
+            if((bIsStart && bCountOut) || (!bIsStart && bCountIn)) {
+                ++iDegree;
+            }
+        }
+
+        maxDegree = qMax(maxDegree, iDegree);
+        minDegree = qMin(minDegree, iDegree);
+    }
+
+    return QPair<int,int>(minDegree,maxDegree);
+}
+
+} // namespace
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
 
 Network::Network(const QString& sConnectivityMethod,
                  double dThreshold)
-: m_sConnectivityMethod(sConnectivityMethod)
+: m_pPairWeights(new NetworkPairWeights)
+, m_iMinMaxFreqBins(QPair<int,int>(-1,-1))
+, m_sConnectivityMethod(sConnectivityMethod)
 , m_minMaxFullWeights(QPair<double,double>(std::numeric_limits<double>::max(),0.0))
 , m_minMaxThresholdedWeights(QPair<double,double>(std::numeric_limits<double>::max(),0.0))
 , m_dThreshold(dThreshold)
@@ -95,20 +273,20 @@ MatrixXd Network::getFullConnectivityMatrix(bool bGetMirroredVersion) const
     MatrixXd matDist(m_lNodes.size(), m_lNodes.size());
     matDist.setZero();
 
-    for(int i = 0; i < m_lFullEdges.size(); ++i) {
-        int row = m_lFullEdges.at(i)->getStartNodeID();
-        int col = m_lFullEdges.at(i)->getEndNodeID();
+    const NetworkAdjacency& adjacency = m_fullAdjacency;
 
-        if(row < matDist.rows() && col < matDist.cols()) {
-            matDist(row,col) = m_lFullEdges.at(i)->getWeight();
+    for(int i = 0; i < adjacency.vecRowPtr.size() - 1; ++i) {
+        for(int k = adjacency.vecRowPtr[i]; k < adjacency.vecRowPtr[i + 1]; ++k) {
+            int j = adjacency.vecNeighbors[k];
+            int p = adjacency.vecPairs[k];
+            bool bIsStart = (i < j) != testBit(m_vecReversedMask, p);
 
-            if(bGetMirroredVersion) {
-                matDist(col,row) = m_lFullEdges.at(i)->getWeight();
+            if(bIsStart || bGetMirroredVersion) {
+                matDist(i,j) = m_vecPairWeights[p];
             }
         }
     }
 
-    //IOUtils::write_eigen_matrix(matDist,"eigen.txt");
     return matDist;
 }
 
@@ -119,75 +297,248 @@ MatrixXd Network::getThresholdedConnectivityMatrix(bool bGetMirroredVersion) con
     MatrixXd matDist(m_lNodes.size(), m_lNodes.size());
     matDist.setZero();
 
-    for(int i = 0; i < m_lThresholdedEdges.size(); ++i) {
-        int row = m_lThresholdedEdges.at(i)->getStartNodeID();
-        int col = m_lThresholdedEdges.at(i)->getEndNodeID();
+    const NetworkAdjacency& adjacency = m_thresholdedAdjacency;
 
-        if(row < matDist.rows() && col < matDist.cols()) {
-            matDist(row,col) = m_lThresholdedEdges.at(i)->getWeight();
+    for(int i = 0; i < adjacency.vecRowPtr.size() - 1; ++i) {
+        for(int k = adjacency.vecRowPtr[i]; k < adjacency.vecRowPtr[i + 1]; ++k) {
+            int j = adjacency.vecNeighbors[k];
+            int p = adjacency.vecPairs[k];
+            bool bIsStart = (i < j) != testBit(m_vecReversedMask, p);
 
-            if(bGetMirroredVersion) {
-                matDist(col,row) = m_lThresholdedEdges.at(i)->getWeight();
+            if(bIsStart || bGetMirroredVersion) {
+                matDist(i,j) = m_vecPairWeights[p];
             }
         }
     }
 
-    //IOUtils::write_eigen_matrix(matDist,"eigen.txt");
     return matDist;
 }
 
 //=============================================================================================================
 
-const QList<NetworkEdge::SPtr>& Network::getFullEdges() const
+QList<NetworkEdge::SPtr> Network::getFullEdges() const
 {
-    return m_lFullEdges;
+    QList<NetworkEdge::SPtr> lEdges;
+    lEdges.reserve(m_fullAdjacency.vecNeighbors.size() / 2);
+
+    const int iNumberPairs = m_vecPairWeights.size();
+    int p = 0;
+
+    for(int j = 1; j < m_lNodes.size() && p < iNumberPairs; ++j) {
+        for(int i = 0; i < j && p < iNumberPairs; ++i, ++p) {
+            if(testBit(m_vecConnectedMask, p)) {
+                lEdges << createEdge(p, i, j);
+            }
+        }
+    }
+
+    return lEdges;
 }
 
 //=============================================================================================================
 
-const QList<NetworkEdge::SPtr>& Network::getThresholdedEdges() const
+QList<NetworkEdge::SPtr> Network::getThresholdedEdges() const
 {
-    return m_lThresholdedEdges;
+    QList<NetworkEdge::SPtr> lEdges;
+    lEdges.reserve(m_thresholdedAdjacency.vecNeighbors.size() / 2);
+
+    const int iNumberPairs = m_vecPairWeights.size();
+    int p = 0;
+
+    for(int j = 1; j < m_lNodes.size() && p < iNumberPairs; ++j) {
+        for(int i = 0; i < j && p < iNumberPairs; ++i, ++p) {
+            if(testBit(m_vecActiveMask, p)) {
+                lEdges << createEdge(p, i, j);
+            }
+        }
+    }
+
+    return lEdges;
 }
 
 //=============================================================================================================
 
-const QList<NetworkNode::SPtr>& Network::getNodes() const
+QList<NetworkNode::SPtr> Network::getNodes() const
 {
-    return m_lNodes;
+    const int iNumberNodes = m_lNodes.size();
+    QVector<QList<NetworkEdge::SPtr> > lNodeEdges(iNumberNodes);
+
+    // Create every edge once and share it between its two nodes
+    for(const NetworkEdge::SPtr& pEdge : getFullEdges()) {
+        lNodeEdges[pEdge->getStartNodeID()] << pEdge;
+        lNodeEdges[pEdge->getEndNodeID()] << pEdge;
+    }
+
+    QList<NetworkNode::SPtr> lNodes;
+    lNodes.reserve(iNumberNodes);
+
+    for(int i = 0; i < iNumberNodes; ++i) {
+        NetworkNode::SPtr pNode = NetworkNode::SPtr(new NetworkNode(*m_lNodes.at(i)));
+        pNode->setEdges(lNodeEdges.at(i));
+        lNodes << pNode;
+    }
+
+    return lNodes;
 }
 
 //=============================================================================================================
 
-NetworkNode::SPtr Network::getNodeAt(int i)
+NetworkEdge::SPtr Network::getEdgeAt(int i) const
 {
-    return m_lNodes.at(i);
+    const int iNumberPairs = m_vecPairWeights.size();
+    int p = 0;
+
+    for(int j = 1; j < m_lNodes.size() && p < iNumberPairs; ++j) {
+        for(int k = 0; k < j && p < iNumberPairs; ++k, ++p) {
+            if(testBit(m_vecConnectedMask, p) && i-- == 0) {
+                return createEdge(p, k, j);
+            }
+        }
+    }
+
+    return NetworkEdge::SPtr();
 }
 
 //=============================================================================================================
 
-qint16 Network::getFullDistribution() const
+NetworkNode::SPtr Network::getNodeAt(int i) const
 {
-    qint16 distribution = 0;
+    QList<NetworkEdge::SPtr> lEdges;
 
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        distribution += m_lNodes.at(i)->getFullDegree();
+    for(int k = m_fullAdjacency.vecRowPtr.at(i); k < m_fullAdjacency.vecRowPtr.at(i + 1); ++k) {
+        const int j = m_fullAdjacency.vecNeighbors.at(k);
+        lEdges << createEdge(m_fullAdjacency.vecPairs.at(k), qMin(i, j), qMax(i, j));
     }
 
-    return distribution;
+    NetworkNode::SPtr pNode = NetworkNode::SPtr(new NetworkNode(*m_lNodes.at(i)));
+    pNode->setEdges(lEdges);
+
+    return pNode;
 }
 
 //=============================================================================================================
 
-qint16 Network::getThresholdedDistribution() const
+int Network::getNumberNodes() const
+{
+    return m_lNodes.size();
+}
+
+//=============================================================================================================
+
+const RowVectorXf& Network::getNodeVert(int iNodeId) const
+{
+    return m_lNodes.at(iNodeId)->getVert();
+}
+
+//=============================================================================================================
+
+qint16 Network::getFullDegree(int iNodeId) const
 {
-    qint16 distribution = 0;
+    return m_fullAdjacency.vecRowPtr.at(iNodeId + 1) - m_fullAdjacency.vecRowPtr.at(iNodeId);
+}
+
+//=============================================================================================================
 
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        distribution += m_lNodes.at(i)->getThresholdedDegree();
+qint16 Network::getThresholdedDegree(int iNodeId) const
+{
+    return m_thresholdedAdjacency.vecRowPtr.at(iNodeId + 1) - m_thresholdedAdjacency.vecRowPtr.at(iNodeId);
+}
+
+//=============================================================================================================
+
+const NetworkAdjacency& Network::getFullAdjacency() const
+{
+    return m_fullAdjacency;
+}
+
+//=============================================================================================================
+
+const NetworkAdjacency& Network::getThresholdedAdjacency() const
+{
+    return m_thresholdedAdjacency;
+}
+
+//=============================================================================================================
+
+const VectorXd& Network::getPairWeights() const
+{
+    return m_vecPairWeights;
+}
+
+//=============================================================================================================
+
+const MatrixXd& Network::getPairWeightMatrix() const
+{
+    return m_pPairWeights->matWeights;
+}
+
+//=============================================================================================================
+
+bool Network::isPairActive(int iPair) const
+{
+    return testBit(m_vecActiveMask, iPair);
+}
+
+//=============================================================================================================
+
+void Network::initPairWeights(int iNumberFreqBins)
+{
+    const int iNumberPairs = numberPairs(m_lNodes.size());
+
+    NetworkPairWeights* pPairWeights = new NetworkPairWeights;
+    pPairWeights->matWeights = MatrixXd::Zero(iNumberPairs, qMax(iNumberFreqBins, 1));
+    m_pPairWeights = pPairWeights;
+    m_vecPairWeights = VectorXd::Zero(iNumberPairs);
+
+    m_vecConnectedMask.fill(~quint64(0), (iNumberPairs + 63) / 64);
+    if(iNumberPairs % 64 != 0) {
+        m_vecConnectedMask.last() = (quint64(1) << (iNumberPairs % 64)) - 1;
     }
+    m_vecReversedMask.fill(0, m_vecConnectedMask.size());
+    m_vecActiveMask.fill(0, m_vecConnectedMask.size());
+}
 
-    return distribution;
+//=============================================================================================================
+
+void Network::setPairWeight(int i,
+                            int j,
+                            const VectorXd& vecWeight)
+{
+    if(i == j) {
+        return;
+    }
+
+    const int p = getPairIndex(i, j);
+    MatrixXd& matWeights = m_pPairWeights->matWeights;
+
+    if(p >= matWeights.rows() || vecWeight.size() != matWeights.cols()) {
+        qDebug() << "Network::setPairWeight - Pair or number of bins does not match the storage. Call initPairWeights first. Returning.";
+        return;
+    }
+
+    matWeights.row(p) = vecWeight.transpose();
+    averageBins(matWeights.row(p), m_iMinMaxFreqBins, m_vecPairWeights[p]);
+}
+
+//=============================================================================================================
+
+void Network::finishPairWeights()
+{
+    update();
+}
+
+//=============================================================================================================
+
+qint16 Network::getFullDistribution() const
+{
+    return m_fullAdjacency.vecNeighbors.size();
+}
+
+//=============================================================================================================
+
+qint16 Network::getThresholdedDistribution() const
+{
+    return m_thresholdedAdjacency.vecNeighbors.size();
 }
 
 //=============================================================================================================
@@ -222,108 +573,42 @@ QPair<double, double> Network::getMinMaxThresholdedWeights() const
 
 QPair<int,int> Network::getMinMaxFullDegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getFullDegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getFullDegree();
-        } else if (m_lNodes.at(i)->getFullDegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getFullDegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return minMaxDegrees(m_fullAdjacency, m_vecReversedMask, true, true);
 }
 
 //=============================================================================================================
 
 QPair<int,int> Network::getMinMaxThresholdedDegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getThresholdedDegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getThresholdedDegree();
-        } else if (m_lNodes.at(i)->getThresholdedDegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getThresholdedDegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return minMaxDegrees(m_thresholdedAdjacency, m_vecReversedMask, true, true);
 }
 
 //=============================================================================================================
 
 QPair<int,int> Network::getMinMaxFullIndegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getFullIndegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getFullIndegree();
-        } else if (m_lNodes.at(i)->getFullIndegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getFullIndegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return minMaxDegrees(m_fullAdjacency, m_vecReversedMask, true, false);
 }
 
 //=============================================================================================================
 
 QPair<int,int> Network::getMinMaxThresholdedIndegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getThresholdedIndegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getThresholdedIndegree();
-        } else if (m_lNodes.at(i)->getThresholdedIndegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getThresholdedIndegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return minMaxDegrees(m_thresholdedAdjacency, m_vecReversedMask, true, false);
 }
 
 //=============================================================================================================
 
 QPair<int,int> Network::getMinMaxFullOutdegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getFullOutdegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getFullOutdegree();
-        } else if (m_lNodes.at(i)->getFullOutdegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getFullOutdegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return minMaxDegrees(m_fullAdjacency, m_vecReversedMask, false, true);
 }
 
 //=============================================================================================================
 
 QPair<int,int> Network::getMinMaxThresholdedOutdegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getThresholdedOutdegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getThresholdedOutdegree();
-        } else if (m_lNodes.at(i)->getThresholdedOutdegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getThresholdedOutdegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return minMaxDegrees(m_thresholdedAdjacency, m_vecReversedMask, false, true);
 }
 
 //=============================================================================================================
@@ -331,19 +616,8 @@ QPair<int,int> Network::getMinMaxThresholdedOutdegrees() const
 void Network::setThreshold(double dThreshold)
 {
     m_dThreshold = dThreshold;
-    m_lThresholdedEdges.clear();
-
-    for(int i = 0; i < m_lFullEdges.size(); ++i) {
-        if(fabs(m_lFullEdges.at(i)->getWeight()) >= m_dThreshold) {
-            m_lFullEdges.at(i)->setActive(true);
-            m_lThresholdedEdges.append(m_lFullEdges.at(i));
-        } else {
-            m_lFullEdges.at(i)->setActive(false);
-        }
-    }
 
-    m_minMaxThresholdedWeights.first = m_dThreshold;
-    m_minMaxThresholdedWeights.second = m_minMaxFullWeights.second;
+    update();
 }
 
 //=============================================================================================================
@@ -382,21 +656,20 @@ void Network::setFrequencyRange(float fLowerFreq, float fUpperFreq)
     m_minMaxFrequency.first = fLowerFreq;
     m_minMaxFrequency.second = fUpperFreq;
 
-    int iLowerBin = fLowerFreq * dScaleFactor;
-    int iUpperBin = fUpperFreq * dScaleFactor;
-
-    // Update the min max values
-    m_minMaxFullWeights = QPair<double,double>(std::numeric_limits<double>::max(),0.0);
+    m_iMinMaxFreqBins.first = fLowerFreq * dScaleFactor;
+    m_iMinMaxFreqBins.second = fUpperFreq * dScaleFactor;
 
-    for(int i = 0; i < m_lFullEdges.size(); ++i) {
-        m_lFullEdges.at(i)->setFrequencyBins(QPair<int,int>(iLowerBin,iUpperBin));
+    // Average all pairs at once. Only read the shared weights so they are not detached from other copies.
+    const MatrixXd& matWeights = m_pPairWeights.constData()->matWeights;
+    const int iStartBin = m_iMinMaxFreqBins.first;
+    const int iBins = matWeights.cols();
 
-        if(fabs(m_lFullEdges.at(i)->getWeight()) < m_minMaxFullWeights.first) {
-            m_minMaxFullWeights.first = fabs(m_lFullEdges.at(i)->getWeight());
-        } else if(fabs(m_lFullEdges.at(i)->getWeight()) > m_minMaxFullWeights.second) {
-            m_minMaxFullWeights.second = fabs(m_lFullEdges.at(i)->getWeight());
-        }
+    if(m_iMinMaxFreqBins.second >= iStartBin && iStartBin >= 0 && iStartBin < iBins) {
+        const int iNumberBins = qMin(m_iMinMaxFreqBins.second, iBins - 1) - iStartBin + 1;
+        m_vecPairWeights = matWeights.middleCols(iStartBin, iNumberBins).rowwise().mean();
     }
+
+    update();
 }
 
 //=============================================================================================================
@@ -410,18 +683,50 @@ const QPair<float,float>& Network::getFrequencyRange() const
 
 void Network::append(NetworkEdge::SPtr newEdge)
 {
-    if(newEdge->getEndNodeID() != newEdge->getStartNodeID()) {
-        double dEdgeWeight = newEdge->getWeight();
-        if(dEdgeWeight < m_minMaxFullWeights.first) {
-            m_minMaxFullWeights.first = dEdgeWeight;
-        } else if(dEdgeWeight >= m_minMaxFullWeights.second) {
-            m_minMaxFullWeights.second = dEdgeWeight;
-        }
+    const int iStartID = newEdge->getStartNodeID();
+    const int iEndID = newEdge->getEndNodeID();
+
+    if(iStartID == iEndID) {
+        return;
+    }
+
+    MatrixXd matEdgeWeight = newEdge->getMatrixWeight();
+    reservePairs(qMax(m_lNodes.size(), qMax(iStartID, iEndID) + 1), matEdgeWeight.rows());
 
-        m_lFullEdges << newEdge;
+    const int p = getPairIndex(iStartID, iEndID);
+    MatrixXd& matWeights = m_pPairWeights->matWeights;
 
-        if(fabs(newEdge->getWeight()) >= m_dThreshold) {
-            m_lThresholdedEdges << newEdge;
+    matWeights.row(p).setZero();
+    matWeights.row(p).head(matEdgeWeight.rows()) = matEdgeWeight.rowwise().mean().transpose();
+    m_vecPairWeights[p] = newEdge->getWeight();
+
+    const bool bReplaced = testBit(m_vecConnectedMask, p);
+    setBit(m_vecConnectedMask, p, true);
+    setBit(m_vecReversedMask, p, iStartID > iEndID);
+
+    // A replaced weight can lower the min/max weights, which needs a full update
+    if(bReplaced) {
+        update();
+        return;
+    }
+
+    // A new pair only adds its own entries, so appending edges one by one stays linear in the number of pairs
+    const double dWeight = fabs(m_vecPairWeights[p]);
+    const bool bActive = dWeight >= m_dThreshold;
+
+    m_vecActiveMask.resize(m_vecConnectedMask.size());
+    setBit(m_vecActiveMask, p, bActive);
+
+    m_minMaxFullWeights.first = qMin(m_minMaxFullWeights.first, dWeight);
+    m_minMaxFullWeights.second = qMax(m_minMaxFullWeights.second, dWeight);
+    m_minMaxThresholdedWeights.first = m_dThreshold;
+    m_minMaxThresholdedWeights.second = m_minMaxFullWeights.second;
+
+    if(qMax(iStartID, iEndID) < m_lNodes.size()) {
+        insertAdjacency(m_fullAdjacency, qMin(iStartID, iEndID), qMax(iStartID, iEndID), p);
+
+        if(bActive) {
+            insertAdjacency(m_thresholdedAdjacency, qMin(iStartID, iEndID), qMax(iStartID, iEndID), p);
         }
     }
 }
@@ -431,17 +736,32 @@ void Network::append(NetworkEdge::SPtr newEdge)
 void Network::append(NetworkNode::SPtr newNode)
 {
     m_lNodes << newNode;
+
+    // Unless edges to this node were appended before the node itself, it only adds empty adjacency rows
+    if(m_vecPairWeights.size() > numberPairs(m_lNodes.size() - 1)) {
+        update();
+        return;
+    }
+
+    appendAdjacencyRow(m_fullAdjacency);
+    appendAdjacencyRow(m_thresholdedAdjacency);
 }
 
 //=============================================================================================================
 
 bool Network::isEmpty() const
 {
-    if(m_lFullEdges.isEmpty() || m_lNodes.isEmpty()) {
+    if(m_lNodes.isEmpty()) {
         return true;
     }
 
-    return false;
+    for(int i = 0; i < m_vecConnectedMask.size(); ++i) {
+        if(m_vecConnectedMask.at(i) != 0) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 //=============================================================================================================
@@ -454,15 +774,9 @@ void Network::normalize()
         return;
     }
 
-    for(int i = 0; i < m_lFullEdges.size(); ++i) {
-        m_lFullEdges.at(i)->setWeight(m_lFullEdges.at(i)->getWeight()/m_minMaxFullWeights.second);
-    }
-
-    m_minMaxFullWeights.first = m_minMaxFullWeights.first/m_minMaxFullWeights.second;
-    m_minMaxFullWeights.second = 1.0;
+    m_vecPairWeights /= m_minMaxFullWeights.second;
 
-    m_minMaxThresholdedWeights.first = m_minMaxThresholdedWeights.first/m_minMaxThresholdedWeights.second;
-    m_minMaxThresholdedWeights.second = 1.0;
+    update();
 }
 
 //=============================================================================================================
@@ -521,3 +835,89 @@ int Network::getFFTSize()
     return m_iFFTSize;
 }
 
+//=============================================================================================================
+
+void Network::reservePairs(int iNumberNodes,
+                           int iNumberFreqBins)
+{
+    const int iNumberPairs = qMax(numberPairs(iNumberNodes), int(m_vecPairWeights.size()));
+    const MatrixXd& matCurrent = m_pPairWeights.constData()->matWeights;
+    const int iBins = qMax(iNumberFreqBins, int(matCurrent.cols()));
+
+    if(iNumberPairs == matCurrent.rows() && iBins == matCurrent.cols()) {
+        return;
+    }
+
+    // Allocate a new block instead of detaching, so the current weights are copied only once
+    NetworkPairWeights* pPairWeights = new NetworkPairWeights;
+    pPairWeights->matWeights = MatrixXd::Zero(iNumberPairs, iBins);
+    pPairWeights->matWeights.topLeftCorner(matCurrent.rows(), matCurrent.cols()) = matCurrent;
+    m_pPairWeights = pPairWeights;
+
+    const int iOldPairs = m_vecPairWeights.size();
+    m_vecPairWeights.conservativeResize(iNumberPairs);
+    m_vecPairWeights.tail(iNumberPairs - iOldPairs).setZero();
+
+    m_vecConnectedMask.resize((iNumberPairs + 63) / 64);
+    m_vecReversedMask.resize(m_vecConnectedMask.size());
+}
+
+//=============================================================================================================
+
+void Network::update()
+{
+    const int iNumberPairs = m_vecPairWeights.size();
+
+    // Threshold 64 pairs per mask word
+    m_vecActiveMask.fill(0, m_vecConnectedMask.size());
+    m_minMaxFullWeights = QPair<double,double>(std::numeric_limits<double>::max(),0.0);
+
+    for(int w = 0; w < m_vecConnectedMask.size(); ++w) {
+        const quint64 iConnected = m_vecConnectedMask.at(w);
+
+        if(iConnected == 0) {
+            continue;
+        }
+
+        const int iFirst = w * 64;
+        const int iLast = qMin(iFirst + 64, iNumberPairs);
+        quint64 iActive = 0;
+
+        for(int p = iFirst; p < iLast; ++p) {
+            const double dWeight = fabs(m_vecPairWeights[p]);
+            iActive |= quint64(dWeight >= m_dThreshold) << (p - iFirst);
+
+            if((iConnected >> (p - iFirst)) & 1) {
+                m_minMaxFullWeights.first = qMin(m_minMaxFullWeights.first, dWeight);
+                m_minMaxFullWeights.second = qMax(m_minMaxFullWeights.second, dWeight);
+            }
+        }
+
+        m_vecActiveMask[w] = iActive & iConnected;
+    }
+
+    m_minMaxThresholdedWeights.first = m_dThreshold;
+    m_minMaxThresholdedWeights.second = m_minMaxFullWeights.second;
+
+    buildAdjacency(m_vecConnectedMask, m_lNodes.size(), iNumberPairs, m_fullAdjacency);
+    buildAdjacency(m_vecActiveMask, m_lNodes.size(), iNumberPairs, m_thresholdedAdjacency);
+}
+
+//=============================================================================================================
+
+NetworkEdge::SPtr Network::createEdge(int iPair,
+                                     int i,
+                                     int j) const
+{
+    const bool bReversed = testBit(m_vecReversedMask, iPair);
+
+    NetworkEdge::SPtr pEdge = NetworkEdge::SPtr(new NetworkEdge(bReversed ? j : i,
+                                                                bReversed ? i : j,
+                                                                m_pPairWeights.constData()->matWeights.row(iPair).transpose(),
+                                                                testBit(m_vecActiveMask, iPair),
+                                                                m_iMinMaxFreqBins.first,
+                                                                m_iMinMaxFreqBins.second));
+    pEdge->setWeight(m_vecPairWeights[iPair]);
+
+    return pEdge;
+}
@@ -46,6 +46,9 @@
 //=============================================================================================================
 
 #include <QSharedPointer>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include <QVector>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -77,10 +80,39 @@ struct VisualizationInfo {
     Eigen::Vector4i colEdges = Eigen::Vector4i(255, 0, 0, 255); /**< The edge color.*/
 };
 
+//=============================================================================================================
+/**
+ * Compressed sparse row (CSR) adjacency of a network. The neighbours of node i are stored in
+ * vecNeighbors[vecRowPtr[i]] to vecNeighbors[vecRowPtr[i+1]-1]. Each undirected edge is listed for both of its nodes.
+ */
+struct NetworkAdjacency {
+    QVector<int> vecRowPtr;       /**< Offsets into vecNeighbors, one entry per node plus a trailing end offset.*/
+    QVector<int> vecNeighbors;    /**< The IDs of the neighbouring nodes.*/
+    QVector<int> vecPairs;        /**< The packed pair index of each neighbour entry, see Network::getPairIndex.*/
+};
+
+//=============================================================================================================
+/**
+ * The per frequency bin weights of all node pairs (rows: packed pairs, cols: frequency bins). Implicitly shared
+ * between Network copies, so that passing networks through queued signals does not copy the weight tensor.
+ */
+class NetworkPairWeights : public QSharedData
+{
+public:
+    Eigen::MatrixXd matWeights;   /**< The weights, one row per packed pair.*/
+};
+
 //=============================================================================================================
 /**
  * This class holds information (nodes and connecting edges) about a network, can compute a distance table and provide network metrics.
  *
+ * The edge weights are stored as a packed upper triangle (one row per node pair i < j, one column per frequency bin).
+ * Thresholding produces a bitmask over the pairs and the resulting graph is kept in CSR form, so degree and adjacency
+ * queries do not touch any per edge objects. The mutators only update the packed weights, the bitmasks and the CSR
+ * adjacency, so const getters only read and a Network can be read from several threads. The NetworkEdge and
+ * NetworkNode objects returned by the edge and node getters are created on each call from the packed storage and
+ * are not kept by the network. Changes made to them are not written back.
+ *
  * @brief This class holds information about a network, can compute a distance table and provide network metrics.
  */
 
@@ -127,27 +159,27 @@ public:
 
     //=========================================================================================================
     /**
-     * Returns the full and non thresholded edges.
+     * Returns the full and non thresholded edges. The edges are created from the packed weights on each call.
      *
      * @return Returns the network edges.
      */
-    const QList<QSharedPointer<NetworkEdge> >& getFullEdges() const;
+    QList<QSharedPointer<NetworkEdge> > getFullEdges() const;
 
     //=========================================================================================================
     /**
-     * Returns the thresholded edges.
+     * Returns the thresholded edges. The edges are created from the packed weights on each call.
      *
      * @return Returns the network edges.
      */
-    const QList<QSharedPointer<NetworkEdge> >& getThresholdedEdges() const;
+    QList<QSharedPointer<NetworkEdge> > getThresholdedEdges() const;
 
     //=========================================================================================================
     /**
-     * Returns the nodes.
+     * Returns the nodes together with their edges. The nodes and edges are created on each call.
      *
      * @return Returns the network nodes.
      */
-    const QList<QSharedPointer<NetworkNode> >& getNodes() const;
+    QList<QSharedPointer<NetworkNode> > getNodes() const;
 
     //=========================================================================================================
     /**
@@ -157,17 +189,139 @@ public:
      *
      * @return Returns the network edge.
      */
-    QSharedPointer<NetworkEdge> getEdgeAt(int i);
+    QSharedPointer<NetworkEdge> getEdgeAt(int i) const;
 
     //=========================================================================================================
     /**
-     * Returns the node at a specific position.
+     * Returns the node at a specific position together with its edges. The node is created on each call.
      *
      * @param[in] i      The index to look up the node. i must be a valid index position in the network list (i.e., 0 <= i < size()).
      *
      * @return Returns the network node.
      */
-    QSharedPointer<NetworkNode> getNodeAt(int i);
+    QSharedPointer<NetworkNode> getNodeAt(int i) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of nodes.
+     *
+     * @return The number of nodes.
+     */
+    int getNumberNodes() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the 3D position of a node without creating the edge view.
+     *
+     * @param[in] iNodeId    The node ID. Must be a valid node index.
+     *
+     * @return The 3D position of the node.
+     */
+    const Eigen::RowVectorXf& getNodeVert(int iNodeId) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the degree of a node in the full network.
+     *
+     * @param[in] iNodeId    The node ID.
+     *
+     * @return The number of edges connected to the node.
+     */
+    qint16 getFullDegree(int iNodeId) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the degree of a node in the thresholded network.
+     *
+     * @param[in] iNodeId    The node ID.
+     *
+     * @return The number of active edges connected to the node.
+     */
+    qint16 getThresholdedDegree(int iNodeId) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the CSR adjacency of the full network.
+     *
+     * @return The full adjacency.
+     */
+    const NetworkAdjacency& getFullAdjacency() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the CSR adjacency of the thresholded network.
+     *
+     * @return The thresholded adjacency.
+     */
+    const NetworkAdjacency& getThresholdedAdjacency() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the averaged weight of every packed pair for the current frequency range.
+     *
+     * @return The averaged pair weights.
+     */
+    const Eigen::VectorXd& getPairWeights() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the per frequency bin weights of every packed pair (rows: pairs, cols: bins).
+     *
+     * @return The pair weight matrix.
+     */
+    const Eigen::MatrixXd& getPairWeightMatrix() const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether the packed pair passes the current threshold.
+     *
+     * @param[in] iPair      The packed pair index.
+     *
+     * @return Whether the pair is part of the thresholded network.
+     */
+    bool isPairActive(int iPair) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the packed index of the node pair (i,j). The layout does not depend on the number of nodes, so that
+     * nodes can be added later on.
+     *
+     * @param[in] i      The first node ID.
+     * @param[in] j      The second node ID. Must be different from i.
+     *
+     * @return The packed pair index.
+     */
+    static inline int getPairIndex(int i, int j);
+
+    //=========================================================================================================
+    /**
+     * Allocates zero weights for all pairs of the current nodes and marks every pair as connected (full graph).
+     * Call this after all nodes were appended and before setPairWeight. The edge view, degrees and adjacencies
+     * keep describing the previous weights until finishPairWeights is called.
+     *
+     * @param[in] iNumberFreqBins    The number of frequency bins per pair.
+     */
+    void initPairWeights(int iNumberFreqBins);
+
+    //=========================================================================================================
+    /**
+     * Sets the per frequency bin weights of the undirected node pair (i,j). Pairs with i == j are ignored. After
+     * initPairWeights this may be called concurrently for different pairs.
+     *
+     * @param[in] i              The first node ID.
+     * @param[in] j              The second node ID.
+     * @param[in] vecWeight      The weights, one per frequency bin.
+     */
+    void setPairWeight(int i,
+                       int j,
+                       const Eigen::VectorXd& vecWeight);
+
+    //=========================================================================================================
+    /**
+     * Thresholds the weights set with setPairWeight and builds the adjacencies and the edge view. Call this once
+     * after all pairs were set.
+     */
+    void finishPairWeights();
 
     //=========================================================================================================
     /**
@@ -393,10 +547,48 @@ public:
     int getFFTSize();
 
 protected:
-    QList<QSharedPointer<NetworkEdge> >     m_lFullEdges;               /**< List with all edges of the network.*/
-    QList<QSharedPointer<NetworkEdge> >     m_lThresholdedEdges;        /**< List with all the active (thresholded) edges of the network.*/
+    //=========================================================================================================
+    /**
+     * Grows the packed storage so that it can hold all pairs of iNumberNodes nodes with iNumberFreqBins bins.
+     *
+     * @param[in] iNumberNodes       The number of nodes.
+     * @param[in] iNumberFreqBins    The number of frequency bins.
+     */
+    void reservePairs(int iNumberNodes,
+                      int iNumberFreqBins);
 
-    QList<QSharedPointer<NetworkNode> >     m_lNodes;                   /**< List with all nodes of the network.*/
+    //=========================================================================================================
+    /**
+     * Rebuilds the threshold mask, the CSR adjacencies and the min/max weights after a change.
+     * All non-const methods which change the network call this, so the const getters only read.
+     */
+    void update();
+
+    //=========================================================================================================
+    /**
+     * Creates the NetworkEdge object of a connected pair from the packed weights.
+     *
+     * @param[in] iPair      The packed pair index.
+     * @param[in] i          The lower node ID of the pair.
+     * @param[in] j          The higher node ID of the pair.
+     *
+     * @return The new edge.
+     */
+    QSharedPointer<NetworkEdge> createEdge(int iPair,
+                                           int i,
+                                           int j) const;
+
+    QSharedDataPointer<NetworkPairWeights>  m_pPairWeights;             /**< The per frequency bin weights of all packed pairs.*/
+    Eigen::VectorXd                         m_vecPairWeights;           /**< The averaged weight of all packed pairs.*/
+    QVector<quint64>                        m_vecConnectedMask;         /**< Bitmask of the packed pairs which are connected by an edge.*/
+    QVector<quint64>                        m_vecReversedMask;          /**< Bitmask of the packed pairs whose edge points from the higher to the lower node ID.*/
+    QPair<int,int>                          m_iMinMaxFreqBins;          /**< The lower/upper bin indices to average from/to. (-1,-1) averages over all bins.*/
+
+    QVector<quint64>                        m_vecActiveMask;            /**< Bitmask of the packed pairs which pass the threshold.*/
+    NetworkAdjacency                        m_fullAdjacency;            /**< The CSR adjacency of the full network.*/
+    NetworkAdjacency                        m_thresholdedAdjacency;     /**< The CSR adjacency of the thresholded network.*/
+
+    QList<QSharedPointer<NetworkNode> >     m_lNodes;                   /**< List with all nodes of the network. Edges are never assigned to these.*/
 
     Eigen::MatrixXd                         m_matDistMatrix;            /**< The distance matrix.*/
 
@@ -417,6 +609,16 @@ protected:
 //=============================================================================================================
 // INLINE DEFINITIONS
 //=============================================================================================================
+
+inline int Network::getPairIndex(int i, int j)
+{
+    if(i > j) {
+        qSwap(i, j);
+    }
+
+    return j * (j - 1) / 2 + i;
+}
+
 } // namespace CONNECTIVITYLIB
 
 #ifndef metatype_networks
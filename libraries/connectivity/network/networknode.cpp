@@ -359,3 +359,10 @@ void NetworkNode::append(QSharedPointer<NetworkEdge> newEdge)
     }
 }
 
+//=============================================================================================================
+
+void NetworkNode::setEdges(const QList<QSharedPointer<NetworkEdge> >& lEdges)
+{
+    m_lEdges = lEdges;
+}
+
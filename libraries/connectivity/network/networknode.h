@@ -278,6 +278,14 @@ public:
      */
     void append(QSharedPointer<NetworkEdge> newEdge);
 
+    //=========================================================================================================
+    /**
+     * Replaces all edges of this network node. Used by Network to assign its edge view to the nodes.
+     *
+     * @param[in] lEdges     The new edges.
+     */
+    void setEdges(const QList<QSharedPointer<NetworkEdge> >& lEdges);
+
 protected:
     bool                                    m_bIsHub;       /**< Whether this node is a hub.*/
 
@@ -64,8 +64,8 @@ ColorMap::~ColorMap()
 
 double ColorMap::linearSlope(double x, double m, double n)
 {
-    //f = m*x + n
-    return m*x + n;
+    //f = m*x + n, clamped to [0,1] so that rounding at the fuzzy set borders cannot wrap around in qRgb
+    return qBound(0.0, m*x + n, 1.0);
 }
 
 //=============================================================================================================
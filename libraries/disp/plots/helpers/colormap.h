@@ -457,7 +457,7 @@ public:
 protected:
     //=========================================================================================================
     /**
-     * Describes a linear function (y = mx + n) and returns the output value y
+     * Describes a linear function (y = mx + n) and returns the output value y, clamped to [0,1]
      *
      * @param[in] x  input value
      * @param[in] m  slope
@@ -44,6 +44,7 @@
 
 #include "helpers/evokedsetmodel.h"
 #include "helpers/channelinfomodel.h"
+#include "helpers/minmaxpyramid.h"
 
 //=============================================================================================================
 // QT INCLUDES
@@ -568,6 +569,29 @@ void ButterflyView::createPlotPath(qint32 row, QPainter& painter) const
                 path.moveTo(qSamplePosition);
             }
 
+            int iNumberPixels = this->width()-2;
+
+            if(iNumberPixels > 0 && rowVec.at(j).second.cols() >= 2*iNumberPixels) {
+                //More than one sample per pixel -> create the min/max envelope per pixel, which keeps spikes visible
+                Eigen::RowVectorXd vecMin, vecMax;
+                MinMaxPyramid::computeEnvelope(rowVec.at(j).second.data(), rowVec.at(j).second.cols(), iNumberPixels, vecMin, vecMax);
+
+                for(int p = 0; p < vecMin.cols(); ++p) {
+                    float fValueMin = vecMin(p)*fScaleY;
+                    float fValueMax = vecMax(p)*fScaleY;
+
+                    //Cut plotting if out of widget area
+                    fValueMin = fValueMin > fWinMaxVal ? fWinMaxVal : fValueMin < -fWinMaxVal ? -fWinMaxVal : fValueMin;
+                    fValueMax = fValueMax > fWinMaxVal ? fWinMaxVal : fValueMax < -fWinMaxVal ? -fWinMaxVal : fValueMax;
+
+                    path.lineTo(QPointF(p+2, -(y_base+fValueMin)));
+                    path.lineTo(QPointF(p+2, -(y_base+fValueMax)));
+                }
+
+                painter.drawPath(path);
+                continue;
+            }
+
             //create lines from one to the next sample
             qint32 i;
             for(i = 1; i < rowVec.at(j).second.cols() && path.elementCount() <= this->width(); i += dsFactor) {
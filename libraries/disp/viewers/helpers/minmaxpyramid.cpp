@@ -0,0 +1,261 @@
+//=============================================================================================================
+/**
+ * @file     minmaxpyramid.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the MinMaxPyramid Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "minmaxpyramid.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtGlobal>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace DISPLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+MinMaxPyramid::MinMaxPyramid(int iBinFactor)
+: m_iBinFactor(qMax(2, iBinFactor))
+, m_iNumberRows(0)
+, m_iNumberSamples(0)
+{
+}
+
+//=============================================================================================================
+
+void MinMaxPyramid::resize(int iNumberRows,
+                           int iNumberSamples)
+{
+    m_iNumberRows = qMax(0, iNumberRows);
+    m_iNumberSamples = qMax(0, iNumberSamples);
+
+    m_vecBinSizes.clear();
+    m_vecMinLevels.clear();
+    m_vecMaxLevels.clear();
+
+    // Add levels as long as they contain at least two bins
+    for(int iBinSize = m_iBinFactor; 2 * iBinSize <= m_iNumberSamples; iBinSize *= m_iBinFactor) {
+        int iNumberBins = (m_iNumberSamples + iBinSize - 1) / iBinSize;
+
+        m_vecBinSizes.append(iBinSize);
+        m_vecMinLevels.append(MatrixXdR::Zero(m_iNumberRows, iNumberBins));
+        m_vecMaxLevels.append(MatrixXdR::Zero(m_iNumberRows, iNumberBins));
+    }
+}
+
+//=============================================================================================================
+
+void MinMaxPyramid::update(const MatrixXdR& matData,
+                           int iFirstSample,
+                           int iNumberSamples)
+{
+    if(matData.rows() != m_iNumberRows || matData.cols() != m_iNumberSamples) {
+        resize(matData.rows(), matData.cols());
+        iFirstSample = 0;
+        iNumberSamples = -1;
+    }
+
+    if(m_vecBinSizes.isEmpty()) {
+        return;
+    }
+
+    if(iNumberSamples < 0) {
+        iFirstSample = qBound(0, iFirstSample, m_iNumberSamples);
+        iNumberSamples = m_iNumberSamples - iFirstSample;
+    }
+
+    if(iNumberSamples >= m_iNumberSamples) {
+        updateRange(matData, 0, m_iNumberSamples);
+        return;
+    }
+
+    // The data is a ring buffer, a range which starts before the first or ends behind the last sample continues
+    // at the other end of the matrix
+    iFirstSample = ((iFirstSample % m_iNumberSamples) + m_iNumberSamples) % m_iNumberSamples;
+    int iLastSample = iFirstSample + iNumberSamples;
+
+    if(iLastSample > m_iNumberSamples) {
+        updateRange(matData, iFirstSample, m_iNumberSamples);
+        updateRange(matData, 0, iLastSample - m_iNumberSamples);
+    } else {
+        updateRange(matData, iFirstSample, iLastSample);
+    }
+}
+
+//=============================================================================================================
+
+void MinMaxPyramid::updateRange(const MatrixXdR& matData,
+                                int iFirstSample,
+                                int iLastSample)
+{
+    if(iLastSample <= iFirstSample) {
+        return;
+    }
+
+    int r, iBin, iStart, iCount;
+
+    // The first level is computed from the samples
+    int iBinSize = m_vecBinSizes.at(0);
+    int iFirstBin = iFirstSample / iBinSize;
+    int iLastBin = (iLastSample - 1) / iBinSize + 1;
+
+    for(r = 0; r < m_iNumberRows; ++r) {
+        for(iBin = iFirstBin; iBin < iLastBin; ++iBin) {
+            iStart = iBin * iBinSize;
+            iCount = qMin(iBinSize, m_iNumberSamples - iStart);
+
+            m_vecMinLevels[0](r, iBin) = matData.row(r).segment(iStart, iCount).minCoeff();
+            m_vecMaxLevels[0](r, iBin) = matData.row(r).segment(iStart, iCount).maxCoeff();
+        }
+    }
+
+    // Every other level combines m_iBinFactor bins of the level below
+    for(int iLevel = 1; iLevel < m_vecBinSizes.size(); ++iLevel) {
+        int iNumberChildren = m_vecMinLevels.at(iLevel - 1).cols();
+        iFirstBin = iFirstBin / m_iBinFactor;
+        iLastBin = (iLastBin - 1) / m_iBinFactor + 1;
+
+        for(r = 0; r < m_iNumberRows; ++r) {
+            for(iBin = iFirstBin; iBin < iLastBin; ++iBin) {
+                iStart = iBin * m_iBinFactor;
+                iCount = qMin(m_iBinFactor, iNumberChildren - iStart);
+
+                m_vecMinLevels[iLevel](r, iBin) = m_vecMinLevels.at(iLevel - 1).row(r).segment(iStart, iCount).minCoeff();
+                m_vecMaxLevels[iLevel](r, iBin) = m_vecMaxLevels.at(iLevel - 1).row(r).segment(iStart, iCount).maxCoeff();
+            }
+        }
+    }
+}
+
+//=============================================================================================================
+
+void MinMaxPyramid::getEnvelope(const double* pData,
+                                int iRow,
+                                int iFirstSample,
+                                int iNumberSamples,
+                                int iNumberPixels,
+                                RowVectorXd& vecMin,
+                                RowVectorXd& vecMax) const
+{
+    if(iNumberPixels <= 0 || iNumberSamples <= 0) {
+        vecMin.resize(0);
+        vecMax.resize(0);
+        return;
+    }
+
+    double dSamplesPerPixel = double(iNumberSamples) / iNumberPixels;
+
+    // Pick the coarsest level whose bins still fit into one pixel
+    int iLevel = -1;
+
+    while(iLevel + 1 < m_vecBinSizes.size() && m_vecBinSizes.at(iLevel + 1) <= dSamplesPerPixel) {
+        ++iLevel;
+    }
+
+    if(iLevel < 0 || iRow < 0 || iRow >= m_iNumberRows || iFirstSample < 0 || iFirstSample + iNumberSamples > m_iNumberSamples) {
+        computeEnvelope(pData + iFirstSample, iNumberSamples, iNumberPixels, vecMin, vecMax);
+        return;
+    }
+
+    int iBinSize = m_vecBinSizes.at(iLevel);
+    int iNumberBins = m_vecMinLevels.at(iLevel).cols();
+    const MatrixXdR& matMin = m_vecMinLevels.at(iLevel);
+    const MatrixXdR& matMax = m_vecMaxLevels.at(iLevel);
+
+    vecMin.resize(iNumberPixels);
+    vecMax.resize(iNumberPixels);
+
+    // Every bin is assigned to the pixel its first sample falls into
+    int iFirstBin = iFirstSample / iBinSize;
+    int iLastBin;
+
+    for(int p = 0; p < iNumberPixels; ++p) {
+        iLastBin = p == iNumberPixels - 1
+                   ? (iFirstSample + iNumberSamples - 1) / iBinSize + 1
+                   : (iFirstSample + int((p + 1) * dSamplesPerPixel)) / iBinSize;
+
+        iFirstBin = qMin(iFirstBin, iNumberBins - 1);
+        iLastBin = qBound(iFirstBin + 1, iLastBin, iNumberBins);
+
+        vecMin(p) = matMin.row(iRow).segment(iFirstBin, iLastBin - iFirstBin).minCoeff();
+        vecMax(p) = matMax.row(iRow).segment(iFirstBin, iLastBin - iFirstBin).maxCoeff();
+
+        iFirstBin = iLastBin;
+    }
+}
+
+//=============================================================================================================
+
+void MinMaxPyramid::computeEnvelope(const double* pData,
+                                    int iNumberSamples,
+                                    int iNumberPixels,
+                                    RowVectorXd& vecMin,
+                                    RowVectorXd& vecMax)
+{
+    if(iNumberPixels <= 0 || iNumberSamples <= 0) {
+        vecMin.resize(0);
+        vecMax.resize(0);
+        return;
+    }
+
+    Map<const RowVectorXd> vecData(pData, iNumberSamples);
+    double dSamplesPerPixel = double(iNumberSamples) / iNumberPixels;
+    int iStart, iEnd;
+
+    vecMin.resize(iNumberPixels);
+    vecMax.resize(iNumberPixels);
+
+    for(int p = 0; p < iNumberPixels; ++p) {
+        iStart = qMin(int(p * dSamplesPerPixel), iNumberSamples - 1);
+        iEnd = p == iNumberPixels - 1 ? iNumberSamples : int((p + 1) * dSamplesPerPixel);
+        iEnd = qBound(iStart + 1, iEnd, iNumberSamples);
+
+        vecMin(p) = vecData.segment(iStart, iEnd - iStart).minCoeff();
+        vecMax(p) = vecData.segment(iStart, iEnd - iStart).maxCoeff();
+    }
+}
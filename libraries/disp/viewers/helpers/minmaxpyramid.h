@@ -0,0 +1,203 @@
+//=============================================================================================================
+/**
+ * @file     minmaxpyramid.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the MinMaxPyramid Class.
+ *
+ */
+
+#ifndef MINMAXPYRAMID_H
+#define MINMAXPYRAMID_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../../disp_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QVector>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+//=============================================================================================================
+// DEFINE NAMESPACE DISPLIB
+//=============================================================================================================
+
+namespace DISPLIB
+{
+
+//=============================================================================================================
+// DISPLIB FORWARD DECLARATIONS
+//=============================================================================================================
+
+//=============================================================================================================
+// DEFINE TYPEDEFS
+//=============================================================================================================
+
+typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> MatrixXdR;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS MinMaxPyramid
+ *
+ * @brief The MinMaxPyramid class holds multi-resolution min/max decimations of a row major data matrix. Level l
+ *        stores the minimum and maximum of bins of iBinFactor^(l+1) samples per row. The pyramid is updated for
+ *        the written sample ranges only and is used to draw traces as per pixel min/max envelopes, so that the
+ *        painting cost scales with the widget width instead of the number of samples while spikes are preserved.
+ */
+class DISPSHARED_EXPORT MinMaxPyramid
+{
+
+public:
+    typedef QSharedPointer<MinMaxPyramid> SPtr;              /**< Shared pointer type for MinMaxPyramid. */
+    typedef QSharedPointer<const MinMaxPyramid> ConstSPtr;   /**< Const shared pointer type for MinMaxPyramid. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a MinMaxPyramid object.
+     *
+     * @param[in] iBinFactor     The number of bins of one level which are combined to one bin of the next level.
+     */
+    explicit MinMaxPyramid(int iBinFactor = 4);
+
+    //=========================================================================================================
+    /**
+     * Resizes the pyramid to the dimensions of the data matrix. The content has to be updated afterwards.
+     *
+     * @param[in] iNumberRows        The number of rows (channels) of the data matrix.
+     * @param[in] iNumberSamples     The number of samples (columns) of the data matrix.
+     */
+    void resize(int iNumberRows,
+                int iNumberSamples);
+
+    //=========================================================================================================
+    /**
+     * Recomputes all bins on all levels which cover the given sample range. The pyramid is resized if the
+     * dimensions of matData changed, in which case the whole matrix is processed. matData is treated as a ring
+     * buffer, a range starting before the first or ending behind the last column wraps around to the other end.
+     *
+     * @param[in] matData            The data matrix the pyramid is build for.
+     * @param[in] iFirstSample       The first sample which was written, may be negative.
+     * @param[in] iNumberSamples     The number of written samples. -1 for all samples from iFirstSample on.
+     */
+    void update(const MatrixXdR& matData,
+                int iFirstSample = 0,
+                int iNumberSamples = -1);
+
+    //=========================================================================================================
+    /**
+     * Computes the per pixel min/max envelope of a sample range of one row. The coarsest level whose bin size
+     * does not exceed the number of samples per pixel is used.
+     *
+     * @param[in] pData              Pointer to the samples of the row. Used if no level is coarse enough.
+     * @param[in] iRow               The row of the data matrix.
+     * @param[in] iFirstSample       The first sample of the range.
+     * @param[in] iNumberSamples     The number of samples of the range.
+     * @param[in] iNumberPixels      The number of pixels the range is drawn to.
+     * @param[out] vecMin            The minimum per pixel.
+     * @param[out] vecMax            The maximum per pixel.
+     */
+    void getEnvelope(const double* pData,
+                     int iRow,
+                     int iFirstSample,
+                     int iNumberSamples,
+                     int iNumberPixels,
+                     Eigen::RowVectorXd& vecMin,
+                     Eigen::RowVectorXd& vecMax) const;
+
+    //=========================================================================================================
+    /**
+     * Computes the per pixel min/max envelope directly from the samples, e.g. for short data without a pyramid.
+     *
+     * @param[in] pData              Pointer to the first sample.
+     * @param[in] iNumberSamples     The number of samples.
+     * @param[in] iNumberPixels      The number of pixels the samples are drawn to.
+     * @param[out] vecMin            The minimum per pixel.
+     * @param[out] vecMax            The maximum per pixel.
+     */
+    static void computeEnvelope(const double* pData,
+                                int iNumberSamples,
+                                int iNumberPixels,
+                                Eigen::RowVectorXd& vecMin,
+                                Eigen::RowVectorXd& vecMax);
+
+    //=========================================================================================================
+    /**
+     * Returns the number of levels.
+     *
+     * @return The number of levels.
+     */
+    inline int getNumberLevels() const;
+
+protected:
+    //=========================================================================================================
+    /**
+     * Recomputes all bins on all levels which cover the samples [iFirstSample, iLastSample).
+     *
+     * @param[in] matData            The data matrix the pyramid is build for.
+     * @param[in] iFirstSample       The first sample of the range, 0 <= iFirstSample.
+     * @param[in] iLastSample        The sample behind the range, iLastSample <= number of samples.
+     */
+    void updateRange(const MatrixXdR& matData,
+                     int iFirstSample,
+                     int iLastSample);
+
+    int                     m_iBinFactor;           /**< The number of bins combined per level. */
+    int                     m_iNumberRows;          /**< The number of rows of the data matrix. */
+    int                     m_iNumberSamples;       /**< The number of samples of the data matrix. */
+
+    QVector<int>            m_vecBinSizes;          /**< The bin size in samples per level. */
+    QVector<MatrixXdR>      m_vecMinLevels;         /**< The bin minima per level. */
+    QVector<MatrixXdR>      m_vecMaxLevels;         /**< The bin maxima per level. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline int MinMaxPyramid::getNumberLevels() const
+{
+    return m_vecBinSizes.size();
+}
+} // NAMESPACE DISPLIB
+
+#endif // MINMAXPYRAMID_H
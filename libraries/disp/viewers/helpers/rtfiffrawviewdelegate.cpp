@@ -495,19 +495,6 @@ void RtFiffRawViewDelegate::createPlotPath(const QModelIndex &index,
     double dScaleY = option.rect.height()/(2*dMaxValue);
     double y_base = path.currentPosition().y();
 
-    // Calculate the smallest possible width for one sample data point
-    int iSkip = t_pModel->getMaxSamples() / option.rect.width();
-    if(iSkip <= 0) {
-        iSkip = 1;
-    }
-    double dRatio = t_pModel->getMaxSamples() / iSkip;
-    double dDx = option.rect.width() / dRatio;
-
-//    qDebug() << "t_pModel->getMaxSamples()" << t_pModel->getMaxSamples();
-//    qDebug() << "dRatio" << dRatio;
-//    qDebug() << "iSkip" << iSkip;
-//    qDebug() << "dDx" << dDx;
-
     // Init indices
     int currentSampleIndex = t_pModel->getCurrentSampleIndex();
     double lastFirstValue = t_pModel->getLastBlockFirstValue(index.row());
@@ -525,7 +512,18 @@ void RtFiffRawViewDelegate::createPlotPath(const QModelIndex &index,
         path.moveTo(qSamplePosition);
     }
 
-    for(qint32 j = 0; j < data.second; j += iSkip) {
+    //If more than one sample falls onto one pixel draw the min/max envelope per pixel instead of every sample.
+    //This keeps the path size proportional to the width and still shows spikes.
+    int iNumberPixels = option.rect.width();
+
+    if(iNumberPixels > 0 && data.second >= 2*iNumberPixels) {
+        createEnvelopePath(index, option, path, ellipsePos, amplitude, data, dScaleY);
+        return;
+    }
+
+    double dDx = double(option.rect.width()) / t_pModel->getMaxSamples();
+
+    for(qint32 j = 0; j < data.second; ++j) {
         if(j < currentSampleIndex) {
             dValue = *(data.first+j) - *(data.first); //remove first sample data[0] as offset
         } else {
@@ -552,6 +550,78 @@ void RtFiffRawViewDelegate::createPlotPath(const QModelIndex &index,
 
 //=============================================================================================================
 
+void RtFiffRawViewDelegate::createEnvelopePath(const QModelIndex &index,
+                                               const QStyleOptionViewItem &option,
+                                               QPainterPath& path,
+                                               QPointF &ellipsePos,
+                                               QString &amplitude,
+                                               RowVectorPair &data,
+                                               double dScaleY) const
+{
+    const RtFiffRawViewModel* t_pModel = static_cast<const RtFiffRawViewModel*>(index.model());
+
+    double x_base = path.currentPosition().x();
+    double y_base = path.currentPosition().y();
+
+    int iNumberPixels = option.rect.width();
+    int iNumberSamples = data.second;
+    int currentSampleIndex = qBound(0, t_pModel->getCurrentSampleIndex(), iNumberSamples);
+    int iMarkerPixel = m_markerPosition.x();
+
+    //The data in front of the current sample index is offset by its first sample, the data behind it by the first
+    //sample of the last block. Split the pixels accordingly so that no pixel mixes both parts.
+    int iPixelsFront = qRound(double(currentSampleIndex) * iNumberPixels / iNumberSamples);
+    iPixelsFront = qBound(currentSampleIndex > 0 ? 1 : 0,
+                          iPixelsFront,
+                          currentSampleIndex < iNumberSamples ? iNumberPixels - 1 : iNumberPixels);
+
+    Eigen::RowVectorXd vecMin, vecMax;
+    double dOffset, dValueMin, dValueMax, dX;
+    int iFirstSample, iPartSamples, iFirstPixel, iPartPixels;
+
+    for(int iPart = 0; iPart < 2; ++iPart) {
+        if(iPart == 0) {
+            iFirstSample = 0;
+            iPartSamples = currentSampleIndex;
+            iFirstPixel = 0;
+            iPartPixels = iPixelsFront;
+            dOffset = *(data.first); //remove first sample data[0] as offset
+        } else {
+            iFirstSample = currentSampleIndex;
+            iPartSamples = iNumberSamples - currentSampleIndex;
+            iFirstPixel = iPixelsFront;
+            iPartPixels = iNumberPixels - iPixelsFront;
+            dOffset = t_pModel->getLastBlockFirstValue(index.row()); //do not remove first sample data[0] as offset because this is the last data part
+        }
+
+        if(iPartSamples <= 0 || iPartPixels <= 0) {
+            continue;
+        }
+
+        t_pModel->getMinMaxEnvelope(index.row(), iFirstSample, iPartSamples, iPartPixels, vecMin, vecMax);
+
+        for(int p = 0; p < vecMin.cols(); ++p) {
+            //Reverse direction -> plot the right way
+            dValueMin = y_base - (vecMin(p) - dOffset) * dScaleY;
+            dValueMax = y_base - (vecMax(p) - dOffset) * dScaleY;
+            dX = x_base + iFirstPixel + p + 1;
+
+            path.lineTo(dX, dValueMin);
+            path.lineTo(dX, dValueMax);
+
+            //Create ellipse position
+            if(iFirstPixel + p == iMarkerPixel) {
+                ellipsePos.setX(dX);
+                ellipsePos.setY(dValueMax);
+
+                amplitude = QString::number(vecMax(p));
+            }
+        }
+    }
+}
+
+//=============================================================================================================
+
 void RtFiffRawViewDelegate::createCurrentPositionMarkerPath(const QModelIndex &index, const QStyleOptionViewItem &option, QPainterPath& path) const
 {
     const RtFiffRawViewModel* t_pModel = static_cast<const RtFiffRawViewModel*>(index.model());
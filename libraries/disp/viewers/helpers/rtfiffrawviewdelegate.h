@@ -180,6 +180,27 @@ private:
                         QString &amplitude,
                         DISPLIB::RowVectorPair &data) const;
 
+    //=========================================================================================================
+    /**
+     * createEnvelopePath appends the per pixel min/max envelope of the data to the path. Used by createPlotPath
+     * if more than one sample falls onto one pixel.
+     *
+     * @param[in] index      Used to locate data in a data model.
+     * @param[in] option     Describes the parameters used to draw an item in a view widget
+     * @param[in,out] path   The QPointerPath to create for the data plot.
+     * @param[in] ellipsePos Position of the ellipse which is plotted at the current channel signal value.
+     * @param[in] amplitude  String which is to be plotted.
+     * @param[in] data       Current data for the given row.
+     * @param[in] dScaleY    The scaling from data values to pixels.
+     */
+    void createEnvelopePath(const QModelIndex &index,
+                            const QStyleOptionViewItem &option,
+                            QPainterPath& path,
+                            QPointF &ellipsePos,
+                            QString &amplitude,
+                            DISPLIB::RowVectorPair &data,
+                            double dScaleY) const;
+
     //=========================================================================================================
     /**
      * createCurrentPositionMarkerPath Creates the QPointer path for the current marker position plot.
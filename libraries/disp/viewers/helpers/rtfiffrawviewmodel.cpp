@@ -315,17 +315,14 @@ void RtFiffRawViewModel::setFiffInfo(QSharedPointer<FIFFLIB::FiffInfo> &p_pFiffI
         m_vecLastBlockFirstValuesRaw.conservativeResize(m_pFiffInfo->chs.size());
         m_vecLastBlockFirstValuesRaw.setZero();
 
-        m_matOverlap.conservativeResize(m_pFiffInfo->chs.size(), m_iMaxFilterLength);
+        m_pyramidRaw.update(m_matDataRaw);
+        m_pyramidFiltered.update(m_matDataFiltered);
 
-        m_matSparseProjMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-        m_matSparseCompMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-        m_matSparseSpharaMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-        m_matSparseProjCompMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
+        m_matOverlap.conservativeResize(m_pFiffInfo->chs.size(), m_iMaxFilterLength);
 
-        m_matSparseProjMult.setIdentity();
-        m_matSparseCompMult.setIdentity();
-        m_matSparseSpharaMult.setIdentity();
-        m_matSparseProjCompMult.setIdentity();
+        m_projectionOperator.setNumberChannels(m_pFiffInfo->chs.size());
+        m_spharaOperator.setNumberChannels(m_pFiffInfo->chs.size());
+        m_spharaOperator.setStages(ProjectionOperator::Sphara);
 
         //Create the initial Compensator projector
         updateCompensator(0);
@@ -384,6 +381,9 @@ void RtFiffRawViewModel::setSamplingInfo(float sps, int T, bool bSetZero)
         m_vecLastBlockFirstValuesFiltered.setZero();
     }
 
+    m_pyramidRaw.update(m_matDataRaw);
+    m_pyramidFiltered.update(m_matDataFiltered);
+
     if(m_iCurrentSample>m_iMaxSamples) {
         m_iCurrentSample = 0;
     }
@@ -405,6 +405,40 @@ MatrixXd RtFiffRawViewModel::getLastBlock()
 //=============================================================================================================
 
 void RtFiffRawViewModel::addData(const QList<MatrixXd> &data)
+{
+    for(qint32 b = 0; b < data.size(); ++b) {
+        if(!appendBlock(data.at(b))) {
+            return;
+        }
+    }
+
+    //Update data content
+    QModelIndex topLeft = this->index(0,1);
+    QModelIndex bottomRight = this->index(m_pFiffInfo->ch_names.size()-1,1);
+    QVector<int> roles; roles << Qt::DisplayRole;
+
+    emit dataChanged(topLeft, bottomRight, roles);
+}
+
+//=============================================================================================================
+
+void RtFiffRawViewModel::addData(const MatrixXd &data)
+{
+    if(!appendBlock(data)) {
+        return;
+    }
+
+    //Update data content
+    QModelIndex topLeft = this->index(0,1);
+    QModelIndex bottomRight = this->index(m_pFiffInfo->ch_names.size()-1,1);
+    QVector<int> roles; roles << Qt::DisplayRole;
+
+    emit dataChanged(topLeft, bottomRight, roles);
+}
+
+//=============================================================================================================
+
+bool RtFiffRawViewModel::appendBlock(const MatrixXd &data)
 {
     //SSP
     bool doProj = m_bProjActivated && m_matDataRaw.cols() > 0 && m_matDataRaw.rows() == m_matProj.cols() ? true : false;
@@ -413,147 +447,139 @@ void RtFiffRawViewModel::addData(const QList<MatrixXd> &data)
     bool doComp = m_bCompActivated && m_matDataRaw.cols() > 0 && m_matDataRaw.rows() == m_matComp.cols() ? true : false;
 
     //SPHARA
-    bool doSphara = m_bSpharaActivated && m_matSparseSpharaMult.cols() > 0 && m_matDataRaw.rows() == m_matSparseSpharaMult.cols() ? true : false;
+    bool doSphara = m_bSpharaActivated && m_spharaOperator.getNumberChannels() > 0 && m_matDataRaw.rows() == m_spharaOperator.getNumberChannels() ? true : false;
+
+    bool doFilter = !m_filterKernel.isEmpty() && m_bPerformFiltering;
+
+    //Compensator, SSP and SPHARA are applied as one fused operator. SPHARA is applied after filtering if the data is filtered.
+    int iStages = ProjectionOperator::NoStage;
+
+    if(doComp) {
+        iStages |= ProjectionOperator::Compensator;
+    }
+
+    if(doProj) {
+        iStages |= ProjectionOperator::Projector;
+    }
+
+    if(doSphara && !doFilter) {
+        iStages |= ProjectionOperator::Sphara;
+    }
+
+    m_projectionOperator.setStages(iStages);
 
     //Copy new data into the global data matrix
-    for(qint32 b = 0; b < data.size(); ++b) {
-        int nCol = data.at(b).cols();
-        int nRow = data.at(b).rows();
+    int nCol = data.cols();
+    int nRow = data.rows();
 
-        if(nRow != m_matDataRaw.rows()) {
-            qDebug()<<"incoming data does not match internal data row size. Returning...";
-            return;
-        }
+    if(nRow != m_matDataRaw.rows()) {
+        qDebug()<<"incoming data does not match internal data row size. Returning...";
+        return false;
+    }
 
-        //Reset m_iCurrentSample and start filling the data matrix from the beginning again. Also add residual amount of data to the end of the matrix.
-        if(m_iCurrentSample+nCol > m_matDataRaw.cols()) {
-            m_iResidual = nCol - ((m_iCurrentSample+nCol) % m_matDataRaw.cols());
+    //Reset m_iCurrentSample and start filling the data matrix from the beginning again. Also add residual amount of data to the end of the matrix.
+    if(m_iCurrentSample+nCol > m_matDataRaw.cols()) {
+        m_iResidual = nCol - ((m_iCurrentSample+nCol) % m_matDataRaw.cols());
 
-            if(m_iResidual == nCol) {
-                m_iResidual = 0;
-            }
+        if(m_iResidual == nCol) {
+            m_iResidual = 0;
+        }
 
 //            std::cout<<"incoming data exceeds internal data cols by: "<<(m_iCurrentSample+nCol) % m_matDataRaw.cols()<<std::endl;
 //            std::cout<<"m_iCurrentSample+nCol: "<<m_iCurrentSample+nCol<<std::endl;
 //            std::cout<<"m_matDataRaw.cols(): "<<m_matDataRaw.cols()<<std::endl;
 //            std::cout<<"nCol-m_iResidual: "<<nCol-m_iResidual<<std::endl<<std::endl;
 
-            if(doComp) {
-                if(doProj) {
-                    //Comp + Proj
-                    m_matDataRaw.block(0, m_iCurrentSample, nRow, m_iResidual) = m_matSparseProjCompMult * data.at(b).block(0,0,nRow,m_iResidual);
-                } else {
-                    //Comp
-                    m_matDataRaw.block(0, m_iCurrentSample, nRow, m_iResidual) = m_matSparseCompMult * data.at(b).block(0,0,nRow,m_iResidual);
-                }
-            } else {
-                if(doProj)
-                {
-                    //Proj
-                    m_matDataRaw.block(0, m_iCurrentSample, nRow, m_iResidual) = m_matSparseProjMult * data.at(b).block(0,0,nRow,m_iResidual);
-                } else {
-                    //None - Raw
-                    m_matDataRaw.block(0, m_iCurrentSample, nRow, m_iResidual) = data.at(b).block(0,0,nRow,m_iResidual);
-                }
-            }
+        m_projectionOperator.apply(data.block(0,0,nRow,m_iResidual),
+                                   m_matDataRaw.block(0, m_iCurrentSample, nRow, m_iResidual));
 
-            m_iCurrentSample = 0;
+        m_iCurrentSample = 0;
 
-            if(!m_bIsFreezed) {
-                m_vecLastBlockFirstValuesFiltered = m_matDataFiltered.col(0);
-                m_vecLastBlockFirstValuesRaw = m_matDataRaw.col(0);
-            }
+        if(!m_bIsFreezed) {
+            m_vecLastBlockFirstValuesFiltered = m_matDataFiltered.col(0);
+            m_vecLastBlockFirstValuesRaw = m_matDataRaw.col(0);
+        }
 
-            //Store old detected triggers
-            m_qMapDetectedTriggerOld = m_qMapDetectedTrigger;
+        //Store old detected triggers
+        m_qMapDetectedTriggerOld = m_qMapDetectedTrigger;
 
-            //Clear detected triggers
-            if(m_bTriggerDetectionActive) {
-                QMutableMapIterator<int,QList<QPair<int,double> > > i(m_qMapDetectedTrigger);
-                while (i.hasNext()) {
-                    i.next();
-                    i.value().clear();
-                }
+        //Clear detected triggers
+        if(m_bTriggerDetectionActive) {
+            QMutableMapIterator<int,QList<QPair<int,double> > > i(m_qMapDetectedTrigger);
+            while (i.hasNext()) {
+                i.next();
+                i.value().clear();
             }
-        } else {
-            m_iResidual = 0;
         }
+    } else {
+        m_iResidual = 0;
+    }
 
-        //std::cout<<"incoming data is ok"<<std::endl;
+    //std::cout<<"incoming data is ok"<<std::endl;
 
-        if(doComp) {
-            if(doProj) {
-                //Comp + Proj
-                m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol) = m_matSparseProjCompMult * data.at(b);
-            } else {
-                //Comp
-                m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol) = m_matSparseCompMult * data.at(b);
+    m_projectionOperator.apply(data,
+                               m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol));
+
+    //Filter if neccessary else set filtered data matrix to zero
+    if(doFilter) {
+        filterDataBlock(m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol), m_iCurrentSample);
+
+        //Perform SPHARA on filtered data after actual filtering - SPHARA should be applied on the best possible data
+        if(doSphara) {
+            if(m_iCurrentSample-m_iMaxFilterLength/2 >= 0) {
+                m_spharaOperator.apply(m_matDataFiltered.block(0, m_iCurrentSample-m_iMaxFilterLength/2, nRow, nCol));
             }
-        } else {
-            if(doProj) {
-                //Proj
-                m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol) = m_matSparseProjMult * data.at(b);
-            } else {
-                //None - Raw
-                m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol) = data.at(b);
+            else {
+                if(m_iCurrentSample-m_iMaxFilterLength/2 < 0) {
+                    m_spharaOperator.apply(m_matDataFiltered.block(0, 0, nRow, nCol));
+                    int iResidual = m_iResidual+m_iMaxFilterLength/2;
+                    m_spharaOperator.apply(m_matDataFiltered.block(0, m_matDataFiltered.cols()-iResidual, nRow, iResidual));
+                }
             }
         }
+    } else {
+        m_matDataFiltered.block(0, m_iCurrentSample, nRow, nCol).setZero();// = m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol);
+    }
 
-        //Filter if neccessary else set filtered data matrix to zero
-        if(!m_filterKernel.isEmpty() && m_bPerformFiltering) {
-            filterDataBlock(m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol), m_iCurrentSample);
+    //Update the min/max decimations of the written sample ranges
+    m_pyramidRaw.update(m_matDataRaw, m_iCurrentSample, nCol);
 
-            //Perform SPHARA on filtered data after actual filtering - SPHARA should be applied on the best possible data
-            if(doSphara) {
-                if(m_iCurrentSample-m_iMaxFilterLength/2 >= 0) {
-                    m_matDataFiltered.block(0, m_iCurrentSample-m_iMaxFilterLength/2, nRow, nCol) = m_matSparseSpharaMult * m_matDataFiltered.block(0, m_iCurrentSample-m_iMaxFilterLength/2, nRow, nCol);
-                }
-                else {
-                    if(m_iCurrentSample-m_iMaxFilterLength/2 < 0) {
-                        m_matDataFiltered.block(0, 0, nRow, nCol) = m_matSparseSpharaMult * m_matDataFiltered.block(0, 0, nRow, nCol);
-                        int iResidual = m_iResidual+m_iMaxFilterLength/2;
-                        m_matDataFiltered.block(0, m_matDataFiltered.cols()-iResidual, nRow, iResidual) = m_matSparseSpharaMult * m_matDataFiltered.block(0, m_matDataFiltered.cols()-iResidual, nRow, iResidual);
-                    }
-                }
-            }
-        } else {
-            m_matDataFiltered.block(0, m_iCurrentSample, nRow, nCol).setZero();// = m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol);
+    if(doFilter) {
+        //The overlap add writes up to one filter length around the current block
+        m_pyramidFiltered.update(m_matDataFiltered, m_iCurrentSample-m_iMaxFilterLength, nCol+2*m_iMaxFilterLength);
+    } else {
+        m_pyramidFiltered.update(m_matDataFiltered, m_iCurrentSample, nCol);
+    }
 
-            //Perform SPHARA on raw data data
-            if(doSphara) {
-                m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol) = m_matSparseSpharaMult * m_matDataRaw.block(0, m_iCurrentSample, nRow, nCol);
-            }
-        }
+    if(m_iCurrentSample == 0) {
+        //The residual and the filter delay were written to the end of the matrices
+        m_pyramidRaw.update(m_matDataRaw, m_matDataRaw.cols()-m_iResidual, m_iResidual);
+        m_pyramidFiltered.update(m_matDataFiltered, m_matDataFiltered.cols()-m_iResidual-m_iMaxFilterLength, m_iResidual+m_iMaxFilterLength);
+    }
 
-        m_iCurrentSample += nCol;
-        m_iCurrentBlockSize = nCol;
+    m_iCurrentSample += nCol;
+    m_iCurrentBlockSize = nCol;
 
-        //detect the trigger flanks in the trigger channels
-        if(m_bTriggerDetectionActive) {
-            int iOldDetectedTriggers = m_qMapDetectedTrigger[m_iCurrentTriggerChIndex].size();
+    //detect the trigger flanks in the trigger channels
+    if(m_bTriggerDetectionActive) {
+        int iOldDetectedTriggers = m_qMapDetectedTrigger[m_iCurrentTriggerChIndex].size();
 
-            QList<QPair<int,double> > qMapDetectedTrigger = RTPROCESSINGLIB::detectTriggerFlanksMax(data.at(b), m_iCurrentTriggerChIndex, m_iCurrentSample-nCol, m_dTriggerThreshold, true, 500);
-            //QList<QPair<int,double> > qMapDetectedTrigger = RTPROCESSINGLIB::detectTriggerFlanksGrad(data.at(b), m_iCurrentTriggerChIndex, m_iCurrentSample-nCol, m_dTriggerThreshold, false, "Rising");
+        QList<QPair<int,double> > qMapDetectedTrigger = RTPROCESSINGLIB::detectTriggerFlanksMax(data, m_iCurrentTriggerChIndex, m_iCurrentSample-nCol, m_dTriggerThreshold, true, 500);
+        //QList<QPair<int,double> > qMapDetectedTrigger = RTPROCESSINGLIB::detectTriggerFlanksGrad(data, m_iCurrentTriggerChIndex, m_iCurrentSample-nCol, m_dTriggerThreshold, false, "Rising");
 
-            //Append results to already found triggers
-            m_qMapDetectedTrigger[m_iCurrentTriggerChIndex].append(qMapDetectedTrigger);
+        //Append results to already found triggers
+        m_qMapDetectedTrigger[m_iCurrentTriggerChIndex].append(qMapDetectedTrigger);
 
-            //Compute newly counted triggers
-            int newTriggers = m_qMapDetectedTrigger[m_iCurrentTriggerChIndex].size() - iOldDetectedTriggers;
+        //Compute newly counted triggers
+        int newTriggers = m_qMapDetectedTrigger[m_iCurrentTriggerChIndex].size() - iOldDetectedTriggers;
 
-            if(newTriggers!=0) {
-                m_iDetectedTriggers += newTriggers;
-                emit triggerDetected(m_iDetectedTriggers, m_qMapDetectedTrigger);
-            }
+        if(newTriggers!=0) {
+            m_iDetectedTriggers += newTriggers;
+            emit triggerDetected(m_iDetectedTriggers, m_qMapDetectedTrigger);
         }
     }
 
-    //Update data content
-    QModelIndex topLeft = this->index(0,1);
-    QModelIndex bottomRight = this->index(m_pFiffInfo->ch_names.size()-1,1);
-    QVector<int> roles; roles << Qt::DisplayRole;
-
-    emit dataChanged(topLeft, bottomRight, roles);
+    return true;
 }
 
 //=============================================================================================================
@@ -594,6 +620,38 @@ fiff_int_t RtFiffRawViewModel::getCoil(qint32 row) const
 
 //=============================================================================================================
 
+void RtFiffRawViewModel::getMinMaxEnvelope(int row,
+                                           int iFirstSample,
+                                           int iNumberSamples,
+                                           int iNumberPixels,
+                                           RowVectorXd& vecMin,
+                                           RowVectorXd& vecMax) const
+{
+    qint32 chRow = m_qMapIdxRowSelection.value(row,0);
+    bool bFiltered = !m_filterKernel.isEmpty() && m_bPerformFiltering;
+
+    const MatrixXdR& matData = m_bIsFreezed ? (bFiltered ? m_matDataFilteredFreeze : m_matDataRawFreeze)
+                                            : (bFiltered ? m_matDataFiltered : m_matDataRaw);
+    const MinMaxPyramid& pyramid = m_bIsFreezed ? (bFiltered ? m_pyramidFilteredFreeze : m_pyramidRawFreeze)
+                                                : (bFiltered ? m_pyramidFiltered : m_pyramidRaw);
+
+    if(chRow >= matData.rows()) {
+        vecMin.resize(0);
+        vecMax.resize(0);
+        return;
+    }
+
+    pyramid.getEnvelope(matData.data() + chRow*matData.cols(),
+                        chRow,
+                        iFirstSample,
+                        iNumberSamples,
+                        iNumberPixels,
+                        vecMin,
+                        vecMax);
+}
+
+//=============================================================================================================
+
 void RtFiffRawViewModel::selectRows(const QList<qint32> &selection)
 {
     beginResetModel();
@@ -654,6 +712,8 @@ void RtFiffRawViewModel::toggleFreeze(const QModelIndex &)
     if(m_bIsFreezed) {
         m_matDataRawFreeze = m_matDataRaw;
         m_matDataFilteredFreeze = m_matDataFiltered;
+        m_pyramidRawFreeze = m_pyramidRaw;
+        m_pyramidFilteredFreeze = m_pyramidFiltered;
         m_qMapDetectedTriggerFreeze = m_qMapDetectedTrigger;
         m_qMapDetectedTriggerOldFreeze = m_qMapDetectedTriggerOld;
 
@@ -707,33 +767,7 @@ void RtFiffRawViewModel::updateProjection(const QList<FIFFLIB::FiffProj>& projs)
 //        std::cout << "Proj\n";
 //        std::cout << m_matProj.block(0,0,10,10) << std::endl;
 
-        //
-        // Make proj sparse
-        //
-        qint32 nchan = this->m_pFiffInfo->nchan;
-        qint32 i, k;
-
-        typedef Eigen::Triplet<double> T;
-        std::vector<T> tripletList;
-        tripletList.reserve(nchan);
-
-        tripletList.clear();
-        tripletList.reserve(m_matProj.rows()*m_matProj.cols());
-        for(i = 0; i < m_matProj.rows(); ++i) {
-            for(k = 0; k < m_matProj.cols(); ++k) {
-                if(m_matProj(i,k) != 0) {
-                    tripletList.push_back(T(i, k, m_matProj(i,k)));
-                }
-            }
-        }
-
-        m_matSparseProjMult = SparseMatrix<double>(m_matProj.rows(),m_matProj.cols());
-        if(tripletList.size() > 0) {
-            m_matSparseProjMult.setFromTriplets(tripletList.begin(), tripletList.end());
-        }
-
-        //Create full multiplication matrix
-        m_matSparseProjCompMult = m_matSparseProjMult * m_matSparseCompMult;
+        m_projectionOperator.setProjector(m_matProj);
     }
 }
 
@@ -761,33 +795,7 @@ void RtFiffRawViewModel::updateCompensator(int to)
         //Note that the data is written in raw form not in compensated form.
         m_matComp = newComp.data->data;
 
-        //
-        // Make proj sparse
-        //
-        qint32 nchan = this->m_pFiffInfo->nchan;
-        qint32 i, k;
-
-        typedef Eigen::Triplet<double> T;
-        std::vector<T> tripletList;
-        tripletList.reserve(nchan);
-
-        tripletList.clear();
-        tripletList.reserve(m_matComp.rows()*m_matComp.cols());
-        for(i = 0; i < m_matComp.rows(); ++i) {
-            for(k = 0; k < m_matComp.cols(); ++k) {
-                if(m_matComp(i,k) != 0) {
-                    tripletList.push_back(T(i, k, m_matComp(i,k)));
-                }
-            }
-        }
-
-        m_matSparseCompMult = SparseMatrix<double>(m_matComp.rows(),m_matComp.cols());
-        if(tripletList.size() > 0) {
-            m_matSparseCompMult.setFromTriplets(tripletList.begin(), tripletList.end());
-        }
-
-        //Create full multiplication matrix
-        m_matSparseProjCompMult = m_matSparseProjMult * m_matSparseCompMult;
+        m_projectionOperator.setCompensator(m_matComp);
     }
 }
 
@@ -826,54 +834,11 @@ void RtFiffRawViewModel::updateSpharaOptions(const QString& sSytemType, int nBas
 //        IOUtils::write_eigen_matrix(matSpharaMultSecond, QString(QCoreApplication::applicationDirPath() + "/resources/mne_scan/plugins/noisereduction/SPHARA/matSpharaMultSecond.txt"));
 //        IOUtils::write_eigen_matrix(m_matSpharaEEGLoaded, QString(QCoreApplication::applicationDirPath() + "/resources/mne_scan/plugins/noisereduction/SPHARA/m_matSpharaEEGLoaded.txt"));
 
-        //
-        // Make operators sparse
-        //
-        qint32 nchan = this->m_pFiffInfo->nchan;
-        qint32 i, k;
-
-        typedef Eigen::Triplet<double> T;
-        std::vector<T> tripletList;
-        tripletList.reserve(nchan);
-
-        //First operator
-        tripletList.clear();
-        tripletList.reserve(matSpharaMultFirst.rows()*matSpharaMultFirst.cols());
-        for(i = 0; i < matSpharaMultFirst.rows(); ++i) {
-            for(k = 0; k < matSpharaMultFirst.cols(); ++k) {
-                if(matSpharaMultFirst(i,k) != 0) {
-                    tripletList.push_back(T(i, k, matSpharaMultFirst(i,k)));
-                }
-            }
-        }
-
-        Eigen::SparseMatrix<double> matSparseSpharaMultFirst = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-
-        matSparseSpharaMultFirst = SparseMatrix<double>(matSpharaMultFirst.rows(),matSpharaMultFirst.cols());
-        if(tripletList.size() > 0) {
-            matSparseSpharaMultFirst.setFromTriplets(tripletList.begin(), tripletList.end());
-        }
-
-        //Second operator
-        tripletList.clear();
-        tripletList.reserve(matSpharaMultSecond.rows()*matSpharaMultSecond.cols());
-
-        for(i = 0; i < matSpharaMultSecond.rows(); ++i) {
-            for(k = 0; k < matSpharaMultSecond.cols(); ++k) {
-                if(matSpharaMultSecond(i,k) != 0) {
-                    tripletList.push_back(T(i, k, matSpharaMultSecond(i,k)));
-                }
-            }
-        }
-
-        Eigen::SparseMatrix<double>matSparseSpharaMultSecond = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
-
-        if(tripletList.size() > 0) {
-            matSparseSpharaMultSecond.setFromTriplets(tripletList.begin(), tripletList.end());
-        }
-
         //Create full multiplication matrix
-        m_matSparseSpharaMult = matSparseSpharaMultFirst * matSparseSpharaMultSecond;
+        MatrixXd matSpharaMult = matSpharaMultFirst * matSpharaMultSecond;
+
+        m_projectionOperator.setSphara(matSpharaMult);
+        m_spharaOperator.setSphara(matSpharaMult);
     }
 }
 
@@ -1167,6 +1132,8 @@ void RtFiffRawViewModel::filterDataBlock()
         m_vecLastBlockFirstValuesFiltered = m_matDataFiltered.col(0);
     }
 
+    m_pyramidFiltered.update(m_matDataFiltered);
+
     //std::cout<<"END RtFiffRawViewModel::filterDataBlock"<<std::endl;
 }
 
@@ -41,11 +41,13 @@
 //=============================================================================================================
 
 #include "../../disp_global.h"
+#include "minmaxpyramid.h"
 
 #include <fiff/fiff_types.h>
 #include <fiff/fiff_proj.h>
 
 #include <rtprocessing/helpers/filterkernel.h>
+#include <rtprocessing/helpers/projectionoperator.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -60,7 +62,6 @@
 //=============================================================================================================
 
 #include <Eigen/Core>
-#include <Eigen/SparseCore>
 
 //=============================================================================================================
 // FORWARD DECLARATIONS
@@ -86,7 +87,6 @@ namespace DISPLIB
 //=============================================================================================================
 
 typedef QPair<const double*,qint32> RowVectorPair;
-typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> MatrixXdR;
 
 //=============================================================================================================
 /**
@@ -187,6 +187,14 @@ public:
      */
     void addData(const QList<Eigen::MatrixXd> &data);
 
+    //=========================================================================================================
+    /**
+     * Adds a single block of time points for a channel set
+     *
+     * @param[in] data       data to add (Time points of channel samples)
+     */
+    void addData(const Eigen::MatrixXd &data);
+
     //=========================================================================================================
     /**
      * Returns the kind of a given channel number
@@ -243,6 +251,24 @@ public:
      */
     inline double getLastBlockFirstValue(int row) const;
 
+    //=========================================================================================================
+    /**
+     * Returns the per pixel min/max envelope of a sample range of the currently displayed data of a channel.
+     *
+     * @param[in] row                row for which the envelope is to be returned
+     * @param[in] iFirstSample       the first sample of the range
+     * @param[in] iNumberSamples     the number of samples of the range
+     * @param[in] iNumberPixels      the number of pixels the range is drawn to
+     * @param[out] vecMin            the minimum per pixel
+     * @param[out] vecMax            the maximum per pixel
+     */
+    void getMinMaxEnvelope(int row,
+                           int iFirstSample,
+                           int iNumberSamples,
+                           int iNumberPixels,
+                           Eigen::RowVectorXd& vecMin,
+                           Eigen::RowVectorXd& vecMax) const;
+
     //=========================================================================================================
     /**
      * Returns a map which conatins the channel idx and its corresponding selection status
@@ -509,6 +535,16 @@ private:
      */
     void initSphara();
 
+    //=========================================================================================================
+    /**
+     * Copies a block into the global data matrices and applies the projections, filters and trigger detection.
+     *
+     * @param[in] data       data to add (Time points of channel samples)
+     *
+     * @return false if the block does not match the number of channels.
+     */
+    bool appendBlock(const Eigen::MatrixXd &data);
+
     static void doFilterPerChannelRTMSA(QPair<QList<RTPROCESSINGLIB::FilterKernel>,QPair<int,Eigen::RowVectorXd> > &channelDataTime);
 
     //=========================================================================================================
@@ -566,6 +602,10 @@ private:
     MatrixXdR                           m_matDataFiltered;                          /**< The filtered data */
     MatrixXdR                           m_matDataRawFreeze;                         /**< The raw data in freeze mode */
     MatrixXdR                           m_matDataFilteredFreeze;                    /**< The raw filtered data in freeze mode */
+    MinMaxPyramid                       m_pyramidRaw;                               /**< The min/max decimations of the raw data */
+    MinMaxPyramid                       m_pyramidFiltered;                          /**< The min/max decimations of the filtered data */
+    MinMaxPyramid                       m_pyramidRawFreeze;                         /**< The min/max decimations of the raw data in freeze mode */
+    MinMaxPyramid                       m_pyramidFilteredFreeze;                    /**< The min/max decimations of the filtered data in freeze mode */
     Eigen::MatrixXd                     m_matOverlap;                               /**< Last overlap block for the back */
 
     Eigen::VectorXi                     m_vecIndicesFirstVV;                        /**< The indices of the channels to pick for the first SPHARA operator in case of a VectorView system.*/
@@ -574,10 +614,8 @@ private:
     Eigen::VectorXi                     m_vecIndicesSecondBabyMEG;                  /**< The indices of the channels to pick for the second SPHARA operator in case of a BabyMEG system.*/
     Eigen::VectorXi                     m_vecIndicesFirstEEG;                       /**< The indices of the channels to pick for the second SPHARA operator in case of an EEG system.*/
 
-    Eigen::SparseMatrix<double>         m_matSparseSpharaMult;                      /**< The final sparse SPHARA operator .*/
-    Eigen::SparseMatrix<double>         m_matSparseProjCompMult;                    /**< The final sparse projection + compensator operator.*/
-    Eigen::SparseMatrix<double>         m_matSparseProjMult;                        /**< The final sparse SSP projector */
-    Eigen::SparseMatrix<double>         m_matSparseCompMult;                        /**< The final sparse compensator matrix */
+    RTPROCESSINGLIB::ProjectionOperator m_projectionOperator;                       /**< The fused compensator, SSP and SPHARA operator applied to the incoming data */
+    RTPROCESSINGLIB::ProjectionOperator m_spharaOperator;                           /**< The SPHARA operator applied after filtering */
 
     Eigen::MatrixXd                     m_matProj;                                  /**< SSP projector */
     Eigen::MatrixXd                     m_matComp;                                  /**< Compensator */
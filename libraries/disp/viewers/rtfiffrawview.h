@@ -147,6 +147,14 @@ public:
      */
     void addData(const QList<Eigen::MatrixXd>& data);
 
+    //=========================================================================================================
+    /**
+     * Add a single data block to the view.
+     *
+     * @param [in] data    The new data block.
+     */
+    void addData(const Eigen::MatrixXd& data);
+
     //=========================================================================================================
     /**
      * Get the latest data block from the underlying model.
@@ -410,6 +418,12 @@ protected:
      */
     void channelContextMenu(QPoint pos);
 
+    //=========================================================================================================
+    /**
+     * Hides or shows the rows of the bad channels if the bad channels changed.
+     */
+    void updateBadChannels();
+
     //=========================================================================================================
     /**
      * apply the in m_qListCurrentSelection stored selection -> hack around C++11 lambda
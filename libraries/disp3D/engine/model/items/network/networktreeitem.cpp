@@ -253,7 +253,6 @@ void NetworkTreeItem::plotNodes(const Network& tNetworkData)
         return;
     }
 
-    QList<NetworkNode::SPtr> lNetworkNodes = tNetworkData.getNodes();
     qint16 iMaxDegree = tNetworkData.getMinMaxThresholdedDegrees().second;
 
     VisualizationInfo visualizationInfo = tNetworkData.getVisualizationInfo();
@@ -285,13 +284,14 @@ void NetworkTreeItem::plotNodes(const Network& tNetworkData)
     QVector3D tempPos;
     qint16 iDegree = 0;
 
-    for(int i = 0; i < lNetworkNodes.size(); ++i) {
-        iDegree = lNetworkNodes.at(i)->getThresholdedDegree();
+    for(int i = 0; i < tNetworkData.getNumberNodes(); ++i) {
+        iDegree = tNetworkData.getThresholdedDegree(i);
 
         if(iDegree != 0) {
-            tempPos = QVector3D(lNetworkNodes.at(i)->getVert()(0),
-                                lNetworkNodes.at(i)->getVert()(1),
-                                lNetworkNodes.at(i)->getVert()(2));
+            const RowVectorXf& vecVert = tNetworkData.getNodeVert(i);
+            tempPos = QVector3D(vecVert(0),
+                                vecVert(1),
+                                vecVert(2));
 
             //Set position and scale
             QMatrix4x4 tempTransform;
@@ -336,8 +336,9 @@ void NetworkTreeItem::plotEdges(const Network &tNetworkData)
     double dMaxWeight = tNetworkData.getMinMaxThresholdedWeights().second;
     double dMinWeight = tNetworkData.getMinMaxThresholdedWeights().first;
 
-    QList<NetworkEdge::SPtr> lNetworkEdges = tNetworkData.getThresholdedEdges();
-    QList<NetworkNode::SPtr> lNetworkNodes = tNetworkData.getNodes();
+    // Iterate the thresholded CSR adjacency directly instead of creating the edge objects
+    const NetworkAdjacency& adjacency = tNetworkData.getThresholdedAdjacency();
+    const VectorXd& vecWeights = tNetworkData.getPairWeights();
 
     VisualizationInfo visualizationInfo = tNetworkData.getVisualizationInfo();
 
@@ -370,26 +371,27 @@ void NetworkTreeItem::plotEdges(const Network &tNetworkData)
     double dWeight = 0.0;
     int iStartID, iEndID;
 
-    for(int i = 0; i < lNetworkEdges.size(); ++i) {
-        //Plot in edges
-        NetworkEdge::SPtr pNetworkEdge = lNetworkEdges.at(i);
+    for(iStartID = 0; iStartID < adjacency.vecRowPtr.size() - 1; ++iStartID) {
+        for(int k = adjacency.vecRowPtr[iStartID]; k < adjacency.vecRowPtr[iStartID + 1]; ++k) {
+            //Plot every undirected edge once
+            iEndID = adjacency.vecNeighbors[k];
 
-        if(pNetworkEdge->isActive()) {
-            iStartID = pNetworkEdge->getStartNodeID();
-            iEndID = pNetworkEdge->getEndNodeID();
+            if(iEndID < iStartID) {
+                continue;
+            }
 
-            RowVectorXf vectorStart = lNetworkNodes.at(iStartID)->getVert();
+            const RowVectorXf& vectorStart = tNetworkData.getNodeVert(iStartID);
             startPos = QVector3D(vectorStart(0),
                                  vectorStart(1),
                                  vectorStart(2));
 
-            RowVectorXf vectorEnd = lNetworkNodes.at(iEndID)->getVert();
+            const RowVectorXf& vectorEnd = tNetworkData.getNodeVert(iEndID);
             endPos = QVector3D(vectorEnd(0),
                                vectorEnd(1),
                                vectorEnd(2));
 
             if(startPos != endPos) {
-                dWeight = fabs(pNetworkEdge->getWeight());
+                dWeight = fabs(vecWeights[adjacency.vecPairs[k]]);
                 if(dWeight != 0.0) {
                     diff = endPos - startPos;
                     edgePos = endPos - diff/2;
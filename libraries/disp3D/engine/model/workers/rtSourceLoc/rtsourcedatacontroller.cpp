@@ -76,11 +76,8 @@ RtSourceDataController::RtSourceDataController()
        connect(&m_rtSourceDataWorkerThread, &QThread::finished,
                m_pRtSourceDataWorker.data(), &QObject::deleteLater);
 
-       connect(m_pRtSourceDataWorker.data(), &RtSourceDataWorker::newRtRawData,
-               this, &RtSourceDataController::onNewRtRawData, Qt::BlockingQueuedConnection);
-
-       connect(m_pRtSourceDataWorker.data(), &RtSourceDataWorker::newRtSmoothedData,
-               this, &RtSourceDataController::onNewSmoothedRtRawData, Qt::BlockingQueuedConnection);
+       connect(m_pRtSourceDataWorker.data(), &RtSourceDataWorker::newRtDataAvailable,
+               this, &RtSourceDataController::onNewRtDataAvailable, Qt::QueuedConnection);
 
        connect(&m_timer, &QTimer::timeout,
                m_pRtSourceDataWorker.data(), &RtSourceDataWorker::streamData);
@@ -130,6 +127,9 @@ RtSourceDataController::RtSourceDataController()
        connect(this, &RtSourceDataController::cancelDistanceChanged,
                m_pRtInterpolationLeftWorker.data(), &RtSourceInterpolationMatWorker::setCancelDistance);
 
+       connect(this, &RtSourceDataController::interpolationCacheDirectoryChanged,
+               m_pRtInterpolationLeftWorker.data(), &RtSourceInterpolationMatWorker::setCacheDirectory);
+
        connect(m_pRtInterpolationLeftWorker.data(), &RtSourceInterpolationMatWorker::newInterpolationMatrixCalculated,
                this, &RtSourceDataController::onNewInterpolationMatrixLeftCalculated);
 
@@ -157,6 +157,9 @@ RtSourceDataController::RtSourceDataController()
        connect(this, &RtSourceDataController::cancelDistanceChanged,
                m_pRtInterpolationRightWorker.data(), &RtSourceInterpolationMatWorker::setCancelDistance);
 
+       connect(this, &RtSourceDataController::interpolationCacheDirectoryChanged,
+               m_pRtInterpolationRightWorker.data(), &RtSourceInterpolationMatWorker::setCacheDirectory);
+
        connect(m_pRtInterpolationRightWorker.data(), &RtSourceInterpolationMatWorker::newInterpolationMatrixCalculated,
                this, &RtSourceDataController::onNewInterpolationMatrixRightCalculated);
 
@@ -218,6 +221,13 @@ void RtSourceDataController::setCancelDistance(double dCancelDist)
 
 //=============================================================================================================
 
+void RtSourceDataController::setInterpolationCacheDirectory(const QString &sCacheDir)
+{
+    emit interpolationCacheDirectoryChanged(sCacheDir);
+}
+
+//=============================================================================================================
+
 void RtSourceDataController::setTimeInterval(int iMSec)
 {
 //    if(iMSec < 17) {
@@ -335,20 +345,21 @@ void RtSourceDataController::addData(const MatrixXd& data)
 
 //=============================================================================================================
 
-void RtSourceDataController::onNewRtRawData(const VectorXd &vecDataVectorLeftHemi,
-                                            const VectorXd &vecDataVectorRightHemi)
+void RtSourceDataController::onNewRtDataAvailable()
 {
-    emit newRtRawDataAvailable(vecDataVectorLeftHemi,
-                               vecDataVectorRightHemi);
-}
+    if(!m_pRtSourceDataWorker || !m_pRtSourceDataWorker->acquireLatestFrame()) {
+        return;
+    }
 
-//=============================================================================================================
+    const RtSourceDataFrame& frame = m_pRtSourceDataWorker->getCurrentFrame();
 
-void RtSourceDataController::onNewSmoothedRtRawData(const MatrixX4f &matColorMatrixLeftHemi,
-                                                    const MatrixX4f &matColorMatrixRightHemi)
-{
-    emit newRtSmoothedDataAvailable(matColorMatrixLeftHemi,
-                                    matColorMatrixRightHemi);
+    if(frame.bSmoothed) {
+        emit newRtSmoothedDataAvailable(frame.matColorMatrixLeftHemi,
+                                        frame.matColorMatrixRightHemi);
+    } else {
+        emit newRtRawDataAvailable(frame.vecDataVectorLeftHemi,
+                                   frame.vecDataVectorRightHemi);
+    }
 }
 
 //=============================================================================================================
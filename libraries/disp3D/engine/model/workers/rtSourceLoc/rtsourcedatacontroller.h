@@ -138,6 +138,15 @@ public:
      */
     void setCancelDistance(double dCancelDist);
 
+    //=========================================================================================================
+    /**
+     * Sets the directory in which the interpolation matrices are cached. Previously calculated matrices for the
+     * same surface, source space and interpolation parameters are loaded from there instead of recalculated.
+     *
+     * @param[in] sCacheDir             The cache directory. An empty string disables the cache.
+     */
+    void setInterpolationCacheDirectory(const QString &sCacheDir);
+
     //=========================================================================================================
     /**
      * Set the time in MSec to wait inbetween data samples.
@@ -252,24 +261,11 @@ public:
 protected:
     //=========================================================================================================
     /**
-     * Call this function whenever new raw data is available to be dispatched.
-     * This function is usefull, e.g., when the interpolation is done on shader (GPU) level.
-     *
-     * @param[in] vecDataVectorLeftHemi          The new streamed raw data for the left hemispehre.
-     * @param[in] vecDataVectorRightHemi         The new streamed raw data for the right hemispehre.
+     * Call this function whenever the worker streamed a new frame. Picks up the latest frame and dispatches it
+     * as raw data (e.g., when the interpolation is done on shader (GPU) level) or as interpolated colors.
+     * Frames which were streamed while the previous one was dispatched are skipped.
      */
-    void onNewRtRawData(const Eigen::VectorXd &vecDataVectorLeftHemi,
-                        const Eigen::VectorXd &vecDataVectorRightHemi);
-
-    //=========================================================================================================
-    /**
-     * Call this function whenever new interpolated raw data is available to be dispatched.
-     *
-     * @param[in] matColorMatrixLeftHemi          The new streamed interpolated raw data in form of RGB colors per vertex for the left hemisphere.
-     * @param[in] matColorMatrixRightHemi         The new streamed interpolated raw data in form of RGB colors per vertex for the right hemisphere.
-     */
-    void onNewSmoothedRtRawData(const Eigen::MatrixX4f &matColorMatrixLeftHemi,
-                                const Eigen::MatrixX4f &matColorMatrixRightHemi);
+    void onNewRtDataAvailable();
 
     //=========================================================================================================
     /**
@@ -382,6 +378,14 @@ signals:
      */
     void cancelDistanceChanged(double dCancelDist);
 
+    //=========================================================================================================
+    /**
+     * Emit this signal whenever the interpolation cache directory changed.
+     *
+     * @param[in] sCacheDir             The new cache directory.
+     */
+    void interpolationCacheDirectoryChanged(const QString &sCacheDir);
+
     //=========================================================================================================
     /**
      * Emit this signal whenever the thresholds changed.
@@ -66,6 +66,12 @@ using namespace Eigen;
 using namespace DISPLIB;
 using namespace FIFFLIB;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+const int COLORMAP_LUT_SIZE = 4096;     /**< Number of entries of the colormap lookup tables. Fine enough to stay within one 8-bit color step of the steepest colormap ramp. */
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -77,11 +83,16 @@ RtSourceDataWorker::RtSourceDataWorker()
 , m_bStreamSmoothedData(true)
 , m_iCurrentSample(0)
 , m_iSampleCtr(0)
+, m_iBatchSize(10)
+, m_iBatchFrame(0)
+, m_iNumBatchFrames(0)
 {
     VisualizationInfo leftHemiInfo;
     VisualizationInfo rightHemiInfo;
     leftHemiInfo.pMatInterpolationMatrix = QSharedPointer<SparseMatrix<float> >(new SparseMatrix<float>());
     rightHemiInfo.pMatInterpolationMatrix = QSharedPointer<SparseMatrix<float> >(new SparseMatrix<float>());
+    leftHemiInfo.matColormapLut = createColormapLut(leftHemiInfo.sColormapType, leftHemiInfo.functionHandlerColorMap);
+    rightHemiInfo.matColormapLut = leftHemiInfo.matColormapLut;
     m_lHemiVisualizationInfo << leftHemiInfo << rightHemiInfo;
 }
 
@@ -121,6 +132,7 @@ void RtSourceDataWorker::setSurfaceColor(const MatrixX4f &matColorLeft,
 void RtSourceDataWorker::setNumberAverages(int iNumAvr)
 {
     m_iAverageSamples = iNumAvr;
+    m_iNumBatchFrames = 0;
 }
 
 //=============================================================================================================
@@ -128,6 +140,7 @@ void RtSourceDataWorker::setNumberAverages(int iNumAvr)
 void RtSourceDataWorker::setStreamSmoothedData(bool bStreamSmoothedData)
 {
     m_bStreamSmoothedData = bStreamSmoothedData;
+    m_iNumBatchFrames = 0;
 }
 
 //=============================================================================================================
@@ -137,6 +150,10 @@ void RtSourceDataWorker::setColormapType(const QString& sColormapType)
     //Create function handler to corresponding color map function
     m_lHemiVisualizationInfo[0].sColormapType = sColormapType;
     m_lHemiVisualizationInfo[1].sColormapType = sColormapType;
+
+    //Sample the colormap once, so the per frame colormapping is a table lookup
+    m_lHemiVisualizationInfo[0].matColormapLut = createColormapLut(sColormapType, m_lHemiVisualizationInfo[0].functionHandlerColorMap);
+    m_lHemiVisualizationInfo[1].matColormapLut = m_lHemiVisualizationInfo[0].matColormapLut;
 }
 
 //=============================================================================================================
@@ -168,6 +185,7 @@ void RtSourceDataWorker::setSFreq(const double dSFreq)
 void RtSourceDataWorker::setInterpolationMatrixLeft(QSharedPointer<Eigen::SparseMatrix<float> > pMatInterpolationMatrixLeft)
 {
     m_lHemiVisualizationInfo[0].pMatInterpolationMatrix = pMatInterpolationMatrixLeft;
+    m_iNumBatchFrames = 0;
 }
 
 //=============================================================================================================
@@ -175,6 +193,7 @@ void RtSourceDataWorker::setInterpolationMatrixLeft(QSharedPointer<Eigen::Sparse
 void RtSourceDataWorker::setInterpolationMatrixRight(QSharedPointer<Eigen::SparseMatrix<float> > pMatInterpolationMatrixRight)
 {
     m_lHemiVisualizationInfo[1].pMatInterpolationMatrix = pMatInterpolationMatrixRight;
+    m_iNumBatchFrames = 0;
 }
 
 //=============================================================================================================
@@ -185,114 +204,228 @@ void RtSourceDataWorker::streamData()
 //    qint64 iTime = 0;
 //    timer.start();
 
-    if(m_iAverageSamples != 0 && !m_lDataLoopQ.isEmpty()) {
-        int iSampleCtr = 0;
-
-        //Perform the actual interpolation and send signal
-        while((iSampleCtr <= m_iAverageSamples)) {
-            if(m_lDataQ.isEmpty()) {
-                if(m_bIsLooping && !m_lDataLoopQ.isEmpty()) {
-                    if(m_vecAverage.rows() != m_lDataLoopQ.front().rows()) {
-                        m_vecAverage = m_lDataLoopQ.front();
-                        m_iCurrentSample++;
-                        iSampleCtr++;
-                    } else if (m_iCurrentSample < m_lDataLoopQ.size()){
-                        m_vecAverage += m_lDataLoopQ.at(m_iCurrentSample);
-                        m_iCurrentSample++;
-                        iSampleCtr++;
-                    }
-
-                    //Set iterator back to the front if needed
-                    if(m_iCurrentSample >= m_lDataLoopQ.size()) {
-                        m_iCurrentSample = 0;
-                        break;
-                    }
-                } else {
-                    return;
-                }
-            } else {
-                if(m_vecAverage.rows() != m_lDataQ.front().rows()) {
-                    m_vecAverage = m_lDataQ.takeFirst();
+    if(m_iAverageSamples == 0 || m_lDataLoopQ.isEmpty()) {
+        return;
+    }
+
+    RtSourceDataFrame& frame = m_frameBuffer.writeBuffer();
+
+    if(m_bStreamSmoothedData) {
+        //Interpolate the next batch once all frames of the current one were streamed
+        if(m_iBatchFrame >= m_iNumBatchFrames && !interpolateNextBatch()) {
+            return;
+        }
+
+        const int iFrame = m_iBatchFrame++;
+
+        //Do the colormapping for both hemispheres in parallel
+        QFuture<void> result = QtConcurrent::map(m_lHemiVisualizationInfo,
+                                                 [iFrame](VisualizationInfo& visualizationInfoHemi) {
+            generateColorsFromInterpolatedValues(visualizationInfoHemi, iFrame);
+        });
+        result.waitForFinished();
+
+        //Swap instead of copy. The color matrices we get back from the frame are overwritten next time, so their memory is reused.
+        frame.matColorMatrixLeftHemi.swap(m_lHemiVisualizationInfo[0].matFinalVertColor);
+        frame.matColorMatrixRightHemi.swap(m_lHemiVisualizationInfo[1].matFinalVertColor);
+        frame.bSmoothed = true;
+    } else {
+        if(!averageNextFrame()) {
+            return;
+        }
+
+        const int iNumSourcesLeft = m_lHemiVisualizationInfo[0].pMatInterpolationMatrix->cols();
+        const int iNumSourcesRight = m_lHemiVisualizationInfo[1].pMatInterpolationMatrix->cols();
+
+        if(iNumSourcesLeft == 0 || iNumSourcesRight == 0) {
+            return;
+        }
+
+        m_vecAverage /= (double)m_iAverageSamples;
+
+        frame.vecDataVectorLeftHemi = m_vecAverage.segment(0, iNumSourcesLeft);
+        frame.vecDataVectorRightHemi = m_vecAverage.segment(iNumSourcesLeft, iNumSourcesRight);
+        frame.bSmoothed = false;
+
+        m_vecAverage.setZero(m_vecAverage.rows());
+    }
+
+    //If the previous frame was not picked up yet, its notification is still pending and will deliver this frame instead
+    if(!m_frameBuffer.publish()) {
+        emit newRtDataAvailable();
+    }
+
+//iTime = timer.elapsed();
+//qWarning() << "RtSourceDataWorker::streamData iTime" << iTime;
+//timer.restart();
+}
+
+//=============================================================================================================
+
+bool RtSourceDataWorker::averageNextFrame()
+{
+    int iSampleCtr = 0;
+
+    //Sum up the samples of the next frame
+    while((iSampleCtr <= m_iAverageSamples)) {
+        if(m_lDataQ.isEmpty()) {
+            if(m_bIsLooping && !m_lDataLoopQ.isEmpty()) {
+                if(m_vecAverage.rows() != m_lDataLoopQ.front().rows()) {
+                    m_vecAverage = m_lDataLoopQ.front();
                     m_iCurrentSample++;
                     iSampleCtr++;
-                } else {
-                    m_vecAverage += m_lDataQ.takeFirst();
+                } else if (m_iCurrentSample < m_lDataLoopQ.size()){
+                    m_vecAverage += m_lDataLoopQ.at(m_iCurrentSample);
                     m_iCurrentSample++;
                     iSampleCtr++;
                 }
 
                 //Set iterator back to the front if needed
-                if(m_iCurrentSample >= m_lDataQ.size()) {
+                if(m_iCurrentSample >= m_lDataLoopQ.size()) {
                     m_iCurrentSample = 0;
                     break;
                 }
+            } else {
+                return false;
+            }
+        } else {
+            if(m_vecAverage.rows() != m_lDataQ.front().rows()) {
+                m_vecAverage = m_lDataQ.takeFirst();
+                m_iCurrentSample++;
+                iSampleCtr++;
+            } else {
+                m_vecAverage += m_lDataQ.takeFirst();
+                m_iCurrentSample++;
+                iSampleCtr++;
+            }
+
+            //Set iterator back to the front if needed
+            if(m_iCurrentSample >= m_lDataQ.size()) {
+                m_iCurrentSample = 0;
+                break;
             }
         }
+    }
 
-        if(m_lHemiVisualizationInfo[0].pMatInterpolationMatrix->cols() != 0
-           && m_lHemiVisualizationInfo[1].pMatInterpolationMatrix->cols() != 0) {
-            //Perform the actual interpolation and send signal
-            m_vecAverage /= (double)m_iAverageSamples;
+    return true;
+}
 
-            if(m_bStreamSmoothedData) {
-                m_lHemiVisualizationInfo[0].vecSensorValues = m_vecAverage.segment(0, m_lHemiVisualizationInfo[0].pMatInterpolationMatrix->cols());
-                m_lHemiVisualizationInfo[1].vecSensorValues = m_vecAverage.segment(m_lHemiVisualizationInfo[0].pMatInterpolationMatrix->cols(), m_lHemiVisualizationInfo[1].pMatInterpolationMatrix->cols());
+//=============================================================================================================
 
-                //Do calculations for both hemispheres in parallel
-                QFuture<void> result = QtConcurrent::map(m_lHemiVisualizationInfo,
-                                                         generateColorsFromSensorValues);
-                result.waitForFinished();
+bool RtSourceDataWorker::interpolateNextBatch()
+{
+    if(!averageNextFrame()) {
+        return false;
+    }
 
-                emit newRtSmoothedData(m_lHemiVisualizationInfo[0].matFinalVertColor,
-                                       m_lHemiVisualizationInfo[1].matFinalVertColor);
-            } else {
-                emit newRtRawData(m_vecAverage.segment(0, m_lHemiVisualizationInfo[0].pMatInterpolationMatrix->cols()),
-                                  m_vecAverage.segment(m_lHemiVisualizationInfo[0].pMatInterpolationMatrix->cols(), m_lHemiVisualizationInfo[1].pMatInterpolationMatrix->cols()));
-            }
-            m_vecAverage.setZero(m_vecAverage.rows());
-        }
+    const int iNumSourcesLeft = m_lHemiVisualizationInfo[0].pMatInterpolationMatrix->cols();
+    const int iNumSourcesRight = m_lHemiVisualizationInfo[1].pMatInterpolationMatrix->cols();
+
+    if(iNumSourcesLeft == 0 || iNumSourcesRight == 0) {
+        return false;
     }
 
-//iTime = timer.elapsed();
-//qWarning() << "RtSourceDataWorker::streamData iTime" << iTime;
-//timer.restart();
+    //Average the upcoming frames as well, as far as their data is already queued. The loop buffer always delivers
+    //a frame, so it only ever contributes the first one and the batch does not run ahead of the incoming data.
+    MatrixXd matAverages(m_vecAverage.rows(), m_iBatchSize);
+    int iNumFrames = 0;
+
+    do {
+        matAverages.col(iNumFrames++) = m_vecAverage / (double)m_iAverageSamples;
+        m_vecAverage.setZero(m_vecAverage.rows());
+    } while(iNumFrames < m_iBatchSize
+            && m_lDataQ.size() > m_iAverageSamples
+            && averageNextFrame()
+            && m_vecAverage.rows() == matAverages.rows());
 
-    //qDebug()<<"RtSourceDataWorker::streamData - this->thread() "<< this->thread();
-    //qDebug()<<"RtSourceDataWorker::streamData - time.elapsed()" << time.elapsed();
+    m_lHemiVisualizationInfo[0].matSensorValues = matAverages.block(0, 0, iNumSourcesLeft, iNumFrames).cast<float>();
+    m_lHemiVisualizationInfo[1].matSensorValues = matAverages.block(iNumSourcesLeft, 0, iNumSourcesRight, iNumFrames).cast<float>();
+
+    //Do the interpolation for both hemispheres in parallel
+    QFuture<void> result = QtConcurrent::map(m_lHemiVisualizationInfo,
+                                             interpolateSensorValues);
+    result.waitForFinished();
+
+    m_iBatchFrame = 0;
+    m_iNumBatchFrames = iNumFrames;
+
+    return true;
 }
 
 //=============================================================================================================
 
-void RtSourceDataWorker::generateColorsFromSensorValues(VisualizationInfo &visualizationInfoHemi)
+bool RtSourceDataWorker::acquireLatestFrame()
 {
-    if(visualizationInfoHemi.vecSensorValues.rows() != visualizationInfoHemi.pMatInterpolationMatrix->cols()) {
-        qDebug() << "RtSourceDataWorker::generateColorsFromSensorValues - Number of new vertex colors (" << visualizationInfoHemi.vecSensorValues.rows() << ") do not match with previously set number of sensors (" << visualizationInfoHemi.pMatInterpolationMatrix->cols() << "). Returning...";
+    return m_frameBuffer.update();
+}
+
+//=============================================================================================================
+
+const RtSourceDataFrame& RtSourceDataWorker::getCurrentFrame() const
+{
+    return m_frameBuffer.readBuffer();
+}
+
+//=============================================================================================================
+
+void RtSourceDataWorker::interpolateSensorValues(VisualizationInfo &visualizationInfoHemi)
+{
+    if(visualizationInfoHemi.matSensorValues.rows() != visualizationInfoHemi.pMatInterpolationMatrix->cols()) {
+        qDebug() << "RtSourceDataWorker::interpolateSensorValues - Number of new vertex colors (" << visualizationInfoHemi.matSensorValues.rows() << ") do not match with previously set number of sensors (" << visualizationInfoHemi.pMatInterpolationMatrix->cols() << "). Returning...";
+        visualizationInfoHemi.matInterpolatedValues.resize(0, 0);
         return;
     }
 
-    // interpolate sensor signals
-    VectorXf vecIntrpltdVals = Interpolation::interpolateSignal(*visualizationInfoHemi.pMatInterpolationMatrix, visualizationInfoHemi.vecSensorValues.cast<float>());
+    // interpolate sensor signals of all frames at once
+    visualizationInfoHemi.matInterpolatedValues = Interpolation::interpolateSignals(*visualizationInfoHemi.pMatInterpolationMatrix, visualizationInfoHemi.matSensorValues);
+}
+
+//=============================================================================================================
+
+void RtSourceDataWorker::generateColorsFromInterpolatedValues(VisualizationInfo &visualizationInfoHemi,
+                                                              int iFrame)
+{
+    if(iFrame >= visualizationInfoHemi.matInterpolatedValues.cols()) {
+        return;
+    }
 
     // Reset to original color as default
     visualizationInfoHemi.matFinalVertColor = visualizationInfoHemi.matOriginalVertColor;
 
     //Generate color data for vertices
-    normalizeAndTransformToColor(vecIntrpltdVals,
+    normalizeAndTransformToColor(visualizationInfoHemi.matInterpolatedValues.col(iFrame),
                                  visualizationInfoHemi.matFinalVertColor,
                                  visualizationInfoHemi.dThresholdX,
                                  visualizationInfoHemi.dThresholdZ,
-                                 visualizationInfoHemi.functionHandlerColorMap,
-                                 visualizationInfoHemi.sColormapType);
+                                 visualizationInfoHemi.matColormapLut);
+}
+
+//=============================================================================================================
+
+MatrixX4f RtSourceDataWorker::createColormapLut(const QString& sColorMap,
+                                                QRgb (*functionHandlerColorMap)(double v, const QString& sColorMap))
+{
+    MatrixX4f matColormapLut(COLORMAP_LUT_SIZE, 4);
+
+    for(int i = 0; i < COLORMAP_LUT_SIZE; ++i) {
+        QColor color(functionHandlerColorMap((double)i / (COLORMAP_LUT_SIZE - 1), sColorMap));
+
+        matColormapLut(i,0) = color.redF();
+        matColormapLut(i,1) = color.greenF();
+        matColormapLut(i,2) = color.blueF();
+        matColormapLut(i,3) = color.alphaF();
+    }
+
+    return matColormapLut;
 }
 
 //=============================================================================================================
 
-void RtSourceDataWorker::normalizeAndTransformToColor(const VectorXf& vecData,
+void RtSourceDataWorker::normalizeAndTransformToColor(const Ref<const VectorXf>& vecData,
                                                       MatrixX4f& matFinalVertColor,
                                                       double dThresholdX,
                                                       double dThresholdZ,
-                                                      QRgb (*functionHandlerColorMap)(double v, const QString& sColorMap),
-                                                      const QString& sColorMap)
+                                                      const MatrixX4f& matColormapLut)
 {
     //Note: This function needs to be implemented extremly efficient.
     if(vecData.rows() != matFinalVertColor.rows()) {
@@ -300,45 +433,27 @@ void RtSourceDataWorker::normalizeAndTransformToColor(const VectorXf& vecData,
         return;
     }
 
-    float fSample;
-    QRgb qRgb;
-    const double dTresholdDiff = dThresholdZ - dThresholdX;
-
-    for(int r = 0; r < vecData.rows(); ++r) {
-        //Take the absolute values because the histogram threshold is also calcualted using the absolute values
-        fSample = std::fabs(vecData(r));
-
-        if(fSample >= dThresholdX) {
-            //Check lower and upper thresholds and normalize to one
-            if(fSample >= dThresholdZ) {
-                fSample = 1.0f;
-            } else {
-                if(fSample != 0.0f && dTresholdDiff != 0.0 ) {
-                    fSample = (fSample - dThresholdX) / (dTresholdDiff);
-                } else {
-                    fSample = 0.0f;
-                }
-            }
-
-            qRgb = functionHandlerColorMap(fSample, sColorMap);
+    if(matColormapLut.rows() == 0) {
+        return;
+    }
 
-            QColor color(qRgb);
-//            QColor color (matFinalVertColor(r,0) * 255 * (1.0-0.60) + (float)qRed(qRgb)*0.60,
-//                          matFinalVertColor(r,1) * 255 * (1.0-0.60) + (float)qGreen(qRgb)*0.60,
-//                          matFinalVertColor(r,2) * 255 * (1.0-0.60) + (float)qBlue(qRgb)*0.60,
-//                          255.0 + 0.75 * (255.0-255.0));
+    const float fThresholdX = dThresholdX;
+    const float fMaxLutIdx = matColormapLut.rows() - 1;
 
-            //qDebug() << "RtSourceDataWorker::normalizeAndTransformToColor color" << color;
+    //Normalize to lookup table indices. Values at or above the upper threshold map to the last entry.
+    //If the thresholds collapse every value at or above the lower threshold is at the upper threshold as well.
+    const bool bValidRange = dThresholdZ > dThresholdX;
+    const float fScale = bValidRange ? fMaxLutIdx / (float)(dThresholdZ - dThresholdX) : 0.0f;
+    const float fOffset = bValidRange ? 0.5f : fMaxLutIdx;
 
-            matFinalVertColor(r,0) = color.redF();
-            matFinalVertColor(r,1) = color.greenF();
-            matFinalVertColor(r,2) = color.blueF();
-            matFinalVertColor(r,3) = color.alphaF();
+    //These are packet-wise float operations, which Eigen vectorizes with SIMD instructions.
+    //Take the absolute values because the histogram threshold is also calcualted using the absolute values
+    const ArrayXf arrAbsData = vecData.array().abs();
+    const ArrayXi arrLutIdx = ((arrAbsData - fThresholdX) * fScale + fOffset).max(0.0f).min(fMaxLutIdx).cast<int>();
 
-//            matFinalVertColor(r,0) = (float)qRed(qRgb)/255.0f;
-//            matFinalVertColor(r,1) = (float)qGreen(qRgb)/255.0f;
-//            matFinalVertColor(r,2) = (float)qBlue(qRgb)/255.0f;
-//            matFinalVertColor(r,3) = 1.0f;
+    for(int r = 0; r < vecData.rows(); ++r) {
+        if(arrAbsData(r) >= fThresholdX) {
+            matFinalVertColor.row(r) = matColormapLut.row(arrLutIdx(r));
         } else {
             matFinalVertColor(r,3) = 0.0f; //Use this if you want only vertices with activation to be plotted
         }
@@ -43,6 +43,8 @@
 
 #include <disp/plots/helpers/colormap.h>
 
+#include <utils/generics/triplebuffer.h>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -72,7 +74,9 @@ struct VisualizationInfo {
     double                      dThresholdX;
     double                      dThresholdZ;
 
-    Eigen::VectorXd             vecSensorValues;
+    Eigen::MatrixXf             matSensorValues;            /**< The sensor values of the current batch, one column per frame. */
+    Eigen::MatrixXf             matInterpolatedValues;      /**< The interpolated values of the current batch, one column per frame. */
+    Eigen::MatrixX4f            matColormapLut;             /**< The RGBA lookup table of the colormap, sampled equidistantly in [0,1]. */
     Eigen::MatrixX4f            matOriginalVertColor;
     Eigen::MatrixX4f            matFinalVertColor;
 
@@ -82,6 +86,14 @@ struct VisualizationInfo {
     QRgb (*functionHandlerColorMap)(double v, const QString& sColorMap) = DISPLIB::ColorMap::valueToColor;
 }; /**< The struct specifing visualization info. */
 
+struct RtSourceDataFrame {
+    bool                        bSmoothed = false;          /**< Whether this frame holds smoothed color data or raw data. */
+    Eigen::MatrixX4f            matColorMatrixLeftHemi;     /**< The interpolated RGBA colors per vertex for the left hemisphere. */
+    Eigen::MatrixX4f            matColorMatrixRightHemi;    /**< The interpolated RGBA colors per vertex for the right hemisphere. */
+    Eigen::VectorXd             vecDataVectorLeftHemi;      /**< The raw data for the left hemisphere. */
+    Eigen::VectorXd             vecDataVectorRightHemi;     /**< The raw data for the right hemisphere. */
+}; /**< The struct specifing one streamed frame. */
+
 struct ColorComputationInfo {
     double                      dThresholdX;
     double                      dThresholdZ;
@@ -210,32 +222,87 @@ public:
      */
     void streamData();
 
+    //=========================================================================================================
+    /**
+     * Picks up the most recently streamed frame. Frames which were streamed in between are skipped. Must only
+     * be called from a single consumer thread.
+     *
+     * @return True if a new frame was picked up, false if there was no new frame since the last call.
+     */
+    bool acquireLatestFrame();
+
+    //=========================================================================================================
+    /**
+     * Returns the frame picked up by the last call to acquireLatestFrame. The frame stays valid until the next
+     * call to acquireLatestFrame.
+     *
+     * @return The current frame.
+     */
+    const RtSourceDataFrame& getCurrentFrame() const;
+
 protected:
     //=========================================================================================================
     /**
-     * @brief normalizeAndTransformToColor  This method normalizes final values for all vertices of the mesh and converts them to rgb using the specified color converter
+     * Averages the next frame into m_vecAverage. The sum still needs to be divided by the number of averages.
+     *
+     * @return True if a frame was completed, false if there is not enough data yet.
+     */
+    bool averageNextFrame();
+
+    //=========================================================================================================
+    /**
+     * Averages the next frames and interpolates them batch-wise. The interpolation matrix is only traversed once
+     * per batch and hemisphere instead of once per frame.
+     *
+     * @return True if a new batch is available, false if there is not enough data or no interpolation matrix yet.
+     */
+    bool interpolateNextBatch();
+
+    //=========================================================================================================
+    /**
+     * @brief createColormapLut  This method samples a color map into a lookup table
+     *
+     * @param[in] sColorMap                     The color map to use
+     * @param[in] functionHandlerColorMap       The pointer to the function which converts scalar values to rgb
+     *
+     * @return The RGBA lookup table
+     */
+    static Eigen::MatrixX4f createColormapLut(const QString& sColorMap,
+                                              QRgb (*functionHandlerColorMap)(double v, const QString& sColorMap));
+
+    //=========================================================================================================
+    /**
+     * @brief normalizeAndTransformToColor  This method normalizes final values for all vertices of the mesh and converts them to rgb using the colormap lookup table
      *
      * @param[in] vecData                       The final values for each vertex of the surface
      * @param[in,out] matFinalVertColor         The color matrix which the results are to be written to
      * @param[in] dThresholdX                   Lower threshold for normalizing
      * @param[in] dThresholdZ                   Upper threshold for normalizing
-     * @param[in] functionHandlerColorMap       The pointer to the function which converts scalar values to rgb
-     * @param[in] sColorMap                     The color map to use
+     * @param[in] matColormapLut                The RGBA lookup table of the color map to use
      */
-    static void normalizeAndTransformToColor(const Eigen::VectorXf& vecData,
+    static void normalizeAndTransformToColor(const Eigen::Ref<const Eigen::VectorXf>& vecData,
                                              Eigen::MatrixX4f &matFinalVertColor,
                                              double dThresholdX,
                                              double dThresholdZ,
-                                             QRgb (*functionHandlerColorMap)(double v, const QString& sColorMap),
-                                             const QString& sColorMap);
+                                             const Eigen::MatrixX4f& matColormapLut);
+
+    //=========================================================================================================
+    /**
+     * @brief interpolateSensorValues            Interpolates all frames of the current batch
+     *
+     * @param[in/out] visualizationInfoHemi      The needed visualization info
+     */
+    static void interpolateSensorValues(VisualizationInfo &visualizationInfoHemi);
 
     //=========================================================================================================
     /**
-     * @brief generateColorsFromSensorValues     Produces the final color matrix that is to be emitted
+     * @brief generateColorsFromInterpolatedValues     Produces the final color matrix that is to be emitted
      *
      * @param[in/out] visualizationInfoHemi      The needed visualization info
+     * @param[in] iFrame                         The frame of the current batch
      */
-    static void generateColorsFromSensorValues(VisualizationInfo &visualizationInfoHemi);
+    static void generateColorsFromInterpolatedValues(VisualizationInfo &visualizationInfoHemi,
+                                                     int iFrame);
 
     QList<Eigen::VectorXd>                              m_lDataQ;                           /**< List that holds the matrix data <n_channels x n_samples>. */
     QList<Eigen::VectorXd>                              m_lDataLoopQ;                       /**< List that holds the matrix data <n_channels x n_samples> for looping. */
@@ -247,31 +314,24 @@ protected:
     int                                                 m_iCurrentSample;                   /**< Iterator to current sample which is/was streamed. */
     int                                                 m_iAverageSamples;                  /**< Number of average to compute. */
     int                                                 m_iSampleCtr;                       /**< The sample counter. */
+    int                                                 m_iBatchSize;                       /**< The maximum number of frames which are interpolated at once. */
+    int                                                 m_iBatchFrame;                      /**< The next frame of the current batch to be streamed. */
+    int                                                 m_iNumBatchFrames;                  /**< The number of frames in the current batch. */
 
     double                                              m_dSFreq;                           /**< The current sampling frequency. */
 
     QList<VisualizationInfo>                            m_lHemiVisualizationInfo;           /**< The visualization info for each hemisphere. */
 
-signals:
-    //=========================================================================================================
-    /**
-     * Emit this signal whenever this item should stream new raw data to its listeners.
-     *
-     * @param[in] vecDataVectorLeftHemi          The new streamed raw data for the left hemispehre.
-     * @param[in] vecDataVectorRightHemi         The new streamed raw data for the right hemispehre.
-     */
-    void newRtRawData(const Eigen::VectorXd &vecDataVectorLeftHemi,
-                      const Eigen::VectorXd &vecDataVectorRightHemi);
+    UTILSLIB::TripleBuffer<RtSourceDataFrame>           m_frameBuffer;                      /**< Latest-wins hand-off of the streamed frames to the consumer. */
 
+signals:
     //=========================================================================================================
     /**
-     * Emit this signal whenever this item should stream interpolated raw data to its listeners.
-     *
-     * @param[in] matColorMatrixLeftHemi          The new streamed interpolated raw data in form of RGB colors per vertex for the left hemisphere.
-     * @param[in] matColorMatrixRightHemi         The new streamed interpolated raw data in form of RGB colors per vertex for the right hemisphere.
+     * Emit this signal whenever a new frame was streamed and no earlier notification is still pending. Call
+     * acquireLatestFrame to pick up the frame. At most one notification is in flight at any time, so slow
+     * listeners do not cause stale frames to queue up.
      */
-    void newRtSmoothedData(const Eigen::MatrixX4f &matColorMatrixLeftHemi,
-                           const Eigen::MatrixX4f &matColorMatrixRightHemi);
+    void newRtDataAvailable();
 };
 } // NAMESPACE
 
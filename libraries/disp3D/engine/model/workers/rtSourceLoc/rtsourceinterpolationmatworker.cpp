@@ -47,6 +47,8 @@
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QBuffer>
+
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
@@ -59,6 +61,7 @@ using namespace DISP3DLIB;
 using namespace MNELIB;
 using namespace Eigen;
 using namespace FSLIB;
+using namespace UTILSLIB;
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -68,11 +71,13 @@ RtSourceInterpolationMatWorker::RtSourceInterpolationMatWorker()
 : m_bInterpolationInfoIsInit(false)
 , m_iVisualizationType(Data3DTreeModelItemRoles::InterpolationBased)
 , m_bAnnotationInfoIsInit(false)
+, m_cache(FileCache::defaultDirectory("interpolation"), "interp")
 , m_pMatInterpolationMat(QSharedPointer<SparseMatrix<float> >(new SparseMatrix<float>()))
 , m_pMatAnnotationMat(QSharedPointer<SparseMatrix<float> >(new SparseMatrix<float>()))
 {
     m_lInterpolationData.dCancelDistance = 0.05;
     m_lInterpolationData.interpolationFunction = DISP3DLIB::Interpolation::cubic;
+    m_lInterpolationData.sInterpolationFunction = QStringLiteral("Cubic");
     m_lInterpolationData.matDistanceMatrix = QSharedPointer<MatrixXd>(new MatrixXd());
 }
 
@@ -87,23 +92,24 @@ void RtSourceInterpolationMatWorker::setInterpolationFunction(const QString &sIn
 
     if(sInterpolationFunction == QStringLiteral("Linear")) {
         m_lInterpolationData.interpolationFunction = Interpolation::linear;
+        m_lInterpolationData.sInterpolationFunction = sInterpolationFunction;
     }
     else if(sInterpolationFunction == QStringLiteral("Square")) {
         m_lInterpolationData.interpolationFunction = Interpolation::square;
+        m_lInterpolationData.sInterpolationFunction = sInterpolationFunction;
     }
     else if(sInterpolationFunction == QStringLiteral("Cubic")) {
         m_lInterpolationData.interpolationFunction = Interpolation::cubic;
+        m_lInterpolationData.sInterpolationFunction = sInterpolationFunction;
     }
     else if(sInterpolationFunction == QStringLiteral("Gaussian")) {
         m_lInterpolationData.interpolationFunction = Interpolation::gaussian;
+        m_lInterpolationData.sInterpolationFunction = sInterpolationFunction;
     }
 
     if(m_bInterpolationInfoIsInit == true){
-        //recalculate Interpolation matrix parameters changed
-        m_pMatInterpolationMat = Interpolation::createInterpolationMat(m_lInterpolationData.vecMappedSubset,
-                                                                       m_lInterpolationData.matDistanceMatrix,
-                                                                       m_lInterpolationData.interpolationFunction,
-                                                                       m_lInterpolationData.dCancelDistance);
+        //recalculate Interpolation matrix parameters changed, the distance table stays valid
+        calculateInterpolationOperator();
 
         emitMatrix();
     }
@@ -130,6 +136,7 @@ void RtSourceInterpolationMatWorker::setCancelDistance(double dCancelDist)
     }
 
     m_lInterpolationData.dCancelDistance = dCancelDist;
+    m_lInterpolationData.matDistanceMatrix = QSharedPointer<MatrixXd>(new MatrixXd());
 
     //recalculate everything because parameters changed
     calculateInterpolationOperator();
@@ -152,6 +159,7 @@ void RtSourceInterpolationMatWorker::setInterpolationInfo(const Eigen::MatrixX3f
     m_lInterpolationData.matVertices = matVertices;
     m_lInterpolationData.vecNeighborVertices = vecNeighborVertices;
     m_lInterpolationData.vecMappedSubset = vecMappedSubset;
+    m_lInterpolationData.matDistanceMatrix = QSharedPointer<MatrixXd>(new MatrixXd());
 
     m_bInterpolationInfoIsInit = true;
 
@@ -193,6 +201,13 @@ void RtSourceInterpolationMatWorker::setAnnotationInfo(const Eigen::VectorXi &ve
 
 //=============================================================================================================
 
+void RtSourceInterpolationMatWorker::setCacheDirectory(const QString &sCacheDir)
+{
+    m_cache.setDirectory(sCacheDir);
+}
+
+//=============================================================================================================
+
 void RtSourceInterpolationMatWorker::calculateInterpolationOperator()
 {
     if(!m_bInterpolationInfoIsInit) {
@@ -200,18 +215,49 @@ void RtSourceInterpolationMatWorker::calculateInterpolationOperator()
         return;
     }
 
-    //SCDC with cancel distance
-    m_lInterpolationData.matDistanceMatrix = GeometryInfo::scdc(m_lInterpolationData.matVertices,
-                                                                m_lInterpolationData.vecNeighborVertices,
-                                                                m_lInterpolationData.vecMappedSubset,
-                                                                m_lInterpolationData.dCancelDistance);
+    //Try to load a previously calculated matrix
+    QString sCacheKey = m_cache.isEnabled() ? getCacheKey() : QString();
+    QByteArray baCached;
+
+    if(!sCacheKey.isEmpty() && m_cache.read(sCacheKey, baCached)) {
+        QBuffer buffer(&baCached);
+        buffer.open(QIODevice::ReadOnly);
+        QSharedPointer<SparseMatrix<float> > pMatInterpolationMat = Interpolation::readInterpolationMat(buffer);
+
+        if(pMatInterpolationMat
+           && pMatInterpolationMat->rows() == m_lInterpolationData.matVertices.rows()
+           && pMatInterpolationMat->cols() == m_lInterpolationData.vecMappedSubset.size()) {
+            m_pMatInterpolationMat = pMatInterpolationMat;
+            return;
+        }
+
+        qDebug() << "RtSourceInterpolationMatWorker::calculateInterpolationOperator - Ignoring invalid cache file" << m_cache.getFileName(sCacheKey);
+    }
+
+    //SCDC with cancel distance. The distance table does not depend on the interpolation function, so only calculate it if the geometry or cancel distance changed.
+    if(m_lInterpolationData.matDistanceMatrix->size() == 0) {
+        m_lInterpolationData.matDistanceMatrix = GeometryInfo::scdc(m_lInterpolationData.matVertices,
+                                                                    m_lInterpolationData.vecNeighborVertices,
+                                                                    m_lInterpolationData.vecMappedSubset,
+                                                                    m_lInterpolationData.dCancelDistance);
+    }
 
     //create Interpolation matrix
     m_pMatInterpolationMat = Interpolation::createInterpolationMat(m_lInterpolationData.vecMappedSubset,
                                                                    m_lInterpolationData.matDistanceMatrix,
                                                                    m_lInterpolationData.interpolationFunction,
                                                                    m_lInterpolationData.dCancelDistance);
+
+    if(!sCacheKey.isEmpty()) {
+        baCached.clear();
+        QBuffer buffer(&baCached);
+        buffer.open(QIODevice::WriteOnly);
+
+        if(Interpolation::writeInterpolationMat(buffer, *m_pMatInterpolationMat)) {
+            m_cache.write(sCacheKey, baCached);
+        }
     }
+}
 
 //=============================================================================================================
 
@@ -274,3 +320,22 @@ void RtSourceInterpolationMatWorker::emitMatrix()
             break;
     }
 }
+
+//=============================================================================================================
+
+QString RtSourceInterpolationMatWorker::getCacheKey() const
+{
+    //The key covers the surface, its neighborhood, the source space and all interpolation parameters
+    FileCacheKey key("RtSourceInterpolationMat v1");
+    key.add(m_lInterpolationData.sInterpolationFunction);
+    key.addValue(m_lInterpolationData.dCancelDistance);
+    key.addMatrix(m_lInterpolationData.matVertices);
+
+    for(const QVector<int>& vecNeighbors : m_lInterpolationData.vecNeighborVertices) {
+        key.addVector(vecNeighbors);
+    }
+
+    key.addVector(m_lInterpolationData.vecMappedSubset);
+
+    return key.result();
+}
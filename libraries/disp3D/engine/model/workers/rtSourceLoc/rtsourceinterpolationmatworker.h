@@ -42,6 +42,7 @@
 #include "../../../../disp3D_global.h"
 
 #include <fs/label.h>
+#include <utils/filecache.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -150,6 +151,16 @@ public:
                            const QList<FSLIB::Label> &lLabels,
                            const Eigen::VectorXi &vecVertNo);
 
+    //=========================================================================================================
+    /**
+     * Sets the directory in which calculated interpolation matrices are cached. The cache is keyed by the
+     * surface, the source space, the cancel distance and the interpolation function, so switching back to a
+     * previously shown subject or source space loads the matrix instead of recalculating it.
+     *
+     * @param[in] sCacheDir         The cache directory. An empty string disables the cache.
+     */
+    void setCacheDirectory(const QString &sCacheDir);
+
 protected:    
     //=========================================================================================================
     /**
@@ -169,6 +180,14 @@ protected:
      */
     void emitMatrix();
 
+    //=========================================================================================================
+    /**
+     * Returns the cache key of the interpolation matrix for the current interpolation data.
+     *
+     * @return The cache key.
+     */
+    QString getCacheKey() const;
+
     //=============================================================================================================
     /**
      * The struct specifing all data that is used in the interpolation process
@@ -187,6 +206,7 @@ protected:
         QVector<QVector<int> >          vecNeighborVertices;            /**< The neighbor vertex information. */
 
         double (*interpolationFunction) (double);                   /**< Function that computes interpolation coefficients using the distance values. */
+        QString                         sInterpolationFunction;         /**< The name of the interpolation function. */
     }                           m_lInterpolationData;               /**< Container for the interpolation data. */
 
     bool                        m_bInterpolationInfoIsInit;         /**< Flag if this thread's interpoaltion data was initialized. */
@@ -194,6 +214,8 @@ protected:
 
     int                         m_iVisualizationType;               /**< The visualization type (smoothing or annotation based). */
 
+    UTILSLIB::FileCache         m_cache;                            /**< The size bounded interpolation matrix cache. Disabled if it has no directory. */
+
     QSharedPointer<Eigen::SparseMatrix<float> >  m_pMatInterpolationMat;              /**< The current itnerpolation matrix (keep this as member so we can easily switch between interpolation and annotation based visualization). */
     QSharedPointer<Eigen::SparseMatrix<float> >  m_pMatAnnotationMat;                 /**< The current itnerpolation matrix (keep this as member so we can easily switch between interpolation and annotation based visualization). */
 
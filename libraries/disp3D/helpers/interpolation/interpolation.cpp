@@ -44,6 +44,8 @@
 
 #include <QSet>
 #include <QDebug>
+#include <QDataStream>
+#include <QIODevice>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -60,6 +62,9 @@ using namespace Eigen;
 // DEFINE GLOBAL METHODS
 //=============================================================================================================
 
+const quint32 INTERPOLATION_FILE_MAGIC = 0x49504d54;    /**< "IPMT" */
+const qint32 INTERPOLATION_FILE_VERSION = 1;
+
 //=============================================================================================================
 // INITIALIZE STATIC MEMBER
 //=============================================================================================================
@@ -167,6 +172,77 @@ VectorXf Interpolation::interpolateSignal(const SparseMatrix<float> &matInterpol
 
 //=============================================================================================================
 
+MatrixXf Interpolation::interpolateSignals(const SparseMatrix<float> &matInterpolationMatrix,
+                                           const MatrixXf &matMeasurementData)
+{
+    if (matInterpolationMatrix.cols() != matMeasurementData.rows()) {
+        qDebug() << "[WARNING] Interpolation::interpolateSignals - Dimension mismatch. Return empty matrix...";
+        return MatrixXf();
+    }
+
+    MatrixXf matOut = matInterpolationMatrix * matMeasurementData;
+
+    return matOut;
+}
+
+//=============================================================================================================
+
+bool Interpolation::writeInterpolationMat(QIODevice &device,
+                                          const SparseMatrix<float> &matInterpolationMatrix)
+{
+    SparseMatrix<float> matInterpolation = matInterpolationMatrix;
+    matInterpolation.makeCompressed();
+
+    QDataStream stream(&device);
+    stream << INTERPOLATION_FILE_MAGIC << INTERPOLATION_FILE_VERSION;
+    stream << static_cast<qint32>(matInterpolation.rows()) << static_cast<qint32>(matInterpolation.cols()) << static_cast<qint32>(matInterpolation.nonZeros());
+    stream.writeRawData(reinterpret_cast<const char*>(matInterpolation.outerIndexPtr()), static_cast<int>((matInterpolation.outerSize() + 1) * sizeof(int)));
+    stream.writeRawData(reinterpret_cast<const char*>(matInterpolation.innerIndexPtr()), static_cast<int>(matInterpolation.nonZeros() * sizeof(int)));
+    stream.writeRawData(reinterpret_cast<const char*>(matInterpolation.valuePtr()), static_cast<int>(matInterpolation.nonZeros() * sizeof(float)));
+
+    return stream.status() == QDataStream::Ok;
+}
+
+//=============================================================================================================
+
+QSharedPointer<SparseMatrix<float> > Interpolation::readInterpolationMat(QIODevice &device)
+{
+    QDataStream stream(&device);
+
+    quint32 magic;
+    qint32 version, rows, cols, nnz;
+    stream >> magic >> version >> rows >> cols >> nnz;
+    if(stream.status() != QDataStream::Ok || magic != INTERPOLATION_FILE_MAGIC || version != INTERPOLATION_FILE_VERSION
+            || rows < 0 || cols < 0 || nnz < 0) {
+        return QSharedPointer<SparseMatrix<float> >();
+    }
+
+    VectorXi vecOuter(cols + 1), vecInner(nnz);
+    VectorXf vecValues(nnz);
+    const int iOuterBytes = static_cast<int>(vecOuter.size() * sizeof(int));
+    const int iInnerBytes = static_cast<int>(vecInner.size() * sizeof(int));
+    const int iValueBytes = static_cast<int>(vecValues.size() * sizeof(float));
+    if(stream.readRawData(reinterpret_cast<char*>(vecOuter.data()), iOuterBytes) != iOuterBytes
+            || stream.readRawData(reinterpret_cast<char*>(vecInner.data()), iInnerBytes) != iInnerBytes
+            || stream.readRawData(reinterpret_cast<char*>(vecValues.data()), iValueBytes) != iValueBytes) {
+        return QSharedPointer<SparseMatrix<float> >();
+    }
+
+    if(vecOuter[0] != 0 || vecOuter[cols] != nnz || (nnz > 0 && (vecInner.minCoeff() < 0 || vecInner.maxCoeff() >= rows))) {
+        return QSharedPointer<SparseMatrix<float> >();
+    }
+
+    for(int i = 0; i < cols; ++i) {
+        if(vecOuter[i + 1] < vecOuter[i]) {
+            return QSharedPointer<SparseMatrix<float> >();
+        }
+    }
+
+    return QSharedPointer<SparseMatrix<float> >(new SparseMatrix<float>(Map<const SparseMatrix<float> >(rows, cols, nnz, vecOuter.data(), vecInner.data(), vecValues.data())));
+}
+
+//=============================================================================================================
+
 double Interpolation::linear(const double dIn)
 {
     return dIn;
@@ -61,6 +61,8 @@
 // FORWARD DECLARATIONS
 //=============================================================================================================
 
+class QIODevice;
+
 //=============================================================================================================
 // DEFINE NAMESPACE DISP3DLIB
 //=============================================================================================================
@@ -151,6 +153,41 @@ public:
     static Eigen::VectorXf interpolateSignal(const Eigen::SparseMatrix<float> &matInterpolationMatrix,
                                              const Eigen::VectorXf &vecMeasurementData);
 
+    //=========================================================================================================
+    /**
+     * Batched version of <i>interpolateSignal</i>. Interpolates several frames with a single sparse matrix * matrix
+     * product, so the weight matrix is only traversed once for the whole batch.
+     *
+     * @param[in] matInterpolationMatrix    The weight matrix which should be used for multiplying
+     * @param[in] matMeasurementData        The measured sensor data, one column per frame
+     *
+     * @return                              Interpolated values for all vertices of the mesh, one column per frame
+     */
+    static Eigen::MatrixXf interpolateSignals(const Eigen::SparseMatrix<float> &matInterpolationMatrix,
+                                              const Eigen::MatrixXf &matMeasurementData);
+
+    //=========================================================================================================
+    /**
+     * Writes a weight matrix in a binary format, e.g., to cache it on disk.
+     *
+     * @param[in] device                    The device to write to
+     * @param[in] matInterpolationMatrix    The weight matrix
+     *
+     * @return                              True if successful
+     */
+    static bool writeInterpolationMat(QIODevice &device,
+                                      const Eigen::SparseMatrix<float> &matInterpolationMatrix);
+
+    //=========================================================================================================
+    /**
+     * Reads a weight matrix which was written by <i>writeInterpolationMat</i>.
+     *
+     * @param[in] device                    The device to read from
+     *
+     * @return                              The weight matrix, a null pointer if the data is invalid
+     */
+    static QSharedPointer<Eigen::SparseMatrix<float> > readInterpolationMat(QIODevice &device);
+
     //=========================================================================================================
     /**
      * Serves as a placeholder for other functions and is needed in case a linear interpolation is wanted when calling <i>createInterplationMat</i>.Returns input argument unchanged.
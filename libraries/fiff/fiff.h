@@ -55,7 +55,9 @@
 #include "fiff_ctf_comp.h"
 #include "fiff_info.h"
 #include "fiff_raw_data.h"
+#include "fiff_raw_data_set.h"
 #include "fiff_raw_dir.h"
+#include "fiff_compressed_buffer.h"
 #include "fiff_stream.h"
 #include "fiff_evoked_set.h"
 
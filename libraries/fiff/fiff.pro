@@ -78,11 +78,14 @@ SOURCES += fiff.cpp \
     fiff_ch_info.cpp \
     fiff_proj.cpp \
     fiff_named_matrix.cpp \
+    fiff_mapped_matrix.cpp \
     fiff_raw_data.cpp \
+    fiff_raw_data_set.cpp \
     fiff_ctf_comp.cpp \
     fiff_id.cpp \
     fiff_info.cpp \
     fiff_raw_dir.cpp \
+    fiff_compressed_buffer.cpp \
     fiff_dig_point.cpp \
     fiff_ch_pos.cpp \
     fiff_cov.cpp \
@@ -111,11 +114,14 @@ HEADERS += fiff.h \
     fiff_ch_info.h \
     fiff_proj.h \
     fiff_named_matrix.h \
+    fiff_mapped_matrix.h \
     fiff_ctf_comp.h \
     fiff_info.h \
     fiff_raw_data.h \
+    fiff_raw_data_set.h \
     fiff_dir_entry.h \
     fiff_raw_dir.h \
+    fiff_compressed_buffer.h \
     fiff_dig_point.h \
     fiff_ch_pos.h \
     fiff_cov.h \
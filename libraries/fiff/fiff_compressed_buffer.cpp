@@ -0,0 +1,248 @@
+//=============================================================================================================
+/**
+ * @file     fiff_compressed_buffer.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FiffCompressedBuffer class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_compressed_buffer.h"
+#include "fiff_file.h"
+
+#include <cstring>
+#include <type_traits>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtEndian>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+namespace
+{
+
+const qint32 COMPRESSED_BUFFER_VERSION = 1;
+
+//=============================================================================================================
+/**
+ * Returns the size of one sample of a supported type in bytes, 0 otherwise.
+ */
+int sampleWidth(fiff_int_t iType)
+{
+    switch(iType) {
+        case FIFFT_DAU_PACK16:
+        case FIFFT_SHORT:
+            return 2;
+        case FIFFT_INT:
+        case FIFFT_FLOAT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+//=============================================================================================================
+/**
+ * Maps a signed difference to an unsigned value with small magnitudes near zero (zigzag coding).
+ */
+template<typename U>
+inline U zigzag(U d)
+{
+    typedef typename std::make_signed<U>::type S;
+    return static_cast<U>(static_cast<U>(d << 1) ^ static_cast<U>(static_cast<S>(d) >> (8*sizeof(U) - 1)));
+}
+
+//=============================================================================================================
+
+template<typename U>
+inline U unzigzag(U z)
+{
+    return static_cast<U>((z >> 1) ^ static_cast<U>(0 - (z & 1)));
+}
+
+//=============================================================================================================
+/**
+ * Replaces every sample by its residual to the previous sample of the same channel and splits the residuals
+ * into sizeof(U) byte planes, least significant byte first.
+ */
+template<typename U>
+void encodePlanes(const char* pData, qint64 nchan, qint64 nsamp, bool bXor, uchar* pPlanes)
+{
+    const qint64 iCount = nchan * nsamp;
+
+    for(qint64 i = 0; i < iCount; ++i) {
+        U value, prev = 0;
+        memcpy(&value, pData + i * sizeof(U), sizeof(U));
+        if(i >= nchan) {
+            memcpy(&prev, pData + (i - nchan) * sizeof(U), sizeof(U));
+        }
+
+        const U residual = bXor ? static_cast<U>(value ^ prev) : zigzag<U>(static_cast<U>(value - prev));
+        for(size_t b = 0; b < sizeof(U); ++b) {
+            pPlanes[b * iCount + i] = static_cast<uchar>(residual >> (8 * b));
+        }
+    }
+}
+
+//=============================================================================================================
+/**
+ * Inverse of encodePlanes.
+ */
+template<typename U>
+void decodePlanes(const uchar* pPlanes, qint64 nchan, qint64 nsamp, bool bXor, char* pData)
+{
+    const qint64 iCount = nchan * nsamp;
+
+    for(qint64 i = 0; i < iCount; ++i) {
+        U residual = 0, prev = 0;
+        for(size_t b = 0; b < sizeof(U); ++b) {
+            residual |= static_cast<U>(static_cast<U>(pPlanes[b * iCount + i]) << (8 * b));
+        }
+        if(i >= nchan) {
+            memcpy(&prev, pData + (i - nchan) * sizeof(U), sizeof(U));
+        }
+
+        const U value = bXor ? static_cast<U>(residual ^ prev) : static_cast<U>(prev + unzigzag<U>(residual));
+        memcpy(pData + i * sizeof(U), &value, sizeof(U));
+    }
+}
+
+} // namespace
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+bool FiffCompressedBuffer::isSupportedType(fiff_int_t iType)
+{
+    return sampleWidth(iType) > 0;
+}
+
+//=============================================================================================================
+
+QByteArray FiffCompressedBuffer::compress(const char* pData,
+                                          fiff_int_t iType,
+                                          qint32 nchan,
+                                          qint32 nsamp,
+                                          int iLevel)
+{
+    const int iWidth = sampleWidth(iType);
+    if(iWidth == 0 || nchan <= 0 || nsamp < 0) {
+        return QByteArray();
+    }
+
+    QByteArray baPlanes(static_cast<qint64>(nchan) * nsamp * iWidth, Qt::Uninitialized);
+    uchar* pPlanes = reinterpret_cast<uchar*>(baPlanes.data());
+    if(iWidth == 2) {
+        encodePlanes<quint16>(pData, nchan, nsamp, false, pPlanes);
+    } else {
+        encodePlanes<quint32>(pData, nchan, nsamp, iType == FIFFT_FLOAT, pPlanes);
+    }
+
+    QByteArray baCompressed = qCompress(baPlanes, iLevel);
+
+    QByteArray baPayload(HEADER_SIZE, Qt::Uninitialized);
+    uchar* pHeader = reinterpret_cast<uchar*>(baPayload.data());
+    qToBigEndian<qint32>(COMPRESSED_BUFFER_VERSION, pHeader);
+    qToBigEndian<qint32>(iType, pHeader + 4);
+    qToBigEndian<qint32>(nchan, pHeader + 8);
+    qToBigEndian<qint32>(nsamp, pHeader + 12);
+    qToBigEndian<qint32>(0, pHeader + 16);   // Flags, reserved
+    baPayload.append(baCompressed);
+
+    return baPayload;
+}
+
+//=============================================================================================================
+
+bool FiffCompressedBuffer::readHeader(const char* pPayload,
+                                      qint64 iSize,
+                                      fiff_int_t& iType,
+                                      qint32& nchan,
+                                      qint32& nsamp)
+{
+    if(iSize < HEADER_SIZE) {
+        return false;
+    }
+
+    const uchar* pHeader = reinterpret_cast<const uchar*>(pPayload);
+    if(qFromBigEndian<qint32>(pHeader) != COMPRESSED_BUFFER_VERSION) {
+        return false;
+    }
+    iType = qFromBigEndian<qint32>(pHeader + 4);
+    nchan = qFromBigEndian<qint32>(pHeader + 8);
+    nsamp = qFromBigEndian<qint32>(pHeader + 12);
+
+    return isSupportedType(iType) && nchan > 0 && nsamp >= 0;
+}
+
+//=============================================================================================================
+
+bool FiffCompressedBuffer::uncompress(const char* pPayload,
+                                      qint64 iSize,
+                                      QByteArray& baData,
+                                      fiff_int_t& iType,
+                                      qint32& nchan,
+                                      qint32& nsamp)
+{
+    if(!readHeader(pPayload, iSize, iType, nchan, nsamp)) {
+        return false;
+    }
+
+    const int iWidth = sampleWidth(iType);
+    const QByteArray baPlanes = qUncompress(reinterpret_cast<const uchar*>(pPayload) + HEADER_SIZE,
+                                            static_cast<int>(iSize - HEADER_SIZE));
+    if(baPlanes.size() != static_cast<qint64>(nchan) * nsamp * iWidth) {
+        return false;
+    }
+
+    baData.resize(baPlanes.size());
+    const uchar* pPlanes = reinterpret_cast<const uchar*>(baPlanes.constData());
+    if(iWidth == 2) {
+        decodePlanes<quint16>(pPlanes, nchan, nsamp, false, baData.data());
+    } else {
+        decodePlanes<quint32>(pPlanes, nchan, nsamp, iType == FIFFT_FLOAT, baData.data());
+    }
+
+    return true;
+}
@@ -0,0 +1,143 @@
+//=============================================================================================================
+/**
+ * @file     fiff_compressed_buffer.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FiffCompressedBuffer class declaration.
+ *
+ */
+
+#ifndef FIFF_COMPRESSED_BUFFER_H
+#define FIFF_COMPRESSED_BUFFER_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QByteArray>
+
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//=============================================================================================================
+/**
+ * Codec for FIFF_DATA_BUFFER tags of type FIFFT_COMPRESSED_BUFFER. Every buffer is compressed on its own, so
+ * the raw directory keeps random access to each buffer.
+ *
+ * The payload starts with a big endian header (version, sample type, nchan, nsamp, flags) followed by a zlib
+ * stream (qCompress). Before compression every sample is replaced by its difference to the previous sample of
+ * the same channel (integer types) or by the XOR of both bit patterns (float), and the residuals are split into
+ * byte planes. Both steps are lossless and turn slowly varying signals into long runs of small bytes.
+ *
+ * @brief Compressed raw data buffer codec
+ */
+class FIFFSHARED_EXPORT FiffCompressedBuffer
+{
+public:
+    static const qint32 HEADER_SIZE = 20;   /**< Size of the payload header in bytes. */
+
+    //=========================================================================================================
+    /**
+     * Checks if a sample type can be stored compressed.
+     *
+     * @param[in] iType      fiff type of the samples.
+     *
+     * @return true for FIFFT_DAU_PACK16, FIFFT_SHORT, FIFFT_INT and FIFFT_FLOAT.
+     */
+    static bool isSupportedType(fiff_int_t iType);
+
+    //=========================================================================================================
+    /**
+     * Compresses one raw data buffer.
+     *
+     * @param[in] pData      nchan x nsamp samples in native byte order, channels running fastest.
+     * @param[in] iType      fiff type of the samples.
+     * @param[in] nchan      number of channels.
+     * @param[in] nsamp      number of samples.
+     * @param[in] iLevel     zlib compression level (0-9, -1 for the zlib default).
+     *
+     * @return the tag payload, empty if the type is not supported.
+     */
+    static QByteArray compress(const char* pData,
+                               fiff_int_t iType,
+                               qint32 nchan,
+                               qint32 nsamp,
+                               int iLevel = -1);
+
+    //=========================================================================================================
+    /**
+     * Reads the header of a compressed buffer payload.
+     *
+     * @param[in] pPayload   the tag payload.
+     * @param[in] iSize      size of the payload in bytes, at least HEADER_SIZE.
+     * @param[out] iType     fiff type of the samples.
+     * @param[out] nchan     number of channels.
+     * @param[out] nsamp     number of samples.
+     *
+     * @return true if the header is valid.
+     */
+    static bool readHeader(const char* pPayload,
+                           qint64 iSize,
+                           fiff_int_t& iType,
+                           qint32& nchan,
+                           qint32& nsamp);
+
+    //=========================================================================================================
+    /**
+     * Uncompresses one raw data buffer.
+     *
+     * @param[in] pPayload   the tag payload.
+     * @param[in] iSize      size of the payload in bytes.
+     * @param[out] baData    the samples in native byte order, channels running fastest.
+     * @param[out] iType     fiff type of the samples.
+     * @param[out] nchan     number of channels.
+     * @param[out] nsamp     number of samples.
+     *
+     * @return true if succeeded, false if the payload is corrupt.
+     */
+    static bool uncompress(const char* pPayload,
+                           qint64 iSize,
+                           QByteArray& baData,
+                           fiff_int_t& iType,
+                           qint32& nchan,
+                           qint32& nsamp);
+};
+} // NAMESPACE
+
+#endif // FIFF_COMPRESSED_BUFFER_H
@@ -253,6 +253,7 @@ namespace FIFFLIB
 #define FIFFT_DIG_STRING_STRUCT    36
 #define FIFFT_STREAM_SEGMENT_STRUCT 37
 #define FIFFT_DATA_REF_STRUCT       38
+#define FIFFT_COMPRESSED_BUFFER     60  /**< MNE-CPP extension: independently compressed raw data buffer, see FiffCompressedBuffer */
 /*
  * These are for matrices of any of the above 
  */
@@ -0,0 +1,205 @@
+//=============================================================================================================
+/**
+ * @file     fiff_mapped_matrix.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FiffMappedMatrix Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_mapped_matrix.h"
+#include "fiff_file.h"
+#include "fiff_constants.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtEndian>
+#include <QDebug>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cstring>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+static inline float fromBigEndianFloat(const uchar* pSrc)
+{
+    quint32 iRaw = qFromBigEndian<quint32>(pSrc);
+    float fVal;
+    std::memcpy(&fVal, &iRaw, sizeof(float));
+    return fVal;
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffMappedMatrix::FiffMappedMatrix()
+: m_pData(Q_NULLPTR)
+, m_iRows(0)
+, m_iCols(0)
+{
+}
+
+//=============================================================================================================
+
+FiffMappedMatrix::~FiffMappedMatrix()
+{
+    close();
+}
+
+//=============================================================================================================
+
+bool FiffMappedMatrix::open(const QString& sFileName,
+                            fiff_long_t iTagPos)
+{
+    close();
+
+    m_file.setFileName(sFileName);
+    if(!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[FiffMappedMatrix::open] Could not open" << sFileName;
+        return false;
+    }
+
+    //
+    //   Read the tag header: kind, type, size, next
+    //
+    uchar header[FIFFC_DATA_OFFSET];
+    if(!m_file.seek(iTagPos) || m_file.read(reinterpret_cast<char*>(header), FIFFC_DATA_OFFSET) != FIFFC_DATA_OFFSET) {
+        qWarning() << "[FiffMappedMatrix::open] Could not read tag header at" << iTagPos;
+        m_file.close();
+        return false;
+    }
+
+    fiff_int_t iType = qFromBigEndian<qint32>(header + 4);
+    fiff_int_t iSize = qFromBigEndian<qint32>(header + 8);
+
+    if(iType != FIFFT_MATRIX_FLOAT || iSize < 3 * 4) {
+        qWarning() << "[FiffMappedMatrix::open] Tag is not a dense float matrix";
+        m_file.close();
+        return false;
+    }
+
+    //
+    //   The dimensions are stored at the end of the payload: dims[0], dims[1], ndim
+    //
+    uchar dims[12];
+    if(!m_file.seek(iTagPos + FIFFC_DATA_OFFSET + iSize - 12) || m_file.read(reinterpret_cast<char*>(dims), 12) != 12) {
+        m_file.close();
+        return false;
+    }
+
+    qint32 iNDim = qFromBigEndian<qint32>(dims + 8);
+    qint32 iRows = qFromBigEndian<qint32>(dims);
+    qint32 iCols = qFromBigEndian<qint32>(dims + 4);
+
+    if(iNDim != 2 || iRows < 0 || iCols < 0 || static_cast<qint64>(iRows) * iCols * 4 + 12 != iSize) {
+        qWarning() << "[FiffMappedMatrix::open] Only two dimensional matrices are supported";
+        m_file.close();
+        return false;
+    }
+
+    m_pData = m_file.map(iTagPos + FIFFC_DATA_OFFSET, iSize - 12);
+    if(!m_pData) {
+        qWarning() << "[FiffMappedMatrix::open] Could not map" << sFileName;
+        m_file.close();
+        return false;
+    }
+
+    m_iRows = iRows;
+    m_iCols = iCols;
+
+    return true;
+}
+
+//=============================================================================================================
+
+void FiffMappedMatrix::close()
+{
+    if(m_pData) {
+        m_file.unmap(m_pData);
+        m_pData = Q_NULLPTR;
+    }
+    if(m_file.isOpen()) {
+        m_file.close();
+    }
+    m_iRows = 0;
+    m_iCols = 0;
+}
+
+//=============================================================================================================
+
+void FiffMappedMatrix::readColumn(qint32 iCol,
+                                  const VectorXi& vecRowSel,
+                                  float* pDest) const
+{
+    const uchar* pCol = m_pData + static_cast<qint64>(iCol) * m_iRows * 4;
+
+    if(vecRowSel.size() == 0) {
+        for(qint32 i = 0; i < m_iRows; ++i) {
+            pDest[i] = fromBigEndianFloat(pCol + 4 * i);
+        }
+    } else {
+        for(qint32 i = 0; i < vecRowSel.size(); ++i) {
+            pDest[i] = fromBigEndianFloat(pCol + 4 * vecRowSel[i]);
+        }
+    }
+}
+
+//=============================================================================================================
+
+MatrixXf FiffMappedMatrix::readColumns(qint32 iCol,
+                                       qint32 iNumCols,
+                                       const VectorXi& vecRowSel) const
+{
+    qint32 iNumRows = vecRowSel.size() == 0 ? m_iRows : static_cast<qint32>(vecRowSel.size());
+    MatrixXf matBlock(iNumRows, iNumCols);
+
+    for(qint32 j = 0; j < iNumCols; ++j) {
+        readColumn(iCol + j, vecRowSel, matBlock.data() + static_cast<qint64>(j) * iNumRows);
+    }
+
+    return matBlock;
+}
@@ -0,0 +1,191 @@
+//=============================================================================================================
+/**
+ * @file     fiff_mapped_matrix.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FiffMappedMatrix class declaration.
+ *
+ */
+
+#ifndef FIFF_MAPPED_MATRIX_H
+#define FIFF_MAPPED_MATRIX_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QFile>
+#include <QSharedPointer>
+#include <QString>
+
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//=============================================================================================================
+/**
+ * Gives random column access to a dense FIFFT_FLOAT matrix tag without reading the whole tag into memory.
+ * The tag payload is memory mapped and columns are converted from big endian on demand. Columns refer to the
+ * matrix as returned by FiffTag::toFloatMatrix, i.e. each column is stored contiguously in the file.
+ *
+ * @brief Memory mapped dense float matrix tag
+ */
+class FIFFSHARED_EXPORT FiffMappedMatrix
+{
+public:
+    typedef QSharedPointer<FiffMappedMatrix> SPtr;              /**< Shared pointer type for FiffMappedMatrix. */
+    typedef QSharedPointer<const FiffMappedMatrix> ConstSPtr;   /**< Const shared pointer type for FiffMappedMatrix. */
+
+    //=========================================================================================================
+    /**
+     * Default constructor.
+     */
+    FiffMappedMatrix();
+
+    //=========================================================================================================
+    /**
+     * Destroys the mapped matrix and unmaps the file.
+     */
+    ~FiffMappedMatrix();
+
+    //=========================================================================================================
+    /**
+     * Maps the dense float matrix tag located at the given position.
+     *
+     * @param[in] sFileName  The FIFF file.
+     * @param[in] iTagPos    Position of the tag (the tag header, not the payload) within the file.
+     *
+     * @return true if the tag is a two dimensional dense float matrix and could be mapped, false otherwise.
+     */
+    bool open(const QString& sFileName,
+              fiff_long_t iTagPos);
+
+    //=========================================================================================================
+    /**
+     * Unmaps and closes the file.
+     */
+    void close();
+
+    //=========================================================================================================
+    /**
+     * Returns whether a matrix is mapped.
+     *
+     * @return true if a matrix is mapped.
+     */
+    inline bool isOpen() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of rows.
+     *
+     * @return the number of rows.
+     */
+    inline qint32 rows() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of columns.
+     *
+     * @return the number of columns.
+     */
+    inline qint32 cols() const;
+
+    //=========================================================================================================
+    /**
+     * Converts one column into native floats.
+     *
+     * @param[in] iCol           The column to read.
+     * @param[in] vecRowSel      Rows to read. All rows are read if empty.
+     * @param[out] pDest         Destination with room for vecRowSel.size() (or rows()) values.
+     */
+    void readColumn(qint32 iCol,
+                    const Eigen::VectorXi& vecRowSel,
+                    float* pDest) const;
+
+    //=========================================================================================================
+    /**
+     * Converts a block of consecutive columns into a native float matrix.
+     *
+     * @param[in] iCol           The first column to read.
+     * @param[in] iNumCols       The number of columns to read.
+     * @param[in] vecRowSel      Rows to read. All rows are read if empty.
+     *
+     * @return the converted block.
+     */
+    Eigen::MatrixXf readColumns(qint32 iCol,
+                                qint32 iNumCols,
+                                const Eigen::VectorXi& vecRowSel = Eigen::VectorXi()) const;
+
+private:
+    QFile       m_file;         /**< The mapped file. */
+    uchar*      m_pData;        /**< Start of the mapped tag payload. */
+    qint32      m_iRows;        /**< Number of rows. */
+    qint32      m_iCols;        /**< Number of columns. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline bool FiffMappedMatrix::isOpen() const
+{
+    return m_pData != Q_NULLPTR;
+}
+
+//=============================================================================================================
+
+inline qint32 FiffMappedMatrix::rows() const
+{
+    return m_iRows;
+}
+
+//=============================================================================================================
+
+inline qint32 FiffMappedMatrix::cols() const
+{
+    return m_iCols;
+}
+} // NAMESPACE
+
+#endif // FIFF_MAPPED_MATRIX_H
@@ -41,6 +41,7 @@
 #include "fiff_raw_data.h"
 #include "fiff_tag.h"
 #include "fiff_stream.h"
+#include "fiff_compressed_buffer.h"
 #include "cstdlib"
 
 //=============================================================================================================
@@ -265,9 +266,10 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
         fid = this->file;
     }
 
-    MatrixXd one, newData, tmp_data;
+    MatrixXd one, tmp_data;
+    QByteArray baUncompressed;
     FiffRawDir thisRawDir;
-    FiffTag::SPtr t_pTag;
+    FiffTag::SPtr t_pTag;   // Reused for all buffers, see FiffStream::read_tag_into
     fiff_int_t first_pick, last_pick, picksamp;
     for(k = 0; k < this->rawdir.size(); ++k)
     {
@@ -293,77 +295,68 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
             }
             else
             {
-                fid->read_tag(t_pTag, thisRawDir.ent->pos);
+                fid->read_tag_into(t_pTag, thisRawDir.ent->pos, false);
+                int endian = fid->byteOrder() == QDataStream::LittleEndian ? FIFFV_LITTLE_ENDIAN : FIFFV_BIG_ENDIAN;
+                const char* pData = t_pTag->data();
+                qint64 iSize = t_pTag->size();
+                fiff_int_t iType = t_pTag->type;
+                if (iType == FIFFT_COMPRESSED_BUFFER)
+                {
+                    qint32 iBufferChan, iBufferSamp;
+                    if (FiffCompressedBuffer::uncompress(pData, iSize, baUncompressed, iType, iBufferChan, iBufferSamp))
+                    {
+                        pData = baUncompressed.constData();
+                        iSize = baUncompressed.size();
+                        endian = FIFFV_NATIVE_ENDIAN;
+                    }
+                    else
+                    {
+                        printf("Corrupt compressed data buffer at position %d\n", thisRawDir.ent->pos);
+                        iSize = 0;
+                    }
+                }
                 //
                 //   Depending on the state of the projection and selection
-                //   we proceed a little bit differently
+                //   we proceed a little bit differently. The payload stays in
+                //   file byte order, decode_data_buffer swaps, converts and
+                //   calibrates it in one pass.
                 //
                 if (mult.cols() == 0)
                 {
                     if (sel.cols() == 0)
                     {
-                        if (t_pTag->type == FIFFT_DAU_PACK16)
-                            one = cal*(Map< MatrixDau16 >( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_INT)
-                            one = cal*(Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_FLOAT)
-                            one = cal*(Map< MatrixXf >( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_SHORT)
-                            one = cal*(Map< MatrixShort >( t_pTag->toShort(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else
-                            printf("Data Storage Format not known yet [1]!! Type: %d\n", t_pTag->type);
+                        if (!FiffTag::decode_data_buffer(pData, iSize, iType, endian, nchan, thisRawDir.nsamp, one, this->cals))
+                        {
+                            printf("Data Storage Format not known yet [1]!! Type: %d\n", iType);
+                            one.setZero(nchan, thisRawDir.nsamp);
+                        }
                     }
                     else
                     {
-                        //ToDo find a faster solution for this!! --> make cal and mul sparse like in MATLAB
-                        newData.resize(sel.cols(), thisRawDir.nsamp); //ToDo this can be done much faster, without newData
-
-                        if (t_pTag->type == FIFFT_DAU_PACK16)
-                        {
-                            tmp_data = (Map< MatrixDau16 > ( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_INT)
+                        one.resize(sel.cols(), thisRawDir.nsamp);
+                        if (FiffTag::decode_data_buffer(pData, iSize, iType, endian, nchan, thisRawDir.nsamp, tmp_data, this->cals))
                         {
-                            tmp_data = (Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_FLOAT)
-                        {
-                            tmp_data = (Map< MatrixXf > ( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
-
                             for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_SHORT)
-                        {
-                            tmp_data = (Map< MatrixShort > ( t_pTag->toShort(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
+                                one.row(r) = tmp_data.row(sel[r]);
                         }
                         else
                         {
-                            printf("Data Storage Format not known yet [2]!! Type: %d\n", t_pTag->type);
+                            printf("Data Storage Format not known yet [2]!! Type: %d\n", iType);
+                            one.setZero();
                         }
-
-                        one = cal*newData;
                     }
                 }
                 else
                 {
-                    if (t_pTag->type == FIFFT_DAU_PACK16)
-                        one = mult*(Map< MatrixDau16 >( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-                    else if(t_pTag->type == FIFFT_INT)
-                        one = mult*(Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-                    else if(t_pTag->type == FIFFT_FLOAT)
-                        one = mult*(Map< MatrixXf >( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
+                    if (FiffTag::decode_data_buffer(pData, iSize, iType, endian, nchan, thisRawDir.nsamp, tmp_data))
+                    {
+                        one = mult*tmp_data;
+                    }
                     else
-                        printf("Data Storage Format not known yet [3]!! Type: %d\n", t_pTag->type);
+                    {
+                        printf("Data Storage Format not known yet [3]!! Type: %d\n", iType);
+                        one.setZero(mult.rows(), thisRawDir.nsamp);
+                    }
                 }
             }
             //
@@ -600,7 +593,9 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
         fid = this->file;
     }
 
-    MatrixXd one;
+    MatrixXd one, tmp_data;
+    QByteArray baUncompressed;
+    FiffTag::SPtr t_pTag;   // Reused for all buffers, see FiffStream::read_tag_into
     fiff_int_t first_pick, last_pick, picksamp;
     for(k = 0; k < this->rawdir.size(); ++k)
     {
@@ -626,79 +621,68 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
             }
             else
             {
-                FiffTag::SPtr t_pTag;
-                fid->read_tag(t_pTag, thisRawDir.ent->pos);
+                fid->read_tag_into(t_pTag, thisRawDir.ent->pos, false);
+                int endian = fid->byteOrder() == QDataStream::LittleEndian ? FIFFV_LITTLE_ENDIAN : FIFFV_BIG_ENDIAN;
+                const char* pData = t_pTag->data();
+                qint64 iSize = t_pTag->size();
+                fiff_int_t iType = t_pTag->type;
+                if (iType == FIFFT_COMPRESSED_BUFFER)
+                {
+                    qint32 iBufferChan, iBufferSamp;
+                    if (FiffCompressedBuffer::uncompress(pData, iSize, baUncompressed, iType, iBufferChan, iBufferSamp))
+                    {
+                        pData = baUncompressed.constData();
+                        iSize = baUncompressed.size();
+                        endian = FIFFV_NATIVE_ENDIAN;
+                    }
+                    else
+                    {
+                        printf("Corrupt compressed data buffer at position %d\n", thisRawDir.ent->pos);
+                        iSize = 0;
+                    }
+                }
                 //
                 //   Depending on the state of the projection and selection
-                //   we proceed a little bit differently
+                //   we proceed a little bit differently. The payload stays in
+                //   file byte order, decode_data_buffer swaps, converts and
+                //   calibrates it in one pass.
                 //
                 if (mult.cols() == 0)
                 {
                     if (sel.cols() == 0)
                     {
-                        if (t_pTag->type == FIFFT_DAU_PACK16)
-                            one = cal*(Map< MatrixDau16 >( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_INT)
-                            one = cal*(Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_FLOAT)
-                            one = cal*(Map< MatrixXf >( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_SHORT)
-                            one = cal*(Map< MatrixShort >( t_pTag->toShort(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else
-                            printf("Data Storage Format not known yet [1]!! Type: %d\n", t_pTag->type);
+                        if (!FiffTag::decode_data_buffer(pData, iSize, iType, endian, nchan, thisRawDir.nsamp, one, this->cals))
+                        {
+                            printf("Data Storage Format not known yet [1]!! Type: %d\n", iType);
+                            one.setZero(nchan, thisRawDir.nsamp);
+                        }
                     }
                     else
                     {
-
-                        //ToDo find a faster solution for this!! --> make cal and mul sparse like in MATLAB
-                        MatrixXd newData(sel.cols(), thisRawDir.nsamp); //ToDo this can be done much faster, without newData
-
-                        if (t_pTag->type == FIFFT_DAU_PACK16)
+                        one.resize(sel.cols(), thisRawDir.nsamp);
+                        if (FiffTag::decode_data_buffer(pData, iSize, iType, endian, nchan, thisRawDir.nsamp, tmp_data, this->cals))
                         {
-                            MatrixXd tmp_data = (Map< MatrixDau16 > ( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-
                             for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_INT)
-                        {
-                            MatrixXd tmp_data = (Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_FLOAT)
-                        {
-                            MatrixXd tmp_data = (Map< MatrixXf > ( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_SHORT)
-                        {
-                            MatrixXd tmp_data = (Map< MatrixShort > ( t_pTag->toShort(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
+                                one.row(r) = tmp_data.row(sel[r]);
                         }
                         else
                         {
-                            printf("Data Storage Format not known yet [2]!! Type: %d\n", t_pTag->type);
+                            printf("Data Storage Format not known yet [2]!! Type: %d\n", iType);
+                            one.setZero();
                         }
-
-                        one = cal*newData;
                     }
                 }
                 else
                 {
-                    if (t_pTag->type == FIFFT_DAU_PACK16)
-                        one = mult*(Map< MatrixDau16 >( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-                    else if(t_pTag->type == FIFFT_INT)
-                        one = mult*(Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-                    else if(t_pTag->type == FIFFT_FLOAT)
-                        one = mult*(Map< MatrixXf >( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
+                    if (FiffTag::decode_data_buffer(pData, iSize, iType, endian, nchan, thisRawDir.nsamp, tmp_data))
+                    {
+                        one = mult*tmp_data;
+                    }
                     else
-                        printf("Data Storage Format not known yet [3]!! Type: %d\n", t_pTag->type);
+                    {
+                        printf("Data Storage Format not known yet [3]!! Type: %d\n", iType);
+                        one.setZero(mult.rows(), thisRawDir.nsamp);
+                    }
                 }
             }
             //
@@ -0,0 +1,447 @@
+//=============================================================================================================
+/**
+ * @file     fiff_raw_data_set.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FiffRawDataSet class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_raw_data_set.h"
+#include "fiff_dir_node.h"
+#include "fiff_tag.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QRunnable>
+#include <QWaitCondition>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+namespace
+{
+
+//=============================================================================================================
+/**
+ * Counts the pending tasks of one read_raw_segment call.
+ */
+struct ReadLatch
+{
+    QMutex          mutex;
+    QWaitCondition  done;
+    int             iPending;
+    bool            bFailed;
+};
+
+} // namespace
+
+//=============================================================================================================
+/**
+ * Reads one chunk of one file into its columns of the result matrix.
+ */
+class FiffRawDataSet::ReadTask : public QRunnable
+{
+public:
+    ReadTask(const FiffRawDataSet* pSet,
+             int iPart,
+             fiff_int_t from,
+             fiff_int_t to,
+             fiff_int_t iColumn,
+             const RowVectorXi& sel,
+             MatrixXd* pData,
+             ReadLatch* pLatch)
+    : m_pSet(pSet)
+    , m_iPart(iPart)
+    , m_from(from)
+    , m_to(to)
+    , m_iColumn(iColumn)
+    , m_sel(sel)
+    , m_pData(pData)
+    , m_pLatch(pLatch)
+    {
+    }
+
+    void run() override
+    {
+        Reader* pReader = m_pSet->acquireReader(m_iPart);
+        MatrixXd matChunk, matTimes;
+        bool bOk = pReader->raw.read_raw_segment(matChunk, matTimes, m_from, m_to, m_sel);
+        m_pSet->releaseReader(m_iPart, pReader);
+
+        bOk = bOk && matChunk.rows() == m_pData->rows() && matChunk.cols() == m_to - m_from + 1;
+        if(bOk) {
+            // The chunks cover disjoint columns, no locking needed
+            m_pData->middleCols(m_iColumn, matChunk.cols()) = matChunk;
+        }
+
+        QMutexLocker locker(&m_pLatch->mutex);
+        if(!bOk) {
+            m_pLatch->bFailed = true;
+        }
+        if(--m_pLatch->iPending == 0) {
+            m_pLatch->done.wakeAll();
+        }
+    }
+
+private:
+    const FiffRawDataSet*   m_pSet;
+    int                     m_iPart;
+    fiff_int_t              m_from;
+    fiff_int_t              m_to;
+    fiff_int_t              m_iColumn;
+    RowVectorXi             m_sel;
+    MatrixXd*               m_pData;
+    ReadLatch*              m_pLatch;
+};
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffRawDataSet::FiffRawDataSet(const QString& sFileName,
+                               int iIoThreads)
+: m_iFirstSample(-1)
+, m_iLastSample(-1)
+, m_iChunkSize(0)
+{
+    m_ioPool.setMaxThreadCount(qMax(1, iIoThreads));
+    init(findSplitFiles(sFileName));
+}
+
+//=============================================================================================================
+
+FiffRawDataSet::FiffRawDataSet(const QStringList& lFileNames,
+                               int iIoThreads)
+: m_iFirstSample(-1)
+, m_iLastSample(-1)
+, m_iChunkSize(0)
+{
+    m_ioPool.setMaxThreadCount(qMax(1, iIoThreads));
+    init(lFileNames);
+}
+
+//=============================================================================================================
+
+FiffRawDataSet::~FiffRawDataSet()
+{
+    m_ioPool.waitForDone();
+    clearReaders();
+}
+
+//=============================================================================================================
+
+QStringList FiffRawDataSet::findSplitFiles(const QString& sFileName)
+{
+    QStringList lFileNames;
+    QString sCurrent = sFileName;
+
+    while(!sCurrent.isEmpty() && !lFileNames.contains(sCurrent) && QFile::exists(sCurrent)) {
+        lFileNames << sCurrent;
+
+        QFile file(sCurrent);
+        FiffStream::SPtr pStream(new FiffStream(&file));
+        sCurrent.clear();
+        if(!pStream->open()) {
+            break;
+        }
+
+        QList<FiffDirNode::SPtr> lRefs = pStream->dirtree()->dir_tree_find(FIFFB_REF);
+        for(int i = 0; i < lRefs.size(); ++i) {
+            FiffTag::SPtr pTag;
+            if(!lRefs[i]->find_tag(pStream, FIFF_REF_ROLE, pTag) || *pTag->toInt() != FIFFV_ROLE_NEXT_FILE) {
+                continue;
+            }
+            if(lRefs[i]->find_tag(pStream, FIFF_REF_FILE_NAME, pTag)) {
+                // The reference is relative to the directory of the referencing file
+                sCurrent = QFileInfo(lFileNames.last()).dir().filePath(pTag->toString());
+            }
+            break;
+        }
+        pStream->close();
+    }
+
+    return lFileNames;
+}
+
+//=============================================================================================================
+
+bool FiffRawDataSet::isEmpty() const
+{
+    return m_lParts.isEmpty();
+}
+
+//=============================================================================================================
+
+QStringList FiffRawDataSet::fileNames() const
+{
+    return m_lFileNames;
+}
+
+//=============================================================================================================
+
+const FiffInfo& FiffRawDataSet::info() const
+{
+    static const FiffInfo emptyInfo;
+    return m_lParts.isEmpty() ? emptyInfo : m_lParts.first()->info;
+}
+
+//=============================================================================================================
+
+fiff_int_t FiffRawDataSet::firstSample() const
+{
+    return m_iFirstSample;
+}
+
+//=============================================================================================================
+
+fiff_int_t FiffRawDataSet::lastSample() const
+{
+    return m_iLastSample;
+}
+
+//=============================================================================================================
+
+QList<FiffRawData::ConstSPtr> FiffRawDataSet::parts() const
+{
+    QList<FiffRawData::ConstSPtr> lParts;
+    for(int i = 0; i < m_lParts.size(); ++i) {
+        lParts << m_lParts[i];
+    }
+    return lParts;
+}
+
+//=============================================================================================================
+
+void FiffRawDataSet::setProj(const MatrixXd& proj)
+{
+    for(int i = 0; i < m_lParts.size(); ++i) {
+        m_lParts[i]->proj = proj;
+    }
+    clearReaders();
+}
+
+//=============================================================================================================
+
+void FiffRawDataSet::setComp(const FiffCtfComp& comp)
+{
+    for(int i = 0; i < m_lParts.size(); ++i) {
+        m_lParts[i]->comp = comp;
+    }
+    clearReaders();
+}
+
+//=============================================================================================================
+
+void FiffRawDataSet::setIoThreadCount(int iIoThreads)
+{
+    m_ioPool.setMaxThreadCount(qMax(1, iIoThreads));
+}
+
+//=============================================================================================================
+
+void FiffRawDataSet::setChunkSize(fiff_int_t iSamples)
+{
+    m_iChunkSize = qMax(0, iSamples);
+}
+
+//=============================================================================================================
+
+bool FiffRawDataSet::read_raw_segment(MatrixXd& data,
+                                      MatrixXd& times,
+                                      fiff_int_t from,
+                                      fiff_int_t to,
+                                      const RowVectorXi& sel) const
+{
+    if(m_lParts.isEmpty()) {
+        return false;
+    }
+
+    if(from == -1)
+        from = m_iFirstSample;
+    if(to == -1)
+        to = m_iLastSample;
+    if(from < m_iFirstSample)
+        from = m_iFirstSample;
+    if(to > m_iLastSample)
+        to = m_iLastSample;
+    if(from > to) {
+        printf("No data in this range %d ... %d\n", from, to);
+        return false;
+    }
+
+    //
+    //   Cut the range into chunks per file
+    //
+    struct Chunk { int iPart; fiff_int_t from; fiff_int_t to; };
+    QList<Chunk> lChunks;
+    for(int i = 0; i < m_lParts.size(); ++i) {
+        const FiffRawData& raw = *m_lParts[i];
+        fiff_int_t first = qMax(from, raw.first_samp);
+        fiff_int_t last = qMin(to, raw.last_samp);
+        if(first > last) {
+            continue;
+        }
+
+        fiff_int_t iChunkSize = m_iChunkSize;
+        if(iChunkSize <= 0) {
+            iChunkSize = raw.rawdir.isEmpty() ? last - first + 1 : qMax(1, 8 * raw.rawdir.first().nsamp);
+        }
+        for(fiff_int_t k = first; k <= last; k += iChunkSize) {
+            Chunk chunk = { i, k, qMin(last, k + iChunkSize - 1) };
+            lChunks << chunk;
+        }
+    }
+
+    const qint32 nrows = sel.size() > 0 ? sel.size() : m_lParts.first()->info.nchan;
+    data.setZero(nrows, to - from + 1);
+
+    ReadLatch latch;
+    latch.iPending = lChunks.size();
+    latch.bFailed = false;
+
+    for(int i = 0; i < lChunks.size(); ++i) {
+        ReadTask* pTask = new ReadTask(this, lChunks[i].iPart, lChunks[i].from, lChunks[i].to, lChunks[i].from - from, sel, &data, &latch);
+        if(lChunks.size() == 1) {
+            // Not worth a thread switch
+            pTask->run();
+            delete pTask;
+        } else {
+            m_ioPool.start(pTask);
+        }
+    }
+
+    {
+        QMutexLocker locker(&latch.mutex);
+        while(latch.iPending > 0) {
+            latch.done.wait(&latch.mutex);
+        }
+    }
+
+    times.resize(1, to - from + 1);
+    for(fiff_int_t k = 0; k < times.cols(); ++k) {
+        times(0, k) = static_cast<double>(from + k) / m_lParts.first()->info.sfreq;
+    }
+
+    return !latch.bFailed;
+}
+
+//=============================================================================================================
+
+void FiffRawDataSet::init(const QStringList& lFileNames)
+{
+    for(int i = 0; i < lFileNames.size(); ++i) {
+        QSharedPointer<QFile> pFile(new QFile(lFileNames[i]));
+        FiffRawData::SPtr pRaw(new FiffRawData(*pFile));
+        if(pRaw->isEmpty()) {
+            qWarning("FiffRawDataSet::init - Could not read %s, the recording ends with the previous file.", lFileNames[i].toUtf8().constData());
+            break;
+        }
+
+        if(!m_lParts.isEmpty()) {
+            if(pRaw->info.nchan != m_lParts.first()->info.nchan) {
+                qWarning("FiffRawDataSet::init - %s has a different number of channels, the recording ends with the previous file.", lFileNames[i].toUtf8().constData());
+                break;
+            }
+            if(pRaw->first_samp != m_iLastSample + 1) {
+                qWarning("FiffRawDataSet::init - %s does not continue at sample %d, the gap is read as zeros.", lFileNames[i].toUtf8().constData(), m_iLastSample + 1);
+            }
+        }
+
+        if(m_lParts.isEmpty() || pRaw->first_samp < m_iFirstSample) {
+            m_iFirstSample = pRaw->first_samp;
+        }
+        if(m_lParts.isEmpty() || pRaw->last_samp > m_iLastSample) {
+            m_iLastSample = pRaw->last_samp;
+        }
+
+        m_lFileNames << lFileNames[i];
+        m_lFiles << pFile;
+        m_lParts << pRaw;
+    }
+
+    m_lFreeReaders.resize(m_lParts.size());
+}
+
+//=============================================================================================================
+
+FiffRawDataSet::Reader* FiffRawDataSet::acquireReader(int iPart) const
+{
+    {
+        QMutexLocker locker(&m_readerMutex);
+        if(!m_lFreeReaders[iPart].isEmpty()) {
+            return m_lFreeReaders[iPart].takeLast();
+        }
+    }
+
+    const FiffRawData& part = *m_lParts[iPart];
+
+    Reader* pReader = new Reader;
+    pReader->pFile = QSharedPointer<QFile>(new QFile(m_lFileNames[iPart]));
+    pReader->raw = part;
+    pReader->raw.file = FiffStream::SPtr(new FiffStream(pReader->pFile.data()));
+    pReader->raw.file->setByteOrder(part.file->byteOrder());
+
+    return pReader;
+}
+
+//=============================================================================================================
+
+void FiffRawDataSet::releaseReader(int iPart, Reader* pReader) const
+{
+    QMutexLocker locker(&m_readerMutex);
+    m_lFreeReaders[iPart].append(pReader);
+}
+
+//=============================================================================================================
+
+void FiffRawDataSet::clearReaders()
+{
+    QMutexLocker locker(&m_readerMutex);
+    for(int i = 0; i < m_lFreeReaders.size(); ++i) {
+        qDeleteAll(m_lFreeReaders[i]);
+        m_lFreeReaders[i].clear();
+    }
+}
@@ -0,0 +1,276 @@
+//=============================================================================================================
+/**
+ * @file     fiff_raw_data_set.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FiffRawDataSet class declaration.
+ *
+ */
+
+#ifndef FIFF_RAW_DATA_SET_H
+#define FIFF_RAW_DATA_SET_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_raw_data.h"
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QList>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+class QFile;
+
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//=============================================================================================================
+/**
+ * Presents a raw recording which is split into several files (raw.fif, raw-1.fif, ...) as one continuous sample
+ * range. A segment read is cut into chunks of whole buffers which are read concurrently on a small I/O thread
+ * pool, each worker uses its own file handle. The chunks are assembled in sample order. Samples which are not
+ * covered by any file are returned as zeros.
+ *
+ * @brief Split fiff raw data files read as one recording
+ */
+class FIFFSHARED_EXPORT FiffRawDataSet
+{
+public:
+    typedef QSharedPointer<FiffRawDataSet> SPtr;            /**< Shared pointer type for FiffRawDataSet. */
+    typedef QSharedPointer<const FiffRawDataSet> ConstSPtr; /**< Const shared pointer type for FiffRawDataSet. */
+
+    //=========================================================================================================
+    /**
+     * Opens a recording and all files it continues in, see findSplitFiles.
+     *
+     * @param[in] sFileName      the first file of the recording.
+     * @param[in] iIoThreads     number of concurrent reads.
+     */
+    explicit FiffRawDataSet(const QString& sFileName,
+                            int iIoThreads = 4);
+
+    //=========================================================================================================
+    /**
+     * Opens a recording from an explicit list of files, given in recording order.
+     *
+     * @param[in] lFileNames     the files of the recording.
+     * @param[in] iIoThreads     number of concurrent reads.
+     */
+    explicit FiffRawDataSet(const QStringList& lFileNames,
+                            int iIoThreads = 4);
+
+    //=========================================================================================================
+    /**
+     * Waits for pending reads and closes all files.
+     */
+    ~FiffRawDataSet();
+
+    //=========================================================================================================
+    /**
+     * Returns the files of a split recording, starting with sFileName. The next file is taken from the
+     * FIFFB_REF block (role FIFFV_ROLE_NEXT_FILE) of each file. Files without such a block end the list.
+     *
+     * @param[in] sFileName      the first file of the recording.
+     *
+     * @return the file names in recording order.
+     */
+    static QStringList findSplitFiles(const QString& sFileName);
+
+    //=========================================================================================================
+    /**
+     * True if no file could be opened.
+     *
+     * @return true if the set is empty.
+     */
+    bool isEmpty() const;
+
+    //=========================================================================================================
+    /**
+     * @return the file names in recording order.
+     */
+    QStringList fileNames() const;
+
+    //=========================================================================================================
+    /**
+     * @return the measurement info of the first file.
+     */
+    const FiffInfo& info() const;
+
+    //=========================================================================================================
+    /**
+     * @return the first sample of the recording.
+     */
+    fiff_int_t firstSample() const;
+
+    //=========================================================================================================
+    /**
+     * @return the last sample of the recording.
+     */
+    fiff_int_t lastSample() const;
+
+    //=========================================================================================================
+    /**
+     * @return the raw data of each file.
+     */
+    QList<FiffRawData::ConstSPtr> parts() const;
+
+    //=========================================================================================================
+    /**
+     * Sets the SSP operator for all files. Must not be called while a read is in progress.
+     *
+     * @param[in] proj           the SSP operator.
+     */
+    void setProj(const Eigen::MatrixXd& proj);
+
+    //=========================================================================================================
+    /**
+     * Sets the compensator for all files. Must not be called while a read is in progress.
+     *
+     * @param[in] comp           the compensator.
+     */
+    void setComp(const FiffCtfComp& comp);
+
+    //=========================================================================================================
+    /**
+     * Sets the number of concurrent reads.
+     *
+     * @param[in] iIoThreads     number of I/O threads.
+     */
+    void setIoThreadCount(int iIoThreads);
+
+    //=========================================================================================================
+    /**
+     * Sets the number of samples read per task. Chunks are extended to whole buffers by the readers.
+     *
+     * @param[in] iSamples       chunk size in samples.
+     */
+    void setChunkSize(fiff_int_t iSamples);
+
+    //=========================================================================================================
+    /**
+     * Reads a segment of the recording, see FiffRawData::read_raw_segment.
+     *
+     * @param[out] data      returns the data matrix (channels x samples)
+     * @param[out] times     returns the time values corresponding to the samples
+     * @param[in] from       first sample to include. If omitted, defaults to the first sample of the recording
+     * @param[in] to         last sample to include. If omitted, defaults to the last sample of the recording
+     * @param[in] sel        channel selection vector (optional)
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool read_raw_segment(Eigen::MatrixXd& data,
+                          Eigen::MatrixXd& times,
+                          fiff_int_t from = -1,
+                          fiff_int_t to = -1,
+                          const Eigen::RowVectorXi& sel = defaultRowVectorXi) const;
+
+private:
+    class ReadTask;
+
+    //=========================================================================================================
+    /**
+     * A file handle with its own copy of the raw data description. Each worker reads through its own reader.
+     */
+    struct Reader
+    {
+        QSharedPointer<QFile>   pFile;      /**< The file handle of this reader. */
+        FiffRawData             raw;        /**< Raw data description reading through pFile. */
+    };
+
+    //=========================================================================================================
+    /**
+     * Opens all files of the recording.
+     *
+     * @param[in] lFileNames     the files of the recording.
+     */
+    void init(const QStringList& lFileNames);
+
+    //=========================================================================================================
+    /**
+     * Returns a free reader of a file, a new one is created if all are busy.
+     *
+     * @param[in] iPart          index of the file.
+     *
+     * @return the reader.
+     */
+    Reader* acquireReader(int iPart) const;
+
+    //=========================================================================================================
+    /**
+     * Returns a reader to the free list.
+     *
+     * @param[in] iPart          index of the file.
+     * @param[in] pReader        the reader.
+     */
+    void releaseReader(int iPart, Reader* pReader) const;
+
+    //=========================================================================================================
+    /**
+     * Deletes all free readers, they are recreated with the current proj and comp.
+     */
+    void clearReaders();
+
+    QStringList                         m_lFileNames;       /**< The files of the recording. */
+    QList<QSharedPointer<QFile> >       m_lFiles;           /**< The files opened during setup. */
+    QList<FiffRawData::SPtr>            m_lParts;           /**< The raw data of each file. */
+    fiff_int_t                          m_iFirstSample;     /**< First sample of the recording. */
+    fiff_int_t                          m_iLastSample;      /**< Last sample of the recording. */
+    fiff_int_t                          m_iChunkSize;       /**< Samples read per task, 0 for eight buffers. */
+
+    mutable QMutex                      m_readerMutex;      /**< Guards m_lFreeReaders. */
+    mutable QVector<QList<Reader*> >    m_lFreeReaders;     /**< Free readers per file. */
+    mutable QThreadPool                 m_ioPool;           /**< Pool running the reads. */
+
+    Q_DISABLE_COPY(FiffRawDataSet)
+};
+} // NAMESPACE
+
+#endif // FIFF_RAW_DATA_SET_H
@@ -52,11 +52,13 @@
 #include "fiff_ch_pos.h"
 #include "fiff_dig_point.h"
 #include "fiff_id.h"
+#include "fiff_compressed_buffer.h"
 #include "c/fiff_digitizer_data.h"
 #include "fiff_dig_point.h"
 
 #include <utils/mnemath.h>
 #include <utils/ioutils.h>
+#include <utils/filecache.h>
 
 #define MALLOC_54(x,t) (t *)malloc((x)*sizeof(t))
 
@@ -70,6 +72,7 @@
 
 #include <iostream>
 #include <time.h>
+#include <limits>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -82,7 +85,11 @@
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QDateTime>
 #include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QtEndian>
 #include <QTcpSocket>
 
 //=============================================================================================================
@@ -93,6 +100,90 @@ using namespace FIFFLIB;
 using namespace UTILSLIB;
 using namespace Eigen;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace
+{
+QMutex s_sidecarMutex;                          /**< Guards the sidecar settings. */
+QString s_sSidecarDir;                          /**< Directory of the index files, empty if the sidecar index is disabled. */
+qint64 s_iSidecarMaxBytes = 64*1024*1024;       /**< The maximum size of all index files. */
+}
+
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+/**
+ * The cache of the sidecar index files, disabled if the sidecar index is disabled.
+ */
+static FileCache sidecarIndexCache()
+{
+    QMutexLocker locker(&s_sidecarMutex);
+    return FileCache(s_sSidecarDir, "idx", s_iSidecarMaxBytes);
+}
+
+//=============================================================================================================
+
+/**
+ * The cache key of the index of a fiff file. Size, modification time and file id are part of the key, so a
+ * rewritten file never gets the index of its previous version.
+ */
+static QString sidecarIndexKey(const QString& sFileName, const FiffId& id)
+{
+    QFileInfo fileInfo(sFileName);
+
+    FileCacheKey key("FiffStream sidecar index v1");
+    key.add(fileInfo.absoluteFilePath());
+    key.addValue(static_cast<qint64>(fileInfo.size())).addValue(static_cast<qint64>(fileInfo.lastModified().toMSecsSinceEpoch()));
+    key.addValue(id.version).addValue(id.machid[0]).addValue(id.machid[1]).addValue(id.time.secs).addValue(id.time.usecs);
+
+    return key.result();
+}
+
+//=============================================================================================================
+
+static bool readSidecarIndex(const QByteArray& baIndex,
+                             QList<FiffDirEntry::SPtr>& dir)
+{
+    QDataStream stream(baIndex);
+    qint32 nent;
+    stream >> nent;
+    if(stream.status() != QDataStream::Ok || nent <= 0)
+        return false;
+
+    QList<FiffDirEntry::SPtr> t_dir;
+    t_dir.reserve(nent);
+    for(qint32 k = 0; k < nent; ++k)
+    {
+        FiffDirEntry::SPtr t_pEntry(new FiffDirEntry);
+        qint64 pos;
+        stream >> t_pEntry->kind >> t_pEntry->type >> t_pEntry->size >> pos;
+        t_pEntry->pos = static_cast<fiff_int_t>(pos);
+        t_dir.append(t_pEntry);
+    }
+    if(stream.status() != QDataStream::Ok)
+        return false;
+
+    dir = t_dir;
+    return true;
+}
+
+//=============================================================================================================
+
+static QByteArray writeSidecarIndex(const QList<FiffDirEntry::SPtr>& dir)
+{
+    QByteArray baIndex;
+    QDataStream stream(&baIndex, QIODevice::WriteOnly);
+
+    stream << static_cast<qint32>(dir.size());
+    for(const FiffDirEntry::SPtr& t_pEntry : dir)
+        stream << t_pEntry->kind << t_pEntry->type << t_pEntry->size << static_cast<qint64>(t_pEntry->pos);
+
+    return baIndex;
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -298,10 +389,22 @@ bool FiffStream::open(QIODevice::OpenModeFlag mode)
      */
     if (dirpos <= 0) {  /* Must do it in the hard way... */
         bool ok = false;
-        m_dir = this->make_dir(&ok);
-        if (!ok) {
-          qCritical ("Could not create tag directory!");
-          return false;
+        FileCache t_indexCache = sidecarIndexCache();
+        QString t_sIndexKey;
+        QByteArray t_baIndex;
+        if (t_indexCache.isEnabled() && qobject_cast<QFile*>(this->device()))
+            t_sIndexKey = sidecarIndexKey(t_sFileName, m_id);
+        if (!t_sIndexKey.isEmpty() && t_indexCache.read(t_sIndexKey, t_baIndex) && readSidecarIndex(t_baIndex, m_dir)) {
+            qInfo("Using sidecar index %s", t_indexCache.getFileName(t_sIndexKey).toUtf8().constData());
+        }
+        else {
+            m_dir = this->make_dir(&ok);
+            if (!ok) {
+              qCritical ("Could not create tag directory!");
+              return false;
+            }
+            if (!t_sIndexKey.isEmpty())
+                t_indexCache.write(t_sIndexKey, writeSidecarIndex(m_dir));
         }
     }
     else {              /* Just read the directory */
@@ -340,6 +443,24 @@ bool FiffStream::open(QIODevice::OpenModeFlag mode)
 
 //=============================================================================================================
 
+void FiffStream::enable_sidecar_index(const QString& sCacheDir,
+                                      qint64 iMaxBytes)
+{
+    QMutexLocker locker(&s_sidecarMutex);
+    s_sSidecarDir = sCacheDir.isEmpty() ? FileCache::defaultDirectory("fiff_index") : sCacheDir;
+    s_iSidecarMaxBytes = iMaxBytes;
+}
+
+//=============================================================================================================
+
+void FiffStream::disable_sidecar_index()
+{
+    QMutexLocker locker(&s_sidecarMutex);
+    s_sSidecarDir.clear();
+}
+
+//=============================================================================================================
+
 bool FiffStream::close()
 {
     if(this->device()->isOpen())
@@ -1658,12 +1779,24 @@ bool FiffStream::read_rt_tag(FiffTag::SPtr &p_pTag)
 
 bool FiffStream::read_tag(FiffTag::SPtr &p_pTag,
                           fiff_long_t pos)
+{
+    p_pTag = FiffTag::SPtr(new FiffTag());
+
+    return read_tag_into(p_pTag, pos);
+}
+
+//=============================================================================================================
+
+bool FiffStream::read_tag_into(FiffTag::SPtr &p_pTag,
+                               fiff_long_t pos,
+                               bool bConvert)
 {
     if (pos >= 0) {
         this->device()->seek(pos);
     }
 
-    p_pTag = FiffTag::SPtr(new FiffTag());
+    if (!p_pTag)
+        p_pTag = FiffTag::SPtr(new FiffTag());
 
     //
     // Read fiff tag header from stream
@@ -1672,6 +1805,8 @@ bool FiffStream::read_tag(FiffTag::SPtr &p_pTag,
      *this  >> p_pTag->type;
     qint32 size;
      *this  >> size;
+    // Keep the capacity, a smaller tag must not shrink the buffer
+    p_pTag->reserve(qMax(size, p_pTag->capacity()));
     p_pTag->resize(size);
      *this  >> p_pTag->next;
 
@@ -1693,7 +1828,8 @@ bool FiffStream::read_tag(FiffTag::SPtr &p_pTag,
     {
         this->readRawData(p_pTag->data(), p_pTag->size());
         //FiffTag::convert_tag_data(p_pTag,FIFFV_BIG_ENDIAN,FIFFV_NATIVE_ENDIAN);
-        FiffTag::convert_tag_data(p_pTag,endian,FIFFV_NATIVE_ENDIAN);
+        if (bConvert)
+            FiffTag::convert_tag_data(p_pTag,endian,FIFFV_NATIVE_ENDIAN);
     }
 
     if (p_pTag->next != FIFFV_NEXT_SEQ)
@@ -1841,6 +1977,22 @@ bool FiffStream::setup_read_raw(QIODevice &p_IODevice,
                 case FIFFT_INT:
                     nsamp = ent->size/(4*nchan);
                     break;
+                case FIFFT_COMPRESSED_BUFFER:
+                {
+                    //
+                    //   The sample count is part of the compressed payload header
+                    //
+                    fiff_int_t iSampleType;
+                    qint32 iBufferChan;
+                    t_pStream->device()->seek(ent->pos + 16);
+                    QByteArray baHeader = t_pStream->device()->read(FiffCompressedBuffer::HEADER_SIZE);
+                    if(!FiffCompressedBuffer::readHeader(baHeader.constData(), baHeader.size(), iSampleType, iBufferChan, nsamp)
+                       || iBufferChan != nchan) {
+                        qWarning("Corrupt compressed data buffer at position %d\n",ent->pos);
+                        return false;
+                    }
+                    break;
+                }
                 default:
                     qWarning("Cannot handle data buffers of type %d\n",ent->type);
                     return false;
@@ -2018,12 +2170,13 @@ FiffStream::SPtr FiffStream::start_writing_raw(QIODevice &p_IODevice,
                                                const FiffInfo& info,
                                                RowVectorXd& cals,
                                                MatrixXi sel,
-                                               bool bResetRange)
+                                               bool bResetRange,
+                                               fiff_int_t iDataType)
 {
     //
-    //   We will always write floats
+    //   Floats unless the caller packs the data itself
     //
-    fiff_int_t data_type = 4;
+    fiff_int_t data_type = iDataType;
     qint32 k;
 
     if(sel.cols() == 0)
@@ -3140,6 +3293,56 @@ bool FiffStream::write_raw_buffer(const MatrixXd& buf)
 
 //=============================================================================================================
 
+bool FiffStream::write_compressed_raw_buffer(const MatrixXd& buf,
+                                             const RowVectorXd& cals,
+                                             fiff_int_t iDataType,
+                                             int iLevel)
+{
+    if (buf.rows() != cals.cols())
+    {
+        qWarning("buffer and calibration sizes do not match\n");
+        return false;
+    }
+
+    ArrayXXd scaled = buf.array().colwise() * cals.transpose().array().inverse();
+    QByteArray baPayload;
+
+    switch(iDataType)
+    {
+        case FIFFT_FLOAT:
+        {
+            MatrixXf tmp = scaled.matrix().cast<float>();
+            baPayload = FiffCompressedBuffer::compress(reinterpret_cast<const char*>(tmp.data()), iDataType, tmp.rows(), tmp.cols(), iLevel);
+            break;
+        }
+        case FIFFT_INT:
+        {
+            MatrixXi tmp = scaled.round().max(double(std::numeric_limits<qint32>::min())).min(double(std::numeric_limits<qint32>::max())).cast<int>().matrix();
+            baPayload = FiffCompressedBuffer::compress(reinterpret_cast<const char*>(tmp.data()), iDataType, tmp.rows(), tmp.cols(), iLevel);
+            break;
+        }
+        case FIFFT_SHORT:
+        {
+            MatrixShort tmp = scaled.round().max(double(std::numeric_limits<short>::min())).min(double(std::numeric_limits<short>::max())).cast<short>().matrix();
+            baPayload = FiffCompressedBuffer::compress(reinterpret_cast<const char*>(tmp.data()), iDataType, tmp.rows(), tmp.cols(), iLevel);
+            break;
+        }
+        default:
+            qWarning("Compressed raw buffers of type %d are not supported\n", iDataType);
+            return false;
+    }
+
+    *this << (qint32)FIFF_DATA_BUFFER;
+    *this << (qint32)FIFFT_COMPRESSED_BUFFER;
+    *this << (qint32)baPayload.size();
+    *this << (qint32)FIFFV_NEXT_SEQ;
+    this->writeRawData(baPayload.constData(), baPayload.size());
+
+    return true;
+}
+
+//=============================================================================================================
+
 fiff_long_t FiffStream::write_string(fiff_int_t kind,
                                      const QString& data)
 {
@@ -3174,37 +3377,68 @@ void FiffStream::write_rt_command(fiff_int_t command, const QString& data)
 
 QList<FiffDirEntry::SPtr> FiffStream::make_dir(bool *ok)
 {
-    FiffTag::SPtr t_pTag;
     QList<FiffDirEntry::SPtr> dir;
     FiffDirEntry::SPtr t_pFiffDirEntry;
-    fiff_long_t pos;
     if(ok) *ok = false;
     /*
      * Start from the very beginning...
      */
     if(!this->device()->seek(SEEK_SET))
         return dir;
-    while ((pos = this->read_tag_info(t_pTag)) != -1) {
+
+    const bool bLittleEndian = this->byteOrder() == QDataStream::LittleEndian;
+    const fiff_long_t iFileSize = this->device()->size();
+
+    /*
+     * Map the file if possible, the headers are then read without any system call
+     */
+    QFile* t_pFile = qobject_cast<QFile*>(this->device());
+    uchar* t_pMap = t_pFile ? t_pFile->map(0, iFileSize) : Q_NULLPTR;
+
+    const qint32 iHeaderSize = 4 * sizeof(qint32);
+    uchar t_header[iHeaderSize];
+    fiff_long_t pos = 0;
+    while (pos >= 0 && pos + iHeaderSize <= iFileSize) {
+        const uchar* t_pHeader = t_header;
+        if (t_pMap) {
+            t_pHeader = t_pMap + pos;
+        }
+        else if (!this->device()->seek(pos)
+                 || this->device()->read(reinterpret_cast<char*>(t_header), iHeaderSize) != iHeaderSize) {
+            break;
+        }
+
+        fiff_int_t kind = bLittleEndian ? qFromLittleEndian<qint32>(t_pHeader) : qFromBigEndian<qint32>(t_pHeader);
+        fiff_int_t type = bLittleEndian ? qFromLittleEndian<qint32>(t_pHeader + 4) : qFromBigEndian<qint32>(t_pHeader + 4);
+        fiff_int_t size = bLittleEndian ? qFromLittleEndian<qint32>(t_pHeader + 8) : qFromBigEndian<qint32>(t_pHeader + 8);
+        fiff_int_t next = bLittleEndian ? qFromLittleEndian<qint32>(t_pHeader + 12) : qFromBigEndian<qint32>(t_pHeader + 12);
+
         /*
         * Check that we haven't run into the directory
         */
-        if (t_pTag->kind == FIFF_DIR)
+        if (kind == FIFF_DIR)
             break;
         /*
         * Put in the new entry
         */
         t_pFiffDirEntry = FiffDirEntry::SPtr(new FiffDirEntry);
-        t_pFiffDirEntry->kind = t_pTag->kind;
-        t_pFiffDirEntry->type = t_pTag->type;
-        t_pFiffDirEntry->size = t_pTag->size();
-        t_pFiffDirEntry->pos = (fiff_long_t)pos;
+        t_pFiffDirEntry->kind = kind;
+        t_pFiffDirEntry->type = type;
+        t_pFiffDirEntry->size = size;
+        t_pFiffDirEntry->pos = pos;
 
-        //qDebug() << "Kind: " << t_pTag->kind << "| Type:" << t_pTag->type << "| Size" << t_pTag->size() << "| Next:" << t_pTag->next;
+        //qDebug() << "Kind: " << kind << "| Type:" << type << "| Size" << size << "| Next:" << next;
 
         dir.append(t_pFiffDirEntry);
-        if (t_pTag->next < 0)
+        if (next < 0 || size < 0)
             break;
+
+        pos = next > 0 ? (fiff_long_t)next : pos + iHeaderSize + size;
     }
+
+    if (t_pMap)
+        t_pFile->unmap(t_pMap);
+
     /*
      * Put in the new the terminating entry
      */
@@ -429,6 +429,23 @@ public:
     bool read_tag(QSharedPointer<FiffTag>& p_pTag,
                   fiff_long_t pos = -1);
 
+    //=========================================================================================================
+    /**
+     * Read one tag from a fif file into an existing tag. The payload buffer of the tag is kept and only grows,
+     * so bulk reads of tags with similar sizes (e.g. raw data buffers) do not allocate per tag. The tag must not
+     * be referenced elsewhere, its content is overwritten. A new tag is created if p_pTag is null.
+     *
+     * @param[in, out] p_pTag the tag to read into
+     * @param[in] pos position of the tag inside the fif file
+     * @param[in] bConvert whether to convert the payload to the native byte order. Without conversion the payload
+     *                     stays in the byte order of the stream (see byteOrder()), e.g. for FiffTag::decode_data_buffer.
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool read_tag_into(QSharedPointer<FiffTag>& p_pTag,
+                       fiff_long_t pos = -1,
+                       bool bConvert = true);
+
     //=========================================================================================================
     /**
      * fiff_setup_read_raw
@@ -473,6 +490,25 @@ public:
      */
     fiff_long_t start_block(fiff_int_t kind);
 
+    //=========================================================================================================
+    /**
+     * Enables the sidecar index for files without a tag directory. Such files (common for acquisition output) are
+     * otherwise scanned tag by tag on every open. The index holds the scanned directory and is kept in a
+     * UTILSLIB::FileCache keyed by file path, size, modification time and file id. Set this before opening files.
+     *
+     * @param[in] sCacheDir  Directory of the index files. If empty, the fiff_index directory in the cache location
+     *                       of the application is used.
+     * @param[in] iMaxBytes  The maximum size of all index files, the least recently used ones are removed first.
+     */
+    static void enable_sidecar_index(const QString& sCacheDir = QString(),
+                                     qint64 iMaxBytes = 64*1024*1024);
+
+    //=========================================================================================================
+    /**
+     * Disables the sidecar index.
+     */
+    static void disable_sidecar_index();
+
     //=========================================================================================================
     /**
      * Opens a fiff file for writing and writes the compulsory header tags
@@ -508,6 +544,8 @@ public:
      * @param[out] cals          A copy of the calibration values
      * @param[in] sel            Which channels will be included in the output file (optional)
      * @param[in] bResetRange    Flag whether to reset the channel range to 1.0. Default is true.
+     * @param[in] iDataType      The data type of the raw buffers which will follow (FIFFT_FLOAT, FIFFT_INT or FIFFT_SHORT).
+     *                           Integer types need the channel range, i.e., bResetRange should be false. Default is FIFFT_FLOAT.
      *
      * @return the started fiff file
      */
@@ -515,7 +553,8 @@ public:
                                               const FiffInfo& info,
                                               Eigen::RowVectorXd& cals,
                                               Eigen::MatrixXi sel = defaultMatrixXi,
-                                              bool bResetRange = true);
+                                              bool bResetRange = true,
+                                              fiff_int_t iDataType = FIFFT_FLOAT);
 
     //=========================================================================================================
     /**
@@ -836,6 +875,24 @@ public:
      */
     bool write_raw_buffer(const Eigen::MatrixXd& buf);
 
+    //=========================================================================================================
+    /**
+     * Writes a raw buffer as FIFF_DATA_BUFFER tag of type FIFFT_COMPRESSED_BUFFER, see FiffCompressedBuffer.
+     * The samples are divided by the calibration factors and stored as iDataType before compression, integer
+     * types are rounded and clipped. Readers recover the stored samples exactly.
+     *
+     * @param[in] buf        the buffer to write
+     * @param[in] cals       calibration factors
+     * @param[in] iDataType  sample type inside the compressed buffer (FIFFT_FLOAT, FIFFT_INT or FIFFT_SHORT)
+     * @param[in] iLevel     zlib compression level (0-9, -1 for the zlib default)
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool write_compressed_raw_buffer(const Eigen::MatrixXd& buf,
+                                     const Eigen::RowVectorXd& cals,
+                                     fiff_int_t iDataType = FIFFT_FLOAT,
+                                     int iLevel = -1);
+
     //=========================================================================================================
     /**
      * Writes a string tag
@@ -871,7 +928,8 @@ private:
 
     //=========================================================================================================
     /**
-     * Scan the tag list to create a directory
+     * Scan the tag list to create a directory. Only the 16 byte tag headers are read, payloads are skipped
+     * without being loaded. Files are scanned through a memory mapping when possible.
      * Refactored: fiff_make_dir (fiff_dir.c)
      *
      * @param[out] ok    If a conversion error occurs, *ok is set to false; otherwise *ok is set to true.
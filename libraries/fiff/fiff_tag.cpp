@@ -42,7 +42,9 @@
 #include <utils/ioutils.h>
 
 #include <complex>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -57,6 +59,121 @@
 using namespace UTILSLIB;
 using namespace FIFFLIB;
 
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+namespace
+{
+
+//=============================================================================================================
+/**
+ * Decodes nchan x nsamp values of type In into matData. The payload is copied chunk wise into a small scratch
+ * buffer which stays in cache while it is swapped, converted and scaled.
+ */
+template<typename In, typename Out>
+void decodeTyped(const char* pData,
+                 bool bSwap,
+                 qint32 nchan,
+                 qint32 nsamp,
+                 Eigen::Matrix<Out, Eigen::Dynamic, Eigen::Dynamic>& matData,
+                 const Eigen::RowVectorXd& cals)
+{
+    const qint32 iChunkCols = qMax(1, 4096 / qMax(nchan, 1));
+    std::vector<In> vecScratch(static_cast<size_t>(iChunkCols) * nchan);
+    const bool bCalibrate = cals.size() == nchan;
+    Eigen::Array<Out, Eigen::Dynamic, 1> arrCals;
+    if(bCalibrate) {
+        arrCals = cals.transpose().cast<Out>().array();
+    }
+
+    for(qint32 s = 0; s < nsamp; s += iChunkCols) {
+        const qint32 nCols = qMin(iChunkCols, nsamp - s);
+        const qint64 iCount = static_cast<qint64>(nCols) * nchan;
+        memcpy(vecScratch.data(), pData + static_cast<qint64>(s) * nchan * sizeof(In), iCount * sizeof(In));
+
+        if(bSwap) {
+            switch(sizeof(In)) {
+                case 2: IOUtils::swap_16(vecScratch.data(), iCount); break;
+                case 4: IOUtils::swap_32(vecScratch.data(), iCount); break;
+                case 8: IOUtils::swap_64(vecScratch.data(), iCount); break;
+            }
+        }
+
+        Eigen::Map<const Eigen::Matrix<In, Eigen::Dynamic, Eigen::Dynamic> > matIn(vecScratch.data(), nchan, nCols);
+        if(bCalibrate) {
+            matData.middleCols(s, nCols) = (matIn.template cast<Out>().array().colwise() * arrCals).matrix();
+        } else {
+            matData.middleCols(s, nCols) = matIn.template cast<Out>();
+        }
+    }
+}
+
+//=============================================================================================================
+/**
+ * Dispatches decode_data_buffer on the fiff type.
+ */
+template<typename Out>
+bool decodeDataBuffer(const char* pData,
+                      qint64 iSize,
+                      fiff_int_t iType,
+                      int iFromEndian,
+                      qint32 nchan,
+                      qint32 nsamp,
+                      Eigen::Matrix<Out, Eigen::Dynamic, Eigen::Dynamic>& matData,
+                      const Eigen::RowVectorXd& cals)
+{
+    int iWidth;
+    switch(iType) {
+        case FIFFT_DAU_PACK16:
+        case FIFFT_SHORT:
+            iWidth = 2;
+            break;
+        case FIFFT_INT:
+        case FIFFT_FLOAT:
+            iWidth = 4;
+            break;
+        case FIFFT_DOUBLE:
+            iWidth = 8;
+            break;
+        default:
+            return false;
+    }
+
+    if(nchan <= 0 || nsamp < 0 || iSize < static_cast<qint64>(nchan) * nsamp * iWidth) {
+        return false;
+    }
+
+    if(matData.rows() != nchan || matData.cols() != nsamp) {
+        matData.resize(nchan, nsamp);
+    }
+
+    if(iFromEndian == FIFFV_NATIVE_ENDIAN) {
+        iFromEndian = NATIVE_ENDIAN;
+    }
+    const bool bSwap = iFromEndian != NATIVE_ENDIAN;
+
+    switch(iType) {
+        case FIFFT_DAU_PACK16:
+        case FIFFT_SHORT:
+            decodeTyped<qint16, Out>(pData, bSwap, nchan, nsamp, matData, cals);
+            break;
+        case FIFFT_INT:
+            decodeTyped<qint32, Out>(pData, bSwap, nchan, nsamp, matData, cals);
+            break;
+        case FIFFT_FLOAT:
+            decodeTyped<float, Out>(pData, bSwap, nchan, nsamp, matData, cals);
+            break;
+        case FIFFT_DOUBLE:
+            decodeTyped<double, Out>(pData, bSwap, nchan, nsamp, matData, cals);
+            break;
+    }
+
+    return true;
+}
+
+} // namespace
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -471,10 +588,7 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
     int            k,r;//,c;
     char           *offset;
     fiff_int_t     *ithis;
-    fiff_short_t   *sthis;
-    fiff_long_t    *lthis;
     float          *fthis;
-    double         *dthis;
 //    fiffDirEntry   dethis;
 //    fiffId         idthis;
 //    fiffChInfoRec* chthis;//FiffChInfo*     chthis;//ToDo adapt parsing to the new class
@@ -507,38 +621,22 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
     case FIFFT_INT :
     case FIFFT_UINT :
     case FIFFT_JULIAN :
-        np = tag->size()/sizeof(fiff_int_t);
-        for (ithis = (fiff_int_t *)tag->data(), k = 0; k < np; k++, ithis++)
-            IOUtils::swap_intp(ithis);
+    case FIFFT_FLOAT :
+    case FIFFT_COMPLEX_FLOAT :
+        IOUtils::swap_32(tag->data(), tag->size()/4);
         break;
 
     case FIFFT_LONG :
     case FIFFT_ULONG :
-        np = tag->size()/sizeof(fiff_long_t);
-        for (lthis = (fiff_long_t *)tag->data(), k = 0; k < np; k++, lthis++)
-            IOUtils::swap_longp(lthis);
+    case FIFFT_DOUBLE :
+    case FIFFT_COMPLEX_DOUBLE :
+        IOUtils::swap_64(tag->data(), tag->size()/8);
         break;
 
     case FIFFT_SHORT :
     case FIFFT_DAU_PACK16 :
     case FIFFT_USHORT :
-        np = tag->size()/sizeof(fiff_short_t);
-        for (sthis = (fiff_short_t *)tag->data(), k = 0; k < np; k++, sthis++)
-            *sthis = IOUtils::swap_short(*sthis);
-        break;
-
-    case FIFFT_FLOAT :
-    case FIFFT_COMPLEX_FLOAT :
-        np = tag->size()/sizeof(fiff_float_t);
-        for (fthis = (fiff_float_t *)tag->data(), k = 0; k < np; k++, fthis++)
-            IOUtils::swap_floatp(fthis);
-        break;
-
-    case FIFFT_DOUBLE :
-    case FIFFT_COMPLEX_DOUBLE :
-        np = tag->size()/sizeof(fiff_double_t);
-        for (dthis = (fiff_double_t *)tag->data(), k = 0; k < np; k++, dthis++)
-            IOUtils::swap_doublep(dthis);
+        IOUtils::swap_16(tag->data(), tag->size()/2);
         break;
 
     case FIFFT_OLD_PACK :
@@ -548,10 +646,8 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
      */
         IOUtils::swap_floatp(fthis+0);
         IOUtils::swap_floatp(fthis+1);
-        sthis = (short *)(fthis+2);
         np = (tag->size() - 2*sizeof(float))/sizeof(short);
-        for (k = 0; k < np; k++,sthis++)
-            *sthis = IOUtils::swap_short(*sthis);
+        IOUtils::swap_16(fthis+2, np);
         break;
 
     case FIFFT_DIR_ENTRY_STRUCT :
@@ -717,6 +813,34 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
     return;
 }
 
+//=============================================================================================================
+
+bool FiffTag::decode_data_buffer(const char* pData,
+                                 qint64 iSize,
+                                 fiff_int_t iType,
+                                 int iFromEndian,
+                                 qint32 nchan,
+                                 qint32 nsamp,
+                                 Eigen::MatrixXd& matData,
+                                 const Eigen::RowVectorXd& cals)
+{
+    return decodeDataBuffer<double>(pData, iSize, iType, iFromEndian, nchan, nsamp, matData, cals);
+}
+
+//=============================================================================================================
+
+bool FiffTag::decode_data_buffer(const char* pData,
+                                 qint64 iSize,
+                                 fiff_int_t iType,
+                                 int iFromEndian,
+                                 qint32 nchan,
+                                 qint32 nsamp,
+                                 Eigen::MatrixXf& matData,
+                                 const Eigen::RowVectorXd& cals)
+{
+    return decodeDataBuffer<float>(pData, iSize, iType, iFromEndian, nchan, nsamp, matData, cals);
+}
+
 //=============================================================================================================
 //fiff_type_spec
 
@@ -468,6 +468,46 @@ public:
      */
     static void convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian);
 
+    //=========================================================================================================
+    /**
+     * Decodes a raw data buffer payload (nchan x nsamp, channels running fastest) straight from the file byte
+     * order into a calibrated matrix. Swapping, type conversion and calibration are done in one pass over cache
+     * sized chunks, without converting the tag in place first. Supported types are FIFFT_DAU_PACK16,
+     * FIFFT_SHORT, FIFFT_INT, FIFFT_FLOAT and FIFFT_DOUBLE.
+     *
+     * @param[in] pData          raw payload as read from the file.
+     * @param[in] iSize          size of the payload in bytes.
+     * @param[in] iType          fiff type of the payload.
+     * @param[in] iFromEndian    byte order of the payload (FIFFV_LITTLE_ENDIAN, FIFFV_BIG_ENDIAN or FIFFV_NATIVE_ENDIAN).
+     * @param[in] nchan          number of channels.
+     * @param[in] nsamp          number of samples.
+     * @param[out] matData       the decoded data, resized to nchan x nsamp if needed.
+     * @param[in] cals           per channel calibration factors, no calibration is applied if empty.
+     *
+     * @return true if succeeded, false if the type is not supported or the payload is too small.
+     */
+    static bool decode_data_buffer(const char* pData,
+                                   qint64 iSize,
+                                   fiff_int_t iType,
+                                   int iFromEndian,
+                                   qint32 nchan,
+                                   qint32 nsamp,
+                                   Eigen::MatrixXd& matData,
+                                   const Eigen::RowVectorXd& cals = Eigen::RowVectorXd());
+
+    //=========================================================================================================
+    /**
+     * Single precision version of decode_data_buffer.
+     */
+    static bool decode_data_buffer(const char* pData,
+                                   qint64 iSize,
+                                   fiff_int_t iType,
+                                   int iFromEndian,
+                                   qint32 nchan,
+                                   qint32 nsamp,
+                                   Eigen::MatrixXf& matData,
+                                   const Eigen::RowVectorXd& cals = Eigen::RowVectorXd());
+
     //
     // from fiff_type_spec.c
     //
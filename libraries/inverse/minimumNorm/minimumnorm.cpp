@@ -44,6 +44,7 @@
 #include <fiff/fiff_evoked.h>
 
 #include <iostream>
+#include <cmath>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -61,12 +62,56 @@ using namespace INVERSELIB;
 using namespace UTILSLIB;
 using namespace FIFFLIB;
 
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+template<typename T>
+static MatrixXd combineAndNormalize(const Matrix<T,Dynamic,Dynamic>& matSol,
+                                    bool bCombineXyz,
+                                    const VectorXd& vecNoiseNorm)
+{
+    // Combine the current components and apply the noise normalization in a single pass over the solution.
+    // The caller checks that a non-empty noise normalization matches the number of sources.
+    const qint32 iStep = bCombineXyz ? 3 : 1;
+    const qint32 iNumSources = matSol.rows() / iStep;
+    const bool bNoiseNorm = vecNoiseNorm.size() > 0;
+
+    MatrixXd matResult(iNumSources, matSol.cols());
+
+    for(qint32 t = 0; t < matSol.cols(); ++t) {
+        const T* pSol = matSol.data() + t * matSol.rows();
+        double* pResult = matResult.data() + t * iNumSources;
+
+        for(qint32 i = 0; i < iNumSources; ++i) {
+            double dValue;
+
+            if(bCombineXyz) {
+                const double x = pSol[3*i];
+                const double y = pSol[3*i+1];
+                const double z = pSol[3*i+2];
+                dValue = std::sqrt(x*x + y*y + z*z);
+            } else {
+                dValue = pSol[i];
+            }
+
+            pResult[i] = bNoiseNorm ? dValue * vecNoiseNorm[i] : dValue;
+        }
+    }
+
+    return matResult;
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
 
 MinimumNorm::MinimumNorm(const MNEInverseOperator &p_inverseOperator, float lambda, const QString method)
 : m_inverseOperator(p_inverseOperator)
+, m_bFactoredKernel(false)
+, m_bFloatPrecision(false)
+, m_bKernelFactored(false)
+, m_bKernelFloat(false)
 , inverseSetup(false)
 {
     this->setRegularization(lambda);
@@ -77,6 +122,10 @@ MinimumNorm::MinimumNorm(const MNEInverseOperator &p_inverseOperator, float lamb
 
 MinimumNorm::MinimumNorm(const MNEInverseOperator &p_inverseOperator, float lambda, bool dSPM, bool sLORETA)
 : m_inverseOperator(p_inverseOperator)
+, m_bFactoredKernel(false)
+, m_bFloatPrecision(false)
+, m_bKernelFactored(false)
+, m_bKernelFloat(false)
 , inverseSetup(false)
 {
     this->setRegularization(lambda);
@@ -188,38 +237,63 @@ MNESourceEstimate MinimumNorm::calculateInverse(const MatrixXd &data, float tmin
         return MNESourceEstimate();
     }
 
-    if(K.cols() != data.rows()) {
-        qWarning() << "MinimumNorm::calculateInverse - Dimension mismatch between K.cols() and data.rows() -" << K.cols() << "and" << data.rows();
+    // Branch on the kernel layout latched by doInverseSetup, the setters only take effect with the next setup
+    const qint32 iNumKernelRows = m_bKernelFactored ? m_matKernelLeads.rows() : K.rows();
+    const qint32 iNumKernelCols = m_bKernelFactored ? m_matKernelTrans.cols() : K.cols();
+
+    if(iNumKernelCols != data.rows()) {
+        qWarning() << "MinimumNorm::calculateInverse - Dimension mismatch between K.cols() and data.rows() -" << iNumKernelCols << "and" << data.rows();
         return MNESourceEstimate();
     }
 
-    MatrixXd sol = K * data; //apply imaging kernel
+    const bool bCombineXyz = (inv.source_ori == FIFFV_MNE_FREE_ORI && pick_normal == false);
+    const qint32 iNumSources = bCombineXyz ? iNumKernelRows / 3 : iNumKernelRows;
 
-    if (inv.source_ori == FIFFV_MNE_FREE_ORI && pick_normal == false)
-    {
-        printf("combining the current components...\n");
+    if(m_vecNoiseNorm.size() > 0 && m_vecNoiseNorm.size() != iNumSources) {
+        qWarning() << "MinimumNorm::calculateInverse - Dimension mismatch between the noise normalization and the number of sources -" << m_vecNoiseNorm.size() << "and" << iNumSources;
+        return MNESourceEstimate();
+    }
 
-        MatrixXd sol1(sol.rows()/3,sol.cols());
-        for(qint32 i = 0; i < sol.cols(); ++i)
-        {
-            VectorXd* tmp = MNEMath::combine_xyz(sol.col(i));
-            sol1.block(0,i,sol.rows()/3,1) = tmp->cwiseSqrt();
-            delete tmp;
-        }
-        sol.resize(sol1.rows(),sol1.cols());
-        sol = sol1;
+    if(bCombineXyz) {
+        printf("combining the current components...\n");
     }
 
-    if (m_bdSPM)
-    {
+    if (m_bdSPM) {
         printf("(dSPM)...");
-        sol = inv.noisenorm*sol;
-    }
-    else if (m_bsLORETA)
-    {
+    } else if (m_bsLORETA) {
         printf("(sLORETA)...");
-        sol = inv.noisenorm*sol;
     }
+
+    //apply imaging kernel, combine the current components and noise normalize in one pass
+    MatrixXd sol;
+
+    if(m_bKernelFloat) {
+        MatrixXf matData = data.cast<float>();
+        MatrixXf solF;
+
+        if(m_bKernelFactored) {
+            solF.noalias() = m_matKernelLeadsF * (m_matKernelTransF * matData);
+        } else {
+            solF.noalias() = m_matKernelF * matData;
+        }
+
+        sol = combineAndNormalize(solF, bCombineXyz, m_vecNoiseNorm);
+    } else {
+        MatrixXd solD;
+
+        if(m_bKernelFactored) {
+            solD.noalias() = m_matKernelLeads * (m_matKernelTrans * data);
+        } else {
+            solD.noalias() = K * data;
+        }
+
+        if(bCombineXyz || m_vecNoiseNorm.size() > 0) {
+            sol = combineAndNormalize(solD, bCombineXyz, m_vecNoiseNorm);
+        } else {
+            sol.swap(solD);
+        }
+    }
+
     printf("[done]\n");
 
     //Results
@@ -242,10 +316,40 @@ void MinimumNorm::doInverseSetup(qint32 nave, bool pick_normal)
     //
     inv = m_inverseOperator.prepare_inverse_operator(nave, m_fLambda, m_bdSPM, m_bsLORETA);
 
+    // Latch the kernel layout, calculateInverse has to match the kernels assembled here
+    m_bKernelFactored = m_bFactoredKernel;
+    m_bKernelFloat = m_bFloatPrecision;
+
     printf("Computing inverse...\n");
-    inv.assemble_kernel(label, m_sMethod, pick_normal, K, noise_norm, vertno);
+    if(m_bKernelFactored) {
+        K.resize(0,0);
+        inv.assemble_kernel_factors(label, m_sMethod, pick_normal, m_matKernelLeads, m_matKernelTrans, noise_norm, vertno);
+
+        std::cout << "K " << m_matKernelLeads.rows() << " x " << m_matKernelLeads.cols() << " * " << m_matKernelTrans.rows() << " x " << m_matKernelTrans.cols() << std::endl;
+    } else {
+        m_matKernelLeads.resize(0,0);
+        m_matKernelTrans.resize(0,0);
+        inv.assemble_kernel(label, m_sMethod, pick_normal, K, noise_norm, vertno);
+
+        std::cout << "K " << K.rows() << " x " << K.cols() << std::endl;
+    }
 
-    std::cout << "K " << K.rows() << " x " << K.cols() << std::endl;
+    if(m_bKernelFloat) {
+        m_matKernelF = K.cast<float>();
+        m_matKernelLeadsF = m_matKernelLeads.cast<float>();
+        m_matKernelTransF = m_matKernelTrans.cast<float>();
+    } else {
+        m_matKernelF.resize(0,0);
+        m_matKernelLeadsF.resize(0,0);
+        m_matKernelTransF.resize(0,0);
+    }
+
+    // The noise normalization is diagonal, keep only its diagonal for the fused application
+    if(m_bdSPM || m_bsLORETA) {
+        m_vecNoiseNorm = inv.noisenorm.diagonal();
+    } else {
+        m_vecNoiseNorm.resize(0);
+    }
 
     inverseSetup = true;
 }
@@ -314,3 +418,17 @@ void MinimumNorm::setRegularization(float lambda)
 {
     m_fLambda = lambda;
 }
+
+//=============================================================================================================
+
+void MinimumNorm::setFactoredKernel(bool bFactoredKernel)
+{
+    m_bFactoredKernel = bFactoredKernel;
+}
+
+//=============================================================================================================
+
+void MinimumNorm::setFloatPrecision(bool bFloatPrecision)
+{
+    m_bFloatPrecision = bFloatPrecision;
+}
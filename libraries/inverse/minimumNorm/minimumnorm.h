@@ -175,7 +175,26 @@ public:
 
     //=========================================================================================================
     /**
-     * Get the assembled kernel
+     * Keep the imaging kernel in factored form (whitened SVD factors) instead of assembling the dense
+     * n_sources x n_channels kernel. The kernel is then applied as two thin matrix products. Takes effect with
+     * the next call of doInverseSetup.
+     *
+     * @param[in] bFactoredKernel   Whether to keep the kernel in factored form.
+     */
+    void setFactoredKernel(bool bFactoredKernel);
+
+    //=========================================================================================================
+    /**
+     * Apply the imaging kernel in single (float) precision. The resulting source estimate is still returned in
+     * double precision. Takes effect with the next call of doInverseSetup.
+     *
+     * @param[in] bFloatPrecision   Whether to apply the kernel in float precision.
+     */
+    void setFloatPrecision(bool bFloatPrecision);
+
+    //=========================================================================================================
+    /**
+     * Get the assembled kernel. The kernel is empty when the inverse was set up with a factored kernel.
      *
      * @return the assembled kernel
      */
@@ -187,6 +206,10 @@ private:
     QString m_sMethod;                              /**< Selected method */
     bool m_bsLORETA;                                /**< Do sLORETA method */
     bool m_bdSPM;                                   /**< Do dSPM method */
+    bool m_bFactoredKernel;                         /**< Keep the imaging kernel in factored form */
+    bool m_bFloatPrecision;                         /**< Apply the imaging kernel in float precision */
+    bool m_bKernelFactored;                         /**< m_bFactoredKernel at the time of the last inverse setup */
+    bool m_bKernelFloat;                            /**< m_bFloatPrecision at the time of the last inverse setup */
 
     bool inverseSetup;                              /**< Inverse Setup Calcluated */
     MNELIB::MNEInverseOperator inv;                 /**< The setup inverse operator */
@@ -194,6 +217,12 @@ private:
     QList<Eigen::VectorXi> vertno;                  /**< The vertices numbers */
     FSLIB::Label label;                             /**< The corresponding labels */
     Eigen::MatrixXd K;                              /**< Imaging kernel */
+    Eigen::MatrixXd m_matKernelLeads;               /**< Left factor of the imaging kernel (n_sources x rank) */
+    Eigen::MatrixXd m_matKernelTrans;               /**< Right factor of the imaging kernel (rank x n_channels) */
+    Eigen::MatrixXf m_matKernelF;                   /**< Imaging kernel in float precision */
+    Eigen::MatrixXf m_matKernelLeadsF;              /**< Left factor of the imaging kernel in float precision */
+    Eigen::MatrixXf m_matKernelTransF;              /**< Right factor of the imaging kernel in float precision */
+    Eigen::VectorXd m_vecNoiseNorm;                 /**< Diagonal of the noise normalization, empty for MNE */
 };
 
 //=============================================================================================================
@@ -194,6 +194,10 @@ MNESourceEstimate PwlRapMusic::calculateInverse(const MatrixXd& p_matMeasurement
         clock_t start_subcorr, end_subcorr;
         start_subcorr = clock();
 
+        //Precompute the projected gain blocks shared by all pairs
+        SubcorrData t_subcorrData;
+        calcSubcorrData(t_matProj_LeadField, t_matU_B, t_subcorrData);
+
         double t_val_roh_k;
 
         //Powell
@@ -226,16 +230,11 @@ MNESourceEstimate PwlRapMusic::calculateInverse(const MatrixXd& p_matMeasurement
                 for(int i = 0; i < t_iNumVecElements; i++)
                 {
                     int k = t_pVecIdxElements(i);
-                    //new Version: calculate matrix multiplication before
-                    //Create Lead Field combinations -> It would be better to use a pointer construction, to increase performance
-                    MatrixX6T t_matProj_G(t_matProj_LeadField.rows(),6);
-
-                    int idx1 = m_ppPairIdxCombinations[k]->x1;
-                    int idx2 = m_ppPairIdxCombinations[k]->x2;
 
-                    RapMusic::getGainMatrixPair(t_matProj_LeadField, t_matProj_G, idx1, idx2);
+                    int idx1, idx2;
+                    RapMusic::getPointPair(m_iNumGridPoints, k, idx1, idx2);
 
-                    t_vecRoh(k) = RapMusic::subcorr(t_matProj_G, t_matU_B);//t_vecRoh holds the correlations roh_k
+                    t_vecRoh(k) = subcorr(t_subcorrData, idx1, idx2);//t_vecRoh holds the correlations roh_k
                 }
             }
 
@@ -270,8 +269,7 @@ MNESourceEstimate PwlRapMusic::calculateInverse(const MatrixXd& p_matMeasurement
             {
                 t_iMaxIdx_old = t_iMaxIdx;
                 //get positions in sparsed leadfield from index combinations;
-                t_iIdx1 = m_ppPairIdxCombinations[t_iMaxIdx]->x1;
-                t_iIdx2 = m_ppPairIdxCombinations[t_iMaxIdx]->x2;
+                RapMusic::getPointPair(m_iNumGridPoints, t_iMaxIdx, t_iIdx1, t_iIdx2);
             }
 
             //set new index
@@ -41,10 +41,20 @@
 
 #include <utils/mnemath.h>
 
+#include <algorithm>
+#include <limits>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtConcurrent>
+#include <QThread>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
@@ -64,8 +74,8 @@ RapMusic::RapMusic()
 , m_iNumGridPoints(0)
 , m_iNumChannels(0)
 , m_iNumLeadFieldCombinations(0)
-, m_ppPairIdxCombinations(NULL)
 , m_iMaxNumThreads(1)
+, m_bFloatPrecision(false)
 , m_bIsInit(false)
 , m_iSamplesStcWindow(-1)
 , m_fStcOverlap(-1)
@@ -80,8 +90,8 @@ RapMusic::RapMusic(MNEForwardSolution& p_pFwd, bool p_bSparsed, int p_iN, double
 , m_iNumGridPoints(0)
 , m_iNumChannels(0)
 , m_iNumLeadFieldCombinations(0)
-, m_ppPairIdxCombinations(NULL)
 , m_iMaxNumThreads(1)
+, m_bFloatPrecision(false)
 , m_bIsInit(false)
 , m_iSamplesStcWindow(-1)
 , m_fStcOverlap(-1)
@@ -94,8 +104,6 @@ RapMusic::RapMusic(MNEForwardSolution& p_pFwd, bool p_bSparsed, int p_iN, double
 
 RapMusic::~RapMusic()
 {
-    if(m_ppPairIdxCombinations != NULL)
-        free(m_ppPairIdxCombinations);
 }
 
 //=============================================================================================================
@@ -107,8 +115,8 @@ bool RapMusic::init(MNEForwardSolution& p_pFwd, bool p_bSparsed, int p_iN, doubl
         std::cout << "OpenMP enabled" << std::endl;
         m_iMaxNumThreads = omp_get_max_threads();
     #else
-        std::cout << "OpenMP disabled (to enable it: VS2010->Project Properties->C/C++->Language, then modify OpenMP Support)" << std::endl;
-        m_iMaxNumThreads = 1;
+        std::cout << "OpenMP disabled -> using the Qt thread pool" << std::endl;
+        m_iMaxNumThreads = QThread::idealThreadCount();
     #endif
         std::cout << "Available Threats: " << m_iMaxNumThreads << std::endl << std::endl;
 
@@ -148,20 +156,9 @@ bool RapMusic::init(MNEForwardSolution& p_pFwd, bool p_bSparsed, int p_iN, doubl
 
     m_ForwardSolution = p_pFwd;
 
-    //##### Calc lead field combination #####
-
-    std::cout << "Calculate gain matrix combinations. \n";
-
+    //Lead field combinations are generated on the fly during the scan -> only their number is needed here
     m_iNumLeadFieldCombinations = MNEMath::nchoose2(m_iNumGridPoints+1);
 
-    m_ppPairIdxCombinations = (Pair **)malloc(m_iNumLeadFieldCombinations * sizeof(Pair *));
-
-    calcPairCombinations(m_iNumGridPoints, m_iNumLeadFieldCombinations, m_ppPairIdxCombinations);
-
-    std::cout << "Gain matrix combinations calculated. \n\n";
-
-    //##### Calc lead field combination end #####
-
     std::cout << "Number of grid points: " << m_iNumGridPoints << "\n\n";
 
     std::cout << "Number of combinated points: " << m_iNumLeadFieldCombinations << "\n\n";
@@ -459,53 +456,18 @@ MNESourceEstimate RapMusic::calculateInverse(const MatrixXd& p_matMeasurement, Q
         MatrixXT t_matU_B;
         useFullRank(t_svdProj_Phi_S.matrixU(), t_svdProj_Phi_S.singularValues().asDiagonal(), t_matU_B);
 
-        //Inits
-        VectorXT t_vecRoh(m_iNumLeadFieldCombinations,1);
-        t_vecRoh.setZero();
-
         //subcorr benchmark
         //Stop the time
         clock_t start_subcorr, end_subcorr;
         start_subcorr = clock();
 
-        //Multithreading correlation calculation
-        #ifdef _OPENMP
-        #pragma omp parallel num_threads(m_iMaxNumThreads)
-        #endif
-        {
-        #ifdef _OPENMP
-        #pragma omp for
-        #endif
-            for(int i = 0; i < m_iNumLeadFieldCombinations; i++)
-            {
-                //new Version: calculate matrix multiplication before
-                //Create Lead Field combinations -> It would be better to use a pointer construction, to increase performance
-                MatrixX6T t_matProj_G(t_matProj_LeadField.rows(),6);
-
-                int idx1 = m_ppPairIdxCombinations[i]->x1;
-                int idx2 = m_ppPairIdxCombinations[i]->x2;
-
-                RapMusic::getGainMatrixPair(t_matProj_LeadField, t_matProj_G, idx1, idx2);
-
-                t_vecRoh(i) = RapMusic::subcorr(t_matProj_G, t_matU_B);//t_vecRoh holds the correlations roh_k
-            }
-        }
+        //Precompute the projected gain blocks shared by all pairs and scan all combinations multithreaded
+        SubcorrData t_subcorrData;
+        calcSubcorrData(t_matProj_LeadField, t_matU_B, t_subcorrData);
 
-//         if(r==0)
-//         {
-//             std::fstream filestr;
-//             std::stringstream filename;
-//             filename << "Roh_gold.txt";
-//
-//             filestr.open ( filename.str().c_str(), std::fstream::out);
-//             for(int i = 0; i < m_iNumLeadFieldCombinations; ++i)
-//             {
-//               filestr << t_vecRoh(i) << "\n";
-//             }
-//             filestr.close();
-//
-//             //exit(0);
-//         }
+        int t_iIdx1 = 0;
+        int t_iIdx2 = 0;
+        double t_val_roh_k = scanPairCombinations(t_subcorrData, t_iIdx1, t_iIdx2);//p_vecCor = ^roh_k
 
         //subcorr benchmark
         end_subcorr = clock();
@@ -513,17 +475,6 @@ MNESourceEstimate RapMusic::calculateInverse(const MatrixXd& p_matMeasurement, Q
         float t_fSubcorrElapsedTime = ( (float)(end_subcorr-start_subcorr) / (float)CLOCKS_PER_SEC ) * 1000.0f;
         std::cout << "Time Elapsed: " << t_fSubcorrElapsedTime << " ms" << std::endl;
 
-        //Find the maximum of correlation - can't put this in the for loop because it's running in different threads.
-        double t_val_roh_k;
-
-        VectorXT::Index t_iMaxIdx;
-
-        t_val_roh_k = t_vecRoh.maxCoeff(&t_iMaxIdx);//p_vecCor = ^roh_k
-
-        //get positions in sparsed leadfield from index combinations;
-        int t_iIdx1 = m_ppPairIdxCombinations[t_iMaxIdx]->x1;
-        int t_iIdx2 = m_ppPairIdxCombinations[t_iMaxIdx]->x2;
-
         // (Idx+1) because of MATLAB positions -> starting with 1 not with 0
         std::cout << "Iteration: " << r+1 << " of " << t_iMaxSearch
             << "; Correlation: " << t_val_roh_k<< "; Position (Idx+1): " << t_iIdx1+1 << " - " << t_iIdx2+1 <<"\n\n";
@@ -737,6 +688,183 @@ double RapMusic::subcorr(MatrixX6T& p_matProj_G, const MatrixXT& p_matU_B, Vecto
 
 //=============================================================================================================
 
+template<typename T>
+static void calcGramDiag(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& p_matG,
+                         Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& p_matGramDiag)
+{
+    p_matGramDiag.resize(3, p_matG.cols());
+
+    for(int i = 0; i < p_matG.cols(); i += 3) {
+        p_matGramDiag.template middleCols<3>(i).noalias() = p_matG.template middleCols<3>(i).transpose() * p_matG.template middleCols<3>(i);
+    }
+}
+
+//=============================================================================================================
+
+template<typename T>
+static double calcPairSubcorr(const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& p_matProj_LeadField,
+                              const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& p_matW,
+                              const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& p_matGramG,
+                              const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& p_matGramW,
+                              int p_iIdx1,
+                              int p_iIdx2)
+{
+    typedef Eigen::Matrix<T, 3, 3> Matrix3;
+
+    const int iCol1 = p_iIdx1*3;
+    const int iCol2 = p_iIdx2*3;
+
+    //B = G^T*G of the pair, assembled from the precomputed diagonal blocks and the cross term
+    Matrix3 matCrossG;
+    matCrossG.noalias() = p_matProj_LeadField.template middleCols<3>(iCol1).transpose() * p_matProj_LeadField.template middleCols<3>(iCol2);
+
+    RapMusic::Matrix6T matB;
+    matB.topLeftCorner<3,3>() = p_matGramG.template middleCols<3>(iCol1).template cast<double>();
+    matB.topRightCorner<3,3>() = matCrossG.template cast<double>();
+    matB.bottomLeftCorner<3,3>() = matCrossG.transpose().template cast<double>();
+    matB.bottomRightCorner<3,3>() = p_matGramG.template middleCols<3>(iCol2).template cast<double>();
+
+    //A = G^T*U_B*U_B^T*G = W^T*W of the pair
+    Matrix3 matCrossW;
+    matCrossW.noalias() = p_matW.template middleCols<3>(iCol1).transpose() * p_matW.template middleCols<3>(iCol2);
+
+    RapMusic::Matrix6T matA;
+    matA.topLeftCorner<3,3>() = p_matGramW.template middleCols<3>(iCol1).template cast<double>();
+    matA.topRightCorner<3,3>() = matCrossW.template cast<double>();
+    matA.bottomLeftCorner<3,3>() = matCrossW.transpose().template cast<double>();
+    matA.bottomRightCorner<3,3>() = p_matGramW.template middleCols<3>(iCol2).template cast<double>();
+
+    //Whiten with B restricted to the rank of the pair (singular values of G > 10^-5, same as getRank)
+    Eigen::SelfAdjointEigenSolver<RapMusic::Matrix6T> t_eigB(matB);
+    const RapMusic::Vector6T& vecEigB = t_eigB.eigenvalues();
+
+    RapMusic::Matrix6T matZ = RapMusic::Matrix6T::Zero();
+    for(int k = 5; k >= 0; --k) {
+        if(k < 5 && vecEigB(k) <= 0.00001*0.00001) {
+            break;
+        }
+        matZ.col(k) = t_eigB.eigenvectors().col(k) / std::sqrt(std::max(vecEigB(k), std::numeric_limits<double>::min()));
+    }
+
+    //The squared subspace correlation is the largest eigenvalue of Z^T*A*Z
+    RapMusic::Matrix6T matC = matZ.transpose() * matA * matZ;
+    Eigen::SelfAdjointEigenSolver<RapMusic::Matrix6T> t_eigC(matC, Eigen::EigenvaluesOnly);
+
+    return std::sqrt(std::max(t_eigC.eigenvalues()(5), 0.0));
+}
+
+//=============================================================================================================
+
+void RapMusic::calcSubcorrData(const MatrixXT& p_matProj_LeadField,
+                               const MatrixXT& p_matU_B,
+                               SubcorrData& p_subcorrData) const
+{
+    if(m_bFloatPrecision) {
+        p_subcorrData.matProjLeadFieldF = p_matProj_LeadField.cast<float>();
+        p_subcorrData.matWF.noalias() = p_matU_B.cast<float>().transpose() * p_subcorrData.matProjLeadFieldF;
+
+        calcGramDiag(p_subcorrData.matProjLeadFieldF, p_subcorrData.matGramGF);
+        calcGramDiag(p_subcorrData.matWF, p_subcorrData.matGramWF);
+    } else {
+        p_subcorrData.matProjLeadField = p_matProj_LeadField;
+        p_subcorrData.matW.noalias() = p_matU_B.transpose() * p_matProj_LeadField;
+
+        calcGramDiag(p_subcorrData.matProjLeadField, p_subcorrData.matGramG);
+        calcGramDiag(p_subcorrData.matW, p_subcorrData.matGramW);
+    }
+}
+
+//=============================================================================================================
+
+double RapMusic::subcorr(const SubcorrData& p_subcorrData, int p_iIdx1, int p_iIdx2) const
+{
+    if(m_bFloatPrecision) {
+        return calcPairSubcorr(p_subcorrData.matProjLeadFieldF,
+                               p_subcorrData.matWF,
+                               p_subcorrData.matGramGF,
+                               p_subcorrData.matGramWF,
+                               p_iIdx1,
+                               p_iIdx2);
+    }
+
+    return calcPairSubcorr(p_subcorrData.matProjLeadField,
+                           p_subcorrData.matW,
+                           p_subcorrData.matGramG,
+                           p_subcorrData.matGramW,
+                           p_iIdx1,
+                           p_iIdx2);
+}
+
+//=============================================================================================================
+
+double RapMusic::scanPairCombinations(const SubcorrData& p_subcorrData, int &p_iIdx1, int &p_iIdx2) const
+{
+    //Split the combinations in contiguous chunks, each chunk keeps its own maximum
+    struct ScanChunk {
+        int iStart;
+        int iEnd;
+        int iMaxIdx;
+        double dMaxCor;
+    };
+
+    const int iNumChunks = std::max(1, std::min(m_iMaxNumThreads * 8, m_iNumLeadFieldCombinations));
+    const int iChunkSize = (m_iNumLeadFieldCombinations + iNumChunks - 1) / iNumChunks;
+
+    QVector<ScanChunk> vecChunks;
+    for(int i = 0; i < m_iNumLeadFieldCombinations; i += iChunkSize) {
+        ScanChunk chunk;
+        chunk.iStart = i;
+        chunk.iEnd = std::min(i + iChunkSize, m_iNumLeadFieldCombinations);
+        chunk.iMaxIdx = i;
+        chunk.dMaxCor = -1.0;
+        vecChunks.append(chunk);
+    }
+
+    auto scanChunk = [&](ScanChunk& chunk) {
+        //Generate the index pairs on the fly instead of looking them up
+        int idx1, idx2;
+        RapMusic::getPointPair(m_iNumGridPoints, chunk.iStart, idx1, idx2);
+
+        for(int i = chunk.iStart; i < chunk.iEnd; ++i) {
+            double dCor = subcorr(p_subcorrData, idx1, idx2);
+
+            if(dCor > chunk.dMaxCor) {
+                chunk.dMaxCor = dCor;
+                chunk.iMaxIdx = i;
+            }
+
+            RapMusic::nextPointPair(m_iNumGridPoints, idx1, idx2);
+        }
+    };
+
+    //Multithreading correlation calculation
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(m_iMaxNumThreads) schedule(dynamic)
+    for(int i = 0; i < vecChunks.size(); ++i) {
+        scanChunk(vecChunks[i]);
+    }
+    #else
+    QFuture<void> future = QtConcurrent::map(vecChunks, scanChunk);
+    future.waitForFinished();
+    #endif
+
+    //Find the maximum of correlation - chunks are ordered, so ties resolve to the first combination
+    double dMaxCor = -1.0;
+    int iMaxIdx = 0;
+    for(int i = 0; i < vecChunks.size(); ++i) {
+        if(vecChunks[i].dMaxCor > dMaxCor) {
+            dMaxCor = vecChunks[i].dMaxCor;
+            iMaxIdx = vecChunks[i].iMaxIdx;
+        }
+    }
+
+    RapMusic::getPointPair(m_iNumGridPoints, iMaxIdx, p_iIdx1, p_iIdx2);
+
+    return dMaxCor;
+}
+
+//=============================================================================================================
+
 void RapMusic::calcA_k_1(   const MatrixX6T& p_matG_k_1,
                             const Vector6T& p_matPhi_k_1,
                             const int p_iIdxk_1,
@@ -790,36 +918,6 @@ void RapMusic::calcOrthProj(const MatrixXT& p_matA_k_1, MatrixXT& p_matOrthProj)
 
 //=============================================================================================================
 
-void RapMusic::calcPairCombinations(    const int p_iNumPoints,
-                                        const int p_iNumCombinations,
-                                        Pair** p_ppPairIdxCombinations) const
-{
-    int idx1 = 0;
-    int idx2 = 0;
-
-    //Process Code in {m_max_num_threads} threads -> When compile with Intel Compiler -> probably obsolete
-    #ifdef _OPENMP
-    #pragma omp parallel num_threads(m_iMaxNumThreads) private(idx1, idx2)
-    #endif
-    {
-    #ifdef _OPENMP
-    #pragma omp for
-    #endif
-        for (int i = 0; i < p_iNumCombinations; ++i)
-        {
-            RapMusic::getPointPair(p_iNumPoints, i, idx1, idx2);
-
-            Pair* t_pairCombination = new Pair();
-            t_pairCombination->x1 = idx1;
-            t_pairCombination->x2 = idx2;
-
-            p_ppPairIdxCombinations[i] = t_pairCombination;
-        }
-    }
-}
-
-//=============================================================================================================
-
 void RapMusic::getPointPair(const int p_iPoints, const int p_iCurIdx, int &p_iIdx1, int &p_iIdx2)
 {
     int ii = p_iPoints*(p_iPoints+1)/2-1-p_iCurIdx;
@@ -881,3 +979,10 @@ void RapMusic::setStcAttr(int p_iSampStcWin, float p_fStcOverlap)
     m_iSamplesStcWindow = p_iSampStcWin;
     m_fStcOverlap = p_fStcOverlap;
 }
+
+//=============================================================================================================
+
+void RapMusic::setFloatPrecision(bool p_bFloatPrecision)
+{
+    m_bFloatPrecision = p_bFloatPrecision;
+}
@@ -58,6 +58,7 @@
 #include <Eigen/Core>
 #include <Eigen/SVD>
 #include <Eigen/LU>
+#include <Eigen/Eigenvalues>
 
 //=============================================================================================================
 // DEFINE NAMESPACE INVERSELIB
@@ -83,6 +84,23 @@ typedef struct Pair
     int x2; /**< Index two of the pair. */
 } Pair;
 
+//=============================================================================================================
+/**
+ * Declares the precomputed projected gain blocks used for the subspace correlation scan of the RAP MUSIC
+ * algorithm. Only the set matching the selected precision (double or float) is filled.
+ */
+typedef struct SubcorrData
+{
+    Eigen::MatrixXd matProjLeadField;   /**< The projected gain matrix (channels x 3*grid points). */
+    Eigen::MatrixXd matW;               /**< The projected gain matrix in signal subspace coordinates U_B^T*G (rank x 3*grid points). */
+    Eigen::MatrixXd matGramG;           /**< The 3x3 diagonal Gram blocks G_i^T*G_i of all grid points (3 x 3*grid points). */
+    Eigen::MatrixXd matGramW;           /**< The 3x3 diagonal Gram blocks W_i^T*W_i of all grid points (3 x 3*grid points). */
+    Eigen::MatrixXf matProjLeadFieldF;  /**< Float version of matProjLeadField. */
+    Eigen::MatrixXf matWF;              /**< Float version of matW. */
+    Eigen::MatrixXf matGramGF;          /**< Float version of matGramG. */
+    Eigen::MatrixXf matGramWF;          /**< Float version of matGramW. */
+} SubcorrData;
+
 //=============================================================================================================
 /**
  * @brief    The RapMusic class provides the RAP MUSIC Algorithm CPU implementation. ToDo: Paper references.
@@ -165,6 +183,15 @@ public:
      */
     void setStcAttr(int p_iSampStcWin, float p_fStcOverlap);
 
+    //=========================================================================================================
+    /**
+     * Sets whether the subspace correlation scan over all dipole pairs is computed in single (float) precision.
+     * The source directions of the found dipole pairs are always computed in double precision.
+     *
+     * @param[in] p_bFloatPrecision  True when the scan should be performed in float precision.
+     */
+    void setFloatPrecision(bool p_bFloatPrecision);
+
 protected:
     //=========================================================================================================
     /**
@@ -210,6 +237,45 @@ protected:
      */
     static double subcorr(MatrixX6T& p_matProj_G, const MatrixXT& p_matU_B, Vector6T& p_vec_phi_k_1);
 
+    //=========================================================================================================
+    /**
+     * Precomputes the projected gain blocks which are shared by all dipole pairs of one RAP MUSIC iteration.
+     *
+     * @param[in] p_matProj_LeadField    The projected gain matrix (channels x 3*grid points).
+     * @param[in] p_matU_B               The matrix U is the subspace projection of the orthogonal projected Phi_s.
+     * @param[out] p_subcorrData         The precomputed blocks.
+     */
+    void calcSubcorrData(const MatrixXT& p_matProj_LeadField,
+                         const MatrixXT& p_matU_B,
+                         SubcorrData& p_subcorrData) const;
+
+    //=========================================================================================================
+    /**
+     * Computes the subspace correlation of a dipole pair from the precomputed gain blocks. This is equivalent to
+     * subcorr(p_matProj_G, p_matU_B) but solves a closed-form 6x6 generalized eigenvalue problem
+     * (G^T*U_B*U_B^T*G x = lambda G^T*G x) instead of an SVD of the channels x 6 pair matrix.
+     *
+     * @param[in] p_subcorrData  The precomputed blocks of the current iteration.
+     * @param[in] p_iIdx1        First Lead Field index point.
+     * @param[in] p_iIdx2        Second Lead Field index point.
+     *
+     * @return   The maximal correlation c_1 of the subspace correlation.
+     */
+    double subcorr(const SubcorrData& p_subcorrData, int p_iIdx1, int p_iIdx2) const;
+
+    //=========================================================================================================
+    /**
+     * Scans all dipole pair combinations for the maximal subspace correlation. The scan is distributed over
+     * OpenMP threads when available, otherwise over the Qt thread pool.
+     *
+     * @param[in] p_subcorrData  The precomputed blocks of the current iteration.
+     * @param[out] p_iIdx1       First Lead Field index point of the maximal correlated pair.
+     * @param[out] p_iIdx2       Second Lead Field index point of the maximal correlated pair.
+     *
+     * @return   The maximal correlation.
+     */
+    double scanPairCombinations(const SubcorrData& p_subcorrData, int &p_iIdx1, int &p_iIdx2) const;
+
     //=========================================================================================================
     /**
      * Calculates the accumulated manifold vectors A_{k1}
@@ -234,21 +300,6 @@ protected:
      */
     void calcOrthProj(const MatrixXT& p_matA_k_1, MatrixXT& p_matOrthProj) const;
 
-    //=========================================================================================================
-    /**
-     * Pre-Calculates the gain matrix index combinations to search for a two dipole independent topography
-     * (IT = source).
-     *
-     * @param[in] p_iNumPoints   The number of Lead Field points -> for dimension check
-     * @param[in] p_iNumCombinations The number of pair index combinations.
-     * @param[out] p_ppPairIdxCombinations   The destination which contains pointer to pointer of index
-     *                                       combinations of Lead Field indices -> Number of pointers =
-     *                                       Combination (number of grid points over 2 = Num + 1 C 2)
-     */
-    void calcPairCombinations(  const int p_iNumPoints,
-                                const int p_iNumCombinations,
-                                Pair** p_ppPairIdxCombinations) const;
-
     //=========================================================================================================
     /**
      * Calculates the combination indices Idx1 and Idx2 of n points.\n
@@ -267,6 +318,17 @@ protected:
      */
     static void getPointPair(const int p_iPoints, const int p_iCurIdx, int &p_iIdx1, int &p_iIdx2);
 
+    //=========================================================================================================
+    /**
+     * Advances the combination indices Idx1 and Idx2 of n points to the next combination, i.e. the one
+     * getPointPair returns for p_iCurIdx+1. This avoids storing all combinations.
+     *
+     * @param[in] p_iPoints      The number of points n which are combined with each other.
+     * @param[in, out] p_iIdx1   Index 1.
+     * @param[in, out] p_iIdx2   Index 2.
+     */
+    static inline void nextPointPair(const int p_iPoints, int &p_iIdx1, int &p_iIdx2);
+
     //=========================================================================================================
     /**
      * Returns a gain matrix pair for the given indices
@@ -306,10 +368,10 @@ protected:
     int m_iNumChannels;                 /**< Number of channels */
     int m_iNumLeadFieldCombinations;    /**< Number of Lead Filed combinations (grid points + 1 over 2)*/
 
-    Pair** m_ppPairIdxCombinations; /**< Index combination vector with grid pair indices. */
-
     int m_iMaxNumThreads;   /**< Number of available CPU threads. */
 
+    bool m_bFloatPrecision; /**< Whether the pair scan is performed in float precision. */
+
     bool m_bIsInit; /**< Whether the algorithm is initialized. */
 
     //Stc stuff
@@ -355,6 +417,18 @@ protected:
 // INLINE DEFINITIONS
 //=============================================================================================================
 
+inline void RapMusic::nextPointPair(const int p_iPoints, int &p_iIdx1, int &p_iIdx2)
+{
+    ++p_iIdx2;
+
+    if(p_iIdx2 >= p_iPoints) {
+        ++p_iIdx1;
+        p_iIdx2 = p_iIdx1;
+    }
+}
+
+//=============================================================================================================
+
 inline int RapMusic::getRank(const MatrixXT& p_matSigma)
 {
     int t_iRank;
@@ -75,6 +75,8 @@ SOURCES += \
     mne.cpp \
     mne_sourcespace.cpp \
     mne_forwardsolution.cpp \
+    mne_lazy_gain_matrix.cpp \
+    mne_source_morph.cpp \
     mne_sourceestimate.cpp \
     mne_hemisphere.cpp \
     mne_inverse_operator.cpp \
@@ -126,6 +128,8 @@ HEADERS += \
     mne_sourcespace.h \
     mne_hemisphere.h \
     mne_forwardsolution.h \
+    mne_lazy_gain_matrix.h \
+    mne_source_morph.h \
     mne_sourceestimate.h \
     mne_inverse_operator.h \
     mne_epoch_data.h \
@@ -60,10 +60,12 @@
 #include <fs/surfaceset.h>
 #include <utils/mnemath.h>
 #include <utils/kmeans.h>
+#include <utils/filecache.h>
 
 #include <iostream>
 #include <QtConcurrent>
 #include <QFuture>
+#include <QBuffer>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -75,6 +77,100 @@ using namespace FSLIB;
 using namespace Eigen;
 using namespace FIFFLIB;
 
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+template<typename Derived>
+static void writeMatrix(QDataStream& stream, const Eigen::PlainObjectBase<Derived>& mat)
+{
+    stream << static_cast<qint32>(mat.rows()) << static_cast<qint32>(mat.cols());
+    stream.writeRawData(reinterpret_cast<const char*>(mat.data()), static_cast<int>(mat.size() * sizeof(typename Derived::Scalar)));
+}
+
+//=============================================================================================================
+
+template<typename Derived>
+static bool readMatrix(QDataStream& stream, Eigen::PlainObjectBase<Derived>& mat)
+{
+    qint32 rows, cols;
+    stream >> rows >> cols;
+    if(stream.status() != QDataStream::Ok || rows < 0 || cols < 0)
+        return false;
+    mat.resize(rows, cols);
+    int iBytes = static_cast<int>(mat.size() * sizeof(typename Derived::Scalar));
+    return stream.readRawData(reinterpret_cast<char*>(mat.data()), iBytes) == iBytes;
+}
+
+//=============================================================================================================
+
+/**
+ * The cache key covers everything the clustering depends on: the (whitened) region gain matrices, which are
+ * given by the forward solution, the annotation and the noise covariance, the number of clusters per region,
+ * which is given by the cluster size, and the distance measure.
+ */
+static QString clusterCacheKey(const QList<RegionData>& lRegionData)
+{
+    FileCacheKey key("MNEForwardSolution::cluster_forward_solution v1");
+
+    for(const RegionData& region : lRegionData)
+    {
+        key.addValue(region.iLabelIdxIn).addValue(region.nClusters).addValue(region.bUseWhitened);
+        key.add(region.sDistMeasure);
+        key.addMatrix(region.idcs).addMatrix(region.matRoiG);
+        if(region.bUseWhitened)
+            key.addMatrix(region.matRoiGWhitened);
+    }
+
+    return key.result();
+}
+
+//=============================================================================================================
+
+static bool readClusterCache(QIODevice& device,
+                             qint32 iNumRegions,
+                             QList<RegionDataOut>& lRegionDataOut)
+{
+    QDataStream stream(&device);
+    qint32 iNum;
+    stream >> iNum;
+    if(iNum != iNumRegions)
+        return false;
+
+    lRegionDataOut.clear();
+    for(qint32 i = 0; i < iNum; ++i)
+    {
+        RegionDataOut regionOut;
+        stream >> regionOut.iLabelIdxOut;
+        if(!readMatrix(stream, regionOut.roiIdx) || !readMatrix(stream, regionOut.ctrs)
+                || !readMatrix(stream, regionOut.sumd) || !readMatrix(stream, regionOut.D))
+        {
+            lRegionDataOut.clear();
+            return false;
+        }
+        lRegionDataOut.append(regionOut);
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+static void writeClusterCache(QIODevice& device,
+                              const QList<RegionDataOut>& lRegionDataOut)
+{
+    QDataStream stream(&device);
+    stream << static_cast<qint32>(lRegionDataOut.size());
+    for(const RegionDataOut& regionOut : lRegionDataOut)
+    {
+        stream << regionOut.iLabelIdxOut;
+        writeMatrix(stream, regionOut.roiIdx);
+        writeMatrix(stream, regionOut.ctrs);
+        writeMatrix(stream, regionOut.sumd);
+        writeMatrix(stream, regionOut.D);
+    }
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -96,7 +192,7 @@ MNEForwardSolution::MNEForwardSolution()
 
 //=============================================================================================================
 
-MNEForwardSolution::MNEForwardSolution(QIODevice &p_IODevice, bool force_fixed, bool surf_ori, const QStringList& include, const QStringList& exclude, bool bExcludeBads)
+MNEForwardSolution::MNEForwardSolution(QIODevice &p_IODevice, bool force_fixed, bool surf_ori, const QStringList& include, const QStringList& exclude, bool bExcludeBads, bool bLazy)
 : source_ori(-1)
 , surf_ori(surf_ori)
 , coord_frame(-1)
@@ -109,7 +205,7 @@ MNEForwardSolution::MNEForwardSolution(QIODevice &p_IODevice, bool force_fixed,
 , source_rr(MatrixX3f::Zero(0,3))
 , source_nn(MatrixX3f::Zero(0,3))
 {
-    if(!read(p_IODevice, *this, force_fixed, surf_ori, include, exclude, bExcludeBads))
+    if(!read(p_IODevice, *this, force_fixed, surf_ori, include, exclude, bExcludeBads, bLazy))
     {
         printf("\tForward solution not found.\n");//ToDo Throw here
         return;
@@ -127,6 +223,7 @@ MNEForwardSolution::MNEForwardSolution(const MNEForwardSolution &p_MNEForwardSol
 , nchan(p_MNEForwardSolution.nchan)
 , sol(p_MNEForwardSolution.sol)
 , sol_grad(p_MNEForwardSolution.sol_grad)
+, sol_lazy(p_MNEForwardSolution.sol_lazy)
 , mri_head_t(p_MNEForwardSolution.mri_head_t)
 , src(p_MNEForwardSolution.src)
 , source_rr(p_MNEForwardSolution.source_rr)
@@ -152,6 +249,7 @@ void MNEForwardSolution::clear()
     nchan = -1;
     sol = FiffNamedMatrix::SDPtr(new FiffNamedMatrix());
     sol_grad = FiffNamedMatrix::SDPtr(new FiffNamedMatrix());
+    sol_lazy.clear();
     mri_head_t.clear();
     src.clear();
     source_rr = MatrixX3f(0,3);
@@ -165,7 +263,8 @@ MNEForwardSolution MNEForwardSolution::cluster_forward_solution(const Annotation
                                                                 MatrixXd& p_D,
                                                                 const FiffCov &p_pNoise_cov,
                                                                 const FiffInfo &p_pInfo,
-                                                                QString p_sMethod) const
+                                                                QString p_sMethod,
+                                                                const QString& p_sCacheDir) const
 {
     printf("Cluster forward solution using %s.\n", p_sMethod.toUtf8().constData());
 
@@ -203,6 +302,8 @@ MNEForwardSolution MNEForwardSolution::cluster_forward_solution(const Annotation
 //    }
 
     MatrixXd t_G_Whitened(0,0);
+    MatrixXd t_matWhitener;
+    VectorXi t_vecFwdIdx;
     bool t_bUseWhitened = false;
     //
     //Whiten gain matrix before clustering -> cause diffenerent units Magnetometer, Gradiometer and EEG
@@ -214,10 +315,19 @@ MNEForwardSolution MNEForwardSolution::cluster_forward_solution(const Annotation
         MatrixXd p_outWhitener;
         qint32 p_outNumNonZero;
         //do whitening with noise cov
-        this->prepare_forward(p_pInfo, p_pNoise_cov, false, p_outFwdInfo, t_G_Whitened, p_outNoiseCov, p_outWhitener, p_outNumNonZero);
-        printf("\tWhitening the forward solution.\n");
+        if(this->isLazy())
+        {
+            // The regions are whitened one by one below -> the full gain matrix is never assembled
+            this->prepare_whitener(p_pInfo, p_pNoise_cov, false, p_outFwdInfo, t_vecFwdIdx, p_outNoiseCov, t_matWhitener, p_outNumNonZero);
+            printf("\tWhitening the forward solution per region.\n");
+        }
+        else
+        {
+            this->prepare_forward(p_pInfo, p_pNoise_cov, false, p_outFwdInfo, t_G_Whitened, p_outNoiseCov, p_outWhitener, p_outNumNonZero);
+            printf("\tWhitening the forward solution.\n");
 
-        t_G_Whitened = p_outWhitener*t_G_Whitened;
+            t_G_Whitened = p_outWhitener*t_G_Whitened;
+        }
         t_bUseWhitened = true;
     }
 
@@ -286,14 +396,31 @@ MNEForwardSolution MNEForwardSolution::cluster_forward_solution(const Annotation
                 idcs.conservativeResize(c);
 
                 //get selected G
-                MatrixXd t_G(this->sol->data.rows(), idcs.rows()*3);
-                MatrixXd t_G_Whitened_Roi(t_G_Whitened.rows(), idcs.rows()*3);
+                MatrixXd t_G;
+                MatrixXd t_G_Whitened_Roi;
 
-                for(qint32 j = 0; j < idcs.rows(); ++j)
+                if(this->isLazy())
                 {
-                    t_G.block(0, j*3, t_G.rows(), 3) = this->sol->data.block(0, (idcs[j]+offset)*3, t_G.rows(), 3);
+                    t_G = this->sol_lazy->sources(VectorXi(idcs.array() + offset));
                     if(t_bUseWhitened)
-                        t_G_Whitened_Roi.block(0, j*3, t_G_Whitened_Roi.rows(), 3) = t_G_Whitened.block(0, (idcs[j]+offset)*3, t_G_Whitened_Roi.rows(), 3);
+                    {
+                        MatrixXd t_G_Picked(t_vecFwdIdx.size(), t_G.cols());
+                        for(qint32 j = 0; j < t_vecFwdIdx.size(); ++j)
+                            t_G_Picked.row(j) = t_G.row(t_vecFwdIdx[j]);
+                        t_G_Whitened_Roi = t_matWhitener*t_G_Picked;
+                    }
+                }
+                else
+                {
+                    t_G.resize(this->sol->data.rows(), idcs.rows()*3);
+                    t_G_Whitened_Roi.resize(t_G_Whitened.rows(), idcs.rows()*3);
+
+                    for(qint32 j = 0; j < idcs.rows(); ++j)
+                    {
+                        t_G.block(0, j*3, t_G.rows(), 3) = this->sol->data.block(0, (idcs[j]+offset)*3, t_G.rows(), 3);
+                        if(t_bUseWhitened)
+                            t_G_Whitened_Roi.block(0, j*3, t_G_Whitened_Roi.rows(), 3) = t_G_Whitened.block(0, (idcs[j]+offset)*3, t_G_Whitened_Roi.rows(), 3);
+                    }
                 }
 
                 qint32 nSens = t_G.rows();
@@ -345,10 +472,37 @@ MNEForwardSolution MNEForwardSolution::cluster_forward_solution(const Annotation
         //
         // Calculate clusters
         //
-        printf("Clustering... ");
-        QFuture< RegionDataOut > res;
-        res = QtConcurrent::mapped(m_qListRegionDataIn, &RegionData::cluster);
-        res.waitForFinished();
+        QList<RegionDataOut> t_qListRegionDataOut;
+        FileCache t_cache(p_sCacheDir, "clu");
+        QString t_sCacheKey;
+        QByteArray t_baCached;
+        if(t_cache.isEnabled())
+            t_sCacheKey = clusterCacheKey(m_qListRegionDataIn);
+
+        QBuffer t_cacheBuffer(&t_baCached);
+        if(t_cache.isEnabled() && t_cache.read(t_sCacheKey, t_baCached)
+                && t_cacheBuffer.open(QIODevice::ReadOnly)
+                && readClusterCache(t_cacheBuffer, m_qListRegionDataIn.size(), t_qListRegionDataOut))
+        {
+            printf("Clusters read from cache %s\n", t_cache.getFileName(t_sCacheKey).toUtf8().constData());
+        }
+        else
+        {
+            printf("Clustering... ");
+            QFuture< RegionDataOut > res;
+            res = QtConcurrent::mapped(m_qListRegionDataIn, &RegionData::cluster);
+            res.waitForFinished();
+            t_qListRegionDataOut = res.results();
+
+            if(t_cache.isEnabled())
+            {
+                QByteArray baCluster;
+                QBuffer buffer(&baCluster);
+                buffer.open(QIODevice::WriteOnly);
+                writeClusterCache(buffer, t_qListRegionDataOut);
+                t_cache.write(t_sCacheKey, baCluster);
+            }
+        }
 
         //
         // Assign results
@@ -359,8 +513,8 @@ MNEForwardSolution MNEForwardSolution::cluster_forward_solution(const Annotation
         qint32 nSens;
         QList<RegionData>::const_iterator itIn;
         itIn = m_qListRegionDataIn.begin();
-        QFuture<RegionDataOut>::const_iterator itOut;
-        for (itOut = res.constBegin(); itOut != res.constEnd(); ++itOut)
+        QList<RegionDataOut>::const_iterator itOut;
+        for (itOut = t_qListRegionDataOut.constBegin(); itOut != t_qListRegionDataOut.constEnd(); ++itOut)
         {
             nClusters = itOut->ctrs.rows();
             nSens = itOut->ctrs.cols()/3;
@@ -483,9 +637,9 @@ MNEForwardSolution MNEForwardSolution::cluster_forward_solution(const Annotation
         totalNumOfClust += p_fwdOut.src[h].cluster_info.clusterVertnos.size();
 
     if(this->isFixedOrient())
-        p_D = MatrixXd::Zero(this->sol->data.cols(), totalNumOfClust);
+        p_D = MatrixXd::Zero(this->sol->ncol, totalNumOfClust);
     else
-        p_D = MatrixXd::Zero(this->sol->data.cols(), totalNumOfClust*3);
+        p_D = MatrixXd::Zero(this->sol->ncol, totalNumOfClust*3);
 
     QList<VectorXi> t_vertnos = this->src.get_vertno();
 
@@ -690,6 +844,7 @@ MNEForwardSolution MNEForwardSolution::cluster_forward_solution(const Annotation
     //
     p_fwdOut.sol->data = t_G_new;
     p_fwdOut.sol->ncol = t_G_new.cols();
+    p_fwdOut.sol_lazy.clear();
 
     p_fwdOut.nsource = p_fwdOut.sol->ncol/3;
 
@@ -703,7 +858,7 @@ MNEForwardSolution MNEForwardSolution::reduce_forward_solution(qint32 p_iNumDipo
     MNEForwardSolution p_fwdOut = MNEForwardSolution(*this);
 
     bool isFixed = p_fwdOut.isFixedOrient();
-    qint32 np = isFixed ? p_fwdOut.sol->data.cols() : p_fwdOut.sol->data.cols()/3;
+    qint32 np = isFixed ? p_fwdOut.sol->ncol : p_fwdOut.sol->ncol/3;
 
     if(p_iNumDipoles > np)
         return p_fwdOut;
@@ -720,13 +875,13 @@ MNEForwardSolution MNEForwardSolution::reduce_forward_solution(qint32 p_iNumDipo
 
     if(isFixed)
     {
-        p_D = MatrixXd::Zero(p_fwdOut.sol->data.cols(), p_iNumDipoles);
+        p_D = MatrixXd::Zero(p_fwdOut.sol->ncol, p_iNumDipoles);
         for(qint32 i = 0; i < p_iNumDipoles; ++i)
             p_D(sel[i], i) = 1;
     }
     else
     {
-        p_D = MatrixXd::Zero(p_fwdOut.sol->data.cols(), p_iNumDipoles*3);
+        p_D = MatrixXd::Zero(p_fwdOut.sol->ncol, p_iNumDipoles*3);
         for(qint32 i = 0; i < p_iNumDipoles; ++i)
             for(qint32 j = 0; j < 3; ++j)
                 p_D((sel[i]*3)+j, (i*3)+j) = 1;
@@ -779,7 +934,14 @@ MNEForwardSolution MNEForwardSolution::reduce_forward_solution(qint32 p_iNumDipo
 //    //vertno end
 
     // New gain matrix
-    p_fwdOut.sol->data = this->sol->data * p_D;
+    if(this->isLazy())
+    {
+        // p_D only selects sources -> read just these columns
+        p_fwdOut.sol->data = this->sol_lazy->sources(sel);
+        p_fwdOut.sol_lazy.clear();
+    }
+    else
+        p_fwdOut.sol->data = this->sol->data * p_D;
 
     MatrixX3f rr(p_iNumDipoles,3);
 
@@ -915,7 +1077,7 @@ FiffCov MNEForwardSolution::compute_depth_prior(const MatrixXd &Gain, const Fiff
 FiffCov MNEForwardSolution::compute_orient_prior(float loose)
 {
     bool is_fixed_ori = this->isFixedOrient();
-    qint32 n_sources = this->sol->data.cols();
+    qint32 n_sources = this->sol->ncol;
 
     if (0 <= loose && loose <= 1)
     {
@@ -982,11 +1144,20 @@ MNEForwardSolution MNEForwardSolution::pick_channels(const QStringList& include,
     printf("\t%d out of %d channels remain after picking\n", nuse, fwd.nchan);
 
     //   Pick the correct rows of the forward operator
-    MatrixXd newData(nuse, fwd.sol->data.cols());
-    for(quint32 i = 0; i < nuse; ++i)
-        newData.row(i) = fwd.sol->data.row(sel[i]);
+    MatrixXd newData;
+    if(fwd.isLazy())
+    {
+        fwd.sol_lazy = MNELazyGainMatrix::SPtr(new MNELazyGainMatrix(*fwd.sol_lazy));
+        fwd.sol_lazy->selectRows(sel.transpose());
+    }
+    else
+    {
+        newData.resize(nuse, fwd.sol->data.cols());
+        for(quint32 i = 0; i < nuse; ++i)
+            newData.row(i) = fwd.sol->data.row(sel[i]);
 
-    fwd.sol->data = newData;
+        fwd.sol->data = newData;
+    }
     fwd.sol->nrow = nuse;
 
     QStringList ch_names;
@@ -1056,18 +1227,28 @@ MNEForwardSolution MNEForwardSolution::pick_regions(const QList<Label> &p_qListL
     selectedFwd.source_rr = rr;
     selectedFwd.source_nn = nn;
 
-    VectorXi selSolIdcs = tripletSelection(selVertices);
-    MatrixXd G(selectedFwd.sol->data.rows(),selSolIdcs.size());
-//    selectedFwd.sol_grad; //ToDo
-    qint32 rows = G.rows();
-
-    for(qint32 i = 0; i < selSolIdcs.size(); ++i)
-        G.block(0, i, rows, 1) = selectedFwd.sol->data.col(selSolIdcs[i]);
-
-    selectedFwd.sol->data = G;
-    selectedFwd.sol->nrow = selectedFwd.sol->data.rows();
-    selectedFwd.sol->ncol = selectedFwd.sol->data.cols();
-    selectedFwd.nsource = selectedFwd.sol->ncol / 3;
+    if(selectedFwd.isLazy())
+    {
+        selectedFwd.sol_lazy = MNELazyGainMatrix::SPtr(new MNELazyGainMatrix(*selectedFwd.sol_lazy));
+        selectedFwd.sol_lazy->selectSources(selVertices);
+        selectedFwd.sol->ncol = selectedFwd.sol_lazy->cols();
+        selectedFwd.nsource = selectedFwd.sol_lazy->numSources();
+    }
+    else
+    {
+        VectorXi selSolIdcs = tripletSelection(selVertices);
+        MatrixXd G(selectedFwd.sol->data.rows(),selSolIdcs.size());
+//        selectedFwd.sol_grad; //ToDo
+        qint32 rows = G.rows();
+
+        for(qint32 i = 0; i < selSolIdcs.size(); ++i)
+            G.block(0, i, rows, 1) = selectedFwd.sol->data.col(selSolIdcs[i]);
+
+        selectedFwd.sol->data = G;
+        selectedFwd.sol->nrow = selectedFwd.sol->data.rows();
+        selectedFwd.sol->ncol = selectedFwd.sol->data.cols();
+        selectedFwd.nsource = selectedFwd.sol->ncol / 3;
+    }
 
     selectedFwd.src = selectedFwd.src.pick_regions(p_qListLabels);
 
@@ -1097,6 +1278,23 @@ void MNEForwardSolution::prepare_forward(const FiffInfo &p_info,
                                          FiffCov &p_outNoiseCov,
                                          MatrixXd &p_outWhitener,
                                          qint32 &p_outNumNonZero) const
+{
+    VectorXi fwd_idx;
+    prepare_whitener(p_info, p_noise_cov, p_pca, p_outFwdInfo, fwd_idx, p_outNoiseCov, p_outWhitener, p_outNumNonZero);
+
+    gain = pick_gain_rows(fwd_idx);
+}
+
+//=============================================================================================================
+
+void MNEForwardSolution::prepare_whitener(const FiffInfo &p_info,
+                                          const FiffCov &p_noise_cov,
+                                          bool p_pca,
+                                          FiffInfo &p_outFwdInfo,
+                                          VectorXi &p_outFwdIdx,
+                                          FiffCov &p_outNoiseCov,
+                                          MatrixXd &p_outWhitener,
+                                          qint32 &p_outNumNonZero) const
 {
     QStringList fwd_ch_names, ch_names;
     for(qint32 i = 0; i < this->info.chs.size(); ++i)
@@ -1177,9 +1375,7 @@ void MNEForwardSolution::prepare_forward(const FiffInfo &p_info,
     fwd_idx.conservativeResize(count_fwd_idx);
     info_idx.conservativeResize(count_info_idx);
 
-    gain.resize(count_fwd_idx, this->sol->data.cols());
-    for(qint32 i = 0; i < count_fwd_idx; ++i)
-        gain.row(i) = this->sol->data.row(fwd_idx[i]);
+    p_outFwdIdx = fwd_idx;
 
     p_outFwdInfo = p_info.pick_info(info_idx);
 
@@ -1188,16 +1384,42 @@ void MNEForwardSolution::prepare_forward(const FiffInfo &p_info,
 
 //=============================================================================================================
 
+MatrixXd MNEForwardSolution::pick_gain_rows(const VectorXi &p_vecSel) const
+{
+    if(this->isLazy())
+    {
+        MNELazyGainMatrix t_lazyGain(*this->sol_lazy);
+        t_lazyGain.selectRows(p_vecSel);
+        return t_lazyGain.toDense();
+    }
+
+    MatrixXd gain(p_vecSel.size(), this->sol->data.cols());
+    for(qint32 i = 0; i < p_vecSel.size(); ++i)
+        gain.row(i) = this->sol->data.row(p_vecSel[i]);
+
+    return gain;
+}
+
+//=============================================================================================================
+
 bool MNEForwardSolution::read(QIODevice& p_IODevice,
                               MNEForwardSolution& fwd,
                               bool force_fixed,
                               bool surf_ori,
                               const QStringList& include,
                               const QStringList& exclude,
-                              bool bExcludeBads)
+                              bool bExcludeBads,
+                              bool bLazy)
 {
     FiffStream::SPtr t_pStream(new FiffStream(&p_IODevice));
 
+    // Mapping needs a file on disk
+    if(bLazy && !qobject_cast<QFile*>(&p_IODevice))
+    {
+        qWarning("MNEForwardSolution::read - Lazy reading needs a file. Reading the full gain matrix.");
+        bLazy = false;
+    }
+
     printf("Reading forward solution from %s...\n", t_pStream->streamName().toUtf8().constData());
     if(!t_pStream->open())
         return false;
@@ -1279,7 +1501,7 @@ bool MNEForwardSolution::read(QIODevice& p_IODevice,
 
     MNEForwardSolution megfwd;
     QString ori;
-    if (read_one(t_pStream, megnode, megfwd))
+    if (read_one(t_pStream, megnode, megfwd, bLazy))
     {
         if (megfwd.source_ori == FIFFV_MNE_FIXED_ORI)
             ori = QString("fixed");
@@ -1288,7 +1510,7 @@ bool MNEForwardSolution::read(QIODevice& p_IODevice,
         printf("\tRead MEG forward solution (%d sources, %d channels, %s orientations)\n", megfwd.nsource,megfwd.nchan,ori.toUtf8().constData());
     }
     MNEForwardSolution eegfwd;
-    if (read_one(t_pStream, eegnode, eegfwd))
+    if (read_one(t_pStream, eegnode, eegfwd, bLazy))
     {
         if (eegfwd.source_ori == FIFFV_MNE_FIXED_ORI)
             ori = QString("fixed");
@@ -1304,7 +1526,7 @@ bool MNEForwardSolution::read(QIODevice& p_IODevice,
 
     if (!megfwd.isEmpty() && !eegfwd.isEmpty())
     {
-        if (megfwd.sol->data.cols() != eegfwd.sol->data.cols() ||
+        if (megfwd.sol->ncol != eegfwd.sol->ncol ||
                 megfwd.source_ori != eegfwd.source_ori ||
                 megfwd.nsource != eegfwd.nsource ||
                 megfwd.coord_frame != eegfwd.coord_frame)
@@ -1315,10 +1537,17 @@ bool MNEForwardSolution::read(QIODevice& p_IODevice,
         }
 
         fwd = MNEForwardSolution(megfwd);
-        fwd.sol->data = MatrixXd(megfwd.sol->nrow + eegfwd.sol->nrow, megfwd.sol->ncol);
+        if(fwd.isLazy())
+        {
+            fwd.sol_lazy->appendRows(*eegfwd.sol_lazy);
+        }
+        else
+        {
+            fwd.sol->data = MatrixXd(megfwd.sol->nrow + eegfwd.sol->nrow, megfwd.sol->ncol);
 
-        fwd.sol->data.block(0,0,megfwd.sol->nrow,megfwd.sol->ncol) = megfwd.sol->data;
-        fwd.sol->data.block(megfwd.sol->nrow,0,eegfwd.sol->nrow,eegfwd.sol->ncol) = eegfwd.sol->data;
+            fwd.sol->data.block(0,0,megfwd.sol->nrow,megfwd.sol->ncol) = megfwd.sol->data;
+            fwd.sol->data.block(megfwd.sol->nrow,0,eegfwd.sol->nrow,eegfwd.sol->ncol) = eegfwd.sol->data;
+        }
         fwd.sol->nrow = megfwd.sol->nrow + eegfwd.sol->nrow;
         fwd.sol->row_names.append(eegfwd.sol->row_names);
 
@@ -1421,7 +1650,10 @@ bool MNEForwardSolution::read(QIODevice& p_IODevice,
 
             MatrixXd tmp = fwd.source_nn.transpose().cast<double>();
             SparseMatrix<double>* fix_rot = MNEMath::make_block_diag(tmp,1);
-            fwd.sol->data *= (*fix_rot);
+            if(fwd.isLazy())
+                fwd.sol_lazy->setOrientation(MNELazyGainMatrix::FixedOriented, fwd.source_nn);
+            else
+                fwd.sol->data *= (*fix_rot);
             fwd.sol->ncol  = fwd.nsource;
             fwd.source_ori = FIFFV_MNE_FIXED_ORI;
 
@@ -1505,7 +1737,10 @@ bool MNEForwardSolution::read(QIODevice& p_IODevice,
         MatrixXd tmp = fwd.source_nn.transpose().cast<double>();
         SparseMatrix<double>* surf_rot = MNEMath::make_block_diag(tmp,3);
 
-        fwd.sol->data *= *surf_rot;
+        if(fwd.isLazy())
+            fwd.sol_lazy->setOrientation(MNELazyGainMatrix::SurfaceOriented, fwd.source_nn);
+        else
+            fwd.sol->data *= *surf_rot;
 
         if (!fwd.sol_grad->isEmpty())
         {
@@ -1683,7 +1918,8 @@ bool MNEForwardSolution::read(QIODevice& p_IODevice,
 
 bool MNEForwardSolution::read_one(FiffStream::SPtr& p_pStream,
                                   const FiffDirNode::SPtr& p_Node,
-                                  MNEForwardSolution& one)
+                                  MNEForwardSolution& one,
+                                  bool bLazy)
 {
     //
     //   Read all interesting stuff for one forward solution
@@ -1730,7 +1966,16 @@ bool MNEForwardSolution::read_one(FiffStream::SPtr& p_pStream,
 
     one.nchan = *t_pTag->toInt();
 
-    if(p_pStream->read_named_matrix(p_Node, FIFF_MNE_FORWARD_SOLUTION, *one.sol.data()))
+    if(bLazy)
+    {
+        if(!read_lazy_gain(p_pStream, p_Node, one))
+        {
+            p_pStream->close();
+            qWarning("MNEForwardSolution::read_one - Forward solution data could not be mapped.");
+            return false;
+        }
+    }
+    else if(p_pStream->read_named_matrix(p_Node, FIFF_MNE_FORWARD_SOLUTION, *one.sol.data()))
         one.sol->transpose_named_matrix();
     else
     {
@@ -1740,13 +1985,14 @@ bool MNEForwardSolution::read_one(FiffStream::SPtr& p_pStream,
         return false;
     }
 
-    if(p_pStream->read_named_matrix(p_Node, FIFF_MNE_FORWARD_SOLUTION_GRAD, *one.sol_grad.data()))
+    // The gradient is not needed for the lazily read solution
+    if(!bLazy && p_pStream->read_named_matrix(p_Node, FIFF_MNE_FORWARD_SOLUTION_GRAD, *one.sol_grad.data()))
         one.sol_grad->transpose_named_matrix();
     else
         one.sol_grad->clear();
 
-    if (one.sol->data.rows() != one.nchan ||
-            (one.sol->data.cols() != one.nsource && one.sol->data.cols() != 3*one.nsource))
+    if (one.sol->nrow != one.nchan ||
+            (one.sol->ncol != one.nsource && one.sol->ncol != 3*one.nsource))
     {
         p_pStream->close();
         printf("Forward solution matrix has wrong dimensions.\n"); //ToDo: throw error.
@@ -1768,6 +2014,89 @@ bool MNEForwardSolution::read_one(FiffStream::SPtr& p_pStream,
 
 //=============================================================================================================
 
+bool MNEForwardSolution::read_lazy_gain(FiffStream::SPtr& p_pStream,
+                                        const FiffDirNode::SPtr& p_Node,
+                                        MNEForwardSolution& one)
+{
+    QFile* t_pFile = qobject_cast<QFile*>(p_pStream->device());
+    if(!t_pFile)
+        return false;
+
+    //
+    //   Descend to the named matrix holding the solution
+    //
+    FiffDirNode::SPtr node;
+    for(qint32 k = 0; k < p_Node->nchild(); ++k)
+    {
+        if(p_Node->children[k]->type == FIFFB_MNE_NAMED_MATRIX && p_Node->children[k]->has_tag(FIFF_MNE_FORWARD_SOLUTION))
+        {
+            node = p_Node->children[k];
+            break;
+        }
+    }
+    if(!node)
+    {
+        qWarning("MNEForwardSolution::read_lazy_gain - Forward solution matrix not available\n");
+        return false;
+    }
+
+    fiff_long_t t_iTagPos = -1;
+    for(qint32 k = 0; k < node->nent(); ++k)
+    {
+        if(node->dir[k]->kind == FIFF_MNE_FORWARD_SOLUTION)
+        {
+            t_iTagPos = node->dir[k]->pos;
+            break;
+        }
+    }
+
+    FiffMappedMatrix::SPtr t_pMapped(new FiffMappedMatrix);
+    if(t_iTagPos < 0 || !t_pMapped->open(t_pFile->fileName(), t_iTagPos))
+        return false;
+
+    //
+    //   The file holds the transposed matrix -> its column names are the channels
+    //
+    FiffTag::SPtr t_pTag;
+    one.sol->clear();
+    if(node->find_tag(p_pStream, FIFF_MNE_COL_NAMES, t_pTag))
+        one.sol->row_names = FiffStream::split_name_list(t_pTag->toString());
+    if(node->find_tag(p_pStream, FIFF_MNE_ROW_NAMES, t_pTag))
+        one.sol->col_names = FiffStream::split_name_list(t_pTag->toString());
+    one.sol->nrow = t_pMapped->rows();
+    one.sol->ncol = t_pMapped->cols();
+
+    if(one.sol->row_names.size() != one.sol->nrow)
+    {
+        qWarning("MNEForwardSolution::read_lazy_gain - Number of channels and channel names do not match\n");
+        return false;
+    }
+
+    one.sol_lazy = MNELazyGainMatrix::SPtr(new MNELazyGainMatrix(one.nsource));
+    if(!one.sol_lazy->appendRows(t_pMapped))
+    {
+        one.sol_lazy.clear();
+        return false;
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+void MNEForwardSolution::load_lazy_solution()
+{
+    if(!this->isLazy())
+        return;
+
+    this->sol->data = this->sol_lazy->toDense();
+    this->sol->nrow = this->sol->data.rows();
+    this->sol->ncol = this->sol->data.cols();
+    this->sol_lazy.clear();
+}
+
+//=============================================================================================================
+
 void MNEForwardSolution::restrict_gain_matrix(MatrixXd &G, const FiffInfo &info)
 {
     // Figure out which ones have been used
@@ -1820,6 +2149,7 @@ void MNEForwardSolution::to_fixed_ori()
         qWarning("Warning: Only surface-oriented, free-orientation forward solutions can be converted to fixed orientaton.\n");//ToDo: Throw here//qCritical//qFatal
         return;
     }
+    load_lazy_solution();
     qint32 count = 0;
     for(qint32 i = 2; i < this->sol->data.cols(); i += 3)
         this->sol->data.col(count) = this->sol->data.col(i);//ToDo: is this right? - just take z?
@@ -44,6 +44,7 @@
 
 #include "mne_global.h"
 #include "mne_sourcespace.h"
+#include "mne_lazy_gain_matrix.h"
 
 #include <utils/mnemath.h>
 #include <utils/kmeans.h>
@@ -123,7 +124,7 @@ struct RegionData
         // Kmeans Reduction
         RegionDataOut p_RegionDataOut;
 
-        UTILSLIB::KMeans t_kMeans(t_sDistMeasure, QString("sample"), 5);
+        UTILSLIB::KMeans t_kMeans(t_sDistMeasure, QString("plus"), 5);
 
         if(bUseWhitened)
         {
@@ -189,6 +190,7 @@ public:
      * @param[in] include       Include these channels (optional)
      * @param[in] exclude       Exclude these channels (optional)
      * @param[in] bExcludeBads  If true bads are also read; default = false (optional)
+     * @param[in] bLazy         If true and p_IODevice is a file, the gain matrix is memory mapped instead of read (optional)
      *
      */
     MNEForwardSolution(QIODevice &p_IODevice,
@@ -196,7 +198,8 @@ public:
                        bool surf_ori = false,
                        const QStringList& include = FIFFLIB::defaultQStringList,
                        const QStringList& exclude = FIFFLIB::defaultQStringList,
-                       bool bExcludeBads = false);
+                       bool bExcludeBads = false,
+                       bool bLazy = false);
 
     //=========================================================================================================
     /**
@@ -229,6 +232,9 @@ public:
      * @param[in]    p_pNoise_cov
      * @param[in]    p_pInfo
      * @param[in]    p_sMethod           "cityblock" or "sqeuclidean"
+     * @param[in]    p_sCacheDir         Directory to cache the clustering results in. The results are reused when
+     *                                   the forward solution, annotation, noise covariance, cluster size and method
+     *                                   match. No caching if empty (optional)
      *
      * @return clustered MNE forward solution
      */
@@ -237,7 +243,8 @@ public:
                                                 Eigen::MatrixXd& p_D = defaultD,
                                                 const FIFFLIB::FiffCov &p_pNoise_cov = defaultCov,
                                                 const FIFFLIB::FiffInfo &p_pInfo = defaultInfo,
-                                                QString p_sMethod = "cityblock") const;
+                                                QString p_sMethod = "cityblock",
+                                                const QString& p_sCacheDir = QString()) const;
 
     //=========================================================================================================
     /**
@@ -295,6 +302,23 @@ public:
      */
     inline bool isFixedOrient() const;
 
+    //=========================================================================================================
+    /**
+     * Returns whether the gain matrix is memory mapped and sol->data is not filled yet.
+     * Only cluster_forward_solution, pick_channels, pick_regions, pick_types, prepare_forward and
+     * reduce_forward_solution work on the mapped gain matrix; call load_lazy_solution before using sol->data.
+     *
+     * @return true if the gain matrix is memory mapped, false otherwise.
+     */
+    inline bool isLazy() const;
+
+    //=========================================================================================================
+    /**
+     * Reads the memory mapped gain matrix into sol->data and releases the mapping.
+     * Only the picked channels and sources are read.
+     */
+    void load_lazy_solution();
+
     //=========================================================================================================
     /**
      * mne.fiff.pick_channels_forward
@@ -428,6 +452,8 @@ public:
      * @param[in] include       Include these channels (optional)
      * @param[in] exclude       Exclude these channels (optional)
      * @param[in] bExcludeBads  If true bads are also read; default = false (optional)
+     * @param[in] bLazy         If true and p_IODevice is a file, the gain matrix is memory mapped instead of read.
+     *                          Columns are read on demand, see isLazy(). (optional)
      *
      * @return true if succeeded, false otherwise
      */
@@ -437,7 +463,8 @@ public:
                      bool surf_ori = false,
                      const QStringList& include = FIFFLIB::defaultQStringList,
                      const QStringList& exclude = FIFFLIB::defaultQStringList,
-                     bool bExcludeBads = true);
+                     bool bExcludeBads = true,
+                     bool bLazy = false);
 
     //ToDo readFromStream
 
@@ -509,12 +536,62 @@ private:
      * @param[in] p_pStream  The opened fif file to read from
      * @param[in] p_Node     The forward solution node
      * @param[out] one       The read forward solution
+     * @param[in] bLazy      Whether to map the gain matrix instead of reading it
      *
      * @return True if succeeded, false otherwise
      */
     static bool read_one(FIFFLIB::FiffStream::SPtr& p_pStream,
                          const FIFFLIB::FiffDirNode::SPtr& p_Node,
-                         MNEForwardSolution& one);
+                         MNEForwardSolution& one,
+                         bool bLazy = false);
+
+    //=========================================================================================================
+    /**
+     * Maps the gain matrix of one forward solution instead of reading it. Sets sol_lazy and the names and
+     * dimensions of sol; sol->data stays empty.
+     *
+     * @param[in] p_pStream  The opened fif file to read from
+     * @param[in] p_Node     The forward solution node
+     * @param[in, out] one   The forward solution, nsource has to be set
+     *
+     * @return True if succeeded, false otherwise
+     */
+    static bool read_lazy_gain(FIFFLIB::FiffStream::SPtr& p_pStream,
+                               const FIFFLIB::FiffDirNode::SPtr& p_Node,
+                               MNEForwardSolution& one);
+
+    //=========================================================================================================
+    /**
+     * Returns the gain matrix restricted to the given channels, reading only these rows if the solution is lazy.
+     *
+     * @param[in] p_vecSel   The selected channels.
+     *
+     * @return the selected rows of the gain matrix.
+     */
+    Eigen::MatrixXd pick_gain_rows(const Eigen::VectorXi& p_vecSel) const;
+
+    //=========================================================================================================
+    /**
+     * Computes the whitener of prepare_forward and the forward channels it applies to, without assembling the gain
+     * matrix.
+     *
+     * @param[in] p_info             Fiff information
+     * @param[in] p_noise_cov        Noise covariance matrix
+     * @param[in] p_pca              calculates pca if requested
+     * @param[out] p_outFwdInfo      Picked fiff information
+     * @param[out] p_outFwdIdx       Rows of the gain matrix the whitener applies to
+     * @param[out] p_outNoiseCov     Prepared noise covariance matrix
+     * @param[out] p_outWhitener     Whitener
+     * @param[out] p_outNumNonZero   the rank (non zeros)
+     */
+    void prepare_whitener(const FIFFLIB::FiffInfo &p_info,
+                          const FIFFLIB::FiffCov &p_noise_cov,
+                          bool p_pca,
+                          FIFFLIB::FiffInfo &p_outFwdInfo,
+                          Eigen::VectorXi &p_outFwdIdx,
+                          FIFFLIB::FiffCov &p_outNoiseCov,
+                          Eigen::MatrixXd &p_outWhitener,
+                          qint32 &p_outNumNonZero) const;
 
 public:
     FIFFLIB::FiffInfoBase info;                 /**< light weighted measurement info */
@@ -525,6 +602,7 @@ public:
     FIFFLIB::fiff_int_t nchan;                  /**< Number of channels */
     FIFFLIB::FiffNamedMatrix::SDPtr sol;        /**< Forward solution */
     FIFFLIB::FiffNamedMatrix::SDPtr sol_grad;   /**< ToDo... */
+    MNELazyGainMatrix::SPtr sol_lazy;           /**< Memory mapped gain matrix, if read lazily; sol then holds only names and dimensions */
     FIFFLIB::FiffCoordTrans mri_head_t;         /**< MRI head coordinate transformation */
     MNESourceSpace src;                         /**< Geometric description of the source spaces (hemispheres) */
     Eigen::MatrixX3f source_rr;                 /**< Source locations */
@@ -556,6 +634,13 @@ inline bool MNEForwardSolution::isFixedOrient() const
 
 //=============================================================================================================
 
+inline bool MNEForwardSolution::isLazy() const
+{
+    return !this->sol_lazy.isNull();
+}
+
+//=============================================================================================================
+
 inline std::ostream& operator<<(std::ostream& out, const MNELIB::MNEForwardSolution &p_MNEForwardSolution)
 {
     out << "#### MNE Forward Solution ####\n";
@@ -161,6 +161,29 @@ bool MNEInverseOperator::assemble_kernel(const Label &label,
                                          MatrixXd &K,
                                          SparseMatrix<double> &noise_norm,
                                          QList<VectorXi> &vertno)
+{
+    MatrixXd matLeads, matTrans;
+    if(!assemble_kernel_factors(label, method, pick_normal, matLeads, matTrans, noise_norm, vertno)) {
+        return false;
+    }
+
+    K = matLeads*matTrans;
+
+    //store assembled kernel
+    m_K = K;
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool MNEInverseOperator::assemble_kernel_factors(const Label &label,
+                                                 QString method,
+                                                 bool pick_normal,
+                                                 MatrixXd &matLeads,
+                                                 MatrixXd &matTrans,
+                                                 SparseMatrix<double> &noise_norm,
+                                                 QList<VectorXi> &vertno) const
 {
     MatrixXd t_eigen_leads = this->eigen_leads->data;
     MatrixXd t_source_cov = this->source_cov->data;
@@ -263,7 +286,7 @@ bool MNEInverseOperator::assemble_kernel(const Label &label,
     SparseMatrix<double> t_reginv(reginv.rows(),reginv.rows());
     t_reginv.setFromTriplets(tripletList.begin(), tripletList.end());
 
-    MatrixXd trans = t_reginv*eigen_fields->data*whitener*proj;
+    matTrans = t_reginv*eigen_fields->data*whitener*proj;
     //
     //   Transformation into current distributions by weighting the eigenleads
     //   with the weights computed above
@@ -274,7 +297,7 @@ bool MNEInverseOperator::assemble_kernel(const Label &label,
         //     R^0.5 has been already factored in
         //
         printf("(eigenleads already weighted)...\n");
-        K = t_eigen_leads*trans;
+        matLeads = t_eigen_leads;
     }
     else
     {
@@ -290,15 +313,12 @@ bool MNEInverseOperator::assemble_kernel(const Label &label,
        SparseMatrix<double> t_sourceCov(t_source_cov.rows(),t_source_cov.rows());
        t_sourceCov.setFromTriplets(tripletList2.begin(), tripletList2.end());
 
-       K = t_sourceCov*t_eigen_leads*trans;
+       matLeads = t_sourceCov*t_eigen_leads;
     }
 
     if(method.compare("MNE") == 0)
         noise_norm = SparseMatrix<double>();
 
-    //store assembled kernel
-    m_K = K;
-
     return true;
 }
 
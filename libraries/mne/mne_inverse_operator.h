@@ -216,6 +216,31 @@ public:
                          Eigen::SparseMatrix<double> &noise_norm,
                          QList<Eigen::VectorXi> &vertno);
 
+    //=========================================================================================================
+    /**
+     * Assembles the imaging kernel in factored form K = matLeads * matTrans without forming the dense
+     * n_sources x n_channels product. matLeads holds the (source covariance weighted) eigenleads and matTrans
+     * the regularized, whitened and projected eigenfields, i.e. the kernel is kept as its whitened SVD factors.
+     * Applying both factors one after the other (two thin products) is equivalent to applying the kernel.
+     *
+     * @param[in] label          labels.
+     * @param[in] method         The applied normals. ("MNE" | "dSPM" | "sLORETA")
+     * @param[in] pick_normal    Pick normals.
+     * @param[out] matLeads      Left kernel factor (n_sources x rank).
+     * @param[out] matTrans      Right kernel factor (rank x n_channels).
+     * @param[out] noise_norm    Noise normals.
+     * @param[out] vertno        Vertices of the hemispheres.
+     *
+     * @return true when successful, false otherwise
+     */
+    bool assemble_kernel_factors(const FSLIB::Label &label,
+                                 QString method,
+                                 bool pick_normal,
+                                 Eigen::MatrixXd &matLeads,
+                                 Eigen::MatrixXd &matTrans,
+                                 Eigen::SparseMatrix<double> &noise_norm,
+                                 QList<Eigen::VectorXi> &vertno) const;
+
     //=========================================================================================================
     /**
      * Check that channels in inverse operator are measurements.
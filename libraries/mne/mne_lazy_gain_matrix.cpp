@@ -0,0 +1,270 @@
+//=============================================================================================================
+/**
+ * @file     mne_lazy_gain_matrix.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the MNELazyGainMatrix Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "mne_lazy_gain_matrix.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtConcurrent>
+#include <QDebug>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+MNELazyGainMatrix::MNELazyGainMatrix(qint32 iNumSources)
+: m_iNumRowsTotal(0)
+, m_iNumSources(iNumSources)
+, m_iStoredCols(0)
+, m_vecSourceSel(VectorXi::LinSpaced(iNumSources, 0, iNumSources - 1))
+, m_orientation(Cartesian)
+{
+}
+
+//=============================================================================================================
+
+bool MNELazyGainMatrix::appendRows(const FiffMappedMatrix::SPtr& pMatrix)
+{
+    if(!pMatrix || !pMatrix->isOpen() || m_iNumSources <= 0) {
+        return false;
+    }
+
+    if(m_lParts.isEmpty()) {
+        if(pMatrix->cols() != m_iNumSources && pMatrix->cols() != 3 * m_iNumSources) {
+            qWarning() << "[MNELazyGainMatrix::appendRows] Number of columns does not match the number of sources.";
+            return false;
+        }
+        m_iStoredCols = pMatrix->cols() / m_iNumSources;
+    } else if(pMatrix->cols() != m_iStoredCols * m_iNumSources) {
+        qWarning() << "[MNELazyGainMatrix::appendRows] Number of columns does not match.";
+        return false;
+    }
+
+    qint32 iOldSize = m_vecRowSel.size();
+    m_vecRowSel.conservativeResize(iOldSize + pMatrix->rows());
+    for(qint32 i = 0; i < pMatrix->rows(); ++i) {
+        m_vecRowSel[iOldSize + i] = m_iNumRowsTotal + i;
+    }
+
+    m_lParts.append(pMatrix);
+    m_iNumRowsTotal += pMatrix->rows();
+
+    updatePartSelection();
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool MNELazyGainMatrix::appendRows(const MNELazyGainMatrix& other)
+{
+    if(other.m_iNumSources != m_iNumSources || other.m_iStoredCols != m_iStoredCols || other.numSources() != numSources()) {
+        qWarning() << "[MNELazyGainMatrix::appendRows] Gain matrices do not match.";
+        return false;
+    }
+
+    qint32 iOldSize = m_vecRowSel.size();
+    m_vecRowSel.conservativeResize(iOldSize + other.m_vecRowSel.size());
+    m_vecRowSel.tail(other.m_vecRowSel.size()) = other.m_vecRowSel.array() + m_iNumRowsTotal;
+
+    m_lParts.append(other.m_lParts);
+    m_iNumRowsTotal += other.m_iNumRowsTotal;
+
+    updatePartSelection();
+
+    return true;
+}
+
+//=============================================================================================================
+
+void MNELazyGainMatrix::setOrientation(OrientationMode mode,
+                                       const MatrixX3f& matSourceNN)
+{
+    m_orientation = mode;
+    m_matSourceNN = mode == Cartesian ? MatrixX3f() : matSourceNN;
+}
+
+//=============================================================================================================
+
+void MNELazyGainMatrix::selectRows(const VectorXi& vecSel)
+{
+    VectorXi vecRowSel(vecSel.size());
+    for(qint32 i = 0; i < vecSel.size(); ++i) {
+        vecRowSel[i] = m_vecRowSel[vecSel[i]];
+    }
+    m_vecRowSel = vecRowSel;
+
+    updatePartSelection();
+}
+
+//=============================================================================================================
+
+void MNELazyGainMatrix::selectSources(const VectorXi& vecSel)
+{
+    VectorXi vecSourceSel(vecSel.size());
+    for(qint32 i = 0; i < vecSel.size(); ++i) {
+        vecSourceSel[i] = m_vecSourceSel[vecSel[i]];
+    }
+    m_vecSourceSel = vecSourceSel;
+}
+
+//=============================================================================================================
+
+MatrixXf MNELazyGainMatrix::sourceBlock(qint32 iSource) const
+{
+    const qint32 iOrigSource = m_vecSourceSel[iSource];
+
+    MatrixXf matStored(rows(), m_iStoredCols);
+    VectorXf vecBuffer;
+
+    for(qint32 c = 0; c < m_iStoredCols; ++c) {
+        const qint32 iCol = iOrigSource * m_iStoredCols + c;
+
+        for(qint32 p = 0; p < m_lParts.size(); ++p) {
+            const VectorXi& vecPartRows = m_lPartRows[p];
+            if(vecPartRows.size() == 0) {
+                continue;
+            }
+
+            const VectorXi& vecPartDest = m_lPartDest[p];
+            vecBuffer.resize(vecPartRows.size());
+            m_lParts[p]->readColumn(iCol, vecPartRows, vecBuffer.data());
+
+            for(qint32 k = 0; k < vecPartRows.size(); ++k) {
+                matStored(vecPartDest[k], c) = vecBuffer[k];
+            }
+        }
+    }
+
+    if(m_iStoredCols == 3) {
+        if(m_orientation == SurfaceOriented) {
+            return matStored * m_matSourceNN.block(3 * iOrigSource, 0, 3, 3).transpose();
+        } else if(m_orientation == FixedOriented) {
+            return matStored * m_matSourceNN.row(iOrigSource).transpose();
+        }
+    }
+
+    return matStored;
+}
+
+//=============================================================================================================
+
+MatrixXd MNELazyGainMatrix::sources(const VectorXi& vecSources) const
+{
+    const qint32 iColsPerSource = colsPerSource();
+    MatrixXd matGain(rows(), vecSources.size() * iColsPerSource);
+
+    for(qint32 i = 0; i < vecSources.size(); ++i) {
+        matGain.middleCols(i * iColsPerSource, iColsPerSource) = sourceBlock(vecSources[i]).cast<double>();
+    }
+
+    return matGain;
+}
+
+//=============================================================================================================
+
+MatrixXf MNELazyGainMatrix::toDenseFloat() const
+{
+    const qint32 iColsPerSource = colsPerSource();
+    MatrixXf matGain(rows(), cols());
+
+    QVector<qint32> vecSources(numSources());
+    for(qint32 i = 0; i < vecSources.size(); ++i) {
+        vecSources[i] = i;
+    }
+
+    // Each source writes its own columns, no synchronization needed
+    auto readSource = [&](const qint32 iSource) {
+        matGain.middleCols(iSource * iColsPerSource, iColsPerSource) = sourceBlock(iSource);
+    };
+
+    QFuture<void> future = QtConcurrent::map(vecSources, readSource);
+    future.waitForFinished();
+
+    return matGain;
+}
+
+//=============================================================================================================
+
+MatrixXd MNELazyGainMatrix::toDense() const
+{
+    return toDenseFloat().cast<double>();
+}
+
+//=============================================================================================================
+
+void MNELazyGainMatrix::updatePartSelection()
+{
+    m_lPartRows.clear();
+    m_lPartDest.clear();
+
+    QVector<qint32> vecOffsets;
+    qint32 iOffset = 0;
+    for(qint32 p = 0; p < m_lParts.size(); ++p) {
+        vecOffsets.append(iOffset);
+        iOffset += m_lParts[p]->rows();
+        m_lPartRows.append(VectorXi(m_vecRowSel.size()));
+        m_lPartDest.append(VectorXi(m_vecRowSel.size()));
+    }
+
+    QVector<qint32> vecCount(m_lParts.size(), 0);
+    for(qint32 i = 0; i < m_vecRowSel.size(); ++i) {
+        qint32 p = m_lParts.size() - 1;
+        while(p > 0 && m_vecRowSel[i] < vecOffsets[p]) {
+            --p;
+        }
+        m_lPartRows[p][vecCount[p]] = m_vecRowSel[i] - vecOffsets[p];
+        m_lPartDest[p][vecCount[p]] = i;
+        ++vecCount[p];
+    }
+
+    for(qint32 p = 0; p < m_lParts.size(); ++p) {
+        m_lPartRows[p].conservativeResize(vecCount[p]);
+        m_lPartDest[p].conservativeResize(vecCount[p]);
+    }
+}
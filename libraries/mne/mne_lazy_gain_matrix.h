@@ -0,0 +1,264 @@
+//=============================================================================================================
+/**
+ * @file     mne_lazy_gain_matrix.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    MNELazyGainMatrix class declaration.
+ *
+ */
+
+#ifndef MNE_LAZY_GAIN_MATRIX_H
+#define MNE_LAZY_GAIN_MATRIX_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "mne_global.h"
+
+#include <fiff/fiff_mapped_matrix.h>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QList>
+#include <QSharedPointer>
+
+//=============================================================================================================
+// DEFINE NAMESPACE MNELIB
+//=============================================================================================================
+
+namespace MNELIB
+{
+
+//=============================================================================================================
+/**
+ * Gain matrix whose entries stay in the memory mapped forward solution file. Channel (row) and source picks as
+ * well as the orientation change of MNEForwardSolution::read are only recorded; columns are read and rotated
+ * when a block of sources is requested. Several mapped matrices (e.g. MEG and EEG) are stacked row wise.
+ *
+ * @brief Memory mapped, lazily evaluated forward gain matrix
+ */
+class MNESHARED_EXPORT MNELazyGainMatrix
+{
+public:
+    typedef QSharedPointer<MNELazyGainMatrix> SPtr;             /**< Shared pointer type for MNELazyGainMatrix. */
+    typedef QSharedPointer<const MNELazyGainMatrix> ConstSPtr;  /**< Const shared pointer type for MNELazyGainMatrix. */
+
+    /**
+     * Orientation applied to the stored gain columns of each source.
+     */
+    enum OrientationMode {
+        Cartesian,          /**< Columns as stored in the file. */
+        SurfaceOriented,    /**< Free orientation rotated into the local surface coordinate system. */
+        FixedOriented       /**< Free orientation projected onto the source normal. */
+    };
+
+    //=========================================================================================================
+    /**
+     * Constructs an empty gain matrix.
+     *
+     * @param[in] iNumSources    Number of sources of the forward solution.
+     */
+    explicit MNELazyGainMatrix(qint32 iNumSources = 0);
+
+    //=========================================================================================================
+    /**
+     * Appends the rows of a mapped matrix. All parts must have the same number of columns.
+     *
+     * @param[in] pMatrix    The mapped matrix, sensors x source components.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    bool appendRows(const FIFFLIB::FiffMappedMatrix::SPtr& pMatrix);
+
+    //=========================================================================================================
+    /**
+     * Appends the rows of another lazy gain matrix, e.g. the EEG part to the MEG part.
+     *
+     * @param[in] other      The gain matrix to append. Its row selection is kept.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    bool appendRows(const MNELazyGainMatrix& other);
+
+    //=========================================================================================================
+    /**
+     * Sets the orientation which is applied on access.
+     *
+     * @param[in] mode           The orientation mode.
+     * @param[in] matSourceNN    Source normals: nsource x 3 for FixedOriented, 3*nsource x 3 (one rotation per
+     *                           source) for SurfaceOriented. Ignored for Cartesian.
+     */
+    void setOrientation(OrientationMode mode,
+                        const Eigen::MatrixX3f& matSourceNN = Eigen::MatrixX3f());
+
+    //=========================================================================================================
+    /**
+     * Restricts the rows to the given selection.
+     *
+     * @param[in] vecSel     Selected rows, relative to the current row selection.
+     */
+    void selectRows(const Eigen::VectorXi& vecSel);
+
+    //=========================================================================================================
+    /**
+     * Restricts the sources to the given selection.
+     *
+     * @param[in] vecSel     Selected sources, relative to the current source selection.
+     */
+    void selectSources(const Eigen::VectorXi& vecSel);
+
+    //=========================================================================================================
+    /**
+     * Returns the number of (selected) rows.
+     *
+     * @return the number of rows.
+     */
+    inline qint32 rows() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of columns after orientation and source selection.
+     *
+     * @return the number of columns.
+     */
+    inline qint32 cols() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of (selected) sources.
+     *
+     * @return the number of sources.
+     */
+    inline qint32 numSources() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of columns per source after orientation, i.e. 1 or 3.
+     *
+     * @return the number of columns per source.
+     */
+    inline qint32 colsPerSource() const;
+
+    //=========================================================================================================
+    /**
+     * Reads the gain columns of one source.
+     *
+     * @param[in] iSource    The source, relative to the current source selection.
+     *
+     * @return rows() x colsPerSource() gain block.
+     */
+    Eigen::MatrixXf sourceBlock(qint32 iSource) const;
+
+    //=========================================================================================================
+    /**
+     * Reads the gain columns of a set of sources.
+     *
+     * @param[in] vecSources     The sources, relative to the current source selection.
+     *
+     * @return rows() x vecSources.size()*colsPerSource() gain matrix.
+     */
+    Eigen::MatrixXd sources(const Eigen::VectorXi& vecSources) const;
+
+    //=========================================================================================================
+    /**
+     * Reads the whole (selected) gain matrix in single precision. Sources are read in parallel.
+     *
+     * @return rows() x cols() gain matrix.
+     */
+    Eigen::MatrixXf toDenseFloat() const;
+
+    //=========================================================================================================
+    /**
+     * Reads the whole (selected) gain matrix.
+     *
+     * @return rows() x cols() gain matrix.
+     */
+    Eigen::MatrixXd toDense() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Splits the global row selection into per part local rows and destination rows.
+     */
+    void updatePartSelection();
+
+    QList<FIFFLIB::FiffMappedMatrix::SPtr>  m_lParts;           /**< Mapped matrices, stacked row wise. */
+    QList<Eigen::VectorXi>                  m_lPartRows;        /**< Selected rows within each part. */
+    QList<Eigen::VectorXi>                  m_lPartDest;        /**< Destination row of each selected part row. */
+    qint32                                  m_iNumRowsTotal;    /**< Number of rows of all parts. */
+    Eigen::VectorXi                         m_vecRowSel;        /**< Selected rows over all parts. */
+
+    qint32                                  m_iNumSources;      /**< Number of sources of the file. */
+    qint32                                  m_iStoredCols;      /**< Number of stored columns per source: 1 or 3. */
+    Eigen::VectorXi                         m_vecSourceSel;     /**< Selected sources. */
+
+    OrientationMode                         m_orientation;      /**< The orientation applied on access. */
+    Eigen::MatrixX3f                        m_matSourceNN;      /**< Normals or rotations for all sources of the file. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline qint32 MNELazyGainMatrix::rows() const
+{
+    return static_cast<qint32>(m_vecRowSel.size());
+}
+
+//=============================================================================================================
+
+inline qint32 MNELazyGainMatrix::cols() const
+{
+    return numSources() * colsPerSource();
+}
+
+//=============================================================================================================
+
+inline qint32 MNELazyGainMatrix::numSources() const
+{
+    return static_cast<qint32>(m_vecSourceSel.size());
+}
+
+//=============================================================================================================
+
+inline qint32 MNELazyGainMatrix::colsPerSource() const
+{
+    return m_orientation == FixedOriented ? 1 : m_iStoredCols;
+}
+} // NAMESPACE
+
+#endif // MNE_LAZY_GAIN_MATRIX_H
@@ -0,0 +1,720 @@
+//=============================================================================================================
+/**
+ * @file     mne_source_morph.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    MNESourceMorph class definition.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "mne_source_morph.h"
+
+#include <fs/surface.h>
+#include <utils/filecache.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtConcurrent>
+#include <QBuffer>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QThreadPool>
+#include <QDebug>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace FSLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+namespace
+{
+
+typedef SparseMatrix<double, RowMajor> RowSparseMatrix;
+
+const quint32 MORPH_FILE_MAGIC = 0x4d4f5250;     /**< "MORP" */
+const qint32 MORPH_FILE_VERSION = 1;
+}
+
+//=============================================================================================================
+
+/**
+ * Vertex adjacency of a triangulated surface, including the vertices themselves.
+ */
+static RowSparseMatrix surfaceAdjacency(const MatrixX3i& matTris,
+                                        qint32 iNumVert)
+{
+    std::vector<Triplet<double> > vecTriplets;
+    vecTriplets.reserve(6 * matTris.rows() + iNumVert);
+
+    for(qint32 i = 0; i < iNumVert; ++i)
+        vecTriplets.push_back(Triplet<double>(i, i, 1.0));
+
+    for(Index t = 0; t < matTris.rows(); ++t)
+    {
+        for(int k = 0; k < 3; ++k)
+        {
+            int a = matTris(t, k);
+            int b = matTris(t, (k + 1) % 3);
+            vecTriplets.push_back(Triplet<double>(a, b, 1.0));
+            vecTriplets.push_back(Triplet<double>(b, a, 1.0));
+        }
+    }
+
+    RowSparseMatrix matAdj(iNumVert, iNumVert);
+    matAdj.setFromTriplets(vecTriplets.begin(), vecTriplets.end());
+
+    // Edges are shared by two triangles, only the pattern is of interest
+    for(Index i = 0; i < matAdj.nonZeros(); ++i)
+        matAdj.valuePtr()[i] = 1.0;
+
+    return matAdj;
+}
+
+//=============================================================================================================
+
+/**
+ * Spreads the source vertices over the surface. Every step replaces the value of a vertex by the mean of the
+ * vertex and its neighbours which already carry data. Returns all vertices x source vertices.
+ */
+static RowSparseMatrix smoothingMatrix(const RowSparseMatrix& matAdj,
+                                       const VectorXi& vecVertices,
+                                       qint32 iSmooth,
+                                       VectorXd& vecUsed)
+{
+    const Index iNumVert = matAdj.rows();
+
+    std::vector<Triplet<double> > vecTriplets;
+    vecTriplets.reserve(vecVertices.size());
+    vecUsed = VectorXd::Zero(iNumVert);
+    for(Index k = 0; k < vecVertices.size(); ++k)
+    {
+        vecTriplets.push_back(Triplet<double>(vecVertices[k], static_cast<int>(k), 1.0));
+        vecUsed[vecVertices[k]] = 1.0;
+    }
+
+    RowSparseMatrix matSmooth(iNumVert, vecVertices.size());
+    matSmooth.setFromTriplets(vecTriplets.begin(), vecTriplets.end());
+
+    Index iNumUsed = static_cast<Index>(vecUsed.sum());
+
+    for(qint32 iStep = 0; iSmooth < 0 || iStep < iSmooth; ++iStep)
+    {
+        if(iNumUsed == iNumVert)
+            break;
+
+        VectorXd vecCount = matAdj * vecUsed;
+        RowSparseMatrix matNext = matAdj * matSmooth;
+
+        Index iNumUsedNext = 0;
+        for(Index r = 0; r < matNext.outerSize(); ++r)
+        {
+            if(vecCount[r] > 0.0)
+            {
+                const double dScale = 1.0 / vecCount[r];
+                for(RowSparseMatrix::InnerIterator it(matNext, r); it; ++it)
+                    it.valueRef() *= dScale;
+                vecUsed[r] = 1.0;
+                ++iNumUsedNext;
+            }
+        }
+
+        matSmooth = matNext;
+
+        // Surfaces with unconnected parts never get covered completely
+        if(iNumUsedNext == iNumUsed)
+            break;
+        iNumUsed = iNumUsedNext;
+    }
+
+    return matSmooth;
+}
+
+//=============================================================================================================
+
+/**
+ * Nearest candidate vertex for each query point. The candidates are binned into a uniform grid whose cells
+ * hold a few points each, the search visits rings of cells around the query until no closer point can exist.
+ */
+static VectorXi nearestVertices(const MatrixX3f& matPoints,
+                                const VectorXi& vecCandidates,
+                                const MatrixX3f& matQuery)
+{
+    VectorXi vecNearest = VectorXi::Constant(matQuery.rows(), -1);
+    const Index iNumCand = vecCandidates.size();
+    if(iNumCand == 0)
+        return vecNearest;
+
+    Vector3f vecMin = matPoints.row(vecCandidates[0]).transpose();
+    Vector3f vecMax = vecMin;
+    for(Index k = 1; k < iNumCand; ++k)
+    {
+        vecMin = vecMin.cwiseMin(matPoints.row(vecCandidates[k]).transpose());
+        vecMax = vecMax.cwiseMax(matPoints.row(vecCandidates[k]).transpose());
+    }
+
+    // The points lie on a sphere, aim for about four points per occupied cell
+    const float fRadius = 0.5f * (vecMax - vecMin).maxCoeff();
+    float fCell = 4.0f * fRadius * std::sqrt(3.14159265f / iNumCand);
+    if(!(fCell > 0.0f))
+        fCell = 1.0f;
+
+    Vector3i vecDims;
+    forever
+    {
+        vecDims = ((vecMax - vecMin) / fCell).array().floor().cast<int>() + 1;
+        if(static_cast<qint64>(vecDims[0]) * vecDims[1] * vecDims[2] <= 8 * static_cast<qint64>(iNumCand) + 64)
+            break;
+        fCell *= 1.5f;
+    }
+
+    auto cellCoord = [&](const Vector3f& p) {
+        Vector3i c = ((p - vecMin) / fCell).array().floor().cast<int>();
+        return c.cwiseMax(0).cwiseMin(vecDims - Vector3i::Ones()).eval();
+    };
+    auto cellIndex = [&](const Vector3i& c) {
+        return (c[2] * vecDims[1] + c[1]) * vecDims[0] + c[0];
+    };
+
+    // Counting sort of the candidates into the cells
+    const int iNumCells = vecDims[0] * vecDims[1] * vecDims[2];
+    VectorXi vecCellStart = VectorXi::Zero(iNumCells + 1);
+    VectorXi vecCellOfCand(iNumCand);
+    for(Index k = 0; k < iNumCand; ++k)
+    {
+        vecCellOfCand[k] = cellIndex(cellCoord(matPoints.row(vecCandidates[k]).transpose()));
+        ++vecCellStart[vecCellOfCand[k] + 1];
+    }
+    for(int c = 0; c < iNumCells; ++c)
+        vecCellStart[c + 1] += vecCellStart[c];
+
+    VectorXi vecSorted(iNumCand);
+    VectorXi vecFill = vecCellStart.head(iNumCells);
+    for(Index k = 0; k < iNumCand; ++k)
+        vecSorted[vecFill[vecCellOfCand[k]]++] = vecCandidates[k];
+
+    const int iMaxRing = vecDims.maxCoeff();
+
+    auto query = [&](Index q) {
+        const Vector3f p = matQuery.row(q).transpose();
+        const Vector3i c = cellCoord(p);
+
+        // Distance of the query to its (clamped) cell, non zero for queries outside of the grid
+        Vector3f vecCellMin = vecMin + c.cast<float>() * fCell;
+        float fOutside = (vecCellMin - p).cwiseMax(p - vecCellMin - Vector3f::Constant(fCell)).cwiseMax(0.0f).norm();
+
+        float fBest = std::numeric_limits<float>::max();
+        int iBest = -1;
+
+        for(int r = 0; r <= iMaxRing; ++r)
+        {
+            for(int dz = -r; dz <= r; ++dz)
+            {
+                const int z = c[2] + dz;
+                if(z < 0 || z >= vecDims[2])
+                    continue;
+                for(int dy = -r; dy <= r; ++dy)
+                {
+                    const int y = c[1] + dy;
+                    if(y < 0 || y >= vecDims[1])
+                        continue;
+                    const bool bShell = std::abs(dz) == r || std::abs(dy) == r;
+                    for(int dx = -r; dx <= r; dx += (bShell || r == 0) ? 1 : 2 * r)
+                    {
+                        const int x = c[0] + dx;
+                        if(x < 0 || x >= vecDims[0])
+                            continue;
+                        const int iCell = (z * vecDims[1] + y) * vecDims[0] + x;
+                        for(int k = vecCellStart[iCell]; k < vecCellStart[iCell + 1]; ++k)
+                        {
+                            float fDist = (matPoints.row(vecSorted[k]).transpose() - p).squaredNorm();
+                            if(fDist < fBest)
+                            {
+                                fBest = fDist;
+                                iBest = vecSorted[k];
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Points of the next ring are at least r cells away
+            const float fBound = r * fCell - fOutside;
+            if(iBest >= 0 && fBound > 0.0f && fBest <= fBound * fBound)
+                break;
+        }
+
+        vecNearest[q] = iBest;
+    };
+
+    const Index iChunk = 4096;
+    QVector<Index> vecChunks;
+    for(Index q = 0; q < matQuery.rows(); q += iChunk)
+        vecChunks.append(q);
+
+    QFuture<void> future = QtConcurrent::map(vecChunks, [&](const Index& iStart) {
+        const Index iEnd = std::min(iStart + iChunk, static_cast<Index>(matQuery.rows()));
+        for(Index q = iStart; q < iEnd; ++q)
+            query(q);
+    });
+    future.waitForFinished();
+
+    return vecNearest;
+}
+
+//=============================================================================================================
+
+static QString sphereFileName(const QString& sSubjectsDir,
+                              const QString& sSubject,
+                              qint32 hemi)
+{
+    return QString("%1/%2/surf/%3.sphere.reg").arg(sSubjectsDir).arg(sSubject).arg(hemi == 0 ? "lh" : "rh");
+}
+
+//=============================================================================================================
+
+/**
+ * The cache key covers the subjects, the vertices and the smoothing steps. Size and modification time of the
+ * spheres are included so that a re-registered subject invalidates the cached operator.
+ */
+static QString morphCacheKey(const QString& sSubjectFrom,
+                             const QString& sSubjectTo,
+                             const QString& sSubjectsDir,
+                             const QList<VectorXi>& lVerticesFrom,
+                             const QList<VectorXi>& lVerticesTo,
+                             qint32 iSmooth)
+{
+    FileCacheKey key("MNESourceMorph v1");
+    key.add(sSubjectFrom).add(sSubjectTo).addValue(iSmooth);
+
+    for(qint32 h = 0; h < 2; ++h)
+    {
+        for(const QString& sFile : {sphereFileName(sSubjectsDir, sSubjectFrom, h), sphereFileName(sSubjectsDir, sSubjectTo, h)})
+        {
+            QFileInfo info(sFile);
+            key.addValue(info.size()).addValue(info.lastModified().toMSecsSinceEpoch());
+        }
+
+        key.addMatrix(lVerticesFrom[h]).addMatrix(lVerticesTo[h]);
+    }
+
+    return key.result();
+}
+
+//=============================================================================================================
+
+static void writeVector(QDataStream& stream, const VectorXi& vec)
+{
+    stream << static_cast<qint32>(vec.size());
+    stream.writeRawData(reinterpret_cast<const char*>(vec.data()), static_cast<int>(vec.size() * sizeof(int)));
+}
+
+//=============================================================================================================
+
+static bool readVector(QDataStream& stream, VectorXi& vec)
+{
+    qint32 size;
+    stream >> size;
+    if(stream.status() != QDataStream::Ok || size < 0)
+        return false;
+    vec.resize(size);
+    int iBytes = static_cast<int>(size * sizeof(int));
+    return stream.readRawData(reinterpret_cast<char*>(vec.data()), iBytes) == iBytes;
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+MNESourceMorph::MNESourceMorph()
+: m_bFloat(false)
+, m_bMultiThreaded(true)
+{
+}
+
+//=============================================================================================================
+
+bool MNESourceMorph::compute(const QString& sSubjectFrom,
+                             const QString& sSubjectTo,
+                             const QString& sSubjectsDir,
+                             const QList<VectorXi>& lVerticesFrom,
+                             const QList<VectorXi>& lVerticesTo,
+                             qint32 iSmooth,
+                             const QString& sCacheDir)
+{
+    if(lVerticesFrom.size() != 2 || lVerticesTo.size() != 2)
+    {
+        qWarning("MNESourceMorph::compute - Vertices of both hemispheres are required.");
+        return false;
+    }
+
+    FileCache cache(sCacheDir, "morph");
+    QString sCacheKey;
+    if(cache.isEnabled())
+    {
+        sCacheKey = morphCacheKey(sSubjectFrom, sSubjectTo, sSubjectsDir, lVerticesFrom, lVerticesTo, iSmooth);
+
+        QByteArray baCached;
+        if(cache.read(sCacheKey, baCached))
+        {
+            QBuffer buffer(&baCached);
+            buffer.open(QIODevice::ReadOnly);
+
+            bool bFloat = m_bFloat, bMultiThreaded = m_bMultiThreaded;
+            if(read(buffer, *this))
+            {
+                m_bFloat = bFloat;
+                m_bMultiThreaded = bMultiThreaded;
+                return true;
+            }
+            qWarning("MNESourceMorph::compute - Ignoring invalid cache file %s", cache.getFileName(sCacheKey).toUtf8().constData());
+        }
+    }
+
+    std::vector<Triplet<double> > vecTriplets;
+    Index iRowOffset = 0, iColOffset = 0;
+
+    for(qint32 h = 0; h < 2; ++h)
+    {
+        Surface surfFrom, surfTo;
+        if(!Surface::read(sphereFileName(sSubjectsDir, sSubjectFrom, h), surfFrom, false)
+                || !Surface::read(sphereFileName(sSubjectsDir, sSubjectTo, h), surfTo, false))
+        {
+            qWarning("MNESourceMorph::compute - Could not read the sphere.reg surfaces.");
+            return false;
+        }
+
+        SparseMatrix<double> matHemi = computeHemisphere(surfFrom.rr(), surfFrom.tris(), lVerticesFrom[h],
+                                                         surfTo.rr(), lVerticesTo[h], iSmooth);
+        if(matHemi.size() == 0)
+            return false;
+
+        for(Index c = 0; c < matHemi.outerSize(); ++c)
+            for(SparseMatrix<double>::InnerIterator it(matHemi, c); it; ++it)
+                vecTriplets.push_back(Triplet<double>(it.row() + iRowOffset, it.col() + iColOffset, it.value()));
+
+        iRowOffset += matHemi.rows();
+        iColOffset += matHemi.cols();
+    }
+
+    SparseMatrix<double> matMorph(iRowOffset, iColOffset);
+    matMorph.setFromTriplets(vecTriplets.begin(), vecTriplets.end());
+    setOperator(matMorph, lVerticesFrom, lVerticesTo);
+
+    if(cache.isEnabled())
+    {
+        QByteArray baCached;
+        QBuffer buffer(&baCached);
+        buffer.open(QIODevice::WriteOnly);
+        if(write(buffer))
+            cache.write(sCacheKey, baCached);
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+SparseMatrix<double> MNESourceMorph::computeHemisphere(const MatrixX3f& matSphereFrom,
+                                                       const MatrixX3i& matTrisFrom,
+                                                       const VectorXi& vecVerticesFrom,
+                                                       const MatrixX3f& matSphereTo,
+                                                       const VectorXi& vecVerticesTo,
+                                                       qint32 iSmooth)
+{
+    const qint32 iNumVert = static_cast<qint32>(matSphereFrom.rows());
+
+    if(vecVerticesFrom.size() == 0 || vecVerticesFrom.minCoeff() < 0 || vecVerticesFrom.maxCoeff() >= iNumVert
+            || (vecVerticesTo.size() > 0 && (vecVerticesTo.minCoeff() < 0 || vecVerticesTo.maxCoeff() >= matSphereTo.rows())))
+    {
+        qWarning("MNESourceMorph::computeHemisphere - Vertices do not match the surfaces.");
+        return SparseMatrix<double>();
+    }
+
+    VectorXd vecUsed;
+    RowSparseMatrix matSmooth = smoothingMatrix(surfaceAdjacency(matTrisFrom, iNumVert), vecVerticesFrom, iSmooth, vecUsed);
+
+    // Only vertices which carry data after smoothing are valid nearest neighbours
+    VectorXi vecCovered(static_cast<Index>(vecUsed.sum()));
+    for(Index i = 0, k = 0; i < vecUsed.size(); ++i)
+        if(vecUsed[i] > 0.0)
+            vecCovered[k++] = static_cast<int>(i);
+
+    MatrixX3f matQuery(vecVerticesTo.size(), 3);
+    for(Index t = 0; t < vecVerticesTo.size(); ++t)
+        matQuery.row(t) = matSphereTo.row(vecVerticesTo[t]);
+
+    VectorXi vecNearest = nearestVertices(matSphereFrom, vecCovered, matQuery);
+
+    std::vector<Triplet<double> > vecTriplets;
+    for(Index t = 0; t < vecNearest.size(); ++t)
+        for(RowSparseMatrix::InnerIterator it(matSmooth, vecNearest[t]); it; ++it)
+            vecTriplets.push_back(Triplet<double>(static_cast<int>(t), static_cast<int>(it.col()), it.value()));
+
+    SparseMatrix<double> matMorph(vecVerticesTo.size(), vecVerticesFrom.size());
+    matMorph.setFromTriplets(vecTriplets.begin(), vecTriplets.end());
+
+    return matMorph;
+}
+
+//=============================================================================================================
+
+void MNESourceMorph::setOperator(const SparseMatrix<double>& matMorph,
+                                 const QList<VectorXi>& lVerticesFrom,
+                                 const QList<VectorXi>& lVerticesTo)
+{
+    m_matMorph = matMorph;
+    m_matMorph.makeCompressed();
+    m_matMorphF = m_matMorph.cast<float>();
+    m_lVerticesFrom = lVerticesFrom;
+    m_lVerticesTo = lVerticesTo;
+}
+
+//=============================================================================================================
+
+void MNESourceMorph::setFloatPrecision(bool bFloat)
+{
+    m_bFloat = bFloat;
+}
+
+//=============================================================================================================
+
+void MNESourceMorph::setMultiThreaded(bool bMultiThreaded)
+{
+    m_bMultiThreaded = bMultiThreaded;
+}
+
+//=============================================================================================================
+
+MNESourceEstimate MNESourceMorph::apply(const MNESourceEstimate& stcFrom) const
+{
+    if(isEmpty() || stcFrom.data.rows() != m_matMorph.cols())
+    {
+        qWarning("MNESourceMorph::apply - Source estimate does not match the morph operator.");
+        return MNESourceEstimate();
+    }
+
+    VectorXi vecVertices(m_matMorph.rows());
+    Index iOffset = 0;
+    for(const VectorXi& vecHemi : m_lVerticesTo)
+    {
+        vecVertices.segment(iOffset, vecHemi.size()) = vecHemi;
+        iOffset += vecHemi.size();
+    }
+
+    return MNESourceEstimate(apply(stcFrom.data), vecVertices, stcFrom.tmin, stcFrom.tstep);
+}
+
+//=============================================================================================================
+
+QList<MNESourceEstimate> MNESourceMorph::apply(const QList<MNESourceEstimate>& lStcFrom) const
+{
+    QList<MNESourceEstimate> lStcTo;
+
+    Index iNumSamples = 0;
+    for(const MNESourceEstimate& stc : lStcFrom)
+    {
+        if(isEmpty() || stc.data.rows() != m_matMorph.cols())
+        {
+            qWarning("MNESourceMorph::apply - Source estimate does not match the morph operator.");
+            return lStcTo;
+        }
+        iNumSamples += stc.data.cols();
+    }
+
+    // One product over all time series keeps the operator in cache for the whole batch
+    MatrixXd matData(m_matMorph.cols(), iNumSamples);
+    Index iOffset = 0;
+    for(const MNESourceEstimate& stc : lStcFrom)
+    {
+        matData.middleCols(iOffset, stc.data.cols()) = stc.data;
+        iOffset += stc.data.cols();
+    }
+
+    MatrixXd matResult = apply(matData);
+    matData.resize(0, 0);
+
+    VectorXi vecVertices(m_matMorph.rows());
+    iOffset = 0;
+    for(const VectorXi& vecHemi : m_lVerticesTo)
+    {
+        vecVertices.segment(iOffset, vecHemi.size()) = vecHemi;
+        iOffset += vecHemi.size();
+    }
+
+    iOffset = 0;
+    for(const MNESourceEstimate& stc : lStcFrom)
+    {
+        lStcTo.append(MNESourceEstimate(matResult.middleCols(iOffset, stc.data.cols()), vecVertices, stc.tmin, stc.tstep));
+        iOffset += stc.data.cols();
+    }
+
+    return lStcTo;
+}
+
+//=============================================================================================================
+
+MatrixXd MNESourceMorph::apply(const MatrixXd& matData) const
+{
+    MatrixXd matResult(m_matMorph.rows(), matData.cols());
+
+    const Index iNumThreads = m_bMultiThreaded ? std::max(1, QThreadPool::globalInstance()->maxThreadCount()) : 1;
+    const Index iBlock = std::max<Index>(64, (matData.cols() + iNumThreads - 1) / iNumThreads);
+
+    if(iNumThreads == 1 || matData.cols() <= iBlock)
+    {
+        applyBlock(matData, matResult, 0, matData.cols());
+        return matResult;
+    }
+
+    QVector<Index> vecStarts;
+    for(Index c = 0; c < matData.cols(); c += iBlock)
+        vecStarts.append(c);
+
+    QFuture<void> future = QtConcurrent::map(vecStarts, [&](const Index& iStart) {
+        applyBlock(matData, matResult, iStart, std::min(iBlock, matData.cols() - iStart));
+    });
+    future.waitForFinished();
+
+    return matResult;
+}
+
+//=============================================================================================================
+
+void MNESourceMorph::applyBlock(const MatrixXd& matData,
+                                MatrixXd& matResult,
+                                Index iStart,
+                                Index iCount) const
+{
+    if(m_bFloat)
+    {
+        MatrixXf matBlock = matData.middleCols(iStart, iCount).cast<float>();
+        MatrixXf matBlockResult = m_matMorphF * matBlock;
+        matResult.middleCols(iStart, iCount) = matBlockResult.cast<double>();
+    }
+    else
+    {
+        matResult.middleCols(iStart, iCount).noalias() = m_matMorph * matData.middleCols(iStart, iCount);
+    }
+}
+
+//=============================================================================================================
+
+bool MNESourceMorph::write(QIODevice& device) const
+{
+    SparseMatrix<double> matMorph = m_matMorph;
+    matMorph.makeCompressed();
+
+    QDataStream stream(&device);
+    stream << MORPH_FILE_MAGIC << MORPH_FILE_VERSION;
+    stream << static_cast<qint32>(matMorph.rows()) << static_cast<qint32>(matMorph.cols()) << static_cast<qint32>(matMorph.nonZeros());
+    stream.writeRawData(reinterpret_cast<const char*>(matMorph.outerIndexPtr()), static_cast<int>((matMorph.outerSize() + 1) * sizeof(int)));
+    stream.writeRawData(reinterpret_cast<const char*>(matMorph.innerIndexPtr()), static_cast<int>(matMorph.nonZeros() * sizeof(int)));
+    stream.writeRawData(reinterpret_cast<const char*>(matMorph.valuePtr()), static_cast<int>(matMorph.nonZeros() * sizeof(double)));
+
+    stream << static_cast<qint32>(m_lVerticesFrom.size());
+    for(const VectorXi& vec : m_lVerticesFrom)
+        writeVector(stream, vec);
+    stream << static_cast<qint32>(m_lVerticesTo.size());
+    for(const VectorXi& vec : m_lVerticesTo)
+        writeVector(stream, vec);
+
+    return stream.status() == QDataStream::Ok;
+}
+
+//=============================================================================================================
+
+bool MNESourceMorph::read(QIODevice& device,
+                          MNESourceMorph& morph)
+{
+    QDataStream stream(&device);
+
+    quint32 magic;
+    qint32 version, rows, cols, nnz;
+    stream >> magic >> version >> rows >> cols >> nnz;
+    if(stream.status() != QDataStream::Ok || magic != MORPH_FILE_MAGIC || version != MORPH_FILE_VERSION
+            || rows < 0 || cols < 0 || nnz < 0)
+        return false;
+
+    VectorXi vecOuter(cols + 1), vecInner(nnz);
+    VectorXd vecValues(nnz);
+    const int iOuterBytes = static_cast<int>(vecOuter.size() * sizeof(int));
+    const int iInnerBytes = static_cast<int>(vecInner.size() * sizeof(int));
+    const int iValueBytes = static_cast<int>(vecValues.size() * sizeof(double));
+    if(stream.readRawData(reinterpret_cast<char*>(vecOuter.data()), iOuterBytes) != iOuterBytes
+            || stream.readRawData(reinterpret_cast<char*>(vecInner.data()), iInnerBytes) != iInnerBytes
+            || stream.readRawData(reinterpret_cast<char*>(vecValues.data()), iValueBytes) != iValueBytes)
+        return false;
+
+    if(vecOuter[0] != 0 || vecOuter[cols] != nnz || (nnz > 0 && (vecInner.minCoeff() < 0 || vecInner.maxCoeff() >= rows)))
+        return false;
+
+    QList<VectorXi> lVerticesFrom, lVerticesTo;
+    for(QList<VectorXi>* pList : {&lVerticesFrom, &lVerticesTo})
+    {
+        qint32 iNum;
+        stream >> iNum;
+        if(stream.status() != QDataStream::Ok || iNum < 0)
+            return false;
+        for(qint32 i = 0; i < iNum; ++i)
+        {
+            VectorXi vec;
+            if(!readVector(stream, vec))
+                return false;
+            pList->append(vec);
+        }
+    }
+
+    SparseMatrix<double> matMorph = Map<const SparseMatrix<double> >(rows, cols, nnz, vecOuter.data(), vecInner.data(), vecValues.data());
+    morph.setOperator(matMorph, lVerticesFrom, lVerticesTo);
+
+    return true;
+}
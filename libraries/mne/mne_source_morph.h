@@ -0,0 +1,304 @@
+//=============================================================================================================
+/**
+ * @file     mne_source_morph.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    MNESourceMorph class declaration.
+ *
+ */
+
+#ifndef MNE_SOURCE_MORPH_H
+#define MNE_SOURCE_MORPH_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "mne_global.h"
+#include "mne_sourceestimate.h"
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+class QIODevice;
+
+//=============================================================================================================
+// DEFINE NAMESPACE MNELIB
+//=============================================================================================================
+
+namespace MNELIB
+{
+
+//=============================================================================================================
+/**
+ * Sparse operator which morphs source estimates from the source space of one subject to the source space of
+ * another one (usually fsaverage). The data of the source vertices is spread over the surface by iterated
+ * neighbour averaging and each destination vertex then takes the value of its nearest neighbour on the
+ * registered spheres (sphere.reg). Both steps are folded into a single sparse matrix, so a whole time series
+ * (or a batch of them) is morphed with one sparse times dense product.
+ *
+ * @brief Precomputed sparse subject to subject morph operator
+ */
+class MNESHARED_EXPORT MNESourceMorph
+{
+public:
+    typedef QSharedPointer<MNESourceMorph> SPtr;             /**< Shared pointer type for MNESourceMorph. */
+    typedef QSharedPointer<const MNESourceMorph> ConstSPtr;  /**< Const shared pointer type for MNESourceMorph. */
+
+    //=========================================================================================================
+    /**
+     * Constructs an empty morph operator.
+     */
+    MNESourceMorph();
+
+    //=========================================================================================================
+    /**
+     * Computes the morph operator from the sphere.reg surfaces of both subjects. If a cache directory is given
+     * a previously computed operator for the same subjects, vertices and smoothing steps is read from there,
+     * otherwise the new operator is stored in it.
+     *
+     * @param[in] sSubjectFrom       Name of the subject the source estimates belong to.
+     * @param[in] sSubjectTo         Name of the destination subject, e.g. fsaverage.
+     * @param[in] sSubjectsDir       FreeSurfer subjects directory.
+     * @param[in] lVerticesFrom      Source vertices of the left and right hemisphere of sSubjectFrom.
+     * @param[in] lVerticesTo        Destination vertices of the left and right hemisphere of sSubjectTo.
+     * @param[in] iSmooth            Number of smoothing steps. Negative values smooth until the whole surface
+     *                               is covered.
+     * @param[in] sCacheDir          Directory of the operator cache. Empty disables the cache.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    bool compute(const QString& sSubjectFrom,
+                 const QString& sSubjectTo,
+                 const QString& sSubjectsDir,
+                 const QList<Eigen::VectorXi>& lVerticesFrom,
+                 const QList<Eigen::VectorXi>& lVerticesTo,
+                 qint32 iSmooth = -1,
+                 const QString& sCacheDir = QString());
+
+    //=========================================================================================================
+    /**
+     * Computes the morph operator of one hemisphere from already loaded sphere.reg surfaces.
+     *
+     * @param[in] matSphereFrom      Vertex positions of the sphere.reg surface of the source subject.
+     * @param[in] matTrisFrom        Triangles of the source subject surface.
+     * @param[in] vecVerticesFrom    Source vertices.
+     * @param[in] matSphereTo        Vertex positions of the sphere.reg surface of the destination subject.
+     * @param[in] vecVerticesTo      Destination vertices.
+     * @param[in] iSmooth            Number of smoothing steps. Negative values smooth until the whole surface
+     *                               is covered.
+     *
+     * @return The morph matrix of the hemisphere, destination vertices x source vertices.
+     */
+    static Eigen::SparseMatrix<double> computeHemisphere(const Eigen::MatrixX3f& matSphereFrom,
+                                                         const Eigen::MatrixX3i& matTrisFrom,
+                                                         const Eigen::VectorXi& vecVerticesFrom,
+                                                         const Eigen::MatrixX3f& matSphereTo,
+                                                         const Eigen::VectorXi& vecVerticesTo,
+                                                         qint32 iSmooth = -1);
+
+    //=========================================================================================================
+    /**
+     * Sets the morph operator directly, e.g. after combining hemispheres computed with computeHemisphere.
+     *
+     * @param[in] matMorph           Morph matrix, destination vertices x source vertices.
+     * @param[in] lVerticesFrom      Source vertices per hemisphere, matching the columns.
+     * @param[in] lVerticesTo        Destination vertices per hemisphere, matching the rows.
+     */
+    void setOperator(const Eigen::SparseMatrix<double>& matMorph,
+                     const QList<Eigen::VectorXi>& lVerticesFrom,
+                     const QList<Eigen::VectorXi>& lVerticesTo);
+
+    //=========================================================================================================
+    /**
+     * Applies the operator in single precision. The sparse matrix and the data are streamed as float, which
+     * halves the memory traffic of large batches. The result is returned in double precision.
+     *
+     * @param[in] bFloat     Whether to use single precision.
+     */
+    void setFloatPrecision(bool bFloat);
+
+    //=========================================================================================================
+    /**
+     * Sets whether the time samples are split over the global thread pool when applying the operator.
+     *
+     * @param[in] bMultiThreaded     Whether to apply multithreaded.
+     */
+    void setMultiThreaded(bool bMultiThreaded);
+
+    //=========================================================================================================
+    /**
+     * Morphs a source estimate. The rows of the estimate have to follow the source vertices of the left and
+     * then the right hemisphere.
+     *
+     * @param[in] stcFrom    The source estimate of the source subject.
+     *
+     * @return The morphed source estimate, empty if the estimate does not match the operator.
+     */
+    MNESourceEstimate apply(const MNESourceEstimate& stcFrom) const;
+
+    //=========================================================================================================
+    /**
+     * Morphs a batch of source estimates. The time series are concatenated and morphed with one product.
+     *
+     * @param[in] lStcFrom   The source estimates of the source subject.
+     *
+     * @return The morphed source estimates, empty if one of the estimates does not match the operator.
+     */
+    QList<MNESourceEstimate> apply(const QList<MNESourceEstimate>& lStcFrom) const;
+
+    //=========================================================================================================
+    /**
+     * Morphs a data matrix, source vertices x samples.
+     *
+     * @param[in] matData    The data to morph.
+     *
+     * @return The morphed data, destination vertices x samples.
+     */
+    Eigen::MatrixXd apply(const Eigen::MatrixXd& matData) const;
+
+    //=========================================================================================================
+    /**
+     * Writes the operator to a device.
+     *
+     * @param[in] device     The device to write to.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    bool write(QIODevice& device) const;
+
+    //=========================================================================================================
+    /**
+     * Reads an operator written by write.
+     *
+     * @param[in] device     The device to read from.
+     * @param[out] morph     The read operator.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    static bool read(QIODevice& device,
+                     MNESourceMorph& morph);
+
+    //=========================================================================================================
+    /**
+     * Returns whether the operator is empty.
+     *
+     * @return true if no operator was computed or read.
+     */
+    inline bool isEmpty() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the morph matrix, destination vertices x source vertices.
+     *
+     * @return The morph matrix.
+     */
+    inline const Eigen::SparseMatrix<double>& matrix() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the destination vertices of the left and the right hemisphere.
+     *
+     * @return The destination vertices.
+     */
+    inline const QList<Eigen::VectorXi>& verticesTo() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the source vertices of the left and the right hemisphere.
+     *
+     * @return The source vertices.
+     */
+    inline const QList<Eigen::VectorXi>& verticesFrom() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Applies the operator to the columns [iStart, iStart+iCount) of matData.
+     */
+    void applyBlock(const Eigen::MatrixXd& matData,
+                    Eigen::MatrixXd& matResult,
+                    Eigen::Index iStart,
+                    Eigen::Index iCount) const;
+
+    Eigen::SparseMatrix<double> m_matMorph;     /**< Morph matrix, destination vertices x source vertices. */
+    Eigen::SparseMatrix<float> m_matMorphF;     /**< Single precision copy of m_matMorph. */
+    QList<Eigen::VectorXi> m_lVerticesFrom;     /**< Source vertices per hemisphere. */
+    QList<Eigen::VectorXi> m_lVerticesTo;       /**< Destination vertices per hemisphere. */
+    bool m_bFloat;                              /**< Whether to apply in single precision. */
+    bool m_bMultiThreaded;                      /**< Whether to split the samples over the thread pool. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline bool MNESourceMorph::isEmpty() const
+{
+    return m_matMorph.size() == 0;
+}
+
+//=============================================================================================================
+
+inline const Eigen::SparseMatrix<double>& MNESourceMorph::matrix() const
+{
+    return m_matMorph;
+}
+
+//=============================================================================================================
+
+inline const QList<Eigen::VectorXi>& MNESourceMorph::verticesTo() const
+{
+    return m_lVerticesTo;
+}
+
+//=============================================================================================================
+
+inline const QList<Eigen::VectorXi>& MNESourceMorph::verticesFrom() const
+{
+    return m_lVerticesFrom;
+}
+} // NAMESPACE
+
+#endif // MNE_SOURCE_MORPH_H
@@ -0,0 +1,307 @@
+//=============================================================================================================
+/**
+ * @file     projectionoperator.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    ProjectionOperator class definition.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "projectionoperator.h"
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDebug>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace RTPROCESSINGLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+const double SPARSE_FILL_RATIO = 0.1;   /**< Operators with a lower ratio of non zero entries are applied as sparse product. */
+
+//=============================================================================================================
+/**
+ * Returns the stage matrix if it matches the number of channels, otherwise an empty matrix.
+ */
+MatrixXd checkStage(const MatrixXd& matStage,
+                    int iNumberChannels,
+                    const char* sStage)
+{
+    if(matStage.size() != 0 && (matStage.rows() != iNumberChannels || matStage.cols() != iNumberChannels)) {
+        qWarning() << "[ProjectionOperator] Dimensions of the" << sStage << "do not match the number of channels" << iNumberChannels << ". Using identity instead.";
+        return MatrixXd();
+    }
+
+    return matStage;
+}
+
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+ProjectionOperator::ProjectionOperator(int iNumberChannels)
+: m_iNumberChannels(0)
+, m_iStages(NoStage)
+, m_bSparse(false)
+{
+    setNumberChannels(iNumberChannels);
+}
+
+//=============================================================================================================
+
+void ProjectionOperator::setNumberChannels(int iNumberChannels)
+{
+    m_iNumberChannels = std::max(0, iNumberChannels);
+
+    m_matComp.resize(0,0);
+    m_matProj.resize(0,0);
+    m_matSphara.resize(0,0);
+
+    update();
+}
+
+//=============================================================================================================
+
+void ProjectionOperator::setCompensator(const MatrixXd& matComp)
+{
+    m_matComp = checkStage(matComp, m_iNumberChannels, "compensator");
+
+    if(m_iStages & Compensator) {
+        update();
+    }
+}
+
+//=============================================================================================================
+
+void ProjectionOperator::setProjector(const MatrixXd& matProj)
+{
+    m_matProj = checkStage(matProj, m_iNumberChannels, "projector");
+
+    if(m_iStages & Projector) {
+        update();
+    }
+}
+
+//=============================================================================================================
+
+void ProjectionOperator::setSphara(const MatrixXd& matSphara)
+{
+    m_matSphara = checkStage(matSphara, m_iNumberChannels, "SPHARA operator");
+
+    if(m_iStages & Sphara) {
+        update();
+    }
+}
+
+//=============================================================================================================
+
+void ProjectionOperator::setStages(int iStages)
+{
+    if(iStages == m_iStages) {
+        return;
+    }
+
+    m_iStages = iStages;
+
+    update();
+}
+
+//=============================================================================================================
+
+void ProjectionOperator::apply(Ref<MatrixXd> matData) const
+{
+    applyInPlace<MatrixXd>(matData);
+}
+
+//=============================================================================================================
+
+void ProjectionOperator::apply(Ref<MatrixXdR> matData) const
+{
+    applyInPlace<MatrixXdR>(matData);
+}
+
+//=============================================================================================================
+
+void ProjectionOperator::apply(const Ref<const MatrixXd>& matIn,
+                               Ref<MatrixXd> matOut) const
+{
+    applyTo<MatrixXd>(matIn, matOut);
+}
+
+//=============================================================================================================
+
+void ProjectionOperator::apply(const Ref<const MatrixXd>& matIn,
+                               Ref<MatrixXdR> matOut) const
+{
+    applyTo<MatrixXdR>(matIn, matOut);
+}
+
+//=============================================================================================================
+
+void ProjectionOperator::update()
+{
+    int n = m_iNumberChannels;
+
+    // Fuse the selected stages, the compensator is applied first and SPHARA last
+    m_matOperator = MatrixXd::Identity(n, n);
+
+    if((m_iStages & Compensator) && m_matComp.size() != 0) {
+        m_matOperator = m_matComp;
+    }
+
+    if((m_iStages & Projector) && m_matProj.size() != 0) {
+        m_matOperator = m_matProj * m_matOperator;
+    }
+
+    if((m_iStages & Sphara) && m_matSphara.size() != 0) {
+        m_matOperator = m_matSphara * m_matOperator;
+    }
+
+    // Channels whose row and column equal the identity are neither changed nor needed by other channels
+    MatrixXd matDiff = m_matOperator - MatrixXd::Identity(n, n);
+    VectorXi vecChannels(n);
+    int iNumberChanged = 0;
+
+    for(int i = 0; i < n; ++i) {
+        if((matDiff.row(i).array() != 0.0).any() || (matDiff.col(i).array() != 0.0).any()) {
+            vecChannels(iNumberChanged++) = i;
+        }
+    }
+
+    m_vecChannels = vecChannels.head(iNumberChanged);
+
+    m_matDense.resize(iNumberChanged, iNumberChanged);
+
+    for(int i = 0; i < iNumberChanged; ++i) {
+        for(int j = 0; j < iNumberChanged; ++j) {
+            m_matDense(i,j) = m_matOperator(m_vecChannels(i), m_vecChannels(j));
+        }
+    }
+
+    // Dense products are much faster per entry, only use the sparse product for operators with few non zeros
+    int iNonZeros = (m_matDense.array() != 0.0).count();
+    m_bSparse = iNumberChanged > 0 && iNonZeros < SPARSE_FILL_RATIO * iNumberChanged * iNumberChanged;
+
+    if(m_bSparse) {
+        m_matSparse = m_matDense.sparseView();
+        m_matSparse.makeCompressed();
+    } else {
+        m_matSparse.resize(0,0);
+    }
+}
+
+//=============================================================================================================
+
+template<typename MatrixType>
+void ProjectionOperator::applyInPlace(Ref<MatrixType> matData) const
+{
+    if(isIdentity() || matData.cols() == 0) {
+        return;
+    }
+
+    if(matData.rows() != m_iNumberChannels) {
+        qWarning() << "[ProjectionOperator::apply] Number of rows" << matData.rows() << "does not match the number of channels" << m_iNumberChannels;
+        return;
+    }
+
+    int iNumberChanged = m_vecChannels.size();
+
+    if(iNumberChanged == m_iNumberChannels) {
+        if(m_bSparse) {
+            matData = m_matSparse * matData;
+        } else {
+            matData = m_matDense * matData;
+        }
+
+        return;
+    }
+
+    // Only multiply the changed channels, the others stay as they are
+    MatrixType matChanged(iNumberChanged, matData.cols());
+
+    for(int i = 0; i < iNumberChanged; ++i) {
+        matChanged.row(i) = matData.row(m_vecChannels(i));
+    }
+
+    if(m_bSparse) {
+        matChanged = m_matSparse * matChanged;
+    } else {
+        matChanged = m_matDense * matChanged;
+    }
+
+    for(int i = 0; i < iNumberChanged; ++i) {
+        matData.row(m_vecChannels(i)) = matChanged.row(i);
+    }
+}
+
+//=============================================================================================================
+
+template<typename MatrixType>
+void ProjectionOperator::applyTo(const Ref<const MatrixXd>& matIn,
+                                 Ref<MatrixType> matOut) const
+{
+    if(matIn.rows() != matOut.rows() || matIn.cols() != matOut.cols()) {
+        qWarning() << "[ProjectionOperator::apply] Input and output dimensions do not match.";
+        return;
+    }
+
+    // If every channel is changed, multiply directly into the output
+    if(!isIdentity() && m_vecChannels.size() == m_iNumberChannels && matIn.rows() == m_iNumberChannels) {
+        if(m_bSparse) {
+            matOut.noalias() = m_matSparse * matIn;
+        } else {
+            matOut.noalias() = m_matDense * matIn;
+        }
+
+        return;
+    }
+
+    matOut = matIn;
+    applyInPlace<MatrixType>(matOut);
+}
@@ -0,0 +1,296 @@
+//=============================================================================================================
+/**
+ * @file     projectionoperator.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    ProjectionOperator class declaration.
+ *
+ */
+
+#ifndef PROJECTIONOPERATOR_H
+#define PROJECTIONOPERATOR_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../rtprocessing_global.h"
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+
+//=============================================================================================================
+// DEFINE NAMESPACE RTPROCESSINGLIB
+//=============================================================================================================
+
+namespace RTPROCESSINGLIB
+{
+
+//=============================================================================================================
+/**
+ * The ProjectionOperator fuses the compensator, the SSP projector and the SPHARA operator into one precomputed
+ * channel x channel operator, which is applied to the data in place. Only the channels which are changed by the
+ * operator are multiplied. The operator is stored dense or sparse, depending on how many of its entries are
+ * non zero.
+ *
+ * @brief Fused compensator, SSP and SPHARA operator.
+ */
+class RTPROCESINGSHARED_EXPORT ProjectionOperator
+{
+
+public:
+    typedef QSharedPointer<ProjectionOperator> SPtr;            /**< Shared pointer type for ProjectionOperator. */
+    typedef QSharedPointer<const ProjectionOperator> ConstSPtr; /**< Const shared pointer type for ProjectionOperator. */
+
+    typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> MatrixXdR;
+
+    enum Stage {
+        NoStage = 0x0,
+        Compensator = 0x1,
+        Projector = 0x2,
+        Sphara = 0x4
+    };
+
+    //=========================================================================================================
+    /**
+     * Constructs an identity operator.
+     *
+     * @param [in] iNumberChannels   The number of channels of the data the operator is applied to.
+     */
+    explicit ProjectionOperator(int iNumberChannels = 0);
+
+    //=========================================================================================================
+    /**
+     * Sets the number of channels. All stages are reset to identity.
+     *
+     * @param [in] iNumberChannels   The number of channels of the data the operator is applied to.
+     */
+    void setNumberChannels(int iNumberChannels);
+
+    //=========================================================================================================
+    /**
+     * Sets the compensator. It is applied first.
+     *
+     * @param [in] matComp   The compensator. An empty matrix resets the stage to identity.
+     */
+    void setCompensator(const Eigen::MatrixXd& matComp);
+
+    //=========================================================================================================
+    /**
+     * Sets the SSP projector. It is applied after the compensator.
+     *
+     * @param [in] matProj   The projector. An empty matrix resets the stage to identity.
+     */
+    void setProjector(const Eigen::MatrixXd& matProj);
+
+    //=========================================================================================================
+    /**
+     * Sets the SPHARA operator. It is applied last.
+     *
+     * @param [in] matSphara     The SPHARA operator. An empty matrix resets the stage to identity.
+     */
+    void setSphara(const Eigen::MatrixXd& matSphara);
+
+    //=========================================================================================================
+    /**
+     * Selects the stages which are part of the fused operator. The fused operator is only recomputed if the
+     * selection changed.
+     *
+     * @param [in] iStages   Combination of Stage flags.
+     */
+    void setStages(int iStages);
+
+    //=========================================================================================================
+    /**
+     * Returns the selected stages.
+     *
+     * @return Combination of Stage flags.
+     */
+    inline int getStages() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of channels.
+     *
+     * @return The number of channels.
+     */
+    inline int getNumberChannels() const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether applying the operator leaves the data unchanged.
+     *
+     * @return Returns true if the fused operator is the identity.
+     */
+    inline bool isIdentity() const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether the operator is applied as sparse product.
+     *
+     * @return Returns true if the sparse product is used.
+     */
+    inline bool isSparse() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the fused operator.
+     *
+     * @return The fused channel x channel operator.
+     */
+    inline const Eigen::MatrixXd& getOperator() const;
+
+    //=========================================================================================================
+    /**
+     * Applies the operator in place to column major data (channels x samples).
+     *
+     * @param [in, out] matData  The data.
+     */
+    void apply(Eigen::Ref<Eigen::MatrixXd> matData) const;
+
+    //=========================================================================================================
+    /**
+     * Applies the operator in place to row major data (channels x samples).
+     *
+     * @param [in, out] matData  The data.
+     */
+    void apply(Eigen::Ref<MatrixXdR> matData) const;
+
+    //=========================================================================================================
+    /**
+     * Applies the operator to matIn and writes the result to matOut, which must have the same size and must not
+     * overlap matIn.
+     *
+     * @param [in] matIn         The data (channels x samples).
+     * @param [out] matOut       The projected data.
+     */
+    void apply(const Eigen::Ref<const Eigen::MatrixXd>& matIn,
+               Eigen::Ref<Eigen::MatrixXd> matOut) const;
+
+    //=========================================================================================================
+    /**
+     * Applies the operator to matIn and writes the result to row major matOut, which must have the same size
+     * and must not overlap matIn.
+     *
+     * @param [in] matIn         The data (channels x samples).
+     * @param [out] matOut       The projected data.
+     */
+    void apply(const Eigen::Ref<const Eigen::MatrixXd>& matIn,
+               Eigen::Ref<MatrixXdR> matOut) const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Recomputes the fused operator from the selected stages.
+     */
+    void update();
+
+    //=========================================================================================================
+    /**
+     * Multiplies the changed channels of matData in place.
+     *
+     * @param [in, out] matData  The data.
+     */
+    template<typename MatrixType>
+    void applyInPlace(Eigen::Ref<MatrixType> matData) const;
+
+    //=========================================================================================================
+    /**
+     * Applies the operator to matIn and writes the result to matOut.
+     *
+     * @param [in] matIn         The data.
+     * @param [out] matOut       The projected data.
+     */
+    template<typename MatrixType>
+    void applyTo(const Eigen::Ref<const Eigen::MatrixXd>& matIn,
+                 Eigen::Ref<MatrixType> matOut) const;
+
+    int                                         m_iNumberChannels;  /**< The number of channels. */
+    int                                         m_iStages;          /**< The selected stages. */
+    bool                                        m_bSparse;          /**< Whether the sparse product is used. */
+
+    Eigen::MatrixXd                             m_matComp;          /**< The compensator, empty for identity. */
+    Eigen::MatrixXd                             m_matProj;          /**< The SSP projector, empty for identity. */
+    Eigen::MatrixXd                             m_matSphara;        /**< The SPHARA operator, empty for identity. */
+
+    Eigen::MatrixXd                             m_matOperator;      /**< The fused operator. */
+    Eigen::VectorXi                             m_vecChannels;      /**< The channels changed by the fused operator. */
+    Eigen::MatrixXd                             m_matDense;         /**< The fused operator restricted to m_vecChannels. */
+    Eigen::SparseMatrix<double,Eigen::RowMajor> m_matSparse;        /**< Sparse version of m_matDense. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline int ProjectionOperator::getStages() const
+{
+    return m_iStages;
+}
+
+//=============================================================================================================
+
+inline int ProjectionOperator::getNumberChannels() const
+{
+    return m_iNumberChannels;
+}
+
+//=============================================================================================================
+
+inline bool ProjectionOperator::isIdentity() const
+{
+    return m_vecChannels.size() == 0;
+}
+
+//=============================================================================================================
+
+inline bool ProjectionOperator::isSparse() const
+{
+    return m_bSparse;
+}
+
+//=============================================================================================================
+
+inline const Eigen::MatrixXd& ProjectionOperator::getOperator() const
+{
+    return m_matOperator;
+}
+
+} // NAMESPACE RTPROCESSINGLIB
+
+#endif // PROJECTIONOPERATOR_H
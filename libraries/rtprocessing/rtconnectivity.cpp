@@ -41,6 +41,7 @@
 #include <connectivity/connectivitysettings.h>
 #include <connectivity/connectivity.h>
 #include <connectivity/network/network.h>
+#include <connectivity/metrics/abstractmetric.h>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -60,10 +61,40 @@
 using namespace RTPROCESSINGLIB;
 using namespace CONNECTIVITYLIB;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+/**
+ * Returns whether the trial stores intermediate data, i.e. whether it was added to the running sums.
+ */
+bool hasIntermediateData(const ConnectivitySettings::IntermediateTrialData& trialData)
+{
+    return trialData.matPsd.size() != 0 ||
+           !trialData.vecPairCsd.isEmpty() ||
+           !trialData.vecPairCsdNormalized.isEmpty() ||
+           !trialData.vecPairCsdImagSign.isEmpty() ||
+           !trialData.vecPairCsdImagAbs.isEmpty() ||
+           !trialData.vecPairCsdImagSqrd.isEmpty();
+}
+
+} // namespace
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS RtConnectivityWorker
 //=============================================================================================================
 
+RtConnectivityWorker::RtConnectivityWorker(QAtomicInt* pPendingBlocks)
+: m_iStreamSkip(0)
+, m_bEstimationPending(false)
+, m_pPendingBlocks(pPendingBlocks)
+{
+}
+
+//=============================================================================================================
+
 void RtConnectivityWorker::doWork(const ConnectivitySettings &connectivitySettings)
 {
     if(this->thread()->isInterruptionRequested()) {
@@ -99,25 +130,166 @@ void RtConnectivityWorker::doWork(const ConnectivitySettings &connectivitySettin
 }
 
 //=============================================================================================================
-// DEFINE MEMBER METHODS RtConnectivity
+
+void RtConnectivityWorker::doWorkIncremental(const ConnectivitySettings& connectivitySettings,
+                                             const Eigen::MatrixXd& matData,
+                                             int iNumberTrials,
+                                             int iSegmentLength,
+                                             int iHopSize)
+{
+    bool bBlocksPending = false;
+    if(m_pPendingBlocks) {
+        bBlocksPending = m_pPendingBlocks->fetchAndAddOrdered(-1) > 1;
+    }
+
+    if(this->thread()->isInterruptionRequested()) {
+        return;
+    }
+
+    // Restart the window if the parameters the stored spectra depend on have changed
+    if(m_connectivitySettings.getSamplingFrequency() != connectivitySettings.getSamplingFrequency() ||
+       m_connectivitySettings.getFFTSize() != connectivitySettings.getFFTSize() ||
+       m_connectivitySettings.getWindowType() != connectivitySettings.getWindowType() ||
+       m_connectivitySettings.getNodePositions().rows() != connectivitySettings.getNodePositions().rows()) {
+        reset();
+        m_connectivitySettings = connectivitySettings;
+        m_connectivitySettings.clearAllData();
+    }
+
+    if(m_connectivitySettings.getConnectivityMethods() != connectivitySettings.getConnectivityMethods()) {
+        m_connectivitySettings.setConnectivityMethods(connectivitySettings.getConnectivityMethods());
+        m_bEstimationPending = true;
+    }
+
+    m_connectivitySettings.setNodePositions(connectivitySettings.getNodePositions());
+
+    // Collect the new trials
+    QList<Eigen::MatrixXd> lNewTrials;
+
+    if(matData.size() != 0) {
+        // All trials need to have the same dimensions since they share the tapers and sums
+        int iTrialLength = iSegmentLength > 0 ? iSegmentLength : matData.cols();
+
+        if(!m_connectivitySettings.isEmpty() &&
+           (m_connectivitySettings.at(0).matData.rows() != matData.rows() || m_connectivitySettings.at(0).matData.cols() != iTrialLength)) {
+            reset();
+        }
+
+        if(iSegmentLength > 0) {
+            lNewTrials = segmentStream(matData, iSegmentLength, iHopSize);
+        } else {
+            lNewTrials.append(matData);
+        }
+    }
+
+    for(int i = 0; i < lNewTrials.size(); ++i) {
+        m_connectivitySettings.append(lNewTrials.at(i));
+        m_bEstimationPending = true;
+    }
+
+    // Evict the oldest trials. Only trials which took part in an estimation were added to the running sums and
+    // need to be subtracted, trials which were skipped while blocks were queued are dropped directly.
+    while(m_connectivitySettings.size() > qMax(iNumberTrials, 1)) {
+        if(hasIntermediateData(m_connectivitySettings.at(0))) {
+            m_connectivitySettings.removeFirst();
+        } else {
+            m_connectivitySettings.getTrialData().removeFirst();
+        }
+
+        m_bEstimationPending = true;
+    }
+
+    // Skip the estimation while further blocks are queued, the last of them triggers it
+    if(bBlocksPending || !m_bEstimationPending) {
+        return;
+    }
+
+    if(m_connectivitySettings.isEmpty() || m_connectivitySettings.getConnectivityMethods().isEmpty()) {
+        return;
+    }
+
+    // Without stored per trial data the contributions of evicted trials cannot be subtracted, rebuild the sums instead
+    if(!AbstractMetric::m_bStorageModeIsActive) {
+        m_connectivitySettings.clearIntermediateData();
+    }
+
+    QList<Network> finalNetworks = Connectivity::calculate(m_connectivitySettings);
+    m_bEstimationPending = false;
+
+    // Only hand back the parameters, the window stays with the worker
+    ConnectivitySettings connectivitySettingsOut = m_connectivitySettings;
+    connectivitySettingsOut.clearAllData();
+
+    emit resultReady(finalNetworks, connectivitySettingsOut);
+}
+
 //=============================================================================================================
 
-RtConnectivity::RtConnectivity(QObject *parent)
-: QObject(parent)
+void RtConnectivityWorker::reset()
 {
-    RtConnectivityWorker *worker = new RtConnectivityWorker;
-    worker->moveToThread(&m_workerThread);
+    m_connectivitySettings.clearAllData();
+    m_matStreamBuffer.resize(0,0);
+    m_iStreamSkip = 0;
+    m_bEstimationPending = false;
+}
 
-    connect(&m_workerThread, &QThread::finished,
-            worker, &QObject::deleteLater);
+//=============================================================================================================
 
-    connect(this, &RtConnectivity::operate,
-            worker, &RtConnectivityWorker::doWork);
+QList<Eigen::MatrixXd> RtConnectivityWorker::segmentStream(const Eigen::MatrixXd& matData,
+                                                         int iSegmentLength,
+                                                         int iHopSize)
+{
+    QList<Eigen::MatrixXd> lSegments;
 
-    connect(worker, &RtConnectivityWorker::resultReady,
-            this, &RtConnectivity::newConnectivityResultAvailable);
+    if(iHopSize <= 0) {
+        iHopSize = iSegmentLength;
+    }
 
-    m_workerThread.start();
+    if(m_matStreamBuffer.rows() != matData.rows()) {
+        m_matStreamBuffer.resize(matData.rows(), 0);
+        m_iStreamSkip = 0;
+    }
+
+    // Skip the samples between two segments if the hop is larger than the segment length
+    int iSkip = qMin(m_iStreamSkip, int(matData.cols()));
+    m_iStreamSkip -= iSkip;
+
+    int iOldCols = m_matStreamBuffer.cols();
+    m_matStreamBuffer.conservativeResize(Eigen::NoChange, iOldCols + matData.cols() - iSkip);
+    m_matStreamBuffer.rightCols(matData.cols() - iSkip) = matData.rightCols(matData.cols() - iSkip);
+
+    int iStart = 0;
+
+    while(m_matStreamBuffer.cols() - iStart >= iSegmentLength) {
+        lSegments.append(m_matStreamBuffer.middleCols(iStart, iSegmentLength));
+        iStart += iHopSize;
+    }
+
+    if(iStart >= m_matStreamBuffer.cols()) {
+        m_iStreamSkip += iStart - m_matStreamBuffer.cols();
+        m_matStreamBuffer.resize(matData.rows(), 0);
+    } else if(iStart > 0) {
+        Eigen::MatrixXd matRemaining = m_matStreamBuffer.rightCols(m_matStreamBuffer.cols() - iStart);
+        m_matStreamBuffer.swap(matRemaining);
+    }
+
+    return lSegments;
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS RtConnectivity
+//=============================================================================================================
+
+RtConnectivity::RtConnectivity(QObject *parent)
+: QObject(parent)
+, m_iPendingBlocks(0)
+, m_iNumberTrials(10)
+, m_iSegmentLength(0)
+, m_iHopSize(0)
+{
+    qRegisterMetaType<Eigen::MatrixXd>("Eigen::MatrixXd");
+
+    createWorker();
 }
 
 //=============================================================================================================
@@ -136,11 +308,62 @@ void RtConnectivity::append(const ConnectivitySettings& connectivitySettings)
 
 //=============================================================================================================
 
+void RtConnectivity::append(const ConnectivitySettings& connectivitySettings,
+                            const Eigen::MatrixXd& matData)
+{
+    m_iPendingBlocks.ref();
+
+    emit operateIncremental(connectivitySettings,
+                            matData,
+                            m_iNumberTrials,
+                            m_iSegmentLength,
+                            m_iHopSize);
+}
+
+//=============================================================================================================
+
+void RtConnectivity::setSlidingWindow(int iNumberTrials,
+                                      int iSegmentLength,
+                                      int iHopSize)
+{
+    m_iNumberTrials = iNumberTrials;
+    m_iSegmentLength = iSegmentLength;
+    m_iHopSize = iHopSize;
+}
+
+//=============================================================================================================
+
+void RtConnectivity::reset()
+{
+    emit resetRequested();
+}
+
+//=============================================================================================================
+
 void RtConnectivity::restart()
 {
     stop();
 
-    RtConnectivityWorker *worker = new RtConnectivityWorker;
+    createWorker();
+}
+
+//=============================================================================================================
+
+void RtConnectivity::stop()
+{
+    m_workerThread.requestInterruption();
+    m_workerThread.quit();
+    m_workerThread.wait();
+
+    // Blocks which were queued for the stopped worker are dropped
+    m_iPendingBlocks.store(0);
+}
+
+//=============================================================================================================
+
+void RtConnectivity::createWorker()
+{
+    RtConnectivityWorker *worker = new RtConnectivityWorker(&m_iPendingBlocks);
     worker->moveToThread(&m_workerThread);
 
     connect(&m_workerThread, &QThread::finished,
@@ -149,17 +372,14 @@ void RtConnectivity::restart()
     connect(this, &RtConnectivity::operate,
             worker, &RtConnectivityWorker::doWork);
 
+    connect(this, &RtConnectivity::operateIncremental,
+            worker, &RtConnectivityWorker::doWorkIncremental);
+
+    connect(this, &RtConnectivity::resetRequested,
+            worker, &RtConnectivityWorker::reset);
+
     connect(worker, &RtConnectivityWorker::resultReady,
             this, &RtConnectivity::newConnectivityResultAvailable);
 
     m_workerThread.start();
 }
-
-//=============================================================================================================
-
-void RtConnectivity::stop()
-{
-    m_workerThread.requestInterruption();
-    m_workerThread.quit();
-    m_workerThread.wait();
-}
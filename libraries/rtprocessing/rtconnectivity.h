@@ -41,16 +41,21 @@
 
 #include "rtprocessing_global.h"
 
+#include <connectivity/connectivitysettings.h>
+
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
 
+#include <Eigen/Core>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QObject>
 #include <QThread>
+#include <QAtomicInt>
 
 //=============================================================================================================
 // FORWARD DECLARATIONS
@@ -61,7 +66,6 @@ namespace FIFFLIB {
 }
 
 namespace CONNECTIVITYLIB {
-    class ConnectivitySettings;
     class Network;
 }
 
@@ -78,7 +82,9 @@ namespace RTPROCESSINGLIB
 
 //=============================================================================================================
 /**
- * Real-time connectivity worker.
+ * Real-time connectivity worker. Besides computing a connectivity settings object as a whole, the worker keeps a
+ * sliding window of trials between calls, so that only the spectra of new trials are computed and the contributions
+ * of evicted trials are subtracted from the running sums.
  *
  * @brief Real-time connectivity worker.
  */
@@ -87,6 +93,14 @@ class RTPROCESINGSHARED_EXPORT RtConnectivityWorker : public QObject
     Q_OBJECT
 
 public:
+    //=========================================================================================================
+    /**
+     * Creates the real-time connectivity worker.
+     *
+     * @param[in] pPendingBlocks     Counter of the data blocks which were queued but not yet processed (optional).
+     */
+    explicit RtConnectivityWorker(QAtomicInt* pPendingBlocks = Q_NULLPTR);
+
     //=========================================================================================================
     /**
      * Perform actual connectivity estimation.
@@ -95,6 +109,50 @@ public:
      */
     void doWork(const CONNECTIVITYLIB::ConnectivitySettings& connectivitySettings);
 
+    //=========================================================================================================
+    /**
+     * Adds new data to the sliding window and updates the connectivity estimation incrementally. The trial data of
+     * connectivitySettings is ignored, only its parameters are used. Changing the spectral parameters restarts the window.
+     *
+     * @param[in] connectivitySettings   The connectivity settings (methods, sampling frequency, FFT size, window type, node positions).
+     * @param[in] matData                The new data block (rows: nodes, cols: samples). May be empty to only recompute.
+     * @param[in] iNumberTrials          The number of trials in the sliding window.
+     * @param[in] iSegmentLength         The segment length in samples if matData is part of a continuous stream. 0 treats every block as one trial.
+     * @param[in] iHopSize               The number of samples between the starts of two consecutive segments. 0 uses iSegmentLength.
+     */
+    void doWorkIncremental(const CONNECTIVITYLIB::ConnectivitySettings& connectivitySettings,
+                           const Eigen::MatrixXd& matData,
+                           int iNumberTrials,
+                           int iSegmentLength,
+                           int iHopSize);
+
+    //=========================================================================================================
+    /**
+     * Clears the sliding window and the buffered stream data.
+     */
+    void reset();
+
+protected:
+    //=========================================================================================================
+    /**
+     * Cuts the segments which became complete with the new data out of the buffered stream.
+     *
+     * @param[in] matData            The new data block.
+     * @param[in] iSegmentLength     The segment length in samples.
+     * @param[in] iHopSize           The hop size in samples.
+     *
+     * @return The new segments.
+     */
+    QList<Eigen::MatrixXd> segmentStream(const Eigen::MatrixXd& matData,
+                                         int iSegmentLength,
+                                         int iHopSize);
+
+    CONNECTIVITYLIB::ConnectivitySettings   m_connectivitySettings;     /**< The sliding window with the stored per trial spectra and the running sums. */
+    Eigen::MatrixXd                         m_matStreamBuffer;          /**< The stream samples which were not yet cut into segments. */
+    int                                     m_iStreamSkip;              /**< The number of upcoming stream samples to skip if the hop is larger than the segment length. */
+    bool                                    m_bEstimationPending;       /**< Whether the window changed since the last estimation. */
+    QAtomicInt*                             m_pPendingBlocks;           /**< Counter of the queued data blocks, used to skip estimations while blocks are waiting. */
+
 signals:
     void resultReady(const  QList<CONNECTIVITYLIB::Network>& connectivityResults, const CONNECTIVITYLIB::ConnectivitySettings& connectivitySettings);
 };
@@ -135,6 +193,40 @@ public:
      */
     void append(const CONNECTIVITYLIB::ConnectivitySettings& connectivitySettings);
 
+    //=========================================================================================================
+    /**
+     * Appends a new data block to the sliding window of the worker. Only the new trials are transformed and the
+     * running sums are updated incrementally. The trial data of connectivitySettings is ignored. If the worker falls
+     * behind, queued blocks are collected and estimated together.
+     *
+     * @param[in] connectivitySettings   The connectivity settings holding the estimation parameters.
+     * @param[in] matData                The new data block (rows: nodes, cols: samples). May be empty to only recompute.
+     */
+    void append(const CONNECTIVITYLIB::ConnectivitySettings& connectivitySettings,
+                const Eigen::MatrixXd& matData);
+
+    //=========================================================================================================
+    /**
+     * Sets the sliding window used by append(connectivitySettings, matData). With a segment length the appended blocks
+     * are treated as a continuous stream which is cut into segments every iHopSize samples, so that overlapping windows
+     * share the spectra of their common segments. E.g. a 1 s window updated every 100 ms at 1 kHz: iNumberTrials = 10,
+     * iSegmentLength = 100, iHopSize = 100.
+     *
+     * @param[in] iNumberTrials      The number of trials (segments) in the window.
+     * @param[in] iSegmentLength     The segment length in samples. 0 treats every appended block as one trial. Default is 0.
+     * @param[in] iHopSize           The number of samples between two segments. 0 uses iSegmentLength. Default is 0.
+     */
+    void setSlidingWindow(int iNumberTrials,
+                          int iSegmentLength = 0,
+                          int iHopSize = 0);
+
+    //=========================================================================================================
+    /**
+     * Clears the sliding window of the worker. Needs to be called when data from a different source or channel
+     * selection is appended next.
+     */
+    void reset();
+
     //=========================================================================================================
     /**
      * Restarts the thread by interrupting its computation queue, quitting, waiting and then starting it again.
@@ -148,12 +240,31 @@ public:
     void stop();
 
 protected:
+    //=========================================================================================================
+    /**
+     * Creates a new worker, moves it to the worker thread and connects it.
+     */
+    void createWorker();
+
     QThread             m_workerThread;         /**< The worker thread. */
+    QAtomicInt          m_iPendingBlocks;       /**< The number of data blocks queued for the worker. */
+
+    int                 m_iNumberTrials;        /**< The number of trials in the sliding window. */
+    int                 m_iSegmentLength;       /**< The segment length in samples. 0 treats every block as one trial. */
+    int                 m_iHopSize;             /**< The hop size in samples. */
 
 signals:
     void newConnectivityResultAvailable(const QList<CONNECTIVITYLIB::Network>& connectivityResults, const CONNECTIVITYLIB::ConnectivitySettings& connectivitySettings);
 
     void operate(const CONNECTIVITYLIB::ConnectivitySettings& connectivitySettings);
+
+    void operateIncremental(const CONNECTIVITYLIB::ConnectivitySettings& connectivitySettings,
+                            const Eigen::MatrixXd& matData,
+                            int iNumberTrials,
+                            int iSegmentLength,
+                            int iHopSize);
+
+    void resetRequested();
 };
 
 //=============================================================================================================
@@ -161,4 +272,9 @@ signals:
 //=============================================================================================================
 } // NAMESPACE
 
+#ifndef metatype_matrix
+#define metatype_matrix
+Q_DECLARE_METATYPE(Eigen::MatrixXd); /**< Provides QT META type declaration of the Eigen::MatrixXd type. For signal/slot usage.*/
+#endif
+
 #endif // RTCONNECTIVITY_RTPROCESSING_H
@@ -94,6 +94,7 @@ SOURCES += \
     helpers/parksmcclellan.cpp \
     helpers/filterkernel.cpp \
     helpers/filterio.cpp \
+    helpers/projectionoperator.cpp \
 
 HEADERS +=  \
     icp.h \
@@ -112,6 +113,7 @@ HEADERS +=  \
     helpers/parksmcclellan.h \
     helpers/filterkernel.h \
     helpers/filterio.h \
+    helpers/projectionoperator.h \
 
 INCLUDEPATH += $${EIGEN_INCLUDE_DIR}
 INCLUDEPATH += $${MNE_INCLUDE_DIR}
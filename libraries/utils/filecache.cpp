@@ -0,0 +1,240 @@
+//=============================================================================================================
+/**
+ * @file     filecache.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FileCache class definition.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "filecache.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QDebug>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FileCacheKey::FileCacheKey(const QString& sName)
+: m_hash(QCryptographicHash::Sha1)
+{
+    m_hash.addData(sName.toUtf8());
+}
+
+//=============================================================================================================
+
+FileCacheKey& FileCacheKey::add(const char* data,
+                                int iLength)
+{
+    // Prefix every item with its length, so that different splits of the same bytes give different keys
+    m_hash.addData(reinterpret_cast<const char*>(&iLength), sizeof(iLength));
+    m_hash.addData(data, iLength);
+
+    return *this;
+}
+
+//=============================================================================================================
+
+FileCacheKey& FileCacheKey::add(const QString& sValue)
+{
+    QByteArray baValue = sValue.toUtf8();
+
+    return add(baValue.constData(), baValue.size());
+}
+
+//=============================================================================================================
+
+QString FileCacheKey::result() const
+{
+    return QString::fromLatin1(m_hash.result().toHex());
+}
+
+//=============================================================================================================
+
+FileCache::FileCache(const QString& sDirectory,
+                     const QString& sSuffix,
+                     qint64 iMaxBytes)
+: m_sDirectory(sDirectory)
+, m_sSuffix(sSuffix)
+, m_iMaxBytes(iMaxBytes)
+{
+}
+
+//=============================================================================================================
+
+QString FileCache::defaultDirectory(const QString& sName)
+{
+    QString sCacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+
+    if(sCacheLocation.isEmpty()) {
+        return QString();
+    }
+
+    return sCacheLocation + "/" + sName;
+}
+
+//=============================================================================================================
+
+bool FileCache::isEnabled() const
+{
+    return !m_sDirectory.isEmpty();
+}
+
+//=============================================================================================================
+
+QString FileCache::getDirectory() const
+{
+    return m_sDirectory;
+}
+
+//=============================================================================================================
+
+void FileCache::setDirectory(const QString& sDirectory)
+{
+    m_sDirectory = sDirectory;
+}
+
+//=============================================================================================================
+
+void FileCache::setMaxBytes(qint64 iMaxBytes)
+{
+    m_iMaxBytes = iMaxBytes;
+}
+
+//=============================================================================================================
+
+QString FileCache::getFileName(const QString& sKey) const
+{
+    if(!isEnabled() || sKey.isEmpty()) {
+        return QString();
+    }
+
+    return QString("%1/%2.%3").arg(m_sDirectory).arg(sKey).arg(m_sSuffix);
+}
+
+//=============================================================================================================
+
+bool FileCache::read(const QString& sKey,
+                     QByteArray& data) const
+{
+    QFile file(getFileName(sKey));
+
+    if(!isEnabled() || !file.exists()) {
+        return false;
+    }
+
+    // The modification time orders the entries for the eviction. A read-only cache is still read.
+    if(file.open(QIODevice::ReadWrite)) {
+        file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    } else if(!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    data = file.readAll();
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool FileCache::write(const QString& sKey,
+                      const QByteArray& data) const
+{
+    QString sFileName = getFileName(sKey);
+
+    if(sFileName.isEmpty()) {
+        return false;
+    }
+
+    QDir().mkpath(m_sDirectory);
+
+    // QSaveFile writes to a temporary file and renames it on commit, so concurrent runs never see a partial entry
+    QSaveFile file(sFileName);
+
+    if(!file.open(QIODevice::WriteOnly)
+       || file.write(data) != data.size()
+       || !file.commit()) {
+        qWarning() << "[FileCache::write] Could not write cache file" << sFileName;
+        return false;
+    }
+
+    evict(sFileName);
+
+    return true;
+}
+
+//=============================================================================================================
+
+void FileCache::evict(const QString& sKeep) const
+{
+    if(!isEnabled()) {
+        return;
+    }
+
+    // Newest first, everything behind the size bound is removed
+    QFileInfoList lFiles = QDir(m_sDirectory).entryInfoList(QStringList() << "*." + m_sSuffix,
+                                                            QDir::Files,
+                                                            QDir::Time);
+    QString sKeepPath = QFileInfo(sKeep).absoluteFilePath();
+    qint64 iBytes = 0;
+    bool bFull = false;
+
+    for(const QFileInfo& fileInfo : lFiles) {
+        if(!sKeep.isEmpty() && fileInfo.absoluteFilePath() == sKeepPath) {
+            iBytes += fileInfo.size();
+            continue;
+        }
+
+        if(bFull || iBytes + fileInfo.size() > m_iMaxBytes) {
+            QFile::remove(fileInfo.absoluteFilePath());
+            bFull = true;
+        } else {
+            iBytes += fileInfo.size();
+        }
+    }
+}
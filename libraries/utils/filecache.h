@@ -0,0 +1,299 @@
+//=============================================================================================================
+/**
+ * @file     filecache.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FileCache class declaration.
+ *
+ */
+
+#ifndef FILECACHE_H
+#define FILECACHE_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "utils_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QCryptographicHash>
+#include <QString>
+#include <QByteArray>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE UTILSLIB
+//=============================================================================================================
+
+namespace UTILSLIB
+{
+
+//=============================================================================================================
+/**
+ * Builds the SHA1 key of a FileCache entry from everything the cached result depends on.
+ *
+ * @brief Key of a FileCache entry
+ */
+class UTILSSHARED_EXPORT FileCacheKey
+{
+public:
+    //=========================================================================================================
+    /**
+     * Constructs a key.
+     *
+     * @param[in] sName      Name and version of the cached data, e.g. "MNESourceMorph v1". Changing it invalidates
+     *                       all entries of the old format.
+     */
+    explicit FileCacheKey(const QString& sName);
+
+    //=========================================================================================================
+    /**
+     * Adds raw bytes to the key.
+     *
+     * @param[in] data       The bytes.
+     * @param[in] iLength    The number of bytes.
+     *
+     * @return This key.
+     */
+    FileCacheKey& add(const char* data,
+                      int iLength);
+
+    //=========================================================================================================
+    /**
+     * Adds a string to the key.
+     *
+     * @param[in] sValue     The string.
+     *
+     * @return This key.
+     */
+    FileCacheKey& add(const QString& sValue);
+
+    //=========================================================================================================
+    /**
+     * Adds a plain value (integer, floating point or a POD struct) to the key.
+     *
+     * @param[in] value      The value.
+     *
+     * @return This key.
+     */
+    template<typename T>
+    FileCacheKey& addValue(const T& value);
+
+    //=========================================================================================================
+    /**
+     * Adds the dimensions and the coefficients of a dense Eigen matrix or vector to the key.
+     *
+     * @param[in] mat        The matrix.
+     *
+     * @return This key.
+     */
+    template<typename Derived>
+    FileCacheKey& addMatrix(const Eigen::PlainObjectBase<Derived>& mat);
+
+    //=========================================================================================================
+    /**
+     * Adds the size and the elements of a contiguous container (QVector, std::vector) to the key.
+     *
+     * @param[in] vec        The container.
+     *
+     * @return This key.
+     */
+    template<typename Container>
+    FileCacheKey& addVector(const Container& vec);
+
+    //=========================================================================================================
+    /**
+     * Returns the key.
+     *
+     * @return The hex encoded SHA1 of everything added so far.
+     */
+    QString result() const;
+
+private:
+    QCryptographicHash  m_hash;         /**< The hash of everything added so far. */
+};
+
+//=============================================================================================================
+/**
+ * A size bounded directory of cached results. Entries are named by a FileCacheKey and written atomically, so
+ * concurrent runs never see a partial file. After each write the least recently used entries are removed until
+ * the directory fits the size bound again.
+ *
+ * @brief Size bounded on-disk cache
+ */
+class UTILSSHARED_EXPORT FileCache
+{
+public:
+    typedef QSharedPointer<FileCache> SPtr;            /**< Shared pointer type for FileCache. */
+    typedef QSharedPointer<const FileCache> ConstSPtr; /**< Const shared pointer type for FileCache. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a FileCache.
+     *
+     * @param[in] sDirectory     The cache directory. An empty directory disables the cache.
+     * @param[in] sSuffix        The suffix of the cache files. Only files with this suffix are evicted.
+     * @param[in] iMaxBytes      The maximum size of all cache files with this suffix in the directory.
+     */
+    explicit FileCache(const QString& sDirectory = QString(),
+                       const QString& sSuffix = QString("cache"),
+                       qint64 iMaxBytes = 256*1024*1024);
+
+    //=========================================================================================================
+    /**
+     * Returns the default directory of a cache, a subdirectory of the writable cache location of the application.
+     *
+     * @param[in] sName      The name of the subdirectory.
+     *
+     * @return The directory, empty if there is no writable cache location.
+     */
+    static QString defaultDirectory(const QString& sName);
+
+    //=========================================================================================================
+    /**
+     * Returns whether the cache is enabled, i.e. a directory is set.
+     *
+     * @return true if the cache is enabled.
+     */
+    bool isEnabled() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the cache directory.
+     *
+     * @return The cache directory, empty if the cache is disabled.
+     */
+    QString getDirectory() const;
+
+    //=========================================================================================================
+    /**
+     * Sets the cache directory.
+     *
+     * @param[in] sDirectory     The cache directory. An empty directory disables the cache.
+     */
+    void setDirectory(const QString& sDirectory);
+
+    //=========================================================================================================
+    /**
+     * Sets the maximum size of all cache files in the directory.
+     *
+     * @param[in] iMaxBytes      The maximum size in bytes.
+     */
+    void setMaxBytes(qint64 iMaxBytes);
+
+    //=========================================================================================================
+    /**
+     * Returns the file name of an entry.
+     *
+     * @param[in] sKey       The key of the entry, see FileCacheKey.
+     *
+     * @return The file name, empty if the cache is disabled.
+     */
+    QString getFileName(const QString& sKey) const;
+
+    //=========================================================================================================
+    /**
+     * Reads an entry and marks it as recently used.
+     *
+     * @param[in] sKey       The key of the entry.
+     * @param[out] data      The content of the entry.
+     *
+     * @return true if the entry exists and was read.
+     */
+    bool read(const QString& sKey,
+              QByteArray& data) const;
+
+    //=========================================================================================================
+    /**
+     * Writes an entry atomically and evicts the least recently used entries which exceed the size bound.
+     *
+     * @param[in] sKey       The key of the entry.
+     * @param[in] data       The content of the entry.
+     *
+     * @return true if the entry was written.
+     */
+    bool write(const QString& sKey,
+               const QByteArray& data) const;
+
+    //=========================================================================================================
+    /**
+     * Removes the least recently used cache files until all files with the cache suffix fit the size bound.
+     *
+     * @param[in] sKeep      File name which is never removed, e.g. the entry which was just written.
+     */
+    void evict(const QString& sKeep = QString()) const;
+
+private:
+    QString     m_sDirectory;       /**< The cache directory, empty if the cache is disabled. */
+    QString     m_sSuffix;          /**< The suffix of the cache files. */
+    qint64      m_iMaxBytes;        /**< The maximum size of all cache files with m_sSuffix. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+template<typename T>
+inline FileCacheKey& FileCacheKey::addValue(const T& value)
+{
+    return add(reinterpret_cast<const char*>(&value), static_cast<int>(sizeof(T)));
+}
+
+//=============================================================================================================
+
+template<typename Derived>
+inline FileCacheKey& FileCacheKey::addMatrix(const Eigen::PlainObjectBase<Derived>& mat)
+{
+    qint64 dims[2] = {static_cast<qint64>(mat.rows()), static_cast<qint64>(mat.cols())};
+    add(reinterpret_cast<const char*>(dims), static_cast<int>(sizeof(dims)));
+    return add(reinterpret_cast<const char*>(mat.data()), static_cast<int>(mat.size() * sizeof(typename Derived::Scalar)));
+}
+
+//=============================================================================================================
+
+template<typename Container>
+inline FileCacheKey& FileCacheKey::addVector(const Container& vec)
+{
+    qint64 iSize = static_cast<qint64>(vec.size());
+    add(reinterpret_cast<const char*>(&iSize), static_cast<int>(sizeof(iSize)));
+    return add(reinterpret_cast<const char*>(vec.data()), static_cast<int>(vec.size() * sizeof(typename Container::value_type)));
+}
+
+} // NAMESPACE UTILSLIB
+
+#endif // FILECACHE_H
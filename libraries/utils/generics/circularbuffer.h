@@ -46,6 +46,7 @@
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QAtomicInt>
 #include <QPair>
 #include <QSemaphore>
 #include <QSharedPointer>
@@ -63,6 +64,21 @@
 namespace UTILSLIB
 {
 
+//=============================================================================================================
+/**
+ * Queue statistics of a CircularBuffer. When the buffer connects two plugins, these describe that edge.
+ */
+struct CircularBufferStatistics
+{
+    int iCapacity;          /**< Maximal number of buffer elements. */
+    int iSize;              /**< Number of elements currently in the buffer. */
+    int iMaxSize;           /**< Highest number of elements in the buffer since the last reset (high-water mark). */
+    int iNumPushed;         /**< Number of pushed elements. */
+    int iNumPopped;         /**< Number of popped elements. */
+    int iNumPushTimeouts;   /**< Number of push attempts which timed out because the buffer was full (back pressure). */
+    int iNumPopTimeouts;    /**< Number of pop attempts which timed out because the buffer was empty (starvation). */
+};
+
 //=============================================================================================================
 /**
  * TEMPLATE CIRCULAR BUFFER
@@ -139,6 +155,20 @@ public:
      */
     inline int getFreeElementsWrite();
 
+    //=========================================================================================================
+    /**
+     * Returns the queue statistics, i.e. fill level, high-water mark and push/pop counters.
+     *
+     * @return the queue statistics.
+     */
+    inline CircularBufferStatistics getStatistics() const;
+
+    //=========================================================================================================
+    /**
+     * Resets the high-water mark and the push/pop counters.
+     */
+    inline void resetStatistics();
+
 private:
     //=========================================================================================================
     /**
@@ -148,6 +178,13 @@ private:
      * @return the mapped index.
      */
     inline unsigned int mapIndex(int& index);
+
+    //=========================================================================================================
+    /**
+     * Updates the high-water mark after elements were pushed.
+     */
+    inline void updateMaxSize();
+
     unsigned int    m_uiMaxNumElements;     /**< Holds the maximal number of buffer elements.*/
     _Tp*            m_pBuffer;              /**< Holds the circular buffer.*/
     int             m_iCurrentReadIndex;    /**< Holds the current read index.*/
@@ -157,6 +194,12 @@ private:
     int             m_iTimeout;             /**< Holds the timeout value after which the acquire statement will return false.*/
 
     bool            m_bPause;
+
+    QAtomicInt      m_iMaxSize;             /**< Holds the highest number of elements in the buffer since the last reset.*/
+    QAtomicInt      m_iNumPushed;           /**< Holds the number of pushed elements.*/
+    QAtomicInt      m_iNumPopped;           /**< Holds the number of popped elements.*/
+    QAtomicInt      m_iNumPushTimeouts;     /**< Holds the number of timed out push attempts.*/
+    QAtomicInt      m_iNumPopTimeouts;      /**< Holds the number of timed out pop attempts.*/
 };
 
 //=============================================================================================================
@@ -173,6 +216,11 @@ CircularBuffer<_Tp>::CircularBuffer(unsigned int uiMaxNumElements)
 , m_pUsedElements(new QSemaphore(0))
 , m_iTimeout(1000)
 , m_bPause(false)
+, m_iMaxSize(0)
+, m_iNumPushed(0)
+, m_iNumPopped(0)
+, m_iNumPushTimeouts(0)
+, m_iNumPopTimeouts(0)
 {
 }
 
@@ -196,8 +244,11 @@ inline bool CircularBuffer<_Tp>::push(const _Tp* pArray, unsigned int size)
             for(unsigned int i = 0; i < size; ++i) {
                 m_pBuffer[mapIndex(m_iCurrentWriteIndex)] = pArray[i];
             }
-            const QSemaphoreReleaser releaser(m_pUsedElements, size);
+            m_pUsedElements->release(size);
+            m_iNumPushed.fetchAndAddRelaxed(size);
+            updateMaxSize();
         } else {
+            m_iNumPushTimeouts.fetchAndAddRelaxed(1);
             return false;
         }
     }
@@ -212,8 +263,11 @@ inline bool CircularBuffer<_Tp>::push(const _Tp& newElement)
 {
     if(m_pFreeElements->tryAcquire(1, m_iTimeout)) {
         m_pBuffer[mapIndex(m_iCurrentWriteIndex)] = newElement;
-        const QSemaphoreReleaser releaser(m_pUsedElements, 1);
+        m_pUsedElements->release(1);
+        m_iNumPushed.fetchAndAddRelaxed(1);
+        updateMaxSize();
     } else {
+       m_iNumPushTimeouts.fetchAndAddRelaxed(1);
        return false;
     }
 
@@ -229,7 +283,9 @@ inline bool CircularBuffer<_Tp>::pop(_Tp& element)
         if(m_pUsedElements->tryAcquire(1, m_iTimeout)) {
             element = m_pBuffer[mapIndex(m_iCurrentReadIndex)];
             const QSemaphoreReleaser releaser(m_pFreeElements, 1);
+            m_iNumPopped.fetchAndAddRelaxed(1);
         } else {
+            m_iNumPopTimeouts.fetchAndAddRelaxed(1);
             return false;
         }
     }
@@ -248,6 +304,19 @@ inline unsigned int CircularBuffer<_Tp>::mapIndex(int& index)
 
 //=============================================================================================================
 
+template<typename _Tp>
+inline void CircularBuffer<_Tp>::updateMaxSize()
+{
+    int iSize = m_pUsedElements->available();
+    int iMaxSize = m_iMaxSize.loadAcquire();
+
+    while(iSize > iMaxSize && !m_iMaxSize.testAndSetOrdered(iMaxSize, iSize)) {
+        iMaxSize = m_iMaxSize.loadAcquire();
+    }
+}
+
+//=============================================================================================================
+
 template<typename _Tp>
 inline void CircularBuffer<_Tp>::clear()
 {
@@ -284,6 +353,35 @@ inline int CircularBuffer<_Tp>::getFreeElementsWrite()
     return m_pFreeElements->available();
 }
 
+//=============================================================================================================
+
+template<typename _Tp>
+inline CircularBufferStatistics CircularBuffer<_Tp>::getStatistics() const
+{
+    CircularBufferStatistics stats;
+    stats.iCapacity = m_uiMaxNumElements;
+    stats.iSize = m_pUsedElements->available();
+    stats.iMaxSize = m_iMaxSize.loadAcquire();
+    stats.iNumPushed = m_iNumPushed.loadAcquire();
+    stats.iNumPopped = m_iNumPopped.loadAcquire();
+    stats.iNumPushTimeouts = m_iNumPushTimeouts.loadAcquire();
+    stats.iNumPopTimeouts = m_iNumPopTimeouts.loadAcquire();
+
+    return stats;
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline void CircularBuffer<_Tp>::resetStatistics()
+{
+    m_iMaxSize.storeRelease(m_pUsedElements->available());
+    m_iNumPushed.storeRelease(0);
+    m_iNumPopped.storeRelease(0);
+    m_iNumPushTimeouts.storeRelease(0);
+    m_iNumPopTimeouts.storeRelease(0);
+}
+
 //=============================================================================================================
 // TYPEDEF
 //=============================================================================================================
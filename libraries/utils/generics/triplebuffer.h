@@ -0,0 +1,198 @@
+//=============================================================================================================
+/**
+ * @file     triplebuffer.h
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    TripleBuffer class declaration
+ *
+ */
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../utils_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QAtomicInt>
+#include <QSharedPointer>
+
+//=============================================================================================================
+// DEFINE NAMESPACE UTILSLIB
+//=============================================================================================================
+
+namespace UTILSLIB
+{
+
+//=============================================================================================================
+/**
+ * Lock-free single producer, single consumer triple buffer with latest-wins semantics. The producer fills the
+ * write slot and publishes it, the consumer picks up the most recently published slot. Frames which are
+ * published while the consumer is busy are overwritten, so the consumer never works on stale data and the
+ * memory footprint is bounded to three elements. The slots are reused, i.e. dynamically sized elements keep
+ * their allocation between frames.
+ *
+ * @brief Lock-free latest-wins hand-off between one producer and one consumer thread.
+ */
+template<typename T>
+class TripleBuffer
+{
+public:
+    typedef QSharedPointer<TripleBuffer> SPtr;              /**< Shared pointer type for TripleBuffer. */
+    typedef QSharedPointer<const TripleBuffer> ConstSPtr;   /**< Const shared pointer type for TripleBuffer. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a TripleBuffer with default constructed slots.
+     */
+    TripleBuffer();
+
+    //=========================================================================================================
+    /**
+     * Returns the slot owned by the producer. Only call this from the producer thread.
+     *
+     * @return The write slot.
+     */
+    inline T& writeBuffer();
+
+    //=========================================================================================================
+    /**
+     * Publishes the write slot to the consumer and hands a free slot back to the producer. Only call this from
+     * the producer thread.
+     *
+     * @return True if the previously published frame was not yet picked up by the consumer and got dropped.
+     */
+    inline bool publish();
+
+    //=========================================================================================================
+    /**
+     * Returns whether a frame was published which the consumer did not pick up yet.
+     *
+     * @return True if new data is available.
+     */
+    inline bool hasNewData() const;
+
+    //=========================================================================================================
+    /**
+     * Makes the most recently published frame the read slot. Only call this from the consumer thread.
+     *
+     * @return True if a new frame was picked up, false if the read slot is unchanged.
+     */
+    inline bool update();
+
+    //=========================================================================================================
+    /**
+     * Returns the slot owned by the consumer. Only call this from the consumer thread.
+     *
+     * @return The read slot.
+     */
+    inline const T& readBuffer() const;
+
+private:
+    enum {
+        IndexMask   = 0x3,      /**< Bits holding the index of the shared (middle) slot. */
+        DirtyBit    = 0x4       /**< Set when the shared slot holds a frame which was not picked up yet. */
+    };
+
+    T           m_slots[3];     /**< The three slots. */
+    QAtomicInt  m_iShared;      /**< Index of the shared slot plus the dirty bit. */
+    int         m_iWrite;       /**< Index of the slot owned by the producer. */
+    int         m_iRead;        /**< Index of the slot owned by the consumer. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+template<typename T>
+TripleBuffer<T>::TripleBuffer()
+: m_iShared(1)
+, m_iWrite(0)
+, m_iRead(2)
+{
+}
+
+//=============================================================================================================
+
+template<typename T>
+inline T& TripleBuffer<T>::writeBuffer()
+{
+    return m_slots[m_iWrite];
+}
+
+//=============================================================================================================
+
+template<typename T>
+inline bool TripleBuffer<T>::publish()
+{
+    int iPrevious = m_iShared.fetchAndStoreAcquireRelease(m_iWrite | DirtyBit);
+    m_iWrite = iPrevious & IndexMask;
+
+    return (iPrevious & DirtyBit) != 0;
+}
+
+//=============================================================================================================
+
+template<typename T>
+inline bool TripleBuffer<T>::hasNewData() const
+{
+    return (m_iShared.loadAcquire() & DirtyBit) != 0;
+}
+
+//=============================================================================================================
+
+template<typename T>
+inline bool TripleBuffer<T>::update()
+{
+    if(!hasNewData()) {
+        return false;
+    }
+
+    int iPrevious = m_iShared.fetchAndStoreAcquireRelease(m_iRead);
+    m_iRead = iPrevious & IndexMask;
+
+    return true;
+}
+
+//=============================================================================================================
+
+template<typename T>
+inline const T& TripleBuffer<T>::readBuffer() const
+{
+    return m_slots[m_iRead];
+}
+
+} // NAMESPACE
+
+#endif // TRIPLEBUFFER_H
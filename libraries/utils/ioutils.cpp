@@ -44,6 +44,7 @@
 //=============================================================================================================
 
 #include <QDataStream>
+#include <QtEndian>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -51,6 +52,21 @@
 
 #include <Eigen/Core>
 
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IOUTILS_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
@@ -58,10 +74,115 @@
 using namespace Eigen;
 using namespace UTILSLIB;
 
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+namespace
+{
+
+//=============================================================================================================
+/**
+ * Swaps iCount elements of type T with qbswap, used for the tails the vector loops leave over.
+ */
+template<typename T>
+inline void swapScalar(uchar* pData, qint64 iCount)
+{
+    for(qint64 i = 0; i < iCount; ++i) {
+        T value;
+        memcpy(&value, pData + i*sizeof(T), sizeof(T));
+        value = qbswap(value);
+        memcpy(pData + i*sizeof(T), &value, sizeof(T));
+    }
+}
+
+//=============================================================================================================
+/**
+ * Swaps the bytes of iCount elements of size iWidth in place and returns the number of elements handled. The
+ * remaining elements are left for swapScalar.
+ */
+inline qint64 swapVector(uchar* pData, qint64 iCount, int iWidth)
+{
+    const qint64 iBytes = iCount * iWidth;
+    qint64 iPos = 0;
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+    // Byte shuffle masks reversing each element within a 16 byte lane
+    alignas(16) static const char mask16[16] = {1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14};
+    alignas(16) static const char mask32[16] = {3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12};
+    alignas(16) static const char mask64[16] = {7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8};
+    const char* pMask = iWidth == 2 ? mask16 : (iWidth == 4 ? mask32 : mask64);
+    const __m128i m128 = _mm_load_si128(reinterpret_cast<const __m128i*>(pMask));
+
+#if defined(__AVX2__)
+    const __m256i m256 = _mm256_broadcastsi128_si256(m128);
+    for(; iPos + 32 <= iBytes; iPos += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + iPos));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pData + iPos), _mm256_shuffle_epi8(v, m256));
+    }
+#endif
+    for(; iPos + 16 <= iBytes; iPos += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + iPos));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pData + iPos), _mm_shuffle_epi8(v, m128));
+    }
+#elif defined(IOUTILS_SSE2)
+    // No byte shuffle: swap the bytes of each 16 bit word, then reorder the words for wider elements
+    for(; iPos + 16 <= iBytes; iPos += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + iPos));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        if(iWidth == 4) {
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2,3,0,1)), _MM_SHUFFLE(2,3,0,1));
+        } else if(iWidth == 8) {
+            v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(0,1,2,3)), _MM_SHUFFLE(0,1,2,3));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pData + iPos), v);
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    for(; iPos + 16 <= iBytes; iPos += 16) {
+        uint8x16_t v = vld1q_u8(pData + iPos);
+        v = iWidth == 2 ? vrev16q_u8(v) : (iWidth == 4 ? vrev32q_u8(v) : vrev64q_u8(v));
+        vst1q_u8(pData + iPos, v);
+    }
+#else
+    Q_UNUSED(pData)
+#endif
+
+    return iPos / iWidth;
+}
+
+} // namespace
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
 
+void IOUtils::swap_16(void *pData, qint64 iCount)
+{
+    uchar* p = static_cast<uchar*>(pData);
+    qint64 iDone = swapVector(p, iCount, 2);
+    swapScalar<quint16>(p + 2*iDone, iCount - iDone);
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_32(void *pData, qint64 iCount)
+{
+    uchar* p = static_cast<uchar*>(pData);
+    qint64 iDone = swapVector(p, iCount, 4);
+    swapScalar<quint32>(p + 4*iDone, iCount - iDone);
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_64(void *pData, qint64 iCount)
+{
+    uchar* p = static_cast<uchar*>(pData);
+    qint64 iDone = swapVector(p, iCount, 8);
+    swapScalar<quint64>(p + 8*iDone, iCount - iDone);
+}
+
+//=============================================================================================================
+
 qint32 IOUtils::fread3(QDataStream &p_qStream)
 {
     char* bytes = new char[3];
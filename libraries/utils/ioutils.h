@@ -184,6 +184,34 @@ public:
      */
     static void swap_doublep(double *source);
 
+    //=========================================================================================================
+    /**
+     * Swaps the byte order of an array of 16 bit values in place. Uses the widest byte shuffle the compiler
+     * targets (AVX2, SSSE3, SSE2 or NEON) and falls back to scalar swaps for the tail.
+     *
+     * @param[in, out] pData     start of the array, no alignment required.
+     * @param[in] iCount         number of 16 bit values.
+     */
+    static void swap_16(void *pData, qint64 iCount);
+
+    //=========================================================================================================
+    /**
+     * Swaps the byte order of an array of 32 bit values (int, float, complex float components) in place.
+     *
+     * @param[in, out] pData     start of the array, no alignment required.
+     * @param[in] iCount         number of 32 bit values.
+     */
+    static void swap_32(void *pData, qint64 iCount);
+
+    //=========================================================================================================
+    /**
+     * Swaps the byte order of an array of 64 bit values (long, double, complex double components) in place.
+     *
+     * @param[in, out] pData     start of the array, no alignment required.
+     * @param[in] iCount         number of 64 bit values.
+     */
+    static void swap_64(void *pData, qint64 iCount);
+
     //=========================================================================================================
     /**
      * Write Eigen Matrix to file
@@ -44,12 +44,15 @@
 #include <algorithm>
 #include <vector>
 #include <time.h>
+#include <cmath>
+#include <limits>
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QDebug>
+#include <QThreadStorage>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -58,6 +61,57 @@
 using namespace UTILSLIB;
 using namespace Eigen;
 
+//=============================================================================================================
+// DEFINE STATIC METHODS
+//=============================================================================================================
+
+/**
+ * Buffers of the Elkan bounds. They are kept per thread, so that the many small clusterings run by a
+ * QtConcurrent pool thread (e.g. one per region in MNEForwardSolution::cluster_forward_solution) reuse them.
+ */
+struct KMeansWorkspace
+{
+    VectorXd vecXT;         /**< Transposed input data p x n */
+    VectorXd vecCT;         /**< Transposed centroids p x k */
+    VectorXd vecLower;      /**< Lower bounds of the point to centroid distances n x k */
+    VectorXd vecUpper;      /**< Upper bounds of the distance of each point to its centroid */
+    VectorXd vecCC;         /**< Centroid to centroid distances k x k */
+    VectorXd vecHalfMin;    /**< Half the distance of each centroid to its closest other centroid */
+    VectorXd vecShift;      /**< Distance each centroid moved during the last update */
+    VectorXd vecCOld;       /**< Previous centroid */
+};
+
+static QThreadStorage<KMeansWorkspace> s_workspace;
+
+//=============================================================================================================
+
+static double* reserve(VectorXd& vecBuffer, Eigen::Index iSize)
+{
+    if(vecBuffer.size() < iSize)
+        vecBuffer.resize(iSize);
+    return vecBuffer.data();
+}
+
+//=============================================================================================================
+
+static double euclideanDist(const double* a, const double* b, qint32 p)
+{
+    double dist = 0;
+    for(qint32 j = 0; j < p; ++j)
+        dist += (a[j] - b[j]) * (a[j] - b[j]);
+    return std::sqrt(dist);
+}
+
+//=============================================================================================================
+
+static double cityblockDist(const double* a, const double* b, qint32 p)
+{
+    double dist = 0;
+    for(qint32 j = 0; j < p; ++j)
+        dist += std::fabs(a[j] - b[j]);
+    return dist;
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -181,6 +235,10 @@ bool KMeans::calculate(MatrixXd X,
             if (m_sDistance.compare("correlation") == 0)
                 C.array() -= (C.array().rowwise().sum()/p).replicate(1, p).array();
         }
+        else if (m_sStart.compare("plus") == 0)
+        {
+            plusPlusSeeds(X, C);
+        }
         else if (m_sStart.compare("sample") == 0)
         {
             C = MatrixXd::Zero(k,p);
@@ -219,7 +277,11 @@ bool KMeans::calculate(MatrixXd X,
         try // catch empty cluster errors and move on to next rep
         {
             // Begin phase one:  batch reassignments
-            bool converged = batchUpdate(X, C, idx);
+            bool converged;
+            if (m_sDistance.compare("sqeuclidean") == 0 || m_sDistance.compare("cityblock") == 0)
+                converged = elkanUpdate(X, C, idx);
+            else
+                converged = batchUpdate(X, C, idx);
 
             // Begin phase two:  single reassignments
             if (m_bOnline)
@@ -510,6 +572,294 @@ bool KMeans::batchUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
 
 //=============================================================================================================
 
+void KMeans::plusPlusSeeds(const MatrixXd& X, MatrixXd& C)
+{
+    C = MatrixXd::Zero(k,p);
+    C.row(0) = X.row(rand() % n);
+
+    MatrixXd C_tmp = C.row(0);
+    VectorXd minD = distfun(X, C_tmp).col(0);
+
+    for(qint32 i = 1; i < k; ++i)
+    {
+        // Draw the next centroid with probability proportional to the distance to the closest one so far
+        double total = minD.sum();
+        qint32 sel = rand() % n;
+        if(total > 0)
+        {
+            double r = total * ((double)rand() / ((double)RAND_MAX + 1.0));
+            double cum = 0;
+            for(sel = 0; sel < n - 1; ++sel)
+            {
+                cum += minD[sel];
+                if(cum > r)
+                    break;
+            }
+        }
+
+        C.row(i) = X.row(sel);
+        C_tmp = C.row(i);
+        minD = minD.cwiseMin(distfun(X, C_tmp).col(0));
+    }
+}
+
+//=============================================================================================================
+
+bool KMeans::elkanUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
+{
+    KMeansWorkspace& ws = s_workspace.localData();
+
+    // The bounds need a metric: euclidean instead of squared euclidean distances
+    const bool bSqEuclidean = m_sDistance.compare("sqeuclidean") == 0;
+    double (*metricDist)(const double*, const double*, qint32) = bSqEuclidean ? &euclideanDist : &cityblockDist;
+
+    // Points and centroids are stored column wise so that each one is contiguous
+    Map<MatrixXd> XT(reserve(ws.vecXT, p*n), p, n);
+    Map<MatrixXd> CT(reserve(ws.vecCT, p*k), p, k);
+    Map<MatrixXd> lower(reserve(ws.vecLower, n*k), n, k);
+    Map<VectorXd> upper(reserve(ws.vecUpper, n), n);
+    Map<MatrixXd> CC(reserve(ws.vecCC, k*k), k, k);
+    Map<VectorXd> halfMin(reserve(ws.vecHalfMin, k), k);
+    Map<VectorXd> shift(reserve(ws.vecShift, k), k);
+    Map<VectorXd> cOld(reserve(ws.vecCOld, p), p);
+
+    XT = X.transpose();
+
+    // Total sum of distances in units of distfun
+    auto objective = [&]() -> double {
+        double sum = 0;
+        for(qint32 i = 0; i < n; ++i)
+        {
+            double dist = metricDist(XT.col(i).data(), CT.col(idx[i]).data(), p);
+            sum += bSqEuclidean ? dist * dist : dist;
+        }
+        return sum;
+    };
+
+    // Exact bounds, needed at the start and after a singleton was created
+    auto resetBounds = [&]() {
+        for(qint32 j = 0; j < k; ++j)
+            for(qint32 i = 0; i < n; ++i)
+                lower(i,j) = metricDist(XT.col(i).data(), CT.col(j).data(), p);
+        for(qint32 i = 0; i < n; ++i)
+            upper[i] = lower(i,idx[i]);
+    };
+
+    // Deal with a cluster that lost all its members, the same way batchUpdate does. Returns false for "error".
+    VectorXi dropped = VectorXi::Zero(k);
+    MatrixXd C_new;
+    VectorXi m_new;
+
+    auto handleEmpty = [&](qint32 j, bool& bResetBounds) -> bool {
+        if (m_sEmptyact.compare("drop") == 0)
+        {
+            // Remove the empty cluster from any further processing
+            dropped[j] = 1;
+        }
+        else if (m_sEmptyact.compare("singleton") == 0)
+        {
+            // Take the point furthest away from its centroid out of its (non-singleton) cluster and use it to
+            // create a new singleton cluster which replaces the empty one
+            qint32 lonely = -1;
+            double dLarge = -1;
+            for(qint32 i = 0; i < n; ++i)
+            {
+                if(m[idx[i]] < 2)
+                    continue;
+                double dist = metricDist(XT.col(i).data(), CT.col(idx[i]).data(), p);
+                if(dist > dLarge)
+                {
+                    dLarge = dist;
+                    lonely = i;
+                }
+            }
+            if(lonely < 0)
+                return false;
+
+            qint32 from = idx[lonely];
+            idx[lonely] = j;
+            m[j] = 1;
+            C.row(j) = X.row(lonely);
+            CT.col(j) = XT.col(lonely);
+
+            // Update the cluster from which the point was taken
+            gcentroids(X, idx, VectorXi::Constant(1, from), C_new, m_new);
+            m[from] = m_new[0];
+            C.row(from) = C_new.row(0);
+            CT.col(from) = C_new.row(0).transpose();
+            bResetBounds = true;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    };
+
+    // Centroids of the initial assignment; empty clusters keep their seed
+    VectorXi all(k);
+    for(qint32 i = 0; i < k; ++i)
+        all[i] = i;
+
+    gcentroids(X, idx, all, C_new, m_new);
+    for(qint32 j = 0; j < k; ++j)
+        if(m_new[j] > 0)
+            C.row(j) = C_new.row(j);
+    m = m_new;
+    CT = C.transpose();
+
+    iter = 0;
+    bool converged = false;
+    bool bResetBounds = false;
+
+    for(qint32 j = 0; j < k; ++j)
+        if(m[j] == 0 && !handleEmpty(j, bResetBounds))
+            return converged;
+
+    // Start with exact bounds
+    resetBounds();
+
+    // The objective of the last accepted step; a step which does not decrease it is backed out
+    prevtotsumD = objective();
+    totsumD = prevtotsumD;
+
+    while(true)
+    {
+        ++iter;
+
+        for(qint32 a = 0; a < k; ++a)
+        {
+            CC(a,a) = 0;
+            for(qint32 b = a + 1; b < k; ++b)
+                CC(a,b) = CC(b,a) = metricDist(CT.col(a).data(), CT.col(b).data(), p);
+        }
+        for(qint32 a = 0; a < k; ++a)
+        {
+            halfMin[a] = std::numeric_limits<double>::max();
+            for(qint32 b = 0; b < k; ++b)
+                if(b != a && !dropped[b] && 0.5 * CC(a,b) < halfMin[a])
+                    halfMin[a] = 0.5 * CC(a,b);
+        }
+
+        // Reassign points; ties are resolved in favor of not moving
+        previdx = idx;
+        qint32 nummoved = 0;
+        for(qint32 i = 0; i < n; ++i)
+        {
+            qint32 a = idx[i];
+            if(upper[i] <= halfMin[a])
+                continue;
+
+            bool bTight = false;
+            for(qint32 j = 0; j < k; ++j)
+            {
+                if(j == a || dropped[j] || upper[i] <= lower(i,j) || upper[i] <= 0.5 * CC(a,j))
+                    continue;
+
+                if(!bTight)
+                {
+                    upper[i] = lower(i,a) = metricDist(XT.col(i).data(), CT.col(a).data(), p);
+                    bTight = true;
+                    if(upper[i] <= lower(i,j) || upper[i] <= 0.5 * CC(a,j))
+                        continue;
+                }
+
+                double dist = lower(i,j) = metricDist(XT.col(i).data(), CT.col(j).data(), p);
+                if(dist < upper[i])
+                {
+                    a = j;
+                    upper[i] = dist;
+                }
+            }
+
+            if(a != idx[i])
+            {
+                idx[i] = a;
+                ++nummoved;
+            }
+        }
+
+        if(nummoved == 0)
+        {
+            converged = true;
+            break;
+        }
+
+        // Find clusters that gained or lost members
+        std::vector<int> tmp;
+        for(qint32 i = 0; i < n; ++i)
+        {
+            if(idx[i] != previdx[i])
+            {
+                tmp.push_back(idx[i]);
+                tmp.push_back(previdx[i]);
+            }
+        }
+        std::sort(tmp.begin(),tmp.end());
+        tmp.erase(std::unique(tmp.begin(),tmp.end()), tmp.end());
+
+        VectorXi changed(tmp.size());
+        for(quint32 i = 0; i < tmp.size(); ++i)
+            changed[i] = tmp[i];
+
+        // Update their centroids and loosen the bounds by the centroid movement
+        gcentroids(X, idx, changed, C_new, m_new);
+        shift.setZero();
+        for(qint32 c = 0; c < changed.rows(); ++c)
+        {
+            qint32 j = changed[c];
+            m[j] = m_new[c];
+            if(m_new[c] > 0)
+            {
+                cOld = CT.col(j);
+                C.row(j) = C_new.row(c);
+                CT.col(j) = C_new.row(c).transpose();
+                shift[j] = metricDist(cOld.data(), CT.col(j).data(), p);
+            }
+        }
+
+        for(qint32 j = 0; j < k; ++j)
+            if(shift[j] > 0)
+                lower.col(j) = (lower.col(j).array() - shift[j]).max(0.0);
+        for(qint32 i = 0; i < n; ++i)
+            upper[i] += shift[idx[i]];
+
+        // Deal with clusters that have just lost all their members
+        bResetBounds = false;
+        for(qint32 c = 0; c < changed.rows(); ++c)
+            if(m[changed[c]] == 0 && !dropped[changed[c]] && !handleEmpty(changed[c], bResetBounds))
+                return converged;
+
+        if(bResetBounds)
+            resetBounds();
+
+        // Test for a cycle: if objective is not decreased, back out
+        // the last step and move on to the single update phase
+        totsumD = objective();
+        if(prevtotsumD <= totsumD)
+        {
+            idx = previdx;
+            gcentroids(X, idx, all, C_new, m_new);
+            for(qint32 j = 0; j < k; ++j)
+                if(m_new[j] > 0)
+                    C.row(j) = C_new.row(j);
+            m = m_new;
+            CT = C.transpose();
+            totsumD = objective();
+            --iter;
+            break;
+        }
+        prevtotsumD = totsumD;
+
+        if (iter >= m_iMaxit)
+            break;
+    }
+
+    return converged;
+}
+
+//=============================================================================================================
+
 bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
 {
     // Initialize some cluster information prior to phase two
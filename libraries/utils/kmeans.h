@@ -75,7 +75,7 @@ public:
     typedef QSharedPointer<const KMeans> ConstSPtr; /**< Const shared pointer type for KMeans. */
 
     //distance {'sqeuclidean','cityblock','cosine','correlation','hamming'};
-    //startNames = {'uniform','sample','cluster'};
+    //startNames = {'uniform','sample','plus','cluster'};
     //emptyactNames = {'error','drop','singleton'};
 
     //=========================================================================================================
@@ -83,7 +83,7 @@ public:
      * Constructs a KMeans algorithm object.
      *
      * @param[in] distance   (optional) K-Means distance measure: "sqeuclidean" (default), "cityblock" , "cosine", "correlation", "hamming"
-     * @param[in] start      (optional) Cluster initialization: "sample" (default), "uniform", "cluster"
+     * @param[in] start      (optional) Cluster initialization: "sample" (default), "uniform", "plus" (k-means++), "cluster"
      * @param[in] replicates (optional) Number of K-Means replicates, which are generated. Best is returned.
      * @param[in] emptyact   (optional) What happens if a cluster wents empty: "error" (default), "drop", "singleton"
      * @param[in] online     (optional) If centroids should be updated during iterations: true (default), false
@@ -127,6 +127,35 @@ private:
     Eigen::MatrixXd distfun(const Eigen::MatrixXd& X,
                             Eigen::MatrixXd& C);//, qint32 iter);
 
+    //=========================================================================================================
+    /**
+     * k-means++ initialization: each further centroid is drawn from the points with a probability proportional
+     * to its distance to the closest centroid chosen so far.
+     *
+     * @param[in] X          Input data
+     * @param[out] C         Initial cluster centroids k x p
+     */
+    void plusPlusSeeds(const Eigen::MatrixXd& X,
+                       Eigen::MatrixXd& C);
+
+    //=========================================================================================================
+    /**
+     * Batch reassignments accelerated by Elkan's triangle inequality bounds. Used instead of batchUpdate for the
+     * metric distances "sqeuclidean" (bounds on the euclidean distance) and "cityblock". Point to centroid
+     * distances are only computed when the bounds can not exclude a reassignment. Empty clusters are handled
+     * according to the emptyact setting and a step which does not decrease the total sum of distances is backed
+     * out, as in batchUpdate.
+     *
+     * @param[in] X          Input data
+     * @param[in, out] C     Cluster centroids
+     * @param[in, out] idx   The cluster indeces to which cluster the input points belong to
+     *
+     * @return true if converged, false otherwise
+     */
+    bool elkanUpdate(const Eigen::MatrixXd& X,
+                     Eigen::MatrixXd& C,
+                     Eigen::VectorXi& idx);
+
     //=========================================================================================================
     /**
      * Updates clusters when points moved
@@ -65,6 +65,7 @@ SOURCES += \
     kmeans.cpp \
     mnemath.cpp \
     ioutils.cpp \
+    filecache.cpp \
     layoutloader.cpp \
     layoutmaker.cpp \
     selectionio.cpp \
@@ -80,6 +81,7 @@ HEADERS += \
     utils_global.h \
     mnemath.h \
     ioutils.h \
+    filecache.h \
     layoutloader.h \
     layoutmaker.h \
     selectionio.h \
@@ -89,6 +91,7 @@ HEADERS += \
     sphere.h \
     simplex_algorithm.h \
     generics/circularbuffer.h \
+    generics/triplebuffer.h \
     generics/commandpattern.h \
     generics/observerpattern.h \
     generics/applicationlogger.h \
@@ -0,0 +1,305 @@
+//=============================================================================================================
+/**
+ * @file     test_byte_swap.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the bulk byte swaps and the fused data buffer decode against scalar swaps.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/ioutils.h>
+
+#include <fiff/fiff_constants.h>
+#include <fiff/fiff_file.h>
+#include <fiff/fiff_tag.h>
+
+#include <cstring>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestByteSwap
+ *
+ * @brief The TestByteSwap class compares the vectorized IOUtils swaps and FiffTag::decode_data_buffer with
+ *        element wise scalar swaps, for all lengths around the vector widths and unaligned starts.
+ *
+ */
+class TestByteSwap : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestByteSwap();
+
+private slots:
+    void initTestCase();
+    void compareSwap16();
+    void compareSwap32();
+    void compareSwap64();
+    void compareDecode_data();
+    void compareDecode();
+    void cleanupTestCase();
+
+private:
+    QByteArray createBytes(int iSize) const;
+
+    double  dEpsilon;
+    int     m_iMaxCount;
+};
+
+//=============================================================================================================
+
+TestByteSwap::TestByteSwap()
+: dEpsilon(1e-12)
+, m_iMaxCount(80)
+{
+}
+
+//=============================================================================================================
+
+void TestByteSwap::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(42);
+}
+
+//=============================================================================================================
+
+void TestByteSwap::compareSwap16()
+{
+    // Every count up to several 32 byte vectors plus the tail, at every offset within a vector lane
+    for(int iOffset = 0; iOffset < 8; ++iOffset) {
+        for(int iCount = 0; iCount <= m_iMaxCount; ++iCount) {
+            QByteArray baData = createBytes(iOffset + 2 * iCount + 8);
+            QByteArray baRef = baData;
+
+            IOUtils::swap_16(baData.data() + iOffset, iCount);
+
+            for(int i = 0; i < iCount; ++i) {
+                qint16 value;
+                memcpy(&value, baRef.constData() + iOffset + 2 * i, 2);
+                value = IOUtils::swap_short(value);
+                memcpy(baRef.data() + iOffset + 2 * i, &value, 2);
+            }
+
+            // Bytes around the array are left alone
+            QVERIFY2(baData == baRef, qPrintable(QString("offset %1 count %2").arg(iOffset).arg(iCount)));
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestByteSwap::compareSwap32()
+{
+    for(int iOffset = 0; iOffset < 8; ++iOffset) {
+        for(int iCount = 0; iCount <= m_iMaxCount; ++iCount) {
+            QByteArray baData = createBytes(iOffset + 4 * iCount + 8);
+            QByteArray baRef = baData;
+
+            IOUtils::swap_32(baData.data() + iOffset, iCount);
+
+            for(int i = 0; i < iCount; ++i) {
+                qint32 value;
+                memcpy(&value, baRef.constData() + iOffset + 4 * i, 4);
+                value = IOUtils::swap_int(value);
+                memcpy(baRef.data() + iOffset + 4 * i, &value, 4);
+            }
+
+            QVERIFY2(baData == baRef, qPrintable(QString("offset %1 count %2").arg(iOffset).arg(iCount)));
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestByteSwap::compareSwap64()
+{
+    for(int iOffset = 0; iOffset < 8; ++iOffset) {
+        for(int iCount = 0; iCount <= m_iMaxCount; ++iCount) {
+            QByteArray baData = createBytes(iOffset + 8 * iCount + 8);
+            QByteArray baRef = baData;
+
+            IOUtils::swap_64(baData.data() + iOffset, iCount);
+
+            for(int i = 0; i < iCount; ++i) {
+                qint64 value;
+                memcpy(&value, baRef.constData() + iOffset + 8 * i, 8);
+                value = IOUtils::swap_long(value);
+                memcpy(baRef.data() + iOffset + 8 * i, &value, 8);
+            }
+
+            QVERIFY2(baData == baRef, qPrintable(QString("offset %1 count %2").arg(iOffset).arg(iCount)));
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestByteSwap::compareDecode_data()
+{
+    QTest::addColumn<int>("iType");
+    QTest::addColumn<int>("iEndian");
+
+    QTest::newRow("short big endian") << int(FIFFT_SHORT) << int(FIFFV_BIG_ENDIAN);
+    QTest::newRow("dau_pack16 big endian") << int(FIFFT_DAU_PACK16) << int(FIFFV_BIG_ENDIAN);
+    QTest::newRow("int big endian") << int(FIFFT_INT) << int(FIFFV_BIG_ENDIAN);
+    QTest::newRow("float big endian") << int(FIFFT_FLOAT) << int(FIFFV_BIG_ENDIAN);
+    QTest::newRow("double big endian") << int(FIFFT_DOUBLE) << int(FIFFV_BIG_ENDIAN);
+    QTest::newRow("float native") << int(FIFFT_FLOAT) << int(FIFFV_NATIVE_ENDIAN);
+    QTest::newRow("int native") << int(FIFFT_INT) << int(FIFFV_NATIVE_ENDIAN);
+}
+
+//=============================================================================================================
+
+void TestByteSwap::compareDecode()
+{
+    QFETCH(int, iType);
+    QFETCH(int, iEndian);
+
+    const qint32 nchan = 37;
+    const qint32 nsamp = 123;
+
+    RowVectorXd cals = RowVectorXd::Random(nchan).cwiseAbs().array() + 0.5;
+
+    // Reference samples in native order, the payload holds them in the file byte order
+    MatrixXd matRef(nchan, nsamp);
+    QByteArray baPayload;
+
+    switch(iType) {
+        case FIFFT_SHORT:
+        case FIFFT_DAU_PACK16:
+        {
+            Matrix<qint16, Dynamic, Dynamic> mat = (MatrixXd::Random(nchan, nsamp) * 30000.0).cast<qint16>();
+            matRef = mat.cast<double>();
+            baPayload = QByteArray(reinterpret_cast<const char*>(mat.data()), int(mat.size() * sizeof(qint16)));
+            for(int i = 0; iEndian == FIFFV_BIG_ENDIAN && i < mat.size(); ++i) {
+                qint16 value = IOUtils::swap_short(mat.data()[i]);
+                memcpy(baPayload.data() + i * sizeof(qint16), &value, sizeof(qint16));
+            }
+            break;
+        }
+        case FIFFT_INT:
+        {
+            MatrixXi mat = (MatrixXd::Random(nchan, nsamp) * 2e9).cast<int>();
+            matRef = mat.cast<double>();
+            baPayload = QByteArray(reinterpret_cast<const char*>(mat.data()), int(mat.size() * sizeof(int)));
+            for(int i = 0; iEndian == FIFFV_BIG_ENDIAN && i < mat.size(); ++i) {
+                qint32 value = IOUtils::swap_int(mat.data()[i]);
+                memcpy(baPayload.data() + i * sizeof(qint32), &value, sizeof(qint32));
+            }
+            break;
+        }
+        case FIFFT_FLOAT:
+        {
+            MatrixXf mat = MatrixXf::Random(nchan, nsamp) * 1e-11f;
+            matRef = mat.cast<double>();
+            baPayload = QByteArray(reinterpret_cast<const char*>(mat.data()), int(mat.size() * sizeof(float)));
+            for(int i = 0; iEndian == FIFFV_BIG_ENDIAN && i < mat.size(); ++i) {
+                float value = IOUtils::swap_float(mat.data()[i]);
+                memcpy(baPayload.data() + i * sizeof(float), &value, sizeof(float));
+            }
+            break;
+        }
+        default:
+        {
+            MatrixXd mat = MatrixXd::Random(nchan, nsamp) * 1e-11;
+            matRef = mat;
+            baPayload = QByteArray(reinterpret_cast<const char*>(mat.data()), int(mat.size() * sizeof(double)));
+            for(int i = 0; iEndian == FIFFV_BIG_ENDIAN && i < mat.size(); ++i) {
+                double value = mat.data()[i];
+                IOUtils::swap_doublep(&value);
+                memcpy(baPayload.data() + i * sizeof(double), &value, sizeof(double));
+            }
+        }
+    }
+
+    const QByteArray baOriginal = baPayload;
+
+    MatrixXd matData;
+    QVERIFY(FiffTag::decode_data_buffer(baPayload.constData(), baPayload.size(), iType, iEndian, nchan, nsamp, matData));
+    QVERIFY((matData - matRef).cwiseAbs().maxCoeff() <= dEpsilon * matRef.cwiseAbs().maxCoeff());
+
+    MatrixXd matCalibrated;
+    QVERIFY(FiffTag::decode_data_buffer(baPayload.constData(), baPayload.size(), iType, iEndian, nchan, nsamp, matCalibrated, cals));
+    MatrixXd matRefCalibrated = cals.transpose().asDiagonal() * matRef;
+    QVERIFY((matCalibrated - matRefCalibrated).cwiseAbs().maxCoeff() <= dEpsilon * matRefCalibrated.cwiseAbs().maxCoeff());
+
+    MatrixXf matDataFloat;
+    QVERIFY(FiffTag::decode_data_buffer(baPayload.constData(), baPayload.size(), iType, iEndian, nchan, nsamp, matDataFloat, cals));
+    QVERIFY((matDataFloat.cast<double>() - matRefCalibrated).cwiseAbs().maxCoeff() <= 1e-6 * matRefCalibrated.cwiseAbs().maxCoeff());
+
+    // The payload is read only and a short payload is rejected
+    QVERIFY(baPayload == baOriginal);
+    QVERIFY(!FiffTag::decode_data_buffer(baPayload.constData(), baPayload.size() - 1, iType, iEndian, nchan, nsamp, matData));
+}
+
+//=============================================================================================================
+
+void TestByteSwap::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+QByteArray TestByteSwap::createBytes(int iSize) const
+{
+    QByteArray baData(iSize, Qt::Uninitialized);
+    for(int i = 0; i < iSize; ++i) {
+        baData[i] = static_cast<char>(std::rand() & 0xFF);
+    }
+
+    return baData;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestByteSwap)
+#include "test_byte_swap.moc"
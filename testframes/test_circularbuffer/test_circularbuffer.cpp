@@ -0,0 +1,275 @@
+//=============================================================================================================
+/**
+ * @file     test_circularbuffer.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the queue statistics of the CircularBuffer.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/generics/circularbuffer.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtConcurrent>
+#include <QtTest>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestCircularBuffer
+ *
+ * @brief The TestCircularBuffer class checks the push/pop counters, the timeout counters and the high-water mark
+ *        of the CircularBuffer queue statistics.
+ *
+ */
+class TestCircularBuffer : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestCircularBuffer();
+
+private slots:
+    void initTestCase();
+    void compareCounters();
+    void compareTimeouts();
+    void compareReset();
+    void compareConcurrent();
+    void cleanupTestCase();
+
+private:
+    int     m_iCapacity;
+};
+
+//=============================================================================================================
+
+TestCircularBuffer::TestCircularBuffer()
+: m_iCapacity(4)
+{
+}
+
+//=============================================================================================================
+
+void TestCircularBuffer::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+}
+
+//=============================================================================================================
+
+void TestCircularBuffer::compareCounters()
+{
+    CircularBuffer_int buffer(m_iCapacity);
+
+    CircularBufferStatistics stats = buffer.getStatistics();
+    QCOMPARE(stats.iCapacity, m_iCapacity);
+    QCOMPARE(stats.iSize, 0);
+    QCOMPARE(stats.iMaxSize, 0);
+    QCOMPARE(stats.iNumPushed, 0);
+    QCOMPARE(stats.iNumPopped, 0);
+
+    for(int i = 0; i < 3; ++i) {
+        QVERIFY(buffer.push(i));
+    }
+
+    int iValue;
+    QVERIFY(buffer.pop(iValue));
+    QCOMPARE(iValue, 0);
+    QVERIFY(buffer.pop(iValue));
+    QCOMPARE(iValue, 1);
+
+    stats = buffer.getStatistics();
+    QCOMPARE(stats.iSize, 1);
+    QCOMPARE(stats.iMaxSize, 3);
+    QCOMPARE(stats.iNumPushed, 3);
+    QCOMPARE(stats.iNumPopped, 2);
+
+    // An array push counts every element and raises the high-water mark to the full buffer
+    const int pArray[3] = {3, 4, 5};
+    QVERIFY(buffer.push(pArray, 3));
+
+    stats = buffer.getStatistics();
+    QCOMPARE(stats.iSize, m_iCapacity);
+    QCOMPARE(stats.iMaxSize, m_iCapacity);
+    QCOMPARE(stats.iNumPushed, 6);
+
+    for(int i = 2; i < 6; ++i) {
+        QVERIFY(buffer.pop(iValue));
+        QCOMPARE(iValue, i);
+    }
+
+    // The high-water mark stays when the buffer drains
+    stats = buffer.getStatistics();
+    QCOMPARE(stats.iSize, 0);
+    QCOMPARE(stats.iMaxSize, m_iCapacity);
+    QCOMPARE(stats.iNumPushed, 6);
+    QCOMPARE(stats.iNumPopped, 6);
+    QCOMPARE(stats.iNumPushTimeouts, 0);
+    QCOMPARE(stats.iNumPopTimeouts, 0);
+}
+
+//=============================================================================================================
+
+void TestCircularBuffer::compareTimeouts()
+{
+    CircularBuffer_int buffer(2);
+
+    // Starvation
+    int iValue;
+    QVERIFY(!buffer.pop(iValue));
+
+    // Back pressure, for single elements and arrays
+    QVERIFY(buffer.push(1));
+    QVERIFY(buffer.push(2));
+    QVERIFY(!buffer.push(3));
+
+    const int pArray[2] = {4, 5};
+    QVERIFY(!buffer.push(pArray, 2));
+
+    CircularBufferStatistics stats = buffer.getStatistics();
+    QCOMPARE(stats.iNumPushed, 2);
+    QCOMPARE(stats.iNumPopped, 0);
+    QCOMPARE(stats.iNumPushTimeouts, 2);
+    QCOMPARE(stats.iNumPopTimeouts, 1);
+    QCOMPARE(stats.iMaxSize, 2);
+
+    // A paused buffer skips the array and neither counts nor times out
+    buffer.pause(true);
+    QVERIFY(buffer.push(pArray, 2));
+    QVERIFY(buffer.pop(iValue));
+    buffer.pause(false);
+
+    stats = buffer.getStatistics();
+    QCOMPARE(stats.iSize, 2);
+    QCOMPARE(stats.iNumPushed, 2);
+    QCOMPARE(stats.iNumPopped, 0);
+    QCOMPARE(stats.iNumPushTimeouts, 2);
+    QCOMPARE(stats.iNumPopTimeouts, 1);
+}
+
+//=============================================================================================================
+
+void TestCircularBuffer::compareReset()
+{
+    CircularBuffer_int buffer(m_iCapacity);
+
+    int iValue;
+    for(int i = 0; i < m_iCapacity; ++i) {
+        QVERIFY(buffer.push(i));
+    }
+    QVERIFY(buffer.pop(iValue));
+    QVERIFY(buffer.pop(iValue));
+
+    // The counters restart from zero, the high-water mark from the current fill level
+    buffer.resetStatistics();
+
+    CircularBufferStatistics stats = buffer.getStatistics();
+    QCOMPARE(stats.iSize, 2);
+    QCOMPARE(stats.iMaxSize, 2);
+    QCOMPARE(stats.iNumPushed, 0);
+    QCOMPARE(stats.iNumPopped, 0);
+    QCOMPARE(stats.iNumPushTimeouts, 0);
+    QCOMPARE(stats.iNumPopTimeouts, 0);
+
+    QVERIFY(buffer.push(7));
+    QVERIFY(buffer.pop(iValue));
+
+    stats = buffer.getStatistics();
+    QCOMPARE(stats.iSize, 2);
+    QCOMPARE(stats.iMaxSize, 3);
+    QCOMPARE(stats.iNumPushed, 1);
+    QCOMPARE(stats.iNumPopped, 1);
+}
+
+//=============================================================================================================
+
+void TestCircularBuffer::compareConcurrent()
+{
+    CircularBuffer_int buffer(m_iCapacity);
+    const int iNumElements = 10000;
+
+    // A producer and a consumer thread, the counters and the high-water mark have to stay consistent
+    QFuture<int> producer = QtConcurrent::run([&buffer, iNumElements]() {
+        int iNumPushed = 0;
+        for(int i = 0; i < iNumElements; ++i) {
+            while(!buffer.push(i)) {
+            }
+            ++iNumPushed;
+        }
+        return iNumPushed;
+    });
+
+    QFuture<bool> consumer = QtConcurrent::run([&buffer, iNumElements]() {
+        int iValue;
+        for(int i = 0; i < iNumElements; ++i) {
+            while(!buffer.pop(iValue)) {
+            }
+            if(iValue != i) {
+                return false;
+            }
+        }
+        return true;
+    });
+
+    QCOMPARE(producer.result(), iNumElements);
+    QVERIFY(consumer.result());
+
+    CircularBufferStatistics stats = buffer.getStatistics();
+    QCOMPARE(stats.iSize, 0);
+    QCOMPARE(stats.iNumPushed, iNumElements);
+    QCOMPARE(stats.iNumPopped, iNumElements);
+    QVERIFY(stats.iMaxSize >= 1);
+    QVERIFY(stats.iMaxSize <= m_iCapacity);
+}
+
+//=============================================================================================================
+
+void TestCircularBuffer::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestCircularBuffer)
+#include "test_circularbuffer.moc"
@@ -0,0 +1,304 @@
+//=============================================================================================================
+/**
+ * @file     test_connectivity_correlation.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the batched Correlation and CrossCorrelation against a per pair reference.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/spectral.h>
+
+#include <connectivity/connectivitysettings.h>
+#include <connectivity/metrics/abstractmetric.h>
+#include <connectivity/metrics/correlation.h>
+#include <connectivity/metrics/crosscorrelation.h>
+#include <connectivity/network/network.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <unsupported/Eigen/FFT>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace CONNECTIVITYLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * Exposes the trial partitioning of AbstractMetric to the test.
+ */
+class TrialBlocks : public AbstractMetric
+{
+public:
+    using AbstractMetric::getTrialBlocks;
+};
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestConnectivityCorrelation
+ *
+ * @brief The TestConnectivityCorrelation class compares the batched Correlation and CrossCorrelation with a
+ *        straightforward per pair computation and checks that the result does not depend on the trial blocks.
+ *
+ */
+class TestConnectivityCorrelation: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestConnectivityCorrelation();
+
+private slots:
+    void initTestCase();
+    void compareTrialBlocks();
+    void compareCorrelation();
+    void compareCrossCorrelation();
+    void cleanupTestCase();
+
+private:
+    typedef Network (*CalculateFunc)(ConnectivitySettings&);
+
+    MatrixXd calculateMetric(CalculateFunc calculate,
+                             int iNumberBlocks) const;
+    MatrixXd referenceCorrelation() const;
+    MatrixXd referenceCrossCorrelation() const;
+
+    double              m_dEpsilon;
+    int                 m_iNumberChannels;
+    int                 m_iNumberSamples;
+    int                 m_iNumberTrials;
+    QList<MatrixXd>     m_lTrials;
+    QList<int>          m_lNumberBlocks;
+};
+
+//=============================================================================================================
+
+TestConnectivityCorrelation::TestConnectivityCorrelation()
+: m_dEpsilon(1e-9)
+, m_iNumberChannels(9)
+, m_iNumberSamples(100)
+, m_iNumberTrials(11)
+{
+}
+
+//=============================================================================================================
+
+void TestConnectivityCorrelation::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    AbstractMetric::m_bStorageModeIsActive = false;
+
+    std::srand(7);
+
+    // Noise with a shared component and an offset, so that demeaning and normalization matter
+    for(int i = 0; i < m_iNumberTrials; ++i) {
+        MatrixXd matTrial = MatrixXd::Random(m_iNumberChannels, m_iNumberSamples);
+        RowVectorXd vecCommon = RowVectorXd::Random(m_iNumberSamples);
+
+        for(int j = 0; j < m_iNumberChannels; ++j) {
+            matTrial.row(j) = (matTrial.row(j) + (0.3 * j) * vecCommon).array() + 0.5 * j;
+        }
+
+        m_lTrials << matTrial;
+    }
+
+    // One block, fewer blocks than trials, uneven blocks, one trial per block and more blocks than trials
+    m_lNumberBlocks << 1 << 2 << 4 << m_iNumberTrials << 2 * m_iNumberTrials;
+}
+
+//=============================================================================================================
+
+void TestConnectivityCorrelation::compareTrialBlocks()
+{
+    for(int iNumberBlocks : m_lNumberBlocks) {
+        AbstractMetric::m_iNumberTrialBlocks = iNumberBlocks;
+        QVector<QPair<int,int> > vecBlocks = TrialBlocks::getTrialBlocks(m_iNumberTrials);
+
+        // Contiguous, non-empty blocks which cover every trial once
+        QCOMPARE(vecBlocks.size(), qMin(iNumberBlocks, m_iNumberTrials));
+        QCOMPARE(vecBlocks.first().first, 0);
+        QCOMPARE(vecBlocks.last().second, m_iNumberTrials);
+
+        for(int i = 0; i < vecBlocks.size(); ++i) {
+            QVERIFY(vecBlocks.at(i).second > vecBlocks.at(i).first);
+
+            if(i > 0) {
+                QCOMPARE(vecBlocks.at(i).first, vecBlocks.at(i - 1).second);
+            }
+        }
+    }
+
+    AbstractMetric::m_iNumberTrialBlocks = -1;
+    QVERIFY(TrialBlocks::getTrialBlocks(0).isEmpty());
+}
+
+//=============================================================================================================
+
+void TestConnectivityCorrelation::compareCorrelation()
+{
+    MatrixXd matRef = referenceCorrelation();
+
+    // Pearson coefficients are bounded, the raw inner products of the offset data are not
+    QVERIFY(matRef.cwiseAbs().maxCoeff() <= 1.0 + m_dEpsilon);
+
+    for(int iNumberBlocks : m_lNumberBlocks) {
+        MatrixXd matResult = calculateMetric(&Correlation::calculate, iNumberBlocks);
+        QVERIFY((matResult - matRef).cwiseAbs().maxCoeff() < m_dEpsilon);
+    }
+}
+
+//=============================================================================================================
+
+void TestConnectivityCorrelation::compareCrossCorrelation()
+{
+    MatrixXd matRef = referenceCrossCorrelation();
+    QVERIFY(matRef.cwiseAbs().maxCoeff() > 0.0);
+
+    for(int iNumberBlocks : m_lNumberBlocks) {
+        MatrixXd matResult = calculateMetric(&CrossCorrelation::calculate, iNumberBlocks);
+        QVERIFY((matResult - matRef).cwiseAbs().maxCoeff() < m_dEpsilon * matRef.cwiseAbs().maxCoeff());
+    }
+}
+
+//=============================================================================================================
+
+void TestConnectivityCorrelation::cleanupTestCase()
+{
+    AbstractMetric::m_iNumberTrialBlocks = -1;
+}
+
+//=============================================================================================================
+
+MatrixXd TestConnectivityCorrelation::calculateMetric(CalculateFunc calculate,
+                                                      int iNumberBlocks) const
+{
+    AbstractMetric::m_iNumberTrialBlocks = iNumberBlocks;
+
+    ConnectivitySettings settings;
+    settings.setSamplingFrequency(256);
+    settings.setFFTSize(m_iNumberSamples);
+    settings.setWindowType("hanning");
+    settings.append(m_lTrials);
+
+    MatrixXd matResult = calculate(settings).getFullConnectivityMatrix(false);
+    AbstractMetric::m_iNumberTrialBlocks = -1;
+
+    return matResult;
+}
+
+//=============================================================================================================
+
+MatrixXd TestConnectivityCorrelation::referenceCorrelation() const
+{
+    // Pearson correlation of every pair i < j, averaged over the trials
+    MatrixXd matRef = MatrixXd::Zero(m_iNumberChannels, m_iNumberChannels);
+
+    for(const MatrixXd& matTrial : m_lTrials) {
+        for(int i = 0; i < m_iNumberChannels; ++i) {
+            RowVectorXd vecI = matTrial.row(i).array() - matTrial.row(i).mean();
+
+            for(int j = i + 1; j < m_iNumberChannels; ++j) {
+                RowVectorXd vecJ = matTrial.row(j).array() - matTrial.row(j).mean();
+                matRef(i,j) += vecI.dot(vecJ) / (vecI.norm() * vecJ.norm());
+            }
+        }
+    }
+
+    return matRef / m_iNumberTrials;
+}
+
+//=============================================================================================================
+
+MatrixXd TestConnectivityCorrelation::referenceCrossCorrelation() const
+{
+    // The per pair computation of the unbatched implementation: taper averaged spectra, product, inverse FFT, max
+    QPair<MatrixXd, VectorXd> tapers = Spectral::generateTapers(m_iNumberSamples, "hanning");
+    const int iNfft = m_iNumberSamples;
+    const double dDenom = tapers.second.sum();
+
+    FFT<double> fft;
+    fft.SetFlag(fft.HalfSpectrum);
+
+    MatrixXd matRef = MatrixXd::Zero(m_iNumberChannels, m_iNumberChannels);
+    RowVectorXd vecTime;
+    RowVectorXcd vecFreq;
+
+    for(const MatrixXd& matTrial : m_lTrials) {
+        QList<RowVectorXcd> lSpectra;
+
+        for(int i = 0; i < m_iNumberChannels; ++i) {
+            RowVectorXd vecRow = matTrial.row(i).array() - matTrial.row(i).mean();
+            RowVectorXcd vecSpectrum = RowVectorXcd::Zero(iNfft / 2 + 1);
+
+            for(int k = 0; k < tapers.first.rows(); ++k) {
+                vecTime = vecRow.cwiseProduct(tapers.first.row(k));
+                fft.fwd(vecFreq, vecTime, iNfft);
+                vecSpectrum += vecFreq * tapers.second(k);
+            }
+
+            lSpectra << vecSpectrum / dDenom;
+        }
+
+        for(int i = 0; i < m_iNumberChannels; ++i) {
+            for(int j = i + 1; j < m_iNumberChannels; ++j) {
+                vecFreq = lSpectra.at(i).cwiseProduct(lSpectra.at(j));
+                fft.inv(vecTime, vecFreq, iNfft);
+                matRef(i,j) += vecTime.maxCoeff();
+            }
+        }
+    }
+
+    return matRef / m_iNumberTrials;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestConnectivityCorrelation)
+#include "test_connectivity_correlation.moc"
@@ -0,0 +1,261 @@
+//=============================================================================================================
+/**
+ * @file     test_connectivity_incremental.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the incremental sliding window connectivity against a full recompute.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <connectivity/connectivitysettings.h>
+#include <connectivity/metrics/abstractmetric.h>
+#include <connectivity/metrics/coherence.h>
+#include <connectivity/metrics/imagcoherence.h>
+#include <connectivity/metrics/phaselockingvalue.h>
+#include <connectivity/metrics/phaselagindex.h>
+#include <connectivity/metrics/weightedphaselagindex.h>
+#include <connectivity/network/network.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace CONNECTIVITYLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestConnectivityIncremental
+ *
+ * @brief The TestConnectivityIncremental class slides a trial window over a stream the way RtConnectivity does,
+ *        subtracting leaving trials from the stored sums, and compares each estimate with a full recompute.
+ *
+ */
+class TestConnectivityIncremental: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestConnectivityIncremental();
+
+private slots:
+    void initTestCase();
+    void compareCoherence();
+    void compareImagCoherence();
+    void comparePLV();
+    void comparePLI();
+    void compareWPLI();
+    void compareRemoveLast();
+    void cleanupTestCase();
+
+private:
+    typedef Network (*CalculateFunc)(ConnectivitySettings&);
+
+    void compareSlidingWindow(CalculateFunc calculate);
+    MatrixXd calculateFull(CalculateFunc calculate,
+                           int iFirstTrial,
+                           int iNumberTrials);
+    void setup(ConnectivitySettings& settings) const;
+
+    double              m_dEpsilon;
+    int                 m_iNumberChannels;
+    int                 m_iNumberSamples;
+    int                 m_iWindowSize;
+    int                 m_iHopSize;
+    QList<MatrixXd>     m_lTrials;
+};
+
+//=============================================================================================================
+
+TestConnectivityIncremental::TestConnectivityIncremental()
+: m_dEpsilon(1e-9)
+, m_iNumberChannels(6)
+, m_iNumberSamples(128)
+, m_iWindowSize(6)
+, m_iHopSize(2)
+{
+}
+
+//=============================================================================================================
+
+void TestConnectivityIncremental::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    // The incremental path relies on the trials keeping their intermediate data
+    AbstractMetric::m_bStorageModeIsActive = true;
+    AbstractMetric::m_iNumberBinStart = -1;
+    AbstractMetric::m_iNumberBinAmount = -1;
+
+    std::srand(42);
+
+    // Noise with a shared component so the estimates are not all close to zero
+    for(int i = 0; i < 16; ++i) {
+        MatrixXd matTrial = MatrixXd::Random(m_iNumberChannels, m_iNumberSamples);
+        RowVectorXd vecCommon = RowVectorXd::Random(m_iNumberSamples);
+
+        for(int j = 0; j < m_iNumberChannels; ++j) {
+            matTrial.row(j) += (0.2 * j) * vecCommon;
+        }
+
+        m_lTrials << matTrial;
+    }
+}
+
+//=============================================================================================================
+
+void TestConnectivityIncremental::compareCoherence()
+{
+    compareSlidingWindow(&Coherence::calculate);
+}
+
+//=============================================================================================================
+
+void TestConnectivityIncremental::compareImagCoherence()
+{
+    compareSlidingWindow(&ImagCoherence::calculate);
+}
+
+//=============================================================================================================
+
+void TestConnectivityIncremental::comparePLV()
+{
+    compareSlidingWindow(&PhaseLockingValue::calculate);
+}
+
+//=============================================================================================================
+
+void TestConnectivityIncremental::comparePLI()
+{
+    compareSlidingWindow(&PhaseLagIndex::calculate);
+}
+
+//=============================================================================================================
+
+void TestConnectivityIncremental::compareWPLI()
+{
+    compareSlidingWindow(&WeightedPhaseLagIndex::calculate);
+}
+
+//=============================================================================================================
+
+void TestConnectivityIncremental::compareRemoveLast()
+{
+    ConnectivitySettings settings;
+    setup(settings);
+    settings.append(m_lTrials.mid(0, m_iWindowSize));
+    Coherence::calculate(settings);
+
+    settings.removeLast(m_iHopSize);
+    QCOMPARE(settings.size(), m_iWindowSize - m_iHopSize);
+
+    MatrixXd matIncremental = Coherence::calculate(settings).getFullConnectivityMatrix(false);
+    MatrixXd matFull = calculateFull(&Coherence::calculate, 0, m_iWindowSize - m_iHopSize);
+
+    QVERIFY((matIncremental - matFull).cwiseAbs().maxCoeff() < m_dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestConnectivityIncremental::cleanupTestCase()
+{
+    AbstractMetric::m_bStorageModeIsActive = false;
+}
+
+//=============================================================================================================
+
+void TestConnectivityIncremental::compareSlidingWindow(CalculateFunc calculate)
+{
+    ConnectivitySettings settings;
+    setup(settings);
+    settings.append(m_lTrials.mid(0, m_iWindowSize));
+
+    MatrixXd matIncremental = calculate(settings).getFullConnectivityMatrix(false);
+    QVERIFY((matIncremental - calculateFull(calculate, 0, m_iWindowSize)).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    // Only the new trials are transformed, the leaving ones are subtracted from the sums
+    for(int iFirst = m_iHopSize; iFirst + m_iWindowSize <= m_lTrials.size(); iFirst += m_iHopSize) {
+        settings.removeFirst(m_iHopSize);
+        settings.append(m_lTrials.mid(iFirst + m_iWindowSize - m_iHopSize, m_iHopSize));
+        QCOMPARE(settings.size(), m_iWindowSize);
+
+        matIncremental = calculate(settings).getFullConnectivityMatrix(false);
+        MatrixXd matFull = calculateFull(calculate, iFirst, m_iWindowSize);
+
+        QVERIFY(matFull.cwiseAbs().maxCoeff() > 0.0);
+        QVERIFY((matIncremental - matFull).cwiseAbs().maxCoeff() < m_dEpsilon);
+    }
+}
+
+//=============================================================================================================
+
+MatrixXd TestConnectivityIncremental::calculateFull(CalculateFunc calculate,
+                                                    int iFirstTrial,
+                                                    int iNumberTrials)
+{
+    ConnectivitySettings settings;
+    setup(settings);
+    settings.append(m_lTrials.mid(iFirstTrial, iNumberTrials));
+
+    return calculate(settings).getFullConnectivityMatrix(false);
+}
+
+//=============================================================================================================
+
+void TestConnectivityIncremental::setup(ConnectivitySettings& settings) const
+{
+    settings.setSamplingFrequency(256);
+    settings.setFFTSize(m_iNumberSamples);
+    settings.setWindowType("hanning");
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestConnectivityIncremental)
+#include "test_connectivity_incremental.moc"
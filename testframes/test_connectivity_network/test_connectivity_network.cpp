@@ -0,0 +1,340 @@
+//=============================================================================================================
+/**
+ * @file     test_connectivity_network.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the packed Network storage against a dense reference and the edge list path.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <connectivity/network/network.h>
+#include <connectivity/network/networkedge.h>
+#include <connectivity/network/networknode.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace CONNECTIVITYLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestConnectivityNetwork
+ *
+ * @brief The TestConnectivityNetwork class compares the packed pair storage of Network with a dense reference
+ *        and with networks built edge by edge.
+ *
+ */
+class TestConnectivityNetwork: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestConnectivityNetwork();
+
+private slots:
+    void initTestCase();
+    void compareFullMatrix();
+    void compareThresholded();
+    void compareEdgeView();
+    void compareEdgeList();
+    void compareCopies();
+    void cleanupTestCase();
+
+private:
+    Network createPackedNetwork() const;
+    Network createEdgeListNetwork(double dThreshold) const;
+
+    double              m_dEpsilon;
+    int                 m_iNumberNodes;
+    int                 m_iNumberBins;
+    double              m_dThreshold;
+    QList<MatrixXd>     m_lBinWeights;
+    MatrixXd            m_matWeights;
+};
+
+//=============================================================================================================
+
+TestConnectivityNetwork::TestConnectivityNetwork()
+: m_dEpsilon(1e-12)
+, m_iNumberNodes(40)
+, m_iNumberBins(5)
+, m_dThreshold(0.5)
+{
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(42);
+
+    // Symmetric weights per frequency bin, the averaged weights are the dense reference
+    m_matWeights = MatrixXd::Zero(m_iNumberNodes, m_iNumberNodes);
+
+    for(int b = 0; b < m_iNumberBins; ++b) {
+        MatrixXd matBin = MatrixXd::Random(m_iNumberNodes, m_iNumberNodes).cwiseAbs();
+        matBin = 0.5 * (matBin + matBin.transpose()).eval();
+        matBin.diagonal().setZero();
+
+        m_lBinWeights << matBin;
+        m_matWeights += matBin / m_iNumberBins;
+    }
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareFullMatrix()
+{
+    Network network = createPackedNetwork();
+
+    QCOMPARE(network.getNumberNodes(), m_iNumberNodes);
+    QVERIFY((network.getFullConnectivityMatrix(true) - m_matWeights).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    // The unmirrored matrix keeps the upper triangle only
+    MatrixXd matUpper = m_matWeights.triangularView<StrictlyUpper>();
+    QVERIFY((network.getFullConnectivityMatrix(false) - matUpper).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        QCOMPARE(int(network.getFullDegree(i)), m_iNumberNodes - 1);
+    }
+
+    QVERIFY(qAbs(network.getMinMaxFullWeights().second - m_matWeights.maxCoeff()) < m_dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareThresholded()
+{
+    Network network = createPackedNetwork();
+    network.setThreshold(m_dThreshold);
+
+    MatrixXd matRef = (m_matWeights.array() >= m_dThreshold).select(m_matWeights, 0.0);
+    matRef.diagonal().setZero();
+
+    QVERIFY((network.getThresholdedConnectivityMatrix(true) - matRef).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    int iNumberEdges = 0;
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        int iDegree = 0;
+
+        for(int j = 0; j < m_iNumberNodes; ++j) {
+            if(i != j && m_matWeights(i,j) >= m_dThreshold) {
+                ++iDegree;
+            }
+        }
+
+        QCOMPARE(int(network.getThresholdedDegree(i)), iDegree);
+        QCOMPARE(int(network.getNodes().at(i)->getThresholdedDegree()), iDegree);
+        iNumberEdges += iDegree;
+    }
+
+    QCOMPARE(network.getThresholdedEdges().size(), iNumberEdges / 2);
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareEdgeView()
+{
+    Network network = createPackedNetwork();
+
+    QCOMPARE(network.getFullEdges().size(), m_iNumberNodes * (m_iNumberNodes - 1) / 2);
+
+    for(const NetworkEdge::SPtr& pEdge : network.getFullEdges()) {
+        const int i = pEdge->getStartNodeID();
+        const int j = pEdge->getEndNodeID();
+
+        QVERIFY(i < j);
+        QVERIFY(qAbs(pEdge->getWeight() - m_matWeights(i,j)) < m_dEpsilon);
+        QCOMPARE(int(pEdge->getMatrixWeight().rows()), m_iNumberBins);
+        QVERIFY(qAbs(pEdge->getMatrixWeight()(m_iNumberBins - 1, 0) - m_lBinWeights.last()(i,j)) < m_dEpsilon);
+    }
+
+    for(const NetworkNode::SPtr& pNode : network.getNodes()) {
+        QCOMPARE(pNode->getFullEdges().size(), m_iNumberNodes - 1);
+    }
+
+    // The single edge and node getters create the same objects as the list getters
+    const QList<NetworkEdge::SPtr> lEdges = network.getFullEdges();
+
+    for(int k = 0; k < lEdges.size(); k += 97) {
+        QCOMPARE(network.getEdgeAt(k)->getStartNodeID(), lEdges.at(k)->getStartNodeID());
+        QCOMPARE(network.getEdgeAt(k)->getEndNodeID(), lEdges.at(k)->getEndNodeID());
+        QCOMPARE(network.getEdgeAt(k)->getWeight(), lEdges.at(k)->getWeight());
+    }
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        QCOMPARE(int(network.getNodeAt(i)->getFullDegree()), m_iNumberNodes - 1);
+        QVERIFY(qAbs(network.getNodeAt(i)->getFullStrength() - m_matWeights.row(i).sum()) < 1e-9);
+    }
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareEdgeList()
+{
+    Network packed = createPackedNetwork();
+    packed.setThreshold(m_dThreshold);
+
+    // Appending edges one by one updates the adjacency incrementally, compare it before any full update
+    Network edgeList = createEdgeListNetwork(m_dThreshold);
+
+    QVERIFY((packed.getFullConnectivityMatrix(true) - edgeList.getFullConnectivityMatrix(true)).cwiseAbs().maxCoeff() < m_dEpsilon);
+    QVERIFY((packed.getThresholdedConnectivityMatrix(true) - edgeList.getThresholdedConnectivityMatrix(true)).cwiseAbs().maxCoeff() < m_dEpsilon);
+    QCOMPARE(packed.getThresholdedEdges().size(), edgeList.getThresholdedEdges().size());
+    QCOMPARE(packed.getMinMaxThresholdedDegrees(), edgeList.getMinMaxThresholdedDegrees());
+    QVERIFY(qAbs(packed.getMinMaxFullWeights().first - edgeList.getMinMaxFullWeights().first) < m_dEpsilon);
+    QVERIFY(qAbs(packed.getMinMaxFullWeights().second - edgeList.getMinMaxFullWeights().second) < m_dEpsilon);
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        QCOMPARE(packed.getFullDegree(i), edgeList.getFullDegree(i));
+        QCOMPARE(packed.getThresholdedDegree(i), edgeList.getThresholdedDegree(i));
+    }
+
+    // Edges appended from the higher to the lower node ID keep their direction
+    const QList<NetworkNode::SPtr> lNodes = edgeList.getNodes();
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        QCOMPARE(lNodes.at(i)->getFullEdgesOut().size(), i);
+        QCOMPARE(lNodes.at(i)->getFullEdgesIn().size(), m_iNumberNodes - 1 - i);
+    }
+
+    // A full update must give the same adjacency as the incremental one
+    edgeList.setThreshold(m_dThreshold);
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        QCOMPARE(packed.getThresholdedDegree(i), edgeList.getThresholdedDegree(i));
+    }
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareCopies()
+{
+    Network network = createPackedNetwork();
+    Network copy = network;
+
+    copy.setThreshold(m_dThreshold);
+
+    // The copy must not change the edges assigned to the nodes of the original network
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        QCOMPARE(int(network.getNodes().at(i)->getThresholdedDegree()), m_iNumberNodes - 1);
+        QCOMPARE(copy.getNodes().at(i)->getThresholdedDegree(), copy.getThresholdedDegree(i));
+    }
+
+    QCOMPARE(network.getThresholdedEdges().size(), network.getFullEdges().size());
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+Network TestConnectivityNetwork::createPackedNetwork() const
+{
+    Network network("Test", 0.0);
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        network.append(NetworkNode::SPtr(new NetworkNode(i, RowVectorXf::Zero(3))));
+    }
+
+    network.initPairWeights(m_iNumberBins);
+
+    VectorXd vecWeight(m_iNumberBins);
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        for(int j = i; j < m_iNumberNodes; ++j) {
+            for(int b = 0; b < m_iNumberBins; ++b) {
+                vecWeight[b] = m_lBinWeights.at(b)(i,j);
+            }
+
+            network.setPairWeight(i, j, vecWeight);
+        }
+    }
+
+    network.finishPairWeights();
+
+    return network;
+}
+
+//=============================================================================================================
+
+Network TestConnectivityNetwork::createEdgeListNetwork(double dThreshold) const
+{
+    Network network("Test", dThreshold);
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        network.append(NetworkNode::SPtr(new NetworkNode(i, RowVectorXf::Zero(3))));
+    }
+
+    MatrixXd matWeight(m_iNumberBins, 1);
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        for(int j = 0; j < i; ++j) {
+            for(int b = 0; b < m_iNumberBins; ++b) {
+                matWeight(b,0) = m_lBinWeights.at(b)(i,j);
+            }
+
+            network.append(NetworkEdge::SPtr(new NetworkEdge(i, j, matWeight)));
+        }
+    }
+
+    return network;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestConnectivityNetwork)
+#include "test_connectivity_network.moc"
@@ -0,0 +1,346 @@
+//=============================================================================================================
+/**
+ * @file     test_fiff_compressed_buffer.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the compressed raw data buffer codec and compressed raw files.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <fiff/fiff.h>
+#include <fiff/fiff_compressed_buffer.h>
+
+#include <cstring>
+#include <limits>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtEndian>
+#include <QtTest>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFiffCompressedBuffer
+ *
+ * @brief The TestFiffCompressedBuffer class checks that compressed raw data buffers decode bit exactly, both
+ *        through the codec directly and through files written with write_compressed_raw_buffer.
+ *
+ */
+class TestFiffCompressedBuffer : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFiffCompressedBuffer();
+
+private slots:
+    void initTestCase();
+    void compareCodec_data();
+    void compareCodec();
+    void compareCorruptPayload();
+    void compareRawFile_data();
+    void compareRawFile();
+    void cleanupTestCase();
+
+private:
+    template<typename T>
+    QByteArray createSamples(qint32 nchan, qint32 nsamp) const;
+    bool writeRaw(const QString& sFileName, fiff_int_t iDataType, bool bCompressed);
+    void compareSamples(const MatrixXd& dataCompressed,
+                        const MatrixXd& dataPlain,
+                        fiff_int_t iDataType,
+                        const RowVectorXd& vecCals) const;
+
+    QTemporaryDir   m_tempDir;
+    FiffRawData     m_rawIn;
+    RowVectorXd     m_vecCals;
+};
+
+//=============================================================================================================
+
+TestFiffCompressedBuffer::TestFiffCompressedBuffer()
+{
+}
+
+//=============================================================================================================
+
+void TestFiffCompressedBuffer::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QVERIFY(m_tempDir.isValid());
+
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    m_rawIn = FiffRawData(t_fileIn);
+    QVERIFY(m_rawIn.info.nchan > 0);
+
+    std::srand(42);
+}
+
+//=============================================================================================================
+
+void TestFiffCompressedBuffer::compareCodec_data()
+{
+    QTest::addColumn<int>("iType");
+    QTest::addColumn<int>("nchan");
+    QTest::addColumn<int>("nsamp");
+
+    QTest::newRow("short") << int(FIFFT_SHORT) << 7 << 301;
+    QTest::newRow("dau_pack16") << int(FIFFT_DAU_PACK16) << 5 << 64;
+    QTest::newRow("int") << int(FIFFT_INT) << 11 << 257;
+    QTest::newRow("float") << int(FIFFT_FLOAT) << 13 << 199;
+    QTest::newRow("single sample") << int(FIFFT_FLOAT) << 3 << 1;
+    QTest::newRow("empty") << int(FIFFT_INT) << 4 << 0;
+}
+
+//=============================================================================================================
+
+void TestFiffCompressedBuffer::compareCodec()
+{
+    QFETCH(int, iType);
+    QFETCH(int, nchan);
+    QFETCH(int, nsamp);
+
+    QByteArray baSamples;
+    switch(iType) {
+        case FIFFT_SHORT:
+        case FIFFT_DAU_PACK16:
+            baSamples = createSamples<qint16>(nchan, nsamp);
+            break;
+        case FIFFT_INT:
+            baSamples = createSamples<qint32>(nchan, nsamp);
+            break;
+        default:
+            baSamples = createSamples<float>(nchan, nsamp);
+    }
+
+    QByteArray baPayload = FiffCompressedBuffer::compress(baSamples.constData(), iType, nchan, nsamp);
+    QVERIFY(baPayload.size() >= FiffCompressedBuffer::HEADER_SIZE);
+
+    fiff_int_t iTypeHeader = 0;
+    qint32 nchanHeader = 0, nsampHeader = 0;
+    QVERIFY(FiffCompressedBuffer::readHeader(baPayload.constData(), baPayload.size(), iTypeHeader, nchanHeader, nsampHeader));
+    QCOMPARE(iTypeHeader, iType);
+    QCOMPARE(nchanHeader, nchan);
+    QCOMPARE(nsampHeader, nsamp);
+
+    QByteArray baDecoded;
+    fiff_int_t iTypeOut = 0;
+    qint32 nchanOut = 0, nsampOut = 0;
+    QVERIFY(FiffCompressedBuffer::uncompress(baPayload.constData(), baPayload.size(), baDecoded, iTypeOut, nchanOut, nsampOut));
+    QCOMPARE(iTypeOut, iType);
+    QCOMPARE(nchanOut, nchan);
+    QCOMPARE(nsampOut, nsamp);
+
+    // Bit exact, including the extreme integer values and the NaN/inf patterns
+    QCOMPARE(baDecoded.size(), baSamples.size());
+    QVERIFY(memcmp(baDecoded.constData(), baSamples.constData(), baSamples.size()) == 0);
+}
+
+//=============================================================================================================
+
+void TestFiffCompressedBuffer::compareCorruptPayload()
+{
+    const qint32 nchan = 4, nsamp = 100;
+    QByteArray baSamples = createSamples<qint32>(nchan, nsamp);
+    QByteArray baPayload = FiffCompressedBuffer::compress(baSamples.constData(), FIFFT_INT, nchan, nsamp);
+
+    QByteArray baDecoded;
+    fiff_int_t iType;
+    qint32 nchanOut, nsampOut;
+
+    // Truncated header and truncated zlib stream
+    QVERIFY(!FiffCompressedBuffer::uncompress(baPayload.constData(), FiffCompressedBuffer::HEADER_SIZE - 1, baDecoded, iType, nchanOut, nsampOut));
+    QVERIFY(!FiffCompressedBuffer::uncompress(baPayload.constData(), baPayload.size() - 8, baDecoded, iType, nchanOut, nsampOut));
+
+    // Header which does not match the compressed samples
+    QByteArray baWrongSize = baPayload;
+    qToBigEndian<qint32>(nsamp + 1, reinterpret_cast<uchar*>(baWrongSize.data()) + 12);
+    QVERIFY(!FiffCompressedBuffer::uncompress(baWrongSize.constData(), baWrongSize.size(), baDecoded, iType, nchanOut, nsampOut));
+
+    // Unsupported sample types are not compressed
+    QVERIFY(!FiffCompressedBuffer::isSupportedType(FIFFT_DOUBLE));
+    QVERIFY(FiffCompressedBuffer::compress(baSamples.constData(), FIFFT_DOUBLE, nchan, nsamp / 2).isEmpty());
+}
+
+//=============================================================================================================
+
+void TestFiffCompressedBuffer::compareRawFile_data()
+{
+    QTest::addColumn<int>("iType");
+
+    QTest::newRow("float") << int(FIFFT_FLOAT);
+    QTest::newRow("int") << int(FIFFT_INT);
+}
+
+//=============================================================================================================
+
+void TestFiffCompressedBuffer::compareRawFile()
+{
+    QFETCH(int, iType);
+
+    const QString sPlainFile = m_tempDir.filePath(QString("plain_%1_raw.fif").arg(iType));
+    const QString sCompressedFile = m_tempDir.filePath(QString("compressed_%1_raw.fif").arg(iType));
+    QVERIFY(writeRaw(sPlainFile, iType, false));
+    QVERIFY(writeRaw(sCompressedFile, iType, true));
+
+    // The compressed file stores the same samples as the plain float one, integers are rounded in calibrated units
+    QFile t_filePlain(sPlainFile);
+    FiffRawData rawPlain(t_filePlain);
+    QFile t_fileCompressed(sCompressedFile);
+    FiffRawData rawCompressed(t_fileCompressed);
+
+    QCOMPARE(rawCompressed.first_samp, rawPlain.first_samp);
+    QCOMPARE(rawCompressed.last_samp, rawPlain.last_samp);
+    QCOMPARE(rawCompressed.rawdir.size(), rawPlain.rawdir.size());
+    QVERIFY(QFileInfo(sCompressedFile).size() < QFileInfo(sPlainFile).size());
+
+    MatrixXd dataPlain, dataCompressed, times;
+    QVERIFY(rawPlain.read_raw_segment(dataPlain, times));
+    QVERIFY(rawCompressed.read_raw_segment(dataCompressed, times));
+    compareSamples(dataCompressed, dataPlain, iType, m_vecCals);
+
+    // Random access within and across buffers
+    fiff_int_t from = rawPlain.first_samp + 1234;
+    fiff_int_t to = from + 2 * rawPlain.rawdir.first().nsamp + 17;
+    RowVectorXi sel(2);
+    sel << 0, rawPlain.info.nchan - 1;
+    RowVectorXd vecSelCals(2);
+    vecSelCals << m_vecCals(0), m_vecCals(rawPlain.info.nchan - 1);
+    QVERIFY(rawPlain.read_raw_segment(dataPlain, times, from, to, sel));
+    QVERIFY(rawCompressed.read_raw_segment(dataCompressed, times, from, to, sel));
+    compareSamples(dataCompressed, dataPlain, iType, vecSelCals);
+}
+
+//=============================================================================================================
+
+void TestFiffCompressedBuffer::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+template<typename T>
+QByteArray TestFiffCompressedBuffer::createSamples(qint32 nchan, qint32 nsamp) const
+{
+    // Slowly varying channels with a few extreme values, channels running fastest
+    QVector<T> vecSamples(nchan * nsamp);
+    for(qint32 s = 0; s < nsamp; ++s) {
+        for(qint32 c = 0; c < nchan; ++c) {
+            double dValue = 100.0 * (c + 1) * std::sin(0.05 * s + c) + (std::rand() % 7) - 3;
+            vecSamples[s * nchan + c] = static_cast<T>(dValue);
+        }
+    }
+
+    if(vecSamples.size() >= 4) {
+        vecSamples[0] = std::numeric_limits<T>::max();
+        vecSamples[1] = std::numeric_limits<T>::lowest();
+        vecSamples[2] = std::numeric_limits<T>::has_quiet_NaN ? std::numeric_limits<T>::quiet_NaN() : T(0);
+        vecSamples[3] = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : T(-1);
+    }
+
+    return QByteArray(reinterpret_cast<const char*>(vecSamples.constData()), vecSamples.size() * int(sizeof(T)));
+}
+
+//=============================================================================================================
+
+bool TestFiffCompressedBuffer::writeRaw(const QString& sFileName, fiff_int_t iDataType, bool bCompressed)
+{
+    QFile t_fileOut(sFileName);
+    FiffStream::SPtr outfid = FiffStream::start_writing_raw(t_fileOut, m_rawIn.info, m_vecCals);
+    if(!outfid) {
+        return false;
+    }
+
+    fiff_int_t from = m_rawIn.first_samp;
+    outfid->write_int(FIFF_FIRST_SAMPLE, &from);
+
+    fiff_int_t quantum = static_cast<fiff_int_t>(ceil(m_rawIn.info.sfreq));
+    MatrixXd data, times;
+    for(fiff_int_t first = from; first <= m_rawIn.last_samp; first += quantum) {
+        fiff_int_t last = qMin(m_rawIn.last_samp, first + quantum - 1);
+        if(!m_rawIn.read_raw_segment(data, times, first, last)) {
+            return false;
+        }
+
+        bool bWritten = bCompressed ? outfid->write_compressed_raw_buffer(data, m_vecCals, iDataType)
+                                    : outfid->write_raw_buffer(data, m_vecCals);
+        if(!bWritten) {
+            return false;
+        }
+    }
+
+    outfid->finish_writing_raw();
+
+    return true;
+}
+
+//=============================================================================================================
+
+void TestFiffCompressedBuffer::compareSamples(const MatrixXd& dataCompressed,
+                                              const MatrixXd& dataPlain,
+                                              fiff_int_t iDataType,
+                                              const RowVectorXd& vecCals) const
+{
+    QCOMPARE(dataCompressed.rows(), dataPlain.rows());
+    QCOMPARE(dataCompressed.cols(), dataPlain.cols());
+
+    if(iDataType == FIFFT_FLOAT) {
+        QVERIFY(dataCompressed == dataPlain);
+        return;
+    }
+
+    // Rounding to integers moves a sample by at most half a calibration step, the plain file adds float precision
+    for(int i = 0; i < dataPlain.rows(); ++i) {
+        ArrayXXd vecError = (dataCompressed.row(i) - dataPlain.row(i)).array().abs() - 1e-6 * dataPlain.row(i).array().abs();
+        QVERIFY(vecError.maxCoeff() <= 0.5 * std::fabs(vecCals(i)));
+    }
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFiffCompressedBuffer)
+#include "test_fiff_compressed_buffer.moc"
@@ -0,0 +1,342 @@
+//=============================================================================================================
+/**
+ * @file     test_fiff_make_dir.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the header-only tag directory scan and the tag buffer reuse of FiffStream.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <fiff/fiff.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QBuffer>
+#include <QtTest>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFiffMakeDir
+ *
+ * @brief The TestFiffMakeDir class compares the header-only directory scan of FiffStream::make_dir with a scan
+ *        which reads every tag through read_tag_info, and checks that read_tag_into keeps the tag buffer.
+ *
+ */
+class TestFiffMakeDir : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFiffMakeDir();
+
+private slots:
+    void initTestCase();
+    void compareScan_data();
+    void compareScan();
+    void compareTagReuse();
+    void cleanupTestCase();
+
+private:
+    bool writeRaw(const QString& sFileName, fiff_int_t iNumberSamples);
+    bool writeNonSequential(const QString& sFileName);
+    static QList<FiffDirEntry::SPtr> referenceScan(FiffStream& stream);
+
+    QTemporaryDir   m_tempDir;
+    FiffRawData     m_rawIn;
+    QString         m_sRawFileName;
+    QString         m_sNonSequentialFileName;
+};
+
+//=============================================================================================================
+
+TestFiffMakeDir::TestFiffMakeDir()
+{
+}
+
+//=============================================================================================================
+
+void TestFiffMakeDir::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QVERIFY(m_tempDir.isValid());
+
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    m_rawIn = FiffRawData(t_fileIn);
+    QVERIFY(m_rawIn.info.nchan > 0);
+
+    // Files written by start_writing_raw have no tag directory, the last buffer is shorter than the others
+    m_sRawFileName = m_tempDir.filePath("nodir_raw.fif");
+    QVERIFY(writeRaw(m_sRawFileName, static_cast<fiff_int_t>(3.5 * m_rawIn.info.sfreq)));
+
+    m_sNonSequentialFileName = m_tempDir.filePath("nonsequential.fif");
+    QVERIFY(writeNonSequential(m_sNonSequentialFileName));
+}
+
+//=============================================================================================================
+
+void TestFiffMakeDir::compareScan_data()
+{
+    QTest::addColumn<QString>("sFileName");
+    QTest::addColumn<bool>("bBuffer");
+
+    // Files are scanned through a memory mapping, other devices through reads of the headers
+    QTest::newRow("raw file") << m_sRawFileName << false;
+    QTest::newRow("raw buffer") << m_sRawFileName << true;
+    QTest::newRow("non-sequential file") << m_sNonSequentialFileName << false;
+    QTest::newRow("non-sequential buffer") << m_sNonSequentialFileName << true;
+}
+
+//=============================================================================================================
+
+void TestFiffMakeDir::compareScan()
+{
+    QFETCH(QString, sFileName);
+    QFETCH(bool, bBuffer);
+
+    QFile t_file(sFileName);
+    QVERIFY(t_file.open(QIODevice::ReadOnly));
+
+    QByteArray baFile;
+    QBuffer t_buffer(&baFile);
+    QIODevice* pDevice = &t_file;
+    if(bBuffer) {
+        baFile = t_file.readAll();
+        t_file.close();
+        QVERIFY(t_buffer.open(QIODevice::ReadOnly));
+        pDevice = &t_buffer;
+    }
+
+    FiffStream stream(pDevice);
+
+    bool ok = false;
+    QList<FiffDirEntry::SPtr> dirScanned = stream.make_dir(&ok);
+    QVERIFY(ok);
+
+    QList<FiffDirEntry::SPtr> dirReference = referenceScan(stream);
+
+    QVERIFY(dirReference.size() > 3);
+    QCOMPARE(dirScanned.size(), dirReference.size());
+    for(int i = 0; i < dirReference.size(); ++i) {
+        QCOMPARE(dirScanned[i]->kind, dirReference[i]->kind);
+        QCOMPARE(dirScanned[i]->type, dirReference[i]->type);
+        QCOMPARE(dirScanned[i]->size, dirReference[i]->size);
+        QCOMPARE(dirScanned[i]->pos, dirReference[i]->pos);
+    }
+}
+
+//=============================================================================================================
+
+void TestFiffMakeDir::compareTagReuse()
+{
+    QFile t_file(m_sRawFileName);
+    FiffStream stream(&t_file);
+    QVERIFY(stream.open());
+
+    // Raw data buffers of two sizes and the small int tags around them
+    QList<FiffDirEntry::SPtr> lEntries;
+    fiff_int_t iMaxSize = 0;
+    for(const FiffDirEntry::SPtr& pEntry : stream.dir()) {
+        if(pEntry->kind == FIFF_DATA_BUFFER || pEntry->kind == FIFF_FIRST_SAMPLE) {
+            lEntries.append(pEntry);
+            iMaxSize = qMax(iMaxSize, pEntry->size);
+        }
+    }
+    QVERIFY(lEntries.size() > 3);
+    QVERIFY(lEntries.first()->size != lEntries.last()->size);
+
+    // Grow the buffer with the largest tag, all following reads have to stay in it
+    FiffTag::SPtr t_pTag;
+    for(const FiffDirEntry::SPtr& pEntry : lEntries) {
+        if(pEntry->size == iMaxSize) {
+            QVERIFY(stream.read_tag_into(t_pTag, pEntry->pos));
+            break;
+        }
+    }
+    QVERIFY(t_pTag);
+
+    const FiffTag* pTag = t_pTag.data();
+    const char* pData = t_pTag->constData();
+    const int iCapacity = t_pTag->capacity();
+    QVERIFY(iCapacity >= iMaxSize);
+
+    for(const FiffDirEntry::SPtr& pEntry : lEntries) {
+        QVERIFY(stream.read_tag_into(t_pTag, pEntry->pos));
+
+        QVERIFY(t_pTag.data() == pTag);
+        QVERIFY(t_pTag->constData() == pData);
+        QCOMPARE(t_pTag->capacity(), iCapacity);
+
+        FiffTag::SPtr t_pTagRead;
+        QVERIFY(stream.read_tag(t_pTagRead, pEntry->pos));
+
+        QCOMPARE(t_pTag->kind, t_pTagRead->kind);
+        QCOMPARE(t_pTag->type, t_pTagRead->type);
+        QCOMPARE(t_pTag->size(), t_pTagRead->size());
+        QCOMPARE(t_pTag->size(), pEntry->size);
+        QVERIFY(static_cast<const QByteArray&>(*t_pTag) == static_cast<const QByteArray&>(*t_pTagRead));
+    }
+
+    stream.close();
+}
+
+//=============================================================================================================
+
+void TestFiffMakeDir::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+bool TestFiffMakeDir::writeRaw(const QString& sFileName, fiff_int_t iNumberSamples)
+{
+    QFile t_fileOut(sFileName);
+    RowVectorXd vCals;
+    FiffStream::SPtr outfid = FiffStream::start_writing_raw(t_fileOut, m_rawIn.info, vCals);
+    if(!outfid) {
+        return false;
+    }
+
+    fiff_int_t from = m_rawIn.first_samp;
+    fiff_int_t to = qMin(m_rawIn.last_samp, from + iNumberSamples - 1);
+    outfid->write_int(FIFF_FIRST_SAMPLE, &from);
+
+    fiff_int_t quantum = static_cast<fiff_int_t>(ceil(m_rawIn.info.sfreq));
+    MatrixXd data, times;
+    for(fiff_int_t first = from; first <= to; first += quantum) {
+        fiff_int_t last = qMin(to, first + quantum - 1);
+        if(!m_rawIn.read_raw_segment(data, times, first, last)) {
+            return false;
+        }
+        outfid->write_raw_buffer(data, vCals);
+    }
+
+    outfid->finish_writing_raw();
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool TestFiffMakeDir::writeNonSequential(const QString& sFileName)
+{
+    QFile t_fileOut(sFileName);
+    if(!t_fileOut.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    FiffStream stream(&t_fileOut);
+
+    fiff_int_t iNullPointer = -1;
+    stream.write_id(FIFF_FILE_ID);
+    stream.write_int(FIFF_DIR_POINTER, &iNullPointer);
+    stream.write_int(FIFF_FREE_LIST, &iNullPointer);
+    stream.start_block(FIFFB_MEAS);
+
+    // A tag which points past a gap, the scan has to follow next instead of the size
+    const int iGapSize = 40;
+    const fiff_int_t iFirstSample = 25;
+    const fiff_int_t iNext = static_cast<fiff_int_t>(t_fileOut.pos()) + 4 * sizeof(fiff_int_t) + sizeof(fiff_int_t) + iGapSize;
+    stream.write_int(FIFF_FIRST_SAMPLE, &iFirstSample, 1, iNext);
+    t_fileOut.write(QByteArray(iGapSize, static_cast<char>(0xAB)));
+
+    const float pValues[7] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+    stream.write_float(FIFF_SFREQ, pValues, 7);
+    stream.write_string(FIFF_COMMENT, QString("make_dir test"));
+    stream.write_float(FIFF_LOWPASS, pValues, 1);
+
+    stream.end_block(FIFFB_MEAS);
+    stream.end_file();
+
+    t_fileOut.close();
+
+    return t_fileOut.error() == QFile::NoError;
+}
+
+//=============================================================================================================
+
+QList<FiffDirEntry::SPtr> TestFiffMakeDir::referenceScan(FiffStream& stream)
+{
+    // The previous scan, which reads every tag through read_tag_info
+    QList<FiffDirEntry::SPtr> dir;
+    FiffDirEntry::SPtr t_pFiffDirEntry;
+
+    if(!stream.device()->seek(0)) {
+        return dir;
+    }
+
+    const fiff_long_t iFileSize = stream.device()->size();
+    FiffTag::SPtr t_pTag;
+    fiff_long_t pos;
+    while (stream.device()->pos() + 16 <= iFileSize && (pos = stream.read_tag_info(t_pTag)) != -1) {
+        if (t_pTag->kind == FIFF_DIR)
+            break;
+
+        t_pFiffDirEntry = FiffDirEntry::SPtr(new FiffDirEntry);
+        t_pFiffDirEntry->kind = t_pTag->kind;
+        t_pFiffDirEntry->type = t_pTag->type;
+        t_pFiffDirEntry->size = t_pTag->size();
+        t_pFiffDirEntry->pos = pos;
+        dir.append(t_pFiffDirEntry);
+
+        if (t_pTag->next < 0)
+            break;
+    }
+
+    t_pFiffDirEntry = FiffDirEntry::SPtr(new FiffDirEntry);
+    t_pFiffDirEntry->kind = -1;
+    t_pFiffDirEntry->type = -1;
+    t_pFiffDirEntry->size = -1;
+    t_pFiffDirEntry->pos  = -1;
+    dir.append(t_pFiffDirEntry);
+
+    return dir;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFiffMakeDir)
+#include "test_fiff_make_dir.moc"
@@ -0,0 +1,258 @@
+//=============================================================================================================
+/**
+ * @file     test_fiff_raw_data_set.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for reading split raw recordings through FiffRawDataSet.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <fiff/fiff.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFiffRawDataSet
+ *
+ * @brief The TestFiffRawDataSet class writes a recording once as a single file and once split in two parts and
+ *        compares segments read from the split set against the single file.
+ *
+ */
+class TestFiffRawDataSet : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFiffRawDataSet();
+
+private slots:
+    void initTestCase();
+    void compareSplitFiles();
+    void compareRange();
+    void compareSegments();
+    void cleanupTestCase();
+
+private:
+    bool writeRaw(const QString& sFileName,
+                  fiff_int_t from,
+                  fiff_int_t to,
+                  const QString& sNextFile = QString());
+    void compareSegment(const FiffRawDataSet& rawSet,
+                        fiff_int_t from,
+                        fiff_int_t to,
+                        const RowVectorXi& sel = RowVectorXi());
+
+    double          dEpsilon;
+    QTemporaryDir   m_tempDir;
+    FiffRawData     m_rawIn;
+    FiffRawData     m_rawSingle;
+    QString         m_sSingleFile;
+    QString         m_sPart1File;
+    QString         m_sPart2File;
+};
+
+//=============================================================================================================
+
+TestFiffRawDataSet::TestFiffRawDataSet()
+: dEpsilon(1e-12)
+{
+}
+
+//=============================================================================================================
+
+void TestFiffRawDataSet::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QVERIFY(m_tempDir.isValid());
+
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    m_rawIn = FiffRawData(t_fileIn);
+    QVERIFY(m_rawIn.info.nchan > 0);
+
+    m_sSingleFile = m_tempDir.filePath("single_raw.fif");
+    m_sPart1File = m_tempDir.filePath("split_raw.fif");
+    m_sPart2File = m_tempDir.filePath("split_raw-1.fif");
+
+    // Cut the second part off at an odd sample so the boundary does not fall on a buffer edge
+    fiff_int_t iSplit = m_rawIn.first_samp + (m_rawIn.last_samp - m_rawIn.first_samp) / 2 + 7;
+
+    QVERIFY(writeRaw(m_sSingleFile, m_rawIn.first_samp, m_rawIn.last_samp));
+    QVERIFY(writeRaw(m_sPart1File, m_rawIn.first_samp, iSplit - 1, QFileInfo(m_sPart2File).fileName()));
+    QVERIFY(writeRaw(m_sPart2File, iSplit, m_rawIn.last_samp));
+
+    QFile t_fileSingle(m_sSingleFile);
+    m_rawSingle = FiffRawData(t_fileSingle);
+    QVERIFY(m_rawSingle.info.nchan == m_rawIn.info.nchan);
+}
+
+//=============================================================================================================
+
+void TestFiffRawDataSet::compareSplitFiles()
+{
+    QStringList lFiles = FiffRawDataSet::findSplitFiles(m_sPart1File);
+    QCOMPARE(lFiles.size(), 2);
+    QCOMPARE(QFileInfo(lFiles[0]).fileName(), QFileInfo(m_sPart1File).fileName());
+    QCOMPARE(QFileInfo(lFiles[1]).fileName(), QFileInfo(m_sPart2File).fileName());
+
+    // The last part has no successor
+    QCOMPARE(FiffRawDataSet::findSplitFiles(m_sPart2File).size(), 1);
+}
+
+//=============================================================================================================
+
+void TestFiffRawDataSet::compareRange()
+{
+    FiffRawDataSet rawSet(m_sPart1File);
+    QVERIFY(!rawSet.isEmpty());
+    QCOMPARE(rawSet.parts().size(), 2);
+    QCOMPARE(rawSet.firstSample(), m_rawSingle.first_samp);
+    QCOMPARE(rawSet.lastSample(), m_rawSingle.last_samp);
+    QCOMPARE(rawSet.info().nchan, m_rawSingle.info.nchan);
+}
+
+//=============================================================================================================
+
+void TestFiffRawDataSet::compareSegments()
+{
+    FiffRawDataSet rawSet(m_sPart1File);
+    fiff_int_t iBoundary = rawSet.parts().last()->first_samp;
+
+    // Whole recording, cut into many chunks read in parallel
+    rawSet.setChunkSize(1000);
+    compareSegment(rawSet, -1, -1);
+
+    // Range crossing the file boundary, read as one chunk per file
+    rawSet.setChunkSize(0);
+    compareSegment(rawSet, iBoundary - 123, iBoundary + 456);
+
+    // Range inside a single part and a channel selection
+    RowVectorXi sel(3);
+    sel << 0, m_rawSingle.info.nchan / 2, m_rawSingle.info.nchan - 1;
+    compareSegment(rawSet, iBoundary + 10, iBoundary + 500, sel);
+    compareSegment(rawSet, iBoundary - 300, iBoundary + 300, sel);
+}
+
+//=============================================================================================================
+
+void TestFiffRawDataSet::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+bool TestFiffRawDataSet::writeRaw(const QString& sFileName,
+                                  fiff_int_t from,
+                                  fiff_int_t to,
+                                  const QString& sNextFile)
+{
+    QFile t_fileOut(sFileName);
+    RowVectorXd vCals;
+    FiffStream::SPtr outfid = FiffStream::start_writing_raw(t_fileOut, m_rawIn.info, vCals);
+    if(!outfid) {
+        return false;
+    }
+
+    outfid->write_int(FIFF_FIRST_SAMPLE, &from);
+
+    fiff_int_t quantum = static_cast<fiff_int_t>(ceil(m_rawIn.info.sfreq));
+    MatrixXd data, times;
+    for(fiff_int_t first = from; first <= to; first += quantum) {
+        fiff_int_t last = qMin(to, first + quantum - 1);
+        if(!m_rawIn.read_raw_segment(data, times, first, last)) {
+            return false;
+        }
+        outfid->write_raw_buffer(data, vCals);
+    }
+
+    if(sNextFile.isEmpty()) {
+        outfid->finish_writing_raw();
+        return true;
+    }
+
+    //
+    //   Point to the next part the way split files written by MNE do
+    //
+    fiff_int_t iRole = FIFFV_ROLE_NEXT_FILE;
+    outfid->end_block(FIFFB_RAW_DATA);
+    outfid->start_block(FIFFB_REF);
+    outfid->write_int(FIFF_REF_ROLE, &iRole);
+    outfid->write_string(FIFF_REF_FILE_NAME, sNextFile);
+    outfid->end_block(FIFFB_REF);
+    outfid->end_block(FIFFB_MEAS);
+    outfid->end_file();
+    outfid->close();
+
+    return true;
+}
+
+//=============================================================================================================
+
+void TestFiffRawDataSet::compareSegment(const FiffRawDataSet& rawSet,
+                                        fiff_int_t from,
+                                        fiff_int_t to,
+                                        const RowVectorXi& sel)
+{
+    MatrixXd dataSet, timesSet;
+    QVERIFY(rawSet.read_raw_segment(dataSet, timesSet, from, to, sel));
+
+    MatrixXd dataSingle, timesSingle;
+    QVERIFY(m_rawSingle.read_raw_segment(dataSingle, timesSingle, from, to, sel));
+
+    QCOMPARE(dataSet.rows(), dataSingle.rows());
+    QCOMPARE(dataSet.cols(), dataSingle.cols());
+    QVERIFY((dataSet - dataSingle).cwiseAbs().maxCoeff() <= dEpsilon * qMax(1.0, dataSingle.cwiseAbs().maxCoeff()));
+    // FiffRawData rounds the sample index to float before dividing, allow for that
+    QVERIFY((timesSet - timesSingle).cwiseAbs().maxCoeff() < 0.01 / m_rawSingle.info.sfreq);
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFiffRawDataSet)
+#include "test_fiff_raw_data_set.moc"
@@ -0,0 +1,314 @@
+//=============================================================================================================
+/**
+ * @file     test_fiff_sidecar_index.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the sidecar tag directory index of fiff files without a directory.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <fiff/fiff.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtEndian>
+#include <QtTest>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFiffSidecarIndex
+ *
+ * @brief The TestFiffSidecarIndex class opens a raw file without a tag directory with and without the sidecar
+ *        index and checks that the index is written, reused, rejected once the file changes and size bounded.
+ *
+ */
+class TestFiffSidecarIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFiffSidecarIndex();
+
+private slots:
+    void initTestCase();
+    void compareDirectory();
+    void compareRawData();
+    void compareReuse();
+    void compareStale();
+    void compareBound();
+    void cleanupTestCase();
+
+private:
+    bool writeRaw(const QString& sFileName, fiff_int_t iNumberSamples);
+    QList<FiffDirEntry::SPtr> readDirectory(const QString& sFileName) const;
+    QStringList indexFiles() const;
+
+    QTemporaryDir   m_tempDir;
+    FiffRawData     m_rawIn;
+    QString         m_sFileName;
+    QString         m_sCacheDir;
+};
+
+//=============================================================================================================
+
+TestFiffSidecarIndex::TestFiffSidecarIndex()
+{
+}
+
+//=============================================================================================================
+
+void TestFiffSidecarIndex::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QVERIFY(m_tempDir.isValid());
+
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    m_rawIn = FiffRawData(t_fileIn);
+    QVERIFY(m_rawIn.info.nchan > 0);
+
+    // Files written by start_writing_raw have no tag directory
+    m_sFileName = m_tempDir.filePath("nodir_raw.fif");
+    m_sCacheDir = m_tempDir.filePath("index");
+    QVERIFY(writeRaw(m_sFileName, 5 * static_cast<fiff_int_t>(m_rawIn.info.sfreq)));
+}
+
+//=============================================================================================================
+
+void TestFiffSidecarIndex::compareDirectory()
+{
+    FiffStream::disable_sidecar_index();
+    QList<FiffDirEntry::SPtr> dirScanned = readDirectory(m_sFileName);
+    QVERIFY(!dirScanned.isEmpty());
+    QVERIFY(indexFiles().isEmpty());
+
+    // The first open scans and writes the index, the second one reads it
+    FiffStream::enable_sidecar_index(m_sCacheDir);
+    QList<FiffDirEntry::SPtr> dirFirst = readDirectory(m_sFileName);
+    QCOMPARE(indexFiles().size(), 1);
+    QList<FiffDirEntry::SPtr> dirIndexed = readDirectory(m_sFileName);
+
+    QCOMPARE(dirFirst.size(), dirScanned.size());
+    QCOMPARE(dirIndexed.size(), dirScanned.size());
+    for(int i = 0; i < dirScanned.size(); ++i) {
+        QCOMPARE(dirIndexed[i]->kind, dirScanned[i]->kind);
+        QCOMPARE(dirIndexed[i]->type, dirScanned[i]->type);
+        QCOMPARE(dirIndexed[i]->size, dirScanned[i]->size);
+        QCOMPARE(dirIndexed[i]->pos, dirScanned[i]->pos);
+    }
+}
+
+//=============================================================================================================
+
+void TestFiffSidecarIndex::compareRawData()
+{
+    FiffStream::disable_sidecar_index();
+    QFile t_fileScanned(m_sFileName);
+    FiffRawData rawScanned(t_fileScanned);
+
+    FiffStream::enable_sidecar_index(m_sCacheDir);
+    QFile t_fileIndexed(m_sFileName);
+    FiffRawData rawIndexed(t_fileIndexed);
+
+    // The tree, measurement info and raw directory are rebuilt from the index
+    QCOMPARE(rawIndexed.info.nchan, rawScanned.info.nchan);
+    QCOMPARE(rawIndexed.info.ch_names, rawScanned.info.ch_names);
+    QCOMPARE(rawIndexed.first_samp, rawScanned.first_samp);
+    QCOMPARE(rawIndexed.last_samp, rawScanned.last_samp);
+    QCOMPARE(rawIndexed.rawdir.size(), rawScanned.rawdir.size());
+
+    MatrixXd dataScanned, dataIndexed, times;
+    QVERIFY(rawScanned.read_raw_segment(dataScanned, times));
+    QVERIFY(rawIndexed.read_raw_segment(dataIndexed, times));
+    QVERIFY(dataIndexed == dataScanned);
+}
+
+//=============================================================================================================
+
+void TestFiffSidecarIndex::compareReuse()
+{
+    FiffStream::enable_sidecar_index(m_sCacheDir);
+    QList<FiffDirEntry::SPtr> dirFull = readDirectory(m_sFileName);
+    QStringList lIndexFiles = indexFiles();
+    QCOMPARE(lIndexFiles.size(), 1);
+
+    // Mark the terminating entry in the index. A reopen which returns the mark did not rescan the file.
+    QFile indexFile(lIndexFiles.first());
+    QVERIFY(indexFile.open(QIODevice::ReadOnly));
+    QByteArray baIndex = indexFile.readAll();
+    indexFile.close();
+
+    const int iEntrySize = 3 * sizeof(qint32) + sizeof(qint64);
+    QVERIFY(baIndex.size() > dirFull.size() * iEntrySize);
+    QCOMPARE(dirFull.last()->size, -1);
+    qToBigEndian<qint32>(-7, reinterpret_cast<uchar*>(baIndex.data()) + baIndex.size() - iEntrySize + 2 * sizeof(qint32));
+
+    QVERIFY(indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(indexFile.write(baIndex), qint64(baIndex.size()));
+    indexFile.close();
+
+    QList<FiffDirEntry::SPtr> dirIndexed = readDirectory(m_sFileName);
+    QCOMPARE(dirIndexed.size(), dirFull.size());
+    QCOMPARE(dirIndexed.last()->size, -7);
+
+    // Restore a valid index for the following tests
+    QVERIFY(QFile::remove(lIndexFiles.first()));
+    QCOMPARE(readDirectory(m_sFileName).last()->size, -1);
+}
+
+//=============================================================================================================
+
+void TestFiffSidecarIndex::compareStale()
+{
+    FiffStream::enable_sidecar_index(m_sCacheDir);
+    readDirectory(m_sFileName);
+    QCOMPARE(indexFiles().size(), 1);
+
+    // A rewritten file differs in size and id, the index must not be used for it
+    QVERIFY(writeRaw(m_sFileName, 3 * static_cast<fiff_int_t>(m_rawIn.info.sfreq)));
+
+    FiffStream::disable_sidecar_index();
+    QList<FiffDirEntry::SPtr> dirScanned = readDirectory(m_sFileName);
+
+    FiffStream::enable_sidecar_index(m_sCacheDir);
+    QList<FiffDirEntry::SPtr> dirIndexed = readDirectory(m_sFileName);
+    QCOMPARE(dirIndexed.size(), dirScanned.size());
+    QCOMPARE(dirIndexed.at(dirIndexed.size() - 2)->pos, dirScanned.at(dirScanned.size() - 2)->pos);
+
+    // The index of the old file is kept until the cache exceeds its size bound
+    QCOMPARE(indexFiles().size(), 2);
+    QCOMPARE(readDirectory(m_sFileName).size(), dirScanned.size());
+}
+
+//=============================================================================================================
+
+void TestFiffSidecarIndex::compareBound()
+{
+    FiffStream::enable_sidecar_index(m_sCacheDir);
+    readDirectory(m_sFileName);
+    QVERIFY(indexFiles().size() >= 1);
+
+    // Rewriting the file creates a new index, the size bound leaves room for the newest one only
+    QVERIFY(writeRaw(m_sFileName, 4 * static_cast<fiff_int_t>(m_rawIn.info.sfreq)));
+    FiffStream::enable_sidecar_index(m_sCacheDir, 1);
+    QList<FiffDirEntry::SPtr> dirIndexed = readDirectory(m_sFileName);
+    QCOMPARE(indexFiles().size(), 1);
+
+    // The remaining index belongs to the current file
+    QList<FiffDirEntry::SPtr> dirReused = readDirectory(m_sFileName);
+    QCOMPARE(dirReused.size(), dirIndexed.size());
+    QCOMPARE(indexFiles().size(), 1);
+}
+
+//=============================================================================================================
+
+void TestFiffSidecarIndex::cleanupTestCase()
+{
+    FiffStream::disable_sidecar_index();
+}
+
+//=============================================================================================================
+
+bool TestFiffSidecarIndex::writeRaw(const QString& sFileName, fiff_int_t iNumberSamples)
+{
+    QFile t_fileOut(sFileName);
+    RowVectorXd vCals;
+    FiffStream::SPtr outfid = FiffStream::start_writing_raw(t_fileOut, m_rawIn.info, vCals);
+    if(!outfid) {
+        return false;
+    }
+
+    fiff_int_t from = m_rawIn.first_samp;
+    fiff_int_t to = qMin(m_rawIn.last_samp, from + iNumberSamples - 1);
+    outfid->write_int(FIFF_FIRST_SAMPLE, &from);
+
+    fiff_int_t quantum = static_cast<fiff_int_t>(ceil(m_rawIn.info.sfreq));
+    MatrixXd data, times;
+    for(fiff_int_t first = from; first <= to; first += quantum) {
+        fiff_int_t last = qMin(to, first + quantum - 1);
+        if(!m_rawIn.read_raw_segment(data, times, first, last)) {
+            return false;
+        }
+        outfid->write_raw_buffer(data, vCals);
+    }
+
+    outfid->finish_writing_raw();
+
+    return true;
+}
+
+//=============================================================================================================
+
+QList<FiffDirEntry::SPtr> TestFiffSidecarIndex::readDirectory(const QString& sFileName) const
+{
+    QFile t_file(sFileName);
+    FiffStream stream(&t_file);
+    if(!stream.open()) {
+        return QList<FiffDirEntry::SPtr>();
+    }
+
+    QList<FiffDirEntry::SPtr> dir = stream.dir();
+    stream.close();
+
+    return dir;
+}
+
+//=============================================================================================================
+
+QStringList TestFiffSidecarIndex::indexFiles() const
+{
+    QStringList lFiles;
+    for(const QString& sFile : QDir(m_sCacheDir).entryList(QStringList() << "*.idx", QDir::Files)) {
+        lFiles << QDir(m_sCacheDir).filePath(sFile);
+    }
+
+    return lFiles;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFiffSidecarIndex)
+#include "test_fiff_sidecar_index.moc"
@@ -50,12 +50,14 @@
 #include <mne/mne_bem.h>
 #include <mne/mne_bem_surface.h>
 #include <string>
+#include <cstring>
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QtTest>
+#include <QBuffer>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -85,6 +87,8 @@ private slots:
     void testDimensionsForInterpolation();
     void testSumOfRow();
     void testEmptyInputsForWeightMatrix();
+    void testReadWriteInterpolationMat();
+    void testInterpolateSignals();
     void cleanupTestCase();
 
 private:
@@ -248,6 +252,73 @@ void TestInterpolation::testEmptyInputsForWeightMatrix()
 
 //=============================================================================================================
 
+void TestInterpolation::testReadWriteInterpolationMat()
+{
+    QSharedPointer<MatrixXd> pDistTable = GeometryInfo::scdc(smallSurface.rr, smallSurface.neighbor_vert, vSmallSubset, 0.5);
+    QSharedPointer<SparseMatrix<float> > pWeightMatrix = Interpolation::createInterpolationMat(vSmallSubset,
+                                                                                            pDistTable,
+                                                                                            Interpolation::cubic,
+                                                                                            0.5);
+
+    QByteArray baData;
+    QBuffer buffer(&baData);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QVERIFY(Interpolation::writeInterpolationMat(buffer, *pWeightMatrix));
+    buffer.close();
+
+    // The matrix is restored exactly, including its sparsity pattern
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QSharedPointer<SparseMatrix<float> > pReadMatrix = Interpolation::readInterpolationMat(buffer);
+    buffer.close();
+
+    QVERIFY(pReadMatrix);
+    QVERIFY(pReadMatrix->rows() == pWeightMatrix->rows());
+    QVERIFY(pReadMatrix->cols() == pWeightMatrix->cols());
+    QVERIFY(pReadMatrix->nonZeros() == pWeightMatrix->nonZeros());
+    QVERIFY(MatrixXf(*pReadMatrix - *pWeightMatrix).cwiseAbs().maxCoeff() == 0.0f);
+
+    // Truncated data is rejected
+    QByteArray baTruncated = baData.left(baData.size() - 1);
+    QBuffer bufferTruncated(&baTruncated);
+    QVERIFY(bufferTruncated.open(QIODevice::ReadOnly));
+    QVERIFY(!Interpolation::readInterpolationMat(bufferTruncated));
+
+    // An outer index array that is not non-decreasing is rejected. The outer indices start after the
+    // magic, version, rows, cols and nnz fields.
+    QVERIFY(pWeightMatrix->cols() >= 2);
+    QByteArray baUnordered = baData;
+    const int iNegativeOuter = -1;
+    std::memcpy(baUnordered.data() + 5 * sizeof(qint32) + sizeof(int), &iNegativeOuter, sizeof(int));
+    QBuffer bufferUnordered(&baUnordered);
+    QVERIFY(bufferUnordered.open(QIODevice::ReadOnly));
+    QVERIFY(!Interpolation::readInterpolationMat(bufferUnordered));
+}
+
+//=============================================================================================================
+
+void TestInterpolation::testInterpolateSignals()
+{
+    QSharedPointer<MatrixXd> pDistTable = GeometryInfo::scdc(smallSurface.rr, smallSurface.neighbor_vert, vSmallSubset, 0.5);
+    QSharedPointer<SparseMatrix<float> > pWeightMatrix = Interpolation::createInterpolationMat(vSmallSubset,
+                                                                                            pDistTable,
+                                                                                            Interpolation::linear,
+                                                                                            0.5);
+
+    // A batch of frames gives the same result as interpolating frame by frame
+    MatrixXf matFrames = MatrixXf::Random(vSmallSubset.size(), 10);
+    MatrixXf matInterpolated = Interpolation::interpolateSignals(*pWeightMatrix, matFrames);
+
+    QVERIFY(matInterpolated.rows() == smallSurface.rr.rows());
+    QVERIFY(matInterpolated.cols() == matFrames.cols());
+
+    for(int i = 0; i < matFrames.cols(); ++i) {
+        VectorXf vecFrame = Interpolation::interpolateSignal(*pWeightMatrix, matFrames.col(i));
+        QVERIFY((matInterpolated.col(i) - vecFrame).cwiseAbs().maxCoeff() < 1e-5f);
+    }
+}
+
+//=============================================================================================================
+
 void TestInterpolation::cleanupTestCase()
 {
 }
@@ -0,0 +1,308 @@
+//=============================================================================================================
+/**
+ * @file     test_kmeans.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the Elkan batch phase of KMeans against the batch k-means fixed point.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/kmeans.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestKMeans
+ *
+ * @brief The TestKMeans class checks that the Elkan batch phase ends in the same fixed point as the plain batch
+ *        reassignments and that empty clusters are handled according to emptyact.
+ *
+ */
+class TestKMeans: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestKMeans();
+
+private slots:
+    void initTestCase();
+    void compareSqEuclidean();
+    void compareCityblock();
+    void compareOnline();
+    void emptySingleton();
+    void emptyDrop();
+    void cleanupTestCase();
+
+private:
+    void compareBatchFixedPoint(const VectorXi& idx,
+                                const MatrixXd& C,
+                                const VectorXd& sumD,
+                                bool bSqEuclidean);
+    void compareTruth(const VectorXi& idx);
+
+    double      m_dEpsilon;
+    int         m_iNumberClusters;
+    int         m_iNumberPoints;
+    MatrixXd    m_matX;
+    VectorXi    m_vecTruth;
+    MatrixXd    m_matDuplicates;
+};
+
+//=============================================================================================================
+
+TestKMeans::TestKMeans()
+: m_dEpsilon(1e-9)
+, m_iNumberClusters(4)
+, m_iNumberPoints(50)
+{
+}
+
+//=============================================================================================================
+
+void TestKMeans::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(42);
+
+    // Well separated blobs, every replicate of the batch phase has to find them
+    MatrixXd matCenters(m_iNumberClusters, 3);
+    matCenters << 0, 0, 0,
+                  10, 0, 0,
+                  0, 10, 0,
+                  0, 0, 10;
+
+    m_matX.resize(m_iNumberClusters * m_iNumberPoints, 3);
+    m_vecTruth.resize(m_matX.rows());
+
+    for(int c = 0; c < m_iNumberClusters; ++c) {
+        for(int i = 0; i < m_iNumberPoints; ++i) {
+            m_matX.row(c * m_iNumberPoints + i) = matCenters.row(c) + RowVector3d::Random();
+            m_vecTruth[c * m_iNumberPoints + i] = c;
+        }
+    }
+
+    // Three distinct points for four clusters: at least two seeds coincide and one cluster starts empty
+    m_matDuplicates.resize(30, 3);
+    for(int i = 0; i < m_matDuplicates.rows(); ++i) {
+        m_matDuplicates.row(i) = matCenters.row(i % 3);
+    }
+}
+
+//=============================================================================================================
+
+void TestKMeans::compareSqEuclidean()
+{
+    KMeans kMeans(QString("sqeuclidean"), QString("plus"), 3, QString("error"), false);
+
+    VectorXi idx;
+    MatrixXd C, D;
+    VectorXd sumD;
+
+    QVERIFY(kMeans.calculate(m_matX, m_iNumberClusters, idx, C, sumD, D));
+
+    compareBatchFixedPoint(idx, C, sumD, true);
+    compareTruth(idx);
+}
+
+//=============================================================================================================
+
+void TestKMeans::compareCityblock()
+{
+    KMeans kMeans(QString("cityblock"), QString("plus"), 5, QString("error"), false);
+
+    VectorXi idx;
+    MatrixXd C, D;
+    VectorXd sumD;
+
+    QVERIFY(kMeans.calculate(m_matX, m_iNumberClusters, idx, C, sumD, D));
+
+    compareBatchFixedPoint(idx, C, sumD, false);
+    compareTruth(idx);
+}
+
+//=============================================================================================================
+
+void TestKMeans::compareOnline()
+{
+    KMeans kMeans(QString("sqeuclidean"), QString("plus"), 3, QString("error"), true);
+
+    VectorXi idx;
+    MatrixXd C, D;
+    VectorXd sumD;
+
+    QVERIFY(kMeans.calculate(m_matX, m_iNumberClusters, idx, C, sumD, D));
+
+    compareBatchFixedPoint(idx, C, sumD, true);
+    compareTruth(idx);
+}
+
+//=============================================================================================================
+
+void TestKMeans::emptySingleton()
+{
+    KMeans kMeans(QString("sqeuclidean"), QString("sample"), 1, QString("singleton"), false);
+
+    VectorXi idx;
+    MatrixXd C, D;
+    VectorXd sumD;
+
+    QVERIFY(kMeans.calculate(m_matDuplicates, 4, idx, C, sumD, D));
+
+    // The empty cluster is replaced by a singleton, so every cluster keeps members
+    for(int c = 0; c < 4; ++c) {
+        QVERIFY((idx.array() == c).any());
+    }
+}
+
+//=============================================================================================================
+
+void TestKMeans::emptyDrop()
+{
+    KMeans kMeans(QString("sqeuclidean"), QString("sample"), 1, QString("drop"), false);
+
+    VectorXi idx;
+    MatrixXd C, D;
+    VectorXd sumD;
+
+    QVERIFY(kMeans.calculate(m_matDuplicates, 4, idx, C, sumD, D));
+
+    // The empty cluster is dropped and never gets members again
+    int iNumberUsed = 0;
+    for(int c = 0; c < 4; ++c) {
+        if((idx.array() == c).any()) {
+            ++iNumberUsed;
+        }
+    }
+
+    QVERIFY(iNumberUsed >= 1 && iNumberUsed <= 3);
+}
+
+//=============================================================================================================
+
+void TestKMeans::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+void TestKMeans::compareBatchFixedPoint(const VectorXi& idx,
+                                        const MatrixXd& C,
+                                        const VectorXd& sumD,
+                                        bool bSqEuclidean)
+{
+    const int n = m_matX.rows();
+    const int k = C.rows();
+
+    QCOMPARE(int(idx.size()), n);
+
+    // A batch reassignment step must not move any point: each one is closest to its own centroid
+    VectorXd vecSumD = VectorXd::Zero(k);
+
+    for(int i = 0; i < n; ++i) {
+        VectorXd vecDist(k);
+
+        for(int c = 0; c < k; ++c) {
+            RowVectorXd diff = m_matX.row(i) - C.row(c);
+            vecDist[c] = bSqEuclidean ? diff.squaredNorm() : diff.cwiseAbs().sum();
+        }
+
+        QVERIFY(vecDist[idx[i]] <= vecDist.minCoeff() + m_dEpsilon);
+        vecSumD[idx[i]] += vecDist[idx[i]];
+    }
+
+    QVERIFY((vecSumD - sumD).cwiseAbs().maxCoeff() < 1e-6);
+
+    // ... and the centroid update must not move any centroid
+    if(bSqEuclidean) {
+        for(int c = 0; c < k; ++c) {
+            RowVectorXd vecMean = RowVectorXd::Zero(m_matX.cols());
+            int iCount = 0;
+
+            for(int i = 0; i < n; ++i) {
+                if(idx[i] == c) {
+                    vecMean += m_matX.row(i);
+                    ++iCount;
+                }
+            }
+
+            QVERIFY(iCount > 0);
+            QVERIFY((vecMean / iCount - C.row(c)).cwiseAbs().maxCoeff() < m_dEpsilon);
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestKMeans::compareTruth(const VectorXi& idx)
+{
+    // Same partition as the blobs, up to the cluster labels
+    for(int c = 0; c < m_iNumberClusters; ++c) {
+        const int iLabel = idx[c * m_iNumberPoints];
+
+        for(int i = 0; i < m_iNumberPoints; ++i) {
+            QCOMPARE(idx[c * m_iNumberPoints + i], iLabel);
+        }
+
+        for(int d = 0; d < c; ++d) {
+            QVERIFY(idx[d * m_iNumberPoints] != iLabel);
+        }
+    }
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestKMeans)
+#include "test_kmeans.moc"
@@ -0,0 +1,352 @@
+//=============================================================================================================
+/**
+ * @file     test_minimumnorm_kernel.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the factored and float MinimumNorm kernels against the dense kernel product.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <fiff/fiff_evoked.h>
+#include <fiff/fiff_cov.h>
+#include <fiff/fiff_constants.h>
+
+#include <mne/mne_forwardsolution.h>
+#include <mne/mne_inverse_operator.h>
+#include <mne/mne_sourceestimate.h>
+
+#include <inverse/minimumNorm/minimumnorm.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <limits>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace MNELIB;
+using namespace INVERSELIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMinimumNormKernel
+ *
+ * @brief The TestMinimumNormKernel class compares the factored and the single precision kernel paths of
+ *        MinimumNorm with the explicit product of the dense kernel and the sample evoked data.
+ *
+ */
+class TestMinimumNormKernel: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMinimumNormKernel();
+
+private slots:
+    void initTestCase();
+    void compareKernelPaths_data();
+    void compareKernelPaths();
+    void compareLatchedLayout();
+    void rejectNoiseNormMismatch();
+    void cleanupTestCase();
+
+private:
+    MatrixXd referenceSolution(const MatrixXd& matKernel,
+                               bool bdSPM,
+                               bool bsLORETA,
+                               bool bPickNormal) const;
+    MatrixXd calculateSolution(const QString& sMethod,
+                               bool bPickNormal,
+                               bool bFactored,
+                               bool bFloat) const;
+    static double relativeError(const MatrixXd& matSol,
+                                const MatrixXd& matRef);
+
+    double              m_dEpsilonDouble;
+    double              m_dEpsilonFloat;
+    float               m_fLambda2;
+    float               m_fTMin;
+    float               m_fTStep;
+    qint32              m_iNave;
+    MNEInverseOperator  m_inverseOperator;
+    MatrixXd            m_matData;
+};
+
+//=============================================================================================================
+
+TestMinimumNormKernel::TestMinimumNormKernel()
+: m_dEpsilonDouble(1e-10)
+, m_dEpsilonFloat(1e-4)
+, m_fLambda2(1.0f / 9.0f)
+, m_fTMin(0.0f)
+, m_fTStep(0.0f)
+, m_iNave(1)
+{
+}
+
+//=============================================================================================================
+
+void TestMinimumNormKernel::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QFile t_fileFwd(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/Result/ref-sample_audvis-meg-eeg-oct-6-fwd.fif");
+    QFile t_fileCov(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-cov.fif");
+    QFile t_fileEvoked(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-ave.fif");
+
+    QPair<float, float> baseline(-1.0f, -1.0f);
+    FiffEvoked evoked(t_fileEvoked, 0, baseline);
+    QVERIFY(!evoked.isEmpty());
+
+    MNEForwardSolution t_forward(t_fileFwd, false, true);
+    QVERIFY(!t_forward.isEmpty());
+
+    FiffCov noise_cov(t_fileCov);
+    noise_cov = noise_cov.regularize(evoked.info, 0.05, 0.05, 0.1, true);
+
+    // Loose orientation keeps the free orientation source layout, so that the xyz components are combined
+    m_inverseOperator = MNEInverseOperator(evoked.info, t_forward, noise_cov, 0.2f, 0.8f);
+    QCOMPARE(m_inverseOperator.source_ori, FIFFV_MNE_FREE_ORI);
+
+    // A section around the response keeps the products small
+    FiffEvoked t_evokedPicked = evoked.pick_channels(m_inverseOperator.noise_cov->names);
+    m_matData = t_evokedPicked.data.middleCols(t_evokedPicked.data.cols() / 2, 40);
+    m_iNave = evoked.nave;
+    m_fTStep = 1.0f / t_evokedPicked.info.sfreq;
+    m_fTMin = evoked.times[0];
+}
+
+//=============================================================================================================
+
+void TestMinimumNormKernel::compareKernelPaths_data()
+{
+    QTest::addColumn<QString>("sMethod");
+    QTest::addColumn<bool>("bPickNormal");
+
+    QTest::newRow("MNE") << QString("MNE") << false;
+    QTest::newRow("MNE normal") << QString("MNE") << true;
+    QTest::newRow("dSPM") << QString("dSPM") << false;
+    QTest::newRow("dSPM normal") << QString("dSPM") << true;
+    QTest::newRow("sLORETA") << QString("sLORETA") << false;
+    QTest::newRow("sLORETA normal") << QString("sLORETA") << true;
+}
+
+//=============================================================================================================
+
+void TestMinimumNormKernel::compareKernelPaths()
+{
+    QFETCH(QString, sMethod);
+    QFETCH(bool, bPickNormal);
+
+    const bool bdSPM = sMethod == "dSPM";
+    const bool bsLORETA = sMethod == "sLORETA";
+
+    MinimumNorm minimumNorm(m_inverseOperator, m_fLambda2, sMethod);
+    minimumNorm.doInverseSetup(m_iNave, bPickNormal);
+
+    const MatrixXd matKernel = minimumNorm.getKernel();
+    QCOMPARE(matKernel.cols(), m_matData.rows());
+
+    const MatrixXd matRef = referenceSolution(matKernel, bdSPM, bsLORETA, bPickNormal);
+    const MatrixXd matDense = minimumNorm.calculateInverse(m_matData, m_fTMin, m_fTStep, bPickNormal).data;
+
+    QCOMPARE(matDense.rows(), matRef.rows());
+    QCOMPARE(matDense.cols(), matRef.cols());
+    QVERIFY(relativeError(matDense, matRef) <= m_dEpsilonDouble);
+
+    // The factored kernel only applies the same product in a different order
+    const MatrixXd matFactored = calculateSolution(sMethod, bPickNormal, true, false);
+    QCOMPARE(matFactored.rows(), matRef.rows());
+    QVERIFY(relativeError(matFactored, matRef) <= m_dEpsilonDouble);
+
+    // The single precision kernels have to stay within float tolerance
+    const MatrixXd matFloat = calculateSolution(sMethod, bPickNormal, false, true);
+    QCOMPARE(matFloat.rows(), matRef.rows());
+    QVERIFY(relativeError(matFloat, matRef) <= m_dEpsilonFloat);
+
+    const MatrixXd matFactoredFloat = calculateSolution(sMethod, bPickNormal, true, true);
+    QCOMPARE(matFactoredFloat.rows(), matRef.rows());
+    QVERIFY(relativeError(matFactoredFloat, matRef) <= m_dEpsilonFloat);
+}
+
+//=============================================================================================================
+
+void TestMinimumNormKernel::compareLatchedLayout()
+{
+    MinimumNorm minimumNormDense(m_inverseOperator, m_fLambda2, QString("dSPM"));
+    minimumNormDense.doInverseSetup(m_iNave, false);
+    const MatrixXd matRef = referenceSolution(minimumNormDense.getKernel(), true, false, false);
+
+    // Toggling the layout after the setup must not switch calculateInverse to kernels that were never assembled
+    minimumNormDense.setFactoredKernel(true);
+    minimumNormDense.setFloatPrecision(true);
+    QVERIFY(minimumNormDense.getKernel().size() > 0);
+
+    MatrixXd matSol = minimumNormDense.calculateInverse(m_matData, m_fTMin, m_fTStep, false).data;
+    QCOMPARE(matSol.rows(), matRef.rows());
+    QVERIFY(relativeError(matSol, matRef) <= m_dEpsilonDouble);
+
+    MinimumNorm minimumNormFactored(m_inverseOperator, m_fLambda2, QString("dSPM"));
+    minimumNormFactored.setFactoredKernel(true);
+    minimumNormFactored.doInverseSetup(m_iNave, false);
+    QVERIFY(minimumNormFactored.getKernel().size() == 0);
+
+    minimumNormFactored.setFactoredKernel(false);
+    minimumNormFactored.setFloatPrecision(true);
+
+    matSol = minimumNormFactored.calculateInverse(m_matData, m_fTMin, m_fTStep, false).data;
+    QCOMPARE(matSol.rows(), matRef.rows());
+    QVERIFY(relativeError(matSol, matRef) <= m_dEpsilonDouble);
+
+    // The next setup picks up the new layout
+    minimumNormFactored.doInverseSetup(m_iNave, false);
+    QVERIFY(minimumNormFactored.getKernel().size() > 0);
+
+    matSol = minimumNormFactored.calculateInverse(m_matData, m_fTMin, m_fTStep, false).data;
+    QCOMPARE(matSol.rows(), matRef.rows());
+    QVERIFY(relativeError(matSol, matRef) <= m_dEpsilonFloat);
+}
+
+//=============================================================================================================
+
+void TestMinimumNormKernel::rejectNoiseNormMismatch()
+{
+    // Set up for combined xyz components, the noise normalization then has one entry per source location.
+    // Asking for the normal components leaves three kernel rows per location, which must be rejected.
+    for(int iFactored = 0; iFactored < 2; ++iFactored) {
+        MinimumNorm minimumNorm(m_inverseOperator, m_fLambda2, QString("dSPM"));
+        minimumNorm.setFactoredKernel(iFactored == 1);
+        minimumNorm.doInverseSetup(m_iNave, false);
+
+        QVERIFY(!minimumNorm.calculateInverse(m_matData, m_fTMin, m_fTStep, false).isEmpty());
+        QVERIFY(minimumNorm.calculateInverse(m_matData, m_fTMin, m_fTStep, true).isEmpty());
+    }
+
+    // Without noise normalization there is nothing to mismatch
+    MinimumNorm minimumNorm(m_inverseOperator, m_fLambda2, QString("MNE"));
+    minimumNorm.doInverseSetup(m_iNave, false);
+    QVERIFY(!minimumNorm.calculateInverse(m_matData, m_fTMin, m_fTStep, true).isEmpty());
+}
+
+//=============================================================================================================
+
+void TestMinimumNormKernel::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+MatrixXd TestMinimumNormKernel::referenceSolution(const MatrixXd& matKernel,
+                                                  bool bdSPM,
+                                                  bool bsLORETA,
+                                                  bool bPickNormal) const
+{
+    MatrixXd matSol = matKernel * m_matData;
+
+    if(m_inverseOperator.source_ori == FIFFV_MNE_FREE_ORI && !bPickNormal) {
+        MatrixXd matCombined(matSol.rows() / 3, matSol.cols());
+
+        for(int i = 0; i < matCombined.rows(); ++i) {
+            matCombined.row(i) = (matSol.row(3*i).array().square()
+                                  + matSol.row(3*i+1).array().square()
+                                  + matSol.row(3*i+2).array().square()).sqrt().matrix();
+        }
+
+        matSol = matCombined;
+    }
+
+    if(bdSPM || bsLORETA) {
+        const SparseMatrix<double> matNoiseNorm = m_inverseOperator.prepare_inverse_operator(m_iNave,
+                                                                                            m_fLambda2,
+                                                                                            bdSPM,
+                                                                                            bsLORETA).noisenorm;
+        matSol = matNoiseNorm * matSol;
+    }
+
+    return matSol;
+}
+
+//=============================================================================================================
+
+MatrixXd TestMinimumNormKernel::calculateSolution(const QString& sMethod,
+                                                  bool bPickNormal,
+                                                  bool bFactored,
+                                                  bool bFloat) const
+{
+    MinimumNorm minimumNorm(m_inverseOperator, m_fLambda2, sMethod);
+    minimumNorm.setFactoredKernel(bFactored);
+    minimumNorm.setFloatPrecision(bFloat);
+    minimumNorm.doInverseSetup(m_iNave, bPickNormal);
+
+    return minimumNorm.calculateInverse(m_matData, m_fTMin, m_fTStep, bPickNormal).data;
+}
+
+//=============================================================================================================
+
+double TestMinimumNormKernel::relativeError(const MatrixXd& matSol,
+                                            const MatrixXd& matRef)
+{
+    // Relative to the largest reference value, single entries close to zero would otherwise dominate
+    if(matSol.rows() != matRef.rows() || matSol.cols() != matRef.cols()) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    return (matSol - matRef).cwiseAbs().maxCoeff() / matRef.cwiseAbs().maxCoeff();
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMinimumNormKernel)
+#include "test_minimumnorm_kernel.moc"
@@ -0,0 +1,314 @@
+//=============================================================================================================
+/**
+ * @file     test_minmaxpyramid.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the MinMaxPyramid envelopes against a brute force min/max.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <disp/viewers/helpers/minmaxpyramid.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace DISPLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMinMaxPyramid
+ *
+ * @brief The TestMinMaxPyramid class compares the envelopes of a MinMaxPyramid with a brute force min/max over
+ *        the samples and checks that partial and wrapped ring buffer updates give the same pyramid as a full build.
+ *
+ */
+class TestMinMaxPyramid: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMinMaxPyramid();
+
+private slots:
+    void initTestCase();
+    void compareBruteForce();
+    void compareUpdate();
+    void compareWrappedStart();
+    void compareWrappedEnd();
+    void compareShortData();
+    void cleanupTestCase();
+
+private:
+    void writeRandom(MatrixXdR& matData,
+                     int iFirstSample,
+                     int iNumberSamples) const;
+    void compareEnvelopes(const MinMaxPyramid& pyramid,
+                          const MatrixXdR& matData) const;
+    void compareEnvelope(const MinMaxPyramid& pyramid,
+                         const MatrixXdR& matData,
+                         int iRow,
+                         int iFirstSample,
+                         int iNumberSamples,
+                         int iNumberPixels) const;
+
+    int                 m_iBinFactor;
+    int                 m_iNumberRows;
+    int                 m_iNumberSamples;
+    MatrixXdR           m_matData;
+};
+
+//=============================================================================================================
+
+TestMinMaxPyramid::TestMinMaxPyramid()
+: m_iBinFactor(4)
+, m_iNumberRows(3)
+, m_iNumberSamples(1003)
+{
+}
+
+//=============================================================================================================
+
+void TestMinMaxPyramid::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(11);
+
+    // The number of samples is no multiple of any bin size, so the last bin of every level is partial
+    m_matData = MatrixXdR::Random(m_iNumberRows, m_iNumberSamples);
+}
+
+//=============================================================================================================
+
+void TestMinMaxPyramid::compareBruteForce()
+{
+    MinMaxPyramid pyramid(m_iBinFactor);
+    pyramid.update(m_matData);
+
+    QCOMPARE(pyramid.getNumberLevels(), 4);
+
+    compareEnvelopes(pyramid, m_matData);
+}
+
+//=============================================================================================================
+
+void TestMinMaxPyramid::compareUpdate()
+{
+    MinMaxPyramid pyramid(m_iBinFactor);
+    MatrixXdR matData = m_matData;
+    pyramid.update(matData);
+
+    // A range which is not aligned to any bin
+    writeRandom(matData, 201, 77);
+    pyramid.update(matData, 201, 77);
+
+    // -1 updates all samples up to the end of the matrix
+    writeRandom(matData, 995, m_iNumberSamples - 995);
+    pyramid.update(matData, 995, -1);
+
+    compareEnvelopes(pyramid, matData);
+}
+
+//=============================================================================================================
+
+void TestMinMaxPyramid::compareWrappedStart()
+{
+    MinMaxPyramid pyramid(m_iBinFactor);
+    MatrixXdR matData = m_matData;
+    pyramid.update(matData);
+
+    // Starting before the first sample continues at the end of the ring buffer
+    writeRandom(matData, -37, 90);
+    pyramid.update(matData, -37, 90);
+
+    compareEnvelopes(pyramid, matData);
+}
+
+//=============================================================================================================
+
+void TestMinMaxPyramid::compareWrappedEnd()
+{
+    MinMaxPyramid pyramid(m_iBinFactor);
+    MatrixXdR matData = m_matData;
+    pyramid.update(matData);
+
+    // Ending behind the last sample continues at the start of the ring buffer
+    writeRandom(matData, m_iNumberSamples - 21, 66);
+    pyramid.update(matData, m_iNumberSamples - 21, 66);
+
+    // A range longer than the buffer updates everything
+    MatrixXdR matNew = MatrixXdR::Random(m_iNumberRows, m_iNumberSamples);
+    MinMaxPyramid pyramidNew = pyramid;
+    pyramidNew.update(matNew, 500, 2 * m_iNumberSamples);
+
+    compareEnvelopes(pyramid, matData);
+    compareEnvelopes(pyramidNew, matNew);
+}
+
+//=============================================================================================================
+
+void TestMinMaxPyramid::compareShortData()
+{
+    // Without levels the envelope is computed from the samples
+    MatrixXdR matData = MatrixXdR::Random(1, 7);
+    MinMaxPyramid pyramid(m_iBinFactor);
+    pyramid.update(matData);
+
+    QCOMPARE(pyramid.getNumberLevels(), 0);
+    compareEnvelope(pyramid, matData, 0, 0, 7, 3);
+}
+
+//=============================================================================================================
+
+void TestMinMaxPyramid::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+void TestMinMaxPyramid::writeRandom(MatrixXdR& matData,
+                                    int iFirstSample,
+                                    int iNumberSamples) const
+{
+    // Larger values than the initial data, so that stale bins would show up in the envelopes
+    for(int i = iFirstSample; i < iFirstSample + iNumberSamples; ++i) {
+        int iCol = ((i % m_iNumberSamples) + m_iNumberSamples) % m_iNumberSamples;
+        matData.col(iCol) = 3.0 * VectorXd::Random(m_iNumberRows);
+    }
+}
+
+//=============================================================================================================
+
+void TestMinMaxPyramid::compareEnvelopes(const MinMaxPyramid& pyramid,
+                                         const MatrixXdR& matData) const
+{
+    QList<QPair<int,int> > lRanges;
+    lRanges << qMakePair(0, m_iNumberSamples)
+            << qMakePair(1, m_iNumberSamples - 1)
+            << qMakePair(3, 500)
+            << qMakePair(13, 917)
+            << qMakePair(250, 251)
+            << qMakePair(m_iNumberSamples - 130, 130)
+            << qMakePair(997, 6);
+
+    QList<int> lPixels;
+    lPixels << 1 << 2 << 7 << 33 << 100 << 251;
+
+    for(int r = 0; r < m_iNumberRows; ++r) {
+        for(const QPair<int,int>& range : lRanges) {
+            for(int iNumberPixels : lPixels) {
+                compareEnvelope(pyramid, matData, r, range.first, range.second, iNumberPixels);
+            }
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestMinMaxPyramid::compareEnvelope(const MinMaxPyramid& pyramid,
+                                        const MatrixXdR& matData,
+                                        int iRow,
+                                        int iFirstSample,
+                                        int iNumberSamples,
+                                        int iNumberPixels) const
+{
+    RowVectorXd vecMin, vecMax;
+    pyramid.getEnvelope(matData.row(iRow).data(), iRow, iFirstSample, iNumberSamples, iNumberPixels, vecMin, vecMax);
+
+    QCOMPARE(int(vecMin.size()), iNumberPixels);
+    QCOMPARE(int(vecMax.size()), iNumberPixels);
+
+    // The level whose bins fit into one pixel, the same choice getEnvelope makes
+    const double dSamplesPerPixel = double(iNumberSamples) / iNumberPixels;
+    int iBinSize = 1;
+
+    for(int l = 0; l < pyramid.getNumberLevels() && iBinSize * m_iBinFactor <= dSamplesPerPixel; ++l) {
+        iBinSize *= m_iBinFactor;
+    }
+
+    // Brute force over the samples of the bins of every pixel. A bin belongs to the pixel its first sample
+    // falls into, so the pixels can reach up to one bin in front of and behind the requested range.
+    const int iNumberBins = (m_iNumberSamples + iBinSize - 1) / iBinSize;
+    int iFirstBin = iFirstSample / iBinSize;
+
+    for(int p = 0; p < iNumberPixels; ++p) {
+        int iLastBin = p == iNumberPixels - 1
+                       ? (iFirstSample + iNumberSamples - 1) / iBinSize + 1
+                       : (iFirstSample + int((p + 1) * dSamplesPerPixel)) / iBinSize;
+        iFirstBin = qMin(iFirstBin, iNumberBins - 1);
+        iLastBin = qBound(iFirstBin + 1, iLastBin, iNumberBins);
+
+        int iStart = iFirstBin * iBinSize;
+        int iEnd = qMin(iLastBin * iBinSize, m_iNumberSamples);
+
+        if(iBinSize == 1) {
+            iStart = qMin(int(p * dSamplesPerPixel), iNumberSamples - 1);
+            iEnd = p == iNumberPixels - 1 ? iNumberSamples : int((p + 1) * dSamplesPerPixel);
+            iEnd = qBound(iStart + 1, iEnd, iNumberSamples);
+            iStart += iFirstSample;
+            iEnd += iFirstSample;
+        }
+
+        QCOMPARE(vecMin(p), matData.row(iRow).segment(iStart, iEnd - iStart).minCoeff());
+        QCOMPARE(vecMax(p), matData.row(iRow).segment(iStart, iEnd - iStart).maxCoeff());
+
+        iFirstBin = iLastBin;
+    }
+
+    // No extremum of the range is lost
+    QVERIFY(vecMin.minCoeff() <= matData.row(iRow).segment(iFirstSample, iNumberSamples).minCoeff());
+    QVERIFY(vecMax.maxCoeff() >= matData.row(iRow).segment(iFirstSample, iNumberSamples).maxCoeff());
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMinMaxPyramid)
+#include "test_minmaxpyramid.moc"
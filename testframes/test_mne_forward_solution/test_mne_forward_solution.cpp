@@ -79,6 +79,7 @@ private slots:
     void initTestCase();
     void computeForward();
     void compareForward();
+    void compareLazyForward();
     void cleanupTestCase();
 
 private:
@@ -186,6 +187,40 @@ void TestMneForwardSolution::compareForward()
 
 //=============================================================================================================
 
+void TestMneForwardSolution::compareLazyForward()
+{
+    printf(">>>>>>>>>>>>>>>>>>>>>>>>> Compare Lazy MEG/EEG Forward Solution >>>>>>>>>>>>>>>>>>>>>>>>>\n");
+
+    QString fwdMEGEEGFileRef(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/Result/ref-sample_audvis-meg-eeg-oct-6-fwd.fif");
+
+    // The mapped gain matrix has to give the same picks as the one read into memory, also after the orientation change
+    for(bool bSurfOri : {false, true}) {
+        QFile fileFwdEager(fwdMEGEEGFileRef);
+        QFile fileFwdLazy(fwdMEGEEGFileRef);
+        MNEForwardSolution fwdEager(fileFwdEager, false, bSurfOri);
+        MNEForwardSolution fwdLazy(fileFwdLazy, false, bSurfOri, FIFFLIB::defaultQStringList, FIFFLIB::defaultQStringList, false, true);
+
+        QVERIFY(fwdLazy.isLazy());
+        QVERIFY(fwdLazy.nchan == fwdEager.nchan);
+        QVERIFY(fwdLazy.nsource == fwdEager.nsource);
+
+        MNEForwardSolution fwdMegEager = fwdEager.pick_types(true, false);
+        MNEForwardSolution fwdMegLazy = fwdLazy.pick_types(true, false);
+        fwdMegLazy.load_lazy_solution();
+
+        QVERIFY(!fwdMegLazy.isLazy());
+        QVERIFY(fwdMegLazy.sol->data.rows() == fwdMegEager.sol->data.rows());
+        QVERIFY(fwdMegLazy.sol->data.cols() == fwdMegEager.sol->data.cols());
+
+        double dScale = fwdMegEager.sol->data.cwiseAbs().maxCoeff();
+        QVERIFY((fwdMegLazy.sol->data - fwdMegEager.sol->data).cwiseAbs().maxCoeff() <= dEpsilon * dScale);
+    }
+
+    printf("<<<<<<<<<<<<<<<<<<<<<<<<< Compare Lazy MEG/EEG Forward Solution Finished <<<<<<<<<<<<<<<<<<<<<<<<<\n");
+}
+
+//=============================================================================================================
+
 void TestMneForwardSolution::cleanupTestCase()
 {
 }
@@ -0,0 +1,308 @@
+//=============================================================================================================
+/**
+ * @file     test_mne_source_morph.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the source morph operator and the on-disk cache it is stored in.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/filecache.h>
+#include <mne/mne_source_morph.h>
+#include <mne/mne_sourceestimate.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+#include <QBuffer>
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMneSourceMorph
+ *
+ * @brief The TestMneSourceMorph class morphs on a small synthetic sphere, round-trips the operator through its
+ *        serialization and checks the size bound of the cache the operator is stored in.
+ *
+ */
+class TestMneSourceMorph: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMneSourceMorph();
+
+private slots:
+    void initTestCase();
+    void compareIdentity();
+    void compareSmoothing();
+    void compareBatch();
+    void compareReadWrite();
+    void compareCacheEviction();
+    void cleanupTestCase();
+
+private:
+    double      m_dEpsilon;
+    MatrixX3f   m_matSphere;
+    MatrixX3i   m_matTris;
+};
+
+//=============================================================================================================
+
+TestMneSourceMorph::TestMneSourceMorph()
+: m_dEpsilon(1e-12)
+{
+}
+
+//=============================================================================================================
+
+void TestMneSourceMorph::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    // Octahedron: the smallest closed surface, every vertex has four neighbours
+    m_matSphere.resize(6, 3);
+    m_matSphere << 1, 0, 0,
+                   -1, 0, 0,
+                   0, 1, 0,
+                   0, -1, 0,
+                   0, 0, 1,
+                   0, 0, -1;
+
+    m_matTris.resize(8, 3);
+    m_matTris << 0, 2, 4,
+                 2, 1, 4,
+                 1, 3, 4,
+                 3, 0, 4,
+                 2, 0, 5,
+                 1, 2, 5,
+                 3, 1, 5,
+                 0, 3, 5;
+}
+
+//=============================================================================================================
+
+void TestMneSourceMorph::compareIdentity()
+{
+    // Without smoothing every destination vertex picks the source vertex at the same position
+    VectorXi vecVertices(6);
+    vecVertices << 0, 1, 2, 3, 4, 5;
+
+    SparseMatrix<double> matMorph = MNESourceMorph::computeHemisphere(m_matSphere, m_matTris, vecVertices,
+                                                                      m_matSphere, vecVertices, 0);
+
+    QCOMPARE(matMorph.rows(), Index(6));
+    QCOMPARE(matMorph.cols(), Index(6));
+    QVERIFY((MatrixXd(matMorph) - MatrixXd::Identity(6, 6)).norm() < m_dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestMneSourceMorph::compareSmoothing()
+{
+    VectorXi vecVerticesFrom(3);
+    vecVerticesFrom << 0, 2, 4;
+    VectorXi vecVerticesTo(6);
+    vecVerticesTo << 0, 1, 2, 3, 4, 5;
+
+    SparseMatrix<double> matMorph = MNESourceMorph::computeHemisphere(m_matSphere, m_matTris, vecVerticesFrom,
+                                                                      m_matSphere, vecVerticesTo, -1);
+
+    QCOMPARE(matMorph.rows(), Index(6));
+    QCOMPARE(matMorph.cols(), Index(3));
+
+    // Every destination vertex is a mean of the sources, so constant data stays constant
+    MatrixXd matDense(matMorph);
+    QVERIFY((matDense.rowwise().sum() - VectorXd::Ones(6)).norm() < m_dEpsilon);
+    QVERIFY((matDense.array() >= 0.0).all());
+
+    // One smoothing step covers the octahedron: a source vertex averages itself and the two other sources, an
+    // opposite vertex the two sources next to it
+    RowVector3d vecSource = RowVector3d::Constant(1.0 / 3.0);
+    RowVector3d vecOpposite(0.0, 0.5, 0.5);
+    QVERIFY((matDense.row(0) - vecSource).norm() < m_dEpsilon);
+    QVERIFY((matDense.row(1) - vecOpposite).norm() < m_dEpsilon);
+
+    QVERIFY(MNESourceMorph::computeHemisphere(m_matSphere, m_matTris, VectorXi::Constant(1, 6),
+                                              m_matSphere, vecVerticesTo, -1).size() == 0);
+}
+
+//=============================================================================================================
+
+void TestMneSourceMorph::compareBatch()
+{
+    VectorXi vecVerticesFrom(3);
+    vecVerticesFrom << 0, 2, 4;
+    VectorXi vecVerticesTo(6);
+    vecVerticesTo << 0, 1, 2, 3, 4, 5;
+
+    SparseMatrix<double> matHemi = MNESourceMorph::computeHemisphere(m_matSphere, m_matTris, vecVerticesFrom,
+                                                                     m_matSphere, vecVerticesTo, -1);
+
+    MNESourceMorph morph;
+    morph.setOperator(matHemi, QList<VectorXi>() << vecVerticesFrom, QList<VectorXi>() << vecVerticesTo);
+
+    QList<MNESourceEstimate> lStcFrom;
+    lStcFrom << MNESourceEstimate(MatrixXd::Random(3, 5), vecVerticesFrom, 0.0f, 0.001f)
+             << MNESourceEstimate(MatrixXd::Random(3, 7), vecVerticesFrom, 0.1f, 0.001f);
+
+    QList<MNESourceEstimate> lStcTo = morph.apply(lStcFrom);
+    QCOMPARE(lStcTo.size(), lStcFrom.size());
+
+    for(int i = 0; i < lStcFrom.size(); ++i) {
+        MatrixXd matReference = MatrixXd(matHemi) * lStcFrom[i].data;
+        MNESourceEstimate stcSingle = morph.apply(lStcFrom[i]);
+
+        QVERIFY((lStcTo[i].data - matReference).norm() < 1e-10);
+        QVERIFY((stcSingle.data - matReference).norm() < 1e-10);
+        QCOMPARE(lStcTo[i].vertices, vecVerticesTo);
+    }
+
+    // Single precision stays within float accuracy
+    morph.setFloatPrecision(true);
+    MatrixXd matFloat = morph.apply(lStcFrom[0].data);
+    QVERIFY((matFloat - MatrixXd(matHemi) * lStcFrom[0].data).norm() < 1e-5);
+}
+
+//=============================================================================================================
+
+void TestMneSourceMorph::compareReadWrite()
+{
+    VectorXi vecVerticesFrom(3);
+    vecVerticesFrom << 0, 2, 4;
+    VectorXi vecVerticesTo(6);
+    vecVerticesTo << 0, 1, 2, 3, 4, 5;
+
+    MNESourceMorph morph;
+    morph.setOperator(MNESourceMorph::computeHemisphere(m_matSphere, m_matTris, vecVerticesFrom,
+                                                        m_matSphere, vecVerticesTo, -1),
+                      QList<VectorXi>() << vecVerticesFrom,
+                      QList<VectorXi>() << vecVerticesTo);
+
+    QByteArray baData;
+    QBuffer buffer(&baData);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QVERIFY(morph.write(buffer));
+    buffer.close();
+
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    MNESourceMorph morphRead;
+    QVERIFY(MNESourceMorph::read(buffer, morphRead));
+    buffer.close();
+
+    QCOMPARE(morphRead.matrix().rows(), morph.matrix().rows());
+    QCOMPARE(morphRead.matrix().cols(), morph.matrix().cols());
+    QVERIFY((MatrixXd(morphRead.matrix()) - MatrixXd(morph.matrix())).norm() == 0.0);
+    QCOMPARE(morphRead.verticesFrom(), morph.verticesFrom());
+    QCOMPARE(morphRead.verticesTo(), morph.verticesTo());
+
+    // A truncated operator is rejected
+    QByteArray baTruncated = baData.left(baData.size() / 2);
+    QBuffer bufferTruncated(&baTruncated);
+    QVERIFY(bufferTruncated.open(QIODevice::ReadOnly));
+    MNESourceMorph morphTruncated;
+    QVERIFY(!MNESourceMorph::read(bufferTruncated, morphTruncated));
+}
+
+//=============================================================================================================
+
+void TestMneSourceMorph::compareCacheEviction()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    FileCache cache(dir.path(), "morph", 250);
+    QByteArray baEntry(100, 'x');
+
+    QVERIFY(cache.write("a", baEntry));
+    QVERIFY(cache.write("b", baEntry));
+
+    // Age both entries, then touch a by reading it
+    for(const QString& sKey : {QString("a"), QString("b")}) {
+        QFile file(cache.getFileName(sKey));
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(-3600), QFileDevice::FileModificationTime));
+    }
+
+    QByteArray baRead;
+    QVERIFY(cache.read("a", baRead));
+    QCOMPARE(baRead, baEntry);
+
+    // The third entry exceeds the bound, the least recently used one goes
+    QVERIFY(cache.write("c", baEntry));
+    QVERIFY(QFile::exists(cache.getFileName("a")));
+    QVERIFY(!QFile::exists(cache.getFileName("b")));
+    QVERIFY(QFile::exists(cache.getFileName("c")));
+    QVERIFY(!cache.read("b", baRead));
+
+    // Keys are stable and differ with the content
+    FileCacheKey keyA("TestMneSourceMorph"), keyB("TestMneSourceMorph"), keyC("TestMneSourceMorph");
+    keyA.add("ab").add("c");
+    keyB.add("ab").add("c");
+    keyC.add("a").add("bc");
+    QCOMPARE(keyA.result(), keyB.result());
+    QVERIFY(keyA.result() != keyC.result());
+}
+
+//=============================================================================================================
+
+void TestMneSourceMorph::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMneSourceMorph)
+#include "test_mne_source_morph.moc"
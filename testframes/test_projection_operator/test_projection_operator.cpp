@@ -0,0 +1,231 @@
+//=============================================================================================================
+/**
+ * @file     test_projection_operator.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Tests the fused ProjectionOperator against the dense product of its stages.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <rtprocessing/helpers/projectionoperator.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace RTPROCESSINGLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestProjectionOperator
+ *
+ * @brief The TestProjectionOperator class compares the fused operator with the dense product S*P*C.
+ *
+ */
+class TestProjectionOperator: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestProjectionOperator();
+
+private slots:
+    void initTestCase();
+    void compareColMajor();
+    void compareRowMajor();
+    void compareOutOfPlace();
+    void compareSparse();
+    void compareStageSelection();
+    void cleanupTestCase();
+
+private:
+    double              m_dEpsilon;
+    int                 m_iNumberChannels;
+    MatrixXd            m_matComp;
+    MatrixXd            m_matProj;
+    MatrixXd            m_matSphara;
+    MatrixXd            m_matData;
+    ProjectionOperator  m_operator;
+};
+
+//=============================================================================================================
+
+TestProjectionOperator::TestProjectionOperator()
+: m_dEpsilon(1e-10)
+, m_iNumberChannels(60)
+{
+}
+
+//=============================================================================================================
+
+void TestProjectionOperator::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(42);
+
+    // The stages only touch subsets of the channels, like MEG projectors next to EEG and trigger channels
+    int n = m_iNumberChannels;
+    m_matComp = MatrixXd::Identity(n, n);
+    m_matComp.topLeftCorner(30, 30) += 0.01 * MatrixXd::Random(30, 30);
+
+    MatrixXd matU = MatrixXd::Random(40, 3);
+    HouseholderQR<MatrixXd> qr(matU);
+    MatrixXd matQ = qr.householderQ() * MatrixXd::Identity(40, 3);
+    m_matProj = MatrixXd::Identity(n, n);
+    m_matProj.topLeftCorner(40, 40) -= matQ * matQ.transpose();
+
+    m_matSphara = MatrixXd::Identity(n, n);
+    m_matSphara.block(10, 10, 20, 20) = MatrixXd::Random(20, 20);
+
+    m_matData = MatrixXd::Random(n, 500);
+
+    m_operator.setNumberChannels(n);
+    m_operator.setCompensator(m_matComp);
+    m_operator.setProjector(m_matProj);
+    m_operator.setSphara(m_matSphara);
+    m_operator.setStages(ProjectionOperator::Compensator | ProjectionOperator::Projector | ProjectionOperator::Sphara);
+}
+
+//=============================================================================================================
+
+void TestProjectionOperator::compareColMajor()
+{
+    MatrixXd matRef = m_matSphara * m_matProj * m_matComp * m_matData;
+
+    MatrixXd matTest = m_matData;
+    m_operator.apply(matTest);
+
+    QVERIFY(!m_operator.isIdentity());
+    QVERIFY((matTest - matRef).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    // Channels which are not touched by any stage stay bit identical
+    QVERIFY(matTest.bottomRows(20) == m_matData.bottomRows(20));
+}
+
+//=============================================================================================================
+
+void TestProjectionOperator::compareRowMajor()
+{
+    MatrixXd matRef = m_matSphara * m_matProj * m_matComp * m_matData;
+
+    ProjectionOperator::MatrixXdR matTest = m_matData;
+    m_operator.apply(matTest);
+
+    QVERIFY((matTest - matRef).cwiseAbs().maxCoeff() < m_dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestProjectionOperator::compareOutOfPlace()
+{
+    MatrixXd matRef = m_matSphara * m_matProj * m_matComp * m_matData;
+
+    // Write into blocks of larger matrices, as the ring buffer of the raw view model does
+    MatrixXd matOut = MatrixXd::Zero(m_iNumberChannels, 1000);
+    m_operator.apply(m_matData, matOut.block(0, 100, m_iNumberChannels, m_matData.cols()));
+    QVERIFY((matOut.block(0, 100, m_iNumberChannels, m_matData.cols()) - matRef).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    ProjectionOperator::MatrixXdR matOutR = ProjectionOperator::MatrixXdR::Zero(m_iNumberChannels, 1000);
+    m_operator.apply(m_matData.leftCols(200), matOutR.block(0, 700, m_iNumberChannels, 200));
+    QVERIFY((matOutR.block(0, 700, m_iNumberChannels, 200) - matRef.leftCols(200)).cwiseAbs().maxCoeff() < m_dEpsilon);
+    QVERIFY(matOutR.leftCols(700).isZero());
+}
+
+//=============================================================================================================
+
+void TestProjectionOperator::compareSparse()
+{
+    // A permutation-like operator has few non zeros and is applied as sparse product
+    int n = m_iNumberChannels;
+    MatrixXd matPerm = MatrixXd::Identity(n, n);
+    matPerm.topLeftCorner(50, 50) = MatrixXd::Identity(50, 50).rowwise().reverse();
+
+    ProjectionOperator op(n);
+    op.setProjector(matPerm);
+    op.setStages(ProjectionOperator::Projector);
+
+    QVERIFY(op.isSparse());
+
+    MatrixXd matTest = m_matData;
+    op.apply(matTest);
+
+    QVERIFY((matTest - matPerm * m_matData).cwiseAbs().maxCoeff() < m_dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestProjectionOperator::compareStageSelection()
+{
+    ProjectionOperator op = m_operator;
+
+    op.setStages(ProjectionOperator::Projector);
+    QVERIFY((op.getOperator() - m_matProj).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    op.setStages(ProjectionOperator::Compensator | ProjectionOperator::Sphara);
+    QVERIFY((op.getOperator() - m_matSphara * m_matComp).cwiseAbs().maxCoeff() < m_dEpsilon);
+
+    op.setStages(ProjectionOperator::NoStage);
+    QVERIFY(op.isIdentity());
+
+    MatrixXd matTest = m_matData;
+    op.apply(matTest);
+    QVERIFY(matTest == m_matData);
+}
+
+//=============================================================================================================
+
+void TestProjectionOperator::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestProjectionOperator)
+#include "test_projection_operator.moc"
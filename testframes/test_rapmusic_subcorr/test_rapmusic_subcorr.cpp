@@ -0,0 +1,266 @@
+//=============================================================================================================
+/**
+ * @file     test_rapmusic_subcorr.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the closed-form RapMusic pair correlation and the parallel pair scan.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <mne/mne_forwardsolution.h>
+
+#include <inverse/rapMusic/rapmusic.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <Eigen/QR>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace INVERSELIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * Exposes the subspace correlation and the pair scan of RapMusic to the test.
+ */
+class RapMusicScan : public RapMusic
+{
+public:
+    RapMusicScan(MNEForwardSolution& p_pFwd)
+    : RapMusic(p_pFwd, false)
+    {
+    }
+
+    using RapMusic::subcorr;
+    using RapMusic::calcSubcorrData;
+    using RapMusic::scanPairCombinations;
+    using RapMusic::getPointPair;
+    using RapMusic::getGainMatrixPair;
+};
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestRapMusicSubcorr
+ *
+ * @brief The TestRapMusicSubcorr class compares the closed-form 6x6 pair correlation of RapMusic with the SVD
+ *        based computation and checks that the chunked parallel scan finds the same pair as a serial scan.
+ *
+ */
+class TestRapMusicSubcorr: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRapMusicSubcorr();
+
+private slots:
+    void initTestCase();
+    void compareSubcorr_data();
+    void compareSubcorr();
+    void compareScan_data();
+    void compareScan();
+    void cleanupTestCase();
+
+private:
+    double              m_dEpsilonDouble;
+    double              m_dEpsilonFloat;
+    int                 m_iNumChannels;
+    int                 m_iNumGridPoints;
+    int                 m_iRank;
+    int                 m_iNumPairs;
+    MNEForwardSolution  m_forwardSolution;
+    MatrixXd            m_matProjLeadField;
+    MatrixXd            m_matU_B;
+};
+
+//=============================================================================================================
+
+TestRapMusicSubcorr::TestRapMusicSubcorr()
+: m_dEpsilonDouble(1e-8)
+, m_dEpsilonFloat(1e-4)
+, m_iNumChannels(60)
+, m_iNumGridPoints(150)
+, m_iRank(4)
+, m_iNumPairs(500)
+{
+}
+
+//=============================================================================================================
+
+void TestRapMusicSubcorr::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(11);
+
+    // Synthetic gain matrix, RapMusic only needs the channels x 3*grid points solution
+    m_forwardSolution.sol->data = MatrixXd::Random(m_iNumChannels, 3 * m_iNumGridPoints);
+    m_forwardSolution.sol->nrow = m_iNumChannels;
+    m_forwardSolution.sol->ncol = 3 * m_iNumGridPoints;
+
+    // Project out two directions, as after a found source, so that the projected gain is rank deficient
+    MatrixXd matA = MatrixXd::Random(m_iNumChannels, 2);
+    HouseholderQR<MatrixXd> qrA(matA);
+    MatrixXd matQ_A = qrA.householderQ() * MatrixXd::Identity(m_iNumChannels, 2);
+    MatrixXd matOrthProj = MatrixXd::Identity(m_iNumChannels, m_iNumChannels) - matQ_A * matQ_A.transpose();
+
+    m_matProjLeadField = matOrthProj * m_forwardSolution.sol->data;
+
+    // Orthonormal basis of the projected signal subspace
+    MatrixXd matPhi = matOrthProj * MatrixXd::Random(m_iNumChannels, m_iRank);
+    HouseholderQR<MatrixXd> qrPhi(matPhi);
+    m_matU_B = qrPhi.householderQ() * MatrixXd::Identity(m_iNumChannels, m_iRank);
+}
+
+//=============================================================================================================
+
+void TestRapMusicSubcorr::compareSubcorr_data()
+{
+    QTest::addColumn<bool>("bFloatPrecision");
+
+    QTest::newRow("double") << false;
+    QTest::newRow("float") << true;
+}
+
+//=============================================================================================================
+
+void TestRapMusicSubcorr::compareSubcorr()
+{
+    QFETCH(bool, bFloatPrecision);
+
+    RapMusicScan rapMusic(m_forwardSolution);
+    rapMusic.setFloatPrecision(bFloatPrecision);
+
+    SubcorrData subcorrData;
+    rapMusic.calcSubcorrData(m_matProjLeadField, m_matU_B, subcorrData);
+
+    const double dEpsilon = bFloatPrecision ? m_dEpsilonFloat : m_dEpsilonDouble;
+
+    RapMusic::MatrixX6T matProj_G(m_iNumChannels, 6);
+
+    for(int i = 0; i < m_iNumPairs; ++i) {
+        int iIdx1 = std::rand() % m_iNumGridPoints;
+        int iIdx2 = std::rand() % m_iNumGridPoints;
+
+        // Include the pairs of a grid point with itself, their gain combination only has rank three
+        if(i % 10 == 0) {
+            iIdx2 = iIdx1;
+        }
+
+        RapMusicScan::getGainMatrixPair(m_matProjLeadField, matProj_G, iIdx1, iIdx2);
+
+        const double dSvdCor = RapMusicScan::subcorr(matProj_G, m_matU_B);
+        const double dCor = rapMusic.subcorr(subcorrData, iIdx1, iIdx2);
+
+        QVERIFY2(std::fabs(dCor - dSvdCor) <= dEpsilon,
+                 qPrintable(QString("Pair (%1, %2): %3 vs SVD %4").arg(iIdx1).arg(iIdx2).arg(dCor).arg(dSvdCor)));
+    }
+}
+
+//=============================================================================================================
+
+void TestRapMusicSubcorr::compareScan_data()
+{
+    QTest::addColumn<bool>("bFloatPrecision");
+
+    QTest::newRow("double") << false;
+    QTest::newRow("float") << true;
+}
+
+//=============================================================================================================
+
+void TestRapMusicSubcorr::compareScan()
+{
+    QFETCH(bool, bFloatPrecision);
+
+    RapMusicScan rapMusic(m_forwardSolution);
+    rapMusic.setFloatPrecision(bFloatPrecision);
+
+    SubcorrData subcorrData;
+    rapMusic.calcSubcorrData(m_matProjLeadField, m_matU_B, subcorrData);
+
+    // Serial scan over all combinations, ties resolve to the first combination
+    const int iNumCombinations = m_iNumGridPoints * (m_iNumGridPoints + 1) / 2;
+    double dMaxCor = -1.0;
+    int iMaxIdx1 = 0;
+    int iMaxIdx2 = 0;
+
+    for(int i = 0; i < iNumCombinations; ++i) {
+        int iIdx1, iIdx2;
+        RapMusicScan::getPointPair(m_iNumGridPoints, i, iIdx1, iIdx2);
+
+        const double dCor = rapMusic.subcorr(subcorrData, iIdx1, iIdx2);
+
+        if(dCor > dMaxCor) {
+            dMaxCor = dCor;
+            iMaxIdx1 = iIdx1;
+            iMaxIdx2 = iIdx2;
+        }
+    }
+
+    int iIdx1 = -1;
+    int iIdx2 = -1;
+    const double dScanCor = rapMusic.scanPairCombinations(subcorrData, iIdx1, iIdx2);
+
+    QCOMPARE(iIdx1, iMaxIdx1);
+    QCOMPARE(iIdx2, iMaxIdx2);
+    QCOMPARE(dScanCor, dMaxCor);
+}
+
+//=============================================================================================================
+
+void TestRapMusicSubcorr::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestRapMusicSubcorr)
+#include "test_rapmusic_subcorr.moc"
@@ -0,0 +1,366 @@
+//=============================================================================================================
+/**
+ * @file     test_rtdataclient.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the incremental tag parser of RtDataClient with chunked tag streams.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <fiff/fiff_stream.h>
+#include <fiff/fiff_file.h>
+
+#include <communication/rtClient/rtdataclient.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace COMMUNICATIONLIB;
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestRtDataClient
+ *
+ * @brief The TestRtDataClient class sends a recorded tag stream in chunks of arbitrary size, which split tag
+ *        headers and payloads, to an RtDataClient and checks the decoded tags, raw buffers and pooled matrices.
+ *
+ */
+class TestRtDataClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRtDataClient();
+
+private slots:
+    void initTestCase();
+    void compareBlocking_data();
+    void compareBlocking();
+    void compareReceiving_data();
+    void compareReceiving();
+    void compareBufferPool();
+    void cleanupTestCase();
+
+private:
+    void addChunkSizes();
+    QList<QByteArray> chunks(const QList<int>& lChunkSizes) const;
+    bool connectClient(RtDataClient& client, QTcpServer& server, QTcpSocket*& pServerSocket) const;
+
+    int                 m_iNumberChannels;
+    QByteArray          m_baStream;
+    QList<fiff_int_t>   m_lKinds;
+    QList<int>          m_lTagEnds;
+    QList<MatrixXf>     m_lBuffers;
+};
+
+//=============================================================================================================
+
+TestRtDataClient::TestRtDataClient()
+: m_iNumberChannels(5)
+{
+}
+
+//=============================================================================================================
+
+void TestRtDataClient::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(3);
+
+    // Record a raw data block as mne_rt_server sends it, with buffers of different lengths and small tags between
+    FiffStream stream(&m_baStream, QIODevice::WriteOnly);
+
+    stream.start_block(FIFFB_RAW_DATA);
+    m_lKinds << FIFF_BLOCK_START;
+    m_lTagEnds << static_cast<int>(stream.device()->pos());
+
+    const QList<int> lSamples = QList<int>() << 10 << 10 << 3 << 25 << 1 << 10;
+    for(int i = 0; i < lSamples.size(); ++i) {
+        if(i == 2) {
+            fiff_int_t iFirstSample = 42;
+            stream.write_int(FIFF_FIRST_SAMPLE, &iFirstSample);
+            m_lKinds << FIFF_FIRST_SAMPLE;
+            m_lTagEnds << static_cast<int>(stream.device()->pos());
+        }
+
+        MatrixXf matBuffer = MatrixXf::Random(m_iNumberChannels, lSamples[i]);
+        stream.write_float(FIFF_DATA_BUFFER, matBuffer.data(), static_cast<fiff_int_t>(matBuffer.size()));
+        m_lKinds << FIFF_DATA_BUFFER;
+        m_lTagEnds << static_cast<int>(stream.device()->pos());
+        m_lBuffers << matBuffer;
+    }
+
+    stream.end_block(FIFFB_RAW_DATA);
+    m_lKinds << FIFF_BLOCK_END;
+    m_lTagEnds << static_cast<int>(stream.device()->pos());
+
+    QCOMPARE(m_lTagEnds.last(), m_baStream.size());
+}
+
+//=============================================================================================================
+
+void TestRtDataClient::compareBlocking_data()
+{
+    addChunkSizes();
+}
+
+//=============================================================================================================
+
+void TestRtDataClient::compareBlocking()
+{
+    QFETCH(QList<int>, lChunkSizes);
+
+    RtDataClient client;
+    QTcpServer server;
+    QTcpSocket* pServerSocket = Q_NULLPTR;
+    QVERIFY(connectClient(client, server, pServerSocket));
+
+    // Only ask for the tags which are complete on the wire, a partial tag has to stay buffered
+    MatrixXf matData;
+    fiff_int_t kind;
+    int iSent = 0;
+    int iNumberTags = 0;
+    int iNumberBuffers = 0;
+
+    for(const QByteArray& baChunk : chunks(lChunkSizes)) {
+        pServerSocket->write(baChunk);
+        QVERIFY(pServerSocket->waitForBytesWritten(1000));
+        iSent += baChunk.size();
+
+        while(iNumberTags < m_lTagEnds.size() && m_lTagEnds[iNumberTags] <= iSent) {
+            client.readRawBuffer(m_iNumberChannels, matData, kind);
+            QCOMPARE(kind, m_lKinds[iNumberTags]);
+
+            if(kind == FIFF_DATA_BUFFER) {
+                QVERIFY(matData == m_lBuffers[iNumberBuffers]);
+                ++iNumberBuffers;
+            }
+
+            ++iNumberTags;
+        }
+    }
+
+    QCOMPARE(iNumberTags, m_lKinds.size());
+    QCOMPARE(iNumberBuffers, m_lBuffers.size());
+
+    client.disconnectFromHost();
+}
+
+//=============================================================================================================
+
+void TestRtDataClient::compareReceiving_data()
+{
+    addChunkSizes();
+}
+
+//=============================================================================================================
+
+void TestRtDataClient::compareReceiving()
+{
+    QFETCH(QList<int>, lChunkSizes);
+
+    RtDataClient client;
+    QTcpServer server;
+    QTcpSocket* pServerSocket = Q_NULLPTR;
+    QVERIFY(connectClient(client, server, pServerSocket));
+
+    QList<MatrixXf> lReceived;
+    int iNumberEnded = 0;
+    connect(&client, &RtDataClient::rawBufferReceived, this, [&lReceived](QSharedPointer<MatrixXf> pMatRawBuffer) {
+        lReceived << *pMatRawBuffer;
+    });
+    connect(&client, &RtDataClient::rawDataEnded, this, [&iNumberEnded]() {
+        ++iNumberEnded;
+    });
+
+    client.startReceiving(m_iNumberChannels);
+
+    for(const QByteArray& baChunk : chunks(lChunkSizes)) {
+        pServerSocket->write(baChunk);
+        QVERIFY(pServerSocket->waitForBytesWritten(1000));
+        client.waitForReadyRead(100);
+    }
+
+    QTRY_COMPARE(lReceived.size(), m_lBuffers.size());
+    QTRY_COMPARE(iNumberEnded, 1);
+
+    for(int i = 0; i < m_lBuffers.size(); ++i) {
+        QVERIFY(lReceived[i] == m_lBuffers[i]);
+    }
+
+    client.stopReceiving();
+    client.disconnectFromHost();
+}
+
+//=============================================================================================================
+
+void TestRtDataClient::compareBufferPool()
+{
+    RtDataClient client;
+    QTcpServer server;
+    QTcpSocket* pServerSocket = Q_NULLPTR;
+    QVERIFY(connectClient(client, server, pServerSocket));
+
+    // Matrices which are released right away return to the pool and are handed out again
+    QList<const MatrixXf*> lAddresses;
+    QList<QSharedPointer<MatrixXf> > lHeld;
+    bool bHold = false;
+    connect(&client, &RtDataClient::rawBufferReceived, this, [&](QSharedPointer<MatrixXf> pMatRawBuffer) {
+        lAddresses << pMatRawBuffer.data();
+        if(bHold) {
+            lHeld << pMatRawBuffer;
+        }
+    });
+
+    client.startReceiving(m_iNumberChannels);
+
+    pServerSocket->write(m_baStream);
+    QVERIFY(pServerSocket->waitForBytesWritten(1000));
+    QTRY_COMPARE(lAddresses.size(), m_lBuffers.size());
+
+    for(int i = 1; i < lAddresses.size(); ++i) {
+        QVERIFY(lAddresses[i] == lAddresses.first());
+    }
+
+    // Matrices which are still held are not handed out twice
+    lAddresses.clear();
+    bHold = true;
+    pServerSocket->write(m_baStream);
+    QVERIFY(pServerSocket->waitForBytesWritten(1000));
+    QTRY_COMPARE(lAddresses.size(), m_lBuffers.size());
+
+    for(int i = 0; i < lAddresses.size(); ++i) {
+        QCOMPARE(lAddresses.count(lAddresses[i]), 1);
+        QVERIFY(*lHeld[i] == m_lBuffers[i]);
+    }
+
+    // Released matrices are reused again
+    const QList<const MatrixXf*> lReleased = lAddresses;
+    lHeld.clear();
+    lAddresses.clear();
+    bHold = false;
+    pServerSocket->write(m_baStream);
+    QVERIFY(pServerSocket->waitForBytesWritten(1000));
+    QTRY_COMPARE(lAddresses.size(), m_lBuffers.size());
+    QVERIFY(lReleased.contains(lAddresses.first()));
+
+    client.stopReceiving();
+    client.disconnectFromHost();
+}
+
+//=============================================================================================================
+
+void TestRtDataClient::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+void TestRtDataClient::addChunkSizes()
+{
+    QTest::addColumn<QList<int> >("lChunkSizes");
+
+    QTest::newRow("whole stream") << (QList<int>() << m_baStream.size());
+    QTest::newRow("1 byte") << (QList<int>() << 1);
+    QTest::newRow("7 bytes") << (QList<int>() << 7);
+    QTest::newRow("header size") << (QList<int>() << 16);
+    QTest::newRow("17 bytes") << (QList<int>() << 17);
+    QTest::newRow("mixed") << (QList<int>() << 3 << 250 << 13 << 1 << 64 << 900);
+
+    QList<int> lRandom;
+    for(int i = 0; i < 20; ++i) {
+        lRandom << 1 + std::rand() % 300;
+    }
+    QTest::newRow("random") << lRandom;
+}
+
+//=============================================================================================================
+
+QList<QByteArray> TestRtDataClient::chunks(const QList<int>& lChunkSizes) const
+{
+    // The sizes are repeated until the whole stream is split
+    QList<QByteArray> lChunks;
+    int iPos = 0;
+    for(int i = 0; iPos < m_baStream.size(); ++i) {
+        const int iSize = qMin(lChunkSizes[i % lChunkSizes.size()], m_baStream.size() - iPos);
+        lChunks << m_baStream.mid(iPos, iSize);
+        iPos += iSize;
+    }
+
+    return lChunks;
+}
+
+//=============================================================================================================
+
+bool TestRtDataClient::connectClient(RtDataClient& client, QTcpServer& server, QTcpSocket*& pServerSocket) const
+{
+    if(!server.listen(QHostAddress::LocalHost)) {
+        return false;
+    }
+
+    client.connectToHost(QHostAddress::LocalHost, server.serverPort());
+    if(!client.waitForConnected(1000) || !server.waitForNewConnection(1000)) {
+        return false;
+    }
+
+    pServerSocket = server.nextPendingConnection();
+
+    return pServerSocket != Q_NULLPTR;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestRtDataClient)
+#include "test_rtdataclient.moc"
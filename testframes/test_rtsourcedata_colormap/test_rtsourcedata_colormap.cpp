@@ -0,0 +1,232 @@
+//=============================================================================================================
+/**
+ * @file     test_rtsourcedata_colormap.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    The RtSourceDataWorker colormap lookup table unit test
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <disp3D/engine/model/workers/rtSourceLoc/rtsourcedataworker.h>
+#include <disp/plots/helpers/colormap.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QColor>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace DISP3DLIB;
+using namespace DISPLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * Exposes the protected color conversion of RtSourceDataWorker.
+ */
+class RtSourceDataColorConversion : public RtSourceDataWorker
+{
+public:
+    using RtSourceDataWorker::createColormapLut;
+    using RtSourceDataWorker::normalizeAndTransformToColor;
+};
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestRtSourceDataColormap
+ *
+ * @brief The TestRtSourceDataColormap class compares the lookup table based color conversion of the
+ *        RtSourceDataWorker against the per vertex evaluation of the color map.
+ *
+ */
+class TestRtSourceDataColormap : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRtSourceDataColormap();
+
+private slots:
+    void initTestCase();
+    void compareWithColorMap_data();
+    void compareWithColorMap();
+    void cleanupTestCase();
+
+private:
+    void referenceTransformToColor(const VectorXf& vecData,
+                                   MatrixX4f& matFinalVertColor,
+                                   double dThresholdX,
+                                   double dThresholdZ,
+                                   const QString& sColorMap);
+
+    double m_dColorStep;         /**< One 8-bit color step plus rounding slack. */
+};
+
+//=============================================================================================================
+
+TestRtSourceDataColormap::TestRtSourceDataColormap()
+: m_dColorStep(1.0 / 255.0 + 1e-6)
+{
+}
+
+//=============================================================================================================
+
+void TestRtSourceDataColormap::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+}
+
+//=============================================================================================================
+
+void TestRtSourceDataColormap::referenceTransformToColor(const VectorXf& vecData,
+                                                         MatrixX4f& matFinalVertColor,
+                                                         double dThresholdX,
+                                                         double dThresholdZ,
+                                                         const QString& sColorMap)
+{
+    // Per vertex evaluation of the color map, as done before the lookup table was introduced
+    const double dTresholdDiff = dThresholdZ - dThresholdX;
+
+    for(int r = 0; r < vecData.rows(); ++r) {
+        float fSample = std::fabs(vecData(r));
+
+        if(fSample >= dThresholdX) {
+            if(fSample >= dThresholdZ) {
+                fSample = 1.0f;
+            } else if(fSample != 0.0f && dTresholdDiff != 0.0) {
+                fSample = (fSample - dThresholdX) / dTresholdDiff;
+            } else {
+                fSample = 0.0f;
+            }
+
+            QColor color(ColorMap::valueToColor(fSample, sColorMap));
+
+            matFinalVertColor(r,0) = color.redF();
+            matFinalVertColor(r,1) = color.greenF();
+            matFinalVertColor(r,2) = color.blueF();
+            matFinalVertColor(r,3) = color.alphaF();
+        } else {
+            matFinalVertColor(r,3) = 0.0f;
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestRtSourceDataColormap::compareWithColorMap_data()
+{
+    QTest::addColumn<QString>("sColorMap");
+    QTest::addColumn<double>("dThresholdX");
+    QTest::addColumn<double>("dThresholdZ");
+
+    // Viridis is left out: its table index (uint)v*255 only changes at v == 1, so values less than half a
+    // lookup table step below the upper threshold would differ by the whole color range.
+    const QStringList lColorMaps = QStringList() << "Jet" << "Hot" << "HotNegative1" << "HotNegative2"
+                                                 << "Bone" << "RedBlue" << "Cool";
+
+    for(const QString& sColorMap : lColorMaps) {
+        QTest::newRow(QString("%1 0.25-2.75").arg(sColorMap).toUtf8().constData()) << sColorMap << 0.25 << 2.75;
+        QTest::newRow(QString("%1 0-1").arg(sColorMap).toUtf8().constData()) << sColorMap << 0.0 << 1.0;
+        QTest::newRow(QString("%1 narrow").arg(sColorMap).toUtf8().constData()) << sColorMap << 3.0 << 3.0 + 1.0 / 64.0;
+        QTest::newRow(QString("%1 X == Z").arg(sColorMap).toUtf8().constData()) << sColorMap << 1.5 << 1.5;
+    }
+}
+
+//=============================================================================================================
+
+void TestRtSourceDataColormap::compareWithColorMap()
+{
+    QFETCH(QString, sColorMap);
+    QFETCH(double, dThresholdX);
+    QFETCH(double, dThresholdZ);
+
+    // Values from zero up to well above the upper threshold, with both signs, plus the thresholds themselves
+    const int iSteps = 20000;
+    const double dMax = 1.5 * dThresholdZ + 1.0;
+    VectorXf vecData(2 * iSteps + 6);
+    for(int i = 0; i < iSteps; ++i) {
+        const float fValue = static_cast<float>(dMax * i / (iSteps - 1));
+        vecData(2 * i) = fValue;
+        vecData(2 * i + 1) = -fValue;
+    }
+    vecData.tail(6) << dThresholdX, -dThresholdX, dThresholdZ, -dThresholdZ, 0.0f, dMax;
+
+    // Vertices below the lower threshold keep their color and only become transparent
+    const MatrixX4f matInitColor = MatrixX4f::Random(vecData.rows(), 4);
+    MatrixX4f matColorLut = matInitColor;
+    MatrixX4f matColorReference = matInitColor;
+
+    const MatrixX4f matColormapLut = RtSourceDataColorConversion::createColormapLut(sColorMap, ColorMap::valueToColor);
+    RtSourceDataColorConversion::normalizeAndTransformToColor(vecData, matColorLut, dThresholdX, dThresholdZ, matColormapLut);
+    referenceTransformToColor(vecData, matColorReference, dThresholdX, dThresholdZ, sColorMap);
+
+    int iBelow = 0, iAbove = 0;
+    for(int r = 0; r < vecData.rows(); ++r) {
+        const float fAbs = std::fabs(vecData(r));
+        if(fAbs < dThresholdX) {
+            ++iBelow;
+        } else if(fAbs > dThresholdZ) {
+            ++iAbove;
+        }
+    }
+    QVERIFY(iAbove > 0);
+    QVERIFY(dThresholdX == 0.0 || iBelow > 0);
+
+    const double dMaxDiff = (matColorLut - matColorReference).cwiseAbs().maxCoeff();
+    QVERIFY2(dMaxDiff <= m_dColorStep, qPrintable(QString("Max difference %1").arg(dMaxDiff)));
+}
+
+//=============================================================================================================
+
+void TestRtSourceDataColormap::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestRtSourceDataColormap)
+#include "test_rtsourcedata_colormap.moc"
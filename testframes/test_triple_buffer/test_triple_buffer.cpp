@@ -0,0 +1,208 @@
+//=============================================================================================================
+/**
+ * @file     test_triple_buffer.cpp
+ * @author   MNE-CPP authors
+ * @since    0.1.6
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test the latest-wins hand-off of TripleBuffer.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/generics/triplebuffer.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QtTest>
+#include <QtConcurrent>
+#include <QVector>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestTripleBuffer
+ *
+ * @brief The TestTripleBuffer class checks the latest-wins semantics of TripleBuffer and that a consumer thread
+ *        never sees a frame which is still being written.
+ *
+ */
+class TestTripleBuffer: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestTripleBuffer();
+
+private slots:
+    void initTestCase();
+    void latestWins();
+    void slotReuse();
+    void concurrentHandOff();
+    void cleanupTestCase();
+
+private:
+    int     m_iNumberFrames;
+    int     m_iFrameSize;
+};
+
+//=============================================================================================================
+
+TestTripleBuffer::TestTripleBuffer()
+: m_iNumberFrames(20000)
+, m_iFrameSize(256)
+{
+}
+
+//=============================================================================================================
+
+void TestTripleBuffer::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+}
+
+//=============================================================================================================
+
+void TestTripleBuffer::latestWins()
+{
+    TripleBuffer<int> buffer;
+
+    QVERIFY(!buffer.hasNewData());
+    QVERIFY(!buffer.update());
+
+    buffer.writeBuffer() = 1;
+    QVERIFY(!buffer.publish());
+    QVERIFY(buffer.hasNewData());
+
+    // The second frame replaces the first one, which was not picked up
+    buffer.writeBuffer() = 2;
+    QVERIFY(buffer.publish());
+
+    QVERIFY(buffer.update());
+    QCOMPARE(buffer.readBuffer(), 2);
+    QVERIFY(!buffer.hasNewData());
+
+    // Without a new frame the read slot stays the same
+    QVERIFY(!buffer.update());
+    QCOMPARE(buffer.readBuffer(), 2);
+
+    buffer.writeBuffer() = 3;
+    QVERIFY(!buffer.publish());
+    QVERIFY(buffer.update());
+    QCOMPARE(buffer.readBuffer(), 3);
+}
+
+//=============================================================================================================
+
+void TestTripleBuffer::slotReuse()
+{
+    TripleBuffer<QVector<int> > buffer;
+
+    // The producer never gets the slot the consumer holds
+    for(int i = 0; i < 10; ++i) {
+        buffer.writeBuffer().fill(i, m_iFrameSize);
+        buffer.publish();
+
+        if(i % 3 == 0) {
+            QVERIFY(buffer.update());
+            QVERIFY(&buffer.writeBuffer() != &buffer.readBuffer());
+            QCOMPARE(buffer.readBuffer().size(), m_iFrameSize);
+            QCOMPARE(buffer.readBuffer().first(), i);
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestTripleBuffer::concurrentHandOff()
+{
+    TripleBuffer<QVector<int> > buffer;
+    const int iNumberFrames = m_iNumberFrames;
+    const int iFrameSize = m_iFrameSize;
+
+    // Every frame is filled with its number, a mixed frame would mean a slot was shared between the threads
+    QFuture<void> producer = QtConcurrent::run([&buffer, iNumberFrames, iFrameSize]() {
+        for(int i = 1; i <= iNumberFrames; ++i) {
+            QVector<int>& vecFrame = buffer.writeBuffer();
+            vecFrame.resize(iFrameSize);
+            for(int j = 0; j < iFrameSize; ++j) {
+                vecFrame[j] = i;
+            }
+            buffer.publish();
+        }
+    });
+
+    int iLast = 0;
+    bool bConsistent = true;
+    bool bOrdered = true;
+
+    while(iLast < iNumberFrames) {
+        if(!buffer.update()) {
+            continue;
+        }
+
+        const QVector<int>& vecFrame = buffer.readBuffer();
+        const int iFrame = vecFrame.first();
+
+        for(int j = 1; j < vecFrame.size(); ++j) {
+            bConsistent = bConsistent && vecFrame[j] == iFrame;
+        }
+
+        bOrdered = bOrdered && iFrame > iLast;
+        iLast = iFrame;
+    }
+
+    producer.waitForFinished();
+
+    QVERIFY(bConsistent);
+    QVERIFY(bOrdered);
+    QCOMPARE(iLast, iNumberFrames);
+}
+
+//=============================================================================================================
+
+void TestTripleBuffer::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestTripleBuffer)
+#include "test_triple_buffer.moc"
@@ -57,12 +57,30 @@ SUBDIRS += \
     test_fiff_cov \
     test_fiff_digitizer \
     test_mne_msh_display_surface_set \
-    test_mne_project_to_surface
+    test_mne_project_to_surface \
+    test_projection_operator \
+    test_connectivity_network \
+    test_kmeans \
+    test_mne_source_morph \
+    test_triple_buffer \
+    test_fiff_raw_data_set \
+    test_connectivity_incremental \
+    test_fiff_compressed_buffer \
+    test_byte_swap \
+    test_fiff_sidecar_index \
+    test_connectivity_correlation \
+    test_minimumnorm_kernel \
+    test_rapmusic_subcorr \
+    test_fiff_make_dir \
+    test_rtdataclient \
+    test_circularbuffer
 
     qtHaveModule(charts) {
         SUBDIRS += \
             test_interpolation \
             test_geometryinfo \
             test_spectral_connectivity \
-            test_mne_anonymize
+            test_mne_anonymize \
+            test_minmaxpyramid \
+            test_rtsourcedata_colormap
     }